@@ -81,6 +81,10 @@
 	assert(_settings_game.difficulty.competitor_speed <= 4);
 	if ((AI::frame_counter & ((1 << (4 - _settings_game.difficulty.competitor_speed)) - 1)) != 0) return;
 
+	/* The AIs run one after another on this thread. Their commands are not only
+	 * queued: ScriptObject test-runs them at once, which changes global state such
+	 * as _current_company and the command cost caches, and the API reads the pools
+	 * and map unlocked and formats strings in shared buffers. */
 	Backup<CompanyID> cur_company(_current_company);
 	for (const Company *c : Company::Iterate()) {
 		if (c->is_ai) {
@@ -22,6 +22,7 @@
 
 #include "terminal/AIAgentLaunch.h"
 #include "terminal/ShellProcess.h"
+#include "terminal/TerminalReader.h"
 #include "terminal/TerminalSession.h"
 
 #include "widgets/ai_agent_terminal_widget.h"
@@ -39,9 +40,6 @@ using namespace OpenTTD::Terminal;
 static constexpr int TERM_COLS = 100;
 static constexpr int TERM_ROWS = 30;
 
-/** PTY read buffer size. */
-static constexpr size_t PTY_BUFFER_SIZE = 8192;
-
 /** Character cell width (estimate for initial sizing). */
 static constexpr int CELL_WIDTH = 7;
 
@@ -100,7 +98,8 @@ struct AIAgentTerminalWindow : Window
 {
 	std::unique_ptr<TerminalSession> terminal_session;
 	std::unique_ptr<ShellProcess> shell_process;
-	TerminalSnapshot snapshot;
+	std::unique_ptr<TerminalReader> terminal_reader; ///< Feeds the shell's output to the session; declared last of the three so it stops first.
+	TerminalSnapshot snapshot; ///< The state of the session that is drawn; the session itself may be further ahead.
 	std::vector<TerminalCell> scrollback_buffer;
 	Scrollbar *vscroll = nullptr;
 	bool has_snapshot = false;
@@ -148,10 +147,12 @@ struct AIAgentTerminalWindow : Window
 		}
 
 		this->terminal_session = std::make_unique<TerminalSession>(TERM_COLS, TERM_ROWS);
+		this->terminal_reader = std::make_unique<TerminalReader>(*this->shell_process, *this->terminal_session);
 	}
 
 	void Close([[maybe_unused]] int data = 0) override
 	{
+		this->terminal_reader.reset();
 		this->shell_process.reset();
 		this->terminal_session.reset();
 		VideoDriver::GetInstance()->EditBoxLostFocus();
@@ -275,19 +276,22 @@ struct AIAgentTerminalWindow : Window
 
 		/* Get scroll position. */
 		int scroll_pos = this->vscroll ? this->vscroll->GetPosition() : 0;
-		int scrollback_rows = this->terminal_session ? this->terminal_session->GetScrollbackRowCount() : 0;
+		int scrollback_rows = this->snapshot.scrollbackRows;
 
 		/* Draw each visible row. */
 		for (int display_row = 0; display_row < visible_rows; display_row++) {
 			int y = offset_y + display_row * cell_height;
 			if (y >= r.bottom) break;
 
+			/* Only rows in the part being redrawn; usually just the rows that changed. */
+			if (y + cell_height <= _cur_dpi->top || y >= _cur_dpi->top + _cur_dpi->height) continue;
+
 			int data_row = scroll_pos + display_row;
 
 			if (data_row < scrollback_rows) {
 				/* This row is in scrollback. */
 				std::vector<TerminalCell> scrollback_row;
-				const_cast<TerminalSession*>(this->terminal_session.get())->CopyScrollbackRows(data_row, 1, scrollback_row);
+				this->terminal_session->CopySnapshotScrollbackRows(this->snapshot, data_row, 1, scrollback_row);
 				if (!scrollback_row.empty()) {
 					this->DrawTerminalRow(scrollback_row.data(), std::min(cols, static_cast<int>(scrollback_row.size())), offset_x, y, r.right - TERMINAL_PADDING);
 				}
@@ -307,7 +311,7 @@ struct AIAgentTerminalWindow : Window
 	{
 		if (!this->terminal_session || !this->vscroll) return;
 
-		int scrollback_rows = this->terminal_session->GetScrollbackRowCount();
+		int scrollback_rows = this->snapshot.scrollbackRows;
 		int visible_rows = this->snapshot.rows;
 		int total_rows = scrollback_rows + visible_rows;
 
@@ -320,6 +324,34 @@ struct AIAgentTerminalWindow : Window
 		}
 	}
 
+	/**
+	 * Mark the rows of the terminal that changed in the last snapshot dirty.
+	 * This assumes the scroll position has not changed since the previous snapshot.
+	 */
+	void SetDamagedRowsDirty() const
+	{
+		const NWidgetBase *wid = this->GetWidget<NWidgetBase>(WID_AAT_BACKGROUND);
+		const int cell_height = GetCharacterHeight(FS_MONO);
+		const int left = this->left + wid->pos_x;
+		const int right = left + wid->current_x;
+		const int top = this->top + wid->pos_y + TERMINAL_PADDING;
+		const int bottom = this->top + wid->pos_y + wid->current_y;
+
+		int scroll_pos = this->vscroll ? this->vscroll->GetPosition() : 0;
+		int scrollback_rows = this->snapshot.scrollbackRows;
+
+		for (int term_row = 0; term_row < static_cast<int>(this->snapshot.damagedRows.size()); term_row++) {
+			if (!this->snapshot.damagedRows[term_row]) continue;
+
+			int display_row = term_row + scrollback_rows - scroll_pos;
+			if (display_row < 0 || display_row >= this->snapshot.rows) continue;
+
+			int y = top + display_row * cell_height;
+			if (y >= bottom) break;
+			AddDirtyBlock(left, y, right, std::min(y + cell_height, bottom));
+		}
+	}
+
 	/** Poll PTY for data periodically. */
 	IntervalTimer<TimerWindow> pty_poll = {std::chrono::milliseconds(16), [this](auto) {
 		if (!this->shell_process) return;
@@ -332,17 +364,24 @@ struct AIAgentTerminalWindow : Window
 			return;
 		}
 
-		/* Read from PTY. */
-		std::array<uint8_t, PTY_BUFFER_SIZE> buffer;
-		ssize_t bytes = this->shell_process->Read(buffer.data(), buffer.size());
-		if (bytes > 0 && this->terminal_session) {
-			this->terminal_session->FeedOutput(std::span<const uint8_t>(buffer.data(), static_cast<size_t>(bytes)));
-
+		/* The reader thread parses the output; only take a snapshot of the result here. */
+		if (this->terminal_reader && this->terminal_reader->TakeOutput()) {
 			/* Update snapshot. */
+			int old_rows = this->snapshot.rows;
+			int old_count = this->vscroll ? this->vscroll->GetCount() : 0;
+			int old_pos = this->vscroll ? this->vscroll->GetPosition() : 0;
 			if (this->terminal_session->ConsumeSnapshot(this->snapshot)) {
+				bool had_snapshot = this->has_snapshot;
 				this->has_snapshot = true;
 				this->UpdateScrollbar();
-				this->SetDirty();
+
+				/* Scrolling moves every row, otherwise only redraw what changed. */
+				if (!had_snapshot || this->snapshot.rows != old_rows || (this->vscroll != nullptr &&
+						(this->vscroll->GetCount() != old_count || this->vscroll->GetPosition() != old_pos))) {
+					this->SetDirty();
+				} else {
+					this->SetDamagedRowsDirty();
+				}
 			}
 		}
 	}};
@@ -465,7 +504,7 @@ struct AIAgentTerminalWindow : Window
 		if (widget != WID_AAT_BACKGROUND || !this->vscroll) return;
 
 		/* Scroll the terminal view. */
-		int scrollback_rows = this->terminal_session ? this->terminal_session->GetScrollbackRowCount() : 0;
+		int scrollback_rows = this->snapshot.scrollbackRows;
 		int new_pos = this->vscroll->GetPosition() - wheel * 3;  /* 3 lines per wheel notch */
 		new_pos = std::clamp(new_pos, 0, std::max(0, scrollback_rows));
 		this->vscroll->SetPosition(new_pos);
@@ -1965,6 +1965,9 @@ static const MovementTerminalMapping _airport_terminal_mapping[] = {
  * @param i First terminal to examine.
  * @param last_terminal Terminal number to stop examining.
  * @return A terminal or helipad has been found, and has been assigned to the aircraft.
+ * @note Waiting aircraft poll for a free terminal in vehicle order, which decides which
+ *       of them gets a terminal that was freed; only a few bits of the airport's blocks
+ *       are tested, and only when the aircraft has reached its holding position.
  */
 static bool FreeTerminal(Aircraft *v, uint8_t i, uint8_t last_terminal)
 {
@@ -14,11 +14,48 @@
 #include "viewport_func.h"
 #include "framerate_type.h"
 
+#include <unordered_map>
+
 #include "safeguards.h"
 
 /** The table/list with animated tiles. */
 std::vector<TileIndex> _animated_tiles;
 
+/**
+ * Position of every tile in #_animated_tiles, to remove tiles without searching the list.
+ * It is built when it is first needed, as the savegame loaders fill the list directly.
+ */
+static std::unordered_map<uint32_t, uint32_t> _animated_tile_index;
+static bool _animated_tile_index_valid = false; ///< Whether #_animated_tile_index matches #_animated_tiles.
+
+/**
+ * Make sure #_animated_tile_index holds the position of every tile in #_animated_tiles.
+ */
+static void UpdateAnimatedTileIndex()
+{
+	if (_animated_tile_index_valid && _animated_tile_index.size() == _animated_tiles.size()) return;
+
+	_animated_tile_index.clear();
+	_animated_tile_index.reserve(_animated_tiles.size());
+	for (uint32_t i = 0; i < _animated_tiles.size(); i++) _animated_tile_index[_animated_tiles[i].base()] = i;
+	_animated_tile_index_valid = true;
+}
+
+/**
+ * Remove an entry from #_animated_tiles by replacing it with the last entry.
+ * @param pos The position of the entry.
+ */
+static void RemoveAnimatedTileAt(size_t pos)
+{
+	if (_animated_tile_index_valid) {
+		_animated_tile_index.erase(_animated_tiles[pos].base());
+		if (pos + 1 != _animated_tiles.size()) _animated_tile_index[_animated_tiles.back().base()] = static_cast<uint32_t>(pos);
+	}
+
+	if (pos + 1 != _animated_tiles.size()) _animated_tiles[pos] = _animated_tiles.back();
+	_animated_tiles.pop_back();
+}
+
 /**
  * Stops animation on the given tile.
  * @param tile the tile to remove
@@ -33,14 +70,13 @@ void DeleteAnimatedTile(TileIndex tile, bool immediate)
 		 * animated tile list early. */
 		SetAnimatedTileState(tile, AnimatedTileState::None);
 
-		/* To avoid having to move everything after this tile in the animated tile list, look for this tile
-		 * in the animated tile list and replace with last entry if not last. */
-		auto it = std::ranges::find(_animated_tiles, tile);
-		if (it == std::end(_animated_tiles)) return;
-
-		if (std::next(it) != std::end(_animated_tiles)) *it = _animated_tiles.back();
-		_animated_tiles.pop_back();
+		/* To avoid having to move everything after this tile in the animated tile list, look up the position
+		 * of this tile in the animated tile list and replace it with the last entry. */
+		UpdateAnimatedTileIndex();
+		auto it = _animated_tile_index.find(tile.base());
+		if (it == std::end(_animated_tile_index)) return;
 
+		RemoveAnimatedTileAt(it->second);
 		return;
 	}
 
@@ -64,7 +100,10 @@ void AddAnimatedTile(TileIndex tile, bool mark_dirty)
 
 	/* Tile has no previous animation state, so add to the tile list. If the state is anything
 	 * other than None (e.g. Deleted) then the tile will still be in the list and does not need to be added again. */
-	if (state == AnimatedTileState::None) _animated_tiles.push_back(tile);
+	if (state == AnimatedTileState::None) {
+		if (_animated_tile_index_valid) _animated_tile_index[tile.base()] = static_cast<uint32_t>(_animated_tiles.size());
+		_animated_tiles.push_back(tile);
+	}
 
 	SetAnimatedTileState(tile, AnimatedTileState::Animated);
 }
@@ -76,27 +115,22 @@ void AnimateAnimatedTiles()
 {
 	PerformanceAccumulator landscape_framerate(PFE_GL_LANDSCAPE);
 
-	for (auto it = std::begin(_animated_tiles); it != std::end(_animated_tiles); /* nothing */) {
-		TileIndex &tile = *it;
+	/* Every tile is visited every tick: the animation speed callbacks are resolved on every call and
+	 * the order of this list decides the order of the random numbers drawn, so tiles cannot be
+	 * skipped or regrouped by their animation speed without changing the game. */
+	for (size_t i = 0; i < _animated_tiles.size(); /* nothing */) {
+		TileIndex tile = _animated_tiles[i];
 
 		if (GetAnimatedTileState(tile) != AnimatedTileState::Animated) {
-			/* Tile should not be animated any more, mark it as not animated and erase it from the list. */
+			/* Tile should not be animated any more, mark it as not animated and erase it from the list.
+			 * The back of the list takes its place to avoid moving elements. */
 			SetAnimatedTileState(tile, AnimatedTileState::None);
-
-			/* Removing the last entry, no need to swap and continue. */
-			if (std::next(it) == std::end(_animated_tiles)) {
-				_animated_tiles.pop_back();
-				break;
-			}
-
-			/* Replace the current list entry with the back of the list to avoid moving elements. */
-			*it = _animated_tiles.back();
-			_animated_tiles.pop_back();
+			RemoveAnimatedTileAt(i);
 			continue;
 		}
 
 		AnimateTile(tile);
-		++it;
+		++i;
 	}
 }
 
@@ -106,4 +140,6 @@ void AnimateAnimatedTiles()
 void InitializeAnimatedTiles()
 {
 	_animated_tiles.clear();
+	_animated_tile_index.clear();
+	_animated_tile_index_valid = false;
 }
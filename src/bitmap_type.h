@@ -11,18 +11,69 @@
 #define BITMAP_TYPE_HPP
 
 
+#include "core/math_func.hpp"
+#include <bit>
+
 /** Represents a tile area containing containing individually set tiles.
  * Each tile must be contained within the preallocated area.
- * A std::vector<bool> is used to mark which tiles are contained.
+ * The tiles are kept as bits in 64 bit words, row by row, so runs of tiles can
+ * be set and skipped a word at a time.
  */
 class BitmapTileArea : public TileArea {
 protected:
-	std::vector<bool> data;
+	using Word = uint64_t;
+	static constexpr uint WORD_BITS = std::numeric_limits<Word>::digits; ///< Number of tiles in a word.
+
+	std::vector<Word> data;
 
 	inline uint Index(uint x, uint y) const { return y * this->w + x; }
 
 	inline uint Index(TileIndex tile) const { return Index(TileX(tile) - TileX(this->tile), TileY(tile) - TileY(this->tile)); }
 
+	/** Allocate the words for the current size, with no tiles set. */
+	inline void Allocate()
+	{
+		this->data.assign(CeilDiv(this->w * this->h, WORD_BITS), 0);
+	}
+
+	/**
+	 * Set a run of consecutive bits.
+	 * @param index Index of the first bit.
+	 * @param count Number of bits to set.
+	 */
+	void SetBits(uint index, uint count)
+	{
+		while (count > 0) {
+			uint bit = index % WORD_BITS;
+			uint n = std::min(count, WORD_BITS - bit);
+			Word mask = n == WORD_BITS ? ~Word{0} : ((Word{1} << n) - 1);
+			this->data[index / WORD_BITS] |= mask << bit;
+			index += n;
+			count -= n;
+		}
+	}
+
+	/**
+	 * Find the first tile in the tile area, counting from a given index.
+	 * @param index Index to start searching at.
+	 * @return The index of the first tile at or after \a index, or the number of tiles of the area when there is none.
+	 */
+	uint FindNext(uint index) const
+	{
+		uint end = this->w * this->h;
+		if (index >= end) return end;
+
+		size_t word = index / WORD_BITS;
+		Word bits = this->data[word] & (~Word{0} << (index % WORD_BITS));
+		while (bits == 0) {
+			if (++word == this->data.size()) return end;
+			bits = this->data[word];
+		}
+		return static_cast<uint>(word * WORD_BITS) + std::countr_zero(bits);
+	}
+
+	friend class BitmapTileIterator;
+
 public:
 	BitmapTileArea()
 	{
@@ -36,7 +87,7 @@ public:
 		this->tile = ta.tile;
 		this->w = ta.w;
 		this->h = ta.h;
-		this->data.resize(Index(this->w, this->h));
+		this->Allocate();
 	}
 
 	/**
@@ -59,8 +110,7 @@ public:
 		this->tile = TileXY(r.left, r.top);
 		this->w = r.Width();
 		this->h = r.Height();
-		this->data.clear();
-		this->data.resize(Index(w, h));
+		this->Allocate();
 	}
 
 	void Initialize(const TileArea &ta)
@@ -68,8 +118,7 @@ public:
 		this->tile = ta.tile;
 		this->w = ta.w;
 		this->h = ta.h;
-		this->data.clear();
-		this->data.resize(Index(w, h));
+		this->Allocate();
 	}
 
 	/**
@@ -79,7 +128,20 @@ public:
 	inline void SetTile(TileIndex tile)
 	{
 		assert(this->Contains(tile));
-		this->data[Index(tile)] = true;
+		uint index = Index(tile);
+		this->data[index / WORD_BITS] |= Word{1} << (index % WORD_BITS);
+	}
+
+	/**
+	 * Add all tiles of an area as part of the tile area, a row at a time.
+	 * @param ta Area to add, which must lie within the tile area.
+	 */
+	void SetArea(const TileArea &ta)
+	{
+		if (ta.w == 0 || ta.h == 0) return;
+		assert(this->Contains(ta.tile) && this->Contains(TileAddXY(ta.tile, ta.w - 1, ta.h - 1)));
+		uint index = Index(ta.tile);
+		for (uint y = 0; y < ta.h; y++, index += this->w) this->SetBits(index, ta.w);
 	}
 
 	/**
@@ -89,7 +151,8 @@ public:
 	inline void ClrTile(TileIndex tile)
 	{
 		assert(this->Contains(tile));
-		this->data[Index(tile)] = false;
+		uint index = Index(tile);
+		this->data[index / WORD_BITS] &= ~(Word{1} << (index % WORD_BITS));
 	}
 
 	/**
@@ -98,30 +161,44 @@ public:
 	 */
 	inline bool HasTile(TileIndex tile) const
 	{
-		return this->Contains(tile) && this->data[Index(tile)];
+		if (!this->Contains(tile)) return false;
+		uint index = Index(tile);
+		return (this->data[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
 	}
 };
 
 /** Iterator to iterate over all tiles belonging to a bitmaptilearea. */
-class BitmapTileIterator : public OrthogonalTileIterator {
+class BitmapTileIterator : public TileIterator {
 protected:
 	const BitmapTileArea *bitmap;
+	uint index; ///< Index of the current tile in the bitmap.
+
+	/** Move to the first tile at or after the current index, skipping whole words of unset tiles. */
+	inline void Find()
+	{
+		this->index = this->bitmap->FindNext(this->index);
+		if (this->index >= static_cast<uint>(this->bitmap->w * this->bitmap->h)) {
+			this->tile = INVALID_TILE;
+		} else {
+			this->tile = TileAddXY(this->bitmap->tile, this->index % this->bitmap->w, this->index / this->bitmap->w);
+		}
+	}
+
 public:
 	/**
 	 * Construct the iterator.
 	 * @param bitmap BitmapTileArea to iterate.
 	 */
-	BitmapTileIterator(const BitmapTileArea &bitmap) : OrthogonalTileIterator(bitmap), bitmap(&bitmap)
+	BitmapTileIterator(const BitmapTileArea &bitmap) : bitmap(&bitmap), index(0)
 	{
-		if (!this->bitmap->HasTile(TileIndex(this->tile))) ++(*this);
+		this->Find();
 	}
 
 	inline TileIterator& operator ++() override
 	{
-		this->OrthogonalTileIterator::operator++();
-		while (this->tile != INVALID_TILE && !this->bitmap->HasTile(TileIndex(this->tile))) {
-			this->OrthogonalTileIterator::operator++();
-		}
+		assert(this->tile != INVALID_TILE);
+		this->index++;
+		this->Find();
 		return *this;
 	}
 
@@ -8,8 +8,10 @@
 /** @file cachecheck.cpp Check caches. */
 
 #include "stdafx.h"
+#include "cachecheck.h"
 #include "aircraft.h"
 #include "company_base.h"
+#include "console_func.h"
 #include "debug.h"
 #include "industry.h"
 #include "roadstop_base.h"
@@ -27,6 +29,297 @@
 extern void AfterLoadCompanyStats();
 extern void RebuildTownCaches();
 
+/** State of the sampled cache check. */
+static struct {
+	bool enabled = false; ///< Whether the sampled check runs.
+	uint vehicles = 0; ///< Maximum number of vehicles to check per tick.
+	uint stations = 0; ///< Maximum number of stations to check per tick.
+	std::chrono::microseconds budget{}; ///< Maximum time to spend per tick.
+	size_t next_vehicle = 0; ///< Index of the next vehicle to check.
+	size_t next_station = 0; ///< Index of the next station to check.
+	SampledCacheCheckStats stats; ///< What was checked and found so far.
+} _sampled_cache_check;
+
+static const size_t MAX_RECENT_CACHE_MISMATCHES = 32; ///< Number of mismatches kept for #SampledCacheCheckStats::recent.
+
+/**
+ * Report a cache that does not match the value calculated from the 'base' data.
+ * @param msg Description of the mismatch.
+ */
+static void ReportCacheMismatch(std::string &&msg)
+{
+	/* The full check of '-d desync=2' logs to commands-out.log, the sampled check to the console output. */
+	if (_debug_desync_level > 1) {
+		Debug(desync, 2, "warning: {}", msg);
+	} else {
+		Debug(desync, 0, "warning: {}", msg);
+	}
+
+	SampledCacheCheckStats &stats = _sampled_cache_check.stats;
+	stats.mismatches++;
+	stats.recent.push_back(std::move(msg));
+	if (stats.recent.size() > MAX_RECENT_CACHE_MISMATCHES) stats.recent.pop_front();
+}
+
+/**
+ * Recalculate the caches of a vehicle chain and compare them with the cached values.
+ * @param v The vehicle to check.
+ * @return False when the vehicle is not the front of a chain and nothing was checked.
+ */
+static bool CheckVehicleCaches(Vehicle *v)
+{
+	if (v != v->First() || v->vehstatus.Test(VehState::Crashed) || !v->IsPrimaryVehicle()) return false;
+
+	std::vector<NewGRFCache> grf_cache;
+	std::vector<VehicleCache> veh_cache;
+	std::vector<GroundVehicleCache> gro_cache;
+	std::vector<TrainCache> tra_cache;
+
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+		FillNewGRFVehicleCache(u);
+		grf_cache.emplace_back(u->grf_cache);
+		veh_cache.emplace_back(u->vcache);
+		switch (u->type) {
+			case VEH_TRAIN:
+				gro_cache.emplace_back(Train::From(u)->gcache);
+				tra_cache.emplace_back(Train::From(u)->tcache);
+				break;
+			case VEH_ROAD:
+				gro_cache.emplace_back(RoadVehicle::From(u)->gcache);
+				break;
+			default:
+				break;
+		}
+	}
+
+	switch (v->type) {
+		case VEH_TRAIN:    Train::From(v)->ConsistChanged(CCF_TRACK); break;
+		case VEH_ROAD:     RoadVehUpdateCache(RoadVehicle::From(v)); break;
+		case VEH_AIRCRAFT: UpdateAircraftCache(Aircraft::From(v));   break;
+		case VEH_SHIP:     Ship::From(v)->UpdateCache();             break;
+		default: break;
+	}
+
+	uint length = 0;
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+		FillNewGRFVehicleCache(u);
+		if (grf_cache[length] != u->grf_cache) {
+			ReportCacheMismatch(fmt::format("newgrf cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length));
+		}
+		if (veh_cache[length] != u->vcache) {
+			ReportCacheMismatch(fmt::format("vehicle cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length));
+		}
+		switch (u->type) {
+			case VEH_TRAIN:
+				if (gro_cache[length] != Train::From(u)->gcache) {
+					ReportCacheMismatch(fmt::format("train ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length));
+				}
+				if (tra_cache[length] != Train::From(u)->tcache) {
+					ReportCacheMismatch(fmt::format("train cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length));
+				}
+				break;
+			case VEH_ROAD:
+				if (gro_cache[length] != RoadVehicle::From(u)->gcache) {
+					ReportCacheMismatch(fmt::format("road vehicle ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length));
+				}
+				break;
+			default:
+				break;
+		}
+		length++;
+	}
+
+	return true;
+}
+
+/** The sums of the cargo packets of a cargo list. */
+struct CargoPacketSums {
+	uint count = 0; ///< Number of cargo entities.
+	uint64_t periods_in_transit = 0; ///< Sum of the cargo aging periods in transit of each entity.
+	Money feeder_share = 0; ///< Sum of the feeder shares.
+
+	/**
+	 * Get the average number of cargo aging periods in transit, like CargoList::PeriodsInTransit().
+	 * @return The average.
+	 */
+	uint AveragePeriodsInTransit() const
+	{
+		return this->count == 0 ? 0 : this->periods_in_transit / this->count;
+	}
+};
+
+/**
+ * Sum the cargo packets of a cargo list, without touching the caches of the list.
+ * @param list The cargo list.
+ * @return The sums.
+ */
+template <class Tlist>
+static CargoPacketSums SumCargoPackets(const Tlist &list)
+{
+	CargoPacketSums sums;
+	for (typename Tlist::ConstIterator it(list.Packets()->begin()); it != list.Packets()->end(); it++) {
+		const CargoPacket *cp = *it;
+		sums.count += cp->Count();
+		sums.periods_in_transit += static_cast<uint64_t>(cp->GetPeriodsInTransit()) * cp->Count();
+		sums.feeder_share += cp->GetFeederShare();
+	}
+	return sums;
+}
+
+/**
+ * Recalculate the cargo list cache of a vehicle and compare it with the cached values.
+ * @param v The vehicle to check.
+ * @return True iff the cache was valid.
+ */
+static bool CheckVehicleCargoCache(const Vehicle *v)
+{
+	const CargoPacketSums sums = SumCargoPackets(v->cargo);
+	return sums.AveragePeriodsInTransit() == v->cargo.PeriodsInTransit() && sums.count == v->cargo.TotalCount() && sums.feeder_share == v->cargo.GetFeederShare();
+}
+
+/**
+ * Recalculate the cargo list caches of a station and compare them with the cached values.
+ * @param st The station to check.
+ * @return True iff the caches were valid.
+ */
+static bool CheckStationCargoCaches(const Station *st)
+{
+	for (const GoodsEntry &ge : st->goods) {
+		if (!ge.HasData()) continue;
+
+		const StationCargoList &cargo_list = ge.GetData().cargo;
+		const CargoPacketSums sums = SumCargoPackets(cargo_list);
+		if (sums.AveragePeriodsInTransit() != cargo_list.PeriodsInTransit() || sums.count != cargo_list.AvailableCount()) return false;
+	}
+	return true;
+}
+
+/**
+ * Recalculate the docking tiles of a station and report the ones that do not match.
+ * This updates the docking tiles, so it may only be done when every client does it.
+ * @param st The station to check.
+ */
+static void CheckStationDockingTiles(Station *st)
+{
+	TileArea ta;
+	std::map<TileIndex, bool> docking_tiles;
+	for (TileIndex tile : st->docking_station) {
+		ta.Add(tile);
+		docking_tiles[tile] = IsDockingTile(tile);
+	}
+	UpdateStationDockingTiles(st);
+	if (ta.tile != st->docking_station.tile || ta.w != st->docking_station.w || ta.h != st->docking_station.h) {
+		ReportCacheMismatch(fmt::format("station docking mismatch: station {}, company {}", st->index, st->owner));
+	}
+	for (TileIndex tile : ta) {
+		if (docking_tiles[tile] != IsDockingTile(tile)) {
+			ReportCacheMismatch(fmt::format("docking tile mismatch: tile {}", tile));
+		}
+	}
+}
+
+/**
+ * Check the caches of some of the items of a pool, continuing where the previous call stopped.
+ * @tparam T Type of the pool items.
+ * @param next Index of the next item to check; updated so the next call continues from there.
+ * @param count Maximum number of items to check.
+ * @param deadline Stop checking once this time has passed.
+ * @param check Checks one item; returns false when the item was skipped.
+ * @return Number of items checked.
+ */
+template <class T, class Tcheck>
+static uint CheckPoolSlice(size_t &next, uint count, std::chrono::steady_clock::time_point deadline, Tcheck check)
+{
+	uint checked = 0;
+	size_t size = T::GetPoolSize();
+	for (size_t visited = 0; checked < count && visited < size && std::chrono::steady_clock::now() < deadline; visited++) {
+		if (next >= size) next = 0;
+		T *item = T::GetIfValid(next++);
+		if (item != nullptr && check(item)) checked++;
+	}
+	return checked;
+}
+
+/**
+ * Check the cargo caches of the next few vehicles and stations, within the time budget of the sampled check.
+ * The check runs on the server only, so it must not change the game state: the other caches can only be
+ * checked by recalculating them in place, which would fix a wrong cache on the server but not on the clients.
+ */
+static void CheckCachesSampled()
+{
+	auto deadline = std::chrono::steady_clock::now() + _sampled_cache_check.budget;
+	SampledCacheCheckStats &stats = _sampled_cache_check.stats;
+
+	stats.ticks++;
+	stats.vehicles += CheckPoolSlice<Vehicle>(_sampled_cache_check.next_vehicle, _sampled_cache_check.vehicles, deadline, [](const Vehicle *v) {
+		if (!CheckVehicleCargoCache(v)) ReportCacheMismatch(fmt::format("vehicle cargo cache mismatch: vehicle {}", v->index));
+		return true;
+	});
+	stats.stations += CheckPoolSlice<Station>(_sampled_cache_check.next_station, _sampled_cache_check.stations, deadline, [](const Station *st) {
+		if (!CheckStationCargoCaches(st)) ReportCacheMismatch(fmt::format("station cargo cache mismatch: station {}", st->index));
+		return true;
+	});
+}
+
+/**
+ * Start checking the caches of a few vehicles and stations every tick.
+ * @param vehicles Maximum number of vehicles to check per tick.
+ * @param stations Maximum number of stations to check per tick.
+ * @param budget Maximum time to spend per tick.
+ */
+void StartSampledCacheCheck(uint vehicles, uint stations, std::chrono::microseconds budget)
+{
+	_sampled_cache_check.enabled = true;
+	_sampled_cache_check.vehicles = vehicles;
+	_sampled_cache_check.stations = stations;
+	_sampled_cache_check.budget = budget;
+}
+
+/** Stop the sampled cache check; the statistics are kept. */
+void StopSampledCacheCheck()
+{
+	_sampled_cache_check.enabled = false;
+}
+
+/** Clear the statistics of the sampled cache check. */
+void ResetSampledCacheCheckStats()
+{
+	_sampled_cache_check.stats = {};
+}
+
+/**
+ * Whether the sampled cache check runs.
+ * @return True iff it runs.
+ */
+bool IsSampledCacheCheckRunning()
+{
+	return _sampled_cache_check.enabled;
+}
+
+/**
+ * Get what the sampled cache check checked and found.
+ * @return The statistics.
+ */
+const SampledCacheCheckStats &GetSampledCacheCheckStats()
+{
+	return _sampled_cache_check.stats;
+}
+
+/** Print the state and statistics of the sampled cache check to the console. */
+void ConPrintSampledCacheCheck()
+{
+	if (_sampled_cache_check.enabled) {
+		IConsolePrint(CC_DEFAULT, "Sampled cache check running: {} vehicles and {} stations per tick, at most {} us.",
+				_sampled_cache_check.vehicles, _sampled_cache_check.stations, _sampled_cache_check.budget.count());
+	} else {
+		IConsolePrint(CC_DEFAULT, "Sampled cache check not running.");
+	}
+
+	const SampledCacheCheckStats &stats = _sampled_cache_check.stats;
+	IConsolePrint(CC_DEFAULT, "Checked {} vehicles and {} stations in {} ticks; {} mismatches.", stats.vehicles, stats.stations, stats.ticks, stats.mismatches);
+	for (const std::string &msg : stats.recent) IConsolePrint(CC_WARNING, "  {}", msg);
+}
+
 /**
  * Check the validity of some of the caches.
  * Especially in the sense of desyncs between
@@ -37,7 +330,10 @@ void CheckCaches()
 {
 	/* Return here so it is easy to add checks that are run
 	 * always to aid testing of caches. */
-	if (_debug_desync_level <= 1) return;
+	if (_debug_desync_level <= 1) {
+		if (_sampled_cache_check.enabled) CheckCachesSampled();
+		return;
+	}
 
 	/* Check the town caches. */
 	std::vector<TownCache> old_town_caches;
@@ -51,7 +347,7 @@ void CheckCaches()
 	uint i = 0;
 	for (Town *t : Town::Iterate()) {
 		if (old_town_caches[i] != t->cache) {
-			Debug(desync, 2, "warning: town cache mismatch: town {}", t->index);
+			ReportCacheMismatch(fmt::format("town cache mismatch: town {}", t->index));
 		}
 		i++;
 	}
@@ -65,7 +361,7 @@ void CheckCaches()
 	i = 0;
 	for (const Company *c : Company::Iterate()) {
 		if (old_infrastructure[i] != c->infrastructure) {
-			Debug(desync, 2, "warning: infrastructure cache mismatch: company {}", c->index);
+			ReportCacheMismatch(fmt::format("infrastructure cache mismatch: company {}", c->index));
 		}
 		i++;
 	}
@@ -78,83 +374,12 @@ void CheckCaches()
 		rs->GetEntry(DIAGDIR_NW).CheckIntegrity(rs);
 	}
 
-	std::vector<NewGRFCache> grf_cache;
-	std::vector<VehicleCache> veh_cache;
-	std::vector<GroundVehicleCache> gro_cache;
-	std::vector<TrainCache> tra_cache;
-
-	for (Vehicle *v : Vehicle::Iterate()) {
-		if (v != v->First() || v->vehstatus.Test(VehState::Crashed) || !v->IsPrimaryVehicle()) continue;
-
-		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
-			FillNewGRFVehicleCache(u);
-			grf_cache.emplace_back(u->grf_cache);
-			veh_cache.emplace_back(u->vcache);
-			switch (u->type) {
-				case VEH_TRAIN:
-					gro_cache.emplace_back(Train::From(u)->gcache);
-					tra_cache.emplace_back(Train::From(u)->tcache);
-					break;
-				case VEH_ROAD:
-					gro_cache.emplace_back(RoadVehicle::From(u)->gcache);
-					break;
-				default:
-					break;
-			}
-		}
-
-		switch (v->type) {
-			case VEH_TRAIN:    Train::From(v)->ConsistChanged(CCF_TRACK); break;
-			case VEH_ROAD:     RoadVehUpdateCache(RoadVehicle::From(v)); break;
-			case VEH_AIRCRAFT: UpdateAircraftCache(Aircraft::From(v));   break;
-			case VEH_SHIP:     Ship::From(v)->UpdateCache();             break;
-			default: break;
-		}
-
-		uint length = 0;
-		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
-			FillNewGRFVehicleCache(u);
-			if (grf_cache[length] != u->grf_cache) {
-				Debug(desync, 2, "warning: newgrf cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
-			}
-			if (veh_cache[length] != u->vcache) {
-				Debug(desync, 2, "warning: vehicle cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
-			}
-			switch (u->type) {
-				case VEH_TRAIN:
-					if (gro_cache[length] != Train::From(u)->gcache) {
-						Debug(desync, 2, "warning: train ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
-					}
-					if (tra_cache[length] != Train::From(u)->tcache) {
-						Debug(desync, 2, "warning: train cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
-					}
-					break;
-				case VEH_ROAD:
-					if (gro_cache[length] != RoadVehicle::From(u)->gcache) {
-						Debug(desync, 2, "warning: road vehicle ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
-					}
-					break;
-				default:
-					break;
-			}
-			length++;
-		}
-
-		grf_cache.clear();
-		veh_cache.clear();
-		gro_cache.clear();
-		tra_cache.clear();
-	}
+	for (Vehicle *v : Vehicle::Iterate()) CheckVehicleCaches(v);
 
 	/* Check whether the caches are still valid */
 	for (Vehicle *v : Vehicle::Iterate()) {
-		[[maybe_unused]] const auto a = v->cargo.PeriodsInTransit();
-		[[maybe_unused]] const auto b = v->cargo.TotalCount();
-		[[maybe_unused]] const auto c = v->cargo.GetFeederShare();
-		v->cargo.InvalidateCache();
-		assert(a == v->cargo.PeriodsInTransit());
-		assert(b == v->cargo.TotalCount());
-		assert(c == v->cargo.GetFeederShare());
+		[[maybe_unused]] bool valid = CheckVehicleCargoCache(v);
+		assert(valid);
 	}
 
 	/* Backup stations_near */
@@ -168,33 +393,9 @@ void CheckCaches()
 	for (Station *st : Station::Iterate()) old_station_industries_near.push_back(st->industries_near);
 
 	for (Station *st : Station::Iterate()) {
-		for (GoodsEntry &ge : st->goods) {
-			if (!ge.HasData()) continue;
-
-			StationCargoList &cargo_list = ge.GetData().cargo;
-			[[maybe_unused]] const auto a = cargo_list.PeriodsInTransit();
-			[[maybe_unused]] const auto b = cargo_list.TotalCount();
-			cargo_list.InvalidateCache();
-			assert(a == cargo_list.PeriodsInTransit());
-			assert(b == cargo_list.TotalCount());
-		}
-
-		/* Check docking tiles */
-		TileArea ta;
-		std::map<TileIndex, bool> docking_tiles;
-		for (TileIndex tile : st->docking_station) {
-			ta.Add(tile);
-			docking_tiles[tile] = IsDockingTile(tile);
-		}
-		UpdateStationDockingTiles(st);
-		if (ta.tile != st->docking_station.tile || ta.w != st->docking_station.w || ta.h != st->docking_station.h) {
-			Debug(desync, 2, "warning: station docking mismatch: station {}, company {}", st->index, st->owner);
-		}
-		for (TileIndex tile : ta) {
-			if (docking_tiles[tile] != IsDockingTile(tile)) {
-				Debug(desync, 2, "warning: docking tile mismatch: tile {}", tile);
-			}
-		}
+		[[maybe_unused]] bool valid = CheckStationCargoCaches(st);
+		assert(valid);
+		CheckStationDockingTiles(st);
 	}
 
 	Station::RecomputeCatchmentForAll();
@@ -203,7 +404,7 @@ void CheckCaches()
 	i = 0;
 	for (Station *st : Station::Iterate()) {
 		if (st->industries_near != old_station_industries_near[i]) {
-			Debug(desync, 2, "warning: station industries near mismatch: station {}", st->index);
+			ReportCacheMismatch(fmt::format("station industries near mismatch: station {}", st->index));
 		}
 		i++;
 	}
@@ -212,14 +413,14 @@ void CheckCaches()
 	i = 0;
 	for (Town *t : Town::Iterate()) {
 		if (t->stations_near != old_town_stations_near[i]) {
-			Debug(desync, 2, "warning: town stations near mismatch: town {}", t->index);
+			ReportCacheMismatch(fmt::format("town stations near mismatch: town {}", t->index));
 		}
 		i++;
 	}
 	i = 0;
 	for (Industry *ind : Industry::Iterate()) {
 		if (ind->stations_near != old_industry_stations_near[i]) {
-			Debug(desync, 2, "warning: industry stations near mismatch: industry {}", ind->index);
+			ReportCacheMismatch(fmt::format("industry stations near mismatch: industry {}", ind->index));
 		}
 		i++;
 	}
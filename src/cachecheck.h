@@ -0,0 +1,32 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file cachecheck.h Check caches. */
+
+#ifndef CACHECHECK_H
+#define CACHECHECK_H
+
+#include <chrono>
+
+/** What the sampled cache check checked and found. */
+struct SampledCacheCheckStats {
+	uint64_t ticks = 0; ///< Number of ticks the check ran.
+	uint64_t vehicles = 0; ///< Number of vehicles checked.
+	uint64_t stations = 0; ///< Number of stations checked.
+	uint64_t mismatches = 0; ///< Number of mismatching caches found.
+	std::deque<std::string> recent; ///< Descriptions of the most recent mismatches, oldest first.
+};
+
+void CheckCaches();
+void StartSampledCacheCheck(uint vehicles, uint stations, std::chrono::microseconds budget);
+void StopSampledCacheCheck();
+void ResetSampledCacheCheckStats();
+bool IsSampledCacheCheckRunning();
+const SampledCacheCheckStats &GetSampledCacheCheckStats();
+void ConPrintSampledCacheCheck();
+
+#endif /* CACHECHECK_H */
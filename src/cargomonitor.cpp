@@ -26,17 +26,11 @@ CargoMonitorMap _cargo_deliveries; ///< Map of monitored deliveries to the amoun
 static void ClearCargoMonitoring(CargoMonitorMap &cargo_monitor_map, CompanyID company = INVALID_OWNER)
 {
 	if (company == INVALID_OWNER) {
-		cargo_monitor_map.clear();
+		cargo_monitor_map.Clear();
 		return;
 	}
 
-	for (auto it = cargo_monitor_map.begin(); it != cargo_monitor_map.end(); /* nothing */) {
-		if (DecodeMonitorCompany(it->first) == company) {
-			it = cargo_monitor_map.erase(it);
-		} else {
-			++it;
-		}
-	}
+	cargo_monitor_map.GetPartition(company).clear();
 }
 
 /**
@@ -68,16 +62,17 @@ void ClearCargoDeliveryMonitoring(CompanyID company)
  */
 static int32_t GetAmount(CargoMonitorMap &monitor_map, CargoMonitorID monitor, bool keep_monitoring)
 {
-	CargoMonitorMap::iterator iter = monitor_map.find(monitor);
-	if (iter == monitor_map.end()) {
+	CargoMonitorMap::Partition &partition = monitor_map.GetPartition(monitor);
+	auto iter = partition.find(monitor);
+	if (iter == partition.end()) {
 		if (keep_monitoring) {
-			monitor_map.emplace(monitor, 0);
+			partition.emplace(monitor, 0);
 		}
 		return 0;
 	} else {
 		int32_t result = iter->second;
 		iter->second = 0;
-		if (!keep_monitoring) monitor_map.erase(iter);
+		if (!keep_monitoring) partition.erase(iter);
 		return result;
 	}
 }
@@ -118,19 +113,20 @@ void AddCargoDelivery(CargoType cargo_type, CompanyID company, uint32_t amount,
 {
 	if (amount == 0) return;
 
-	if (src.IsValid()) {
+	CargoMonitorMap::Partition &pickups = _cargo_pickups.GetPartition(company);
+	if (src.IsValid() && !pickups.empty()) {
 		/* Handle pickup update. */
 		switch (src.type) {
 			case SourceType::Industry: {
 				CargoMonitorID num = EncodeCargoIndustryMonitor(company, cargo_type, src.ToIndustryID());
-				CargoMonitorMap::iterator iter = _cargo_pickups.find(num);
-				if (iter != _cargo_pickups.end()) iter->second += amount;
+				auto iter = pickups.find(num);
+				if (iter != pickups.end()) iter->second += amount;
 				break;
 			}
 			case SourceType::Town: {
 				CargoMonitorID num = EncodeCargoTownMonitor(company, cargo_type, src.ToTownID());
-				CargoMonitorMap::iterator iter = _cargo_pickups.find(num);
-				if (iter != _cargo_pickups.end()) iter->second += amount;
+				auto iter = pickups.find(num);
+				if (iter != pickups.end()) iter->second += amount;
 				break;
 			}
 			default: break;
@@ -140,17 +136,20 @@ void AddCargoDelivery(CargoType cargo_type, CompanyID company, uint32_t amount,
 	/* Handle delivery.
 	 * Note that delivery in the right area is sufficient to prevent trouble with neighbouring industries or houses. */
 
+	CargoMonitorMap::Partition &deliveries = _cargo_deliveries.GetPartition(company);
+	if (deliveries.empty()) return;
+
 	/* Town delivery. */
 	CargoMonitorID num = EncodeCargoTownMonitor(company, cargo_type, st->town->index);
-	CargoMonitorMap::iterator iter = _cargo_deliveries.find(num);
-	if (iter != _cargo_deliveries.end()) iter->second += amount;
+	auto iter = deliveries.find(num);
+	if (iter != deliveries.end()) iter->second += amount;
 
 	/* Industry delivery. */
 	for (const auto &i : st->industries_near) {
 		if (i.industry->index != dest) continue;
 		CargoMonitorID num = EncodeCargoIndustryMonitor(company, cargo_type, i.industry->index);
-		CargoMonitorMap::iterator iter = _cargo_deliveries.find(num);
-		if (iter != _cargo_deliveries.end()) iter->second += amount;
+		auto iter = deliveries.find(num);
+		if (iter != deliveries.end()) iter->second += amount;
 	}
 }
 
@@ -16,6 +16,8 @@
 #include "town.h"
 #include "core/overflowsafe_type.hpp"
 
+#include <unordered_map>
+
 struct Station;
 
 /**
@@ -28,13 +30,6 @@ struct Station;
  */
 typedef uint32_t CargoMonitorID; ///< Type of the cargo monitor number.
 
-/** Map type for storing and updating active cargo monitor numbers and their amounts. */
-typedef std::map<CargoMonitorID, OverflowSafeInt32> CargoMonitorMap;
-
-extern CargoMonitorMap _cargo_pickups;
-extern CargoMonitorMap _cargo_deliveries;
-
-
 /* Constants for encoding and extracting cargo monitors. */
 constexpr uint8_t CCB_TOWN_IND_NUMBER_START = 0; ///< Start bit of the town or industry number.
 constexpr uint8_t CCB_TOWN_IND_NUMBER_LENGTH = 16; ///< Number of bits of the town or industry number.
@@ -139,6 +134,75 @@ inline TownID DecodeMonitorTown(CargoMonitorID num)
 	return static_cast<TownID>(GB(num, CCB_TOWN_IND_NUMBER_START, CCB_TOWN_IND_NUMBER_LENGTH));
 }
 
+/**
+ * Map type for storing and updating active cargo monitor numbers and their amounts.
+ * The monitors are kept in a hash map per company, so one company's monitors can be dropped
+ * without looking at those of the others, and deliveries by companies without monitors are
+ * skipped right away.
+ */
+class CargoMonitorMap {
+public:
+	using Partition = std::unordered_map<CargoMonitorID, OverflowSafeInt32>; ///< Monitors of one company.
+
+	/**
+	 * Get the monitors of a company.
+	 * @param company The company.
+	 * @return The monitors.
+	 */
+	Partition &GetPartition(CompanyID company)
+	{
+		assert(company.base() < this->partitions.size());
+		return this->partitions[company.base()];
+	}
+
+	/**
+	 * Get the monitors of the company of a monitor.
+	 * @param monitor The monitor.
+	 * @return The monitors.
+	 */
+	Partition &GetPartition(CargoMonitorID monitor) { return this->partitions[DecodeMonitorCompany(monitor).base()]; }
+
+	/**
+	 * Get the amount of a monitor.
+	 * @param monitor The monitor.
+	 * @return The amount, or \c nullptr when the monitor is not active.
+	 */
+	const OverflowSafeInt32 *Find(CargoMonitorID monitor) const
+	{
+		const Partition &partition = this->partitions[DecodeMonitorCompany(monitor).base()];
+		auto it = partition.find(monitor);
+		return it == partition.end() ? nullptr : &it->second;
+	}
+
+	/**
+	 * Activate a monitor, if it is not active yet.
+	 * @param monitor The monitor.
+	 * @param amount The amount to start with.
+	 */
+	void Emplace(CargoMonitorID monitor, OverflowSafeInt32 amount) { this->GetPartition(monitor).emplace(monitor, amount); }
+
+	/** Drop all monitors. */
+	void Clear() { for (Partition &partition : this->partitions) partition.clear(); }
+
+	/**
+	 * Get the active monitors and their amounts in order of their monitor number.
+	 * @return The monitors and amounts.
+	 */
+	std::vector<std::pair<CargoMonitorID, OverflowSafeInt32>> GetSorted() const
+	{
+		std::vector<std::pair<CargoMonitorID, OverflowSafeInt32>> sorted;
+		for (const Partition &partition : this->partitions) sorted.insert(sorted.end(), partition.begin(), partition.end());
+		std::ranges::sort(sorted, {}, &std::pair<CargoMonitorID, OverflowSafeInt32>::first);
+		return sorted;
+	}
+
+private:
+	std::array<Partition, 1 << CCB_COMPANY_LENGTH> partitions; ///< The monitors per company number.
+};
+
+extern CargoMonitorMap _cargo_pickups;
+extern CargoMonitorMap _cargo_deliveries;
+
 void ClearCargoPickupMonitoring(CompanyID company = INVALID_OWNER);
 void ClearCargoDeliveryMonitoring(CompanyID company = INVALID_OWNER);
 int32_t GetDeliveryAmount(CargoMonitorID monitor, bool keep_monitoring);
@@ -696,6 +696,33 @@ void StationCargoList::Append(CargoPacket *cp, StationID next)
 	list.push_back(cp);
 }
 
+/**
+ * Merge packets with the same next hop that can be merged, but are stored separately.
+ * Packets become mergeable after they were appended when e.g. their source is removed.
+ * Each packet is merged into the nearest earlier packet it can be merged with, just like
+ * Append would have done if the packets had been mergeable back then.
+ * @return Number of packets that were merged into others.
+ */
+uint StationCargoList::MergePackets()
+{
+	uint merged = 0;
+	for (auto &it : this->packets) {
+		StationCargoPacketMap::List &list = it.second;
+		if (list.size() < 2) continue;
+		for (auto cp_it = std::next(list.begin()); cp_it != list.end();) {
+			CargoPacket *cp = *cp_it;
+			auto icp_it = std::find_if(std::make_reverse_iterator(cp_it), list.rend(), [cp](CargoPacket *icp) { return StationCargoList::TryMerge(icp, cp); });
+			if (icp_it != list.rend()) {
+				cp_it = list.erase(cp_it);
+				++merged;
+			} else {
+				++cp_it;
+			}
+		}
+	}
+	return merged;
+}
+
 /**
  * Shifts cargo from the front of the packet list for a specific station and
  * applies some action to it.
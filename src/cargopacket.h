@@ -266,6 +266,11 @@ public:
 	static void AfterLoad();
 };
 
+#ifndef WITH_ASSERT
+/* Loading and unloading walk many packets; keep each of them within half a cache line. */
+static_assert(sizeof(CargoPacket) <= 32);
+#endif /* WITH_ASSERT */
+
 /**
  * Simple collection class for a list of cargo packets.
  * @tparam Tinst Actual instantiation of this cargo list.
@@ -546,6 +551,7 @@ public:
 	uint ShiftCargo(Taction action, std::span<const StationID> next, bool include_invalid);
 
 	void Append(CargoPacket *cp, StationID next);
+	uint MergePackets();
 
 	/**
 	 * Check for cargo headed for a specific station.
@@ -58,6 +58,8 @@
 #include "waypoint_cmd.h"
 #include "misc/endian_buffer.hpp"
 #include "string_func.h"
+#include "rpc/rpc_connectivity.h"
+#include "pathfinder/yapf/yapf_cache.h"
 
 #include "table/strings.h"
 
@@ -174,12 +176,13 @@ void CommandHelperBase::InternalDoBefore(bool top_level, bool test)
 
 /**
  * Process result after calling a command proc.
+ * @param cmd The command that was called.
  * @param[in,out] res Command result, may be modified.
  * @param flags Command flags.
  * @param top_level Top level of command execution, i.e. command from a command.
  * @param test Test run of command?
  */
-void CommandHelperBase::InternalDoAfter(CommandCost &res, DoCommandFlags flags, bool top_level, bool test)
+void CommandHelperBase::InternalDoAfter(Commands cmd, CommandCost &res, DoCommandFlags flags, bool top_level, bool test)
 {
 	if (test) {
 		SetTownRatingTestMode(false);
@@ -193,6 +196,26 @@ void CommandHelperBase::InternalDoAfter(CommandCost &res, DoCommandFlags flags,
 			SubtractMoneyFromCompany(res);
 		}
 
+		/* Construction may have connected or split road and rail networks. */
+		if (res.Succeeded() && _command_proc_table[cmd].type == CommandType::LandscapeConstruction) {
+			RpcInvalidateConnectivity();
+			/* These commands notify YAPF of every road tile they change themselves. */
+			switch (cmd) {
+				case CMD_BUILD_ROAD:
+				case CMD_BUILD_LONG_ROAD:
+				case CMD_REMOVE_LONG_ROAD:
+				case CMD_LANDSCAPE_CLEAR:
+				case CMD_TERRAFORM_LAND:
+				case CMD_BUILD_BRIDGE:
+				case CMD_BUILD_TUNNEL:
+					break;
+
+				default:
+					YapfNotifyRoadLayoutChange(INVALID_TILE);
+					break;
+			}
+		}
+
 		/* Flush the signal buffer after top-level command execution.
 		 * This is needed for Command::Do() calls (e.g., from RPC handlers)
 		 * that don't go through InternalExecuteProcessResult(). */
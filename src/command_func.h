@@ -86,7 +86,7 @@ template <Commands TCmd, typename T, bool THasTile> struct CommandHelper;
 class CommandHelperBase {
 protected:
 	static void InternalDoBefore(bool top_level, bool test);
-	static void InternalDoAfter(CommandCost &res, DoCommandFlags flags, bool top_level, bool test);
+	static void InternalDoAfter(Commands cmd, CommandCost &res, DoCommandFlags flags, bool top_level, bool test);
 	static std::tuple<bool, bool, bool> InternalPostBefore(Commands cmd, CommandFlags flags, TileIndex tile, StringID err_message, bool network_command);
 	static void InternalPostResult(CommandCost &res, TileIndex tile, bool estimate_only, bool only_sending, StringID err_message, bool my_cmd);
 	static bool InternalExecutePrepTest(CommandFlags cmd_flags, TileIndex tile, Backup<CompanyID> &cur_company);
@@ -151,7 +151,7 @@ public:
 		if (counter.IsTopLevel() || !flags.Test(DoCommandFlag::Execute)) {
 			InternalDoBefore(counter.IsTopLevel(), true);
 			Tret res = CommandTraits<Tcmd>::proc(DoCommandFlags{flags}.Reset(DoCommandFlag::Execute), args...);
-			InternalDoAfter(ExtractCommandCost(res), flags, counter.IsTopLevel(), true); // Can modify res.
+			InternalDoAfter(Tcmd, ExtractCommandCost(res), flags, counter.IsTopLevel(), true); // Can modify res.
 
 			if (ExtractCommandCost(res).Failed() || !flags.Test(DoCommandFlag::Execute)) return res;
 		}
@@ -160,7 +160,7 @@ public:
 		 * themselves to the cost object at some point. */
 		InternalDoBefore(counter.IsTopLevel(), false);
 		Tret res = CommandTraits<Tcmd>::proc(flags, args...);
-		InternalDoAfter(ExtractCommandCost(res), flags, counter.IsTopLevel(), false);
+		InternalDoAfter(Tcmd, ExtractCommandCost(res), flags, counter.IsTopLevel(), false);
 
 		return res;
 	}
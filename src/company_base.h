@@ -143,8 +143,21 @@ struct Company : CompanyProperties, CompanyPool::PoolItem<&_company_pool> {
 	std::array<FreeUnitIDGenerator, VEH_COMPANY_END> freeunits{};
 	FreeUnitIDGenerator freegroups{};
 
+	mutable std::string cached_name{}; ///< NOSAVE: Cache of the resolved name of the company, if not using a custom name.
+
 	Money GetMaxLoan() const;
 
+	/**
+	 * Get the name of the company, resolving it once when the user did not change it.
+	 * @return The name of the company.
+	 */
+	inline const std::string &GetCachedName() const
+	{
+		if (!this->name.empty()) return this->name;
+		if (this->cached_name.empty()) this->FillCachedName();
+		return this->cached_name;
+	}
+
 	/**
 	 * Is this company a valid company, controlled by the computer (a NoAI program)?
 	 * @param index Index in the pool.
@@ -193,10 +206,14 @@ struct Company : CompanyProperties, CompanyPool::PoolItem<&_company_pool> {
 	}
 
 	static void PostDestructor(size_t index);
+
+private:
+	void FillCachedName() const;
 };
 
 Money CalculateCompanyValue(const Company *c, bool including_loan = true);
 Money CalculateHostileTakeoverValue(const Company *c);
+void ClearAllCompanyCachedNames();
 
 extern uint _cur_company_tick_index;
 
@@ -43,6 +43,7 @@
 #include "timer/timer_window.h"
 
 #include "widgets/statusbar_widget.h"
+#include "rpc/rpc_engine_cache.h"
 
 #include "table/strings.h"
 #include "table/company_face.h"
@@ -406,6 +407,20 @@ CommandCost CheckTileOwnership(TileIndex tile)
 	return CheckOwnership(GetTileOwner(tile), tile);
 }
 
+/** Resolve the default name of the company, for #Company::GetCachedName. */
+void Company::FillCachedName() const
+{
+	this->cached_name = GetString(this->name_1, this->name_2);
+}
+
+/** Clear the cached_name of all companies. */
+void ClearAllCompanyCachedNames()
+{
+	for (const Company *c : Company::Iterate()) {
+		c->cached_name.clear();
+	}
+}
+
 /**
  * Generate the name of a company from the last build coordinate.
  * @param c Company to give a name.
@@ -436,6 +451,7 @@ verify_name:;
 set_name:;
 		c->name_1 = str;
 		c->name_2 = strp;
+		c->cached_name.clear();
 
 		MarkWholeScreenDirty();
 		AI::BroadcastNewEvent(new ScriptEventCompanyRenamed(c->index, name));
@@ -645,6 +661,7 @@ Company *DoStartupNewCompany(bool is_ai, CompanyID company = CompanyID::Invalid(
 	InvalidateWindowData(WC_LINKGRAPH_LEGEND, 0);
 	BuildOwnerLegend();
 	InvalidateWindowData(WC_SMALLMAP, 0, 1);
+	RpcInvalidateEngineCache();
 
 	if (is_ai && (!_networking || _network_server)) AI::StartNew(c->index);
 
@@ -1201,6 +1218,7 @@ CommandCost CmdRenameCompany(DoCommandFlags flags, const std::string &text)
 
 	if (flags.Test(DoCommandFlag::Execute)) {
 		Company *c = Company::Get(_current_company);
+		c->cached_name.clear();
 		if (reset) {
 			c->name.clear();
 		} else {
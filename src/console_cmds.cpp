@@ -42,10 +42,18 @@
 #include "road.h"
 #include "rail.h"
 #include "game/game.hpp"
+#include "game/game_instance.hpp"
+#include "ai/ai_instance.hpp"
 #include "3rdparty/fmt/chrono.h"
 #include "company_cmd.h"
 #include "misc_cmd.h"
 #include "ai_agent_terminal_gui.h"
+#include "pathfinder/yapf/yapf_stats.h"
+#include "spritecache.h"
+#include "trace.h"
+#include "memory_report.h"
+#include "cachecheck.h"
+#include "rpc/rpc_server.h"
 
 #if defined(WITH_ZLIB)
 #include "network/network_content.h"
@@ -2674,6 +2682,308 @@ static bool ConFramerate(std::span<std::string_view> argv)
 	return true;
 }
 
+static bool ConPathfinderStats(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show statistics of the pathfinder searches per vehicle type and company. Usage: 'pfstats [reset]'.");
+		return true;
+	}
+
+	if (argv.size() > 2 || (argv.size() == 2 && argv[1] != "reset")) return false;
+
+	ConPrintYapfStats();
+	if (argv.size() == 2) YapfResetSearchStats();
+	return true;
+}
+
+static bool ConRpcStats(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show the number, size and game thread time of the RPC requests per method. Usage: 'rpcstats [reset]'.");
+		return true;
+	}
+
+	if (argv.size() > 2 || (argv.size() == 2 && argv[1] != "reset")) return false;
+
+	ConPrintRpcStats();
+	if (argv.size() == 2) RpcServerResetStats();
+	return true;
+}
+
+static bool ConNewGRFCallbackStats(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show the cost of the NewGRF callbacks per NewGRF, feature and callback. Usage: 'grfstats [start|stop|reset]'.");
+		IConsolePrint(CC_HELP, "The statistics are only collected between 'grfstats start' and 'grfstats stop'.");
+		return true;
+	}
+
+	if (argv.size() > 2) return false;
+
+	if (argv.size() == 2) {
+		if (argv[1] == "start") {
+			SetNewGRFCallbackStatsEnabled(true);
+			IConsolePrint(CC_INFO, "Collecting NewGRF callback statistics.");
+			return true;
+		}
+		if (argv[1] == "stop") {
+			SetNewGRFCallbackStatsEnabled(false);
+			IConsolePrint(CC_INFO, "Stopped collecting NewGRF callback statistics.");
+			return true;
+		}
+		if (argv[1] != "reset") return false;
+	}
+
+	ConPrintNewGRFCallbackStats();
+	if (argv.size() == 2) ResetNewGRFCallbackStats();
+	return true;
+}
+
+static bool ConSpriteCacheStats(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show the memory use, hit rate and evictions of the sprite cache per sprite type. Usage: 'spritecache [reset]'.");
+		return true;
+	}
+
+	if (argv.size() > 2 || (argv.size() == 2 && argv[1] != "reset")) return false;
+
+	ConPrintSpriteCacheStats();
+	if (argv.size() == 2) ResetSpriteCacheStats();
+	return true;
+}
+
+static bool ConMemoryReport(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show the memory used per pool, cache, AI and game script, the largest first. Usage: 'mem'.");
+		return true;
+	}
+
+	if (argv.size() > 1) return false;
+
+	ConPrintMemoryReport();
+	return true;
+}
+
+static bool ConScriptProfile(std::span<std::string_view> argv)
+{
+	if (argv.size() < 3) {
+		IConsolePrint(CC_HELP, "Profile the API calls and call stacks of an AI or the game script. Usage: 'script_profile <company-id | GS> start | stop | print [<count>] | dump <file>'.");
+		IConsolePrint(CC_HELP, "'print' shows the most expensive API functions and call stacks, also in the log of the script debug window; 'dump' writes the call stacks in the folded format used by flame graph tools.");
+		return true;
+	}
+
+	if (_game_mode != GM_NORMAL) {
+		IConsolePrint(CC_ERROR, "Scripts can only be profiled in a game.");
+		return true;
+	}
+
+	ScriptInstance *instance = nullptr;
+	if (StrEqualsIgnoreCase(argv[1], "GS")) {
+		instance = Game::GetInstance();
+	} else {
+		auto company_id = ParseCompanyID(argv[1]);
+		if (!company_id.has_value() || !Company::IsValidAiID(*company_id)) {
+			IConsolePrint(CC_ERROR, "Company is not controlled by an AI.");
+			return true;
+		}
+		instance = Company::Get(*company_id)->ai_instance.get();
+	}
+	if (instance == nullptr) {
+		IConsolePrint(CC_ERROR, "The script is not running.");
+		return true;
+	}
+
+	if (argv[2] == "start" || argv[2] == "stop") {
+		if (!instance->SetProfiling(argv[2] == "start")) {
+			IConsolePrint(CC_ERROR, "The script is not running.");
+			return true;
+		}
+		IConsolePrint(CC_DEFAULT, "Profiling {}.", argv[2] == "start" ? "started" : "stopped");
+		return true;
+	}
+
+	if (argv[2] == "print") {
+		size_t count = 10;
+		if (argv.size() > 3) {
+			auto value = ParseInteger<size_t>(argv[3]);
+			if (!value.has_value()) return false;
+			count = *value;
+		}
+		for (const std::string &line : instance->LogProfileSummary(count)) IConsolePrint(CC_DEFAULT, "{}", line);
+		return true;
+	}
+
+	if (argv[2] == "dump" && argv.size() == 4) {
+		auto f = FileHandle::Open(argv[3], "wb");
+		if (!f.has_value()) {
+			IConsolePrint(CC_ERROR, "Could not open '{}' for writing.", argv[3]);
+			return true;
+		}
+		fmt::print(*f, "{}", instance->GetProfileFoldedStacks());
+		IConsolePrint(CC_DEFAULT, "Call stacks written to '{}'.", argv[3]);
+		return true;
+	}
+
+	return false;
+}
+
+static bool ConSaveLoadBenchmark(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Load a savegame a number of times, and show how long loading and saving each chunk takes. Usage: 'savebench <file | number> [<count>]'.");
+		IConsolePrint(CC_HELP, "The count defaults to 5.");
+		return true;
+	}
+
+	if (argv.size() < 2 || argv.size() > 3) return false;
+
+	uint count = 5;
+	if (argv.size() == 3) {
+		auto value = ParseType<uint>(argv[2]);
+		if (!value.has_value() || *value == 0) return false;
+		count = *value;
+	}
+
+	std::string_view file = argv[1];
+	_console_file_list_savegame.ValidateFileList();
+	const FiosItem *item = _console_file_list_savegame.FindItem(file);
+	if (item == nullptr) {
+		IConsolePrint(CC_ERROR, "'{}' cannot be found.", file);
+		return true;
+	}
+	if (item->type.abstract != FT_SAVEGAME) {
+		IConsolePrint(CC_ERROR, "'{}' is not a savegame.", file);
+		return true;
+	}
+
+	_switch_mode = SM_LOAD_GAME;
+	_file_to_saveload.Set(*item);
+	StartSaveLoadBenchmark(count);
+	return true;
+}
+
+static bool ConTrace(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Capture a timeline of the game loop, drawing, saving, loading, scripts and more. Usage: 'trace start | stop | abort'.");
+		IConsolePrint(CC_HELP, "'trace stop' writes the capture in the trace event format, for chrome://tracing or ui.perfetto.dev.");
+		return true;
+	}
+
+	if (argv.size() != 2) return false;
+
+	if (argv[1] == "start") {
+		StartTraceCapture();
+		IConsolePrint(CC_DEBUG, "Started capturing a trace.");
+		return true;
+	}
+
+	if (!_trace_capturing) {
+		IConsolePrint(CC_ERROR, "No trace is being captured.");
+		return true;
+	}
+
+	if (argv[1] == "stop") {
+		std::string filename = fmt::format("{}trace-{:%Y%m%d-%H%M%S}.json", FiosGetScreenshotDir(), fmt::localtime(time(nullptr)));
+		size_t count = GetTraceEventCount();
+		if (StopTraceCapture(filename)) {
+			IConsolePrint(CC_DEBUG, "Wrote {} events to '{}'.", count, filename);
+		} else {
+			IConsolePrint(CC_ERROR, "Failed to open '{}' for writing.", filename);
+		}
+		return true;
+	}
+
+	if (argv[1] == "abort") {
+		AbortTraceCapture();
+		IConsolePrint(CC_DEBUG, "Discarded the trace.");
+		return true;
+	}
+
+	return false;
+}
+
+static bool ConCacheCheck(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Check the cargo caches of a few vehicles and stations every tick, and report mismatches. Usage: 'cachecheck [start [<vehicles> [<stations> [<budget-us>]]] | stop | reset]'.");
+		IConsolePrint(CC_HELP, "By default 16 vehicles and 4 stations are checked per tick, in at most 200 microseconds. Without arguments the findings are shown.");
+		return true;
+	}
+
+	if (argv.size() == 1) {
+		ConPrintSampledCacheCheck();
+		return true;
+	}
+
+	if (argv[1] == "start" && argv.size() <= 5) {
+		uint values[] = { 16, 4, 200 };
+		for (size_t i = 2; i < argv.size(); i++) {
+			auto value = ParseInteger(argv[i]);
+			if (!value.has_value()) return false;
+			values[i - 2] = *value;
+		}
+		StartSampledCacheCheck(values[0], values[1], std::chrono::microseconds(values[2]));
+		IConsolePrint(CC_DEBUG, "Started checking {} vehicles and {} stations per tick, in at most {} us.", values[0], values[1], values[2]);
+		return true;
+	}
+
+	if (argv.size() != 2) return false;
+
+	if (argv[1] == "stop") {
+		StopSampledCacheCheck();
+		IConsolePrint(CC_DEBUG, "Stopped the cache check.");
+		return true;
+	}
+
+	if (argv[1] == "reset") {
+		ResetSampledCacheCheckStats();
+		return true;
+	}
+
+	return false;
+}
+
+static bool ConGenerateWorldBenchmark(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Generate a number of new games in a row, and show how long each step of the world generation takes. Usage: 'genbench [<count> [<seed>]]'.");
+		IConsolePrint(CC_HELP, "The count defaults to 5. The first game uses the given seed, 1 by default, and every next game the next seed.");
+		IConsolePrint(CC_HELP, "The map size and all other settings are those used for a new game.");
+		return true;
+	}
+
+	if (argv.size() > 3) return false;
+
+	uint count = 5;
+	if (argv.size() >= 2) {
+		auto value = ParseType<uint>(argv[1]);
+		if (!value.has_value() || *value == 0) return false;
+		count = *value;
+	}
+
+	uint32_t seed = 1;
+	if (argv.size() == 3) {
+		auto value = ParseType<uint32_t>(argv[2]);
+		if (!value.has_value() || *value == GENERATE_NEW_SEED) {
+			IConsolePrint(CC_ERROR, "The given seed must be a valid number.");
+			return true;
+		}
+		seed = *value;
+	}
+
+	if (_game_mode == GM_EDITOR) {
+		IConsolePrint(CC_ERROR, "The world generation benchmark cannot be run in the scenario editor.");
+		return true;
+	}
+
+	StartGenerateWorldBenchmark(count, seed);
+	StartNewGameWithoutGUI(seed);
+	return true;
+}
+
 static bool ConFramerateWindow(std::span<std::string_view> argv)
 {
 	if (argv.empty()) {
@@ -2855,12 +3165,18 @@ static void ConDumpCargoTypes()
 	}
 }
 
+static void ConDumpMap()
+{
+	IConsolePrint(CC_DEFAULT, "  Size: {}x{} ({} tiles)", Map::SizeX(), Map::SizeY(), Map::Size());
+	IConsolePrint(CC_DEFAULT, "  Huge pages: {}", Map::HasHugePages() ? "advised" : "unavailable");
+}
+
 static bool ConDumpInfo(std::span<std::string_view> argv)
 {
 	if (argv.size() != 2) {
 		IConsolePrint(CC_HELP, "Dump debugging information.");
-		IConsolePrint(CC_HELP, "Usage: 'dump_info roadtypes|railtypes|cargotypes'.");
-		IConsolePrint(CC_HELP, "  Show information about road/tram types, rail types or cargo types.");
+		IConsolePrint(CC_HELP, "Usage: 'dump_info roadtypes|railtypes|cargotypes|map'.");
+		IConsolePrint(CC_HELP, "  Show information about road/tram types, rail types, cargo types or the map.");
 		return true;
 	}
 
@@ -2879,6 +3195,11 @@ static bool ConDumpInfo(std::span<std::string_view> argv)
 		return true;
 	}
 
+	if (StrEqualsIgnoreCase(argv[1], "map")) {
+		ConDumpMap();
+		return true;
+	}
+
 	return false;
 }
 
@@ -3022,6 +3343,16 @@ void IConsoleStdLibRegister()
 #endif
 	IConsole::CmdRegister("fps",                     ConFramerate);
 	IConsole::CmdRegister("fps_wnd",                 ConFramerateWindow);
+	IConsole::CmdRegister("pfstats",                 ConPathfinderStats);
+	IConsole::CmdRegister("grfstats",                ConNewGRFCallbackStats);
+	IConsole::CmdRegister("rpcstats",                ConRpcStats);
+	IConsole::CmdRegister("spritecache",             ConSpriteCacheStats);
+	IConsole::CmdRegister("mem",                     ConMemoryReport);
+	IConsole::CmdRegister("script_profile",          ConScriptProfile,    ConHookServerOrNoNetwork);
+	IConsole::CmdRegister("savebench",               ConSaveLoadBenchmark);
+	IConsole::CmdRegister("genbench",                ConGenerateWorldBenchmark);
+	IConsole::CmdRegister("trace",                   ConTrace);
+	IConsole::CmdRegister("cachecheck",              ConCacheCheck);
 
 	/* NewGRF development stuff */
 	IConsole::CmdRegister("reload_newgrfs",          ConNewGRFReload,     ConHookNewGRFDeveloperTool);
@@ -76,6 +76,27 @@ DEFINE_POOL_METHOD(inline size_t)::FindFirstFree()
 	return NO_FREE_ITEM;
 }
 
+/**
+ * Allocate memory for Tgrowth_step more items of a caching pool, and put it in the cache.
+ * Taking the items from one block keeps items allocated one after another close together
+ * in memory, and saves a separate allocation per item for pools that churn a lot of items.
+ * @pre Tcache
+ */
+DEFINE_POOL_METHOD(inline void)::AllocateChunk()
+{
+	static_assert(alignof(Titem) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+	static_assert(sizeof(Titem) >= sizeof(AllocCache));
+
+	uint8_t *chunk = this->chunks.emplace_back(new uint8_t[Tgrowth_step * sizeof(Titem)]).get();
+
+	/* Push the items in reverse, so they are handed out in order of their address. */
+	for (size_t i = Tgrowth_step; i-- > 0;) {
+		AllocCache *ac = reinterpret_cast<AllocCache *>(chunk + i * sizeof(Titem));
+		ac->next = this->alloc_cache;
+		this->alloc_cache = ac;
+	}
+}
+
 /**
  * Makes given index valid
  * @param size size of item
@@ -91,8 +112,9 @@ DEFINE_POOL_METHOD(inline void *)::AllocateItem(size_t size, size_t index)
 	this->items++;
 
 	Titem *item;
-	if (Tcache && this->alloc_cache != nullptr) {
+	if constexpr (Tcache) {
 		assert(sizeof(Titem) == size);
+		if (this->alloc_cache == nullptr) this->AllocateChunk();
 		item = reinterpret_cast<Titem *>(this->alloc_cache);
 		this->alloc_cache = this->alloc_cache->next;
 	} else {
@@ -192,11 +214,10 @@ DEFINE_POOL_METHOD(void)::CleanPool()
 	this->cleaning = false;
 
 	if (Tcache) {
-		while (this->alloc_cache != nullptr) {
-			AllocCache *ac = this->alloc_cache;
-			this->alloc_cache = ac->next;
-			this->allocator.deallocate(reinterpret_cast<uint8_t*>(ac), sizeof(Titem));
-		}
+		/* All items are back in the cache, which only points into the chunks. */
+		this->alloc_cache = nullptr;
+		this->chunks.clear();
+		this->chunks.shrink_to_fit();
 	}
 }
 
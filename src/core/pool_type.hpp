@@ -111,6 +111,20 @@ struct PoolBase {
 	 */
 	virtual void CleanPool() = 0;
 
+	/** Memory used by a pool. */
+	struct MemoryUsage {
+		std::string_view name; ///< Name of the pool.
+		size_t items; ///< Number of items in the pool.
+		size_t capacity; ///< Number of items the pool has room for before it grows.
+		size_t bytes; ///< Bytes of the pool and its items, not counting what the items allocate themselves.
+	};
+
+	/**
+	 * Get the memory used by this pool.
+	 * @return The memory usage.
+	 */
+	virtual MemoryUsage GetMemoryUsage() const = 0;
+
 private:
 	/**
 	 * Dummy private copy constructor to prevent compilers from
@@ -125,7 +139,8 @@ private:
  * @tparam Tindex       Type of the index for this pool
  * @tparam Tgrowth_step Size of growths; if the pool is full increase the size by this amount
  * @tparam Tpool_type   Type of this pool
- * @tparam Tcache       Whether to perform 'alloc' caching, i.e. don't actually deallocated/allocate just reuse the memory
+ * @tparam Tcache       Whether to perform 'alloc' caching, i.e. don't actually deallocated/allocate just reuse the memory;
+ *                      the memory is then allocated in blocks of Tgrowth_step items
  * @warning when Tcache is enabled *all* instances of this pool's item must be of the same size.
  */
 template <class Titem, typename Tindex, size_t Tgrowth_step, PoolType Tpool_type = PoolType::Normal, bool Tcache = false>
@@ -153,6 +168,14 @@ public:
 	Pool(std::string_view name) : PoolBase(Tpool_type), name(name) {}
 	void CleanPool() override;
 
+	MemoryUsage GetMemoryUsage() const override
+	{
+		size_t bytes = this->data.capacity() * sizeof(Titem *) + this->used_bitmap.capacity() * sizeof(BitmapStorage);
+		/* Items of a caching pool live in chunks that are never freed; others are allocated one by one. */
+		bytes += (Tcache ? this->chunks.size() * Tgrowth_step : this->items) * sizeof(Titem);
+		return {this->name, this->items, this->data.size(), bytes};
+	}
+
 	/**
 	 * Returns Titem with given index
 	 * @param index of item to get
@@ -451,6 +474,10 @@ private:
 	/** Cache of freed pointers */
 	AllocCache *alloc_cache = nullptr;
 	std::allocator<uint8_t> allocator{};
+	/** Blocks of Tgrowth_step items each, that the items of a caching pool are allocated from. */
+	std::vector<std::unique_ptr<uint8_t[]>> chunks{};
+
+	void AllocateChunk();
 
 	void *AllocateItem(size_t size, size_t index);
 	void ResizeFor(size_t index);
@@ -42,6 +42,73 @@ struct Randomizer {
 extern Randomizer _random; ///< Random used in the game state calculations
 extern Randomizer _interactive_random; ///< Random used everywhere else, where it does not (directly) influence the game state
 
+/**
+ * Counter based pseudo random number generator, using Philox4x32-10.
+ * Contrary to Randomizer it has no state that changes: every number is computed
+ * from the key of the randomizer and a counter, for example a tile and a tick.
+ * The numbers for different counters can therefore be computed in any order and
+ * on any thread, while still being the same on every machine, without touching
+ * the sequence of _random.
+ */
+struct CounterRandomizer {
+	std::array<uint32_t, 2> key; ///< The key, for example the seed of the game and a number per use.
+
+	/**
+	 * Create the randomizer.
+	 * @param seed The seed, for example one drawn from _random.
+	 * @param stream Number to tell different uses with the same seed apart.
+	 */
+	constexpr CounterRandomizer(uint32_t seed, uint32_t stream) : key{seed, stream} {}
+
+	/**
+	 * Compute the four random numbers for a counter.
+	 * @param counter The counter.
+	 * @return The random numbers.
+	 */
+	constexpr std::array<uint32_t, 4> Generate(std::array<uint32_t, 4> counter) const
+	{
+		std::array<uint32_t, 2> k = this->key;
+		for (int round = 0; round < 10; round++) {
+			if (round != 0) {
+				k[0] += 0x9E3779B9;
+				k[1] += 0xBB67AE85;
+			}
+			uint64_t p0 = static_cast<uint64_t>(0xD2511F53) * counter[0];
+			uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57) * counter[2];
+			counter = {
+				static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ k[0], static_cast<uint32_t>(p1),
+				static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ k[1], static_cast<uint32_t>(p0),
+			};
+		}
+		return counter;
+	}
+
+	/**
+	 * Get the random number for a place and moment.
+	 * @param a The first part of the counter, for example a tile index.
+	 * @param b The second part of the counter, for example a tick counter.
+	 * @param index The number of the random number for the same \a a and \a b.
+	 * @return The random number.
+	 */
+	constexpr uint32_t Get(uint32_t a, uint32_t b, uint32_t index = 0) const
+	{
+		return this->Generate({a, b, index, 0})[0];
+	}
+
+	/**
+	 * Get the random number for a place and moment, scaled to \a limit, excluding \a limit itself.
+	 * @param a The first part of the counter, for example a tile index.
+	 * @param b The second part of the counter, for example a tick counter.
+	 * @param index The number of the random number for the same \a a and \a b.
+	 * @param limit Limit of the range to be generated from.
+	 * @return Random number in [0,\a limit)
+	 */
+	constexpr uint32_t GetRange(uint32_t a, uint32_t b, uint32_t index, uint32_t limit) const
+	{
+		return ScaleToLimit(this->Get(a, b, index), limit);
+	}
+};
+
 /** Stores the state of all random number generators */
 struct SavedRandomSeeds {
 	Randomizer random;
@@ -14,7 +14,9 @@
 #include "string_func.h"
 #include "fileio_func.h"
 #include "settings_type.h"
+#include "thread.h"
 #include <mutex>
+#include <condition_variable>
 
 #if defined(_WIN32)
 #include "os/windows/win32.h"
@@ -102,6 +104,201 @@ void DumpDebugFacilityNames(std::back_insert_iterator<std::string> &output_itera
 	}
 }
 
+/** Destination of a line of debug output. */
+enum class DebugOutput : uint8_t {
+	Stderr, ///< The standard error output.
+	Desync, ///< The commands-out.log file with the commands for desync debugging.
+#ifdef RANDOM_DEBUG
+	Random, ///< The random-out.log file with the calls to the randomizer.
+#endif
+};
+
+/**
+ * Write a line of debug output.
+ * @param output Where to write the line to.
+ * @param line The line, including the prefix and the newline.
+ */
+static void WriteDebugOutput(DebugOutput output, std::string_view line)
+{
+	switch (output) {
+		case DebugOutput::Stderr:
+			fmt::print(stderr, "{}", line);
+			break;
+
+		case DebugOutput::Desync: {
+			static auto f = FioFOpenFile("commands-out.log", "wb", AUTOSAVE_DIR);
+			if (!f.has_value()) return;
+
+			fmt::print(*f, "{}", line);
+			fflush(*f);
+			break;
+		}
+
+#ifdef RANDOM_DEBUG
+		case DebugOutput::Random: {
+			static auto f = FioFOpenFile("random-out.log", "wb", AUTOSAVE_DIR);
+			if (!f.has_value()) return;
+
+			fmt::print(*f, "{}", line);
+			fflush(*f);
+			break;
+		}
+#endif
+	}
+}
+
+/**
+ * Writes the debug output on a separate thread, so enabling detailed debug levels
+ * on a running game or server does not make the calling thread wait for the output.
+ * Errors and severe warnings (level 0) and the desync and random logs are still
+ * written immediately, after all lines queued before them, so nothing is lost when
+ * they precede a crash or desync.
+ */
+class DebugOutputWriter {
+	/** A line of debug output waiting to be written. */
+	struct Item {
+		DebugOutput output; ///< Where to write the line to.
+		std::string line; ///< The line to write, including the prefix and the newline.
+	};
+
+	std::mutex queue_mutex; ///< Mutex to guard the queue and the state of the thread.
+	std::condition_variable queue_signal; ///< Signal that lines were queued, or the thread must stop.
+	std::vector<Item> queue; ///< Lines waiting to be written.
+	std::mutex write_mutex; ///< Mutex to keep the lines in order while writing them.
+	std::thread thread; ///< The thread writing the queued lines.
+	bool started = false; ///< Whether starting the thread was tried.
+	bool stop = false; ///< Whether the thread must stop.
+
+	/**
+	 * Write all queued lines. The caller must hold the write mutex.
+	 * @param lock The lock on the queue mutex; it is released while writing.
+	 * @param spare Storage to swap the queue with.
+	 */
+	void WriteQueued(std::unique_lock<std::mutex> &lock, std::vector<Item> &spare)
+	{
+		std::swap(this->queue, spare);
+		lock.unlock();
+		for (const Item &item : spare) WriteDebugOutput(item.output, item.line);
+		spare.clear();
+		lock.lock();
+	}
+
+	/** Write queued lines until told to stop. */
+	void Run()
+	{
+		std::vector<Item> spare;
+		std::unique_lock<std::mutex> lock(this->queue_mutex);
+		for (;;) {
+			this->queue_signal.wait(lock, [this]() { return this->stop || !this->queue.empty(); });
+			if (this->queue.empty()) return;
+
+			/* Take the write mutex first, to not deadlock with Write. */
+			lock.unlock();
+			std::lock_guard<std::mutex> write_lock(this->write_mutex);
+			lock.lock();
+			this->WriteQueued(lock, spare);
+		}
+	}
+
+public:
+	~DebugOutputWriter()
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->queue_mutex);
+			this->stop = true;
+		}
+		this->queue_signal.notify_one();
+		if (this->thread.joinable()) this->thread.join();
+	}
+
+	/**
+	 * Write a line of debug output.
+	 * @param output Where to write the line to.
+	 * @param line The line, including the prefix and the newline.
+	 * @param immediate Whether to write the line before returning.
+	 */
+	void Write(DebugOutput output, std::string &&line, bool immediate)
+	{
+		std::unique_lock<std::mutex> lock(this->queue_mutex);
+		if (!immediate && !this->stop) {
+			if (!this->started) {
+				this->started = true;
+				StartNewThread(&this->thread, "ottd:debug", [this]() { this->Run(); });
+			}
+			if (this->thread.joinable()) {
+				this->queue.emplace_back(output, std::move(line));
+				lock.unlock();
+				this->queue_signal.notify_one();
+				return;
+			}
+		}
+
+		/* Write the queued lines first, to keep the output in order. */
+		lock.unlock();
+		std::lock_guard<std::mutex> write_lock(this->write_mutex);
+		lock.lock();
+		if (!this->queue.empty()) {
+			std::vector<Item> spare;
+			this->WriteQueued(lock, spare);
+		}
+		lock.unlock();
+		WriteDebugOutput(output, line);
+	}
+
+	/**
+	 * Write all queued lines and keep the writer locked until AfterFork,
+	 * so the writer thread holds no lock and no buffered output while forking.
+	 */
+	void PrepareFork()
+	{
+		this->write_mutex.lock();
+		std::unique_lock<std::mutex> lock(this->queue_mutex);
+		std::vector<Item> spare;
+		while (!this->queue.empty()) this->WriteQueued(lock, spare);
+		lock.release();
+	}
+
+	/**
+	 * Unlock the writer after forking.
+	 * @param child Whether this is the forked child, which has no writer thread.
+	 */
+	void AfterFork(bool child)
+	{
+		/* Make the child write its lines itself. */
+		if (child) this->stop = true;
+		this->queue_mutex.unlock();
+		this->write_mutex.unlock();
+	}
+};
+
+/**
+ * Get the writer of all debug output.
+ * @return The writer, constructed on first use so debug output during static initialisation works.
+ */
+static DebugOutputWriter &GetDebugOutputWriter()
+{
+	static DebugOutputWriter writer;
+	return writer;
+}
+
+/**
+ * Prepare the debug output for a fork(); call DebugAfterFork in both processes afterwards.
+ * All queued lines are written first, so they are neither lost nor written twice.
+ */
+void DebugPrepareFork()
+{
+	GetDebugOutputWriter().PrepareFork();
+}
+
+/**
+ * Continue the debug output after a fork().
+ * @param child Whether this is the forked child.
+ */
+void DebugAfterFork(bool child)
+{
+	GetDebugOutputWriter().AfterFork(child);
+}
+
 /**
  * Internal function for outputting the debug line.
  * @param level Debug category.
@@ -110,21 +307,13 @@ void DumpDebugFacilityNames(std::back_insert_iterator<std::string> &output_itera
 void DebugPrint(std::string_view category, int level, std::string &&message)
 {
 	if (category == "desync" && level != 0) {
-		static auto f = FioFOpenFile("commands-out.log", "wb", AUTOSAVE_DIR);
-		if (!f.has_value()) return;
-
-		fmt::print(*f, "{}{}\n", GetLogPrefix(true), message);
-		fflush(*f);
+		GetDebugOutputWriter().Write(DebugOutput::Desync, fmt::format("{}{}\n", GetLogPrefix(true), message), true);
 #ifdef RANDOM_DEBUG
 	} else if (category == "random") {
-		static auto f = FioFOpenFile("random-out.log", "wb", AUTOSAVE_DIR);
-		if (!f.has_value()) return;
-
-		fmt::print(*f, "{}\n", message);
-		fflush(*f);
+		GetDebugOutputWriter().Write(DebugOutput::Random, fmt::format("{}\n", message), true);
 #endif
 	} else {
-		fmt::print(stderr, "{}dbg: [{}:{}] {}\n", GetLogPrefix(true), category, level, message);
+		GetDebugOutputWriter().Write(DebugOutput::Stderr, fmt::format("{}dbg: [{}:{}] {}\n", GetLogPrefix(true), category, level, message), level == 0);
 
 		if (_debug_remote_console.load()) {
 			/* Only add to the queue when there is at least one consumer of the data. */
@@ -137,4 +137,7 @@ std::string GetLogPrefix(bool force = false);
 void DebugSendRemoteMessages();
 void DebugReconsiderSendRemoteMessages();
 
+void DebugPrepareFork();
+void DebugAfterFork(bool child);
+
 #endif /* DEBUG_H */
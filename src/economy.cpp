@@ -56,6 +56,9 @@
 #include "timer/timer.h"
 #include "timer/timer_game_calendar.h"
 #include "timer/timer_game_economy.h"
+#include "rpc/rpc_connectivity.h"
+#include "rpc/rpc_engine_cache.h"
+#include "pathfinder/yapf/yapf_cache.h"
 
 #include "table/strings.h"
 #include "table/pricebase.h"
@@ -106,50 +109,97 @@ Economy _economy;
 Prices _price;
 static PriceMultipliers _price_base_multiplier;
 
+/** Figures of the vehicles and stations of a company, for its value and performance rating. */
+struct CompanyAssetStats {
+	Money vehicle_value = 0; ///< Value of the vehicles that count for the company value.
+	uint station_facilities = 0; ///< Number of facilities of all stations.
+	uint serviced_station_facilities = 0; ///< Number of facilities of the stations that were serviced recently.
+	uint profitable_vehicles = 0; ///< Number of primary vehicles that made a profit last year.
+	Money min_profit = 0; ///< Lowest profit last year of the primary vehicles old enough to count.
+	bool has_min_profit = false; ///< Whether any primary vehicle is old enough for #min_profit.
+};
+
+/** Asset figures of all companies. */
+using CompanyAssetStatsArray = TypedIndexContainer<std::array<CompanyAssetStats, MAX_COMPANIES>, CompanyID>;
+
 /**
- * Calculate the value of the assets of a company.
- *
- * @param c The company to calculate the value of.
- * @return The value of the assets of the company.
+ * Collect the asset figures of all companies in a single pass over the vehicles and stations.
+ * @param[out] stats The figures per company.
  */
-static Money CalculateCompanyAssetValue(const Company *c)
+static void GetCompanyAssetStats(CompanyAssetStatsArray &stats)
 {
-	Owner owner = c->index;
-
-	uint num = 0;
+	stats.fill({});
 
 	for (const Station *st : Station::Iterate()) {
-		if (st->owner == owner) num += st->facilities.Count();
-	}
+		if (st->owner.base() >= MAX_COMPANIES) continue;
 
-	Money value = num * _price[PR_STATION_VALUE] * 25;
+		CompanyAssetStats &s = stats[st->owner];
+		uint facilities = st->facilities.Count();
+		s.station_facilities += facilities;
+		/* Only count stations that are actually serviced */
+		if (st->time_since_load <= 20 || st->time_since_unload <= 20) s.serviced_station_facilities += facilities;
+	}
 
 	for (const Vehicle *v : Vehicle::Iterate()) {
-		if (v->owner != owner) continue;
+		if (v->owner.base() >= MAX_COMPANIES) continue;
 
+		CompanyAssetStats &s = stats[v->owner];
 		if (v->type == VEH_TRAIN ||
 				v->type == VEH_ROAD ||
 				(v->type == VEH_AIRCRAFT && Aircraft::From(v)->IsNormalAircraft()) ||
 				v->type == VEH_SHIP) {
-			value += v->value * 3 >> 1;
+			s.vehicle_value += v->value * 3 >> 1;
+		}
+
+		if (IsCompanyBuildableVehicleType(v->type) && v->IsPrimaryVehicle()) {
+			if (v->profit_last_year > 0) s.profitable_vehicles++; // For the vehicle score only count profitable vehicles
+			if (v->economy_age > VEHICLE_PROFIT_MIN_AGE) {
+				/* Find the vehicle with the lowest amount of profit */
+				if (!s.has_min_profit || s.min_profit > v->profit_last_year) {
+					s.min_profit = v->profit_last_year;
+					s.has_min_profit = true;
+				}
+			}
 		}
 	}
+}
 
+/**
+ * Calculate the value of the assets of a company.
+ *
+ * @param stats The asset figures of the company.
+ * @return The value of the assets of the company.
+ */
+static Money CalculateCompanyAssetValue(const CompanyAssetStats &stats)
+{
+	Money value = stats.station_facilities * _price[PR_STATION_VALUE] * 25;
+	value += stats.vehicle_value;
 	return value;
 }
 
 /**
- * Calculate the value of the company. That is the value of all
- * assets (vehicles, stations) and money (including loan),
- * except when including_loan is \c false which is useful when
- * we want to calculate the value for bankruptcy.
+ * Calculate the value of the assets of a company.
+ *
+ * @param c The company to calculate the value of.
+ * @return The value of the assets of the company.
+ */
+static Money CalculateCompanyAssetValue(const Company *c)
+{
+	CompanyAssetStatsArray stats;
+	GetCompanyAssetStats(stats);
+	return CalculateCompanyAssetValue(stats[c->index]);
+}
+
+/**
+ * Calculate the value of the company from the value of its assets.
  * @param c the company to get the value of.
+ * @param asset_value the value of the assets of the company.
  * @param including_loan include the loan in the company value.
  * @return the value of the company.
  */
-Money CalculateCompanyValue(const Company *c, bool including_loan)
+static Money CalculateCompanyValue(const Company *c, Money asset_value, bool including_loan)
 {
-	Money value = CalculateCompanyAssetValue(c);
+	Money value = asset_value;
 
 	/* Add real money value */
 	if (including_loan) value -= c->current_loan;
@@ -158,6 +208,20 @@ Money CalculateCompanyValue(const Company *c, bool including_loan)
 	return std::max<Money>(value, 1);
 }
 
+/**
+ * Calculate the value of the company. That is the value of all
+ * assets (vehicles, stations) and money (including loan),
+ * except when including_loan is \c false which is useful when
+ * we want to calculate the value for bankruptcy.
+ * @param c the company to get the value of.
+ * @param including_loan include the loan in the company value.
+ * @return the value of the company.
+ */
+Money CalculateCompanyValue(const Company *c, bool including_loan)
+{
+	return CalculateCompanyValue(c, CalculateCompanyAssetValue(c), including_loan);
+}
+
 /**
  * Calculate what you have to pay to take over a company.
  *
@@ -196,10 +260,11 @@ Money CalculateHostileTakeoverValue(const Company *c)
  *  (also the house is updated, should only be true in the on-tick event)
  * @param update the economy with calculated score
  * @param c company been evaluated
+ * @param stats the asset figures of the company
  * @return actual score of this company
  *
  */
-int UpdateCompanyRatingAndValue(Company *c, bool update)
+static int UpdateCompanyRatingAndValue(Company *c, bool update, const CompanyAssetStats &stats)
 {
 	Owner owner = c->index;
 	int score = 0;
@@ -208,27 +273,9 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 
 	/* Count vehicles */
 	{
-		Money min_profit = 0;
-		bool min_profit_first = true;
-		uint num = 0;
-
-		for (const Vehicle *v : Vehicle::Iterate()) {
-			if (v->owner != owner) continue;
-			if (IsCompanyBuildableVehicleType(v->type) && v->IsPrimaryVehicle()) {
-				if (v->profit_last_year > 0) num++; // For the vehicle score only count profitable vehicles
-				if (v->economy_age > VEHICLE_PROFIT_MIN_AGE) {
-					/* Find the vehicle with the lowest amount of profit */
-					if (min_profit_first || min_profit > v->profit_last_year) {
-						min_profit = v->profit_last_year;
-						min_profit_first = false;
-					}
-				}
-			}
-		}
-
-		min_profit >>= 8; // remove the fract part
+		Money min_profit = stats.min_profit >> 8; // remove the fract part
 
-		_score_part[owner][SCORE_VEHICLES] = num;
+		_score_part[owner][SCORE_VEHICLES] = stats.profitable_vehicles;
 		/* Don't allow negative min_profit to show */
 		if (min_profit > 0) {
 			_score_part[owner][SCORE_MIN_PROFIT] = min_profit;
@@ -237,12 +284,7 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 
 	/* Count stations */
 	{
-		uint num = 0;
-		for (const Station *st : Station::Iterate()) {
-			/* Only count stations that are actually serviced */
-			if (st->owner == owner && (st->time_since_load <= 20 || st->time_since_unload <= 20)) num += st->facilities.Count();
-		}
-		_score_part[owner][SCORE_STATIONS] = num;
+		_score_part[owner][SCORE_STATIONS] = stats.serviced_station_facilities;
 	}
 
 	/* Generate statistics depending on recent income statistics */
@@ -307,13 +349,28 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 	if (update) {
 		c->old_economy[0].performance_history = score;
 		UpdateCompanyHQ(c->location_of_HQ, score);
-		c->old_economy[0].company_value = CalculateCompanyValue(c);
+		c->old_economy[0].company_value = CalculateCompanyValue(c, CalculateCompanyAssetValue(stats), true);
 	}
 
 	SetWindowDirty(WC_PERFORMANCE_DETAIL, 0);
 	return score;
 }
 
+/**
+ * if update is set to true, the economy is updated with this score
+ *  (also the house is updated, should only be true in the on-tick event)
+ * @param update the economy with calculated score
+ * @param c company been evaluated
+ * @return actual score of this company
+ *
+ */
+int UpdateCompanyRatingAndValue(Company *c, bool update)
+{
+	CompanyAssetStatsArray stats;
+	GetCompanyAssetStats(stats);
+	return UpdateCompanyRatingAndValue(c, update, stats[c->index]);
+}
+
 /**
  * Change the ownership of all the items of a company.
  * @param old_owner The company that gets removed.
@@ -477,6 +534,9 @@ void ChangeOwnershipOfCompanyItems(Owner old_owner, Owner new_owner)
 		for (const auto tile : Map::Iterate()) {
 			ChangeTileOwner(tile, old_owner, new_owner);
 		}
+		RpcInvalidateConnectivity();
+		YapfNotifyRoadLayoutChange(INVALID_TILE);
+		YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
 
 		if (new_owner != INVALID_OWNER) {
 			/* Update all signals because there can be new segment that was owned by two companies
@@ -676,6 +736,10 @@ static void CompaniesGenStatistics()
 	/* Only run the economic statistics and update company stats every 3rd economy month (1st of quarter). */
 	if (!HasBit(1 << 0 | 1 << 3 | 1 << 6 | 1 << 9, TimerGameEconomy::month)) return;
 
+	/* The vehicles and stations don't change while the companies are rated, so collect their figures once. */
+	CompanyAssetStatsArray stats;
+	GetCompanyAssetStats(stats);
+
 	for (Company *c : Company::Iterate()) {
 		/* Drop the oldest history off the end */
 		std::copy_backward(c->old_economy.data(), c->old_economy.data() + MAX_HISTORY_QUARTERS - 1, c->old_economy.data() + MAX_HISTORY_QUARTERS);
@@ -684,7 +748,7 @@ static void CompaniesGenStatistics()
 
 		if (c->num_valid_stat_ent != MAX_HISTORY_QUARTERS) c->num_valid_stat_ent++;
 
-		UpdateCompanyRatingAndValue(c, true);
+		UpdateCompanyRatingAndValue(c, true, stats[c->index]);
 		if (c->block_preview != 0) c->block_preview--;
 	}
 
@@ -741,6 +805,9 @@ bool AddInflation(bool check_year)
  */
 void RecomputePrices()
 {
+	/* Engine costs follow the prices. */
+	RpcInvalidateEngineCache();
+
 	/* Setup maximum loan as a rounded down multiple of LOAN_INTERVAL. */
 	_economy.max_loan = ((uint64_t)_settings_game.difficulty.max_loan * _economy.inflation_prices >> 16) / LOAN_INTERVAL * LOAN_INTERVAL;
 
@@ -1213,6 +1280,9 @@ CargoPayment::~CargoPayment()
  * @param cp The cargo packet to pay for.
  * @param count The number of packets to pay for.
  * @param current_tile Current tile the payment is happening on.
+ * @note Packets are paid one at a time on purpose. The income is rounded per packet, and
+ *       the acceptance by industries, subsidies and cargo monitors depend on the source of
+ *       each packet, so summing the packets of a cargo first would change the payment.
  */
 void CargoPayment::PayFinalDelivery(CargoType cargo, const CargoPacket *cp, uint count, TileIndex current_tile)
 {
@@ -62,9 +62,12 @@
 #include "elrail_func.h"
 #include "company_base.h"
 #include "newgrf_railtype.h"
+#include "rpc/rpc_engine_cache.h"
 
 #include "table/elrail_data.h"
 
+#include <unordered_map>
+
 #include "safeguards.h"
 
 /**
@@ -256,11 +259,63 @@ void DrawRailCatenaryOnTunnel(const TileInfo *ti)
 	AddSortableSpriteToDraw(wire_base + sss.image_offset, PAL_NONE, ti->x, ti->y, GetTilePixelZ(ti->tile), sss, IsTransparencySet(TO_CATENARY));
 }
 
+/** A pylon of a tile, see #CatenaryLayout. */
+struct CatenaryPylon {
+	DiagDirection pcp; ///< The pylon control point the pylon stands at.
+	Direction ppp; ///< The pylon position point of the pylon.
+	bool halftile; ///< Whether the pylon uses the sprites of the upper half of a half tile slope.
+	int16_t z; ///< Elevation of the pylon.
+};
+
+/** A wire of a tile, see #CatenaryLayout. */
+struct CatenaryWire {
+	RailCatenarySprite sprite; ///< The sprite data of the wire.
+	bool halftile; ///< Whether the wire uses the sprites of the upper half of a half tile slope.
+	int16_t z; ///< Elevation of the wire.
+};
+
+/** Where the pylons and wires of a railway tile go; only the sprite bases are resolved when drawing. */
+struct CatenaryLayout {
+	std::array<CatenaryPylon, DIAGDIR_END> pylons; ///< The pylons, at most one per pylon control point.
+	std::array<CatenaryWire, TRACK_END> wires; ///< The wires, at most one per track.
+	uint8_t num_pylons; ///< Number of used entries in #pylons.
+	uint8_t num_wires; ///< Number of used entries in #wires.
+	bool low_bridge; ///< Whether the wires are under a low bridge, and only drawn when bridges are transparent.
+	Corner halftile_corner; ///< Raised corner of a half tile slope, or #CORNER_INVALID.
+};
+
+/** Layouts of the tiles drawn recently, by tile index. */
+static std::unordered_map<uint32_t, CatenaryLayout> _catenary_layouts;
+static const size_t MAX_CATENARY_LAYOUTS = 1 << 17; ///< Number of layouts to keep before starting over.
+
 /**
- * Draws wires and, if required, pylons on a given tile
- * @param ti The Tileinfo to draw the tile for
+ * Forget the catenary layout of a tile and its neighbours, as they depend on each other.
+ * @param tile The tile that changed.
  */
-static void DrawRailCatenaryRailway(const TileInfo *ti)
+void InvalidateCatenaryLayout(TileIndex tile)
+{
+	if (_catenary_layouts.empty()) return;
+
+	_catenary_layouts.erase(tile.base());
+	for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
+		TileIndex neighbour = TileAddByDiagDir(tile, dir);
+		if (neighbour < Map::Size()) _catenary_layouts.erase(neighbour.base());
+	}
+}
+
+/** Forget the catenary layouts of all tiles. */
+void ClearCatenaryLayouts()
+{
+	_catenary_layouts.clear();
+}
+
+/**
+ * Work out where the pylons and wires of a tile go.
+ * This only depends on the map, so the result can be kept till the tile or one of its neighbours changes.
+ * @param ti The Tileinfo of the tile.
+ * @param[out] layout The pylons and wires of the tile.
+ */
+static void ComputeCatenaryLayout(const TileInfo *ti, CatenaryLayout &layout)
 {
 	/* Pylons are placed on a tile edge, so we need to take into account
 	 * the track configuration of 2 adjacent tiles. trackconfig[0] stores the
@@ -298,8 +353,10 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 
 	AdjustTileh(ti->tile, &tileh[TS_HOME]);
 
-	SpriteID pylon_normal = GetPylonBase(ti->tile);
-	SpriteID pylon_halftile = (halftile_corner != CORNER_INVALID) ? GetPylonBase(ti->tile, TCX_UPPER_HALFTILE) : pylon_normal;
+	layout.halftile_corner = halftile_corner;
+	layout.num_pylons = 0;
+	layout.num_wires = 0;
+	layout.low_bridge = false;
 
 	for (DiagDirection i = DIAGDIR_BEGIN; i < DIAGDIR_END; i++) {
 		static const uint edge_corners[] = {
@@ -308,7 +365,7 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 			1 << CORNER_S | 1 << CORNER_W, // DIAGDIR_SW
 			1 << CORNER_N | 1 << CORNER_W, // DIAGDIR_NW
 		};
-		SpriteID pylon_base = (halftile_corner != CORNER_INVALID && HasBit(edge_corners[i], halftile_corner)) ? pylon_halftile : pylon_normal;
+		bool pylon_halftile = halftile_corner != CORNER_INVALID && HasBit(edge_corners[i], halftile_corner);
 		TileIndex neighbour = ti->tile + TileOffsByDiagDir(i);
 		int elevation = GetPCPElevation(ti->tile, i);
 
@@ -415,9 +472,6 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 				Direction temp = ppp_orders[k];
 
 				if (ppp_allowed[i].Test(temp)) {
-					uint x = ti->x + _x_pcp_offsets[i] + _x_ppp_offsets[temp];
-					uint y = ti->y + _y_pcp_offsets[i] + _y_ppp_offsets[temp];
-
 					/* Don't build the pylon if it would be outside the tile */
 					if (!_owned_ppp_on_pcp[i].Test(temp)) {
 						/* We have a neighbour that will draw it, bail out */
@@ -425,10 +479,8 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 						continue; // No neighbour, go looking for a better position
 					}
 
-					AddSortableSpriteToDraw(pylon_base + _pylon_sprites[temp], PAL_NONE, x, y, elevation,
-						{{-1, -1, 0}, {1, 1, BB_HEIGHT_UNDER_BRIDGE}, {1, 1, 0}}, IsTransparencySet(TO_CATENARY));
-
-					break; // We already have drawn a pylon, bail out
+					layout.pylons[layout.num_pylons++] = {i, temp, pylon_halftile, static_cast<int16_t>(elevation)};
+					break; // We already have placed a pylon, bail out
 				}
 			}
 		}
@@ -437,18 +489,16 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 	/* The wire above the tunnel is drawn together with the tunnel-roof (see DrawRailCatenaryOnTunnel()) */
 	if (IsTunnelTile(ti->tile)) return;
 
-	/* Don't draw a wire under a low bridge */
-	if (IsBridgeAbove(ti->tile) && !IsTransparencySet(TO_BRIDGES)) {
+	/* Wires under a low bridge are only drawn when bridges are transparent */
+	if (IsBridgeAbove(ti->tile)) {
 		int height = GetBridgeHeight(GetNorthernBridgeEnd(ti->tile));
 
-		if (height <= GetTileMaxZ(ti->tile) + 1) return;
+		layout.low_bridge = height <= GetTileMaxZ(ti->tile) + 1;
 	}
 
 	/* Don't draw a wire if the station tile does not want any */
 	if (IsRailStationTile(ti->tile) && !CanStationTileHaveWires(ti->tile)) return;
 
-	SpriteID wire_normal = GetWireBase(ti->tile);
-	SpriteID wire_halftile = (halftile_corner != CORNER_INVALID) ? GetWireBase(ti->tile, TCX_UPPER_HALFTILE) : wire_normal;
 	Track halftile_track;
 	switch (halftile_corner) {
 		case CORNER_W: halftile_track = TRACK_LEFT; break;
@@ -458,16 +508,16 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 		default:       halftile_track = INVALID_TRACK; break;
 	}
 
-	/* Drawing of pylons is finished, now draw the wires */
+	/* Placing of pylons is finished, now place the wires */
 	for (Track t : SetTrackBitIterator(wire_config[TS_HOME])) {
-		SpriteID wire_base = (t == halftile_track) ? wire_halftile : wire_normal;
 		uint8_t pcp_config = pcp_status.Test(_pcp_positions[t][0]) +
 			(pcp_status.Test(_pcp_positions[t][1]) << 1);
 		int tileh_selector = !(tileh[TS_HOME] % 3) * tileh[TS_HOME] / 3; // tileh for the slopes, 0 otherwise
 
 		assert(pcp_config != 0); // We have a pylon on neither end of the wire, that doesn't work (since we have no sprites for that)
 		assert(!IsSteepSlope(tileh[TS_HOME]));
-		const SortableSpriteStruct &sss = _rail_catenary_sprite_data[_rail_wires[tileh_selector][t][pcp_config]];
+		RailCatenarySprite sprite = _rail_wires[tileh_selector][t][pcp_config];
+		const SortableSpriteStruct &sss = _rail_catenary_sprite_data[sprite];
 
 		/*
 		 * The "wire"-sprite position is inside the tile, i.e. 0 <= sss->?_offset < TILE_SIZE.
@@ -476,7 +526,43 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 		 * down to the nearest full height change.
 		 */
 		int z = (GetSlopePixelZ(ti->x + sss.origin.x, ti->y + sss.origin.y, true) + 4) / 8 * 8;
-		AddSortableSpriteToDraw(wire_base + sss.image_offset, PAL_NONE, ti->x, ti->y, z, sss, IsTransparencySet(TO_CATENARY));
+		layout.wires[layout.num_wires++] = {sprite, t == halftile_track, static_cast<int16_t>(z)};
+	}
+}
+
+/**
+ * Draws wires and, if required, pylons on a given tile
+ * @param ti The Tileinfo to draw the tile for
+ */
+static void DrawRailCatenaryRailway(const TileInfo *ti)
+{
+	auto it = _catenary_layouts.find(ti->tile.base());
+	if (it == _catenary_layouts.end()) {
+		if (_catenary_layouts.size() >= MAX_CATENARY_LAYOUTS) _catenary_layouts.clear();
+		it = _catenary_layouts.try_emplace(ti->tile.base()).first;
+		ComputeCatenaryLayout(ti, it->second);
+	}
+	const CatenaryLayout &layout = it->second;
+
+	SpriteID pylon_normal = GetPylonBase(ti->tile);
+	SpriteID pylon_halftile = (layout.halftile_corner != CORNER_INVALID) ? GetPylonBase(ti->tile, TCX_UPPER_HALFTILE) : pylon_normal;
+	for (uint i = 0; i < layout.num_pylons; i++) {
+		const CatenaryPylon &pylon = layout.pylons[i];
+		uint x = ti->x + _x_pcp_offsets[pylon.pcp] + _x_ppp_offsets[pylon.ppp];
+		uint y = ti->y + _y_pcp_offsets[pylon.pcp] + _y_ppp_offsets[pylon.ppp];
+		AddSortableSpriteToDraw((pylon.halftile ? pylon_halftile : pylon_normal) + _pylon_sprites[pylon.ppp], PAL_NONE, x, y, pylon.z,
+			{{-1, -1, 0}, {1, 1, BB_HEIGHT_UNDER_BRIDGE}, {1, 1, 0}}, IsTransparencySet(TO_CATENARY));
+	}
+
+	/* Don't draw a wire under a low bridge */
+	if (layout.num_wires == 0 || (layout.low_bridge && !IsTransparencySet(TO_BRIDGES))) return;
+
+	SpriteID wire_normal = GetWireBase(ti->tile);
+	SpriteID wire_halftile = (layout.halftile_corner != CORNER_INVALID) ? GetWireBase(ti->tile, TCX_UPPER_HALFTILE) : wire_normal;
+	for (uint i = 0; i < layout.num_wires; i++) {
+		const CatenaryWire &wire = layout.wires[i];
+		const SortableSpriteStruct &sss = _rail_catenary_sprite_data[wire.sprite];
+		AddSortableSpriteToDraw((wire.halftile ? wire_halftile : wire_normal) + sss.image_offset, PAL_NONE, ti->x, ti->y, wire.z, sss, IsTransparencySet(TO_CATENARY));
 	}
 }
 
@@ -617,6 +703,9 @@ void UpdateDisableElrailSettingState(bool disable, bool update_vehicles)
 
 	for (Company *c : Company::Iterate()) c->avail_railtypes = GetCompanyRailTypes(c->index);
 
+	/* The rail types of the engines and the companies changed. */
+	RpcInvalidateEngineCache();
+
 	/* This resets the _last_built_railtype, which will be invalid for electric
 	 * rails. It may have unintended consequences if that function is ever
 	 * extended, though. */
@@ -35,6 +35,8 @@ inline bool HasRailCatenaryDrawn(RailType rt)
 void DrawRailCatenary(const TileInfo *ti);
 void DrawRailCatenaryOnTunnel(const TileInfo *ti);
 void DrawRailCatenaryOnBridge(const TileInfo *ti);
+void InvalidateCatenaryLayout(TileIndex tile);
+void ClearCatenaryLayouts();
 
 void SettingsDisableElrail(int32_t new_value); ///< _settings_game.disable_elrail callback
 void UpdateDisableElrailSettingState(bool disable, bool update_vehicles);
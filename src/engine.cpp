@@ -33,6 +33,7 @@
 #include "timer/timer.h"
 #include "timer/timer_game_tick.h"
 #include "timer/timer_game_calendar.h"
+#include "rpc/rpc_engine_cache.h"
 
 #include "table/strings.h"
 #include "table/engines.h"
@@ -601,6 +602,7 @@ void SetupEngines()
 {
 	CloseWindowByClass(WC_ENGINE_PREVIEW);
 	_engine_pool.CleanPool();
+	RpcInvalidateEngineCache();
 
 	for (VehicleType type = VEH_BEGIN; type != VEH_COMPANY_END; type++) {
 		const auto &mapping = _engine_mngr.mappings[type];
@@ -831,6 +833,7 @@ static void EnableEngineForCompany(EngineID eid, CompanyID company)
 {
 	Engine *e = Engine::Get(eid);
 	Company *c = Company::Get(company);
+	RpcInvalidateEngineCache();
 
 	e->company_avail.Set(company);
 	if (e->type == VEH_TRAIN) {
@@ -859,6 +862,7 @@ static void DisableEngineForCompany(EngineID eid, CompanyID company)
 {
 	Engine *e = Engine::Get(eid);
 	Company *c = Company::Get(company);
+	RpcInvalidateEngineCache();
 
 	e->company_avail.Reset(company);
 	if (e->type == VEH_TRAIN) {
@@ -961,8 +965,12 @@ static bool IsVehicleTypeDisabled(VehicleType type, bool ai)
 static const IntervalTimer<TimerGameCalendar> _calendar_engines_daily({TimerGameCalendar::DAY, TimerGameCalendar::Priority::ENGINE}, [](auto)
 {
 	for (Company *c : Company::Iterate()) {
-		c->avail_railtypes = AddDateIntroducedRailTypes(c->avail_railtypes, TimerGameCalendar::date);
-		c->avail_roadtypes = AddDateIntroducedRoadTypes(c->avail_roadtypes, TimerGameCalendar::date);
+		RailTypes avail_railtypes = AddDateIntroducedRailTypes(c->avail_railtypes, TimerGameCalendar::date);
+		RoadTypes avail_roadtypes = AddDateIntroducedRoadTypes(c->avail_roadtypes, TimerGameCalendar::date);
+		/* The engines a company can build depend on its rail and road types. */
+		if (avail_railtypes != c->avail_railtypes || avail_roadtypes != c->avail_roadtypes) RpcInvalidateEngineCache();
+		c->avail_railtypes = avail_railtypes;
+		c->avail_roadtypes = avail_roadtypes;
 	}
 
 	if (TimerGameCalendar::year >= _year_engine_aging_stops) return;
@@ -1079,6 +1087,7 @@ CommandCost CmdEngineCtrl(DoCommandFlags flags, EngineID engine_id, CompanyID co
 static void NewVehicleAvailable(Engine *e)
 {
 	EngineID index = e->index;
+	RpcInvalidateEngineCache();
 
 	/* In case the company didn't build the vehicle during the intro period,
 	 * prevent that company from getting future intro periods for a while. */
@@ -1175,6 +1184,7 @@ void CalendarEnginesMonthlyLoop()
 		}
 
 		InvalidateWindowClassesData(WC_BUILD_VEHICLE); // rebuild the purchase list (esp. when sorted by reliability)
+		RpcInvalidateEngineCache(); // reliabilities changed
 
 		if (refresh) {
 			SetWindowClassesDirty(WC_BUILD_VEHICLE);
@@ -1228,6 +1238,7 @@ CommandCost CmdRenameEngine(DoCommandFlags flags, EngineID engine_id, const std:
 			e->name = text;
 		}
 
+		RpcInvalidateEngineCache();
 		MarkWholeScreenDirty();
 	}
 
@@ -219,6 +219,9 @@ static std::optional<FileHandle> FioFOpenFileSp(std::string_view filename, std::
  * @param[out] filesize If not \c nullptr, size of the opened file.
  * @return File handle of the opened file, or \c nullptr if the file is not available.
  * @note The file is read from within the tar file, and may not return \c EOF after reading the whole file.
+ * @note Every call opens the tar file again. Files that are read a lot, such as NewGRFs and
+ *       sound sets, are opened once through #RandomAccessFile and keep their handle, so
+ *       this is only done once per file and not per sprite.
  */
 static std::optional<FileHandle> FioFOpenFileTar(const TarFileListEntry &entry, size_t *filesize)
 {
@@ -27,11 +27,13 @@
 #include "timer/timer.h"
 #include "timer/timer_window.h"
 #include "zoom_func.h"
+#include "fileio_func.h"
 
 #include "widgets/framerate_widget.h"
 
 #include <atomic>
 #include <mutex>
+#include <numeric>
 
 #include "table/strings.h"
 
@@ -40,6 +42,7 @@
 static std::mutex _sound_perf_lock;
 static std::atomic<bool> _sound_perf_pending;
 static std::vector<TimingMeasurement> _sound_perf_measurements;
+static bool _pf_recording = false; ///< Whether all measurements are recorded for a benchmark, see StartPerformanceRecording.
 
 /**
  * Private declarations for performance measurement implementation
@@ -73,6 +76,9 @@ namespace {
 		/** Start time for current accumulation cycle */
 		TimingMeasurement acc_timestamp{};
 
+		/** All durations measured since the recording started, when recording. */
+		std::vector<TimingMeasurement> recorded;
+
 		/**
 		 * Initialize a data element with an expected collection rate
 		 * @param expected_rate
@@ -86,6 +92,7 @@ namespace {
 		{
 			this->durations[this->next_index] = end_time - start_time;
 			this->timestamps[this->next_index] = start_time;
+			if (_pf_recording) this->recorded.push_back(end_time - start_time);
 			this->prev_index = this->next_index;
 			this->next_index += 1;
 			if (this->next_index >= NUM_FRAMERATE_POINTS) this->next_index = 0;
@@ -97,6 +104,7 @@ namespace {
 		{
 			this->timestamps[this->next_index] = this->acc_timestamp;
 			this->durations[this->next_index] = this->acc_duration;
+			if (_pf_recording && this->acc_timestamp != 0) this->recorded.push_back(this->acc_duration);
 			this->prev_index = this->next_index;
 			this->next_index += 1;
 			if (this->next_index >= NUM_FRAMERATE_POINTS) this->next_index = 0;
@@ -202,10 +210,13 @@ namespace {
 		PerformanceData(1),                     // PFE_ACC_GL_AIRCRAFT
 		PerformanceData(1),                     // PFE_GL_LANDSCAPE
 		PerformanceData(1),                     // PFE_GL_LINKGRAPH
+		PerformanceData(1),                     // PFE_GL_PATHFINDER
+		PerformanceData(1),                     // PFE_GL_NEWGRF
 		PerformanceData(1000.0 / 30),           // PFE_DRAWING
 		PerformanceData(1),                     // PFE_ACC_DRAWWORLD
 		PerformanceData(60.0),                  // PFE_VIDEO
 		PerformanceData(1000.0 * 8192 / 44100), // PFE_SOUND
+		PerformanceData(1),                     // PFE_RPC
 		PerformanceData(1),                     // PFE_ALLSCRIPTS
 		PerformanceData(1),                     // PFE_GAMESCRIPT
 		PerformanceData(1),                     // PFE_AI0 ...
@@ -335,6 +346,58 @@ void PerformanceAccumulator::Reset(PerformanceElement elem)
 }
 
 
+/** Start recording all measurements, for WritePerformanceRecording. */
+void StartPerformanceRecording()
+{
+	for (PerformanceData &pf : _pf_data) pf.recorded.clear();
+	_pf_recording = true;
+}
+
+/**
+ * Stop recording measurements, and write the statistics of all elements with measurements.
+ * The statistics are written as JSON, with all times in milliseconds, so benchmark runs can be compared by scripts.
+ * @param filename The file to write to.
+ * @param ticks The number of game ticks the recording ran for.
+ * @return Whether the file has been written.
+ */
+bool WritePerformanceRecording(std::string_view filename, uint ticks)
+{
+	_pf_recording = false;
+
+	static const std::array<std::string_view, PFE_AI0> ELEMENT_NAMES = {
+		"gameloop", "gl_economy", "gl_trains", "gl_roadvehs", "gl_ships", "gl_aircraft", "gl_landscape", "gl_linkgraph",
+		"gl_pathfinder", "gl_newgrf", "drawing", "drawworld", "video", "sound", "rpc", "allscripts", "gamescript",
+	};
+
+	auto f = FioFOpenFile(filename, "wt", Subdirectory::NO_DIRECTORY);
+	if (!f.has_value()) return false;
+
+	auto ms = [](TimingMeasurement t) { return t * 1000.0 / TIMESTAMP_PRECISION; };
+
+	fmt::print(*f, "{{\n\t\"ticks\": {},\n\t\"elements\": {{", ticks);
+	bool first = true;
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		std::vector<TimingMeasurement> &recorded = _pf_data[e].recorded;
+		if (recorded.empty()) continue;
+
+		std::sort(recorded.begin(), recorded.end());
+		auto percentile = [&recorded](uint p) { return recorded[(recorded.size() - 1) * p / 100]; };
+		TimingMeasurement total = std::accumulate(recorded.begin(), recorded.end(), TimingMeasurement{0});
+
+		std::string name = e < PFE_AI0 ? std::string{ELEMENT_NAMES[e]} : fmt::format("ai{}", e - PFE_AI0);
+		fmt::print(*f, "{}\n\t\t\"{}\": {{\"count\": {}, \"total\": {:.3f}, \"avg\": {:.3f}, \"min\": {:.3f}, \"p50\": {:.3f}, \"p95\": {:.3f}, \"p99\": {:.3f}, \"max\": {:.3f}}}",
+				first ? "" : ",", name, recorded.size(), ms(total), ms(total) / recorded.size(),
+				ms(recorded.front()), ms(percentile(50)), ms(percentile(95)), ms(percentile(99)), ms(recorded.back()));
+		first = false;
+
+		recorded.clear();
+		recorded.shrink_to_fit();
+	}
+	fmt::print(*f, "\n\t}}\n}}\n");
+	return true;
+}
+
+
 void ShowFrametimeGraphWindow(PerformanceElement elem);
 
 
@@ -345,6 +408,8 @@ static const PerformanceElement DISPLAY_ORDER_PFE[PFE_MAX] = {
 	PFE_GL_ROADVEHS,
 	PFE_GL_SHIPS,
 	PFE_GL_AIRCRAFT,
+	PFE_GL_PATHFINDER,
+	PFE_GL_NEWGRF,
 	PFE_GL_LANDSCAPE,
 	PFE_ALLSCRIPTS,
 	PFE_GAMESCRIPT,
@@ -368,6 +433,7 @@ static const PerformanceElement DISPLAY_ORDER_PFE[PFE_MAX] = {
 	PFE_DRAWWORLD,
 	PFE_VIDEO,
 	PFE_SOUND,
+	PFE_RPC,
 };
 
 static std::string_view GetAIName(int ai_index)
@@ -1013,10 +1079,13 @@ void ConPrintFramerate()
 		"  GL aircraft ticks",
 		"  GL landscape ticks",
 		"  GL link graph delays",
+		"  GL pathfinding",
+		"  GL NewGRF callbacks",
 		"Drawing",
 		"  Viewport drawing",
 		"Video output",
 		"Sound mixing",
+		"RPC requests",
 		"AI/GS scripts total",
 		"Game script",
 	};
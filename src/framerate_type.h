@@ -53,10 +53,13 @@ enum PerformanceElement : uint8_t {
 	PFE_GL_AIRCRAFT,   ///< Time spent processing aircraft
 	PFE_GL_LANDSCAPE,  ///< Time spent processing other world features
 	PFE_GL_LINKGRAPH,  ///< Time spent waiting for link graph background jobs
+	PFE_GL_PATHFINDER, ///< Time spent in the pathfinders, as part of the vehicle ticks
+	PFE_GL_NEWGRF,     ///< Time spent resolving NewGRF callbacks, including those made while drawing
 	PFE_DRAWING,       ///< Speed of drawing world and GUI.
 	PFE_DRAWWORLD,     ///< Time spent drawing world viewports in GUI
 	PFE_VIDEO,         ///< Speed of painting drawn video buffer.
 	PFE_SOUND,         ///< Speed of mixing audio samples
+	PFE_RPC,           ///< Time spent handling RPC requests on the game thread
 	PFE_ALLSCRIPTS,    ///< Sum of all GS/AI scripts
 	PFE_GAMESCRIPT,    ///< Game script execution
 	PFE_AI0,           ///< AI execution for player slot 1
@@ -121,5 +124,7 @@ public:
 
 void ShowFramerateWindow();
 void ProcessPendingPerformanceMeasurements();
+void StartPerformanceRecording();
+bool WritePerformanceRecording(std::string_view filename, uint ticks);
 
 #endif /* FRAMERATE_TYPE_H */
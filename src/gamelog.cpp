@@ -14,6 +14,7 @@
 #include "gamelog_internal.h"
 #include "console_func.h"
 #include "debug.h"
+#include "fileio_func.h"
 #include "timer/timer_game_calendar.h"
 #include "timer/timer_game_tick.h"
 #include "rev.h"
@@ -80,7 +81,11 @@ void Gamelog::StopAction()
 	this->current_action = nullptr;
 	this->action_type = GLAT_NONE;
 
-	if (print) this->PrintDebug(5);
+	if (print) {
+		this->PrintDebug(5);
+		if (_settings_client.network.gamelog_archive) this->Archive();
+		this->Compact();
+	}
 }
 
 void Gamelog::StopAnyAction()
@@ -98,6 +103,149 @@ void Gamelog::Reset()
 	this->current_action  = nullptr;
 }
 
+/**
+ * Check whether two logged changes log the same.
+ * @param a The one change.
+ * @param b The other change.
+ * @return True iff both changes are of the same type with the same data.
+ */
+static bool IsSameChange(const LoggedChange &a, const LoggedChange &b)
+{
+	if (a.ct != b.ct) return false;
+
+	switch (a.ct) {
+		case GLCT_MODE: {
+			const auto &ma = static_cast<const LoggedChangeMode &>(a);
+			const auto &mb = static_cast<const LoggedChangeMode &>(b);
+			return ma.mode == mb.mode && ma.landscape == mb.landscape;
+		}
+
+		case GLCT_REVISION: {
+			const auto &ra = static_cast<const LoggedChangeRevision &>(a);
+			const auto &rb = static_cast<const LoggedChangeRevision &>(b);
+			return ra.text == rb.text && ra.newgrf == rb.newgrf && ra.slver == rb.slver && ra.modified == rb.modified;
+		}
+
+		case GLCT_OLDVER: {
+			const auto &oa = static_cast<const LoggedChangeOldVersion &>(a);
+			const auto &ob = static_cast<const LoggedChangeOldVersion &>(b);
+			return oa.type == ob.type && oa.version == ob.version;
+		}
+
+		case GLCT_SETTING: {
+			const auto &sa = static_cast<const LoggedChangeSettingChanged &>(a);
+			const auto &sb = static_cast<const LoggedChangeSettingChanged &>(b);
+			return sa.name == sb.name && sa.oldval == sb.oldval && sa.newval == sb.newval;
+		}
+
+		case GLCT_GRFADD: {
+			const auto &ga = static_cast<const LoggedChangeGRFAdd &>(a);
+			const auto &gb = static_cast<const LoggedChangeGRFAdd &>(b);
+			return ga.HasGrfIdentifier(gb.grfid, &gb.md5sum);
+		}
+
+		case GLCT_GRFREM:
+			return static_cast<const LoggedChangeGRFRemoved &>(a).grfid == static_cast<const LoggedChangeGRFRemoved &>(b).grfid;
+
+		case GLCT_GRFCOMPAT: {
+			const auto &ga = static_cast<const LoggedChangeGRFChanged &>(a);
+			const auto &gb = static_cast<const LoggedChangeGRFChanged &>(b);
+			return ga.HasGrfIdentifier(gb.grfid, &gb.md5sum);
+		}
+
+		case GLCT_GRFPARAM:
+			return static_cast<const LoggedChangeGRFParameterChanged &>(a).grfid == static_cast<const LoggedChangeGRFParameterChanged &>(b).grfid;
+
+		case GLCT_GRFMOVE: {
+			const auto &ga = static_cast<const LoggedChangeGRFMoved &>(a);
+			const auto &gb = static_cast<const LoggedChangeGRFMoved &>(b);
+			return ga.grfid == gb.grfid && ga.offset == gb.offset;
+		}
+
+		case GLCT_GRFBUG: {
+			const auto &ga = static_cast<const LoggedChangeGRFBug &>(a);
+			const auto &gb = static_cast<const LoggedChangeGRFBug &>(b);
+			return ga.grfid == gb.grfid && ga.bug == gb.bug && ga.data == gb.data;
+		}
+
+		case GLCT_EMERGENCY:
+			return true;
+
+		default: NOT_REACHED();
+	}
+}
+
+/**
+ * Check whether two logged actions log the same changes.
+ * @param a The one action.
+ * @param b The other action.
+ * @return True iff both actions are of the same type with the same changes.
+ */
+static bool IsSameAction(const LoggedAction &a, const LoggedAction &b)
+{
+	return a.at == b.at && std::ranges::equal(a.change, b.change, [](const auto &ca, const auto &cb) { return IsSameChange(*ca, *cb); });
+}
+
+/**
+ * Compact the gamelog, so long running games like servers do not keep an ever growing log in memory and in their savegames.
+ * - Changes of the same setting in consecutive setting actions are merged into the first one,
+ *   and dropped when the setting got back to its old value.
+ * - Loading or emergency saving the game with the same changes as the action right before is only logged once.
+ * Everything that is looked at later on, like the last revision and game mode, removed NewGRFs
+ * and triggered NewGRF bugs, stays in the log. With the network.gamelog_archive setting the
+ * actions are also written to a file before compacting, to keep the complete history.
+ */
+void Gamelog::Compact()
+{
+	assert(this->action_type == GLAT_NONE);
+
+	std::vector<LoggedAction> &actions = this->data->action;
+
+	/* Changes of settings in the current run of consecutive setting actions. */
+	std::map<std::string, LoggedChangeSettingChanged *, std::less<>> settings;
+	for (LoggedAction &la : actions) {
+		if (la.at != GLAT_SETTING) {
+			settings.clear();
+			continue;
+		}
+
+		std::erase_if(la.change, [&settings](std::unique_ptr<LoggedChange> &lc) {
+			if (lc->ct != GLCT_SETTING) return false;
+
+			LoggedChangeSettingChanged *setting = static_cast<LoggedChangeSettingChanged *>(lc.get());
+			auto [it, inserted] = settings.try_emplace(setting->name, setting);
+			if (inserted) return false;
+
+			it->second->newval = setting->newval;
+			return true;
+		});
+	}
+
+	/* Setting changes that got reverted do not change anything at all. */
+	for (LoggedAction &la : actions) {
+		if (la.at != GLAT_SETTING) continue;
+
+		std::erase_if(la.change, [](std::unique_ptr<LoggedChange> &lc) {
+			if (lc->ct != GLCT_SETTING) return false;
+
+			const LoggedChangeSettingChanged *setting = static_cast<const LoggedChangeSettingChanged *>(lc.get());
+			return setting->oldval == setting->newval;
+		});
+	}
+
+	/* Drop actions without changes, and repeated loads and emergency saves. */
+	auto last = actions.end();
+	auto out = actions.begin();
+	for (auto it = actions.begin(); it != actions.end(); ++it) {
+		if (it->change.empty()) continue;
+		if ((it->at == GLAT_LOAD || it->at == GLAT_EMERGENCY) && last != actions.end() && IsSameAction(*last, *it)) continue;
+
+		if (out != it) *out = std::move(*it);
+		last = out++;
+	}
+	actions.erase(out, actions.end());
+}
+
 /**
  * Adds the GRF ID, checksum and filename if found to the output iterator
  * @param output_iterator The iterator to add the GRF info to.
@@ -140,6 +288,27 @@ static const std::string_view la_text[] = {
 
 static_assert(lengthof(la_text) == GLAT_END);
 
+/**
+ * Prints one logged action.
+ * @param la The action to print.
+ * @param grf_names The NewGRFs known from the actions before this one; updated with the changes of this action.
+ * @param proc the procedure to draw with
+ */
+static void PrintAction(const LoggedAction &la, GrfIDMapping &grf_names, std::function<void(const std::string &)> &proc)
+{
+	assert(la.at < GLAT_END);
+
+	proc(fmt::format("Tick {}: {}", la.tick, la_text[la.at]));
+
+	for (auto &lc : la.change) {
+		std::string message;
+		auto output_iterator = std::back_inserter(message);
+		lc->FormatTo(output_iterator, grf_names, la.at);
+
+		proc(message);
+	}
+}
+
 /**
  * Prints active gamelog
  * @param proc the procedure to draw with
@@ -151,20 +320,34 @@ void Gamelog::Print(std::function<void(const std::string &)> proc)
 	proc("---- gamelog start ----");
 
 	for (const LoggedAction &la : this->data->action) {
-		assert(la.at < GLAT_END);
+		PrintAction(la, grf_names, proc);
+	}
 
-		proc(fmt::format("Tick {}: {}", la.tick, la_text[la.at]));
+	proc("---- gamelog end ----");
+}
 
-		for (auto &lc : la.change) {
-			std::string message;
-			auto output_iterator = std::back_inserter(message);
-			lc->FormatTo(output_iterator, grf_names, la.at);
+/**
+ * Append the last logged action to the gamelog archive, so the complete history
+ * stays available after the log in the savegame has been compacted.
+ * @see Gamelog::Compact
+ */
+void Gamelog::Archive()
+{
+	static auto f = FioFOpenFile("gamelog-archive.log", "ab", AUTOSAVE_DIR);
+	if (!f.has_value()) return;
 
-			proc(message);
-		}
+	/* The NewGRFs are described as they were known at the time of the action. */
+	GrfIDMapping grf_names;
+	std::function<void(const std::string &)> ignore = [](const std::string &) {};
+	for (auto it = this->data->action.begin(); it != std::prev(this->data->action.end()); ++it) {
+		PrintAction(*it, grf_names, ignore);
 	}
 
-	proc("---- gamelog end ----");
+	std::function<void(const std::string &)> archive = [](const std::string &s) {
+		fmt::print(*f, "{}\n", s);
+	};
+	PrintAction(this->data->action.back(), grf_names, archive);
+	fflush(*f);
 }
 
 
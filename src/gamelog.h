@@ -53,6 +53,7 @@ private:
 	struct LoggedAction *current_action;
 
 	void Change(std::unique_ptr<LoggedChange> &&change);
+	void Archive();
 
 public:
 	Gamelog();
@@ -63,6 +64,7 @@ public:
 	void StopAnyAction();
 
 	void Reset();
+	void Compact();
 
 	void Print(std::function<void(const std::string &)> proc);
 	void PrintDebug(int level);
@@ -42,6 +42,8 @@
 #include "string_func.h"
 #include "thread.h"
 #include "tgp.h"
+#include "console_func.h"
+#include "settings_type.h"
 
 #include "table/strings.h"
 
@@ -73,6 +75,41 @@ struct GenWorldInfo {
 /** Whether we are generating the map or not. */
 bool _generating_world;
 
+/** Time spent in one step of the world generation. */
+struct GenWorldPhaseStats {
+	std::chrono::steady_clock::duration wall_time{}; ///< Wall clock time spent in this step.
+	std::clock_t cpu_time = 0; ///< Processor time used by all threads during this step.
+	uint count = 0; ///< Number of world generations that ran this step.
+};
+
+/** Timing of the steps of the world generation, and the state of the world generation benchmark. */
+struct GenWorldBenchmark {
+	static inline std::array<GenWorldPhaseStats, GWP_CLASS_COUNT> stats{}; ///< Time spent per step.
+	static inline GenWorldProgress phase = GWP_CLASS_COUNT; ///< The step being timed, GWP_CLASS_COUNT when not generating.
+	static inline std::chrono::steady_clock::time_point wall_start{}; ///< Wall clock time when the step started.
+	static inline std::clock_t cpu_start = 0; ///< Processor time when the step started.
+	static inline uint remaining = 0; ///< Number of worlds the benchmark still has to generate.
+	static inline uint32_t seed = 0; ///< Seed of the world being generated by the benchmark.
+};
+
+/** Names of the world generation steps, for the benchmark results. */
+static const std::string_view _generation_phase_names[] = {
+	"Map initialisation",
+	"Landscape",
+	"Rivers",
+	"Rough and rocky land",
+	"Towns",
+	"Land industries",
+	"Water industries",
+	"Objects",
+	"Trees",
+	"Game initialisation",
+	"Tile loop",
+	"Game script",
+	"Game start",
+};
+static_assert(lengthof(_generation_phase_names) == GWP_CLASS_COUNT);
+
 class AbortGenerateWorldSignal { };
 
 /**
@@ -207,6 +244,7 @@ static void _GenerateWorld()
 		/* Call any callback */
 		if (GenWorldInfo::proc != nullptr) GenWorldInfo::proc();
 		IncreaseGeneratingWorldProgress(GWP_GAME_START);
+		StartGenerateWorldPhase(GWP_CLASS_COUNT);
 
 		CleanupGeneration();
 
@@ -220,6 +258,7 @@ static void _GenerateWorld()
 			SaveOrLoad(name, SLO_SAVE, DFT_GAME_FILE, AUTOSAVE_DIR, false);
 		}
 	} catch (AbortGenerateWorldSignal&) {
+		StartGenerateWorldPhase(GWP_CLASS_COUNT);
 		CleanupGeneration();
 
 		BasePersistentStorageArray::SwitchMode(PSM_LEAVE_GAMELOOP, true);
@@ -285,6 +324,89 @@ void HandleGeneratingWorldAbortion()
 	throw AbortGenerateWorldSignal();
 }
 
+/**
+ * Account the time spent in the current step of the world generation, and start timing the next step.
+ * @param cls The step that starts, or GWP_CLASS_COUNT when the world generation has ended.
+ */
+void StartGenerateWorldPhase(GenWorldProgress cls)
+{
+	if (cls == GenWorldBenchmark::phase) return;
+
+	auto now = std::chrono::steady_clock::now();
+	std::clock_t cpu = std::clock();
+
+	if (GenWorldBenchmark::phase != GWP_CLASS_COUNT) {
+		GenWorldPhaseStats &stats = GenWorldBenchmark::stats[GenWorldBenchmark::phase];
+		stats.wall_time += now - GenWorldBenchmark::wall_start;
+		stats.cpu_time += cpu - GenWorldBenchmark::cpu_start;
+	}
+	if (cls != GWP_CLASS_COUNT) GenWorldBenchmark::stats[cls].count++;
+
+	GenWorldBenchmark::phase = cls;
+	GenWorldBenchmark::wall_start = now;
+	GenWorldBenchmark::cpu_start = cpu;
+}
+
+/** Print the average time spent per step of the world generation to the console. */
+static void ConPrintGenerateWorldPhaseStats()
+{
+	std::chrono::steady_clock::duration total_wall{};
+	std::clock_t total_cpu = 0;
+	uint generations = 0;
+
+	for (uint i = 0; i < GWP_CLASS_COUNT; i++) {
+		const GenWorldPhaseStats &stats = GenWorldBenchmark::stats[i];
+		if (stats.count == 0) continue;
+
+		IConsolePrint(CC_DEFAULT, "{}: wall {} ms; CPU {} ms", _generation_phase_names[i],
+				std::chrono::duration_cast<std::chrono::milliseconds>(stats.wall_time).count() / stats.count,
+				stats.cpu_time * 1000 / CLOCKS_PER_SEC / stats.count);
+		total_wall += stats.wall_time;
+		total_cpu += stats.cpu_time;
+		generations = std::max(generations, stats.count);
+	}
+	if (generations == 0) return;
+
+	IConsolePrint(CC_DEFAULT, "Total: wall {} ms; CPU {} ms",
+			std::chrono::duration_cast<std::chrono::milliseconds>(total_wall).count() / generations,
+			total_cpu * 1000 / CLOCKS_PER_SEC / generations);
+}
+
+/**
+ * Start the world generation benchmark. The caller must start generating the first world with the given seed.
+ * @param count The number of worlds to generate.
+ * @param seed The seed of the first world; every next world uses the next seed.
+ */
+void StartGenerateWorldBenchmark(uint count, uint32_t seed)
+{
+	GenWorldBenchmark::stats = {};
+	GenWorldBenchmark::remaining = count;
+	GenWorldBenchmark::seed = seed;
+}
+
+/**
+ * Continue the world generation benchmark after a world has been generated.
+ * @return True iff another world has to be generated.
+ */
+bool GenerateWorldBenchmarkAfterGenerate()
+{
+	if (GenWorldBenchmark::remaining == 0) return false;
+
+	if (IsGeneratingWorldAborted()) {
+		GenWorldBenchmark::remaining = 0;
+		IConsolePrint(CC_ERROR, "World generation benchmark aborted.");
+		return false;
+	}
+
+	if (--GenWorldBenchmark::remaining != 0) {
+		_settings_newgame.game_creation.generation_seed = ++GenWorldBenchmark::seed;
+		return true;
+	}
+
+	ConPrintGenerateWorldPhaseStats();
+	return false;
+}
+
 /**
  * Generate a world.
  * @param mode The mode of world generation (see GenWorldMode).
@@ -299,6 +421,7 @@ void GenerateWorld(GenWorldMode mode, uint size_x, uint size_y, bool reset_setti
 	GenWorldInfo::size_x = size_x;
 	GenWorldInfo::size_y = size_y;
 	SetModalProgress(true);
+	StartGenerateWorldPhase(GWP_MAP_INIT);
 	GenWorldInfo::abort  = false;
 	GenWorldInfo::abortp = nullptr;
 	GenWorldInfo::lc     = _local_company;
@@ -83,6 +83,9 @@ void AbortGeneratingWorld();
 bool IsGeneratingWorldAborted();
 void HandleGeneratingWorldAbortion();
 void LoadTownData();
+void StartGenerateWorldPhase(GenWorldProgress cls);
+void StartGenerateWorldBenchmark(uint count, uint32_t seed);
+bool GenerateWorldBenchmarkAfterGenerate();
 
 /* genworld_gui.cpp */
 void SetNewLandscapeType(LandscapeType landscape);
@@ -1472,6 +1472,8 @@ static void _SetGeneratingWorldProgress(GenWorldProgress cls, uint progress, uin
 		return;
 	}
 
+	if (total != 0) StartGenerateWorldPhase(cls);
+
 	if (total == 0) {
 		assert(GenWorldStatus::cls == _generation_class_table[cls]);
 		GenWorldStatus::current += progress;
@@ -1504,6 +1506,14 @@ static void _SetGeneratingWorldProgress(GenWorldProgress cls, uint progress, uin
 		return;
 	}
 
+	/* Most generation steps report progress for every tile or item they place, which is
+	 * far more often than the window can show. Only redraw and give the drawing thread a
+	 * chance once per frame, or when a new step starts. */
+	static std::chrono::steady_clock::time_point last_pause{};
+	auto now = std::chrono::steady_clock::now();
+	if (total == 0 && now - last_pause < std::chrono::milliseconds(16)) return;
+	last_pause = now;
+
 	SetWindowDirty(WC_MODAL_PROGRESS, 0);
 
 	VideoDriver::GetInstance()->GameLoopPause();
@@ -24,6 +24,7 @@
 #include "core/backup_type.hpp"
 #include "core/geometry_func.hpp"
 #include "viewport_func.h"
+#include "trace.h"
 
 #include "table/string_colours.h"
 #include "table/sprites.h"
@@ -44,6 +45,7 @@ bool _right_button_down;    ///< Is right mouse button pressed?
 bool _right_button_clicked; ///< Is right mouse button clicked?
 DrawPixelInfo _screen;
 bool _screen_disable_anim = false;   ///< Disable palette animation (important for 32bpp-anim blitter during giant screenshot)
+bool _screen_dirty_suspended = false; ///< Ignore marking parts of the screen dirty, as the whole screen is redrawn later.
 std::atomic<bool> _exit_game;
 GameMode _game_mode;
 SwitchMode _switch_mode;  ///< The next mainloop command.
@@ -1448,6 +1450,8 @@ void RedrawScreenRect(int left, int top, int right, int bottom)
  */
 void DrawDirtyBlocks()
 {
+	TraceZone zone("DrawDirtyBlocks");
+
 	auto is_dirty = [](auto block) -> bool { return block != 0; };
 	auto block = _dirty_blocks.begin();
 
@@ -1512,6 +1516,8 @@ void DrawDirtyBlocks()
  */
 void AddDirtyBlock(int left, int top, int right, int bottom)
 {
+	if (_screen_dirty_suspended) return;
+
 	if (left < 0) left = 0;
 	if (top < 0) top = 0;
 	if (right > _screen.width) right = _screen.width;
@@ -63,6 +63,7 @@ extern bool _right_button_clicked;
 
 extern DrawPixelInfo _screen;
 extern bool _screen_disable_anim;   ///< Disable palette animation (important for 32bpp-anim blitter during giant screenshot)
+extern bool _screen_dirty_suspended; ///< Ignore marking parts of the screen dirty, as the whole screen is redrawn later.
 
 extern std::vector<Dimension> _resolutions;
 extern Dimension _cur_resolution;
@@ -385,6 +385,10 @@ void Layouter::ResetFontCache(FontSize size)
  * @param str Source string of the line (including colour and font size codes).
  * @param state State of the font at the beginning of the line.
  * @return Reference to cache item.
+ * @note Whole paragraphs are cached rather than words, as shaping and bidi
+ *       reordering depend on the surrounding text. The rasterised glyphs are
+ *       cached separately by the font caches, so a changed number in a
+ *       string only costs shaping it again.
  */
 Layouter::LineCacheItem &Layouter::GetCachedParagraphLayout(std::string_view str, const FontState &state)
 {
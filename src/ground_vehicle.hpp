@@ -112,6 +112,10 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 
 	/**
 	 * Calculates the total slope resistance for this vehicle.
+	 * @note This is deliberately not kept as a running sum: the slope flags are changed
+	 *       in many places (reversing, leaving depots, loading games, changing consists),
+	 *       and a sum that drifts from the flags, or differs between a server and a client
+	 *       that just loaded the game, causes a desync. The loop only reads cached values.
 	 * @return Slope resistance.
 	 */
 	inline int64_t GetSlopeResistance() const
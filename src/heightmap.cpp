@@ -78,14 +78,22 @@ static inline uint8_t RGBToGreyscale(uint8_t red, uint8_t green, uint8_t blue)
 
 /**
  * The PNG Heightmap loader.
+ * Non-interlaced images are decoded one row at a time, so besides the greyscale map only a single row has to be kept in memory.
+ * @param map The greyscale map to fill, with one byte per pixel.
+ * @param image Buffer for the decoded rows; owned by the caller so it is freed when libpng jumps back on an error.
+ * @param row_pointers Pointers to the rows of \a image for interlaced images; owned by the caller for the same reason.
+ * @param png_ptr The PNG being read, with all transforms set up.
+ * @param info_ptr The information of the PNG being read.
+ * @param passes The number of passes needed to read the (possibly interlaced) image.
  */
-static void ReadHeightmapPNGImageData(std::span<uint8_t> map, png_structp png_ptr, png_infop info_ptr)
+static void ReadHeightmapPNGImageData(std::span<uint8_t> map, std::vector<uint8_t> &image, std::vector<png_bytep> &row_pointers, png_structp png_ptr, png_infop info_ptr, int passes)
 {
-	uint x, y;
 	uint8_t gray_palette[256];
-	png_bytep *row_pointers = nullptr;
 	bool has_palette = png_get_color_type(png_ptr, info_ptr) == PNG_COLOR_TYPE_PALETTE;
 	uint channels = png_get_channels(png_ptr, info_ptr);
+	uint width = png_get_image_width(png_ptr, info_ptr);
+	uint height = png_get_image_height(png_ptr, info_ptr);
+	size_t row_bytes = png_get_rowbytes(png_ptr, info_ptr);
 
 	/* Get palette and convert it to greyscale */
 	if (has_palette) {
@@ -113,24 +121,36 @@ static void ReadHeightmapPNGImageData(std::span<uint8_t> map, png_structp png_pt
 		}
 	}
 
-	row_pointers = png_get_rows(png_ptr, info_ptr);
-
-	/* Read the raw image data and convert in 8-bit greyscale */
-	for (x = 0; x < png_get_image_width(png_ptr, info_ptr); x++) {
-		for (y = 0; y < png_get_image_height(png_ptr, info_ptr); y++) {
-			uint8_t *pixel = &map[y * png_get_image_width(png_ptr, info_ptr) + x];
-			uint x_offset = x * channels;
-
+	/* Convert one row of raw image data into 8-bit greyscale */
+	auto convert_row = [&](uint y, const uint8_t *row) {
+		uint8_t *pixel = &map[static_cast<size_t>(y) * width];
+		for (uint x = 0; x < width; x++, row += channels) {
 			if (has_palette) {
-				*pixel = gray_palette[row_pointers[y][x_offset]];
+				*pixel++ = gray_palette[row[0]];
 			} else if (channels == 3) {
-				*pixel = RGBToGreyscale(row_pointers[y][x_offset + 0],
-						row_pointers[y][x_offset + 1], row_pointers[y][x_offset + 2]);
+				*pixel++ = RGBToGreyscale(row[0], row[1], row[2]);
 			} else {
-				*pixel = row_pointers[y][x_offset];
+				*pixel++ = row[0];
 			}
 		}
+	};
+
+	if (passes > 1) {
+		/* Every pass of an interlaced image fills in more pixels of all rows, so keep them all. */
+		image.resize(row_bytes * height);
+		row_pointers.resize(height);
+		for (uint y = 0; y < height; y++) row_pointers[y] = &image[y * row_bytes];
+		png_read_image(png_ptr, row_pointers.data());
+		for (uint y = 0; y < height; y++) convert_row(y, row_pointers[y]);
+	} else {
+		image.resize(row_bytes);
+		for (uint y = 0; y < height; y++) {
+			png_read_row(png_ptr, image.data(), nullptr);
+			convert_row(y, image.data());
+		}
 	}
+
+	png_read_end(png_ptr, nullptr);
 }
 
 /**
@@ -142,6 +162,8 @@ static bool ReadHeightmapPNG(std::string_view filename, uint *x, uint *y, std::v
 {
 	png_structp png_ptr = nullptr;
 	png_infop info_ptr  = nullptr;
+	std::vector<uint8_t> image;
+	std::vector<png_bytep> row_pointers;
 
 	auto fp = FioFOpenFile(filename, "rb", HEIGHTMAP_DIR);
 	if (!fp.has_value()) {
@@ -163,11 +185,15 @@ static bool ReadHeightmapPNG(std::string_view filename, uint *x, uint *y, std::v
 	}
 
 	png_init_io(png_ptr, *fp);
+	png_read_info(png_ptr, info_ptr);
 
-	/* Allocate memory and read image, without alpha or 16-bit samples
+	/* Read the image without alpha or 16-bit samples
 	 * (result is either 8-bit indexed/greyscale or 24-bit RGB) */
 	png_set_packing(png_ptr);
-	png_read_png(png_ptr, info_ptr, PNG_TRANSFORM_PACKING | PNG_TRANSFORM_STRIP_ALPHA | PNG_TRANSFORM_STRIP_16, nullptr);
+	png_set_strip_alpha(png_ptr);
+	png_set_strip_16(png_ptr);
+	int passes = png_set_interlace_handling(png_ptr);
+	png_read_update_info(png_ptr, info_ptr);
 
 	/* Maps of wrong colour-depth are not used.
 	 * (this should have been taken care of by stripping alpha and 16-bit samples on load) */
@@ -188,7 +214,7 @@ static bool ReadHeightmapPNG(std::string_view filename, uint *x, uint *y, std::v
 
 	if (map != nullptr) {
 		map->resize(static_cast<size_t>(width) * height);
-		ReadHeightmapPNGImageData(*map, png_ptr, info_ptr);
+		ReadHeightmapPNGImageData(*map, image, row_pointers, png_ptr, info_ptr, passes);
 	}
 
 	*x = width;
@@ -1245,6 +1245,10 @@ void OnTick_Industry()
 
 	if (_game_mode == GM_EDITOR) return;
 
+	/* The industries are produced serially in pool order. ProduceIndustryGoods and the
+	 * production callback draw from the game Random(), the callbacks share the static
+	 * temporary storage of the resolver and may read other industries and towns, and
+	 * planting fields or chopping trees changes the map. */
 	for (Industry *i : Industry::Iterate()) {
 		ProduceIndustryGoods(i);
 
@@ -1519,6 +1523,40 @@ static CommandCost CheckIfIndustryTilesAreFree(TileIndex tile, const IndustryTil
 	return CommandCost();
 }
 
+/**
+ * Check the cheap requirements of #CheckIfIndustryTilesAreFree, without clearing any tiles.
+ * When this returns true, #CheckIfIndustryTilesAreFree fails for the same site.
+ * @param tile Position to check.
+ * @param layout Industry tiles table.
+ * @param type Type of the industry.
+ * @return Whether a tile of the layout can certainly not be used for the industry.
+ */
+static bool IsIndustrySiteObviouslyUnsuitable(TileIndex tile, const IndustryTileLayout &layout, IndustryType type)
+{
+	IndustryBehaviours ind_behav = GetIndustrySpec(type)->behaviour;
+	bool must_be_house = ind_behav.Any({IndustryBehaviour::OnlyInTown, IndustryBehaviour::Town1200More});
+
+	for (const IndustryTileLayoutTile &it : layout) {
+		IndustryGfx gfx = GetTranslatedIndustryTileID(it.gfx);
+		TileIndex cur_tile = TileAddWrap(tile, it.ti.x, it.ti.y);
+
+		if (!IsValidTile(cur_tile)) return true;
+
+		if (gfx == GFX_WATERTILE_SPECIALCHECK) {
+			if (!IsWaterTile(cur_tile) || !IsTileFlat(cur_tile)) return true;
+		} else {
+			if (IsBridgeAbove(cur_tile)) return true;
+
+			const IndustryTileSpec *its = GetIndustryTileSpec(gfx);
+			if (!HasBit(its->slopes_refused, 5) && ((HasTileWaterClass(cur_tile) && IsTileOnWater(cur_tile)) != ind_behav.Test(IndustryBehaviour::BuiltOnWater))) return true;
+
+			if (must_be_house && !IsTileType(cur_tile, MP_HOUSE)) return true;
+		}
+	}
+
+	return false;
+}
+
 /**
  * Check slope requirements for industry tiles.
  * @param tile                    Position to check.
@@ -2290,6 +2328,11 @@ static Industry *CreateNewIndustry(TileIndex tile, IndustryType type, IndustryAv
 	uint32_t seed2 = Random();
 	Industry *i = nullptr;
 	size_t layout_index = RandomRange((uint32_t)indspec->layouts.size());
+
+	/* Most of the random sites are unsuitable. Reject those failing the cheap tile checks before
+	 * checking the town, clearing the tiles and asking NewGRFs; the result would be the same. */
+	if (IsIndustrySiteObviouslyUnsuitable(tile, indspec->layouts[layout_index], type)) return nullptr;
+
 	[[maybe_unused]] CommandCost ret = CreateNewIndustryHelper(tile, type, DoCommandFlag::Execute, indspec, layout_index, seed, GB(seed2, 0, 16), OWNER_NONE, creation_type, &i);
 	assert(i != nullptr || ret.Failed());
 	return i;
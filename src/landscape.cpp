@@ -39,6 +39,7 @@
 #include "station_func.h"
 #include "pathfinder/water_regions.h"
 #include "pathfinder/yapf/yapf_river_builder.h"
+#include "trace.h"
 
 #include "table/strings.h"
 #include "table/sprites.h"
@@ -98,6 +99,14 @@ static const uint TILE_UPDATE_FREQUENCY = 1 << TILE_UPDATE_FREQUENCY_LOG;  ///<
  */
 static std::unique_ptr<SnowLine> _snow_line;
 
+/**
+ * The date for which #_snow_line_height_cache holds the variable snow line height.
+ * The tile loops and drawing ask for the snow line for every tile, but it only changes once a day.
+ * @ingroup SnowLineGroup
+ */
+static std::optional<TimerGameCalendar::Date> _snow_line_cache_date;
+static uint8_t _snow_line_height_cache; ///< Variable snow line height at #_snow_line_cache_date. @ingroup SnowLineGroup
+
 /**
  * Map 2D viewport or smallmap coordinate to 3D world or tile coordinate.
  * Function takes into account height of tiles and foundations.
@@ -595,6 +604,7 @@ bool IsSnowLineSet()
 void SetSnowLine(std::unique_ptr<SnowLine> &&snow_line)
 {
 	_snow_line = std::move(snow_line);
+	_snow_line_cache_date.reset();
 }
 
 /**
@@ -606,8 +616,12 @@ uint8_t GetSnowLine()
 {
 	if (_snow_line == nullptr) return _settings_game.game_creation.snow_line_height;
 
-	TimerGameCalendar::YearMonthDay ymd = TimerGameCalendar::ConvertDateToYMD(TimerGameCalendar::date);
-	return _snow_line->table[ymd.month][ymd.day];
+	if (_snow_line_cache_date != TimerGameCalendar::date) {
+		TimerGameCalendar::YearMonthDay ymd = TimerGameCalendar::ConvertDateToYMD(TimerGameCalendar::date);
+		_snow_line_height_cache = _snow_line->table[ymd.month][ymd.day];
+		_snow_line_cache_date = TimerGameCalendar::date;
+	}
+	return _snow_line_height_cache;
 }
 
 /**
@@ -637,6 +651,7 @@ uint8_t LowestSnowLine()
 void ClearSnowLine()
 {
 	_snow_line = nullptr;
+	_snow_line_cache_date.reset();
 }
 
 /**
@@ -793,6 +808,7 @@ TileIndex _cur_tileloop_tile;
  */
 void RunTileLoop()
 {
+	TraceZone zone("RunTileLoop");
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
 
 	/* The pseudorandom sequence of tiles is generated using a Galois linear feedback
@@ -821,6 +837,9 @@ void RunTileLoop()
 		count--;
 	}
 
+	/* The tiles must be looped in this exact order, one after the other. Even the tile loops
+	 * of trees and clear ground draw from the shared game random generator and change their
+	 * neighbours, e.g. by spreading trees, farmland fields or flooding. */
 	while (count--) {
 		_tile_type_procs[GetTileType(tile)]->tile_loop_proc(tile);
 
@@ -1359,6 +1378,12 @@ static bool CountConnectedSeaTiles(TileIndex tile, std::unordered_set<TileIndex>
 	return false;
 }
 
+/**
+ * Tiles already visited by the breadth first search of FlowRiver.
+ * One bit per tile, so marking a tile is cheaper than hashing it into a set.
+ */
+static std::vector<bool> _river_search_marks;
+
 /**
  * Try to flow the river down from a given begin.
  * @param spring The springing point of the river.
@@ -1374,8 +1399,7 @@ static std::tuple<bool, bool> FlowRiver(TileIndex spring, TileIndex begin, uint
 
 	int height_begin = TileHeight(begin);
 
-	std::unordered_set<TileIndex> marks;
-	marks.insert(begin);
+	_river_search_marks[begin.base()] = true;
 
 	std::vector<TileIndex> queue;
 	queue.push_back(begin);
@@ -1418,13 +1442,16 @@ static std::tuple<bool, bool> FlowRiver(TileIndex spring, TileIndex begin, uint
 
 		for (DiagDirection d = DIAGDIR_BEGIN; d < DIAGDIR_END; d++) {
 			TileIndex t = end + TileOffsByDiagDir(d);
-			if (IsValidTile(t) && !marks.contains(t) && RiverFlowsDown(end, t)) {
-				marks.insert(t);
+			if (IsValidTile(t) && !_river_search_marks[t.base()] && RiverFlowsDown(end, t)) {
+				_river_search_marks[t.base()] = true;
 				queue.push_back(t);
 			}
 		}
 	}
 
+	/* Every marked tile is in the queue, so this clears the marks for the next search. */
+	for (TileIndex t : queue) _river_search_marks[t.base()] = false;
+
 	bool main_river = false;
 	if (found) {
 		/* Flow further down hill. */
@@ -1456,6 +1483,7 @@ static void CreateRivers()
 	uint wells = Map::ScaleBySize(4 << _settings_game.game_creation.amount_of_rivers);
 	const uint num_short_rivers = wells - std::max(1u, wells / 10);
 	SetGeneratingWorldProgress(GWP_RIVER, wells + TILE_UPDATE_FREQUENCY / 64); // Include the tile loop calls below.
+	_river_search_marks.assign(Map::Size(), false);
 
 	/* Try to create long rivers. */
 	for (; wells > num_short_rivers; wells--) {
@@ -1487,6 +1515,8 @@ static void CreateRivers()
 		}
 	}
 
+	_river_search_marks = {};
+
 	/* Widening rivers may have left some tiles requiring to be watered. */
 	ConvertGroundTilesIntoWaterTiles();
 
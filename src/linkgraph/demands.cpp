@@ -196,6 +196,9 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 	scaler.SetDemandPerNode(num_demands);
 	uint chance = 0;
 
+	/* The pairs are visited in a fixed, rotating order. Each assignment reduces the undelivered
+	 * supply and remaining acceptance seen by the pairs after it, and the chance counter is shared
+	 * by all pairs. So the loop cannot be split up or vectorised without changing the demands. */
 	while (!supplies.empty() && !demands.empty()) {
 		NodeID from_id = supplies.front();
 		supplies.pop();
@@ -53,20 +53,11 @@ const PixelColour LinkGraphOverlay::LINK_COLOURS[][12] = {
 }
 };
 
-/**
- * Get a DPI for the widget we will be drawing to.
- * @param dpi DrawPixelInfo to fill with the desired dimensions.
- */
-void LinkGraphOverlay::GetWidgetDpi(DrawPixelInfo *dpi) const
-{
-	const NWidgetBase *wi = this->window->GetWidget<NWidgetBase>(this->widget_id);
-	dpi->left = dpi->top = 0;
-	dpi->width = wi->current_x;
-	dpi->height = wi->current_y;
-}
-
 /**
  * Rebuild the cache and recalculate which links and stations to be shown.
+ * The cache holds the links and stations of the whole map, so it stays valid
+ * when the window is scrolled or zoomed; only the drawing clips them to the
+ * visible area.
  */
 void LinkGraphOverlay::RebuildCache()
 {
@@ -74,14 +65,9 @@ void LinkGraphOverlay::RebuildCache()
 	this->cached_stations.clear();
 	if (this->company_mask.None()) return;
 
-	DrawPixelInfo dpi;
-	this->GetWidgetDpi(&dpi);
-
 	for (const Station *sta : Station::Iterate()) {
 		if (sta->rect.IsEmpty()) continue;
 
-		Point pta = this->GetStationMiddle(sta);
-
 		StationID from = sta->index;
 		StationLinkMap &seen_links = this->cached_links[from];
 
@@ -106,15 +92,12 @@ void LinkGraphOverlay::RebuildCache()
 				if (stb->owner != OWNER_NONE && sta->owner != OWNER_NONE && !this->company_mask.Test(stb->owner)) continue;
 				if (stb->rect.IsEmpty()) continue;
 
-				if (!this->IsLinkVisible(pta, this->GetStationMiddle(stb), &dpi)) continue;
-
 				this->AddLinks(sta, stb);
 				seen_links[to]; // make sure it is created and marked as seen
 			}
 		}
-		if (this->IsPointVisible(pta, &dpi)) {
-			this->cached_stations.emplace_back(from, supply);
-		}
+		if (seen_links.empty()) this->cached_links.erase(from);
+		this->cached_stations.emplace_back(from, supply);
 	}
 }
 
@@ -53,12 +53,12 @@ void LinkGraphJob::EraseFlows(StationID from)
 }
 
 /**
- * Spawn a thread if possible and run the link graph job in the thread. If
- * that's not possible run the job right now in the current thread.
+ * Hand the link graph job to the worker threads of the schedule if possible.
+ * If that's not possible run the job right now in the current thread.
  */
 void LinkGraphJob::SpawnThread()
 {
-	if (!StartNewThread(&this->thread, "ottd:linkgraph", &(LinkGraphSchedule::Run), this)) {
+	if (!LinkGraphSchedule::instance.StartJob(this)) {
 		/* Of course this will hang a bit.
 		 * On the other hand, if you want to play games which make this hang noticeably
 		 * on a platform without threads then you'll probably get other problems first.
@@ -71,13 +71,11 @@ void LinkGraphJob::SpawnThread()
 }
 
 /**
- * Join the calling thread with this job's thread if threading is enabled.
+ * Wait until the worker threads are done with this job, if it was handed to them.
  */
 void LinkGraphJob::JoinThread()
 {
-	if (this->thread.joinable()) {
-		this->thread.join();
-	}
+	LinkGraphSchedule::instance.WaitForJob(this);
 }
 
 /**
@@ -83,7 +83,7 @@ public:
 		PathList paths{}; ///< Paths through this node, sorted so that those with flow == 0 are in the back.
 		FlowStatMap flows{}; ///< Planned flows to other nodes.
 
-		std::vector<EdgeAnnotation> edges{}; ///< Annotations for all edges originating at this node.
+		std::vector<EdgeAnnotation> edges{}; ///< Annotations for all edges originating at this node, sorted by destination like the edges of the base node.
 		std::vector<DemandAnnotation> demands{}; ///< Annotations for the demand to all other nodes.
 
 		NodeAnnotation(const LinkGraph::BaseNode &node, size_t size) : base(node), undelivered_supply(node.supply)
@@ -100,8 +100,8 @@ public:
 		 */
 		EdgeAnnotation &operator[](NodeID to)
 		{
-			auto it = std::ranges::find_if(this->edges, [=] (const EdgeAnnotation &e) { return e.base.dest_node == to; });
-			assert(it != this->edges.end());
+			auto it = std::ranges::lower_bound(this->edges, to, std::less{}, [] (const EdgeAnnotation &e) { return e.base.dest_node; });
+			assert(it != this->edges.end() && it->base.dest_node == to);
 			return *it;
 		}
 
@@ -112,8 +112,8 @@ public:
 		 */
 		const EdgeAnnotation &operator[](NodeID to) const
 		{
-			auto it = std::ranges::find_if(this->edges, [=] (const EdgeAnnotation &e) { return e.base.dest_node == to; });
-			assert(it != this->edges.end());
+			auto it = std::ranges::lower_bound(this->edges, to, std::less{}, [] (const EdgeAnnotation &e) { return e.base.dest_node; });
+			assert(it != this->edges.end() && it->base.dest_node == to);
 			return *it;
 		}
 
@@ -161,7 +161,7 @@ private:
 protected:
 	const LinkGraph link_graph; ///< Link graph to by analyzed. Is copied when job is started and mustn't be modified later.
 	const LinkGraphSettings settings; ///< Copy of _settings_game.linkgraph at spawn time.
-	std::thread thread{}; ///< Thread the job is running in or a default-constructed thread if it's running in the main thread.
+	bool in_worker_pool = false; ///< Is the job waiting for or being run by a worker thread. Protected by LinkGraphSchedule::worker_mutex.
 	TimerGameEconomy::Date join_date = EconomyTime::INVALID_DATE; ///< Date when the job is to be joined.
 	NodeAnnotationVector nodes{}; ///< Extra node data necessary for link graph calculation.
 	std::atomic<bool> job_completed = false; ///< Is the job still running. This is accessed by multiple threads and reads may be stale.
@@ -17,6 +17,7 @@
 #include "../command_func.h"
 #include "../network/network.h"
 #include "../misc_cmd.h"
+#include "../trace.h"
 
 #include "../safeguards.h"
 
@@ -72,7 +73,7 @@ void LinkGraphSchedule::JoinNext()
 	if (!next->IsScheduledToBeJoined()) return;
 	this->running.pop_front();
 	LinkGraphID id = next->LinkGraphIndex();
-	delete next; // implicitly joins the thread
+	delete next; // implicitly waits for the worker thread
 	if (LinkGraph::IsValidID(id)) {
 		LinkGraph *lg = LinkGraph::Get(id);
 		this->Dequeue(lg); // Dequeue to avoid double-queueing recycled IDs.
@@ -86,6 +87,8 @@ void LinkGraphSchedule::JoinNext()
  */
 /* static */ void LinkGraphSchedule::Run(LinkGraphJob *job)
 {
+	TraceZone zone("LinkGraphSchedule::Run");
+
 	for (const auto &handler : instance.handlers) {
 		if (job->IsJobAborted()) return;
 		handler->Run(*job);
@@ -105,8 +108,116 @@ void LinkGraphSchedule::JoinNext()
 }
 
 /**
- * Start all threads in the running list. This is only useful for save/load.
- * Usually threads are started when the job is created.
+ * Start the worker threads, if they are not running yet.
+ * One worker is started per hardware thread, so all running jobs can make progress at once without
+ * competing for the processors more than necessary.
+ * @return True if at least one worker is running.
+ */
+bool LinkGraphSchedule::StartWorkers()
+{
+	if (!this->workers.empty()) return true;
+
+	this->workers_stop = false;
+	uint count = std::max(1U, std::thread::hardware_concurrency());
+	for (uint i = 0; i < count; i++) {
+		std::thread worker;
+		if (!StartNewThread(&worker, "ottd:linkgraph", &LinkGraphSchedule::WorkerThreadThunk, this)) break;
+		this->workers.push_back(std::move(worker));
+	}
+	return !this->workers.empty();
+}
+
+/**
+ * Stop the worker threads. Jobs that were not picked up yet stay queued,
+ * and are run by #WaitForJob when they are joined.
+ */
+void LinkGraphSchedule::StopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->worker_mutex);
+		this->workers_stop = true;
+	}
+	this->work_cv.notify_all();
+	for (std::thread &worker : this->workers) worker.join();
+	this->workers.clear();
+}
+
+/**
+ * Entry point of the worker threads.
+ * @param schedule The schedule to run the jobs of.
+ */
+/* static */ void LinkGraphSchedule::WorkerThreadThunk(LinkGraphSchedule *schedule)
+{
+	schedule->WorkerThread();
+}
+
+/**
+ * Main loop of a worker thread. The jobs are taken in the order they have to be joined,
+ * so the job that is due first is never waiting for jobs that are due later.
+ */
+void LinkGraphSchedule::WorkerThread()
+{
+	std::unique_lock<std::mutex> lock(this->worker_mutex);
+	for (;;) {
+		this->work_cv.wait(lock, [this]() { return this->workers_stop || !this->pending_jobs.empty(); });
+		if (this->workers_stop) return;
+
+		LinkGraphJob *job = this->pending_jobs.front();
+		this->pending_jobs.pop_front();
+
+		lock.unlock();
+		LinkGraphSchedule::Run(job);
+		lock.lock();
+
+		job->in_worker_pool = false;
+		this->job_done_cv.notify_all();
+	}
+}
+
+/**
+ * Queue a job for the worker threads.
+ * @param job The job to run.
+ * @return True if the job was queued, false if no worker thread could be started.
+ */
+bool LinkGraphSchedule::StartJob(LinkGraphJob *job)
+{
+	if (!this->StartWorkers()) return false;
+
+	{
+		std::lock_guard<std::mutex> lock(this->worker_mutex);
+		job->in_worker_pool = true;
+		this->pending_jobs.push_back(job);
+	}
+	this->work_cv.notify_one();
+	return true;
+}
+
+/**
+ * Wait until the worker threads are done with a job. If no worker has picked up
+ * the job yet, it is run in the calling thread instead.
+ * @param job The job to wait for.
+ */
+void LinkGraphSchedule::WaitForJob(LinkGraphJob *job)
+{
+	std::unique_lock<std::mutex> lock(this->worker_mutex);
+	if (!job->in_worker_pool) return;
+
+	auto it = std::ranges::find(this->pending_jobs, job);
+	if (it != this->pending_jobs.end()) {
+		this->pending_jobs.erase(it);
+		job->in_worker_pool = false;
+		lock.unlock();
+		/* Aborted jobs return right away. */
+		LinkGraphSchedule::Run(job);
+		return;
+	}
+
+	this->job_done_cv.wait(lock, [job]() { return !job->in_worker_pool; });
+}
+
+/**
+ * Hand all jobs in the running list to the worker threads. This is only useful for save/load.
+ * Usually jobs are handed over when they are created.
  */
 void LinkGraphSchedule::SpawnAll()
 {
@@ -157,6 +268,7 @@ LinkGraphSchedule::LinkGraphSchedule()
 LinkGraphSchedule::~LinkGraphSchedule()
 {
 	this->Clear();
+	this->StopWorkers();
 }
 
 /**
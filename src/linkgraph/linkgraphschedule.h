@@ -12,6 +12,10 @@
 
 #include "linkgraph.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 class LinkGraphJob;
 
 /**
@@ -46,6 +50,18 @@ protected:
 	GraphList schedule;            ///< Queue for new jobs.
 	JobList running;               ///< Currently running jobs.
 
+	std::vector<std::thread> workers; ///< Threads running the jobs, started when the first job is spawned.
+	std::mutex worker_mutex; ///< Protects #pending_jobs, #workers_stop and LinkGraphJob::in_worker_pool.
+	std::condition_variable work_cv; ///< Signalled when a job is queued or the workers have to stop.
+	std::condition_variable job_done_cv; ///< Signalled when a worker finished a job.
+	std::deque<LinkGraphJob *> pending_jobs; ///< Jobs waiting for a free worker, in the order they have to be joined.
+	bool workers_stop = false; ///< Whether the workers have to stop.
+
+	bool StartWorkers();
+	void StopWorkers();
+	void WorkerThread();
+	static void WorkerThreadThunk(LinkGraphSchedule *schedule);
+
 public:
 	/* This is a tick where not much else is happening, so a small lag might go unnoticed. */
 	static const uint SPAWN_JOIN_TICK = 21; ///< Tick when jobs are spawned or joined every day.
@@ -54,6 +70,9 @@ public:
 	static void Run(LinkGraphJob *job);
 	static void Clear();
 
+	bool StartJob(LinkGraphJob *job);
+	void WaitForJob(LinkGraphJob *job);
+
 	void SpawnNext();
 	bool IsJoinWithUnfinishedJobDue() const;
 	void JoinNext();
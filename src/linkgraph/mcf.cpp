@@ -44,12 +44,7 @@ public:
 	 */
 	inline void UpdateAnnotation() { }
 
-	/**
-	 * Comparator for std containers.
-	 */
-	struct Comparator {
-		bool operator()(const DistanceAnnotation *x, const DistanceAnnotation *y) const;
-	};
+	static bool IsBefore(uint x_anno, uint y_anno, NodeID x, NodeID y);
 };
 
 /**
@@ -86,12 +81,7 @@ public:
 		this->cached_annotation = this->GetCapacityRatio();
 	}
 
-	/**
-	 * Comparator for std containers.
-	 */
-	struct Comparator {
-		bool operator()(const CapacityAnnotation *x, const CapacityAnnotation *y) const;
-	};
+	static bool IsBefore(int x_anno, int y_anno, NodeID x, NodeID y);
 };
 
 /**
@@ -263,22 +253,47 @@ bool CapacityAnnotation::IsBetter(const CapacityAnnotation *base, uint cap,
 template <class Tannotation, class Tedge_iterator>
 void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 {
-	typedef std::set<Tannotation *, typename Tannotation::Comparator> AnnoSet;
+	/** A node waiting to be searched. It is outdated when the node has been queued again or searched since. */
+	struct QueuedNode {
+		decltype(std::declval<Tannotation>().GetAnnotation()) annotation; ///< Annotation of the node when it was queued.
+		NodeID node; ///< The queued node.
+		uint version; ///< Number of times the node had been queued or searched before.
+	};
+	/* The heap functions keep the greatest element at the front, so the node to be searched first has to compare greatest. */
+	auto search_later = [](const QueuedNode &x, const QueuedNode &y) {
+		return Tannotation::IsBefore(y.annotation, x.annotation, y.node, x.node);
+	};
+
 	Tedge_iterator iter(this->job);
 	uint16_t size = this->job.Size();
-	AnnoSet annos;
+	std::vector<QueuedNode> queue;
+	std::vector<uint> versions(size, 0);
+	queue.reserve(size);
 	paths.resize(size, nullptr);
 	for (NodeID node = 0; node < size; ++node) {
 		Tannotation *anno = new Tannotation(node, node == source_node);
 		anno->UpdateAnnotation();
-		annos.insert(anno);
+		queue.push_back({anno->GetAnnotation(), node, 0});
 		paths[node] = anno;
 	}
-	while (!annos.empty()) {
-		typename AnnoSet::iterator i = annos.begin();
-		Tannotation *source = *i;
-		annos.erase(i);
-		NodeID from = source->GetNode();
+	std::make_heap(queue.begin(), queue.end(), search_later);
+
+	/* Prioritize the fastest route for passengers, mail and express cargo,
+	 * and the shortest route for other classes of cargo.
+	 * In-between stops are punished with a 1 tile or 1 day penalty. */
+	bool express = IsCargoInClass(this->job.Cargo(), CargoClass::Passengers) ||
+		IsCargoInClass(this->job.Cargo(), CargoClass::Mail) ||
+		IsCargoInClass(this->job.Cargo(), CargoClass::Express);
+
+	while (!queue.empty()) {
+		std::pop_heap(queue.begin(), queue.end(), search_later);
+		QueuedNode queued = queue.back();
+		queue.pop_back();
+		if (queued.version != versions[queued.node]) continue;
+		++versions[queued.node];
+
+		NodeID from = queued.node;
+		Tannotation *source = static_cast<Tannotation *>(paths[from]);
 		iter.SetNode(source_node, from);
 		for (NodeID to = iter.Next(); to != INVALID_NODE; to = iter.Next()) {
 			if (to == from) continue; // Not a real edge but a consumption sign.
@@ -289,12 +304,6 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 				capacity /= 100;
 				if (capacity == 0) capacity = 1;
 			}
-			/* Prioritize the fastest route for passengers, mail and express cargo,
-			 * and the shortest route for other classes of cargo.
-			 * In-between stops are punished with a 1 tile or 1 day penalty. */
-			bool express = IsCargoInClass(this->job.Cargo(), CargoClass::Passengers) ||
-				IsCargoInClass(this->job.Cargo(), CargoClass::Mail) ||
-				IsCargoInClass(this->job.Cargo(), CargoClass::Express);
 			uint distance = DistanceMaxPlusManhattan(this->job[from].base.xy, this->job[to].base.xy) + 1;
 			/* Compute a default travel time from the distance and an average speed of 1 tile/day. */
 			uint time = (edge.base.TravelTime() != 0) ? edge.base.TravelTime() + Ticks::DAY_TICKS : distance * Ticks::DAY_TICKS;
@@ -302,10 +311,10 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 
 			Tannotation *dest = static_cast<Tannotation *>(paths[to]);
 			if (dest->IsBetter(source, capacity, capacity - edge.Flow(), distance_anno)) {
-				annos.erase(dest);
 				dest->Fork(source, capacity, capacity - edge.Flow(), distance_anno);
 				dest->UpdateAnnotation();
-				annos.insert(dest);
+				queue.push_back({dest->GetAnnotation(), to, ++versions[to]});
+				std::push_heap(queue.begin(), queue.end(), search_later);
 			}
 		}
 	}
@@ -585,46 +594,33 @@ MCF2ndPass::MCF2ndPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 }
 
 /**
- * Relation that creates a weak order without duplicates.
- * Avoid accidentally deleting different paths of the same capacity/distance in
- * a set. When the annotation is the same node IDs are compared, so there are
- * no equal ranges.
- * @tparam T Type to be compared on.
- * @param x_anno First value.
- * @param y_anno Second value.
- * @param x Node id associated with the first value.
- * @param y Node id associated with the second value.
+ * Check whether a node is searched before another one. Nodes with the most
+ * capacity left are searched first; when the capacities are the same the node
+ * IDs are compared, so the order is the same everywhere.
+ * @param x_anno Annotation of the first node.
+ * @param y_anno Annotation of the second node.
+ * @param x ID of the first node.
+ * @param y ID of the second node.
+ * @return If x is searched before y.
  */
-template <typename T>
-bool Greater(T x_anno, T y_anno, NodeID x, NodeID y)
+/* static */ bool CapacityAnnotation::IsBefore(int x_anno, int y_anno, NodeID x, NodeID y)
 {
-	if (x_anno > y_anno) return true;
-	if (x_anno < y_anno) return false;
+	if (x_anno != y_anno) return x_anno > y_anno;
 	return x > y;
 }
 
 /**
- * Compare two capacity annotations.
- * @param x First capacity annotation.
- * @param y Second capacity annotation.
- * @return If x is better than y.
- */
-bool CapacityAnnotation::Comparator::operator()(const CapacityAnnotation *x,
-		const CapacityAnnotation *y) const
-{
-	return x != y && Greater<int>(x->GetAnnotation(), y->GetAnnotation(),
-			x->GetNode(), y->GetNode());
-}
-
-/**
- * Compare two distance annotations.
- * @param x First distance annotation.
- * @param y Second distance annotation.
- * @return If x is better than y.
+ * Check whether a node is searched before another one. The nearest nodes are
+ * searched first; when the distances are the same the node IDs are compared,
+ * so the order is the same everywhere.
+ * @param x_anno Annotation of the first node.
+ * @param y_anno Annotation of the second node.
+ * @param x ID of the first node.
+ * @param y ID of the second node.
+ * @return If x is searched before y.
  */
-bool DistanceAnnotation::Comparator::operator()(const DistanceAnnotation *x,
-		const DistanceAnnotation *y) const
+/* static */ bool DistanceAnnotation::IsBefore(uint x_anno, uint y_anno, NodeID x, NodeID y)
 {
-	return x != y && !Greater<uint>(x->GetAnnotation(), y->GetAnnotation(),
-			x->GetNode(), y->GetNode());
+	if (x_anno != y_anno) return x_anno < y_anno;
+	return x < y;
 }
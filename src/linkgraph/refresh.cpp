@@ -129,6 +129,23 @@ void LinkRefresher::ResetRefit()
 	}
 }
 
+/**
+ * Check if branching to an order would immediately hit a hop that was already
+ * seen. If the order neither refits nor is conditional the branch would
+ * evaluate the hop from \a cur to it with the current cargo first and stop
+ * there, so it doesn't have to be created at all.
+ * @param cur Current order being evaluated.
+ * @param skip_to Order the branch would start at.
+ * @param skip_to_id Index of that order.
+ * @return True if the branch wouldn't do anything.
+ */
+bool LinkRefresher::IsBranchSeen(VehicleOrderID cur, const Order &skip_to, VehicleOrderID skip_to_id) const
+{
+	if (skip_to.IsType(OT_CONDITIONAL)) return false;
+	if ((skip_to.IsType(OT_GOTO_DEPOT) || skip_to.IsType(OT_GOTO_STATION)) && skip_to.IsRefit()) return false;
+	return this->seen_hops->contains(Hop(cur, skip_to_id, this->cargo));
+}
+
 /**
  * Predict the next order the vehicle will execute and resolve conditionals by
  * recursion and return next non-conditional order in list.
@@ -156,11 +173,10 @@ VehicleOrderID LinkRefresher::PredictNextOrder(VehicleOrderID cur, VehicleOrderI
 
 		if (orders[next].IsType(OT_CONDITIONAL)) {
 			VehicleOrderID skip_to = orderlist.GetNextDecisionNode(orders[next].GetConditionSkipToOrder(), num_hops);
-			if (skip_to != INVALID_VEH_ORDER_ID && num_hops < orderlist.GetNumOrders()) {
+			if (skip_to != INVALID_VEH_ORDER_ID && num_hops < orderlist.GetNumOrders() && !this->IsBranchSeen(cur, orders[skip_to], skip_to)) {
 				/* Make copies of capacity tracking lists. There is potential
 				 * for optimization here: If the vehicle never refits we don't
-				 * need to copy anything. Also, if we've seen the branched link
-				 * before we don't need to branch at all. */
+				 * need to copy anything. */
 				LinkRefresher branch(*this);
 				branch.RefreshLinks(cur, skip_to, flags, num_hops + 1);
 			}
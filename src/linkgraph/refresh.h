@@ -92,6 +92,7 @@ protected:
 
 	bool HandleRefit(CargoType refit_cargo);
 	void ResetRefit();
+	bool IsBranchSeen(VehicleOrderID cur, const Order &skip_to, VehicleOrderID skip_to_id) const;
 	void RefreshStats(VehicleOrderID cur, VehicleOrderID next);
 	VehicleOrderID PredictNextOrder(VehicleOrderID cur, VehicleOrderID next, RefreshFlags flags, uint num_hops = 0);
 
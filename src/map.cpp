@@ -13,6 +13,12 @@
 #include "error_func.h"
 #include "string_func.h"
 #include "pathfinder/water_regions.h"
+#include "tile_summary.h"
+
+#if defined(__linux__)
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
 
 #include "safeguards.h"
 
@@ -25,9 +31,36 @@
 
 /* static */ uint Map::initial_land_count; ///< Initial number of land tiles on the map.
 
-/* static */ std::unique_ptr<Tile::TileBase[]> Tile::base_tiles; ///< Base tiles of the map
-/* static */ std::unique_ptr<Tile::TileExtended[]> Tile::extended_tiles; ///< Extended tiles of the map
+/* static */ bool Map::huge_pages; ///< Whether the tile arrays are backed by huge pages.
+
+/* static */ std::unique_ptr<Tile::TileBase[], Tile::TileArrayDeleter> Tile::base_tiles; ///< Base tiles of the map
+/* static */ std::unique_ptr<Tile::TileExtended[], Tile::TileArrayDeleter> Tile::extended_tiles; ///< Extended tiles of the map
+
+/**
+ * Allocate the memory for one of the tile arrays. The tile loop and the
+ * pathfinders access the map randomly, so on large maps a lot of time is lost
+ * on TLB misses. Hence the memory is advised to be backed by huge pages, which
+ * has to happen before it is touched for the first time.
+ * @param size Size of the array in bytes.
+ * @param[out] huge_pages Cleared if the operating system did not accept the advice.
+ * @return The uninitialised memory.
+ */
+static void *AllocateTileMemory(size_t size, bool &huge_pages)
+{
+	void *data = ::operator new(size);
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	/* Only whole pages within the allocation can be advised. */
+	const uint page_size = static_cast<uint>(sysconf(_SC_PAGESIZE));
+	const uintptr_t start = Align(reinterpret_cast<uintptr_t>(data), page_size);
+	const uintptr_t end = (reinterpret_cast<uintptr_t>(data) + size) & ~static_cast<uintptr_t>(page_size - 1);
+	if (end <= start || madvise(reinterpret_cast<void *>(start), end - start, MADV_HUGEPAGE) != 0) huge_pages = false;
+#else
+	huge_pages = false;
+#endif
 
+	return data;
+}
 
 /**
  * (Re)allocates a map with the given dimension
@@ -54,10 +87,21 @@
 	Map::size = size_x * size_y;
 	Map::tile_mask = Map::size - 1;
 
-	Tile::base_tiles = std::make_unique<Tile::TileBase[]>(Map::size);
-	Tile::extended_tiles = std::make_unique<Tile::TileExtended[]>(Map::size);
+	static_assert(std::is_trivially_destructible_v<Tile::TileBase> && std::is_trivially_destructible_v<Tile::TileExtended>);
+
+	Map::huge_pages = true;
+	Tile::TileBase *base_tiles = static_cast<Tile::TileBase *>(AllocateTileMemory(Map::size * sizeof(Tile::TileBase), Map::huge_pages));
+	std::uninitialized_default_construct_n(base_tiles, Map::size);
+	Tile::base_tiles.reset(base_tiles);
+
+	Tile::TileExtended *extended_tiles = static_cast<Tile::TileExtended *>(AllocateTileMemory(Map::size * sizeof(Tile::TileExtended), Map::huge_pages));
+	std::uninitialized_default_construct_n(extended_tiles, Map::size);
+	Tile::extended_tiles.reset(extended_tiles);
+
+	Debug(map, 3, "Huge pages for the tile arrays: {}", Map::huge_pages ? "advised" : "unavailable");
 
 	AllocateWaterRegions();
+	ResetTileSummary();
 }
 
 /* static */ void Map::CountLandTiles()
@@ -39,6 +39,9 @@ private:
 		uint8_t m5 = 0; ///< General purpose
 	};
 
+	/* The fields most code reads (type, height and m5) share this 8 byte entry,
+	 * so inspecting a tile costs a single cache line. The rarely used fields
+	 * live in TileExtended. */
 	static_assert(sizeof(TileBase) == 8);
 
 	/**
@@ -51,8 +54,13 @@ private:
 		uint16_t m8 = 0; ///< General purpose
 	};
 
-	static std::unique_ptr<TileBase[]> base_tiles; ///< Pointer to the tile-array.
-	static std::unique_ptr<TileExtended[]> extended_tiles; ///< Pointer to the extended tile-array.
+	/** Deleter for the tile arrays, which are allocated as raw memory so they can be advised before first use. */
+	struct TileArrayDeleter {
+		void operator()(void *tiles) const { ::operator delete(tiles); }
+	};
+
+	static std::unique_ptr<TileBase[], TileArrayDeleter> base_tiles; ///< Pointer to the tile-array.
+	static std::unique_ptr<TileExtended[], TileArrayDeleter> extended_tiles; ///< Pointer to the extended tile-array.
 
 	TileIndex tile; ///< The tile to access the map data for.
 
@@ -241,10 +249,21 @@ private:
 
 	static uint initial_land_count; ///< Initial number of land tiles on the map.
 
+	static bool huge_pages; ///< Whether the operating system accepted to back the tile arrays with huge pages.
+
 public:
 	static void Allocate(uint size_x, uint size_y);
 	static void CountLandTiles();
 
+	/**
+	 * Check whether the tile arrays are backed by huge pages, if the operating system provides them.
+	 * @return True iff huge pages were successfully requested for the tile arrays.
+	 */
+	static inline bool HasHugePages()
+	{
+		return Map::huge_pages;
+	}
+
 	/**
 	 * Logarithm of the map size along the X side.
 	 * @note try to avoid using this one
@@ -292,6 +311,15 @@ public:
 		return Map::size;
 	}
 
+	/**
+	 * Get the memory used by the tiles of the map.
+	 * @return the number of bytes of the tile arrays
+	 */
+	inline static size_t GetTileBytes()
+	{
+		return static_cast<size_t>(Map::size) * (sizeof(Tile::TileBase) + sizeof(Tile::TileExtended));
+	}
+
 	/**
 	 * Gets the maximum X coordinate within the map, including MP_VOID
 	 * @return the maximum X coordinate
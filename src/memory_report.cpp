@@ -0,0 +1,95 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file memory_report.cpp Report of the memory used per pool, cache and script. */
+
+#include "stdafx.h"
+#include "memory_report.h"
+#include "core/pool_type.hpp"
+#include "map_func.h"
+#include "spritecache.h"
+#include "newgrf_sound.h"
+#include "company_base.h"
+#include "ai/ai_instance.hpp"
+#include "ai/ai_info.hpp"
+#include "game/game.hpp"
+#include "game/game_instance.hpp"
+#include "game/game_info.hpp"
+#include "console_func.h"
+
+#include "safeguards.h"
+
+/**
+ * Get the memory used per pool, per cache and per AI and game script.
+ * The bytes are those of the containers themselves; memory the items allocate on their own,
+ * such as the strings and vectors of a vehicle or station, is not included.
+ * @return The entries of the report, pools first.
+ */
+std::vector<MemoryReportEntry> GetMemoryReport()
+{
+	std::vector<MemoryReportEntry> report;
+
+	for (const PoolBase *pool : *PoolBase::GetPools()) {
+		PoolBase::MemoryUsage usage = pool->GetMemoryUsage();
+		report.emplace_back(MemoryReportCategory::Pool, std::string{usage.name}, usage.items, usage.bytes);
+	}
+
+	report.emplace_back(MemoryReportCategory::Cache, "map tiles", Map::IsInitialized() ? Map::Size() : 0, Map::IsInitialized() ? Map::GetTileBytes() : 0);
+
+	static const std::string_view sprite_types[] = { "normal", "map generator", "character", "recolour" };
+	const SpriteCacheStatsArray &sprites = GetSpriteCacheStats();
+	for (uint8_t type = 0; type < std::size(sprite_types); type++) {
+		report.emplace_back(MemoryReportCategory::Cache, fmt::format("sprite cache ({})", sprite_types[type]), sprites[type].sprites, sprites[type].bytes);
+	}
+	report.emplace_back(MemoryReportCategory::Cache, "NewGRF sounds", 0, GetSoundPoolAllocatedMemory());
+
+	for (const Company *c : Company::Iterate()) {
+		if (!c->is_ai || c->ai_instance == nullptr) continue;
+		std::string name = c->ai_info != nullptr ? fmt::format("AI {} ({})", c->index + 1, c->ai_info->GetName()) : fmt::format("AI {}", c->index + 1);
+		report.emplace_back(MemoryReportCategory::Script, std::move(name), 0, c->ai_instance->GetAllocatedMemory());
+	}
+	if (Game::GetInstance() != nullptr) {
+		std::string name = Game::GetInfo() != nullptr ? fmt::format("GS ({})", Game::GetInfo()->GetName()) : "GS";
+		report.emplace_back(MemoryReportCategory::Script, std::move(name), 0, Game::GetInstance()->GetAllocatedMemory());
+	}
+
+	return report;
+}
+
+/**
+ * Get the name of a category of the memory report.
+ * @param category The category.
+ * @return The name.
+ */
+std::string_view GetMemoryReportCategoryName(MemoryReportCategory category)
+{
+	switch (category) {
+		case MemoryReportCategory::Pool: return "pool";
+		case MemoryReportCategory::Cache: return "cache";
+		case MemoryReportCategory::Script: return "script";
+		default: NOT_REACHED();
+	}
+}
+
+/** Print the memory report to the console, the largest entries first. */
+void ConPrintMemoryReport()
+{
+	std::vector<MemoryReportEntry> report = GetMemoryReport();
+	std::ranges::stable_sort(report, std::greater{}, &MemoryReportEntry::bytes);
+
+	size_t total = 0;
+	for (const MemoryReportEntry &entry : report) total += entry.bytes;
+
+	IConsolePrint(CC_DEFAULT, "Memory in use: {} KiB", total / 1024);
+	for (const MemoryReportEntry &entry : report) {
+		if (entry.category != MemoryReportCategory::Pool && entry.count == 0) {
+			IConsolePrint(CC_DEFAULT, "  {:<6} {}: {} KiB", GetMemoryReportCategoryName(entry.category), entry.name, entry.bytes / 1024);
+		} else {
+			IConsolePrint(CC_DEFAULT, "  {:<6} {}: {} items, {} KiB", GetMemoryReportCategoryName(entry.category), entry.name, entry.count, entry.bytes / 1024);
+		}
+	}
+}
@@ -0,0 +1,32 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file memory_report.h Report of the memory used per pool, cache and script. */
+
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+/** Kind of memory in the memory report. */
+enum class MemoryReportCategory : uint8_t {
+	Pool, ///< A pool of game objects.
+	Cache, ///< The map or a cache of a subsystem.
+	Script, ///< The virtual machine of an AI or the game script.
+};
+
+/** One entry of the memory report. */
+struct MemoryReportEntry {
+	MemoryReportCategory category; ///< Kind of memory.
+	std::string name; ///< Name of the pool, cache or script.
+	size_t count; ///< Number of items, sprites or tiles; 0 when not counted.
+	size_t bytes; ///< Number of bytes used.
+};
+
+std::vector<MemoryReportEntry> GetMemoryReport();
+std::string_view GetMemoryReportCategoryName(MemoryReportCategory category);
+void ConPrintMemoryReport();
+
+#endif /* MEMORY_REPORT_H */
@@ -32,6 +32,9 @@
 #include "town_kdtree.h"
 #include "viewport_kdtree.h"
 #include "newgrf_profiling.h"
+#include "rpc/rpc_connectivity.h"
+#include "pathfinder/yapf/yapf_cache.h"
+#include "elrail_func.h"
 #include "3rdparty/monocypher/monocypher.h"
 
 #include "safeguards.h"
@@ -96,6 +99,9 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 	UnInitWindowSystem();
 
 	Map::Allocate(size_x, size_y);
+	RpcInvalidateConnectivity();
+	YapfNotifyRoadLayoutChange(INVALID_TILE);
+	ClearCatenaryLayouts();
 
 	_pause_mode = {};
 	_game_speed = 100;
@@ -134,9 +134,11 @@ void MxMixSamples(void *buffer, uint samples)
 	std::fill_n(static_cast<int16_t *>(buffer), 2 * samples, 0);
 
 	{
-		std::lock_guard<std::mutex> lock{ _music_stream_mutex };
+		/* Never wait for the game thread here; when it is changing the music
+		 * source, this buffer just goes without music. */
+		std::unique_lock<std::mutex> lock{ _music_stream_mutex, std::try_to_lock };
 		/* Fetch music if a sampled stream is available */
-		if (_music_stream) _music_stream((int16_t*)buffer, samples);
+		if (lock.owns_lock() && _music_stream) _music_stream((int16_t*)buffer, samples);
 	}
 
 	/* Check if any channels should be stopped. */
@@ -190,3 +190,21 @@ NetworkError GetSocketError(SOCKET d)
 
 	return NetworkError(err);
 }
+
+/**
+ * Wait for readiness on a set of sockets.
+ * This wraps poll() or WSAPoll(), so callers do not need to care about
+ * FD_SETSIZE limits like with select().
+ * @param fds The sockets and the events to wait for; revents is filled in.
+ * @param timeout_ms The time to wait in milliseconds; 0 to not block at all.
+ * @return The number of sockets with events, or a negative value on error.
+ */
+int PollSockets(std::span<pollfd> fds, int timeout_ms)
+{
+	if (fds.empty()) return 0;
+#if defined(_WIN32)
+	return WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), timeout_ms);
+#else
+	return poll(fds.data(), static_cast<nfds_t>(fds.size()), timeout_ms);
+#endif
+}
@@ -86,6 +86,7 @@ typedef unsigned long in_addr_t;
 #	include <errno.h>
 #	include <sys/time.h>
 #	include <netdb.h>
+#	include <poll.h>
 
 #   if defined(__EMSCRIPTEN__)
 /* Emscripten doesn't support AI_ADDRCONFIG and errors out on it. */
@@ -132,6 +133,7 @@ bool SetNonBlocking(SOCKET d);
 bool SetNoDelay(SOCKET d);
 bool SetReusePort(SOCKET d);
 NetworkError GetSocketError(SOCKET d);
+int PollSockets(std::span<pollfd> fds, int timeout_ms);
 
 /* Make sure these structures have the size we expect them to be */
 static_assert(sizeof(in_addr)  ==  4); ///< IPv4 addresses should be 4 bytes.
@@ -146,6 +148,41 @@ struct SocketSender {
 	}
 };
 
+/** Sender of several buffers with a single system call, where the platform supports that. */
+struct SocketGatherSender {
+	/** The maximum number of buffers that are sent at once; the minimum every POSIX system supports. */
+	static constexpr size_t MAX_BUFFERS = 16;
+
+	SOCKET sock;
+
+	ssize_t operator()(std::span<const std::span<const uint8_t>> buffers)
+	{
+		assert(!buffers.empty() && buffers.size() <= MAX_BUFFERS);
+#if defined(_WIN32)
+		std::array<WSABUF, MAX_BUFFERS> wsabufs;
+		for (size_t i = 0; i < buffers.size(); i++) {
+			wsabufs[i].buf = reinterpret_cast<char *>(const_cast<uint8_t *>(buffers[i].data()));
+			wsabufs[i].len = static_cast<ULONG>(buffers[i].size());
+		}
+		DWORD sent;
+		if (WSASend(this->sock, wsabufs.data(), static_cast<DWORD>(buffers.size()), &sent, 0, nullptr, nullptr) == SOCKET_ERROR) return -1;
+		return sent;
+#elif defined(UNIX) && !defined(__EMSCRIPTEN__)
+		std::array<iovec, MAX_BUFFERS> iov;
+		for (size_t i = 0; i < buffers.size(); i++) {
+			iov[i].iov_base = const_cast<uint8_t *>(buffers[i].data());
+			iov[i].iov_len = buffers[i].size();
+		}
+		msghdr msg{};
+		msg.msg_iov = iov.data();
+		msg.msg_iovlen = buffers.size();
+		return sendmsg(this->sock, &msg, 0);
+#else
+		return SocketSender{this->sock}(buffers.front());
+#endif
+	}
+};
+
 struct SocketReceiver {
 	SOCKET sock;
 
@@ -14,6 +14,53 @@
 
 #include "../../safeguards.h"
 
+/** The maximum number of buffers of each size that are kept for reuse, per thread. */
+static const size_t PACKET_BUFFER_POOL_SIZE = 64;
+
+/** Buffers of packets that have been destroyed, to be reused for new packets. */
+struct PacketBufferPool {
+	std::vector<std::vector<uint8_t>> small; ///< Buffers with a capacity of at least #COMPAT_MTU.
+	std::vector<std::vector<uint8_t>> large; ///< Buffers with a capacity of at least #TCP_MTU.
+};
+
+/** The pool is per thread, so no locking is needed; a buffer may move to the pool of another thread. */
+static thread_local PacketBufferPool _packet_buffer_pool;
+
+/**
+ * Get an empty buffer, for a packet of at most the given size.
+ * @param limit The maximum size of the packet.
+ * @return The buffer, with enough capacity for the whole packet.
+ */
+static std::vector<uint8_t> AcquirePacketBuffer(size_t limit)
+{
+	bool small = limit <= COMPAT_MTU;
+	auto &pool = small ? _packet_buffer_pool.small : _packet_buffer_pool.large;
+	if (!pool.empty() && pool.back().capacity() >= limit) {
+		std::vector<uint8_t> buffer = std::move(pool.back());
+		pool.pop_back();
+		return buffer;
+	}
+
+	std::vector<uint8_t> buffer;
+	buffer.reserve(std::max(limit, small ? COMPAT_MTU : TCP_MTU));
+	return buffer;
+}
+
+/**
+ * Keep the buffer of a packet for reuse, if there is room for it in the pool.
+ * @param buffer The buffer to release.
+ */
+static void ReleasePacketBuffer(std::vector<uint8_t> &&buffer)
+{
+	if (buffer.capacity() < COMPAT_MTU) return;
+
+	auto &pool = buffer.capacity() >= TCP_MTU ? _packet_buffer_pool.large : _packet_buffer_pool.small;
+	if (pool.size() >= PACKET_BUFFER_POOL_SIZE) return;
+
+	buffer.clear();
+	pool.push_back(std::move(buffer));
+}
+
 /**
  * Create a packet that is used to read from a network socket.
  * @param cs                The socket handler associated with the socket we are reading from.
@@ -31,6 +78,7 @@ Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size)
 	assert(cs != nullptr);
 
 	this->cs = cs;
+	this->buffer = AcquirePacketBuffer(limit);
 	this->buffer.resize(initial_read_size);
 }
 
@@ -52,11 +100,18 @@ Packet::Packet(NetworkSocketHandler *cs, PacketType type, size_t limit) : pos(0)
 		size += cs->send_encryption_handler->MACSize();
 	}
 	assert(this->CanWriteToPacket(size));
+	this->buffer = AcquirePacketBuffer(limit);
 	this->buffer.resize(size, 0);
 
 	this->Send_uint8(type);
 }
 
+/** Give the buffer back for reuse by another packet. */
+Packet::~Packet()
+{
+	ReleasePacketBuffer(std::move(this->buffer));
+}
+
 
 /**
  * Writes the packet size from the raw packet from packet->size
@@ -77,7 +132,6 @@ void Packet::PrepareToSend()
 	}
 
 	this->pos  = 0; // We start reading from here
-	this->buffer.shrink_to_fit();
 }
 
 /**
@@ -446,3 +500,24 @@ size_t Packet::RemainingBytesToTransfer() const
 {
 	return this->Size() - this->pos;
 }
+
+/**
+ * Get the bytes that still have to be transferred out, for transferring them
+ * together with the bytes of other packets.
+ * @return The bytes from the position the last transfer stopped.
+ * @see MarkTransferredOut
+ */
+std::span<const uint8_t> Packet::GetBytesToTransferOut() const
+{
+	return std::span<const uint8_t>(this->buffer).subspan(this->pos);
+}
+
+/**
+ * Mark a number of the bytes from #GetBytesToTransferOut as transferred.
+ * @param bytes The number of bytes that have been transferred.
+ */
+void Packet::MarkTransferredOut(size_t bytes)
+{
+	assert(bytes <= this->RemainingBytesToTransfer());
+	this->pos += static_cast<PacketSize>(bytes);
+}
@@ -55,6 +55,7 @@ private:
 public:
 	Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size = EncodedLengthOfPacketSize());
 	Packet(NetworkSocketHandler *cs, PacketType type, size_t limit = COMPAT_MTU);
+	~Packet();
 
 	/* Sending/writing of packets */
 	void PrepareToSend();
@@ -88,6 +89,8 @@ public:
 	std::string Recv_string(size_t length, StringValidationSettings settings = StringValidationSetting::ReplaceWithQuestionMark);
 
 	size_t RemainingBytesToTransfer() const;
+	std::span<const uint8_t> GetBytesToTransferOut() const;
+	void MarkTransferredOut(size_t bytes);
 
 	/**
 	 * Transfer data from the packet to the given function. It starts reading at the
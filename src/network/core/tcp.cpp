@@ -78,8 +78,17 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 	if (!this->IsConnected()) return SPS_CLOSED;
 
 	while (!this->packet_queue.empty()) {
-		Packet &p = *this->packet_queue.front();
-		ssize_t res = p.TransferOut(SocketSender{this->sock});
+		/* Send as many of the queued packets as we can with a single system call. */
+		std::array<std::span<const uint8_t>, SocketGatherSender::MAX_BUFFERS> buffers;
+		size_t count = 0;
+		size_t to_send = 0;
+		for (auto it = this->packet_queue.begin(); it != this->packet_queue.end() && count < buffers.size(); ++it) {
+			buffers[count] = (*it)->GetBytesToTransferOut();
+			to_send += buffers[count].size();
+			count++;
+		}
+
+		ssize_t res = SocketGatherSender{this->sock}(std::span(buffers.data(), count));
 		if (res == -1) {
 			NetworkError err = NetworkError::GetLast();
 			if (!err.WouldBlock()) {
@@ -98,13 +107,18 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 			return SPS_CLOSED;
 		}
 
-		/* Is this packet sent? */
-		if (p.RemainingBytesToTransfer() == 0) {
-			/* Go to the next packet */
-			this->packet_queue.pop_front();
-		} else {
-			return SPS_PARTLY_SENT;
+		/* Go to the next packet for every packet that has been sent completely. */
+		for (size_t sent = res; sent != 0;) {
+			Packet &p = *this->packet_queue.front();
+			size_t amount = std::min(sent, p.RemainingBytesToTransfer());
+			p.MarkTransferredOut(amount);
+			sent -= amount;
+
+			if (p.RemainingBytesToTransfer() == 0) this->packet_queue.pop_front();
 		}
+
+		/* The OS could not take everything, so it will not take more now. */
+		if (static_cast<size_t>(res) < to_send) return SPS_PARTLY_SENT;
 	}
 
 	return SPS_ALL_SENT;
@@ -58,6 +58,12 @@ public:
 	 */
 	bool HasSendQueue() { return !this->packet_queue.empty(); }
 
+	/**
+	 * Get the number of packets that are still awaiting delivery.
+	 * @return The number of packets in the send queue.
+	 */
+	size_t GetSendQueueLength() const { return this->packet_queue.size(); }
+
 	/**
 	 * Construct a socket handler for a TCP connection.
 	 * @param s The just opened TCP connection.
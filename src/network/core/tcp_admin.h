@@ -62,6 +62,7 @@ enum PacketAdminType : uint8_t {
 	ADMIN_PACKET_SERVER_CMD_LOGGING,     ///< The server gives the admin copies of incoming command packets.
 	ADMIN_PACKET_SERVER_AUTH_REQUEST,    ///< The server gives the admin the used authentication method and required parameters.
 	ADMIN_PACKET_SERVER_ENABLE_ENCRYPTION, ///< The server tells that authentication has completed and requests to enable encryption with the keys of the last \c ADMIN_PACKET_ADMIN_AUTH_RESPONSE.
+	ADMIN_PACKET_SERVER_COMPANY_DELTA,   ///< The server gives the admin the economy and statistics of companies that changed since the last update.
 
 	INVALID_ADMIN_PACKET = 0xFF,         ///< An invalid marker for admin packets.
 };
@@ -86,6 +87,7 @@ enum AdminUpdateType : uint8_t {
 	ADMIN_UPDATE_CMD_NAMES,       ///< The admin would like a list of all DoCommand names.
 	ADMIN_UPDATE_CMD_LOGGING,     ///< The admin would like to have DoCommand information.
 	ADMIN_UPDATE_GAMESCRIPT,      ///< The admin would like to have gamescript messages.
+	ADMIN_UPDATE_COMPANY_DELTA,   ///< Updates about the changed economy and statistics of all companies in one packet.
 	ADMIN_UPDATE_END,             ///< Must ALWAYS be on the end of this list!! (period)
 };
 
@@ -101,6 +103,19 @@ enum class AdminUpdateFrequency : uint8_t {
 };
 using AdminUpdateFrequencies = EnumBitSet<AdminUpdateFrequency, uint8_t>;
 
+/** Fields that can be present for a company in \c ADMIN_PACKET_SERVER_COMPANY_DELTA. */
+enum class AdminCompanyDeltaField : uint8_t {
+	Money, ///< Current money of the company.
+	Loan, ///< Current loan of the company.
+	Income, ///< Income of the company this year.
+	DeliveredCargo, ///< Cargo delivered by the company this quarter.
+	CompanyValue, ///< Company value of the last quarter.
+	Performance, ///< Performance rating of the last quarter.
+	Vehicles, ///< Number of vehicles per vehicle type.
+	Stations, ///< Number of stations per station type.
+};
+using AdminCompanyDeltaFields = EnumBitSet<AdminCompanyDeltaField, uint16_t>;
+
 /** Reasons for removing a company - communicated to admins. */
 enum AdminCompanyRemoveReason : uint8_t {
 	ADMIN_CRR_MANUAL,    ///< The company is manually removed.
@@ -535,6 +550,25 @@ protected:
 	 */
 	virtual NetworkRecvStatus Receive_SERVER_RCON_END(Packet &p);
 
+	/**
+	 * Changes in the economy and statistics of the companies since the last
+	 * \c ADMIN_PACKET_SERVER_COMPANY_DELTA sent to this admin. Repeated for
+	 * every company that changed:
+	 * uint8_t   ID of the company, or \c INVALID_COMPANY (255) to end the list.
+	 * uint16_t  Fields that follow (see #AdminCompanyDeltaField); zero means the company no longer exists.
+	 * uint64_t  Money (only with AdminCompanyDeltaField::Money).
+	 * uint64_t  Loan (only with AdminCompanyDeltaField::Loan).
+	 * int64_t   Income (only with AdminCompanyDeltaField::Income).
+	 * uint16_t  Delivered cargo this quarter (only with AdminCompanyDeltaField::DeliveredCargo).
+	 * uint64_t  Company value of the last quarter (only with AdminCompanyDeltaField::CompanyValue).
+	 * uint16_t  Performance of the last quarter (only with AdminCompanyDeltaField::Performance).
+	 * uint16_t[5] Number of trains, lorries, buses, planes and ships (only with AdminCompanyDeltaField::Vehicles).
+	 * uint16_t[5] Number of train stations, lorry stations, bus stops, airports and harbours (only with AdminCompanyDeltaField::Stations).
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_COMPANY_DELTA(Packet &p);
+
 	NetworkRecvStatus HandlePacket(Packet &p);
 public:
 	NetworkRecvStatus CloseConnection(bool error = true) override;
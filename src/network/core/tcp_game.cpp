@@ -14,6 +14,7 @@
 #include "../../debug.h"
 #include "../../error.h"
 #include "../../strings_func.h"
+#include "../../trace.h"
 
 #include "table/strings.h"
 
@@ -58,6 +59,8 @@ NetworkRecvStatus NetworkGameSocketHandler::CloseConnection(bool)
  */
 NetworkRecvStatus NetworkGameSocketHandler::HandlePacket(Packet &p)
 {
+	TraceZone zone("NetworkGameSocketHandler::HandlePacket");
+
 	PacketGameType type = (PacketGameType)p.Recv_uint8();
 
 	if (this->HasClientQuit()) {
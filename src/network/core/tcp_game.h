@@ -517,6 +517,8 @@ public:
 	NetworkRecvStatus ReceivePackets();
 
 	std::optional<std::string_view> ReceiveCommand(Packet &p, CommandPacket &cp);
+	std::optional<std::string_view> ReceiveCommandHeader(Packet &p, CommandPacket &cp);
+	std::optional<std::string_view> ReceiveCommandData(Packet &p, CommandPacket &cp);
 	void SendCommand(Packet &p, const CommandPacket &cp);
 
 	bool IsPendingDeletion() const { return this->is_pending_deletion; }
@@ -1266,9 +1266,7 @@ void NetworkGameLoop()
 		/* Make sure we are at the frame were the server is (quick-frames) */
 		if (_frame_counter_server > _frame_counter) {
 			/* Run a number of frames; when things go bad, get out. */
-			while (_frame_counter_server > _frame_counter) {
-				if (!ClientNetworkGameSocketHandler::GameLoop()) return;
-			}
+			if (!ClientNetworkGameSocketHandler::CatchUp()) return;
 		} else {
 			/* Else, keep on going till _frame_counter_max */
 			if (_frame_counter_max > _frame_counter) {
@@ -56,6 +56,7 @@ static const AdminUpdateFrequencies _admin_update_type_frequencies[] = {
 	{AdminUpdateFrequency::Poll,                                                                                                                                                          }, // ADMIN_UPDATE_CMD_NAMES
 	{                            AdminUpdateFrequency::Automatic,                                                                                                                         }, // ADMIN_UPDATE_CMD_LOGGING
 	{                            AdminUpdateFrequency::Automatic,                                                                                                                         }, // ADMIN_UPDATE_GAMESCRIPT
+	{AdminUpdateFrequency::Poll, AdminUpdateFrequency::Daily, AdminUpdateFrequency::Weekly, AdminUpdateFrequency::Monthly, AdminUpdateFrequency::Quarterly, AdminUpdateFrequency::Annually}, // ADMIN_UPDATE_COMPANY_DELTA
 };
 /** Sanity check. */
 static_assert(lengthof(_admin_update_type_frequencies) == ADMIN_UPDATE_END);
@@ -68,6 +69,7 @@ ServerNetworkAdminSocketHandler::ServerNetworkAdminSocketHandler(SOCKET s) : Net
 {
 	this->status = ADMIN_STATUS_INACTIVE;
 	this->connect_time = std::chrono::steady_clock::now();
+	this->receive_limit = _settings_client.network.bytes_per_frame_burst;
 }
 
 /**
@@ -84,6 +86,17 @@ ServerNetworkAdminSocketHandler::~ServerNetworkAdminSocketHandler()
 	}
 }
 
+std::unique_ptr<Packet> ServerNetworkAdminSocketHandler::ReceivePacket()
+{
+	/* Only allow receiving when we have some buffer free; the budget gets
+	 * replenished every frame by NetworkServer_Tick. */
+	if (this->receive_limit == 0) return nullptr;
+
+	std::unique_ptr<Packet> p = this->NetworkAdminSocketHandler::ReceivePacket();
+	if (p != nullptr) this->receive_limit -= std::min<size_t>(this->receive_limit, p->Size());
+	return p;
+}
+
 /**
  * Whether a connection is allowed or not at this moment.
  * @return Whether the connection is allowed.
@@ -432,6 +445,81 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Send the economy and statistics of all companies that changed since the last time
+ * this was sent to this admin, in a single packet.
+ * @param always_send Whether to send the packet even when nothing changed.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyDelta(bool always_send)
+{
+	NetworkCompanyStatsArray company_stats = NetworkGetCompanyStats();
+
+	auto p = std::make_unique<Packet>(this, ADMIN_PACKET_SERVER_COMPANY_DELTA);
+	bool changed = false;
+
+	for (CompanyID c = CompanyID::Begin(); c < MAX_COMPANIES; ++c) {
+		std::optional<AdminCompanyDeltaState> &last = this->company_delta[c];
+		const Company *company = Company::GetIfValid(c);
+
+		if (company == nullptr) {
+			if (!last.has_value()) continue;
+
+			/* Tell the admin the company is gone, so it can drop its state as well. */
+			last.reset();
+			p->Send_uint8(c.base());
+			p->Send_uint16(AdminCompanyDeltaFields{}.base());
+			changed = true;
+			continue;
+		}
+
+		AdminCompanyDeltaState current;
+		current.money = company->money;
+		current.loan = company->current_loan;
+		current.income = -std::reduce(std::begin(company->yearly_expenses[0]), std::end(company->yearly_expenses[0]));
+		current.delivered_cargo = static_cast<uint16_t>(std::min<uint64_t>(UINT16_MAX, company->cur_economy.delivered_cargo.GetSum<OverflowSafeInt64>()));
+		current.company_value = company->old_economy[0].company_value;
+		current.performance = company->old_economy[0].performance_history;
+		std::ranges::copy(company_stats[c].num_vehicle, current.num_vehicle.begin());
+		std::ranges::copy(company_stats[c].num_station, current.num_station.begin());
+
+		AdminCompanyDeltaFields fields{};
+		if (!last.has_value() || last->money != current.money) fields.Set(AdminCompanyDeltaField::Money);
+		if (!last.has_value() || last->loan != current.loan) fields.Set(AdminCompanyDeltaField::Loan);
+		if (!last.has_value() || last->income != current.income) fields.Set(AdminCompanyDeltaField::Income);
+		if (!last.has_value() || last->delivered_cargo != current.delivered_cargo) fields.Set(AdminCompanyDeltaField::DeliveredCargo);
+		if (!last.has_value() || last->company_value != current.company_value) fields.Set(AdminCompanyDeltaField::CompanyValue);
+		if (!last.has_value() || last->performance != current.performance) fields.Set(AdminCompanyDeltaField::Performance);
+		if (!last.has_value() || last->num_vehicle != current.num_vehicle) fields.Set(AdminCompanyDeltaField::Vehicles);
+		if (!last.has_value() || last->num_station != current.num_station) fields.Set(AdminCompanyDeltaField::Stations);
+		if (fields.None()) continue;
+
+		p->Send_uint8(c.base());
+		p->Send_uint16(fields.base());
+		if (fields.Test(AdminCompanyDeltaField::Money)) p->Send_uint64(current.money);
+		if (fields.Test(AdminCompanyDeltaField::Loan)) p->Send_uint64(current.loan);
+		if (fields.Test(AdminCompanyDeltaField::Income)) p->Send_uint64(current.income);
+		if (fields.Test(AdminCompanyDeltaField::DeliveredCargo)) p->Send_uint16(current.delivered_cargo);
+		if (fields.Test(AdminCompanyDeltaField::CompanyValue)) p->Send_uint64(current.company_value);
+		if (fields.Test(AdminCompanyDeltaField::Performance)) p->Send_uint16(current.performance);
+		if (fields.Test(AdminCompanyDeltaField::Vehicles)) {
+			for (uint16_t num : current.num_vehicle) p->Send_uint16(num);
+		}
+		if (fields.Test(AdminCompanyDeltaField::Stations)) {
+			for (uint16_t num : current.num_station) p->Send_uint16(num);
+		}
+
+		last = current;
+		changed = true;
+	}
+
+	if (!changed && !always_send) return NETWORK_RECV_STATUS_OKAY;
+
+	p->Send_uint8(CompanyID::Invalid().base());
+	this->SendPacket(std::move(p));
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Send a chat message.
  * @param action The action associated with the message.
@@ -729,6 +817,12 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_POLL(Packet &p)
 			this->SendCompanyStats();
 			break;
 
+		case ADMIN_UPDATE_COMPANY_DELTA:
+			/* The admin is requesting the changes since its last update, or everything again. */
+			if (d1 == UINT32_MAX) this->company_delta.fill(std::nullopt);
+			this->SendCompanyDelta(true);
+			break;
+
 		case ADMIN_UPDATE_CMD_NAMES:
 			/* The admin is requesting the names of DoCommands. */
 			this->SendCmdNames();
@@ -1077,6 +1171,10 @@ void NetworkAdminUpdate(AdminUpdateFrequency freq)
 						as->SendCompanyStats();
 						break;
 
+					case ADMIN_UPDATE_COMPANY_DELTA:
+						as->SendCompanyDelta(false);
+						break;
+
 					default: NOT_REACHED();
 				}
 			}
@@ -21,6 +21,18 @@ class ServerNetworkAdminSocketHandler;
 using NetworkAdminSocketPool = Pool<ServerNetworkAdminSocketHandler, AdminID, 2, PoolType::NetworkAdmin>;
 extern NetworkAdminSocketPool _networkadminsocket_pool;
 
+/** The company values last sent to an admin in an \c ADMIN_PACKET_SERVER_COMPANY_DELTA. */
+struct AdminCompanyDeltaState {
+	Money money; ///< Current money.
+	Money loan; ///< Current loan.
+	Money income; ///< Income this year.
+	uint16_t delivered_cargo; ///< Cargo delivered this quarter.
+	Money company_value; ///< Company value of the last quarter.
+	uint16_t performance; ///< Performance of the last quarter.
+	std::array<uint16_t, NETWORK_VEH_END> num_vehicle; ///< Number of vehicles per type.
+	std::array<uint16_t, NETWORK_VEH_END> num_station; ///< Number of stations per type.
+};
+
 /** Class for handling the server side of the game connection. */
 class ServerNetworkAdminSocketHandler : public NetworkAdminSocketPool::PoolItem<&_networkadminsocket_pool>, public NetworkAdminSocketHandler, public TCPListenHandler<ServerNetworkAdminSocketHandler, ADMIN_PACKET_SERVER_FULL, ADMIN_PACKET_SERVER_BANNED> {
 private:
@@ -46,10 +58,14 @@ public:
 	std::array<AdminUpdateFrequencies, ADMIN_UPDATE_END> update_frequency{}; ///< Admin requested update intervals.
 	std::chrono::steady_clock::time_point connect_time{}; ///< Time of connection.
 	NetworkAddress address{}; ///< Address of the admin.
+	size_t receive_limit = 0; ///< Amount of bytes that we can receive at this moment
+	TypedIndexContainer<std::array<std::optional<AdminCompanyDeltaState>, MAX_COMPANIES>, CompanyID> company_delta{}; ///< Company values last sent with ADMIN_UPDATE_COMPANY_DELTA.
 
 	ServerNetworkAdminSocketHandler(SOCKET s);
 	~ServerNetworkAdminSocketHandler() override;
 
+	std::unique_ptr<Packet> ReceivePacket() override;
+
 	NetworkRecvStatus SendError(NetworkErrorCode error);
 	NetworkRecvStatus SendWelcome();
 	NetworkRecvStatus SendNewGame();
@@ -67,6 +83,7 @@ public:
 	NetworkRecvStatus SendCompanyRemove(CompanyID company_id, AdminCompanyRemoveReason bcrr);
 	NetworkRecvStatus SendCompanyEconomy();
 	NetworkRecvStatus SendCompanyStats();
+	NetworkRecvStatus SendCompanyDelta(bool always_send);
 
 	NetworkRecvStatus SendChat(NetworkAction action, DestType desttype, ClientID client_id, std::string_view msg, int64_t data);
 	NetworkRecvStatus SendRcon(uint16_t colour, std::string_view command);
@@ -23,6 +23,7 @@
 #include "../timer/timer_game_tick.h"
 #include "../timer/timer_game_calendar.h"
 #include "../gfx_func.h"
+#include "../sound_func.h"
 #include "../error.h"
 #include "../rev.h"
 #include "network.h"
@@ -110,6 +111,7 @@ ClientNetworkGameSocketHandler::~ClientNetworkGameSocketHandler()
 {
 	assert(ClientNetworkGameSocketHandler::my_client == this);
 	ClientNetworkGameSocketHandler::my_client = nullptr;
+	_network_join_frames_total = 0;
 
 	delete this->GetInfo();
 }
@@ -262,6 +264,81 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 	return true;
 }
 
+/** Number of frames we have to be behind the server to catch up without drawing the game. */
+static const uint32_t CATCH_UP_MIN_FRAMES = 2 * Ticks::DAY_TICKS;
+/** Time to spend on catching up before the screen gets a chance to show the progress. */
+static constexpr std::chrono::milliseconds CATCH_UP_SLICE{100};
+
+/** Frame at which we started to catch up with the server. */
+static uint32_t _catch_up_start_frame;
+/** Whether we opened the join status window to show the progress of catching up. */
+static bool _catch_up_shows_status;
+
+/**
+ * Run the frames the server is ahead of us.
+ * When we are far behind, like after downloading the map or resyncing, we catch up:
+ * the frames are run without marking the screen dirty or playing sounds, and in
+ * slices, so the join status window can show the progress in the meantime.
+ * Once we are at the frame of the server, the game is drawn as normal again.
+ * @return Whether everything went okay, or not.
+ */
+/* static */ bool ClientNetworkGameSocketHandler::CatchUp()
+{
+	if (_network_join_frames_total == 0) {
+		if (_frame_counter_server - _frame_counter < CATCH_UP_MIN_FRAMES) {
+			while (_frame_counter_server > _frame_counter) {
+				if (!ClientNetworkGameSocketHandler::GameLoop()) return false;
+			}
+			return true;
+		}
+
+		Debug(net, 3, "Catching up {} frames with the server", _frame_counter_server - _frame_counter);
+		_catch_up_start_frame = _frame_counter;
+		_network_join_frames = 0;
+		_network_join_frames_total = _frame_counter_server - _frame_counter;
+
+		/* When registering a new company, the join status window is still open; otherwise show it for the progress. */
+		_catch_up_shows_status = FindWindowById(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_JOIN) == nullptr;
+		if (_catch_up_shows_status) {
+			_network_join_status = NETWORK_JOIN_STATUS_PROCESSING;
+			ShowJoinStatusWindow();
+		}
+	}
+
+	bool screen_dirty_suspended = _screen_dirty_suspended;
+	_screen_dirty_suspended = true;
+	_sound_effects_suspended = true;
+
+	bool okay = true;
+	auto deadline = std::chrono::steady_clock::now() + CATCH_UP_SLICE;
+	while (_frame_counter_server > _frame_counter && std::chrono::steady_clock::now() < deadline) {
+		if (!ClientNetworkGameSocketHandler::GameLoop()) {
+			okay = false;
+			break;
+		}
+	}
+
+	_screen_dirty_suspended = screen_dirty_suspended;
+	_sound_effects_suspended = false;
+
+	if (okay && _frame_counter_server > _frame_counter) {
+		/* The server keeps on going while we catch up. */
+		_network_join_frames = _frame_counter - _catch_up_start_frame;
+		_network_join_frames_total = _frame_counter_server - _catch_up_start_frame;
+		SetWindowDirty(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_JOIN);
+		return true;
+	}
+
+	if (okay) Debug(net, 3, "Caught up with the server after {} frames", _frame_counter - _catch_up_start_frame);
+	_network_join_frames_total = 0;
+	if (_catch_up_shows_status && _network_join_status == NETWORK_JOIN_STATUS_PROCESSING) CloseWindowById(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_JOIN);
+	SetWindowDirty(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_JOIN);
+
+	/* Nothing was marked dirty while catching up. */
+	MarkWholeScreenDirty();
+	return okay;
+}
+
 
 /** Our client's connection. */
 ClientNetworkGameSocketHandler * ClientNetworkGameSocketHandler::my_client = nullptr;
@@ -98,6 +98,7 @@ public:
 	static void Send();
 	static bool Receive();
 	static bool GameLoop();
+	static bool CatchUp();
 };
 
 /** Helper to make the code look somewhat nicer. */
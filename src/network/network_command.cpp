@@ -284,6 +284,20 @@ void NetworkExecuteLocalCommandQueue()
 	_current_company = _local_company;
 }
 
+/**
+ * Execute a command of a replayed command log right away, as if it arrived from the server.
+ * @param cp The command to execute.
+ */
+void NetworkExecuteReplayedCommand(const CommandPacket &cp)
+{
+	Backup<CompanyID> cur_company(_current_company, cp.company);
+	size_t cb_index = FindCallbackIndex(nullptr);
+	assert(cb_index < _callback_tuple_size);
+	assert(_cmd_dispatch[cp.cmd].Unpack[cb_index] != nullptr);
+	_cmd_dispatch[cp.cmd].Unpack[cb_index](cp);
+	cur_company.Restore();
+}
+
 /**
  * Free the local command queues.
  */
@@ -303,13 +317,28 @@ static void DistributeCommandPacket(CommandPacket &cp, const NetworkClientSocket
 	CommandCallback *callback = cp.callback;
 	cp.frame = _frame_counter_max + 1;
 
+	/* All clients but the owner get exactly the same command, so serialise it only once for them. */
+	std::shared_ptr<const std::vector<uint8_t>> serialised;
+
 	for (NetworkClientSocket *cs : NetworkClientSocket::Iterate()) {
 		if (cs->status >= NetworkClientSocket::STATUS_MAP) {
-			/* Callbacks are only send back to the client who sent them in the
-			 *  first place. This filters that out. */
-			cp.callback = (cs != owner) ? nullptr : callback;
-			cp.my_cmd = (cs == owner);
-			cs->outgoing_queue.push_back(cp);
+			if (cs == owner) {
+				/* Callbacks are only send back to the client who sent them in the
+				 *  first place. This filters that out. */
+				cp.callback = callback;
+				cp.my_cmd = true;
+				cs->outgoing_queue.push_back(cp);
+				continue;
+			}
+
+			if (serialised == nullptr) {
+				cp.callback = nullptr;
+				cp.my_cmd = false;
+				serialised = cs->SerialiseCommand(cp);
+			}
+			CommandPacket &c = cs->outgoing_queue.emplace_back();
+			c.cmd = cp.cmd;
+			c.serialised = serialised;
 		}
 	}
 
@@ -372,11 +401,36 @@ void NetworkDistributeCommands()
  * @return An error message, or std::nullopt there has been no error.
  */
 std::optional<std::string_view> NetworkGameSocketHandler::ReceiveCommand(Packet &p, CommandPacket &cp)
+{
+	auto err = this->ReceiveCommandHeader(p, cp);
+	if (err.has_value()) return err;
+	return this->ReceiveCommandData(p, cp);
+}
+
+/**
+ * Receives the company and command of a command from the network, which
+ * is enough to decide whether the sender may send this command at all.
+ * @param p the packet to read from.
+ * @param cp the struct to write the data to.
+ * @return An error message, or std::nullopt there has been no error.
+ */
+std::optional<std::string_view> NetworkGameSocketHandler::ReceiveCommandHeader(Packet &p, CommandPacket &cp)
 {
 	cp.company = (CompanyID)p.Recv_uint8();
 	cp.cmd     = static_cast<Commands>(p.Recv_uint16());
 	if (!IsValidCommand(cp.cmd)) return "invalid command";
 	if (GetCommandFlags(cp.cmd).Test(CommandFlag::Offline)) return "single-player only command";
+	return std::nullopt;
+}
+
+/**
+ * Receives the rest of a command from the network, after #ReceiveCommandHeader.
+ * @param p the packet to read from.
+ * @param cp the struct to write the data to.
+ * @return An error message, or std::nullopt there has been no error.
+ */
+std::optional<std::string_view> NetworkGameSocketHandler::ReceiveCommandData(Packet &p, CommandPacket &cp)
+{
 	cp.err_msg = p.Recv_uint16();
 	cp.data    = _cmd_dispatch[cp.cmd].Sanitize(p.Recv_buffer());
 
@@ -23,6 +23,7 @@
 #include "../timer/timer.h"
 #include "../timer/timer_window.h"
 #include "../core/string_consumer.hpp"
+#include "../thread.h"
 #include "network_content.h"
 
 #include "table/strings.h"
@@ -296,6 +297,8 @@ void ClientNetworkContentSocketHandler::DownloadSelectedContent(uint &files, uin
 	ContentIDList content;
 	for (const auto &ci : this->infos) {
 		if (!ci->IsSelected() || ci->state == ContentInfo::State::AlreadyHere) continue;
+		/* Downloaded, but still being decompressed. */
+		if (std::ranges::find(this->extracting, ci->id) != this->extracting.end()) continue;
 
 		content.push_back(ci->id);
 		bytes += ci->filesize;
@@ -517,24 +520,79 @@ bool ClientNetworkContentSocketHandler::BeforeDownload()
 /**
  * Handle the closing and extracting of a file after
  * downloading it has been done.
+ * The decompression is done on a separate thread, so the next file can
+ * be downloaded in the meantime; #ProcessExtractedContent finishes it.
  */
 void ClientNetworkContentSocketHandler::AfterDownload()
 {
 	/* We read nothing; that's our marker for end-of-stream.
 	 * Now gunzip the tar and make it known. */
 	this->cur_file.reset();
+	this->extracting.push_back(this->cur_info->id);
+
+	std::lock_guard<std::mutex> lock(this->extract_mutex);
+	this->extract_queue.push_back(std::move(this->cur_info));
+	if (this->extract_running) return;
+
+	if (this->extract_thread.joinable()) this->extract_thread.join();
+	this->extract_running = true;
+	if (!StartNewThread(&this->extract_thread, "ottd:content", [this]() { this->ExtractThread(); })) {
+		/* No threads, so do it ourselves. */
+		this->extract_running = false;
+		while (!this->extract_queue.empty()) {
+			std::unique_ptr<ContentInfo> ci = std::move(this->extract_queue.front());
+			this->extract_queue.pop_front();
+			bool success = GunzipFile(*ci);
+			if (success) FioRemove(GetFullFilename(*ci, true));
+			this->extract_done.emplace_back(std::move(ci), success);
+		}
+	}
+}
+
+/** Decompress the downloaded files until there are no more files queued. */
+void ClientNetworkContentSocketHandler::ExtractThread()
+{
+	std::unique_lock<std::mutex> lock(this->extract_mutex);
+	while (!this->extract_queue.empty()) {
+		std::unique_ptr<ContentInfo> ci = std::move(this->extract_queue.front());
+		this->extract_queue.pop_front();
+
+		lock.unlock();
+		bool success = GunzipFile(*ci);
+		if (success) FioRemove(GetFullFilename(*ci, true));
+		lock.lock();
+
+		this->extract_done.emplace_back(std::move(ci), success);
+	}
+	this->extract_running = false;
+}
+
+/** Make the files decompressed by the extraction thread known to the game. */
+void ClientNetworkContentSocketHandler::ProcessExtractedContent()
+{
+	std::vector<std::pair<std::unique_ptr<ContentInfo>, bool>> done;
+	{
+		std::lock_guard<std::mutex> lock(this->extract_mutex);
+		if (this->extract_done.empty()) return;
+		done.swap(this->extract_done);
+	}
 
-	if (GunzipFile(*this->cur_info)) {
-		FioRemove(GetFullFilename(*this->cur_info, true));
+	for (auto &[ci, success] : done) {
+		this->extracting.erase(std::ranges::find(this->extracting, ci->id));
 
-		Subdirectory sd = GetContentInfoSubDir(this->cur_info->type);
+		if (!success) {
+			ShowErrorMessage(GetEncodedString(STR_CONTENT_ERROR_COULD_NOT_EXTRACT), {}, WL_ERROR);
+			continue;
+		}
+
+		Subdirectory sd = GetContentInfoSubDir(ci->type);
 		if (sd == NO_DIRECTORY) NOT_REACHED();
 
 		TarScanner ts;
-		std::string fname = GetFullFilename(*this->cur_info, false);
+		std::string fname = GetFullFilename(*ci, false);
 		ts.AddFile(sd, fname);
 
-		if (this->cur_info->type == CONTENT_TYPE_BASE_MUSIC) {
+		if (ci->type == CONTENT_TYPE_BASE_MUSIC) {
 			/* Music can't be in a tar. So extract the tar! */
 			ExtractTar(fname, BASESET_DIR);
 			FioRemove(fname);
@@ -544,12 +602,19 @@ void ClientNetworkContentSocketHandler::AfterDownload()
 		EM_ASM(if (window["openttd_syncfs"]) openttd_syncfs());
 #endif
 
-		this->OnDownloadComplete(this->cur_info->id);
-	} else {
-		ShowErrorMessage(GetEncodedString(STR_CONTENT_ERROR_COULD_NOT_EXTRACT), {}, WL_ERROR);
+		this->OnDownloadComplete(ci->id);
 	}
 }
 
+/**
+ * Wait until all downloaded files are decompressed and known to the game.
+ */
+void ClientNetworkContentSocketHandler::WaitForExtraction()
+{
+	if (this->extract_thread.joinable()) this->extract_thread.join();
+	this->ProcessExtractedContent();
+}
+
 bool ClientNetworkContentSocketHandler::IsCancelled() const
 {
 	return this->is_cancelled;
@@ -691,6 +756,11 @@ void ClientNetworkContentSocketHandler::OnReceiveData(std::unique_ptr<char[]> da
 	}
 }
 
+ClientNetworkContentSocketHandler::~ClientNetworkContentSocketHandler()
+{
+	if (this->extract_thread.joinable()) this->extract_thread.join();
+}
+
 /** Connect to the content server. */
 class NetworkContentConnecter : public TCPConnecter {
 public:
@@ -760,6 +830,8 @@ void ClientNetworkContentSocketHandler::Cancel(void)
  */
 void ClientNetworkContentSocketHandler::SendReceive()
 {
+	this->ProcessExtractedContent();
+
 	if (this->sock == INVALID_SOCKET || this->is_connecting) return;
 
 	/* Close the connection to the content server after inactivity; there can still be downloads pending via HTTP. */
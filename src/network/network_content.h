@@ -14,6 +14,8 @@
 #include "core/tcp_content.h"
 #include "core/http.h"
 #include <unordered_map>
+#include <mutex>
+#include <thread>
 #include "../core/container_func.hpp"
 
 /** Vector with content info */
@@ -77,6 +79,13 @@ protected:
 	bool is_cancelled = false; ///< Whether the download has been cancelled
 	std::chrono::steady_clock::time_point last_activity = std::chrono::steady_clock::now(); ///< The last time there was network activity
 
+	std::thread extract_thread; ///< Thread decompressing the downloaded files.
+	std::mutex extract_mutex; ///< Protects the extraction queues between the main and extraction thread.
+	std::deque<std::unique_ptr<ContentInfo>> extract_queue; ///< Downloaded files waiting to be decompressed.
+	std::vector<std::pair<std::unique_ptr<ContentInfo>, bool>> extract_done; ///< Decompressed files and whether that succeeded.
+	bool extract_running = false; ///< Whether the extraction thread is handling #extract_queue.
+	ContentIDList extracting; ///< Content that has been downloaded, but is not yet known to the game.
+
 	friend class NetworkContentConnecter;
 
 	bool Receive_SERVER_INFO(Packet &p) override;
@@ -97,6 +106,8 @@ protected:
 
 	bool BeforeDownload();
 	void AfterDownload();
+	void ExtractThread();
+	void ProcessExtractedContent();
 
 	void DownloadSelectedContentHTTP(const ContentIDList &content);
 	void DownloadSelectedContentFallback(const ContentIDList &content);
@@ -104,8 +115,11 @@ public:
 	/** The idle timeout; when to close the connection because it's idle. */
 	static constexpr std::chrono::seconds IDLE_TIMEOUT = std::chrono::seconds(60);
 
+	~ClientNetworkContentSocketHandler() override;
+
 	void Connect();
 	void SendReceive();
+	void WaitForExtraction();
 	NetworkRecvStatus CloseConnection(bool error = true) override;
 	void Cancel();
 
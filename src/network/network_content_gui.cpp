@@ -199,6 +199,9 @@ public:
 
 	void Close([[maybe_unused]] int data = 0) override
 	{
+		/* The rescans below need the downloaded files to be decompressed. */
+		_network_content_client.WaitForExtraction();
+
 		TarScanner::Modes modes{};
 		for (auto ctype : this->received_types) {
 			switch (ctype) {
@@ -93,6 +93,12 @@ bool X25519DerivedKeys::Exchange(const X25519PublicKey &peer_public_key, X25519K
 
 /**
  * Encryption handler implementation for monocypher encryption after a X25519 key exchange.
+ *
+ * The context is a ratchet: every message derives the key for the next one,
+ * so the packets of one connection have to be encrypted one after another in
+ * the order they are sent, and each needs its own MAC. Batching several
+ * packets in one pass, or across connections with different keys, is not
+ * possible without changing the wire protocol.
  */
 class X25519EncryptionHandler : public NetworkEncryptionHandler {
 private:
@@ -1988,6 +1988,8 @@ NetworkJoinStatus _network_join_status; ///< The status of joining.
 uint8_t _network_join_waiting;            ///< The number of clients waiting in front of us.
 uint32_t _network_join_bytes;             ///< The number of bytes we already downloaded.
 uint32_t _network_join_bytes_total;       ///< The total number of bytes to download.
+uint32_t _network_join_frames;            ///< The number of frames we already ran to catch up with the server.
+uint32_t _network_join_frames_total;      ///< The total number of frames to run to catch up with the server, 0 when not catching up.
 
 struct NetworkJoinStatusWindow : Window {
 	std::shared_ptr<NetworkAuthenticationPasswordRequest> request{};
@@ -2023,6 +2025,11 @@ struct NetworkJoinStatusWindow : Window {
 						[[fallthrough]];
 
 					default: // Waiting is 15%, so the remaining downloading of the map is maximum 70%
+						if (_network_join_frames_total != 0) {
+							/* Catching up with the server after loading the map; show how far along that is. */
+							progress = _network_join_frames * 100 / _network_join_frames_total;
+							break;
+						}
 						progress = 15 + _network_join_bytes * (100 - 15) / _network_join_bytes_total;
 						break;
 				}
@@ -2046,6 +2053,9 @@ struct NetworkJoinStatusWindow : Window {
 						break;
 
 					default:
+						if (_network_join_frames_total != 0) {
+							DrawStringMultiLine(r, GetString(STR_NETWORK_CONNECTING_CATCHING_UP, _network_join_frames, _network_join_frames_total), TC_FROMSTRING, SA_CENTER);
+						}
 						break;
 				}
 				break;
@@ -2072,6 +2082,7 @@ struct NetworkJoinStatusWindow : Window {
 				uint64_t max_digits = GetParamMaxDigits(8);
 				size = maxdim(size, GetStringBoundingBox(GetString(STR_NETWORK_CONNECTING_DOWNLOADING_1, max_digits, max_digits)));
 				size = maxdim(size, GetStringBoundingBox(GetString(STR_NETWORK_CONNECTING_DOWNLOADING_1, max_digits, max_digits)));
+				size = maxdim(size, GetStringBoundingBox(GetString(STR_NETWORK_CONNECTING_CATCHING_UP, max_digits, max_digits)));
 				break;
 			}
 		}
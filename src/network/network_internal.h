@@ -73,6 +73,8 @@ extern NetworkJoinStatus _network_join_status;
 extern uint8_t _network_join_waiting;
 extern uint32_t _network_join_bytes;
 extern uint32_t _network_join_bytes_total;
+extern uint32_t _network_join_frames;
+extern uint32_t _network_join_frames_total;
 extern ConnectionType _network_server_connection_type;
 extern std::string _network_server_invite_code;
 
@@ -101,10 +103,12 @@ struct CommandPacket {
 	StringID err_msg{}; ///< string ID of error message to use.
 	CommandCallback *callback = nullptr; ///< any callback function executed upon successful completion of the command.
 	CommandDataBuffer data{}; ///< command parameters.
+	std::shared_ptr<const std::vector<uint8_t>> serialised{}; ///< The command as sent to every client but its owner, when the command has been serialised once for all of them; the other fields are then not sent.
 };
 
 void NetworkDistributeCommands();
 void NetworkExecuteLocalCommandQueue();
+void NetworkExecuteReplayedCommand(const CommandPacket &cp);
 void NetworkFreeLocalCommandQueue();
 void NetworkSyncCommandQueue(NetworkClientSocket *cs);
 void NetworkReplaceCommandClientId(CommandPacket &cp, ClientID client_id);
@@ -0,0 +1,238 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/**
+ * @file network_replay.cpp Replaying a logged command stream without networking.
+ *
+ * A server started with `-d desync=1` or higher writes every command it executes to
+ * its `commands-out.log`, together with the state of the random generator once a day.
+ * Replaying that log on the savegame the server started from executes the same
+ * commands at the same moments, so the game runs the same as it did on the server.
+ * Unlike the replay of DEBUG_DUMP_COMMANDS this needs no special build and no network,
+ * which makes the recorded games of a server usable as repeatable benchmarks.
+ */
+
+#include "../stdafx.h"
+#include "../core/random_func.hpp"
+#include "../core/string_consumer.hpp"
+#include "../fileio_func.h"
+#include "../openttd.h"
+#include "../timer/timer_game_economy.h"
+#include "network_internal.h"
+#include "network_replay.h"
+#include <charconv>
+
+#include "../safeguards.h"
+
+/** State of the command log being replayed. */
+struct CommandReplay {
+	FileHandle file; ///< The command log.
+
+	/* The next entry of the log, either a command or a random state. */
+	bool has_next = false; ///< Whether there is a next entry.
+	bool next_is_sync = false; ///< Whether the next entry is a random state instead of a command.
+	TimerGameEconomy::Date next_date{}; ///< Date of the next entry.
+	TimerGameEconomy::DateFract next_date_fract = 0; ///< Fraction of the day of the next entry.
+	CommandPacket next_command{}; ///< The next command.
+	std::array<uint32_t, 2> next_sync{}; ///< The next random state.
+
+	uint executed = 0; ///< Number of commands executed.
+	uint skipped = 0; ///< Number of commands skipped, because their moment had already passed.
+	uint unparsable = 0; ///< Number of lines that could not be understood.
+	uint sync_matches = 0; ///< Number of random states that matched the log.
+	uint sync_mismatches = 0; ///< Number of random states that differed from the log.
+
+	CommandReplay(FileHandle &&file) : file(std::move(file)) {}
+
+	void ReadNext();
+	bool ParseCommand(StringConsumer &consumer);
+	bool ParseSync(StringConsumer &consumer);
+};
+
+static std::unique_ptr<CommandReplay> _command_replay;
+
+/**
+ * Compare the moment of the next entry of the log with the current moment of the game.
+ * @param replay The replay.
+ * @return Negative when the entry is in the past, zero when it is now, positive when it is still to come.
+ */
+static int CompareWithNow(const CommandReplay &replay)
+{
+	if (replay.next_date != TimerGameEconomy::date) return replay.next_date < TimerGameEconomy::date ? -1 : 1;
+	if (replay.next_date_fract != TimerGameEconomy::date_fract) return replay.next_date_fract < TimerGameEconomy::date_fract ? -1 : 1;
+	return 0;
+}
+
+/**
+ * Read the moment of a log entry.
+ * @param consumer The rest of the line.
+ * @param[out] date The date of the entry.
+ * @param[out] date_fract The fraction of the day of the entry.
+ * @return Whether the moment could be read.
+ */
+static bool ReadMoment(StringConsumer &consumer, TimerGameEconomy::Date &date, TimerGameEconomy::DateFract &date_fract)
+{
+	auto d = consumer.TryReadIntegerBase<uint32_t>(16);
+	if (!d.has_value() || !consumer.ReadIf("; ")) return false;
+	auto f = consumer.TryReadIntegerBase<TimerGameEconomy::DateFract>(16);
+	if (!f.has_value() || !consumer.ReadIf("; ")) return false;
+	date = TimerGameEconomy::Date(*d);
+	date_fract = *f;
+	return true;
+}
+
+/**
+ * Parse a "cmd: " line of the log into the next entry.
+ * @param consumer The line after the "cmd: ".
+ * @return Whether the line could be parsed.
+ */
+bool CommandReplay::ParseCommand(StringConsumer &consumer)
+{
+	if (!ReadMoment(consumer, this->next_date, this->next_date_fract)) return false;
+	auto company = consumer.TryReadIntegerBase<uint16_t>(16);
+	if (!company.has_value() || !consumer.ReadIf("; ")) return false;
+	auto cmd = consumer.TryReadIntegerBase<uint32_t>(16);
+	if (!cmd.has_value() || *cmd >= CMD_END || !consumer.ReadIf("; ")) return false;
+	auto err_msg = consumer.TryReadIntegerBase<uint32_t>(16);
+	if (!err_msg.has_value() || !consumer.ReadIf("; ")) return false;
+
+	CommandPacket &cp = this->next_command;
+	cp = {};
+	cp.company = static_cast<CompanyID>(*company);
+	cp.cmd = static_cast<Commands>(*cmd);
+	cp.err_msg = *err_msg;
+
+	auto args = consumer.ReadUntilChar(' ', StringConsumer::SKIP_ONE_SEPARATOR);
+	for (size_t i = 0; i + 1 < args.size(); i += 2) {
+		uint8_t e = 0;
+		std::from_chars(args.data() + i, args.data() + i + 2, e, 16);
+		cp.data.push_back(e);
+	}
+	return true;
+}
+
+/**
+ * Parse a "sync: " line of the log into the next entry.
+ * @param consumer The line after the "sync: ".
+ * @return Whether the line could be parsed.
+ */
+bool CommandReplay::ParseSync(StringConsumer &consumer)
+{
+	if (!ReadMoment(consumer, this->next_date, this->next_date_fract)) return false;
+	auto state0 = consumer.TryReadIntegerBase<uint32_t>(16);
+	if (!state0.has_value() || !consumer.ReadIf("; ")) return false;
+	auto state1 = consumer.TryReadIntegerBase<uint32_t>(16);
+	if (!state1.has_value()) return false;
+
+	this->next_sync = {*state0, *state1};
+	return true;
+}
+
+/** Read the lines of the log until the next command or random state. */
+void CommandReplay::ReadNext()
+{
+	this->has_next = false;
+
+	char buff[4096];
+	while (fgets(buff, lengthof(buff), this->file) != nullptr) {
+		StringConsumer consumer{std::string_view{buff}};
+		/* Ignore the "[date time] " part of the message */
+		if (consumer.ReadCharIf('[')) {
+			consumer.SkipUntilChar(']', StringConsumer::SKIP_ONE_SEPARATOR);
+			consumer.SkipCharIf(' ');
+		}
+
+		/* Failed commands, messages, joins, saves and the like do not change the game. */
+		bool is_sync = consumer.ReadIf("sync: ");
+		if (!is_sync && !consumer.ReadIf("cmd: ")) continue;
+
+		if (!(is_sync ? this->ParseSync(consumer) : this->ParseCommand(consumer))) {
+			Debug(desync, 0, "Cannot parse command log line: {}", buff);
+			this->unparsable++;
+			continue;
+		}
+
+		this->has_next = true;
+		this->next_is_sync = is_sync;
+		return;
+	}
+}
+
+/**
+ * Start replaying a command log, as written to `commands-out.log` by a server with `-d desync=1`.
+ * The log has to start at the moment of the loaded game; commands from before it are skipped.
+ * While replaying, the AIs and game script do not run, as their commands are in the log.
+ * @param filename The command log.
+ * @return Whether the log could be opened.
+ */
+bool NetworkStartCommandReplay(std::string_view filename)
+{
+	auto f = FioFOpenFile(filename, "rb", NO_DIRECTORY);
+	if (!f.has_value()) {
+		Debug(desync, 0, "Cannot open command log '{}'", filename);
+		return false;
+	}
+
+	_command_replay = std::make_unique<CommandReplay>(std::move(*f));
+	_command_replay->ReadNext();
+	return true;
+}
+
+/**
+ * Execute the commands of the log that are due at the current moment of the game,
+ * and compare the random state with the log. Call this before every tick.
+ */
+void NetworkReplayCommands()
+{
+	if (_command_replay == nullptr || _game_mode != GM_NORMAL) return;
+	CommandReplay &replay = *_command_replay;
+
+	while (replay.has_next) {
+		int when = CompareWithNow(replay);
+		if (when > 0) break;
+
+		if (replay.next_is_sync) {
+			/* The server logs its random state before it executes the commands of the tick. */
+			if (when < 0) {
+				/* Logged before the replay started; nothing to compare. */
+			} else if (_random.state[0] == replay.next_sync[0] && _random.state[1] == replay.next_sync[1]) {
+				replay.sync_matches++;
+			} else {
+				if (replay.sync_mismatches == 0) Debug(desync, 0, "Replay stopped matching the command log at {:08x}:{:02x}", replay.next_date, replay.next_date_fract);
+				replay.sync_mismatches++;
+			}
+		} else if (when < 0) {
+			replay.skipped++;
+		} else {
+			NetworkExecuteReplayedCommand(replay.next_command);
+			replay.executed++;
+		}
+
+		replay.ReadNext();
+	}
+}
+
+/** Stop replaying the command log, and report how the replay went. */
+void NetworkStopCommandReplay()
+{
+	if (_command_replay == nullptr) return;
+	const CommandReplay &replay = *_command_replay;
+
+	Debug(desync, 0, "Command replay: {} commands executed, {} skipped from before the start, {} lines not understood{}",
+			replay.executed, replay.skipped, replay.unparsable, replay.has_next ? "; the end of the log was not reached" : "");
+	Debug(desync, 0, "Command replay: {} random states matched the log, {} did not", replay.sync_matches, replay.sync_mismatches);
+	_command_replay.reset();
+}
+
+/**
+ * Whether a command log is being replayed.
+ * @return True while replaying.
+ */
+bool NetworkIsReplayingCommands()
+{
+	return _command_replay != nullptr;
+}
@@ -35,7 +35,6 @@
 #include "../timer/timer_game_economy.h"
 #include "../timer/timer_game_realtime.h"
 #include <mutex>
-#include <condition_variable>
 
 #include "table/strings.h"
 
@@ -63,54 +62,108 @@ static NetworkAuthenticationDefaultAuthorizedKeyHandler _authorized_key_handler(
 static NetworkAuthenticationDefaultAuthorizedKeyHandler _rcon_authorized_key_handler(_settings_client.network.rcon_authorized_keys); ///< Provides the authorized key validation for rcon.
 
 
-/** Writing a savegame directly to a number of packets. */
-struct PacketWriter : SaveFilter {
-	ServerNetworkGameSocketHandler *cs; ///< Socket we are associated with.
-	std::unique_ptr<Packet> current; ///< The packet we're currently writing to.
-	size_t total_size;                  ///< Total size of the compressed savegame.
-	std::deque<std::unique_ptr<Packet>> packets; ///< Packet queue of the savegame; send these "slowly" to the client. Cannot be a std::queue as we want to push the map size packet in front of the data packets.
+/**
+ * The savegame for joining clients, written to memory so it can be sent to
+ * every client that requested the map during the frame it was made in.
+ */
+struct MapSnapshot : SaveFilter {
+	uint32_t frame;                     ///< The frame the savegame was made at.
+	std::vector<std::vector<uint8_t>> blocks; ///< The compressed savegame, in the blocks it was written in.
+	size_t total_size = 0;              ///< Total size of the compressed savegame.
+	bool finished = false;              ///< Whether the complete savegame has been written.
+	uint users = 0;                     ///< Number of clients the savegame is still being sent to.
 	std::mutex mutex;                   ///< Mutex for making threaded saving safe.
-	std::condition_variable exit_sig;   ///< Signal for threaded destruction of this packet writer.
 
 	/**
-	 * Create the packet writer.
-	 * @param cs The socket handler we're making the packets for.
+	 * Create the snapshot.
+	 * @param frame The frame the savegame is made at.
+	 */
+	MapSnapshot(uint32_t frame) : SaveFilter(nullptr), frame(frame)
+	{
+	}
+
+	/**
+	 * Whether the snapshot can be sent to another client that requests the map now.
+	 * @return True iff it was made during this frame and saving it has not been cancelled.
+	 */
+	bool IsShareable()
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->frame == _frame_counter && this->users != 0;
+	}
+
+	/** Start sending the snapshot to another client. */
+	void AddUser()
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->users++;
+	}
+
+	/**
+	 * Stop sending the snapshot to a client.
+	 * @return True iff there are no other clients the snapshot is sent to.
 	 */
-	PacketWriter(ServerNetworkGameSocketHandler *cs) : SaveFilter(nullptr), cs(cs), total_size(0)
+	bool RemoveUser()
 	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		assert(this->users != 0);
+		return --this->users == 0;
+	}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		/* We want to abort the saving when all sockets are closed. */
+		if (this->users == 0) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
+
+		this->blocks.emplace_back(buf, buf + size);
+		this->total_size += size;
 	}
 
-	/** Make sure everything is cleaned up. */
-	~PacketWriter() override
+	void Finish() override
 	{
-		std::unique_lock<std::mutex> lock(this->mutex);
+		std::lock_guard<std::mutex> lock(this->mutex);
 
-		while (this->cs != nullptr) this->exit_sig.wait(lock);
+		/* We want to abort the saving when all sockets are closed. */
+		if (this->users == 0) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
 
-		/* This must all wait until the Destroy function is called. */
+		this->finished = true;
+	}
+};
 
-		this->packets.clear();
-		this->current = nullptr;
+static std::weak_ptr<MapSnapshot> _network_map_snapshot; ///< The most recently made savegame for joining clients.
+
+/** Number of map packets allowed in a client's send queue before we stop making new ones; about 4 MiB. */
+static constexpr size_t MAP_PACKETS_IN_FLIGHT = 128;
+
+/** Sending a savegame snapshot to a client as a number of packets. */
+struct PacketWriter {
+	ServerNetworkGameSocketHandler *cs; ///< Socket we are associated with.
+	std::shared_ptr<MapSnapshot> snapshot; ///< The savegame we are sending.
+	size_t block = 0;                   ///< The block of the snapshot to continue sending from.
+	size_t offset = 0;                  ///< The offset in that block to continue sending from.
+	std::unique_ptr<Packet> current;    ///< The packet we're currently writing to.
+	bool size_sent = false;             ///< Whether the total size has been sent to the client.
+
+	/**
+	 * Create the packet writer.
+	 * @param cs The socket handler we're making the packets for.
+	 * @param snapshot The savegame to send.
+	 */
+	PacketWriter(ServerNetworkGameSocketHandler *cs, std::shared_ptr<MapSnapshot> snapshot) : cs(cs), snapshot(std::move(snapshot))
+	{
+		this->snapshot->AddUser();
 	}
 
 	/**
-	 * Begin the destruction of this packet writer. It can happen in two ways:
-	 * in the first case the client disconnected while saving the map. In this
-	 * case the saving has not finished and killed this PacketWriter. In that
-	 * case we simply set cs to nullptr, triggering the appending to fail due to
-	 * the connection problem and eventually triggering the destructor. In the
-	 * second case the destructor is already called, and it is waiting for our
-	 * signal which we will send. Only then the packets will be removed by the
-	 * destructor.
+	 * Stop sending the savegame. When no other client is receiving it and the
+	 * saving has not finished, this triggers the saving to fail due to the
+	 * connection problem.
 	 */
 	void Destroy()
 	{
-		std::unique_lock<std::mutex> lock(this->mutex);
-
-		this->cs = nullptr;
-
-		this->exit_sig.notify_all();
-		lock.unlock();
+		if (!this->snapshot->RemoveUser()) return;
 
 		/* Make sure the saving is completely cancelled. Yes,
 		 * we need to handle the save finish as well as the
@@ -119,67 +172,47 @@ struct PacketWriter : SaveFilter {
 	}
 
 	/**
-	 * Transfer all packets from here to the network's queue while holding
-	 * the lock on our mutex.
+	 * Transfer all packets that can be made from the written part of the
+	 * savegame to the network's queue while holding the lock on the snapshot.
 	 * @return True iff the last packet of the map has been sent.
 	 */
 	bool TransferToNetworkQueue()
 	{
-		/* Unsafe check for the queue being empty or not. */
-		if (this->packets.empty()) return false;
-
-		std::lock_guard<std::mutex> lock(this->mutex);
+		std::lock_guard<std::mutex> lock(this->snapshot->mutex);
 
-		while (!this->packets.empty()) {
-			bool last_packet = this->packets.front()->GetPacketType() == PACKET_SERVER_MAP_DONE;
-			this->cs->SendPacket(std::move(this->packets.front()));
-			this->packets.pop_front();
-
-			if (last_packet) return true;
+		/* Fast-track the size to the client. */
+		if (this->snapshot->finished && !this->size_sent) {
+			auto p = std::make_unique<Packet>(this->cs, PACKET_SERVER_MAP_SIZE);
+			p->Send_uint32((uint32_t)this->snapshot->total_size);
+			this->cs->SendPacket(std::move(p));
+			this->size_sent = true;
 		}
 
-		return false;
-	}
-
-	void Write(uint8_t *buf, size_t size) override
-	{
-		std::lock_guard<std::mutex> lock(this->mutex);
-
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
-
-		if (this->current == nullptr) this->current = std::make_unique<Packet>(this->cs, PACKET_SERVER_MAP_DATA, TCP_MTU);
-
-		std::span<const uint8_t> to_write(buf, size);
-		while (!to_write.empty()) {
-			to_write = this->current->Send_bytes(to_write);
-
-			if (!this->current->CanWriteToPacket(1)) {
-				this->packets.push_back(std::move(this->current));
-				if (!to_write.empty()) this->current = std::make_unique<Packet>(this->cs, PACKET_SERVER_MAP_DATA, TCP_MTU);
+		/* Only create (and encrypt) map packets as fast as the socket can get rid of
+		 * them. Otherwise a slow client makes us prepare the whole map in one frame,
+		 * which stalls the game loop and keeps all of it in memory a second time. */
+		const auto &blocks = this->snapshot->blocks;
+		while (this->block < blocks.size() && this->cs->GetSendQueueLength() < MAP_PACKETS_IN_FLIGHT) {
+			if (this->current == nullptr) this->current = std::make_unique<Packet>(this->cs, PACKET_SERVER_MAP_DATA, TCP_MTU);
+
+			std::span<const uint8_t> to_write = std::span(blocks[this->block]).subspan(this->offset);
+			this->offset += to_write.size() - this->current->Send_bytes(to_write).size();
+			if (this->offset == blocks[this->block].size()) {
+				this->block++;
+				this->offset = 0;
 			}
-		}
 
-		this->total_size += size;
-	}
-
-	void Finish() override
-	{
-		std::lock_guard<std::mutex> lock(this->mutex);
+			if (!this->current->CanWriteToPacket(1)) this->cs->SendPacket(std::move(this->current));
+		}
 
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
+		if (!this->snapshot->finished || this->block < blocks.size()) return false;
 
 		/* Make sure the last packet is flushed. */
-		if (this->current != nullptr) this->packets.push_back(std::move(this->current));
+		if (this->current != nullptr) this->cs->SendPacket(std::move(this->current));
 
 		/* Add a packet stating that this is the end to the queue. */
-		this->packets.push_back(std::make_unique<Packet>(this->cs, PACKET_SERVER_MAP_DONE));
-
-		/* Fast-track the size to the client. */
-		auto p = std::make_unique<Packet>(this->cs, PACKET_SERVER_MAP_SIZE);
-		p->Send_uint32((uint32_t)this->total_size);
-		this->packets.push_front(std::move(p));
+		this->cs->SendPacket(std::make_unique<Packet>(this->cs, PACKET_SERVER_MAP_DONE));
+		return true;
 	}
 };
 
@@ -338,13 +371,43 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendClientInfo(NetworkClientIn
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/** Serialised game information, reused for all game info queries within the same frame. */
+struct NetworkGameInfoCache {
+	std::vector<uint8_t> data; ///< The serialised information, without packet header.
+	bool valid = false; ///< Whether \c data may be used at all.
+	uint32_t frame = 0; ///< The frame the information was serialised in.
+	uint8_t clients_on = 0; ///< Number of clients when the information was serialised.
+	uint8_t companies_on = 0; ///< Number of companies when the information was serialised.
+	uint8_t spectators_on = 0; ///< Number of spectators when the information was serialised.
+};
+
+static NetworkGameInfoCache _network_game_info_cache; ///< The game information sent by SendGameInfo.
+
 /** Send the client information about the server. */
 NetworkRecvStatus ServerNetworkGameSocketHandler::SendGameInfo()
 {
 	Debug(net, 9, "client[{}] SendGameInfo()", this->client_id);
 
+	/* Server lists and bots can query in bursts; the information only changes
+	 * from frame to frame, so serialise it at most once per frame. */
+	const NetworkServerGameInfo &info = GetCurrentNetworkServerGameInfo();
+	auto &cache = _network_game_info_cache;
+	if (!cache.valid || cache.frame != _frame_counter || cache.clients_on != info.clients_on ||
+			cache.companies_on != info.companies_on || cache.spectators_on != info.spectators_on) {
+		Packet p(nullptr, PACKET_SERVER_GAME_INFO, TCP_MTU);
+		SerializeNetworkGameInfo(p, info);
+
+		auto contents = p.GetBytesToTransferOut().subspan(Packet::EncodedLengthOfPacketSize() + Packet::EncodedLengthOfPacketType());
+		cache.data.assign(contents.begin(), contents.end());
+		cache.valid = true;
+		cache.frame = _frame_counter;
+		cache.clients_on = info.clients_on;
+		cache.companies_on = info.companies_on;
+		cache.spectators_on = info.spectators_on;
+	}
+
 	auto p = std::make_unique<Packet>(this, PACKET_SERVER_GAME_INFO, TCP_MTU);
-	SerializeNetworkGameInfo(*p, GetCurrentNetworkServerGameInfo());
+	p->Send_bytes(cache.data);
 
 	this->SendPacket(std::move(p));
 
@@ -521,28 +584,17 @@ void ServerNetworkGameSocketHandler::CheckNextClientToSendMap(NetworkClientSocke
 {
 	Debug(net, 9, "client[{}] CheckNextClientToSendMap()", this->client_id);
 
-	/* Find the best candidate for joining, i.e. the first joiner. */
-	NetworkClientSocket *best = nullptr;
+	/* Wait until all clients that are downloading the map are done. */
 	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-		if (ignore_cs == new_cs) continue;
-
-		if (new_cs->status == STATUS_MAP_WAIT) {
-			if (best == nullptr || best->GetInfo()->join_date > new_cs->GetInfo()->join_date || (best->GetInfo()->join_date == new_cs->GetInfo()->join_date && best->client_id > new_cs->client_id)) {
-				best = new_cs;
-			}
-		}
+		if (ignore_cs != new_cs && new_cs->status == STATUS_MAP) return;
 	}
 
-	/* Is there someone else to join? */
-	if (best != nullptr) {
-		/* Let the first start joining. */
-		best->status = STATUS_AUTHORIZED;
-		best->SendMap();
+	/* Let every waiting client start joining, they will all share the same savegame. */
+	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
+		if (ignore_cs == new_cs || new_cs->status != STATUS_MAP_WAIT) continue;
 
-		/* And update the rest. */
-		for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-			if (new_cs->status == STATUS_MAP_WAIT) new_cs->SendWait();
-		}
+		new_cs->status = STATUS_AUTHORIZED;
+		new_cs->SendMap();
 	}
 }
 
@@ -557,8 +609,15 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 	if (this->status == STATUS_AUTHORIZED) {
 		Debug(net, 9, "client[{}] SendMap(): first_packet", this->client_id);
 
-		WaitTillSaved();
-		this->savegame = std::make_shared<PacketWriter>(this);
+		/* A savegame made during this frame is the same as a new one would be, so share it. */
+		std::shared_ptr<MapSnapshot> snapshot = _network_map_snapshot.lock();
+		bool shared = snapshot != nullptr && snapshot->IsShareable();
+		if (!shared) {
+			WaitTillSaved();
+			snapshot = std::make_shared<MapSnapshot>(_frame_counter);
+			_network_map_snapshot = snapshot;
+		}
+		this->savegame = std::make_shared<PacketWriter>(this, snapshot);
 
 		/* Now send the _frame_counter and how many packets are coming */
 		auto p = std::make_unique<Packet>(this, PACKET_SERVER_MAP_BEGIN);
@@ -573,7 +632,11 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 		this->last_frame_server = _frame_counter;
 
 		/* Make a dump of the current game */
-		if (SaveWithFilter(this->savegame, true) != SL_OK) UserError("network savedump failed");
+		if (shared) {
+			Debug(net, 9, "client[{}] SendMap(): sharing map of frame {}", this->client_id, snapshot->frame);
+		} else if (SaveWithFilter(snapshot, true) != SL_OK) {
+			UserError("network savedump failed");
+		}
 	}
 
 	if (this->status == STATUS_MAP) {
@@ -661,14 +724,35 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendCommand(const CommandPacke
 
 	auto p = std::make_unique<Packet>(this, PACKET_SERVER_COMMAND);
 
-	this->NetworkGameSocketHandler::SendCommand(*p, cp);
-	p->Send_uint32(cp.frame);
-	p->Send_bool  (cp.my_cmd);
+	if (cp.serialised != nullptr) {
+		p->Send_bytes(*cp.serialised);
+	} else {
+		this->NetworkGameSocketHandler::SendCommand(*p, cp);
+		p->Send_uint32(cp.frame);
+		p->Send_bool  (cp.my_cmd);
+	}
 
 	this->SendPacket(std::move(p));
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Serialise the contents of the command packet once, for sending it to several clients.
+ * The packets themselves cannot be shared, as every client has its own encryption.
+ * @param cp The command to serialise.
+ * @return The contents of the #PACKET_SERVER_COMMAND packet, without its header.
+ */
+std::shared_ptr<const std::vector<uint8_t>> ServerNetworkGameSocketHandler::SerialiseCommand(const CommandPacket &cp)
+{
+	Packet p(nullptr, PACKET_SERVER_COMMAND);
+	this->NetworkGameSocketHandler::SendCommand(p, cp);
+	p.Send_uint32(cp.frame);
+	p.Send_bool  (cp.my_cmd);
+
+	auto contents = p.GetBytesToTransferOut().subspan(Packet::EncodedLengthOfPacketSize() + Packet::EncodedLengthOfPacketType());
+	return std::make_shared<const std::vector<uint8_t>>(contents.begin(), contents.end());
+}
+
 /**
  * Send a chat message.
  * @param action The action associated with the message.
@@ -990,9 +1074,11 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_GETMAP(Packet &
 
 	Debug(net, 9, "client[{}] Receive_CLIENT_GETMAP()", this->client_id);
 
-	/* Check if someone else is receiving the map */
+	/* Check if someone else is receiving a map we cannot share */
+	std::shared_ptr<MapSnapshot> snapshot = _network_map_snapshot.lock();
+	bool shareable = snapshot != nullptr && snapshot->IsShareable();
 	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-		if (new_cs->status == STATUS_MAP) {
+		if (new_cs->status == STATUS_MAP && !shareable) {
 			/* Tell the new client to wait */
 			Debug(net, 9, "client[{}] status = MAP_WAIT", this->client_id);
 			this->status = STATUS_MAP_WAIT;
@@ -1066,7 +1152,7 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_COMMAND(Packet
 	Debug(net, 9, "client[{}] Receive_CLIENT_COMMAND()", this->client_id);
 
 	CommandPacket cp;
-	auto err = this->ReceiveCommand(p, cp);
+	auto err = this->ReceiveCommandHeader(p, cp);
 
 	if (this->HasClientQuit()) return NETWORK_RECV_STATUS_CLIENT_QUIT;
 
@@ -1077,12 +1163,16 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_COMMAND(Packet
 		return this->SendError(NETWORK_ERROR_NOT_EXPECTED);
 	}
 
-	if (GetCommandFlags(cp.cmd).Test(CommandFlag::Server) && ci->client_id != CLIENT_ID_SERVER) {
+	/* Everything that can be decided on the command and company alone is checked
+	 * before the arguments are unpacked and sanitised, so commands that would be
+	 * rejected anyway do not pay for that. */
+	CommandFlags flags = GetCommandFlags(cp.cmd);
+	if (flags.Test(CommandFlag::Server) && ci->client_id != CLIENT_ID_SERVER) {
 		IConsolePrint(CC_WARNING, "Kicking client #{} (IP: {}) due to calling a server only command {}.", ci->client_id, this->GetClientIP(), cp.cmd);
 		return this->SendError(NETWORK_ERROR_KICKED);
 	}
 
-	if (!GetCommandFlags(cp.cmd).Test(CommandFlag::Spectator) && !Company::IsValidID(cp.company) && ci->client_id != CLIENT_ID_SERVER) {
+	if (!flags.Test(CommandFlag::Spectator) && !Company::IsValidID(cp.company) && ci->client_id != CLIENT_ID_SERVER) {
 		IConsolePrint(CC_WARNING, "Kicking client #{} (IP: {}) due to calling a non-spectator command {}.", ci->client_id, this->GetClientIP(), cp.cmd);
 		return this->SendError(NETWORK_ERROR_KICKED);
 	}
@@ -1092,14 +1182,29 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_COMMAND(Packet
 	 * to match the company in the packet. If it doesn't, the client has done
 	 * something pretty naughty (or a bug), and will be kicked
 	 */
-	CompanyCtrlAction cca = cp.cmd == CMD_COMPANY_CTRL ? std::get<0>(EndianBufferReader::ToValue<CommandTraits<CMD_COMPANY_CTRL>::Args>(cp.data)) : CCA_NEW;
-	if (!(cp.cmd == CMD_COMPANY_CTRL && cca == CCA_NEW && ci->client_playas == COMPANY_NEW_COMPANY) && ci->client_playas != cp.company) {
+	if (cp.cmd != CMD_COMPANY_CTRL && ci->client_playas != cp.company) {
 		IConsolePrint(CC_WARNING, "Kicking client #{} (IP: {}) due to calling a command as another company {}.",
 		               ci->client_playas + 1, this->GetClientIP(), cp.company + 1);
 		return this->SendError(NETWORK_ERROR_COMPANY_MISMATCH);
 	}
 
+	err = this->ReceiveCommandData(p, cp);
+
+	if (this->HasClientQuit()) return NETWORK_RECV_STATUS_CLIENT_QUIT;
+
+	if (err.has_value()) {
+		IConsolePrint(CC_WARNING, "Dropping client #{} (IP: {}) due to {}.", ci->client_id, this->GetClientIP(), *err);
+		return this->SendError(NETWORK_ERROR_NOT_EXPECTED);
+	}
+
 	if (cp.cmd == CMD_COMPANY_CTRL) {
+		CompanyCtrlAction cca = std::get<0>(EndianBufferReader::ToValue<CommandTraits<CMD_COMPANY_CTRL>::Args>(cp.data));
+		if (!(cca == CCA_NEW && ci->client_playas == COMPANY_NEW_COMPANY) && ci->client_playas != cp.company) {
+			IConsolePrint(CC_WARNING, "Kicking client #{} (IP: {}) due to calling a command as another company {}.",
+			               ci->client_playas + 1, this->GetClientIP(), cp.company + 1);
+			return this->SendError(NETWORK_ERROR_COMPANY_MISMATCH);
+		}
+
 		if (cca != CCA_NEW || cp.company != COMPANY_SPECTATOR) {
 			return this->SendError(NETWORK_ERROR_CHEATER);
 		}
@@ -1129,7 +1234,7 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_COMMAND(Packet
 		if (!found) return NETWORK_RECV_STATUS_OKAY;
 	}
 
-	if (GetCommandFlags(cp.cmd).Test(CommandFlag::ClientID)) NetworkReplaceCommandClientId(cp, this->client_id);
+	if (flags.Test(CommandFlag::ClientID)) NetworkReplaceCommandClientId(cp, this->client_id);
 
 	this->incoming_queue.push_back(std::move(cp));
 	return NETWORK_RECV_STATUS_OKAY;
@@ -1689,6 +1794,13 @@ void NetworkServer_Tick(bool send_frame)
 	}
 #endif
 
+	/* Admin connections get the same receive budget as clients, so a flooding
+	 * admin cannot make us spend the whole frame on handling its packets. */
+	for (ServerNetworkAdminSocketHandler *as : ServerNetworkAdminSocketHandler::Iterate()) {
+		as->receive_limit = std::min<size_t>(as->receive_limit + _settings_client.network.bytes_per_frame,
+				_settings_client.network.bytes_per_frame_burst);
+	}
+
 	/* Now we are done with the frame, inform the clients that they can
 	 *  do their frame! */
 	for (NetworkClientSocket *cs : NetworkClientSocket::Iterate()) {
@@ -1964,6 +2076,7 @@ void NetworkServerSendConfigUpdate()
 /** Update the server's NetworkServerGameInfo due to changes in settings. */
 void NetworkServerUpdateGameInfo()
 {
+	_network_game_info_cache.valid = false;
 	if (_network_server) FillStaticNetworkServerGameInfo();
 }
 
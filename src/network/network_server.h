@@ -100,6 +100,7 @@ public:
 	NetworkRecvStatus SendFrame();
 	NetworkRecvStatus SendSync();
 	NetworkRecvStatus SendCommand(const CommandPacket &cp);
+	std::shared_ptr<const std::vector<uint8_t>> SerialiseCommand(const CommandPacket &cp);
 	NetworkRecvStatus SendConfigUpdate();
 
 	static void Send();
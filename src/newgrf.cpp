@@ -45,9 +45,12 @@
 #include "newgrf/newgrf_internal_vehicle.h"
 #include "newgrf/newgrf_internal.h"
 #include "newgrf/newgrf_stringmapping.h"
+#include "thread.h"
 
 #include "table/strings.h"
 
+#include <atomic>
+
 #include "safeguards.h"
 
 /* TTDPatch extended GRF format codec
@@ -1750,6 +1753,70 @@ static void AfterLoadGRFs()
 	_grm_sprites.clear();
 }
 
+/**
+ * Reads the NewGRFs ahead of the loading stages on a separate thread, so they are
+ * in the cache of the operating system when the stages get to them. The stages
+ * decode the pseudo sprites in order and update global state, so they cannot run
+ * in parallel themselves, but they mostly wait for many small reads spread over the
+ * file. Only the part before the sprite data section is read, as the loading
+ * stages skip the sprite data anyway.
+ */
+class NewGRFPrefetcher {
+	std::vector<std::pair<std::string, Subdirectory>> files; ///< The files to read, in loading order.
+	std::atomic<bool> stop = false; ///< Whether to stop reading.
+	std::thread thread; ///< The thread reading the files.
+
+	/** Read all files, until done or told to stop. */
+	void Run()
+	{
+		std::vector<uint8_t> buffer(64 * 1024);
+		for (const auto &[filename, subdir] : this->files) {
+			size_t size;
+			auto f = FioFOpenFile(filename, "rb", subdir, &size);
+			if (!f.has_value()) continue;
+
+			long start = ftell(*f);
+			size = std::min(size, GRFGetSizeOfDataSection(*f));
+			if (start < 0 || fseek(*f, start, SEEK_SET) < 0) continue;
+
+			size_t len;
+			while (size != 0 && !this->stop && (len = fread(buffer.data(), 1, std::min(size, buffer.size()), *f)) != 0) {
+				size -= len;
+			}
+			if (this->stop) return;
+		}
+	}
+
+public:
+	/**
+	 * Start reading the given NewGRFs.
+	 * @param configs The NewGRFs to load.
+	 * @param num_baseset Number of NewGRFs at the front of the list to look up in the baseset dir instead of the newgrf dir.
+	 */
+	NewGRFPrefetcher(const GRFConfigList &configs, uint num_baseset)
+	{
+		uint num_grfs = 0;
+		for (const auto &c : configs) {
+			if (c->status == GCS_DISABLED || c->status == GCS_NOT_FOUND) continue;
+			Subdirectory subdir = num_grfs++ < num_baseset ? BASESET_DIR : NEWGRF_DIR;
+			this->files.emplace_back(c->filename, subdir);
+		}
+		/* With a single file there is nothing to read ahead of. */
+		if (this->files.size() < 2) return;
+
+		if (!StartNewThread(&this->thread, "ottd:grf-read", [this]() { this->Run(); })) {
+			/* Without a thread the files are simply read while loading them. */
+			this->files.clear();
+		}
+	}
+
+	~NewGRFPrefetcher()
+	{
+		this->stop = true;
+		if (this->thread.joinable()) this->thread.join();
+	}
+};
+
 /**
  * Load all the NewGRFs.
  * @param load_index The offset for the first sprite to add.
@@ -1802,6 +1869,8 @@ void LoadNewGRF(SpriteID load_index, uint num_baseset)
 
 	_cur_gps.spriteid = load_index;
 
+	NewGRFPrefetcher prefetcher(_grfconfig, num_baseset);
+
 	/* Load newgrf sprites
 	 * in each loading stage, (try to) open each file specified in the config
 	 * and load information from it. */
@@ -283,13 +283,13 @@ static bool CalcGRFMD5Sum(GRFConfig &config, Subdirectory subdir)
 
 
 /**
- * Find the GRFID of a given grf, and calculate its md5sum.
+ * Find the GRFID of a given grf, without calculating its md5sum yet.
  * @param config    grf to fill.
  * @param is_static grf is static.
  * @param subdir    the subdirectory to search in.
- * @return Operation was successfully completed.
+ * @return Whether the md5sum of the grf has to be calculated.
  */
-bool FillGRFDetails(GRFConfig &config, bool is_static, Subdirectory subdir)
+static bool LoadGRFDetails(GRFConfig &config, bool is_static, Subdirectory subdir)
 {
 	if (!FioCheckFileExists(config.filename, subdir)) {
 		config.status = GCS_NOT_FOUND;
@@ -312,7 +312,19 @@ bool FillGRFDetails(GRFConfig &config, bool is_static, Subdirectory subdir)
 		if (config.flags.Test(GRFConfigFlag::Unsafe)) return false;
 	}
 
-	return CalcGRFMD5Sum(config, subdir);
+	return true;
+}
+
+/**
+ * Find the GRFID of a given grf, and calculate its md5sum.
+ * @param config    grf to fill.
+ * @param is_static grf is static.
+ * @param subdir    the subdirectory to search in.
+ * @return Operation was successfully completed.
+ */
+bool FillGRFDetails(GRFConfig &config, bool is_static, Subdirectory subdir)
+{
+	return LoadGRFDetails(config, is_static, subdir) && CalcGRFMD5Sum(config, subdir);
 }
 
 
@@ -484,6 +496,10 @@ int _skip_all_newgrf_scanning = 0;
 class GRFFileScanner : FileScanner {
 	std::chrono::steady_clock::time_point next_update; ///< The next moment we do update the screen.
 	uint num_scanned; ///< The number of GRFs we have scanned.
+	std::vector<std::unique_ptr<GRFConfig>> scanned; ///< The GRFs found, still without their md5sum.
+
+	void CalcMD5Sums();
+	uint AddScannedGRFs();
 
 public:
 	GRFFileScanner() : num_scanned(0)
@@ -502,14 +518,53 @@ public:
 		}
 
 		GRFFileScanner fs;
-		int ret = fs.Scan(".grf", NEWGRF_DIR);
+		fs.Scan(".grf", NEWGRF_DIR);
+		fs.CalcMD5Sums();
 		/* The number scanned and the number returned may not be the same;
 		 * duplicate NewGRFs and base sets are ignored in the return value. */
 		_settings_client.gui.last_newgrf_count = fs.num_scanned;
-		return ret;
+		return fs.AddScannedGRFs();
 	}
 };
 
+/** Maximum number of threads to calculate the md5sums of the scanned GRFs on. */
+static const uint MAX_GRF_MD5_THREADS = 8;
+
+/**
+ * Calculate the md5sums of all scanned GRFs, on a few threads. Reading the
+ * whole file for its md5sum is most of the work of scanning, but unlike
+ * loading the GRF details it does not touch any global state.
+ */
+void GRFFileScanner::CalcMD5Sums()
+{
+	std::vector<uint8_t> success(this->scanned.size());
+	ParallelForEach("ottd:grf-md5", this->scanned.size(), MAX_GRF_MD5_THREADS, [this, &success](size_t i) {
+		success[i] = CalcGRFMD5Sum(*this->scanned[i], NEWGRF_DIR);
+	});
+
+	for (size_t i = 0; i < this->scanned.size(); i++) {
+		if (!success[i]) this->scanned[i].reset();
+	}
+}
+
+/**
+ * Add the scanned GRFs with an md5sum to the list of all GRFs, skipping duplicates.
+ * @return The number of GRFs added.
+ */
+uint GRFFileScanner::AddScannedGRFs()
+{
+	uint num = 0;
+	for (auto &c : this->scanned) {
+		if (c == nullptr) continue;
+		if (std::ranges::none_of(_all_grfs, [&c](const auto &gc) { return c->ident.grfid == gc->ident.grfid && c->ident.md5sum == gc->ident.md5sum; })) {
+			_all_grfs.push_back(std::move(c));
+			num++;
+		}
+	}
+	this->scanned.clear();
+	return num;
+}
+
 bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length, const std::string &)
 {
 	/* Abort if the user stopped the game during a scan. */
@@ -518,11 +573,10 @@ bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length
 	bool added = false;
 	auto c = std::make_unique<GRFConfig>(filename.substr(basepath_length));
 	GRFConfig *grfconfig = c.get();
-	if (FillGRFDetails(*c, false)) {
-		if (std::ranges::none_of(_all_grfs, [&c](const auto &gc) { return c->ident.grfid == gc->ident.grfid && c->ident.md5sum == gc->ident.md5sum; })) {
-			_all_grfs.push_back(std::move(c));
-			added = true;
-		}
+	/* The md5sums are calculated for all GRFs at once after the scan; see CalcMD5Sums. */
+	if (LoadGRFDetails(*c, false, NEWGRF_DIR)) {
+		this->scanned.push_back(std::move(c));
+		added = true;
 	}
 
 	this->num_scanned++;
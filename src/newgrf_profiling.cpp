@@ -17,6 +17,7 @@
 #include "3rdparty/fmt/chrono.h"
 #include "timer/timer.h"
 #include "timer/timer_game_tick.h"
+#include "framerate_type.h"
 
 #include <chrono>
 
@@ -197,3 +198,139 @@ static TimeoutTimer<TimerGameTick> _profiling_finish_timeout({ TimerGameTick::Pr
 {
 	_profiling_finish_timeout.Abort();
 }
+
+extern std::span<const GRFFile> GetAllGRFFiles();
+
+/** Number of callbacks the statistics are kept for; higher callback numbers are not counted. */
+static constexpr uint NEWGRF_CALLBACK_STATS_CALLBACKS = CBID_VEHICLE_CUSTOM_REFIT + 1;
+/** Callback statistics of one feature of one NewGRF, indexed by callback. */
+using NewGRFFeatureCallbackStats = std::array<NewGRFCallbackStats, NEWGRF_CALLBACK_STATS_CALLBACKS>;
+
+/** Callback statistics of one loaded NewGRF. */
+struct NewGRFFileCallbackStats {
+	uint32_t grfid = 0; ///< The NewGRF the statistics are of.
+	/** Statistics per feature, allocated on first use; the last entry counts the resolutions without a real feature. */
+	std::array<std::unique_ptr<NewGRFFeatureCallbackStats>, GSF_FAKE_END + 1> features{};
+};
+
+bool _newgrf_callback_stats_enabled = false; ///< Whether the callback statistics are being collected.
+/**
+ * Callback statistics in order of the loaded NewGRF files, with the resolutions without a NewGRF first.
+ * They are local to this client and never influence the game state.
+ */
+static std::vector<NewGRFFileCallbackStats> _newgrf_callback_stats;
+/** Number of top-level resolutions in progress; callbacks can be nested in another resolution. */
+static uint _newgrf_callback_depth = 0;
+/** Frame rate measurement of the outermost resolution in progress. */
+static std::optional<PerformanceAccumulator> _newgrf_callback_framerate;
+
+/** Start measuring the resolution. */
+void NewGRFCallbackMeasurer::Start()
+{
+	if (_newgrf_callback_depth++ == 0) _newgrf_callback_framerate.emplace(PFE_GL_NEWGRF);
+	this->start_time = std::chrono::steady_clock::now();
+}
+
+/** Finish measuring the resolution and add it to the statistics. */
+void NewGRFCallbackMeasurer::Stop()
+{
+	uint64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start_time).count();
+	if (--_newgrf_callback_depth == 0) _newgrf_callback_framerate.reset();
+
+	const GRFFile *grffile = this->object.grffile;
+	std::span<const GRFFile> files = GetAllGRFFiles();
+	size_t index = 0;
+	if (grffile != nullptr) {
+		if (grffile < files.data() || grffile >= files.data() + files.size()) return;
+		index = grffile - files.data() + 1;
+	}
+
+	uint callback = this->object.callback;
+	if (callback >= NEWGRF_CALLBACK_STATS_CALLBACKS) return;
+
+	if (index >= _newgrf_callback_stats.size()) _newgrf_callback_stats.resize(index + 1);
+	NewGRFFileCallbackStats &file_stats = _newgrf_callback_stats[index];
+	uint32_t grfid = grffile == nullptr ? 0 : grffile->grfid;
+	/* Another game with other NewGRFs has been loaded since. */
+	if (file_stats.grfid != grfid) file_stats = {grfid, {}};
+
+	auto &feature_stats = file_stats.features[std::min<uint>(this->object.GetFeature(), GSF_FAKE_END)];
+	if (feature_stats == nullptr) feature_stats = std::make_unique<NewGRFFeatureCallbackStats>();
+
+	NewGRFCallbackStats &stats = (*feature_stats)[callback];
+	stats.calls++;
+	stats.total_time += time;
+	stats.max_time = std::max(stats.max_time, time);
+}
+
+/**
+ * Switch the collection of the callback statistics on or off.
+ * @param enabled Whether to collect the statistics.
+ */
+void SetNewGRFCallbackStatsEnabled(bool enabled)
+{
+	_newgrf_callback_stats_enabled = enabled;
+}
+
+/**
+ * Get the callback statistics of all NewGRFs.
+ * @return The statistics per GRF ID, feature and callback.
+ */
+NewGRFCallbackStatsMap GetNewGRFCallbackStats()
+{
+	NewGRFCallbackStatsMap result;
+	for (const NewGRFFileCallbackStats &file_stats : _newgrf_callback_stats) {
+		for (uint feature = 0; feature < file_stats.features.size(); feature++) {
+			if (file_stats.features[feature] == nullptr) continue;
+
+			const NewGRFFeatureCallbackStats &feature_stats = *file_stats.features[feature];
+			for (uint callback = 0; callback < feature_stats.size(); callback++) {
+				const NewGRFCallbackStats &stats = feature_stats[callback];
+				if (stats.calls == 0) continue;
+
+				GrfSpecFeature key_feature = feature == GSF_FAKE_END ? GSF_INVALID : static_cast<GrfSpecFeature>(feature);
+				NewGRFCallbackStats &total = result[{file_stats.grfid, key_feature, static_cast<CallbackID>(callback)}];
+				total.calls += stats.calls;
+				total.total_time += stats.total_time;
+				total.max_time = std::max(total.max_time, stats.max_time);
+			}
+		}
+	}
+	return result;
+}
+
+/**
+ * Clear the callback statistics of all NewGRFs.
+ */
+void ResetNewGRFCallbackStats()
+{
+	_newgrf_callback_stats.clear();
+}
+
+/**
+ * Print the callback statistics to the console, the most expensive ones first.
+ */
+void ConPrintNewGRFCallbackStats()
+{
+	NewGRFCallbackStatsMap all_stats = GetNewGRFCallbackStats();
+	if (all_stats.empty()) {
+		if (_newgrf_callback_stats_enabled) {
+			IConsolePrint(CC_ERROR, "No NewGRF callbacks have been resolved yet.");
+		} else {
+			IConsolePrint(CC_ERROR, "NewGRF callback statistics are not being collected; use 'grfstats start'.");
+		}
+		return;
+	}
+
+	std::vector<NewGRFCallbackStatsMap::const_pointer> sorted;
+	sorted.reserve(all_stats.size());
+	for (const auto &entry : all_stats) sorted.push_back(&entry);
+	std::ranges::sort(sorted, std::greater{}, [](const auto *entry) { return entry->second.total_time; });
+
+	for (const auto *entry : sorted) {
+		const auto &[grfid, feature, callback] = entry->first;
+		const NewGRFCallbackStats &stats = entry->second;
+		IConsolePrint(CC_DEFAULT, "[{:08X}] feature 0x{:02X}, callback 0x{:X}: {} calls, {} us total, {} ns average, {} ns max",
+				std::byteswap(grfid), feature, (uint)callback, stats.calls, stats.total_time / 1000, stats.total_time / stats.calls, stats.max_time);
+	}
+}
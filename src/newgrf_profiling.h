@@ -15,6 +15,8 @@
 #include "newgrf_callbacks.h"
 #include "newgrf_spritegroup.h"
 
+#include <chrono>
+
 
 /**
  * Callback profiler for NewGRF development
@@ -57,4 +59,57 @@ struct NewGRFProfiler {
 
 extern std::vector<NewGRFProfiler> _newgrf_profilers;
 
+/** Accumulated cost of the top-level resolutions of one callback, for one feature of one NewGRF. */
+struct NewGRFCallbackStats {
+	uint64_t calls = 0; ///< Number of resolutions.
+	uint64_t total_time = 0; ///< Time spent in the resolutions, in nanoseconds.
+	uint64_t max_time = 0; ///< Longest single resolution, in nanoseconds.
+};
+
+/** Key of the callback statistics: GRF ID, feature and callback. */
+using NewGRFCallbackStatsKey = std::tuple<uint32_t, GrfSpecFeature, CallbackID>;
+/** Callback statistics of all NewGRFs, ordered by GRF ID, feature and callback. */
+using NewGRFCallbackStatsMap = std::map<NewGRFCallbackStatsKey, NewGRFCallbackStats>;
+
+extern bool _newgrf_callback_stats_enabled;
+
+/**
+ * Measure the time of a top-level sprite group resolution for the callback statistics.
+ * Unlike the NewGRFProfiler this only keeps aggregates, and it only measures anything
+ * while the collection of the statistics is switched on.
+ * Callbacks nested in another resolution are included in the time of the outer
+ * one too, but only the outermost resolution counts for the frame rate window.
+ */
+class NewGRFCallbackMeasurer {
+public:
+	/**
+	 * Start measuring a sprite group resolution, if the statistics are being collected.
+	 * @param object The resolver of the sprite group.
+	 * @param top_level Whether this is a top-level resolution; nested ones are not measured separately.
+	 */
+	inline NewGRFCallbackMeasurer(const ResolverObject &object, bool top_level) : object(object), active(top_level && _newgrf_callback_stats_enabled)
+	{
+		if (this->active) this->Start();
+	}
+
+	/** Finish measuring a sprite group resolution and add it to the statistics. */
+	inline ~NewGRFCallbackMeasurer()
+	{
+		if (this->active) this->Stop();
+	}
+
+private:
+	const ResolverObject &object; ///< The resolver being measured.
+	bool active; ///< Whether this is a top-level resolution that is being measured.
+	std::chrono::steady_clock::time_point start_time; ///< Time the resolution started.
+
+	void Start();
+	void Stop();
+};
+
+void SetNewGRFCallbackStatsEnabled(bool enabled);
+NewGRFCallbackStatsMap GetNewGRFCallbackStats();
+void ResetNewGRFCallbackStats();
+void ConPrintNewGRFCallbackStats();
+
 #endif /* NEWGRF_PROFILING_H */
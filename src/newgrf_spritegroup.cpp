@@ -35,6 +35,8 @@ INSTANTIATE_POOL_METHODS(SpriteGroup)
 {
 	if (group == nullptr) return std::monostate{};
 
+	NewGRFCallbackMeasurer measurer(object, top_level);
+
 	const GRFFile *grf = object.grffile;
 	auto profiler = std::ranges::find(_newgrf_profilers, grf, &NewGRFProfiler::grffile);
 
@@ -183,16 +185,23 @@ static bool RangeHighComparator(const DeterministicSpriteGroupRange &range, uint
 	return range.high < value;
 }
 
-/* virtual */ ResolverResult DeterministicSpriteGroup::Resolve(ResolverObject &object) const
+/**
+ * Evaluate the adjustments of a deterministic sprite group for a variable of the given size.
+ * Having the size as template parameter saves checking it for every adjustment of the chain.
+ * U is the unsigned type and S is the signed type to use.
+ * @param group Group with the adjustments to evaluate.
+ * @param object Object we are resolving for.
+ * @param scope Scope of the group.
+ * @param[out] last_value Result of the last adjustment.
+ * @return False iff an adjustment used a variable that is not available.
+ */
+template <typename U, typename S>
+static bool EvalAdjustsT(const DeterministicSpriteGroup &group, ResolverObject &object, ScopeResolver *scope, uint32_t &last_value)
 {
-	uint32_t last_value = 0;
-	uint32_t value = 0;
-
-	ScopeResolver *scope = object.GetScope(this->var_scope);
-
-	for (const auto &adjust : this->adjusts) {
+	for (const auto &adjust : group.adjusts) {
 		/* Try to get the variable. We shall assume it is available, unless told otherwise. */
 		bool available = true;
+		uint32_t value;
 		if (adjust.variable == 0x7E) {
 			auto subgroup = SpriteGroup::Resolve(adjust.subroutine, object, false);
 			auto *subvalue = std::get_if<CallbackResult>(&subgroup);
@@ -205,21 +214,34 @@ static bool RangeHighComparator(const DeterministicSpriteGroupRange &range, uint
 			value = GetVariable(object, scope, adjust.variable, adjust.parameter, available);
 		}
 
-		if (!available) {
-			/* Unsupported variable: skip further processing and return either
-			 * the group from the first range or the default group. */
-			return SpriteGroup::Resolve(this->error_group, object, false);
-		}
+		if (!available) return false;
 
-		switch (this->size) {
-			case DSG_SIZE_BYTE:  value = EvalAdjustT<uint8_t,  int8_t> (adjust, object, scope, last_value, value); break;
-			case DSG_SIZE_WORD:  value = EvalAdjustT<uint16_t, int16_t>(adjust, object, scope, last_value, value); break;
-			case DSG_SIZE_DWORD: value = EvalAdjustT<uint32_t, int32_t>(adjust, object, scope, last_value, value); break;
-			default: NOT_REACHED();
-		}
-		last_value = value;
+		last_value = EvalAdjustT<U, S>(adjust, object, scope, last_value, value);
+	}
+	return true;
+}
+
+/* virtual */ ResolverResult DeterministicSpriteGroup::Resolve(ResolverObject &object) const
+{
+	uint32_t last_value = 0;
+
+	ScopeResolver *scope = object.GetScope(this->var_scope);
+
+	bool available;
+	switch (this->size) {
+		case DSG_SIZE_BYTE:  available = EvalAdjustsT<uint8_t,  int8_t> (*this, object, scope, last_value); break;
+		case DSG_SIZE_WORD:  available = EvalAdjustsT<uint16_t, int16_t>(*this, object, scope, last_value); break;
+		case DSG_SIZE_DWORD: available = EvalAdjustsT<uint32_t, int32_t>(*this, object, scope, last_value); break;
+		default: NOT_REACHED();
+	}
+
+	if (!available) {
+		/* Unsupported variable: skip further processing and return either
+		 * the group from the first range or the default group. */
+		return SpriteGroup::Resolve(this->error_group, object, false);
 	}
 
+	uint32_t value = last_value;
 	object.last_value = last_value;
 
 	auto result = this->default_result;
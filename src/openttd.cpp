@@ -48,6 +48,7 @@
 #include "vehicle_func.h"
 #include "gamelog.h"
 #include "animated_tile_func.h"
+#include "cachecheck.h"
 #include "roadstop_base.h"
 #include "elrail_func.h"
 #include "rev.h"
@@ -72,6 +73,7 @@
 #include "framerate_type.h"
 #include "industry.h"
 #include "network/network_gui.h"
+#include "network/network_replay.h"
 #include "network/network_survey.h"
 #include "rpc/rpc_server.h"
 #include "misc_cmd.h"
@@ -86,6 +88,7 @@
 #include "linkgraph/linkgraphschedule.h"
 
 #include <system_error>
+#include "trace.h"
 
 #include "table/strings.h"
 
@@ -102,7 +105,6 @@ void MusicLoop();
 void CallWindowGameTickEvent();
 bool HandleBootstrap();
 
-extern void CheckCaches();
 extern Company *DoStartupNewCompany(bool is_ai, CompanyID company = CompanyID::Invalid());
 extern void OSOpenBrowser(const std::string &url);
 extern void ShowOSErrorBox(std::string_view buf, bool system);
@@ -1105,17 +1107,26 @@ void SwitchToMode(SwitchMode new_mode)
 
 		case SM_RESTARTGAME: // Restart --> 'Random game' with current settings
 		case SM_NEWGAME: // New Game --> 'Random game'
-			MakeNewGame(false, new_mode == SM_NEWGAME);
+			/* The world generation benchmark generates a number of worlds in a row. */
+			do {
+				MakeNewGame(false, new_mode == SM_NEWGAME);
+			} while (GenerateWorldBenchmarkAfterGenerate());
 			GenerateSavegameId();
 
 			UpdateSocialIntegration(GM_NORMAL);
 			break;
 
 		case SM_LOAD_GAME: { // Load game, Play Scenario
-			ResetGRFConfig(true);
-			ResetWindowSystem();
+			bool loaded;
+			do {
+				ResetGRFConfig(true);
+				ResetWindowSystem();
+
+				loaded = SafeLoad(_file_to_saveload.name, _file_to_saveload.file_op, _file_to_saveload.ftype.detailed, GM_NORMAL, NO_DIRECTORY);
+				/* The savegame benchmark loads the same savegame a number of times in a row. */
+			} while (SaveLoadBenchmarkAfterLoad(loaded));
 
-			if (!SafeLoad(_file_to_saveload.name, _file_to_saveload.file_op, _file_to_saveload.ftype.detailed, GM_NORMAL, NO_DIRECTORY)) {
+			if (!loaded) {
 				ShowErrorMessage(GetSaveLoadErrorType(), GetSaveLoadErrorMessage(), WL_CRITICAL);
 			} else {
 				if (_file_to_saveload.ftype.abstract == FT_SCENARIO) {
@@ -1224,6 +1235,8 @@ void SwitchToMode(SwitchMode new_mode)
  */
 void StateGameLoop()
 {
+	TraceZone zone("StateGameLoop");
+
 	if (!_networking || _network_server) {
 		StateGameLoop_LinkGraphPauseControl();
 	}
@@ -1236,17 +1249,20 @@ void StateGameLoop()
 		PerformanceMeasurer::Paused(PFE_GL_ROADVEHS);
 		PerformanceMeasurer::Paused(PFE_GL_SHIPS);
 		PerformanceMeasurer::Paused(PFE_GL_AIRCRAFT);
+		PerformanceMeasurer::Paused(PFE_GL_PATHFINDER);
+		PerformanceMeasurer::Paused(PFE_GL_NEWGRF);
 		PerformanceMeasurer::Paused(PFE_GL_LANDSCAPE);
 
 		if (!HasModalProgress()) UpdateLandscapingLimits();
 #ifndef DEBUG_DUMP_COMMANDS
-		if (_game_mode == GM_NORMAL) Game::GameLoop();
+		if (_game_mode == GM_NORMAL && !NetworkIsReplayingCommands()) Game::GameLoop();
 #endif
 		return;
 	}
 
 	PerformanceMeasurer framerate(PFE_GAMELOOP);
 	PerformanceAccumulator::Reset(PFE_GL_LANDSCAPE);
+	PerformanceAccumulator::Reset(PFE_GL_NEWGRF);
 
 	if (_game_mode == GM_EDITOR) {
 		BasePersistentStorageArray::SwitchMode(PSM_ENTER_GAMELOOP);
@@ -1284,7 +1300,8 @@ void StateGameLoop()
 		BasePersistentStorageArray::SwitchMode(PSM_LEAVE_GAMELOOP);
 
 #ifndef DEBUG_DUMP_COMMANDS
-		{
+		/* A replayed command log already holds the commands of the scripts. */
+		if (!NetworkIsReplayingCommands()) {
 			PerformanceMeasurer script_framerate(PFE_ALLSCRIPTS);
 			AI::GameLoop();
 			Game::GameLoop();
@@ -1402,6 +1419,7 @@ void GameLoop()
 			NetworkClientConnectGame(_settings_client.network.last_joined, COMPANY_SPECTATOR);
 		}
 		/* Singleplayer */
+		NetworkReplayCommands();
 		StateGameLoop();
 	}
 
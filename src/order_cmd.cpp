@@ -323,6 +323,10 @@ void OrderList::FreeChain(bool keep_orderlist)
  *         \li a refitting depot order
  *         \li a non-trivial conditional order
  *         \li INVALID_VEH_ORDER_ID if the vehicle won't stop anymore.
+ * @note The result is not cached per order list: orders are changed in place through
+ *       many paths (modifying, refitting, removing destinations, loading games), and a
+ *       stale answer changes cargo routing and thus causes desyncs. The walk only passes
+ *       orders that cannot stop, so it usually ends at the first or second order.
  */
 VehicleOrderID OrderList::GetNextDecisionNode(VehicleOrderID next, uint hops) const
 {
@@ -52,6 +52,8 @@ class WaterRegionData {
 	std::unique_ptr<WaterRegionPatchLabelArray> tile_patch_labels; // Tile patch labels, this may be nullptr in the following trivial cases: region is invalid, region is only land (0 patches), region is only water (1 patch)
 	bool has_cross_region_aqueducts = false;
 	WaterRegionPatchLabel::BaseType number_of_patches{0}; // 0 = no water, 1 = one single patch of water, etc...
+	std::vector<std::vector<WaterRegionPatchDesc>> patch_neighbours; // Patches in adjacent regions reachable from each patch, indexed by label - FIRST_REGION_LABEL
+	bool patch_neighbours_valid = false; // Whether patch_neighbours matches the labels of this region and the adjacent regions
 };
 
 /**
@@ -120,6 +122,42 @@ public:
 		return (*this->data.tile_patch_labels)[this->GetLocalIndex(tile)];
 	}
 
+	/**
+	 * @returns Whether the patches reachable in the adjacent regions are known for all patches of this region.
+	 */
+	bool HasPatchNeighbours() const { return this->data.patch_neighbours_valid; }
+
+	/**
+	 * Returns the patches in the adjacent regions that are reachable from a patch of this region.
+	 * @param label The patch of this region.
+	 * @returns The reachable patches, in the order they were found.
+	 */
+	const std::vector<WaterRegionPatchDesc> &GetPatchNeighbours(WaterRegionPatchLabel label) const
+	{
+		assert(this->HasPatchNeighbours());
+		return this->data.patch_neighbours[label.base() - FIRST_REGION_LABEL.base()];
+	}
+
+	/**
+	 * Stores the patches in the adjacent regions that are reachable from each patch of this region.
+	 * @param neighbours The reachable patches, indexed by label - #FIRST_REGION_LABEL.
+	 */
+	void SetPatchNeighbours(std::vector<std::vector<WaterRegionPatchDesc>> &&neighbours)
+	{
+		assert(neighbours.size() == static_cast<size_t>(this->NumberOfPatches()));
+		this->data.patch_neighbours = std::move(neighbours);
+		this->data.patch_neighbours_valid = true;
+	}
+
+	/**
+	 * Forgets the reachable patches, because the labels of this region or an adjacent region changed.
+	 */
+	void InvalidatePatchNeighbours()
+	{
+		this->data.patch_neighbours.clear();
+		this->data.patch_neighbours_valid = false;
+	}
+
 	/**
 	 * Performs the connected component labeling and other data gathering.
 	 * @see WaterRegion
@@ -128,6 +166,7 @@ public:
 	{
 		Debug(map, 3, "Updating water region ({},{})", GetWaterRegionX(this->tile_area.tile), GetWaterRegionY(this->tile_area.tile));
 		this->data.has_cross_region_aqueducts = false;
+		this->InvalidatePatchNeighbours();
 
 		/* Acquire a tile patch label array if this region does not already have one */
 		if (this->data.tile_patch_labels == nullptr) {
@@ -223,6 +262,7 @@ public:
 
 TypedIndexContainer<std::vector<WaterRegionData>, WaterRegionIndex> _water_region_data;
 TypedIndexContainer<std::vector<bool>, WaterRegionIndex> _is_water_region_valid;
+static uint64_t _water_region_change_counter = 0; ///< Incremented whenever any water region may have changed.
 
 static TileIndex GetTileIndexFromLocalCoordinate(int region_x, int region_y, int local_x, int local_y)
 {
@@ -250,6 +290,15 @@ static WaterRegion GetUpdatedWaterRegion(uint16_t region_x, uint16_t region_y)
 	if (!_is_water_region_valid[index]) {
 		water_region.ForceUpdate();
 		_is_water_region_valid[index] = true;
+
+		/* The labels might have changed, so the adjacent regions have to find their neighbouring patches again. */
+		for (DiagDirection side : DIAGDIRECTIONS_ALL) {
+			const TileIndexDiffC offset = TileIndexDiffCByDiagDir(side);
+			const int nx = region_x + offset.x;
+			const int ny = region_y + offset.y;
+			if (nx < 0 || ny < 0 || nx >= GetWaterRegionMapSizeX() || ny >= GetWaterRegionMapSizeY()) continue;
+			WaterRegion(nx, ny, _water_region_data[GetWaterRegionIndex(nx, ny)]).InvalidatePatchNeighbours();
+		}
 	}
 	return water_region;
 }
@@ -306,6 +355,16 @@ WaterRegionPatchDesc GetWaterRegionPatchInfo(TileIndex tile)
 	return WaterRegionPatchDesc{ GetWaterRegionX(tile), GetWaterRegionY(tile), region.GetLabel(tile) };
 }
 
+/**
+ * Get the number of times the water regions may have changed.
+ * Anything derived from the water regions is still valid as long as this value is unchanged.
+ * @return The change counter.
+ */
+uint64_t GetWaterRegionChangeCounter()
+{
+	return _water_region_change_counter;
+}
+
 /**
  * Marks the water region that tile is part of as invalid.
  * @param tile Tile within the water region that we wish to invalidate.
@@ -314,6 +373,8 @@ void InvalidateWaterRegion(TileIndex tile)
 {
 	if (!IsValidTile(tile)) return;
 
+	_water_region_change_counter++;
+
 	auto invalidate_region = [](TileIndex tile) {
 		const WaterRegionIndex water_region_index = GetWaterRegionIndex(tile);
 		if (!_is_water_region_valid[water_region_index]) Debug(map, 3, "Invalidated water region ({},{})", GetWaterRegionX(tile), GetWaterRegionY(tile));
@@ -386,16 +447,36 @@ static inline void VisitAdjacentWaterRegionPatchNeighbours(const WaterRegionPatc
  * Calls the provided callback function on all accessible water region patches in
  * each cardinal direction, plus any others that are reachable via aqueducts.
  * @param water_region_patch Water patch within the water region to start searching from
- * @param callback The function that will be called for each accessible water patch that is found
+ * @param callback The function that will be called for each accessible water patch that is found; it must not change the map
  */
 void VisitWaterRegionPatchNeighbours(const WaterRegionPatchDesc &water_region_patch, VisitWaterRegionPatchCallback &callback)
 {
 	if (water_region_patch.label == INVALID_WATER_REGION_PATCH) return;
 
-	const WaterRegion current_region = GetUpdatedWaterRegion(water_region_patch.x, water_region_patch.y);
+	WaterRegion current_region = GetUpdatedWaterRegion(water_region_patch.x, water_region_patch.y);
+
+	/* Visit adjacent water region patches in each cardinal direction. Scanning the region edges for
+	 * them is done once for all patches of the region and kept until the labels of the region or an
+	 * adjacent region change. Adjacent regions are relabelled lazily, so update them before looking
+	 * at the kept neighbours; relabelling one of them drops the neighbours of this region. */
+	for (DiagDirection side : DIAGDIRECTIONS_ALL) {
+		const TileIndexDiffC offset = TileIndexDiffCByDiagDir(side);
+		const int nx = water_region_patch.x + offset.x;
+		const int ny = water_region_patch.y + offset.y;
+		if (nx < 0 || ny < 0 || nx >= GetWaterRegionMapSizeX() || ny >= GetWaterRegionMapSizeY()) continue;
+		GetUpdatedWaterRegion(nx, ny);
+	}
 
-	/* Visit adjacent water region patches in each cardinal direction */
-	for (DiagDirection side : DIAGDIRECTIONS_ALL) VisitAdjacentWaterRegionPatchNeighbours(water_region_patch, side, callback);
+	if (!current_region.HasPatchNeighbours()) {
+		std::vector<std::vector<WaterRegionPatchDesc>> neighbours(current_region.NumberOfPatches());
+		for (int i = 0; i < current_region.NumberOfPatches(); ++i) {
+			const WaterRegionPatchDesc patch{ water_region_patch.x, water_region_patch.y, WaterRegionPatchLabel(FIRST_REGION_LABEL.base() + i) };
+			VisitWaterRegionPatchCallback add_neighbour = [&neighbours, i](const WaterRegionPatchDesc &neighbour) { neighbours[i].push_back(neighbour); };
+			for (DiagDirection side : DIAGDIRECTIONS_ALL) VisitAdjacentWaterRegionPatchNeighbours(patch, side, add_neighbour);
+		}
+		current_region.SetPatchNeighbours(std::move(neighbours));
+	}
+	for (const WaterRegionPatchDesc &neighbour : current_region.GetPatchNeighbours(water_region_patch.label)) callback(neighbour);
 
 	/* Visit neighbouring water patches accessible via cross-region aqueducts */
 	if (current_region.HasCrossRegionAqueducts()) {
@@ -413,6 +494,8 @@ void VisitWaterRegionPatchNeighbours(const WaterRegionPatchDesc &water_region_pa
  */
 void AllocateWaterRegions()
 {
+	_water_region_change_counter++;
+
 	const int number_of_regions = GetWaterRegionMapSizeX() * GetWaterRegionMapSizeY();
 
 	_water_region_data.clear();
@@ -54,6 +54,7 @@ WaterRegionDesc GetWaterRegionInfo(TileIndex tile);
 WaterRegionPatchDesc GetWaterRegionPatchInfo(TileIndex tile);
 
 void InvalidateWaterRegion(TileIndex tile);
+uint64_t GetWaterRegionChangeCounter();
 
 using VisitWaterRegionPatchCallback = std::function<void(const WaterRegionPatchDesc &)>;
 void VisitWaterRegionPatchNeighbours(const WaterRegionPatchDesc &water_region_patch, VisitWaterRegionPatchCallback &callback);
@@ -13,9 +13,71 @@
 #include "../../misc/hashtable.hpp"
 #include "../../misc/binaryheap.hpp"
 
+/**
+ * Storage of nodes with stable addresses. Clearing it keeps the allocated
+ *  memory, so it can be reused without allocating again.
+ */
+template <class Titem>
+class NodeArena {
+	static constexpr size_t CHUNK_SIZE = 256; ///< Number of nodes allocated at once.
+
+	std::vector<std::unique_ptr<Titem[]>> chunks; ///< Allocated nodes.
+	size_t num_items = 0; ///< Number of nodes in use.
+
+public:
+	/** return number of nodes in use */
+	inline size_t size() const
+	{
+		return this->num_items;
+	}
+
+	/** return a node by its index */
+	inline Titem &operator[](size_t index)
+	{
+		return this->chunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+	}
+
+	/** return a node by its index */
+	inline const Titem &operator[](size_t index) const
+	{
+		return this->chunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+	}
+
+	/** return a new default initialised node */
+	inline Titem &emplace_back()
+	{
+		if (this->num_items == this->chunks.size() * CHUNK_SIZE) this->chunks.push_back(std::make_unique<Titem[]>(CHUNK_SIZE));
+		Titem &item = (*this)[this->num_items++];
+		item = Titem{};
+		return item;
+	}
+
+	/**
+	 * Forget all nodes.
+	 * @param max_kept Maximum number of nodes to keep the memory of.
+	 */
+	inline void clear(size_t max_kept)
+	{
+		this->num_items = 0;
+		if (this->chunks.size() * CHUNK_SIZE > max_kept) this->chunks.resize(max_kept / CHUNK_SIZE);
+	}
+
+	/** Helper for creating output of this array. */
+	template <class D>
+	void Dump(D &dmp) const
+	{
+		dmp.WriteValue("num_items", this->num_items);
+		for (size_t i = 0; i < this->num_items; i++) {
+			dmp.WriteStructT(fmt::format("item[{}]", i), &(*this)[i]);
+		}
+	}
+};
+
 /**
  * Hash table based node list multi-container class.
  *  Implements open list, closed list and priority queue for A-star pathfinder.
+ *  The containers are taken from a per thread pool and returned to it when the
+ *  node list is destroyed, so consecutive searches reuse the same memory.
  */
 template <class Titem, int Thash_bits_open, int Thash_bits_closed>
 class NodeList {
@@ -24,19 +86,61 @@ public:
 	using Key = typename Titem::Key;
 
 protected:
-	std::deque<Titem> items; ///< Storage of the nodes.
-	HashTable<Titem, Thash_bits_open> open_nodes; ///< Hash table of pointers to open nodes.
-	HashTable<Titem, Thash_bits_closed> closed_nodes; ///< Hash table of pointers to closed nodes.
-	CBinaryHeapT<Titem> open_queue; ///< Priority queue of pointers to open nodes.
+	static constexpr size_t MAX_KEPT_ITEMS = 16384; ///< Maximum number of nodes to keep the memory of in the pool.
+
+	/** The containers of a node list. */
+	struct Storage {
+		NodeArena<Titem> items; ///< Storage of the nodes.
+		HashTable<Titem, Thash_bits_open> open_nodes; ///< Hash table of pointers to open nodes.
+		HashTable<Titem, Thash_bits_closed> closed_nodes; ///< Hash table of pointers to closed nodes.
+		CBinaryHeapT<Titem> open_queue{2048}; ///< Priority queue of pointers to open nodes.
+	};
+
+	/** return the pool of unused containers of this thread */
+	static std::vector<std::unique_ptr<Storage>> &GetPool()
+	{
+		thread_local std::vector<std::unique_ptr<Storage>> pool;
+		return pool;
+	}
+
+	/** take containers from the pool, or make new ones when it is empty */
+	static std::unique_ptr<Storage> AcquireStorage()
+	{
+		std::vector<std::unique_ptr<Storage>> &pool = GetPool();
+		if (pool.empty()) return std::make_unique<Storage>();
+
+		std::unique_ptr<Storage> storage = std::move(pool.back());
+		pool.pop_back();
+		return storage;
+	}
+
+	std::unique_ptr<Storage> storage; ///< The containers, owned until the node list is destroyed.
+	NodeArena<Titem> &items;
+	HashTable<Titem, Thash_bits_open> &open_nodes;
+	HashTable<Titem, Thash_bits_closed> &closed_nodes;
+	CBinaryHeapT<Titem> &open_queue;
 	Titem *new_node; ///< New node under construction.
 
 public:
 	/** default constructor */
-	NodeList() : open_queue(2048)
+	NodeList() : storage(AcquireStorage()), items(storage->items), open_nodes(storage->open_nodes), closed_nodes(storage->closed_nodes), open_queue(storage->open_queue)
 	{
 		this->new_node = nullptr;
 	}
 
+	/** clear the containers and return them to the pool */
+	~NodeList()
+	{
+		this->items.clear(MAX_KEPT_ITEMS);
+		this->open_nodes.Clear();
+		this->closed_nodes.Clear();
+		this->open_queue.Clear();
+		GetPool().push_back(std::move(this->storage));
+	}
+
+	NodeList(const NodeList &) = delete;
+	NodeList &operator=(const NodeList &) = delete;
+
 	/** return number of open nodes */
 	inline int OpenCount()
 	{
@@ -52,7 +156,7 @@ public:
 	/** return the total number of nodes. */
 	inline int TotalCount()
 	{
-		return this->items.Length();
+		return static_cast<int>(this->items.size());
 	}
 
 	/** allocate new data item from items */
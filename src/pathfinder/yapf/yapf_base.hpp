@@ -13,7 +13,9 @@
 #include "../../debug.h"
 #include "../../settings_type.h"
 #include "../../misc/dbg_helpers.h"
+#include "../../framerate_type.h"
 #include "yapf_type.hpp"
+#include "yapf_stats.h"
 
 /**
  * CYapfBaseT - A-star type path finder base class.
@@ -101,6 +103,10 @@ public:
 	 */
 	inline bool FindPath(const VehicleType *v)
 	{
+		PerformanceAccumulator framerate(PFE_GL_PATHFINDER);
+		const auto start_time = std::chrono::steady_clock::now();
+		bool node_limit_reached = false;
+
 		this->vehicle = v;
 
 		for (;;) {
@@ -114,7 +120,10 @@ public:
 			}
 
 			Yapf().PfFollowNode(*best_open_node);
-			if (this->max_search_nodes != 0 && this->nodes.ClosedCount() >= this->max_search_nodes) break;
+			if (this->max_search_nodes != 0 && this->nodes.ClosedCount() >= this->max_search_nodes) {
+				node_limit_reached = true;
+				break;
+			}
 
 			this->nodes.PopOpenNode(best_open_node->GetKey());
 			this->nodes.InsertClosedNode(*best_open_node);
@@ -122,6 +131,21 @@ public:
 
 		const bool destination_found = (this->best_dest_node != nullptr);
 
+		/* Only searches for actual vehicles are counted, e.g. not those of the river builder. */
+		if constexpr (requires { VehicleType::EXPECTED_TYPE; }) {
+			YapfSearchStats search{};
+			search.searches = 1;
+			search.paths_found = destination_found ? 1 : 0;
+			search.nodes_opened = this->nodes.TotalCount();
+			search.nodes_closed = this->nodes.ClosedCount();
+			search.cache_hits = this->stats_cache_hits;
+			search.cache_misses = this->stats_cost_calcs;
+			search.node_limit_reached = node_limit_reached ? 1 : 0;
+			search.total_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+			search.time_histogram[YapfSearchStats::GetTimeBucket(search.total_time)] = 1;
+			YapfRecordSearch(VehicleType::EXPECTED_TYPE, (this->vehicle != nullptr) ? this->vehicle->owner : OWNER_NONE, search);
+		}
+
 		if (_debug_yapf_level >= 3) {
 			const UnitID veh_idx = (this->vehicle != nullptr) ? this->vehicle->unitnumber : 0;
 			const char ttc = Yapf().TransportTypeChar();
@@ -15,9 +15,15 @@
 
 /**
  * Use this function to notify YAPF that track layout (or signal configuration) has change.
- * @param tile  the tile that is changed
+ * @param tile  the tile that is changed, or INVALID_TILE when the whole map may have changed
  * @param track what piece of track is changed
  */
 void YapfNotifyTrackLayoutChange(TileIndex tile, Track track);
 
+/**
+ * Use this function to notify YAPF that the road network may have changed.
+ * @param tile the tile that is changed, or INVALID_TILE when the whole map may have changed
+ */
+void YapfNotifyRoadLayoutChange(TileIndex tile);
+
 #endif /* YAPF_CACHE_H */
@@ -36,18 +36,32 @@ public:
 };
 
 /**
- * Base class for segment cost cache providers. Contains global counter
- *  of track layout changes and static notification function called whenever
+ * Base class for segment cost cache providers. Contains the global counters
+ *  of track layout changes and static notification functions called whenever
  *  the track layout changes. It is implemented as base class because it needs
  *  to be shared between all rail YAPF types (one shared counter, one notification
  *  function.
+ *
+ * Track layout changes are tracked per block of tiles, so a segment only
+ *  becomes invalid when one of the blocks it passes through has changed.
  */
 struct CSegmentCostCacheBase {
-	static int   s_rail_change_counter;
+	static constexpr uint BLOCK_BITS = 4; ///< Size of the blocks of tiles the changes are tracked for, as power of 2.
 
-	static void NotifyTrackLayoutChange(TileIndex, Track)
+	static uint64_t s_rail_change_counter; ///< Number of track layout changes so far.
+	static uint64_t s_last_full_change; ///< Value of #s_rail_change_counter when the whole map last changed.
+	static uint64_t s_reservation_counter; ///< Number of path reservations so far.
+	static std::vector<uint64_t> s_block_last_change; ///< Value of #s_rail_change_counter when each block last changed.
+
+	static uint GetBlock(TileIndex tile);
+	static bool IsUpToDate(uint64_t change_counter, std::span<const uint> blocks);
+
+	static void NotifyTrackLayoutChange(TileIndex tile, Track track);
+
+	/** Notify that a path has been reserved, which changes the result of track followers that mask reserved tracks. */
+	static void NotifyReservationChange()
 	{
-		s_rail_change_counter++;
+		s_reservation_counter++;
 	}
 };
 
@@ -87,6 +101,10 @@ struct CSegmentCostCacheT : public CSegmentCostCacheBase {
 			*found = false;
 			item = &this->heap.emplace_back(key);
 			this->map.Push(*item);
+		} else if (!IsUpToDate(item->change_counter, item->blocks)) {
+			/* The track layout of the segment has changed, so it has to be calculated again. */
+			*found = false;
+			item->Reset();
 		} else {
 			*found = true;
 		}
@@ -124,12 +142,18 @@ protected:
 
 	static inline Cache &stGetGlobalCache()
 	{
-		static int last_rail_change_counter = 0;
+		static uint64_t last_full_change = 0;
+		static uint64_t last_reservation_counter = 0;
 		static Cache C;
 
-		/* delete the cache sometimes... */
-		if (last_rail_change_counter != Cache::s_rail_change_counter) {
-			last_rail_change_counter = Cache::s_rail_change_counter;
+		/* delete the cache when the whole map changed; changes of parts of it are checked per segment */
+		bool flush = last_full_change != Cache::s_last_full_change;
+		/* segments of followers that mask reserved tracks depend on all reservations */
+		if (Types::TrackFollower::DoTrackMasking() && last_reservation_counter != Cache::s_reservation_counter) flush = true;
+
+		if (flush) {
+			last_full_change = Cache::s_last_full_change;
+			last_reservation_counter = Cache::s_reservation_counter;
 			C.Flush();
 		}
 		return C;
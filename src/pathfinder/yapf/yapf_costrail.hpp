@@ -283,6 +283,7 @@ public:
 		/* Do we already have a cached segment? */
 		CachedData &segment = *n.segment;
 		bool is_cached_segment = (segment.cost >= 0);
+		if (!is_cached_segment) segment.BeginCalculation(CSegmentCostCacheBase::s_rail_change_counter);
 
 		int parent_cost = has_parent ? n.parent->cost : 0;
 
@@ -373,6 +374,13 @@ public:
 
 no_entry_cost: // jump here at the beginning if the node has no parent (it is the first node)
 
+			/* Remember where the segment goes, so it is only invalidated when the track there changes. */
+			segment.AddTile(cur.tile);
+			if (follower->is_station) {
+				TileIndexDiff diff = TileOffsByDiagDir(ReverseDiagDir(follower->exitdir));
+				for (int i = 1; i <= follower->tiles_skipped; i++) segment.AddTile(TileAdd(cur.tile, diff * i));
+			}
+
 			/* All other tile costs will be calculated here. */
 			segment_cost += Yapf().OneTileCost(cur.tile, cur.td);
 
@@ -13,6 +13,7 @@
 #include "../../misc/dbg_helpers.h"
 #include "../../train.h"
 #include "nodelist.hpp"
+#include "yapf_costcache.hpp"
 #include "yapf_node.hpp"
 #include "yapf_type.hpp"
 
@@ -73,10 +74,45 @@ struct CYapfRailSegment {
 	TileIndex last_signal_tile = INVALID_TILE;
 	Trackdir last_signal_td = INVALID_TRACKDIR;
 	EndSegmentReasons end_segment_reason{};
+	uint64_t change_counter = 0; ///< Track layout change counter when the segment was calculated.
+	std::vector<uint> blocks; ///< Blocks of tiles the segment passes through, see CSegmentCostCacheBase.
 	CYapfRailSegment *hash_next = nullptr;
 
 	inline CYapfRailSegment(const CYapfRailSegmentKey &key) : key(key) {}
 
+	/** Forget the calculated segment, keeping it in the cache it is part of. */
+	inline void Reset()
+	{
+		this->last_tile = INVALID_TILE;
+		this->last_td = INVALID_TRACKDIR;
+		this->cost = -1;
+		this->last_signal_tile = INVALID_TILE;
+		this->last_signal_td = INVALID_TRACKDIR;
+		this->end_segment_reason = {};
+		this->change_counter = 0;
+		this->blocks.clear();
+	}
+
+	/**
+	 * Start calculating the segment.
+	 * @param change_counter The current track layout change counter.
+	 */
+	inline void BeginCalculation(uint64_t change_counter)
+	{
+		this->change_counter = change_counter;
+		this->blocks.clear();
+	}
+
+	/**
+	 * Record that the segment passes through a tile.
+	 * @param tile The tile.
+	 */
+	inline void AddTile(TileIndex tile)
+	{
+		uint block = CSegmentCostCacheBase::GetBlock(tile);
+		if (std::ranges::find(this->blocks, block) == this->blocks.end()) this->blocks.push_back(block);
+	}
+
 	inline const Key &GetKey() const
 	{
 		return this->key;
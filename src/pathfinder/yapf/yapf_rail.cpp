@@ -199,7 +199,7 @@ public:
 		if (target != nullptr) target->okay = true;
 
 		if (Yapf().CanUseGlobalCache(*this->res_dest_node)) {
-			YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+			CSegmentCostCacheBase::NotifyReservationChange();
 		}
 
 		return true;
@@ -414,19 +414,22 @@ public:
 		return 't';
 	}
 
-	static Trackdir stChooseRailTrack(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest)
+	static Trackdir stChooseRailTrack(const Train *v, TileIndex, DiagDirection, TrackBits, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest)
 	{
+		/* Following the reservation is linear in its length, so do it once for all searches below. */
+		PBSTileInfo origin = FollowTrainReservation(v);
+
 		/* create pathfinder instance */
 		Tpf pf1;
 		Trackdir result1;
 
 		if (_debug_desync_level < 2) {
-			result1 = pf1.ChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest);
+			result1 = pf1.ChooseRailTrack(v, origin, path_found, reserve_track, target, dest);
 		} else {
-			result1 = pf1.ChooseRailTrack(v, tile, enterdir, tracks, path_found, false, nullptr, nullptr);
+			result1 = pf1.ChooseRailTrack(v, origin, path_found, false, nullptr, nullptr);
 			Tpf pf2;
 			pf2.DisableCache(true);
-			Trackdir result2 = pf2.ChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest);
+			Trackdir result2 = pf2.ChooseRailTrack(v, origin, path_found, reserve_track, target, dest);
 			if (result1 != result2) {
 				Debug(desync, 2, "warning: ChooseRailTrack cache mismatch: {} vs {}", result1, result2);
 				DumpState(pf1, pf2);
@@ -436,13 +439,22 @@ public:
 		return result1;
 	}
 
-	inline Trackdir ChooseRailTrack(const Train *v, TileIndex, DiagDirection, TrackBits, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest)
+	/**
+	 * Find the best track for a train to take from the end of its reservation.
+	 * @param v The train.
+	 * @param origin The end of the reservation of the train, see #FollowTrainReservation.
+	 * @param[out] path_found Whether a path to the destination was found.
+	 * @param reserve_track Whether to reserve the found path.
+	 * @param[out] target The end of the reserved path, if any.
+	 * @param[out] dest The destination tile of the found path, if any.
+	 * @return The trackdir to take from the origin.
+	 */
+	inline Trackdir ChooseRailTrack(const Train *v, const PBSTileInfo &origin, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest)
 	{
 		if (target != nullptr) target->tile = INVALID_TILE;
 		if (dest != nullptr) *dest = INVALID_TILE;
 
 		/* set origin and destination nodes */
-		PBSTileInfo origin = FollowTrainReservation(v);
 		Yapf().SetOrigin(origin.tile, origin.trackdir, INVALID_TILE, INVALID_TRACKDIR, 1);
 		Yapf().SetTreatFirstRedTwoWaySignalAsEOL(true);
 		Yapf().SetDestination(v);
@@ -659,8 +671,66 @@ bool YapfTrainFindNearestSafeTile(const Train *v, TileIndex tile, Trackdir td, b
 		: CYapfAnySafeTileRail::stFindNearestSafeTile(v, tile, td, override_railtype);
 }
 
-/** if any track changes, this counter is incremented - that will invalidate segment cost cache */
-int CSegmentCostCacheBase::s_rail_change_counter = 0;
+/** if any track changes, this counter is incremented - that will invalidate segments cached before */
+uint64_t CSegmentCostCacheBase::s_rail_change_counter = 0;
+uint64_t CSegmentCostCacheBase::s_last_full_change = 0;
+uint64_t CSegmentCostCacheBase::s_reservation_counter = 0;
+std::vector<uint64_t> CSegmentCostCacheBase::s_block_last_change;
+
+/**
+ * Get the block of tiles the changes of a tile are tracked in.
+ * @param tile The tile.
+ * @return The index of the block.
+ */
+uint CSegmentCostCacheBase::GetBlock(TileIndex tile)
+{
+	return (TileY(tile) >> BLOCK_BITS) * (Map::SizeX() >> BLOCK_BITS) + (TileX(tile) >> BLOCK_BITS);
+}
+
+/**
+ * Check whether a cached segment is still valid.
+ * @param change_counter Value of #s_rail_change_counter when the segment was calculated.
+ * @param blocks The blocks the segment passes through.
+ * @return True if none of the blocks changed since the segment was calculated.
+ */
+bool CSegmentCostCacheBase::IsUpToDate(uint64_t change_counter, std::span<const uint> blocks)
+{
+	if (change_counter < s_last_full_change) return false;
+	for (uint block : blocks) {
+		if (block >= s_block_last_change.size() || s_block_last_change[block] > change_counter) return false;
+	}
+	return true;
+}
+
+/**
+ * Notify that the track layout changed.
+ * Besides the block of the tile itself, this marks the blocks next to it and,
+ * for tunnels and bridges, around the other end as changed, as segments ending
+ * just before the tile may now continue or end differently.
+ * @param tile The changed tile, or INVALID_TILE when the whole map may have changed.
+ */
+void CSegmentCostCacheBase::NotifyTrackLayoutChange(TileIndex tile, Track)
+{
+	s_rail_change_counter++;
+
+	const size_t num_blocks = (Map::SizeX() >> BLOCK_BITS) * (Map::SizeY() >> BLOCK_BITS);
+	if (tile == INVALID_TILE || s_block_last_change.size() != num_blocks) {
+		s_block_last_change.assign(num_blocks, 0);
+		s_last_full_change = s_rail_change_counter;
+		return;
+	}
+
+	auto mark_around = [](TileIndex tile) {
+		s_block_last_change[GetBlock(tile)] = s_rail_change_counter;
+		for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
+			TileIndex adjacent_tile = AddTileIndexDiffCWrap(tile, TileIndexDiffCByDiagDir(dir));
+			if (adjacent_tile != INVALID_TILE) s_block_last_change[GetBlock(adjacent_tile)] = s_rail_change_counter;
+		}
+	};
+
+	mark_around(tile);
+	if (IsTileType(tile, MP_TUNNELBRIDGE)) mark_around(GetOtherTunnelBridgeEnd(tile));
+}
 
 void YapfNotifyTrackLayoutChange(TileIndex tile, Track track)
 {
@@ -10,6 +10,7 @@
 #include "../../stdafx.h"
 #include "yapf.hpp"
 #include "yapf_node_road.hpp"
+#include "yapf_road_distance.h"
 #include "../../roadstop_base.h"
 
 #include "../../safeguards.h"
@@ -233,6 +234,7 @@ protected:
 	StationID dest_station;
 	StationType station_type;
 	bool non_artic;
+	const RoadDistanceField *distance_field = nullptr; ///< Lower bounds of the cost towards the destination station, if any.
 
 public:
 	void SetDestination(const RoadVehicle *v)
@@ -243,14 +245,17 @@ public:
 			this->dest_tile = CalcClosestStationTile(this->dest_station, v->tile, this->station_type);
 			this->non_artic = !v->HasArticulatedPart();
 			this->dest_trackdirs = INVALID_TRACKDIR_BIT;
+			this->distance_field = YapfRoadGetDistanceField(v, this->dest_station, this->station_type, this->non_artic);
 		} else if (v->current_order.IsType(OT_GOTO_WAYPOINT)) {
 			this->dest_station = v->current_order.GetDestination().ToStationID();
 			this->station_type = StationType::RoadWaypoint;
 			this->dest_tile = CalcClosestStationTile(this->dest_station, v->tile, this->station_type);
 			this->non_artic = !v->HasArticulatedPart();
 			this->dest_trackdirs = INVALID_TRACKDIR_BIT;
+			this->distance_field = YapfRoadGetDistanceField(v, this->dest_station, this->station_type, this->non_artic);
 		} else {
 			this->dest_station = StationID::Invalid();
+			this->distance_field = nullptr;
 			this->dest_tile = v->dest_tile;
 			this->dest_trackdirs = TrackStatusToTrackdirBits(GetTileTrackStatus(v->dest_tile, TRANSPORT_ROAD, GetRoadTramType(v->roadtype)));
 		}
@@ -298,7 +303,10 @@ public:
 			return true;
 		}
 
-		n.estimate = n.cost + OctileDistanceCost(n.segment_last_tile, n.segment_last_td, this->dest_tile);
+		int distance = OctileDistanceCost(n.segment_last_tile, n.segment_last_td, this->dest_tile);
+		/* The shared distance field gives a better, still optimistic, estimate. */
+		if (this->distance_field != nullptr) distance = std::max(distance, this->distance_field->GetLowerBound(n.segment_last_tile, n.segment_last_td));
+		n.estimate = n.cost + distance;
 		assert(n.estimate >= n.parent->estimate);
 		return true;
 	}
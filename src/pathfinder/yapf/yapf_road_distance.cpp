@@ -0,0 +1,243 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/**
+ * @file yapf_road_distance.cpp Distance fields towards road stops, shared by the road vehicles heading there.
+ *
+ * A field is a Dijkstra search backwards from all tiles of the destination,
+ * using the same road follower as the road vehicle pathfinder. Its distances
+ * only count the base tile costs and the penalties for curves, level crossings
+ * and drive-through road stops, which are part of every path, so they are a
+ * lower bound of the real path cost and can serve as estimate for the A* search.
+ * The search is stopped after a fixed number of nodes; every trackdir not
+ * reached by then is at least as far away as the last one that was reached.
+ *
+ * A field only depends on the tiles the search reached and their neighbours,
+ * so changing a road tile only drops the fields around it. Every field is thus
+ * the same as a freshly made one, which keeps the paths of clients that join
+ * later, and start without any fields, the same as those of the server.
+ */
+
+#include "../../stdafx.h"
+#include "../../roadveh.h"
+#include "../../roadstop_base.h"
+#include "../../base_station_base.h"
+#include "../../settings_type.h"
+#include "../follow_track.hpp"
+#include "../pathfinder_func.h"
+#include "../pathfinder_type.h"
+#include "yapf_cache.h"
+#include "yapf_road_distance.h"
+#include <queue>
+
+#include "../../safeguards.h"
+
+static constexpr size_t MAX_DISTANCE_FIELDS = 32; ///< Maximum number of fields to keep.
+static constexpr size_t MAX_DISTANCE_FIELD_NODES = 16384; ///< Maximum number of trackdirs in a field.
+
+/** Everything a field depends on besides the road network. */
+struct RoadDistanceFieldKey {
+	StationID station; ///< Destination station.
+	StationType station_type; ///< Type of road stop at the destination.
+	bool non_artic; ///< Whether bay road stops are usable.
+	RoadType roadtype; ///< Road type of the vehicles.
+	RoadTypes compatible_roadtypes; ///< Road types the vehicles can drive on.
+	Owner owner; ///< Owner of the vehicles, for entering depots.
+	uint32_t curve_penalty; ///< Penalty for curves the field was made with.
+	uint32_t crossing_penalty; ///< Penalty for level crossings the field was made with.
+	uint32_t stop_penalty; ///< Penalty for drive-through road stops the field was made with.
+
+	bool operator==(const RoadDistanceFieldKey &other) const = default;
+};
+
+/** A field and the destination it belongs to. */
+struct CachedRoadDistanceField {
+	RoadDistanceFieldKey key;
+	RoadDistanceField field;
+	TileArea area; ///< The tiles the field depends on.
+};
+
+/** The fields, the most recently used one last. */
+static std::vector<std::unique_ptr<CachedRoadDistanceField>> _road_distance_fields;
+
+/**
+ * Get the key of a road trackdir within a field.
+ * @param tile The tile.
+ * @param td The trackdir.
+ * @return The key.
+ */
+static inline uint32_t GetDistanceKey(TileIndex tile, Trackdir td)
+{
+	return tile.base() << 4 | td;
+}
+
+/**
+ * Get the lower bound of the remaining path cost from a trackdir.
+ * @param tile The tile.
+ * @param td The trackdir.
+ * @return The lower bound.
+ */
+int RoadDistanceField::GetLowerBound(TileIndex tile, Trackdir td) const
+{
+	const uint32_t key = GetDistanceKey(tile, td);
+	auto it = std::ranges::lower_bound(this->distances, key, {}, &std::pair<uint32_t, int>::first);
+	if (it != this->distances.end() && it->first == key) return it->second;
+	return this->horizon;
+}
+
+/**
+ * The cost of a tile that is part of every path through it.
+ * This is RoadVehicle pathfinder's tile cost without the penalties for occupied road stops.
+ * @param key The key of the field, for the penalties.
+ * @param tile The tile.
+ * @param td The trackdir through the tile.
+ * @return The cost.
+ */
+static int StaticTileCost(const RoadDistanceFieldKey &key, TileIndex tile, Trackdir td)
+{
+	if (!IsDiagonalTrackdir(td)) return YAPF_TILE_CORNER_LENGTH + key.curve_penalty;
+
+	int cost = YAPF_TILE_LENGTH;
+	if (IsLevelCrossingTile(tile)) cost += key.crossing_penalty;
+	if (IsTileType(tile, MP_STATION) && !IsRoadWaypoint(tile) && IsDriveThroughStopTile(tile)) cost += key.stop_penalty;
+	return cost;
+}
+
+/**
+ * Call a function for every trackdir a road vehicle can drive to a trackdir from.
+ * A vehicle can arrive from the same tile when it reverses, else from the tile it
+ * entered the tile from, or from the other end of a tunnel or bridge.
+ * @param follower The follower of the vehicles.
+ * @param rtt The road tram type of the vehicles.
+ * @param tile The tile to arrive at.
+ * @param td The trackdir to arrive at.
+ * @param visit The function to call with the tile and trackdir to arrive from.
+ */
+template <typename Tvisit>
+static void VisitRoadPredecessors(CFollowTrackRoad &follower, RoadTramType rtt, TileIndex tile, Trackdir td, Tvisit visit)
+{
+	const DiagDirection from = TrackdirToExitdir(ReverseTrackdir(td));
+	TileIndex from_tile;
+	if (IsTileType(tile, MP_TUNNELBRIDGE) && GetTunnelBridgeDirection(tile) == from) {
+		from_tile = GetOtherTunnelBridgeEnd(tile);
+	} else {
+		from_tile = TileAddByDiagDir(tile, from);
+	}
+
+	for (TileIndex candidate : {tile, from_tile}) {
+		if (!IsValidTile(candidate)) continue;
+		for (Trackdir candidate_td : SetTrackdirBitIterator(GetTrackdirBitsForRoad(candidate, rtt))) {
+			if (follower.Follow(candidate, candidate_td) && follower.new_tile == tile && HasTrackdir(follower.new_td_bits, td)) {
+				visit(candidate, candidate_td);
+			}
+		}
+	}
+}
+
+/**
+ * Fill a distance field.
+ * @param v A vehicle matching the key of the field, for the road follower.
+ * @param key The key of the field.
+ * @param field The field to fill.
+ * @param[out] area The tiles the field depends on.
+ */
+static void FillRoadDistanceField(const RoadVehicle *v, const RoadDistanceFieldKey &key, RoadDistanceField &field, TileArea &area)
+{
+	const RoadTramType rtt = GetRoadTramType(key.roadtype);
+	CFollowTrackRoad follower{v};
+
+	/* Ordering on the key as well keeps the truncated field independent of the order of insertion. */
+	using QueueItem = std::pair<int, uint32_t>;
+	std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+	static std::unordered_map<uint32_t, int> distances;
+	distances.clear();
+
+	auto push = [&](TileIndex tile, Trackdir td, int distance) {
+		auto [it, inserted] = distances.try_emplace(GetDistanceKey(tile, td), distance);
+		if (!inserted) {
+			if (it->second <= distance) return;
+			it->second = distance;
+		} else {
+			area.Add(tile);
+		}
+		queue.emplace(distance, it->first);
+	};
+
+	const BaseStation *st = BaseStation::GetIfValid(key.station);
+	if (st == nullptr) return;
+	for (TileIndex tile : st->GetTileArea(key.station_type)) {
+		if (!IsTileType(tile, MP_STATION) || GetStationIndex(tile) != key.station || GetStationType(tile) != key.station_type) continue;
+		if (!key.non_artic && !IsDriveThroughStopTile(tile)) continue;
+		for (Trackdir td : SetTrackdirBitIterator(GetTrackdirBitsForRoad(tile, rtt))) push(tile, td, 0);
+	}
+
+	std::vector<std::pair<uint32_t, int>> settled;
+	int horizon = 0;
+	while (!queue.empty() && settled.size() < MAX_DISTANCE_FIELD_NODES) {
+		auto [distance, state] = queue.top();
+		queue.pop();
+		if (distances[state] != distance) continue;
+
+		settled.emplace_back(state, distance);
+		horizon = distance;
+
+		const TileIndex tile{state >> 4};
+		const Trackdir td = static_cast<Trackdir>(state & 0xF);
+		/* Driving from the predecessor to this trackdir costs this tile. */
+		const int cost = distance + StaticTileCost(key, tile, td);
+		VisitRoadPredecessors(follower, rtt, tile, td, [&](TileIndex from_tile, Trackdir from_td) { push(from_tile, from_td, cost); });
+	}
+
+	std::ranges::sort(settled);
+	field.distances = std::move(settled);
+	field.horizon = horizon;
+
+	/* The trackdirs a reached trackdir can be driven to from are looked for on the neighbouring tiles. */
+	if (area.tile != INVALID_TILE) area.Expand(1);
+}
+
+/**
+ * Get the distance field towards a road stop for a road vehicle.
+ * The field is shared by all vehicles of the same road type and owner heading
+ * to the same road stops, and kept until the road network changes.
+ * @param v The vehicle.
+ * @param station The destination station or waypoint.
+ * @param station_type The type of road stop at the destination.
+ * @param non_artic Whether the vehicle can use bay road stops.
+ * @return The field; valid until the next call.
+ */
+const RoadDistanceField *YapfRoadGetDistanceField(const RoadVehicle *v, StationID station, StationType station_type, bool non_artic)
+{
+	const auto &settings = _settings_game.pf.yapf;
+	const RoadDistanceFieldKey key{station, station_type, non_artic, v->roadtype, v->compatible_roadtypes, v->owner, settings.road_curve_penalty, settings.road_crossing_penalty, settings.road_stop_penalty};
+
+	auto it = std::ranges::find_if(_road_distance_fields, [&key](const auto &cached) { return cached->key == key; });
+	if (it != _road_distance_fields.end()) {
+		/* Move it to the back, as most recently used. */
+		std::rotate(it, it + 1, _road_distance_fields.end());
+		return &_road_distance_fields.back()->field;
+	}
+
+	if (_road_distance_fields.size() >= MAX_DISTANCE_FIELDS) _road_distance_fields.erase(_road_distance_fields.begin());
+	auto &cached = _road_distance_fields.emplace_back(std::make_unique<CachedRoadDistanceField>(key));
+	FillRoadDistanceField(v, key, cached->field, cached->area);
+	return &cached->field;
+}
+
+void YapfNotifyRoadLayoutChange(TileIndex tile)
+{
+	if (tile == INVALID_TILE) {
+		_road_distance_fields.clear();
+		return;
+	}
+
+	/* A new road stop of a station can be outside of the area of the fields towards it. */
+	const StationID station = IsTileType(tile, MP_STATION) ? GetStationIndex(tile) : StationID::Invalid();
+	std::erase_if(_road_distance_fields, [tile, station](const auto &cached) {
+		return cached->key.station == station || cached->area.Contains(tile);
+	});
+}
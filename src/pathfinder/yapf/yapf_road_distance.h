@@ -0,0 +1,33 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file yapf_road_distance.h Distance fields towards road stops, shared by the road vehicles heading there. */
+
+#ifndef YAPF_ROAD_DISTANCE_H
+#define YAPF_ROAD_DISTANCE_H
+
+#include "../../station_type.h"
+#include "../../tile_type.h"
+#include "../../track_type.h"
+
+struct RoadVehicle;
+
+/**
+ * Lower bounds of the remaining path cost from road trackdirs to a destination.
+ * Only the costs that do not change while vehicles drive are counted, so the
+ * bounds remain valid until the road network changes.
+ */
+struct RoadDistanceField {
+	std::vector<std::pair<uint32_t, int>> distances; ///< Sorted (tile << 4 | trackdir) and their lower bound.
+	int horizon = 0; ///< Lower bound for the trackdirs that are not in #distances.
+
+	int GetLowerBound(TileIndex tile, Trackdir td) const;
+};
+
+const RoadDistanceField *YapfRoadGetDistanceField(const RoadVehicle *v, StationID station, StationType station_type, bool non_artic);
+
+#endif /* YAPF_ROAD_DISTANCE_H */
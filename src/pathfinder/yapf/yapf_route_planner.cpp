@@ -0,0 +1,275 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file yapf_route_planner.cpp Pathfinder for planning new roads and railways. */
+
+#include "../../stdafx.h"
+
+#include "../../bridge.h"
+#include "../../command_func.h"
+#include "../../company_func.h"
+#include "../../rail.h"
+#include "../../rail_map.h"
+#include "../../road_map.h"
+#include "../../tunnelbridge_cmd.h"
+#include "yapf.hpp"
+#include "yapf_route_planner.h"
+
+#include "../../safeguards.h"
+
+static const int ROUTE_TILE_COST = 100; ///< Cost of a new piece of road or track.
+static const int ROUTE_REUSE_COST = 50; ///< Cost of a tile with usable road or track.
+static const int ROUTE_SLOPE_COST = 100; ///< Extra cost of a sloped tile.
+static const int ROUTE_CURVE_COST = 20; ///< Extra cost of a curve.
+static const int ROUTE_BRIDGE_COST = 300; ///< Cost per tile of a bridge, including its heads.
+
+/* Route planner pathfinder node. */
+struct YapfRoutePlannerNode : CYapfNodeT<CYapfNodeKeyTrackDir, YapfRoutePlannerNode> {
+	int step_cost; ///< Cost of reaching this node from its parent.
+	bool bridge; ///< Whether this node is reached by a bridge from its parent.
+	BridgeType bridge_type; ///< Type of that bridge.
+};
+
+/* Route planner pathfinder node list. */
+using RoutePlannerNodeList = NodeList<YapfRoutePlannerNode, 8, 10>;
+
+/* We don't need a follower but YAPF requires one. */
+struct RoutePlannerFollower {};
+
+/* We don't need a vehicle but YAPF requires one. */
+struct RoutePlannerVehicle : Vehicle {};
+
+class YapfRoutePlanner;
+
+/* Types struct required for YAPF components. */
+struct RoutePlannerTypes {
+	using Tpf = YapfRoutePlanner;
+	using TrackFollower = RoutePlannerFollower;
+	using NodeList = RoutePlannerNodeList;
+	using VehicleType = RoutePlannerVehicle;
+};
+
+/**
+ * Route planner pathfinder implementation.
+ * Every node is a tile with the trackdir of the road or track piece that would be built on it,
+ * so curves and, for railways, 90 degree turns follow from consecutive nodes.
+ */
+class YapfRoutePlanner
+	: public CYapfBaseT<RoutePlannerTypes>
+	, public CYapfSegmentCostCacheNoneT<RoutePlannerTypes>
+{
+public:
+	using Node = RoutePlannerTypes::NodeList::Item;
+	using Key = Node::Key;
+
+protected:
+	TileIndex start_tile; ///< Start tile of the route.
+	TileIndex end_tile; ///< End tile of the route.
+	TransportType transport_type; ///< #TRANSPORT_ROAD or #TRANSPORT_RAIL.
+	uint8_t road_rail_type; ///< The road or rail type to build.
+
+	inline YapfRoutePlanner &Yapf()
+	{
+		return *static_cast<YapfRoutePlanner *>(this);
+	}
+
+	/**
+	 * Get the cost of planning a piece of road or track on a tile.
+	 * @param tile The tile.
+	 * @param td The trackdir of the piece.
+	 * @return The cost, or -1 when nothing can be built on the tile.
+	 */
+	inline int GetTileCost(TileIndex tile, Trackdir td) const
+	{
+		int cost = IsDiagonalTrackdir(td) ? 0 : ROUTE_CURVE_COST;
+		if (GetTileSlope(tile) != SLOPE_FLAT) cost += ROUTE_SLOPE_COST;
+
+		/* Whatever is there, the route has to end at the requested tiles. */
+		if (tile == this->start_tile || tile == this->end_tile) return cost + ROUTE_TILE_COST;
+
+		switch (GetTileType(tile)) {
+			case MP_CLEAR:
+			case MP_TREES:
+				if (IsSteepSlope(GetTileSlope(tile))) return -1;
+				return cost + ROUTE_TILE_COST;
+
+			case MP_ROAD: {
+				if (this->transport_type != TRANSPORT_ROAD || !IsNormalRoad(tile)) return -1;
+				RoadType roadtype = static_cast<RoadType>(this->road_rail_type);
+				RoadTramType rtt = GetRoadTramType(roadtype);
+				if (HasTileRoadType(tile, rtt)) {
+					if (GetRoadType(tile, rtt) != roadtype) return -1;
+					Owner owner = GetRoadOwner(tile, rtt);
+					if (owner != _current_company && owner != OWNER_TOWN && owner != OWNER_NONE) return -1;
+				}
+				return cost + ROUTE_REUSE_COST;
+			}
+
+			case MP_RAILWAY:
+				/* Only follow existing track; adding pieces could conflict with signals or other track. */
+				if (this->transport_type != TRANSPORT_RAIL || !IsPlainRail(tile)) return -1;
+				if (GetTileOwner(tile) != _current_company || GetRailType(tile) != static_cast<RailType>(this->road_rail_type)) return -1;
+				if (!HasTrack(tile, TrackdirToTrack(td))) return -1;
+				return cost + ROUTE_REUSE_COST;
+
+			default:
+				return -1;
+		}
+	}
+
+	/**
+	 * Get the cheapest bridge type that can have the given length.
+	 * @param length Length of the bridge, without its heads.
+	 * @return The bridge type, or #MAX_BRIDGES when there is none.
+	 */
+	static BridgeType GetCheapestBridgeType(uint length)
+	{
+		BridgeType best = MAX_BRIDGES;
+		for (BridgeType type = 0; type < MAX_BRIDGES; type++) {
+			if (CheckBridgeAvailability(type, length).Failed()) continue;
+			if (best == MAX_BRIDGES || GetBridgeSpec(type)->price < GetBridgeSpec(best)->price) best = type;
+		}
+		return best;
+	}
+
+	/**
+	 * Add the node at the far end of the shortest bridge that can be built from a tile.
+	 * @param old_node The node of the tile with the first bridge head.
+	 * @param dir The direction of the bridge.
+	 */
+	void FollowBridge(Node &old_node, DiagDirection dir)
+	{
+		TileIndex tile = old_node.GetTile() + TileOffsByDiagDir(dir);
+		for (uint length = 1; length <= _settings_game.construction.max_bridge_length; length++) {
+			tile += TileOffsByDiagDir(dir);
+			/* The void border of the map stops the search before it can wrap around. */
+			if (!IsValidTile(tile)) return;
+			if (tile != this->end_tile && !IsTileType(tile, MP_CLEAR) && !IsTileType(tile, MP_TREES)) continue;
+
+			BridgeType type = GetCheapestBridgeType(length);
+			if (type == MAX_BRIDGES) continue;
+			if (Command<CMD_BUILD_BRIDGE>::Do({}, tile, old_node.GetTile(), this->transport_type, type, this->road_rail_type).Failed()) continue;
+
+			Node &node = Yapf().CreateNewNode();
+			node.Set(&old_node, tile, DiagDirToDiagTrackdir(dir), false);
+			node.step_cost = ROUTE_BRIDGE_COST * (length + 1);
+			node.bridge = true;
+			node.bridge_type = type;
+			Yapf().AddNewNode(node, RoutePlannerFollower{});
+			return;
+		}
+	}
+
+public:
+	YapfRoutePlanner(TileIndex start_tile, TileIndex end_tile, TransportType transport_type, uint8_t road_rail_type, int max_nodes)
+	{
+		this->start_tile = start_tile;
+		this->end_tile = end_tile;
+		this->transport_type = transport_type;
+		this->road_rail_type = road_rail_type;
+		this->max_search_nodes = max_nodes;
+
+		for (DiagDirection d = DIAGDIR_BEGIN; d < DIAGDIR_END; ++d) {
+			Node &node = Yapf().CreateNewNode();
+			node.Set(nullptr, start_tile, DiagDirToDiagTrackdir(d), false);
+			node.step_cost = 0;
+			node.bridge = false;
+			Yapf().AddStartupNode(node);
+		}
+	}
+
+	inline bool PfDetectDestination(Node &n) const
+	{
+		return n.GetTile() == this->end_tile;
+	}
+
+	inline bool PfCalcCost(Node &n, const RoutePlannerFollower *)
+	{
+		n.cost = n.parent->cost + n.step_cost;
+		return true;
+	}
+
+	inline bool PfCalcEstimate(Node &n)
+	{
+		n.estimate = n.cost + ROUTE_REUSE_COST * DistanceManhattan(this->end_tile, n.GetTile());
+		return true;
+	}
+
+	inline void PfFollowNode(Node &old_node)
+	{
+		Trackdir old_td = old_node.GetTrackdir();
+		DiagDirection exitdir = TrackdirToExitdir(old_td);
+		TileIndex tile = old_node.GetTile() + TileOffsByDiagDir(exitdir);
+		if (!IsValidTile(tile)) return;
+
+		TrackdirBits trackdirs = DiagdirReachesTrackdirs(exitdir);
+		if (this->transport_type == TRANSPORT_RAIL) {
+			RailType railtype = static_cast<RailType>(this->road_rail_type);
+			if (Rail90DegTurnDisallowed(railtype, railtype)) trackdirs &= ~TrackdirCrossesTrackdirs(old_td);
+		}
+
+		for (Trackdir td : SetTrackdirBitIterator(trackdirs)) {
+			int cost = this->GetTileCost(tile, td);
+			if (cost < 0) continue;
+
+			Node &node = Yapf().CreateNewNode();
+			node.Set(&old_node, tile, td, false);
+			node.step_cost = cost;
+			node.bridge = false;
+			Yapf().AddNewNode(node, RoutePlannerFollower{});
+		}
+
+		/* Bridge over whatever blocks the way straight on, starting from a tile a bridge head can be built on. */
+		if (old_node.bridge || !IsDiagonalTrackdir(old_td)) return;
+		if (!IsTileType(old_node.GetTile(), MP_CLEAR) && !IsTileType(old_node.GetTile(), MP_TREES)) return;
+		if (this->GetTileCost(tile, DiagDirToDiagTrackdir(exitdir)) >= 0) return;
+		this->FollowBridge(old_node, exitdir);
+	}
+
+	inline char TransportTypeChar() const
+	{
+		return '+';
+	}
+
+	/**
+	 * Get the planned route after a successful search.
+	 * @param route The route to fill.
+	 */
+	void GetRoute(PlannedRoute &route)
+	{
+		route.tiles.clear();
+		for (Node *node = this->GetBestNode(); node != nullptr; node = node->parent) {
+			route.tiles.push_back({node->GetTile(), node->bridge, node->bridge ? node->bridge_type : 0});
+		}
+		std::reverse(route.tiles.begin(), route.tiles.end());
+		route.cost = this->GetBestNode()->cost;
+		route.nodes = this->nodes.ClosedCount();
+	}
+};
+
+/**
+ * Plan a road or railway between two tiles for the current company.
+ * The route goes over clear land and trees, and reuses roads and track of the same type
+ * that can be built on; water, buildings and other infrastructure are crossed with the
+ * cheapest bridge that can be built. Slopes and curves make a route more expensive, and
+ * railways avoid 90 degree turns when trains may not take them.
+ * @param start_tile First tile of the route.
+ * @param end_tile Last tile of the route.
+ * @param transport_type #TRANSPORT_ROAD or #TRANSPORT_RAIL.
+ * @param road_rail_type The road or rail type to build.
+ * @param max_nodes Maximum number of nodes to visit, 0 for no limit.
+ * @param[out] route The planned route, when one is found.
+ * @return Whether a route was found.
+ */
+bool YapfPlanRoute(TileIndex start_tile, TileIndex end_tile, TransportType transport_type, uint8_t road_rail_type, int max_nodes, PlannedRoute &route)
+{
+	YapfRoutePlanner pf(start_tile, end_tile, transport_type, road_rail_type, max_nodes);
+	if (!pf.FindPath(nullptr)) return false;
+
+	pf.GetRoute(route);
+	return true;
+}
@@ -0,0 +1,33 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file yapf_route_planner.h Pathfinder for planning new roads and railways. */
+
+#ifndef YAPF_ROUTE_PLANNER_H
+#define YAPF_ROUTE_PLANNER_H
+
+#include "../../tile_type.h"
+#include "../../transport_type.h"
+#include "../../bridge_type.h"
+
+/** A tile of a route planned by YapfPlanRoute. */
+struct PlannedRouteTile {
+	TileIndex tile; ///< The tile.
+	bool bridge; ///< Whether this tile is reached by a bridge from the previous tile.
+	BridgeType bridge_type; ///< Type of that bridge.
+};
+
+/** A route planned by YapfPlanRoute. */
+struct PlannedRoute {
+	std::vector<PlannedRouteTile> tiles; ///< The tiles of the route, from start to end.
+	int cost; ///< Pathfinder cost of the route.
+	int nodes; ///< Number of nodes the pathfinder visited.
+};
+
+bool YapfPlanRoute(TileIndex start_tile, TileIndex end_tile, TransportType transport_type, uint8_t road_rail_type, int max_nodes, PlannedRoute &route);
+
+#endif /* YAPF_ROUTE_PLANNER_H */
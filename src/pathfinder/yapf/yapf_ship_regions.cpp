@@ -23,6 +23,8 @@ static constexpr int MAX_NUMBER_OF_NODES = 65536;
 static constexpr int NODE_LIST_HASH_BITS_OPEN = 12;
 static constexpr int NODE_LIST_HASH_BITS_CLOSED = 12;
 
+static constexpr size_t MAX_CACHED_PATHS = 256;
+
 /** Yapf Node Key that represents a single patch of interconnected water within a water region. */
 struct WaterRegionPatchKey {
 	WaterRegionPatchDesc water_region_patch;
@@ -174,28 +176,39 @@ public:
 
 	inline char TransportTypeChar() const { return '^'; }
 
-	static std::vector<WaterRegionPatchDesc> FindWaterRegionPath(const Ship *v, TileIndex start_tile, int max_returned_path_length)
+	/**
+	 * Get the patches of the destination of a ship, which are the origins of the search.
+	 * @param v The ship.
+	 * @return The destination patches, in the order they are added to the search.
+	 */
+	static std::vector<WaterRegionPatchDesc> GetDestinationPatches(const Ship *v)
 	{
-		const WaterRegionPatchDesc start_water_region_patch = GetWaterRegionPatchInfo(start_tile);
-
-		/* We reserve 4 nodes (patches) per water region. The vast majority of water regions have 1 or 2 regions so this should be a pretty
-		 * safe limit. We cap the limit at 65536 which is at a region size of 16x16 is equivalent to one node per region for a 4096x4096 map. */
-		const int node_limit = std::min(static_cast<int>(Map::Size() * NODES_PER_REGION) / WATER_REGION_NUMBER_OF_TILES, MAX_NUMBER_OF_NODES);
-		YapfShipRegions pf(node_limit);
-		pf.SetDestination(start_water_region_patch);
+		std::vector<WaterRegionPatchDesc> patches;
+		auto add_patch = [&patches](TileIndex tile) {
+			const WaterRegionPatchDesc patch = GetWaterRegionPatchInfo(tile);
+			if (patch.label != INVALID_WATER_REGION_PATCH && std::ranges::find(patches, patch) == patches.end()) patches.push_back(patch);
+		};
 
 		if (v->current_order.IsType(OT_GOTO_STATION)) {
 			StationID station_id = v->current_order.GetDestination().ToStationID();
 			const BaseStation *station = BaseStation::Get(station_id);
 			for (const auto &tile : station->GetTileArea(StationType::Dock)) {
-				if (IsDockingTile(tile) && IsShipDestinationTile(tile, station_id)) {
-					pf.AddOrigin(GetWaterRegionPatchInfo(tile));
-				}
+				if (IsDockingTile(tile) && IsShipDestinationTile(tile, station_id)) add_patch(tile);
 			}
 		} else {
-			TileIndex tile = v->dest_tile;
-			pf.AddOrigin(GetWaterRegionPatchInfo(tile));
+			add_patch(v->dest_tile);
 		}
+		return patches;
+	}
+
+	static std::vector<WaterRegionPatchDesc> FindWaterRegionPath(const Ship *v, const WaterRegionPatchDesc &start_water_region_patch, const std::vector<WaterRegionPatchDesc> &destinations, int max_returned_path_length)
+	{
+		/* We reserve 4 nodes (patches) per water region. The vast majority of water regions have 1 or 2 regions so this should be a pretty
+		 * safe limit. We cap the limit at 65536 which is at a region size of 16x16 is equivalent to one node per region for a 4096x4096 map. */
+		const int node_limit = std::min(static_cast<int>(Map::Size() * NODES_PER_REGION) / WATER_REGION_NUMBER_OF_TILES, MAX_NUMBER_OF_NODES);
+		YapfShipRegions pf(node_limit);
+		pf.SetDestination(start_water_region_patch);
+		for (const WaterRegionPatchDesc &destination : destinations) pf.AddOrigin(destination);
 
 		/* If origin and destination are the same we simply return that water patch. */
 		std::vector<WaterRegionPatchDesc> path = { start_water_region_patch };
@@ -218,8 +231,22 @@ public:
 	}
 };
 
+/** A previously found path at the water region level. */
+struct CachedWaterRegionPath {
+	WaterRegionPatchDesc start; ///< Patch the path starts at.
+	std::vector<WaterRegionPatchDesc> destinations; ///< Destination patches, in search order.
+	int max_length; ///< Maximum length the path was limited to.
+	std::vector<WaterRegionPatchDesc> path; ///< The found path; empty if no path was found.
+};
+
+/** Paths found since the water regions last changed. */
+static std::vector<CachedWaterRegionPath> _cached_water_region_paths;
+static uint64_t _cached_water_region_paths_counter = 0; ///< Water region change counter the cached paths are valid for.
+
 /**
  * Finds a path at the water region level. Note that the starting region is always included if the path was found.
+ * Ships sailing between the same docks tend to ask for the same path, so paths are kept until the water regions change.
+ * A cached path is exactly the path a new search would find, so the cache does not affect the game state.
  * @param v The ship to find a path for.
  * @param start_tile The tile to start searching from.
  * @param max_returned_path_length The maximum length of the path that will be returned.
@@ -227,5 +254,22 @@ public:
  */
 std::vector<WaterRegionPatchDesc> YapfShipFindWaterRegionPath(const Ship *v, TileIndex start_tile, int max_returned_path_length)
 {
-	return YapfShipRegions::FindWaterRegionPath(v, start_tile, max_returned_path_length);
+	const WaterRegionPatchDesc start_water_region_patch = GetWaterRegionPatchInfo(start_tile);
+	std::vector<WaterRegionPatchDesc> destinations = YapfShipRegions::GetDestinationPatches(v);
+
+	/* Getting the patches may have updated water regions, but that does not change them. */
+	if (_cached_water_region_paths_counter != GetWaterRegionChangeCounter()) {
+		_cached_water_region_paths.clear();
+		_cached_water_region_paths_counter = GetWaterRegionChangeCounter();
+	}
+
+	for (const CachedWaterRegionPath &cached : _cached_water_region_paths) {
+		if (cached.start == start_water_region_patch && cached.max_length == max_returned_path_length && cached.destinations == destinations) return cached.path;
+	}
+
+	std::vector<WaterRegionPatchDesc> path = YapfShipRegions::FindWaterRegionPath(v, start_water_region_patch, destinations, max_returned_path_length);
+
+	if (_cached_water_region_paths.size() >= MAX_CACHED_PATHS) _cached_water_region_paths.clear();
+	_cached_water_region_paths.emplace_back(start_water_region_patch, std::move(destinations), max_returned_path_length, path);
+	return path;
 }
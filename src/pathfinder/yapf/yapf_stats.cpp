@@ -0,0 +1,171 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/**
+ * @file yapf_stats.cpp Statistics of the YAPF searches, per vehicle type and company.
+ *
+ * The statistics are local to this client and never influence the game state.
+ */
+
+#include "../../stdafx.h"
+#include "yapf_stats.h"
+#include "../../console_func.h"
+#include "../../company_base.h"
+
+#include "../../safeguards.h"
+
+/** Number of vehicle types that use YAPF: trains, road vehicles and ships. */
+static constexpr uint YAPF_VEHICLE_TYPES = VEH_SHIP + 1;
+/** Slot for searches not made by a vehicle of a company. */
+static constexpr uint YAPF_STATS_NO_COMPANY = MAX_COMPANIES;
+
+/** Statistics per vehicle type and company, with an extra slot for searches without a company. */
+static std::array<std::array<YapfSearchStats, MAX_COMPANIES + 1>, YAPF_VEHICLE_TYPES> _yapf_search_stats;
+
+/**
+ * Add the statistics of other searches to these.
+ * @param other The statistics to add.
+ */
+void YapfSearchStats::Add(const YapfSearchStats &other)
+{
+	this->searches += other.searches;
+	this->paths_found += other.paths_found;
+	this->nodes_opened += other.nodes_opened;
+	this->nodes_closed += other.nodes_closed;
+	this->cache_hits += other.cache_hits;
+	this->cache_misses += other.cache_misses;
+	this->node_limit_reached += other.node_limit_reached;
+	this->total_time += other.total_time;
+	for (uint i = 0; i < TIME_BUCKETS; i++) this->time_histogram[i] += other.time_histogram[i];
+}
+
+/**
+ * Get the bucket of the search time histogram for a search.
+ * @param time Duration of the search in microseconds.
+ * @return The bucket.
+ */
+/* static */ uint YapfSearchStats::GetTimeBucket(uint64_t time)
+{
+	uint bucket = 0;
+	while (bucket < TIME_BUCKETS - 1 && time >= GetTimeBucketLimit(bucket)) bucket++;
+	return bucket;
+}
+
+/**
+ * Get the upper limit of a bucket of the search time histogram.
+ * @param bucket The bucket.
+ * @return Searches in the bucket took less than this many microseconds; UINT64_MAX for the last bucket.
+ */
+/* static */ uint64_t YapfSearchStats::GetTimeBucketLimit(uint bucket)
+{
+	if (bucket >= TIME_BUCKETS - 1) return UINT64_MAX;
+	return static_cast<uint64_t>(1) << (TIME_BUCKET_BITS + bucket);
+}
+
+/**
+ * Get the statistics slot of a vehicle type and owner.
+ * @param type The vehicle type.
+ * @param owner The owner of the vehicle.
+ * @return The slot, or nullptr when the vehicle type does not use YAPF.
+ */
+static YapfSearchStats *GetSearchStatsSlot(VehicleType type, Owner owner)
+{
+	if (type >= YAPF_VEHICLE_TYPES) return nullptr;
+	return &_yapf_search_stats[type][owner.base() < MAX_COMPANIES ? owner.base() : YAPF_STATS_NO_COMPANY];
+}
+
+/**
+ * Record the statistics of a finished search.
+ * @param type The type of vehicle the search was made for.
+ * @param owner The owner of that vehicle.
+ * @param search The statistics of the one search.
+ */
+void YapfRecordSearch(VehicleType type, Owner owner, const YapfSearchStats &search)
+{
+	YapfSearchStats *stats = GetSearchStatsSlot(type, owner);
+	if (stats != nullptr) stats->Add(search);
+}
+
+/**
+ * Get the statistics of the searches for the vehicles of one type and owner.
+ * @param type The vehicle type.
+ * @param owner The owner; any owner that is not a company gives the searches without a company.
+ * @return The statistics.
+ */
+const YapfSearchStats &YapfGetSearchStats(VehicleType type, Owner owner)
+{
+	static const YapfSearchStats empty{};
+	const YapfSearchStats *stats = GetSearchStatsSlot(type, owner);
+	return stats != nullptr ? *stats : empty;
+}
+
+/**
+ * Get the statistics of all searches for the vehicles of one type.
+ * @param type The vehicle type.
+ * @return The statistics summed over all owners.
+ */
+YapfSearchStats YapfGetTotalSearchStats(VehicleType type)
+{
+	YapfSearchStats total{};
+	if (type >= YAPF_VEHICLE_TYPES) return total;
+	for (const YapfSearchStats &stats : _yapf_search_stats[type]) total.Add(stats);
+	return total;
+}
+
+/** Forget all statistics collected so far. */
+void YapfResetSearchStats()
+{
+	for (auto &per_type : _yapf_search_stats) per_type.fill({});
+}
+
+/**
+ * Print one line of statistics to the console.
+ * @param name Name of the searches.
+ * @param stats The statistics.
+ */
+static void PrintSearchStats(std::string_view name, const YapfSearchStats &stats)
+{
+	uint64_t cost_calcs = stats.cache_hits + stats.cache_misses;
+	IConsolePrint(CC_DEFAULT, "{}: {} searches, {} found, {} limited; {} opened, {} closed; cache hits {:.1f}%; {:.2f}ms total, {:.1f}us avg",
+		name, stats.searches, stats.paths_found, stats.node_limit_reached, stats.nodes_opened, stats.nodes_closed,
+		cost_calcs == 0 ? 0.0 : stats.cache_hits * 100.0 / cost_calcs,
+		stats.total_time / 1000.0, stats.searches == 0 ? 0.0 : static_cast<double>(stats.total_time) / stats.searches);
+}
+
+/** Print the pathfinder statistics to the console, for the 'pfstats' console command. */
+void ConPrintYapfStats()
+{
+	static const std::array<std::string_view, YAPF_VEHICLE_TYPES> TYPE_NAMES = { "Trains", "Road vehicles", "Ships" };
+	bool printed_anything = false;
+
+	for (VehicleType type = VEH_BEGIN; type < YAPF_VEHICLE_TYPES; type++) {
+		YapfSearchStats total = YapfGetTotalSearchStats(type);
+		if (total.searches == 0) continue;
+
+		IConsolePrint(CC_INFO, "{}:", TYPE_NAMES[type]);
+		PrintSearchStats("  Total", total);
+		for (const Company *c : Company::Iterate()) {
+			const YapfSearchStats &stats = YapfGetSearchStats(type, c->index);
+			if (stats.searches != 0) PrintSearchStats(fmt::format("  Company {}", c->index.base() + 1), stats);
+		}
+
+		std::string histogram;
+		for (uint i = 0; i < YapfSearchStats::TIME_BUCKETS; i++) {
+			if (i == YapfSearchStats::TIME_BUCKETS - 1) {
+				format_append(histogram, " >={}us: {}", YapfSearchStats::GetTimeBucketLimit(i - 1), total.time_histogram[i]);
+			} else {
+				format_append(histogram, " <{}us: {}", YapfSearchStats::GetTimeBucketLimit(i), total.time_histogram[i]);
+			}
+		}
+		IConsolePrint(CC_DEFAULT, "  Search times:{}", histogram);
+		printed_anything = true;
+	}
+
+	if (!printed_anything) {
+		IConsolePrint(CC_ERROR, "No pathfinder searches have been made yet.");
+	}
+}
@@ -0,0 +1,42 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file yapf_stats.h Statistics of the YAPF searches, per vehicle type and company. */
+
+#ifndef YAPF_STATS_H
+#define YAPF_STATS_H
+
+#include "../../company_type.h"
+#include "../../vehicle_type.h"
+
+/** Accumulated statistics of a number of pathfinder searches. */
+struct YapfSearchStats {
+	static constexpr uint TIME_BUCKET_BITS = 4; ///< The first bucket of the search time histogram holds searches shorter than 2^TIME_BUCKET_BITS microseconds.
+	static constexpr uint TIME_BUCKETS = 12; ///< Each bucket covers twice the time of the previous one; the last bucket holds all longer searches.
+
+	uint64_t searches = 0; ///< Number of searches.
+	uint64_t paths_found = 0; ///< Number of searches that found a path.
+	uint64_t nodes_opened = 0; ///< Number of nodes created by the searches.
+	uint64_t nodes_closed = 0; ///< Number of nodes fully expanded by the searches.
+	uint64_t cache_hits = 0; ///< Number of node costs taken from the segment cache.
+	uint64_t cache_misses = 0; ///< Number of node costs that had to be calculated.
+	uint64_t node_limit_reached = 0; ///< Number of searches that gave up because they reached the maximum number of nodes.
+	uint64_t total_time = 0; ///< Time spent in the searches, in microseconds.
+	std::array<uint64_t, TIME_BUCKETS> time_histogram{}; ///< Number of searches per duration bucket.
+
+	void Add(const YapfSearchStats &other);
+	static uint GetTimeBucket(uint64_t time);
+	static uint64_t GetTimeBucketLimit(uint bucket);
+};
+
+void YapfRecordSearch(VehicleType type, Owner owner, const YapfSearchStats &search);
+const YapfSearchStats &YapfGetSearchStats(VehicleType type, Owner owner);
+YapfSearchStats YapfGetTotalSearchStats(VehicleType type);
+void YapfResetSearchStats();
+void ConPrintYapfStats();
+
+#endif /* YAPF_STATS_H */
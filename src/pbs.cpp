@@ -266,8 +266,8 @@ struct FindTrainOnTrackInfo {
 /** Find the best matching vehicle on a tile. */
 static void CheckTrainsOnTrack(FindTrainOnTrackInfo &info, TileIndex tile)
 {
-	for (Vehicle *v : VehiclesOnTile(tile)) {
-		if (v->type != VEH_TRAIN || v->vehstatus.Test(VehState::Crashed)) continue;
+	for (Vehicle *v : VehiclesOnTile(tile, VEH_TRAIN)) {
+		if (v->vehstatus.Test(VehState::Crashed)) continue;
 
 		Train *t = Train::From(v);
 		if (t->track == TRACK_BIT_WORMHOLE || HasBit(static_cast<TrackBits>(t->track), TrackdirToTrack(info.res.trackdir))) {
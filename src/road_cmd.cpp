@@ -367,6 +367,8 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlags flags, RoadBits pie
 
 				SetRoadType(other_end, rtt, INVALID_ROADTYPE);
 				SetRoadType(tile,      rtt, INVALID_ROADTYPE);
+				YapfNotifyRoadLayoutChange(other_end);
+				YapfNotifyRoadLayoutChange(tile);
 
 				/* If the owner of the bridge sells all its road, also move the ownership
 				 * to the owner of the other roadtype, unless the bridge owner is a town. */
@@ -391,6 +393,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlags flags, RoadBits pie
 				/* A full diagonal road tile has two road bits. */
 				UpdateCompanyRoadInfrastructure(existing_rt, GetRoadOwner(tile, rtt), -2);
 				SetRoadType(tile, rtt, INVALID_ROADTYPE);
+				YapfNotifyRoadLayoutChange(tile);
 				MarkTileDirtyByTile(tile);
 			}
 		}
@@ -470,6 +473,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlags flags, RoadBits pie
 					SetRoadBits(tile, present, rtt);
 					MarkTileDirtyByTile(tile);
 				}
+				YapfNotifyRoadLayoutChange(tile);
 			}
 
 			CommandCost cost(EXPENSES_CONSTRUCTION, CountBits(pieces) * RoadClearCost(existing_rt));
@@ -509,6 +513,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlags flags, RoadBits pie
 				}
 				MarkTileDirtyByTile(tile);
 				YapfNotifyTrackLayoutChange(tile, railtrack);
+				YapfNotifyRoadLayoutChange(tile);
 			}
 			return CommandCost(EXPENSES_CONSTRUCTION, RoadClearCost(existing_rt) * 2);
 		}
@@ -668,6 +673,7 @@ CommandCost CmdBuildRoad(DoCommandFlags flags, TileIndex tile, RoadBits pieces,
 							/* Ignore half built tiles */
 							if (flags.Test(DoCommandFlag::Execute) && IsStraightRoad(existing)) {
 								SetDisallowedRoadDirections(tile, dis_new);
+								YapfNotifyRoadLayoutChange(tile);
 								MarkTileDirtyByTile(tile);
 							}
 							return CommandCost();
@@ -769,6 +775,7 @@ CommandCost CmdBuildRoad(DoCommandFlags flags, TileIndex tile, RoadBits pieces,
 				SetCrossingReservation(tile, reserved);
 				UpdateLevelCrossing(tile, false);
 				MarkDirtyAdjacentLevelCrossingTiles(tile, GetCrossingRoadAxis(tile));
+				YapfNotifyRoadLayoutChange(tile);
 				MarkTileDirtyByTile(tile);
 			}
 			return CommandCost(EXPENSES_CONSTRUCTION, 2 * RoadBuildCost(rt));
@@ -889,6 +896,7 @@ do_clear:;
 				SetRoadType(tile, rtt, rt);
 				SetRoadOwner(other_end, rtt, company);
 				SetRoadOwner(tile, rtt, company);
+				YapfNotifyRoadLayoutChange(other_end);
 
 				/* Mark tiles dirty that have been repaved */
 				if (IsBridge(tile)) {
@@ -922,6 +930,7 @@ do_clear:;
 					GetDisallowedRoadDirections(tile) ^ toggle_drd : DRD_NONE);
 		}
 
+		YapfNotifyRoadLayoutChange(tile);
 		MarkTileDirtyByTile(tile);
 	}
 	return cost;
@@ -1213,6 +1222,7 @@ static CommandCost RemoveRoadDepot(TileIndex tile, DoCommandFlags flags)
 
 		delete Depot::GetByTile(tile);
 		DoClearSquare(tile);
+		YapfNotifyRoadLayoutChange(tile);
 	}
 
 	return CommandCost(EXPENSES_CONSTRUCTION, _price[PR_CLEAR_DEPOT_ROAD]);
@@ -2041,6 +2051,7 @@ static void TileLoop_Road(TileIndex tile)
 					IsNormalRoad(tile) && !HasAtMostOneBit(GetAllRoadBits(tile))) {
 				if (std::get<0>(GetFoundationSlope(tile)) == SLOPE_FLAT && EnsureNoVehicleOnGround(tile).Succeeded() && Chance16(1, 40)) {
 					StartRoadWorks(tile);
+					YapfNotifyRoadLayoutChange(tile);
 
 					if (_settings_client.sound.ambient) SndPlayTileFx(SND_21_ROAD_WORKS, tile);
 					CreateEffectVehicleAbove(
@@ -2077,6 +2088,7 @@ static void TileLoop_Road(TileIndex tile)
 		}
 	} else if (IncreaseRoadWorksCounter(tile)) {
 		TerminateRoadWorks(tile);
+		YapfNotifyRoadLayoutChange(tile);
 
 		if (_settings_game.economy.mod_road_rebuild) {
 			/* Generate a nicer town surface */
@@ -667,14 +667,14 @@ static RoadVehicle *RoadVehFindCloseTo(RoadVehicle *v, int x, int y, Direction d
 	rvf.best_diff = UINT_MAX;
 
 	if (front->state == RVSB_WORMHOLE) {
-		for (Vehicle *u : VehiclesOnTile(v->tile)) {
+		for (Vehicle *u : VehiclesOnTile(v->tile, VEH_ROAD)) {
 			FindClosestBlockingRoadVeh(u, &rvf);
 		}
-		for (Vehicle *u : VehiclesOnTile(GetOtherTunnelBridgeEnd(v->tile))) {
+		for (Vehicle *u : VehiclesOnTile(GetOtherTunnelBridgeEnd(v->tile), VEH_ROAD)) {
 			FindClosestBlockingRoadVeh(u, &rvf);
 		}
 	} else {
-		for (Vehicle *u : VehiclesNearTileXY(x, y, 8)) {
+		for (Vehicle *u : VehiclesNearTileXY(x, y, 8, VEH_ROAD)) {
 			FindClosestBlockingRoadVeh(u, &rvf);
 		}
 	}
@@ -799,9 +799,10 @@ static bool CheckRoadBlockedForOvertaking(OvertakeData *od)
 	if (!HasBit(trackdirbits, od->trackdir) || (trackbits & ~TRACK_BIT_CROSS) || (red_signals != TRACKDIR_BIT_NONE)) return true;
 
 	/* Are there more vehicles on the tile except the two vehicles involved in overtaking */
-	return HasVehicleOnTile(od->tile, [&](const Vehicle *v) {
-		return v->type == VEH_ROAD && v->First() == v && v != od->u && v != od->v;
-	});
+	for (const Vehicle *v : VehiclesOnTile(od->tile, VEH_ROAD)) {
+		if (v->First() == v && v != od->u && v != od->v) return true;
+	}
+	return false;
 }
 
 static void RoadVehCheckOvertake(RoadVehicle *v, RoadVehicle *u)
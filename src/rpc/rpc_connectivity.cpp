@@ -0,0 +1,234 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/**
+ * @file rpc_connectivity.cpp Cached connectivity queries of the road and rail networks.
+ *
+ * A query labels the whole connected component of the start tile, so later
+ * queries touching the same component are a lookup. Components ignore one-way
+ * roads, signals and rail type compatibility; they answer whether there is
+ * track at all between two tiles. The labels are dropped whenever a landscape
+ * construction command succeeds, as that may have changed any network.
+ */
+
+#include "../stdafx.h"
+#include "rpc_connectivity.h"
+#include "../road_map.h"
+#include "../pathfinder/follow_track.hpp"
+
+#include "../safeguards.h"
+
+/** Connected components of one network, labelled on demand. */
+struct RpcConnectivityCache {
+	uint32_t generation = 0; ///< Value of #_rpc_connectivity_generation the labels are valid for.
+	uint32_t next_label = 0; ///< Label to give to the next component.
+	std::unordered_map<uint64_t, uint32_t> labels; ///< Component of every node labelled so far.
+};
+
+/** Incremented whenever the map may have changed in a way that affects connectivity. */
+static uint32_t _rpc_connectivity_generation = 1;
+static RpcConnectivityCache _rpc_road_connectivity;
+static RpcConnectivityCache _rpc_rail_connectivity;
+
+/** Invalidate all cached road and rail components. */
+void RpcInvalidateConnectivity()
+{
+	_rpc_connectivity_generation++;
+}
+
+/**
+ * Get a cache, dropping its labels when they are out of date.
+ * @param cache The cache to get.
+ * @return \a cache, valid for the current map.
+ */
+static RpcConnectivityCache &GetConnectivityCache(RpcConnectivityCache &cache)
+{
+	if (cache.generation != _rpc_connectivity_generation) {
+		cache.labels.clear();
+		cache.next_label = 0;
+		cache.generation = _rpc_connectivity_generation;
+	}
+	return cache;
+}
+
+/**
+ * Get the key of a rail node, being one track of a tile.
+ * @param tile The tile.
+ * @param track The track on the tile.
+ * @return The key.
+ */
+static inline uint64_t RailNodeKey(TileIndex tile, Track track)
+{
+	return static_cast<uint64_t>(tile.base()) << 3 | track;
+}
+
+/**
+ * Check whether a tile has any road a road vehicle could drive on.
+ * @param tile The tile to check.
+ * @return True if there is road on the tile.
+ */
+bool RpcTileHasRoad(TileIndex tile)
+{
+	return IsValidTile(tile) && GetAnyRoadBits(tile, RTT_ROAD, true) != ROAD_NONE;
+}
+
+/**
+ * Get the tracks of a tile a train could drive on.
+ * @param tile The tile.
+ * @return The tracks.
+ */
+static TrackBits GetRailNodeTracks(TileIndex tile)
+{
+	if (!IsValidTile(tile)) return TRACK_BIT_NONE;
+	return TrackStatusToTrackBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0));
+}
+
+/**
+ * Check whether a tile has any track a train could drive on.
+ * @param tile The tile to check.
+ * @return True if there is rail on the tile.
+ */
+bool RpcTileHasRail(TileIndex tile)
+{
+	return GetRailNodeTracks(tile) != TRACK_BIT_NONE;
+}
+
+/**
+ * Label the road component containing a tile.
+ * Roads connect tiles rather than trackdirs, so this follows the road bits of
+ * the tiles instead of using the road follower, which needs a vehicle.
+ * @param cache The cache to label in.
+ * @param start A tile of the component.
+ * @param label The label to give to the component.
+ */
+static void LabelRoadComponent(RpcConnectivityCache &cache, TileIndex start, uint32_t label)
+{
+	std::vector<TileIndex> stack;
+	cache.labels[start.base()] = label;
+	stack.push_back(start);
+
+	while (!stack.empty()) {
+		TileIndex tile = stack.back();
+		stack.pop_back();
+
+		RoadBits bits = GetAnyRoadBits(tile, RTT_ROAD, true);
+		for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
+			if ((bits & DiagDirToRoadBits(dir)) == ROAD_NONE) continue;
+
+			TileIndex next;
+			if (IsTileType(tile, MP_TUNNELBRIDGE) && GetTunnelBridgeDirection(tile) == dir) {
+				next = GetOtherTunnelBridgeEnd(tile);
+			} else {
+				next = TileAddByDiagDir(tile, dir);
+				if (!IsValidTile(next)) continue;
+				if ((GetAnyRoadBits(next, RTT_ROAD, true) & DiagDirToRoadBits(ReverseDiagDir(dir))) == ROAD_NONE) continue;
+				/* Tunnels and bridge ramps can only be entered from their back. */
+				if (IsTileType(next, MP_TUNNELBRIDGE) && GetTunnelBridgeDirection(next) != dir) continue;
+			}
+
+			if (cache.labels.try_emplace(next.base(), label).second) stack.push_back(next);
+		}
+	}
+}
+
+/**
+ * Label the rail component containing a track, using the rail follower.
+ * The follower keeps the component to tracks of the owner of the start tile.
+ * @param cache The cache to label in.
+ * @param start The tile of the start track.
+ * @param start_track The start track.
+ * @param label The label to give to the component.
+ */
+static void LabelRailComponent(RpcConnectivityCache &cache, TileIndex start, Track start_track, uint32_t label)
+{
+	/* No rail types means no rail type check. */
+	CFollowTrackRail follower(GetTileOwner(start), RailTypes{});
+	std::vector<std::pair<TileIndex, Track>> stack;
+
+	auto visit = [&](TileIndex tile, Track track) {
+		if (cache.labels.try_emplace(RailNodeKey(tile, track), label).second) stack.emplace_back(tile, track);
+	};
+
+	visit(start, start_track);
+	while (!stack.empty()) {
+		auto [tile, track] = stack.back();
+		stack.pop_back();
+
+		for (Trackdir td : {TrackToTrackdir(track), ReverseTrackdir(TrackToTrackdir(track))}) {
+			if (!follower.Follow(tile, td)) continue;
+
+			/* The follower jumps to the end of platforms; the tiles in between are part of the component too. */
+			if (follower.is_station) {
+				TileIndexDiff diff = TileOffsByDiagDir(follower.exitdir);
+				Track platform_track = DiagDirToDiagTrack(follower.exitdir);
+				for (TileIndex t = follower.new_tile - diff * follower.tiles_skipped; t != follower.new_tile; t += diff) {
+					visit(t, platform_track);
+				}
+			}
+
+			for (Track next : SetTrackBitIterator(TrackdirBitsToTrackBits(follower.new_td_bits))) {
+				visit(follower.new_tile, next);
+			}
+		}
+	}
+}
+
+/**
+ * Check whether two tiles are connected by road.
+ * @param start The first tile.
+ * @param end The second tile.
+ * @return True if a road vehicle could drive from \a start to \a end, ignoring one-way roads.
+ */
+bool RpcIsRoadConnected(TileIndex start, TileIndex end)
+{
+	if (!RpcTileHasRoad(start) || !RpcTileHasRoad(end)) return false;
+	if (start == end) return true;
+
+	RpcConnectivityCache &cache = GetConnectivityCache(_rpc_road_connectivity);
+	auto it = cache.labels.find(start.base());
+	if (it == cache.labels.end()) {
+		uint32_t label = cache.next_label++;
+		LabelRoadComponent(cache, start, label);
+		it = cache.labels.find(start.base());
+	}
+
+	auto end_it = cache.labels.find(end.base());
+	return end_it != cache.labels.end() && end_it->second == it->second;
+}
+
+/**
+ * Check whether two tiles are connected by rail.
+ * @param start The first tile.
+ * @param end The second tile.
+ * @return True if any track of \a start is connected to any track of \a end.
+ */
+bool RpcIsRailConnected(TileIndex start, TileIndex end)
+{
+	TrackBits start_tracks = GetRailNodeTracks(start);
+	TrackBits end_tracks = GetRailNodeTracks(end);
+	if (start_tracks == TRACK_BIT_NONE || end_tracks == TRACK_BIT_NONE) return false;
+	if (start == end) return true;
+
+	RpcConnectivityCache &cache = GetConnectivityCache(_rpc_rail_connectivity);
+	std::vector<uint32_t> start_labels;
+	for (Track track : SetTrackBitIterator(start_tracks)) {
+		auto it = cache.labels.find(RailNodeKey(start, track));
+		if (it == cache.labels.end()) {
+			uint32_t label = cache.next_label++;
+			LabelRailComponent(cache, start, track, label);
+			it = cache.labels.find(RailNodeKey(start, track));
+		}
+		start_labels.push_back(it->second);
+	}
+
+	for (Track track : SetTrackBitIterator(end_tracks)) {
+		auto it = cache.labels.find(RailNodeKey(end, track));
+		if (it == cache.labels.end()) continue;
+		if (std::ranges::find(start_labels, it->second) != start_labels.end()) return true;
+	}
+	return false;
+}
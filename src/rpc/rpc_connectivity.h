@@ -0,0 +1,21 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file rpc_connectivity.h Cached connectivity queries of the road and rail networks. */
+
+#ifndef RPC_CONNECTIVITY_H
+#define RPC_CONNECTIVITY_H
+
+#include "../tile_type.h"
+
+bool RpcTileHasRoad(TileIndex tile);
+bool RpcTileHasRail(TileIndex tile);
+bool RpcIsRoadConnected(TileIndex start, TileIndex end);
+bool RpcIsRailConnected(TileIndex start, TileIndex end);
+void RpcInvalidateConnectivity();
+
+#endif /* RPC_CONNECTIVITY_H */
@@ -0,0 +1,15 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file rpc_engine_cache.h Cached responses of the engine queries. */
+
+#ifndef RPC_ENGINE_CACHE_H
+#define RPC_ENGINE_CACHE_H
+
+void RpcInvalidateEngineCache();
+
+#endif /* RPC_ENGINE_CACHE_H */
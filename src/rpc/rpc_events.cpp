@@ -0,0 +1,228 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/**
+ * @file rpc_events.cpp Producers of the notifications pushed to subscribed RPC clients.
+ *
+ * Once per economy day the state relevant to each topic is compared with what
+ * was seen the previous day, and the differences are pushed as one notification
+ * per topic. Topics without subscribers are skipped and their state is dropped,
+ * so a new subscriber first gets a baseline instead of a flood of changes.
+ */
+
+#include "../stdafx.h"
+#include "rpc_handlers.h"
+#include "../cargomonitor.h"
+#include "../news_type.h"
+#include "../station_base.h"
+#include "../vehicle_base.h"
+#include "../timer/timer.h"
+#include "../timer/timer_game_economy.h"
+
+#include "../safeguards.h"
+
+/* Forward declaration for news access */
+const NewsContainer &GetNews();
+
+/** Minimum change of a station rating, in percent, before it is reported. */
+static constexpr int RPC_RATING_THRESHOLD = 5;
+
+/** What was seen for each topic at the previous economy day. */
+struct RpcEventState {
+	bool primed = false; ///< Whether the state below is a valid baseline.
+	std::map<VehicleID, const char *> vehicle_states; ///< Last reported state of each primary vehicle.
+	const NewsItem *last_news = nullptr; ///< Newest news item that has been reported.
+	TimerGameEconomy::Date last_news_date{}; ///< Economy date of #last_news, in case it has been deleted since.
+	std::map<std::pair<StationID, CargoType>, int> ratings; ///< Last reported rating percentage per station and cargo.
+	CargoMonitorMap deliveries; ///< Last seen delivery monitor amounts.
+	CargoMonitorMap pickups; ///< Last seen pickup monitor amounts.
+
+	void Reset()
+	{
+		*this = {};
+	}
+};
+
+static std::array<RpcEventState, to_underlying(RpcTopic::End)> _rpc_event_state;
+static TimerGameEconomy::Date _rpc_event_last_date{};
+
+static void NotifyVehicleChanges(RpcEventState &state)
+{
+	nlohmann::json changes = nlohmann::json::array();
+	std::map<VehicleID, const char *> current;
+
+	for (const Vehicle *v : Vehicle::Iterate()) {
+		if (!v->IsPrimaryVehicle()) continue;
+
+		const char *vehicle_state = RpcVehicleStateToString(v);
+		current[v->index] = vehicle_state;
+		if (!state.primed) continue;
+
+		auto it = state.vehicle_states.find(v->index);
+		const char *previous = it == state.vehicle_states.end() ? nullptr : it->second;
+		if (previous == vehicle_state) continue;
+
+		changes.push_back({
+			{"id", v->index.base()},
+			{"type", RpcVehicleTypeToString(v->type)},
+			{"owner", v->owner.base()},
+			{"state", vehicle_state},
+			{"previous_state", previous != nullptr ? nlohmann::json(previous) : nlohmann::json("new")},
+			{"tile", v->tile.base()}
+		});
+	}
+
+	if (state.primed) {
+		for (const auto &[id, previous] : state.vehicle_states) {
+			if (current.contains(id)) continue;
+			changes.push_back({{"id", id.base()}, {"state", "removed"}, {"previous_state", previous}});
+		}
+	}
+
+	state.vehicle_states = std::move(current);
+	state.primed = true;
+
+	if (!changes.empty()) RpcServerNotify(RpcTopic::Vehicle, "event.vehicle", {{"changes", changes}});
+}
+
+static void NotifyNews(RpcEventState &state)
+{
+	const NewsContainer &news = GetNews();
+
+	/* News is stored newest first; collect everything newer than what was reported last. */
+	std::vector<const NewsItem *> fresh;
+	for (const NewsItem &item : news) {
+		if (state.primed && (&item == state.last_news || item.economy_date < state.last_news_date)) break;
+		fresh.push_back(&item);
+	}
+
+	bool report = state.primed;
+	if (!news.empty()) {
+		state.last_news = &news.front();
+		state.last_news_date = news.front().economy_date;
+	}
+	state.primed = true;
+	if (!report || fresh.empty()) return;
+
+	nlohmann::json items = nlohmann::json::array();
+	for (auto it = fresh.rbegin(); it != fresh.rend(); ++it) {
+		const NewsItem &item = **it;
+		nlohmann::json entry = {
+			{"type", RpcNewsTypeToString(item.type)},
+			{"date", item.date.base()},
+			{"message", item.GetStatusText()}
+		};
+		if (std::holds_alternative<VehicleID>(item.ref1)) entry["vehicle_id"] = std::get<VehicleID>(item.ref1).base();
+		if (std::holds_alternative<StationID>(item.ref1)) entry["station_id"] = std::get<StationID>(item.ref1).base();
+		if (std::holds_alternative<TileIndex>(item.ref1)) entry["tile"] = std::get<TileIndex>(item.ref1).base();
+		if (std::holds_alternative<IndustryID>(item.ref1)) entry["industry_id"] = std::get<IndustryID>(item.ref1).base();
+		items.push_back(std::move(entry));
+	}
+
+	RpcServerNotify(RpcTopic::News, "event.news", {{"items", items}});
+}
+
+static void NotifyStationRatings(RpcEventState &state)
+{
+	nlohmann::json changes = nlohmann::json::array();
+
+	for (const Station *st : Station::Iterate()) {
+		for (CargoType c = 0; c < NUM_CARGO; c++) {
+			const GoodsEntry &ge = st->goods[c];
+			if (!ge.HasRating()) continue;
+
+			int rating = ge.rating * 100 / 255;
+			auto [it, inserted] = state.ratings.try_emplace({st->index, c}, rating);
+			if (inserted) continue;
+			if (std::abs(rating - it->second) < RPC_RATING_THRESHOLD) continue;
+
+			if (state.primed) {
+				changes.push_back({
+					{"station_id", st->index.base()},
+					{"owner", st->owner.base()},
+					{"cargo", static_cast<int>(c)},
+					{"rating", rating},
+					{"previous_rating", it->second}
+				});
+			}
+			it->second = rating;
+		}
+	}
+	state.primed = true;
+
+	if (!changes.empty()) RpcServerNotify(RpcTopic::StationRating, "event.station_rating", {{"changes", changes}});
+}
+
+/**
+ * Collect the growth of the cargo monitor amounts since the last check.
+ * The amounts are only read, so the monitors keep working for cargomonitor.get* callers.
+ * The deltas are in order of the monitor number.
+ * @param current The monitors and their current amounts.
+ * @param previous The amounts seen last time; updated to \a current.
+ * @param primed Whether \a previous is a valid baseline.
+ * @return The deltas.
+ */
+static nlohmann::json CollectCargoMonitorDeltas(const CargoMonitorMap &current, CargoMonitorMap &previous, bool primed)
+{
+	nlohmann::json deltas = nlohmann::json::array();
+
+	/* In order of the monitor number, so the notifications do not depend on the hash map's order. */
+	for (const auto &[monitor, amount] : current.GetSorted()) {
+		const OverflowSafeInt32 *last = previous.Find(monitor);
+		/* A smaller amount means the monitor was read and reset in the meantime. */
+		int32_t delta = (last == nullptr || amount < *last) ? amount.base() : (amount - *last).base();
+		if (!primed || delta == 0) continue;
+
+		nlohmann::json entry = {
+			{"monitor", monitor},
+			{"company", DecodeMonitorCompany(monitor).base()},
+			{"cargo", static_cast<int>(DecodeMonitorCargoType(monitor))},
+			{"amount", delta}
+		};
+		if (MonitorMonitorsIndustry(monitor)) {
+			entry["industry_id"] = DecodeMonitorIndustry(monitor).base();
+		} else {
+			entry["town_id"] = DecodeMonitorTown(monitor).base();
+		}
+		deltas.push_back(std::move(entry));
+	}
+
+	previous = current;
+	return deltas;
+}
+
+static void NotifyCargoMonitors(RpcEventState &state)
+{
+	nlohmann::json deliveries = CollectCargoMonitorDeltas(_cargo_deliveries, state.deliveries, state.primed);
+	nlohmann::json pickups = CollectCargoMonitorDeltas(_cargo_pickups, state.pickups, state.primed);
+	state.primed = true;
+
+	if (deliveries.empty() && pickups.empty()) return;
+	RpcServerNotify(RpcTopic::CargoMonitor, "event.cargomonitor", {{"deliveries", deliveries}, {"pickups", pickups}});
+}
+
+static const IntervalTimer<TimerGameEconomy> _rpc_events_daily({TimerGameEconomy::DAY, TimerGameEconomy::Priority::NONE}, [](auto)
+{
+	/* The date going backwards means a different game was started or loaded; nothing seen before is valid. */
+	if (TimerGameEconomy::date < _rpc_event_last_date) {
+		for (RpcEventState &state : _rpc_event_state) state.Reset();
+	}
+	_rpc_event_last_date = TimerGameEconomy::date;
+
+	static const std::array<void (*)(RpcEventState &), to_underlying(RpcTopic::End)> producers = {
+		NotifyVehicleChanges, NotifyNews, NotifyStationRatings, NotifyCargoMonitors,
+	};
+
+	for (uint8_t i = 0; i < to_underlying(RpcTopic::End); i++) {
+		RpcEventState &state = _rpc_event_state[i];
+		if (!RpcServerHasSubscribers(static_cast<RpcTopic>(i))) {
+			if (state.primed) state.Reset();
+			continue;
+		}
+		producers[i](state);
+	}
+});
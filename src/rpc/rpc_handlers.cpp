@@ -10,6 +10,8 @@
 #include "../stdafx.h"
 #include "rpc_handlers.h"
 #include "../tile_map.h"
+#include "../vehicle_base.h"
+#include "../order_base.h"
 
 #include "../safeguards.h"
 
@@ -52,6 +54,78 @@ const char *RpcVehicleTypeToString(VehicleType type)
 	}
 }
 
+/**
+ * Describe the state of a vehicle.
+ * @param v The vehicle.
+ * @return String representation of the vehicle state.
+ */
+const char *RpcVehicleStateToString(const Vehicle *v)
+{
+	/* Use First() since IsStoppedInDepot() requires primary vehicle */
+	if (v->First()->IsStoppedInDepot()) return "in_depot";
+	if (v->vehstatus.Test(VehState::Crashed)) return "crashed";
+	if (v->vehstatus.Test(VehState::Stopped)) return "stopped";
+	if (v->breakdown_ctr != 0) return "broken";
+	if (v->current_order.IsType(OT_LOADING)) return "loading";
+	return "running";
+}
+
+/**
+ * Convert NewsType to a string.
+ */
+const char *RpcNewsTypeToString(NewsType type)
+{
+	switch (type) {
+		case NewsType::ArrivalCompany: return "arrival_company";
+		case NewsType::ArrivalOther: return "arrival_other";
+		case NewsType::Accident: return "accident";
+		case NewsType::AccidentOther: return "accident_other";
+		case NewsType::CompanyInfo: return "company_info";
+		case NewsType::IndustryOpen: return "industry_open";
+		case NewsType::IndustryClose: return "industry_close";
+		case NewsType::Economy: return "economy";
+		case NewsType::IndustryCompany: return "industry_company";
+		case NewsType::IndustryOther: return "industry_other";
+		case NewsType::IndustryNobody: return "industry_nobody";
+		case NewsType::Advice: return "advice";
+		case NewsType::NewVehicles: return "new_vehicles";
+		case NewsType::Acceptance: return "acceptance";
+		case NewsType::Subsidies: return "subsidies";
+		case NewsType::General: return "general";
+		default: return "unknown";
+	}
+}
+
+/**
+ * Read the field selection from the parameters of a request.
+ * @param params The request parameters; "fields" is an array or a comma separated string of field names.
+ */
+RpcFieldSet::RpcFieldSet(const nlohmann::json &params)
+{
+	if (!params.is_object() || !params.contains("fields")) return;
+
+	const nlohmann::json &fields = params["fields"];
+	if (fields.is_array()) {
+		for (const nlohmann::json &field : fields) {
+			if (field.is_string()) this->fields.insert(field.get<std::string>());
+		}
+	} else if (fields.is_string()) {
+		std::string_view list = fields.get_ref<const std::string &>();
+		while (!list.empty()) {
+			size_t comma = list.find(',');
+			std::string_view field = list.substr(0, comma);
+			if (!field.empty()) this->fields.emplace(field);
+			if (comma == std::string_view::npos) break;
+			list.remove_prefix(comma + 1);
+		}
+	} else {
+		throw std::runtime_error("Parameter 'fields' must be an array or a comma separated string");
+	}
+
+	this->all = false;
+	this->fields.emplace("id");
+}
+
 /**
  * Register all JSON-RPC handlers with the server.
  * Handlers are organized into modules by category:
@@ -13,11 +13,36 @@
 #include "rpc_server.h"
 #include "../tile_type.h"
 #include "../vehicle_type.h"
+#include "../news_type.h"
+#include <set>
 #include <string>
 
 /* Shared utility functions for RPC handlers */
 const char *RpcTileTypeToString(TileType type);
 const char *RpcVehicleTypeToString(VehicleType type);
+const char *RpcVehicleStateToString(const Vehicle *v);
+const char *RpcNewsTypeToString(NewsType type);
+
+/**
+ * The fields requested through the optional "fields" parameter of list handlers.
+ * Handlers check it before computing a field, so unrequested fields cost nothing.
+ * The "id" field is always included.
+ */
+class RpcFieldSet {
+public:
+	explicit RpcFieldSet(const nlohmann::json &params);
+
+	/**
+	 * Check whether a field has been requested.
+	 * @param field The name of the field.
+	 * @return True if the field has to be included in the result.
+	 */
+	bool Has(std::string_view field) const { return this->all || this->fields.contains(field); }
+
+private:
+	bool all = true; ///< No selection was made, so every field is included.
+	std::set<std::string, std::less<>> fields; ///< The requested fields.
+};
 
 /* Query handlers - rpc_handlers_query.cpp */
 void RpcRegisterQueryHandlers(RpcServer &server);
@@ -33,6 +58,7 @@ void RpcRegisterMetaHandlers(RpcServer &server);
 
 /* Viewport/activity handlers - rpc_handlers_viewport.cpp */
 void RpcRegisterViewportHandlers(RpcServer &server);
+void RpcApplyCameraRequest();
 
 /* Activity tracking - call from action handlers to record where changes happen */
 void RpcRecordActivity(TileIndex tile, const std::string &action);
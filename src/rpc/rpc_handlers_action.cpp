@@ -30,6 +30,8 @@
 #include "../company_base.h"
 #include "../misc_cmd.h"
 #include "../town.h"
+#include "../autoreplace_cmd.h"
+#include "../group_type.h"
 #include "../town_cmd.h"
 #include "../station_cmd.h"
 #include "../rail_cmd.h"
@@ -486,31 +488,13 @@ static nlohmann::json HandleVehicleSell(const nlohmann::json &params)
 }
 
 /**
- * Handler for vehicle.clone - Clone an existing vehicle including orders.
- *
- * Parameters:
- *   vehicle_id: The vehicle ID to clone (required)
- *   depot_tile or depot_x/depot_y: The depot to build in (required)
- *   share_orders: Whether to share orders with original (default: false)
- *
- * Returns:
- *   vehicle_id: The ID of the newly cloned vehicle
- *   success: Whether the clone succeeded
- *   cost: The cost of the cloned vehicle
+ * Get the depot to clone a vehicle in from the parameters of a request.
+ * @param params The parameters, with depot_tile or depot_x/depot_y.
+ * @param source_v The vehicle to clone.
+ * @return The tile of the depot.
  */
-static nlohmann::json HandleVehicleClone(const nlohmann::json &params)
+static TileIndex GetCloneDepotTile(const nlohmann::json &params, const Vehicle *source_v)
 {
-	if (!params.contains("vehicle_id")) {
-		throw std::runtime_error("Missing required parameter: vehicle_id");
-	}
-
-	VehicleID source_vid = static_cast<VehicleID>(params["vehicle_id"].get<int>());
-	const Vehicle *source_v = Vehicle::GetIfValid(source_vid);
-	if (source_v == nullptr || !source_v->IsPrimaryVehicle()) {
-		throw std::runtime_error("Invalid vehicle ID");
-	}
-
-	/* Get depot tile */
 	TileIndex depot_tile;
 	if (params.contains("depot_tile")) {
 		depot_tile = static_cast<TileIndex>(params["depot_tile"].get<uint32_t>());
@@ -526,7 +510,7 @@ static nlohmann::json HandleVehicleClone(const nlohmann::json &params)
 	}
 
 	/* Validate depot tile */
-	if (!IsDepotTile(depot_tile)) {
+	if (!IsValidTile(depot_tile) || !IsDepotTile(depot_tile)) {
 		throw std::runtime_error("Specified tile is not a depot");
 	}
 
@@ -536,6 +520,35 @@ static nlohmann::json HandleVehicleClone(const nlohmann::json &params)
 		throw std::runtime_error("Vehicle type does not match depot type");
 	}
 
+	return depot_tile;
+}
+
+/**
+ * Handler for vehicle.clone - Clone an existing vehicle including orders.
+ *
+ * Parameters:
+ *   vehicle_id: The vehicle ID to clone (required)
+ *   depot_tile or depot_x/depot_y: The depot to build in (required)
+ *   share_orders: Whether to share orders with original (default: false)
+ *
+ * Returns:
+ *   vehicle_id: The ID of the newly cloned vehicle
+ *   success: Whether the clone succeeded
+ *   cost: The cost of the cloned vehicle
+ */
+static nlohmann::json HandleVehicleClone(const nlohmann::json &params)
+{
+	if (!params.contains("vehicle_id")) {
+		throw std::runtime_error("Missing required parameter: vehicle_id");
+	}
+
+	VehicleID source_vid = static_cast<VehicleID>(params["vehicle_id"].get<int>());
+	const Vehicle *source_v = Vehicle::GetIfValid(source_vid);
+	if (source_v == nullptr || !source_v->IsPrimaryVehicle()) {
+		throw std::runtime_error("Invalid vehicle ID");
+	}
+
+	TileIndex depot_tile = GetCloneDepotTile(params, source_v);
 	bool share_orders = params.value("share_orders", false);
 
 	/* Switch to vehicle owner's company context */
@@ -573,6 +586,142 @@ static nlohmann::json HandleVehicleClone(const nlohmann::json &params)
 	return result;
 }
 
+/** Maximum number of vehicles vehicle.cloneMany builds in one request. */
+static constexpr uint MAX_CLONE_MANY_COUNT = 100;
+
+/**
+ * Handler for vehicle.cloneMany - Clone an existing vehicle a number of times in one request.
+ *
+ * Parameters:
+ *   vehicle_id: The vehicle ID to clone (required)
+ *   count: The number of clones to build, at most 100 (required)
+ *   depot_tile or depot_x/depot_y: The depot to build in (required)
+ *   share_orders: Whether to share orders with original (default: true)
+ *
+ * Building stops at the first clone that fails, for example when running out of money.
+ *
+ * Returns:
+ *   vehicle_ids: The IDs of the newly cloned vehicles
+ *   success: Whether all clones were built
+ *   cost: The total cost of the cloned vehicles
+ *   error: Why the first failed clone failed, if any
+ */
+static nlohmann::json HandleVehicleCloneMany(const nlohmann::json &params)
+{
+	if (!params.contains("vehicle_id")) {
+		throw std::runtime_error("Missing required parameter: vehicle_id");
+	}
+	if (!params.contains("count")) {
+		throw std::runtime_error("Missing required parameter: count");
+	}
+
+	VehicleID source_vid = static_cast<VehicleID>(params["vehicle_id"].get<int>());
+	const Vehicle *source_v = Vehicle::GetIfValid(source_vid);
+	if (source_v == nullptr || !source_v->IsPrimaryVehicle()) {
+		throw std::runtime_error("Invalid vehicle ID");
+	}
+
+	uint count = params["count"].get<uint>();
+	if (count == 0 || count > MAX_CLONE_MANY_COUNT) {
+		throw std::runtime_error("Count must be between 1 and 100");
+	}
+
+	TileIndex depot_tile = GetCloneDepotTile(params, source_v);
+	bool share_orders = params.value("share_orders", true);
+
+	/* Switch to vehicle owner's company context */
+	Backup<CompanyID> cur_company(_current_company, source_v->owner);
+
+	DoCommandFlags flags;
+	flags.Set(DoCommandFlag::Execute);
+
+	nlohmann::json vehicle_ids = nlohmann::json::array();
+	Money total_cost = 0;
+	CommandCost failure;
+	for (uint i = 0; i < count; i++) {
+		auto [cost, new_veh_id] = Command<CMD_CLONE_VEHICLE>::Do(flags, depot_tile, source_vid, share_orders);
+		if (cost.Failed()) {
+			failure = cost;
+			break;
+		}
+		vehicle_ids.push_back(new_veh_id.base());
+		total_cost += cost.GetCost();
+	}
+
+	cur_company.Restore();
+
+	if (!vehicle_ids.empty()) {
+		RpcRecordActivity(depot_tile, "vehicle.cloneMany");
+	}
+
+	nlohmann::json result;
+	result["success"] = failure.Succeeded();
+	result["source_vehicle_id"] = source_vid.base();
+	result["vehicle_ids"] = vehicle_ids;
+	result["cost"] = total_cost.base();
+	result["share_orders"] = share_orders;
+	if (failure.Failed()) {
+		result["error"] = GetCommandErrorMessage(failure);
+	}
+
+	return result;
+}
+
+/**
+ * Handler for group.setAutoreplace - Replace an engine type by another in a group,
+ * as the vehicles of the group visit a depot.
+ *
+ * Parameters:
+ *   company: Company ID (default: 0)
+ *   group_id: The group to replace the engines in (default: all vehicles of the company)
+ *   old_engine: The engine type to replace (required)
+ *   new_engine: The engine type to replace it with, or -1 to stop replacing it (required)
+ *   when_old: Only replace vehicles of this type when they get old, i.e. autorenew (default: false)
+ *
+ * Returns:
+ *   success: Whether the replacement was set
+ */
+static nlohmann::json HandleGroupSetAutoreplace(const nlohmann::json &params)
+{
+	if (!params.contains("old_engine")) {
+		throw std::runtime_error("Missing required parameter: old_engine");
+	}
+	if (!params.contains("new_engine")) {
+		throw std::runtime_error("Missing required parameter: new_engine");
+	}
+
+	CompanyID company = static_cast<CompanyID>(params.value("company", 0));
+	if (!Company::IsValidID(company)) {
+		throw std::runtime_error("Invalid company ID");
+	}
+
+	GroupID group = params.contains("group_id") ? static_cast<GroupID>(params["group_id"].get<int>()) : ALL_GROUP;
+	EngineID old_engine = static_cast<EngineID>(params["old_engine"].get<int>());
+	int new_engine_param = params["new_engine"].get<int>();
+	EngineID new_engine = new_engine_param < 0 ? EngineID::Invalid() : static_cast<EngineID>(new_engine_param);
+	bool when_old = params.value("when_old", false);
+
+	Backup<CompanyID> cur_company(_current_company, company);
+
+	DoCommandFlags flags;
+	flags.Set(DoCommandFlag::Execute);
+	CommandCost cost = Command<CMD_SET_AUTOREPLACE>::Do(flags, group, old_engine, new_engine, when_old);
+
+	cur_company.Restore();
+
+	nlohmann::json result;
+	result["success"] = cost.Succeeded();
+	result["company"] = company.base();
+	result["group_id"] = group.base();
+	result["old_engine"] = old_engine.base();
+	result["new_engine"] = new_engine_param < 0 ? -1 : new_engine.base();
+	if (cost.Failed()) {
+		result["error"] = GetCommandErrorMessage(cost);
+	}
+
+	return result;
+}
+
 /**
  * Handler for company.setLoan - Set the company's loan amount.
  *
@@ -1508,6 +1657,7 @@ void RpcRegisterActionHandlers(RpcServer &server)
 	server.RegisterHandler("vehicle.build", HandleVehicleBuild);
 	server.RegisterHandler("vehicle.sell", HandleVehicleSell);
 	server.RegisterHandler("vehicle.clone", HandleVehicleClone);
+	server.RegisterHandler("vehicle.cloneMany", HandleVehicleCloneMany);
 	server.RegisterHandler("vehicle.refit", HandleVehicleRefit);
 	server.RegisterHandler("vehicle.attach", HandleVehicleAttach);
 	server.RegisterHandler("order.append", HandleOrderAppend);
@@ -1515,6 +1665,7 @@ void RpcRegisterActionHandlers(RpcServer &server)
 	server.RegisterHandler("order.insert", HandleOrderInsert);
 	server.RegisterHandler("order.setFlags", HandleOrderSetFlags);
 	server.RegisterHandler("order.share", HandleOrderShare);
+	server.RegisterHandler("group.setAutoreplace", HandleGroupSetAutoreplace);
 	server.RegisterHandler("company.setLoan", HandleCompanySetLoan);
 	server.RegisterHandler("town.performAction", HandleTownPerformAction);
 	server.RegisterHandler("station.remove", HandleStationRemove);
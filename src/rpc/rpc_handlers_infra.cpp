@@ -10,6 +10,7 @@
 #include "../stdafx.h"
 #include "rpc_handlers.h"
 #include "../station_base.h"
+#include "../company_base.h"
 #include "../map_func.h"
 #include "../tile_map.h"
 #include "../command_func.h"
@@ -19,6 +20,8 @@
 #include "../station_cmd.h"
 #include "../road_map.h"
 #include "../rail_map.h"
+#include "../rail.h"
+#include "../road_func.h"
 #include "../signal_type.h"
 #include "../direction_func.h"
 #include "../water_cmd.h"
@@ -30,9 +33,14 @@
 #include "../newgrf_roadstop.h"
 #include "../strings_func.h"
 #include "../string_func.h"
+#include "../settings_type.h"
+#include "../pathfinder/yapf/yapf_route_planner.h"
+#include "../table/strings.h"
 
 #include "../safeguards.h"
 
+static constexpr int MAX_ROUTE_PLAN_NODES = 1000000; ///< Largest number of pathfinder nodes route.plan may visit.
+
 /**
  * Extract error message from a failed CommandCost.
  * @param cost The CommandCost to extract the error from.
@@ -2321,6 +2329,265 @@ static nlohmann::json HandleRoadBuildTunnel(const nlohmann::json &params)
 	return result;
 }
 
+/**
+ * Build, or test building, the piece of a planned route on one of its tiles.
+ * Heads of bridges are built together with the bridge, on the tile at its far end.
+ * Road and track that is already there counts as built for free.
+ * @param flags The command flags; without DoCommandFlag::Execute only the cost is determined.
+ * @param route The planned route.
+ * @param i Index of the tile in the route.
+ * @param transport_type #TRANSPORT_ROAD or #TRANSPORT_RAIL.
+ * @param road_rail_type The road or rail type to build.
+ * @return The cost of building the piece.
+ */
+static CommandCost BuildRouteTile(DoCommandFlags flags, const PlannedRoute &route, size_t i, TransportType transport_type, uint8_t road_rail_type)
+{
+	const PlannedRouteTile &cur = route.tiles[i];
+	if (cur.bridge) {
+		return Command<CMD_BUILD_BRIDGE>::Do(flags, cur.tile, route.tiles[i - 1].tile, transport_type, cur.bridge_type, road_rail_type);
+	}
+	if (i + 1 < route.tiles.size() && route.tiles[i + 1].bridge) return CommandCost();
+
+	/* Direction of travel into and out of the tile; the first and last tile only connect to one side. */
+	DiagDirection in = (i > 0) ? DiagdirBetweenTiles(route.tiles[i - 1].tile, cur.tile) : INVALID_DIAGDIR;
+	DiagDirection out = (i + 1 < route.tiles.size()) ? DiagdirBetweenTiles(cur.tile, route.tiles[i + 1].tile) : INVALID_DIAGDIR;
+
+	CommandCost cost;
+	if (transport_type == TRANSPORT_ROAD) {
+		RoadBits bits = ROAD_NONE;
+		if (in != INVALID_DIAGDIR) bits |= DiagDirToRoadBits(ReverseDiagDir(in));
+		if (out != INVALID_DIAGDIR) bits |= DiagDirToRoadBits(out);
+		cost = Command<CMD_BUILD_ROAD>::Do(flags, cur.tile, bits, static_cast<RoadType>(road_rail_type), DRD_NONE, TownID::Invalid());
+	} else {
+		if (in == INVALID_DIAGDIR) in = out;
+		if (out == INVALID_DIAGDIR) out = in;
+		/* The only track that is entered from one side and left through the other. */
+		Track track = FindFirstTrack(DiagdirReachesTracks(in) & DiagdirReachesTracks(ReverseDiagDir(out)));
+		cost = Command<CMD_BUILD_SINGLE_RAIL>::Do(flags, cur.tile, static_cast<RailType>(road_rail_type), track, false);
+	}
+
+	if (cost.Failed() && cost.GetErrorMessage() == STR_ERROR_ALREADY_BUILT) return CommandCost();
+	return cost;
+}
+
+/**
+ * Parse the parameters of route.plan and route.build, and plan the route.
+ * @param params The request parameters.
+ * @param[out] transport_type The transport type of the route.
+ * @param[out] road_rail_type The road or rail type of the route.
+ * @param[out] route The planned route.
+ * @return Whether a route was found.
+ * @pre _current_company is the company to plan for.
+ */
+static bool PlanRouteFromParams(const nlohmann::json &params, TransportType &transport_type, uint8_t &road_rail_type, PlannedRoute &route)
+{
+	if (!params.contains("from_x") || !params.contains("from_y") ||
+	    !params.contains("to_x") || !params.contains("to_y")) {
+		throw std::runtime_error("Missing required parameters: from_x, from_y, to_x, to_y");
+	}
+
+	uint from_x = params["from_x"].get<uint>();
+	uint from_y = params["from_y"].get<uint>();
+	uint to_x = params["to_x"].get<uint>();
+	uint to_y = params["to_y"].get<uint>();
+
+	if (from_x >= Map::SizeX() || from_y >= Map::SizeY() ||
+	    to_x >= Map::SizeX() || to_y >= Map::SizeY()) {
+		throw std::runtime_error("Coordinates out of bounds");
+	}
+
+	TileIndex from_tile = TileXY(from_x, from_y);
+	TileIndex to_tile = TileXY(to_x, to_y);
+	if (!IsValidTile(from_tile) || !IsValidTile(to_tile)) {
+		throw std::runtime_error("Invalid tile (void tile at map edge)");
+	}
+	if (from_tile == to_tile) {
+		throw std::runtime_error("Start and end tile must differ");
+	}
+
+	std::string type = params.value("type", "road");
+	if (type == "road") {
+		transport_type = TRANSPORT_ROAD;
+		int roadtype = params.value("road_type", 0);
+		if (roadtype < 0 || roadtype >= ROADTYPE_END || !ValParamRoadType(static_cast<RoadType>(roadtype))) {
+			throw std::runtime_error(fmt::format("Invalid road_type: {}", roadtype));
+		}
+		road_rail_type = static_cast<uint8_t>(roadtype);
+	} else if (type == "rail") {
+		transport_type = TRANSPORT_RAIL;
+		int railtype = params.value("rail_type", 0);
+		if (railtype < 0 || railtype >= RAILTYPE_END || !ValParamRailType(static_cast<RailType>(railtype))) {
+			throw std::runtime_error(fmt::format("Invalid rail_type: {}", railtype));
+		}
+		road_rail_type = static_cast<uint8_t>(railtype);
+	} else {
+		throw std::runtime_error("Invalid type: must be 'road' or 'rail'");
+	}
+
+	int max_nodes = params.value("max_nodes", static_cast<int>(_settings_game.pf.yapf.max_search_nodes));
+	if (max_nodes <= 0 || max_nodes > MAX_ROUTE_PLAN_NODES) {
+		throw std::runtime_error(fmt::format("Invalid max_nodes: must be 1-{}", MAX_ROUTE_PLAN_NODES));
+	}
+
+	return YapfPlanRoute(from_tile, to_tile, transport_type, road_rail_type, max_nodes, route);
+}
+
+/**
+ * Convert a planned route to JSON.
+ * @param route The planned route.
+ * @return Array of the tiles of the route, with "bridge" set on tiles reached by a bridge.
+ */
+static nlohmann::json RouteToJson(const PlannedRoute &route)
+{
+	nlohmann::json path = nlohmann::json::array();
+	for (const PlannedRouteTile &rt : route.tiles) {
+		nlohmann::json tile = {{"tile", rt.tile.base()}, {"x", TileX(rt.tile)}, {"y", TileY(rt.tile)}};
+		if (rt.bridge) {
+			tile["bridge"] = true;
+			tile["bridge_type"] = rt.bridge_type;
+		}
+		path.push_back(tile);
+	}
+	return path;
+}
+
+/**
+ * Handler for route.plan - plan a road or railway between two tiles.
+ *
+ * The route goes over clear land and trees, reuses road or track of the same type
+ * and bridges water and obstacles; slopes and curves are avoided where possible.
+ * Nothing is built.
+ *
+ * Parameters:
+ *   from_x, from_y: Start tile coordinates
+ *   to_x, to_y: End tile coordinates
+ *   type: "road" or "rail" (optional, default "road")
+ *   road_type / rail_type: Road or rail type available to the company (optional, default 0)
+ *   max_nodes: Maximum number of pathfinder nodes to visit (optional, default the YAPF setting)
+ *   company: Company ID (optional, default 0)
+ *
+ * Returns:
+ *   found: Whether a route was found
+ *   path: The tiles of the route from start to end
+ *   estimated_cost: Cost of building the route
+ *   buildable: Whether every piece of the route can currently be built
+ *   error, error_tile: Why and where building would fail, when not buildable
+ */
+static nlohmann::json HandleRoutePlan(const nlohmann::json &params)
+{
+	CompanyID company = static_cast<CompanyID>(params.value("company", 0));
+	if (!Company::IsValidID(company)) {
+		throw std::runtime_error("Invalid company ID");
+	}
+	Backup<CompanyID> cur_company(_current_company, company);
+
+	TransportType transport_type;
+	uint8_t road_rail_type;
+	PlannedRoute route;
+	bool found = PlanRouteFromParams(params, transport_type, road_rail_type, route);
+
+	nlohmann::json result;
+	result["found"] = found;
+	if (!found) {
+		cur_company.Restore();
+		return result;
+	}
+
+	Money total_cost = 0;
+	result["buildable"] = true;
+	for (size_t i = 0; i < route.tiles.size(); i++) {
+		CommandCost cost = BuildRouteTile({}, route, i, transport_type, road_rail_type);
+		if (cost.Failed()) {
+			result["buildable"] = false;
+			result["error"] = GetCommandErrorMessage(cost);
+			result["error_tile"] = route.tiles[i].tile.base();
+			break;
+		}
+		total_cost += cost.GetCost();
+	}
+
+	cur_company.Restore();
+
+	result["path"] = RouteToJson(route);
+	result["length"] = route.tiles.size();
+	result["estimated_cost"] = total_cost.base();
+	result["nodes"] = route.nodes;
+	return result;
+}
+
+/**
+ * Handler for route.build - plan a road or railway between two tiles and build it.
+ *
+ * Takes the same parameters as route.plan. Every piece is tested before anything is
+ * built, so a blocked route is not started. Building can still stop part way, for
+ * example when the company runs out of money; the pieces built so far are kept.
+ *
+ * Returns:
+ *   success: Whether the whole route was built
+ *   path: The tiles of the route from start to end
+ *   built: Number of tiles of the path that were built
+ *   cost: Construction cost of the built tiles
+ *   error, error_tile: Why and where building failed
+ */
+static nlohmann::json HandleRouteBuild(const nlohmann::json &params)
+{
+	CompanyID company = static_cast<CompanyID>(params.value("company", 0));
+	if (!Company::IsValidID(company)) {
+		throw std::runtime_error("Invalid company ID");
+	}
+	Backup<CompanyID> cur_company(_current_company, company);
+
+	TransportType transport_type;
+	uint8_t road_rail_type;
+	PlannedRoute route;
+	if (!PlanRouteFromParams(params, transport_type, road_rail_type, route)) {
+		cur_company.Restore();
+		return {{"success", false}, {"error", "No route found"}};
+	}
+
+	nlohmann::json result;
+	result["path"] = RouteToJson(route);
+
+	for (size_t i = 0; i < route.tiles.size(); i++) {
+		CommandCost cost = BuildRouteTile({}, route, i, transport_type, road_rail_type);
+		if (cost.Failed()) {
+			cur_company.Restore();
+			result["success"] = false;
+			result["built"] = 0;
+			result["cost"] = 0;
+			result["error"] = GetCommandErrorMessage(cost);
+			result["error_tile"] = route.tiles[i].tile.base();
+			return result;
+		}
+	}
+
+	DoCommandFlags flags;
+	flags.Set(DoCommandFlag::Execute);
+
+	const char *action = (transport_type == TRANSPORT_ROAD) ? "route.build.road" : "route.build.rail";
+	Money total_cost = 0;
+	size_t built = 0;
+	result["success"] = true;
+	for (size_t i = 0; i < route.tiles.size(); i++) {
+		CommandCost cost = BuildRouteTile(flags, route, i, transport_type, road_rail_type);
+		if (cost.Failed()) {
+			result["success"] = false;
+			result["error"] = GetCommandErrorMessage(cost);
+			result["error_tile"] = route.tiles[i].tile.base();
+			break;
+		}
+		total_cost += cost.GetCost();
+		built++;
+		RpcRecordActivity(route.tiles[i].tile, action);
+	}
+
+	cur_company.Restore();
+
+	result["built"] = built;
+	result["cost"] = total_cost.base();
+	return result;
+}
+
 void RpcRegisterInfraHandlers(RpcServer &server)
 {
 	server.RegisterHandler("tile.getRoadInfo", HandleTileGetRoadInfo);
@@ -2344,4 +2611,6 @@ void RpcRegisterInfraHandlers(RpcServer &server)
 	server.RegisterHandler("road.buildBridge", HandleRoadBuildBridge);
 	server.RegisterHandler("rail.buildTunnel", HandleRailBuildTunnel);
 	server.RegisterHandler("road.buildTunnel", HandleRoadBuildTunnel);
+	server.RegisterHandler("route.plan", HandleRoutePlan);
+	server.RegisterHandler("route.build", HandleRouteBuild);
 }
@@ -10,6 +10,8 @@
 #include "../stdafx.h"
 #include "rpc_handlers.h"
 #include "../genworld.h"
+#include "../memory_report.h"
+#include "../cachecheck.h"
 
 #include "../safeguards.h"
 
@@ -40,7 +42,115 @@ static nlohmann::json HandleGameNewGame(const nlohmann::json &params)
 	return result;
 }
 
+/**
+ * Handler for rpc.stats - Cost of the RPC requests per method since the server started or the last reset.
+ *
+ * Parameters:
+ *   reset: Clear the statistics after reporting them (optional, default false)
+ *
+ * Returns the number of seconds covered and one entry per method, the most expensive first.
+ * Times are the time spent on the game thread, in microseconds; the percentiles are the upper
+ * limits of the histogram buckets holding them. Results of deferred handlers are built on the
+ * serialisation thread and are not included.
+ */
+static nlohmann::json HandleRpcStats(RpcServer &server, const nlohmann::json &params)
+{
+	std::vector<RpcMethodStatsMap::const_pointer> sorted;
+	for (const auto &entry : server.GetMethodStats()) sorted.push_back(&entry);
+	std::ranges::stable_sort(sorted, std::greater{}, [](const auto *entry) { return entry->second.total_time; });
+
+	double seconds = server.GetStatsSeconds();
+	nlohmann::json methods = nlohmann::json::array();
+	for (const auto *entry : sorted) {
+		const RpcMethodStats &stats = entry->second;
+		methods.push_back({
+			{"method", entry->first},
+			{"calls", stats.calls},
+			{"errors", stats.errors},
+			{"bytes_in", stats.bytes_in},
+			{"bytes_out", stats.bytes_out},
+			{"total_time_us", stats.total_time},
+			{"p50_time_us", stats.GetPercentileTime(50)},
+			{"p99_time_us", stats.GetPercentileTime(99)},
+			{"max_time_us", stats.max_time},
+			{"ms_per_second", seconds > 0 ? stats.total_time / 1000.0 / seconds : 0.0}
+		});
+	}
+
+	if (params.value("reset", false)) server.ResetStats();
+
+	return {{"seconds", seconds}, {"methods", methods}};
+}
+
+/**
+ * Handler for game.memory - Memory used per pool, cache and script.
+ *
+ * Returns the entries per category, each with a name and the number of bytes;
+ * pools and caches also give the number of items, sprites or tiles. The bytes
+ * do not include memory the items allocate on their own.
+ */
+static nlohmann::json HandleGameMemory(const nlohmann::json &)
+{
+	nlohmann::json pools = nlohmann::json::array();
+	nlohmann::json caches = nlohmann::json::array();
+	nlohmann::json scripts = nlohmann::json::array();
+	size_t total = 0;
+
+	for (const MemoryReportEntry &entry : GetMemoryReport()) {
+		total += entry.bytes;
+		switch (entry.category) {
+			case MemoryReportCategory::Pool: pools.push_back({{"name", entry.name}, {"items", entry.count}, {"bytes", entry.bytes}}); break;
+			case MemoryReportCategory::Cache: caches.push_back({{"name", entry.name}, {"count", entry.count}, {"bytes", entry.bytes}}); break;
+			case MemoryReportCategory::Script: scripts.push_back({{"name", entry.name}, {"bytes", entry.bytes}}); break;
+		}
+	}
+
+	return {{"pools", pools}, {"caches", caches}, {"scripts", scripts}, {"total_bytes", total}};
+}
+
+/**
+ * Handler for game.cacheCheck - Control the sampled cache check and get its findings.
+ *
+ * Parameters:
+ *   action: "start", "stop", "reset" or "status" (optional, default "status")
+ *   vehicles: Vehicles to check per tick when starting (optional, default 16)
+ *   stations: Stations to check per tick when starting (optional, default 4)
+ *   budget_us: Maximum microseconds to spend per tick when starting (optional, default 200)
+ *
+ * Returns whether the check runs, the number of ticks, vehicles and stations checked,
+ * the number of mismatches and the descriptions of the most recent ones.
+ */
+static nlohmann::json HandleGameCacheCheck(const nlohmann::json &params)
+{
+	std::string action = params.value("action", "status");
+	if (action == "start") {
+		StartSampledCacheCheck(params.value("vehicles", 16u), params.value("stations", 4u), std::chrono::microseconds(params.value("budget_us", 200u)));
+	} else if (action == "stop") {
+		StopSampledCacheCheck();
+	} else if (action == "reset") {
+		ResetSampledCacheCheckStats();
+	} else if (action != "status") {
+		throw std::runtime_error("Unknown action: " + action);
+	}
+
+	const SampledCacheCheckStats &stats = GetSampledCacheCheckStats();
+	nlohmann::json recent = nlohmann::json::array();
+	for (const std::string &msg : stats.recent) recent.push_back(msg);
+
+	return {
+		{"running", IsSampledCacheCheckRunning()},
+		{"ticks", stats.ticks},
+		{"vehicles", stats.vehicles},
+		{"stations", stats.stations},
+		{"mismatches", stats.mismatches},
+		{"recent", recent}
+	};
+}
+
 void RpcRegisterMetaHandlers(RpcServer &server)
 {
 	server.RegisterHandler("game.newgame", HandleGameNewGame);
+	server.RegisterHandler("game.memory", HandleGameMemory);
+	server.RegisterHandler("game.cacheCheck", HandleGameCacheCheck);
+	server.RegisterHandler("rpc.stats", [&server](const nlohmann::json &params) { return HandleRpcStats(server, params); });
 }
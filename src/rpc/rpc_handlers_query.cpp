@@ -9,6 +9,8 @@
 
 #include "../stdafx.h"
 #include "rpc_handlers.h"
+#include "rpc_connectivity.h"
+#include "rpc_engine_cache.h"
 #include "../company_base.h"
 #include "../company_func.h"
 #include "../timer/timer_game_calendar.h"
@@ -21,7 +23,9 @@
 #include "../industry.h"
 #include "../cargotype.h"
 #include "../town.h"
+#include "../town_kdtree.h"
 #include "../map_func.h"
+#include "../tile_summary.h"
 #include "../tile_map.h"
 #include "../landscape.h"
 #include "../settings_type.h"
@@ -43,25 +47,21 @@
 #include "../news_type.h"
 #include "../road_map.h"
 #include "../rail_map.h"
+#include "../tunnelbridge_map.h"
 #include "../water_map.h"
 #include "../depot_map.h"
+#include "../pathfinder/yapf/yapf_stats.h"
+#include "../newgrf_profiling.h"
+#include "../spritecache.h"
+
+#include <deque>
+#include <map>
 
 #include "../safeguards.h"
 
 /* Forward declaration for news access */
 const NewsContainer &GetNews();
 
-static const char *VehicleStateToString(const Vehicle *v)
-{
-	/* Use First() since IsStoppedInDepot() requires primary vehicle */
-	if (v->First()->IsStoppedInDepot()) return "in_depot";
-	if (v->vehstatus.Test(VehState::Crashed)) return "crashed";
-	if (v->vehstatus.Test(VehState::Stopped)) return "stopped";
-	if (v->breakdown_ctr != 0) return "broken";
-	if (v->current_order.IsType(OT_LOADING)) return "loading";
-	return "running";
-}
-
 static const char *LandscapeToString(LandscapeType landscape)
 {
 	switch (landscape) {
@@ -226,10 +226,132 @@ static nlohmann::json HandleCompanyList([[maybe_unused]] const nlohmann::json &p
 	return result;
 }
 
-static nlohmann::json HandleVehicleList(const nlohmann::json &params)
+/** Copy of the state of a primary vehicle as reported by vehicle.list. */
+struct VehicleListEntry {
+	uint32_t id;
+	VehicleType type;
+	int owner;
+	UnitID unit_number;
+	std::string name; ///< Only filled when requested, formatting it is the most expensive part.
+	const char *state = nullptr;
+	uint32_t tile;
+	int32_t x;
+	int32_t y;
+	int speed = 0;
+	int max_speed = 0;
+	int32_t age_days;
+	int64_t profit_this_year;
+	int64_t profit_last_year;
+	int64_t value;
+	int cargo_type;
+	uint16_t cargo_capacity;
+	uint cargo_count = 0;
+};
+
+/** Change tracking of a vehicle for the since cursor of vehicle.list. */
+struct VehicleChangeRecord {
+	uint64_t fingerprint = 0; ///< Hash of the reported fields that can change.
+	uint64_t changed = 0; ///< Generation at which #fingerprint last changed.
+	bool present = false; ///< Whether a primary vehicle with this index existed at the last update.
+};
+
+static constexpr size_t MAX_VEHICLE_REMOVALS = 4096; ///< Number of removals remembered for the since cursor.
+
+static std::vector<VehicleChangeRecord> _vehicle_changes; ///< Change records, indexed by vehicle index.
+static std::deque<std::pair<uint64_t, VehicleID>> _vehicle_removals; ///< Recently removed vehicles with the generation they were noticed in.
+static uint64_t _vehicle_change_generation = 0; ///< Generation of the last vehicle.list call.
+static uint64_t _vehicle_removals_forgotten = 0; ///< Removals up to this generation are no longer in #_vehicle_removals.
+
+/**
+ * Hash the fields of a vehicle that vehicle.list reports and that can change:
+ * state, position, speed, profit and cargo. Slowly changing fields like the
+ * age are left out on purpose, otherwise every vehicle would change every day.
+ * @param v The vehicle.
+ * @return The fingerprint.
+ */
+static uint64_t VehicleFingerprint(const Vehicle *v)
 {
-	nlohmann::json result = nlohmann::json::array();
+	uint64_t hash = 14695981039346656037ULL;
+	auto mix = [&hash](uint64_t value) {
+		hash ^= value;
+		hash *= 1099511628211ULL;
+	};
+
+	mix(reinterpret_cast<uintptr_t>(RpcVehicleStateToString(v)));
+	mix(v->tile.base());
+	mix(static_cast<uint32_t>(v->x_pos));
+	mix(static_cast<uint32_t>(v->y_pos));
+	mix(v->cur_speed);
+	mix(v->unitnumber);
+	mix(v->engine_type.base());
+	mix(static_cast<uint64_t>(v->profit_this_year.base()));
+	mix(static_cast<uint64_t>(v->profit_last_year.base()));
+	mix(static_cast<uint64_t>(v->value.base()));
+	mix(v->cargo_type);
+	mix(v->cargo_cap);
+	mix(v->cargo.StoredCount());
+	return hash;
+}
+
+/**
+ * Start a new change generation and record which primary vehicles changed, appeared or disappeared since the previous one.
+ * @return The new generation, which is the cursor for the next call.
+ */
+static uint64_t UpdateVehicleChanges()
+{
+	uint64_t generation = ++_vehicle_change_generation;
+
+	if (_vehicle_changes.size() < Vehicle::GetPoolSize()) _vehicle_changes.resize(Vehicle::GetPoolSize());
 
+	std::vector<bool> seen(_vehicle_changes.size(), false);
+	for (const Vehicle *v : Vehicle::Iterate()) {
+		if (!v->IsPrimaryVehicle()) continue;
+
+		VehicleChangeRecord &record = _vehicle_changes[v->index.base()];
+		uint64_t fingerprint = VehicleFingerprint(v);
+		if (!record.present || record.fingerprint != fingerprint) {
+			record.fingerprint = fingerprint;
+			record.changed = generation;
+			record.present = true;
+		}
+		seen[v->index.base()] = true;
+	}
+
+	for (size_t i = 0; i < _vehicle_changes.size(); i++) {
+		VehicleChangeRecord &record = _vehicle_changes[i];
+		if (!record.present || seen[i]) continue;
+
+		record.present = false;
+		_vehicle_removals.emplace_back(generation, static_cast<VehicleID>(i));
+		if (_vehicle_removals.size() > MAX_VEHICLE_REMOVALS) {
+			_vehicle_removals_forgotten = _vehicle_removals.front().first;
+			_vehicle_removals.pop_front();
+		}
+	}
+
+	return generation;
+}
+
+/**
+ * Handler for vehicle.list.
+ * Only the vehicle data is copied on the game thread; the (potentially large)
+ * JSON result is built and serialised on the RPC serialisation thread.
+ *
+ * Parameters:
+ *   type: Optional vehicle type filter (road, train, ship, aircraft)
+ *   company: Optional owner filter
+ *   since: Optional cursor returned by an earlier call; only vehicles whose state,
+ *          position, profit or cargo changed after it are returned
+ *   fields: Optional array (or comma separated string) of the fields to return; id is always included
+ *
+ * Returns an array of vehicles, or when since is given an object with:
+ *   cursor: Value to pass as since in the next call
+ *   reset: True when since was too old; vehicles then holds everything and the client must drop its cache
+ *   vehicles: Array of changed vehicles
+ *   removed: Array of ids of vehicles that no longer exist
+ */
+static RpcResultBuilder HandleVehicleList(const nlohmann::json &params)
+{
 	VehicleType filter_type = VEH_INVALID;
 	if (params.contains("type")) {
 		std::string type_str = params["type"].get<std::string>();
@@ -244,37 +366,93 @@ static nlohmann::json HandleVehicleList(const nlohmann::json &params)
 		filter_company = static_cast<CompanyID>(params["company"].get<int>());
 	}
 
+	bool incremental = params.contains("since");
+	uint64_t since = incremental ? params["since"].get<uint64_t>() : 0;
+	bool reset = false;
+	uint64_t cursor = 0;
+	std::vector<uint32_t> removed;
+
+	if (incremental) {
+		cursor = UpdateVehicleChanges();
+		/* A cursor from the future belongs to an earlier game session. */
+		if (since > cursor || since < _vehicle_removals_forgotten) {
+			reset = true;
+			since = 0;
+		}
+		for (const auto &[generation, id] : _vehicle_removals) {
+			if (generation > since) removed.push_back(id.base());
+		}
+	}
+
+	RpcFieldSet fields(params);
+
+	std::vector<VehicleListEntry> entries;
 	for (const Vehicle *v : Vehicle::Iterate()) {
 		if (!v->IsPrimaryVehicle()) continue;
 		if (filter_type != VEH_INVALID && v->type != filter_type) continue;
 		if (filter_company != CompanyID::Invalid() && v->owner != filter_company) continue;
-
-		nlohmann::json vehicle_json;
-		vehicle_json["id"] = v->index.base();
-		vehicle_json["type"] = RpcVehicleTypeToString(v->type);
-		vehicle_json["owner"] = v->owner != CompanyID::Invalid() ? v->owner.base() : -1;
-		vehicle_json["unit_number"] = v->unitnumber;
-		vehicle_json["name"] = StrMakeValid(GetString(STR_VEHICLE_NAME, v->index));
-		vehicle_json["state"] = VehicleStateToString(v);
-		vehicle_json["location"] = {
-			{"tile", v->tile != INVALID_TILE ? v->tile.base() : 0},
-			{"x", v->x_pos},
-			{"y", v->y_pos}
+		if (incremental && _vehicle_changes[v->index.base()].changed <= since) continue;
+
+		VehicleListEntry &entry = entries.emplace_back();
+		entry.id = v->index.base();
+		entry.type = v->type;
+		entry.owner = v->owner != CompanyID::Invalid() ? v->owner.base() : -1;
+		entry.unit_number = v->unitnumber;
+		if (fields.Has("name")) entry.name = StrMakeValid(GetString(STR_VEHICLE_NAME, v->index));
+		if (fields.Has("state")) entry.state = RpcVehicleStateToString(v);
+		entry.tile = v->tile != INVALID_TILE ? v->tile.base() : 0;
+		entry.x = v->x_pos;
+		entry.y = v->y_pos;
+		if (fields.Has("speed")) entry.speed = v->GetDisplaySpeed();
+		if (fields.Has("max_speed")) entry.max_speed = v->GetDisplayMaxSpeed();
+		entry.age_days = v->age.base();
+		entry.profit_this_year = (v->profit_this_year >> 8).base();
+		entry.profit_last_year = (v->profit_last_year >> 8).base();
+		entry.value = v->value.base();
+		entry.cargo_type = static_cast<int>(v->cargo_type);
+		entry.cargo_capacity = v->cargo_cap;
+		if (fields.Has("cargo_count")) entry.cargo_count = v->cargo.StoredCount();
+	}
+
+	return [entries = std::move(entries), fields = std::move(fields), incremental, reset, cursor, removed = std::move(removed)]() {
+		nlohmann::json result = nlohmann::json::array();
+		for (const VehicleListEntry &entry : entries) {
+			nlohmann::json vehicle_json;
+			vehicle_json["id"] = entry.id;
+			if (fields.Has("type")) vehicle_json["type"] = RpcVehicleTypeToString(entry.type);
+			if (fields.Has("owner")) vehicle_json["owner"] = entry.owner;
+			if (fields.Has("unit_number")) vehicle_json["unit_number"] = entry.unit_number;
+			if (fields.Has("name")) vehicle_json["name"] = entry.name;
+			if (fields.Has("state")) vehicle_json["state"] = entry.state;
+			if (fields.Has("location")) {
+				vehicle_json["location"] = {
+					{"tile", entry.tile},
+					{"x", entry.x},
+					{"y", entry.y}
+				};
+			}
+			if (fields.Has("speed")) vehicle_json["speed"] = entry.speed;
+			if (fields.Has("max_speed")) vehicle_json["max_speed"] = entry.max_speed;
+			if (fields.Has("age_days")) vehicle_json["age_days"] = entry.age_days;
+			if (fields.Has("profit_this_year")) vehicle_json["profit_this_year"] = entry.profit_this_year;
+			if (fields.Has("profit_last_year")) vehicle_json["profit_last_year"] = entry.profit_last_year;
+			if (fields.Has("value")) vehicle_json["value"] = entry.value;
+			if (fields.Has("cargo_type")) vehicle_json["cargo_type"] = entry.cargo_type;
+			if (fields.Has("cargo_capacity")) vehicle_json["cargo_capacity"] = entry.cargo_capacity;
+			if (fields.Has("cargo_count")) vehicle_json["cargo_count"] = entry.cargo_count;
+
+			result.push_back(std::move(vehicle_json));
+		}
+
+		if (!incremental) return result;
+
+		return nlohmann::json{
+			{"cursor", cursor},
+			{"reset", reset},
+			{"vehicles", std::move(result)},
+			{"removed", removed}
 		};
-		vehicle_json["speed"] = v->GetDisplaySpeed();
-		vehicle_json["max_speed"] = v->GetDisplayMaxSpeed();
-		vehicle_json["age_days"] = v->age.base();
-		vehicle_json["profit_this_year"] = (v->profit_this_year >> 8).base();
-		vehicle_json["profit_last_year"] = (v->profit_last_year >> 8).base();
-		vehicle_json["value"] = v->value.base();
-		vehicle_json["cargo_type"] = static_cast<int>(v->cargo_type);
-		vehicle_json["cargo_capacity"] = v->cargo_cap;
-		vehicle_json["cargo_count"] = v->cargo.StoredCount();
-
-		result.push_back(vehicle_json);
-	}
-
-	return result;
+	};
 }
 
 static nlohmann::json HandleVehicleGet(const nlohmann::json &params)
@@ -294,7 +472,7 @@ static nlohmann::json HandleVehicleGet(const nlohmann::json &params)
 	result["type"] = RpcVehicleTypeToString(v->type);
 	result["owner"] = v->owner != CompanyID::Invalid() ? v->owner.base() : -1;
 	result["name"] = StrMakeValid(GetString(STR_VEHICLE_NAME, v->index));
-	result["state"] = VehicleStateToString(v);
+	result["state"] = RpcVehicleStateToString(v);
 	result["location"] = {
 		{"tile", v->tile != INVALID_TILE ? v->tile.base() : 0},
 		{"x", v->x_pos},
@@ -371,6 +549,13 @@ static nlohmann::json HandleVehicleGet(const nlohmann::json &params)
 	return result;
 }
 
+/**
+ * Handler for station.list.
+ *
+ * Parameters:
+ *   company: Optional owner filter
+ *   fields: Optional array (or comma separated string) of the fields to return; id is always included
+ */
 static nlohmann::json HandleStationList(const nlohmann::json &params)
 {
 	nlohmann::json result = nlohmann::json::array();
@@ -380,32 +565,40 @@ static nlohmann::json HandleStationList(const nlohmann::json &params)
 		filter_company = static_cast<CompanyID>(params["company"].get<int>());
 	}
 
+	RpcFieldSet fields(params);
+
 	for (const Station *st : Station::Iterate()) {
 		if (filter_company != CompanyID::Invalid() && st->owner != filter_company) continue;
 
 		nlohmann::json station_json;
 		station_json["id"] = st->index.base();
-		station_json["name"] = StrMakeValid(st->GetCachedName());
-		station_json["owner"] = st->owner != CompanyID::Invalid() ? st->owner.base() : -1;
-		station_json["location"] = {
-			{"tile", st->xy != INVALID_TILE ? st->xy.base() : 0},
-			{"x", TileX(st->xy)},
-			{"y", TileY(st->xy)}
-		};
-
-		nlohmann::json facilities = nlohmann::json::array();
-		if (st->facilities.Test(StationFacility::Train)) facilities.push_back("train");
-		if (st->facilities.Test(StationFacility::TruckStop)) facilities.push_back("truck");
-		if (st->facilities.Test(StationFacility::BusStop)) facilities.push_back("bus");
-		if (st->facilities.Test(StationFacility::Airport)) facilities.push_back("airport");
-		if (st->facilities.Test(StationFacility::Dock)) facilities.push_back("dock");
-		station_json["facilities"] = facilities;
-
-		int total_waiting = 0;
-		for (CargoType c = 0; c < NUM_CARGO; c++) {
-			total_waiting += st->goods[c].TotalCount();
+		if (fields.Has("name")) station_json["name"] = StrMakeValid(st->GetCachedName());
+		if (fields.Has("owner")) station_json["owner"] = st->owner != CompanyID::Invalid() ? st->owner.base() : -1;
+		if (fields.Has("location")) {
+			station_json["location"] = {
+				{"tile", st->xy != INVALID_TILE ? st->xy.base() : 0},
+				{"x", TileX(st->xy)},
+				{"y", TileY(st->xy)}
+			};
+		}
+
+		if (fields.Has("facilities")) {
+			nlohmann::json facilities = nlohmann::json::array();
+			if (st->facilities.Test(StationFacility::Train)) facilities.push_back("train");
+			if (st->facilities.Test(StationFacility::TruckStop)) facilities.push_back("truck");
+			if (st->facilities.Test(StationFacility::BusStop)) facilities.push_back("bus");
+			if (st->facilities.Test(StationFacility::Airport)) facilities.push_back("airport");
+			if (st->facilities.Test(StationFacility::Dock)) facilities.push_back("dock");
+			station_json["facilities"] = facilities;
+		}
+
+		if (fields.Has("cargo_waiting_total")) {
+			int total_waiting = 0;
+			for (CargoType c = 0; c < NUM_CARGO; c++) {
+				total_waiting += st->goods[c].TotalCount();
+			}
+			station_json["cargo_waiting_total"] = total_waiting;
 		}
-		station_json["cargo_waiting_total"] = total_waiting;
 
 		result.push_back(station_json);
 	}
@@ -463,6 +656,13 @@ static nlohmann::json HandleStationGet(const nlohmann::json &params)
 	return result;
 }
 
+/**
+ * Handler for industry.list.
+ *
+ * Parameters:
+ *   type: Optional industry type filter
+ *   fields: Optional array (or comma separated string) of the fields to return; id is always included
+ */
 static nlohmann::json HandleIndustryList(const nlohmann::json &params)
 {
 	nlohmann::json result = nlohmann::json::array();
@@ -472,55 +672,63 @@ static nlohmann::json HandleIndustryList(const nlohmann::json &params)
 		filter_type = params["type"].get<int>();
 	}
 
+	RpcFieldSet fields(params);
+
 	for (const Industry *ind : Industry::Iterate()) {
 		if (filter_type >= 0 && ind->type != filter_type) continue;
 
 		nlohmann::json industry_json;
 		industry_json["id"] = ind->index.base();
-		industry_json["type"] = ind->type;
-		industry_json["name"] = StrMakeValid(GetString(STR_INDUSTRY_NAME, ind->index));
-		industry_json["location"] = {
-			{"tile", ind->location.tile != INVALID_TILE ? ind->location.tile.base() : 0},
-			{"x", TileX(ind->location.tile)},
-			{"y", TileY(ind->location.tile)}
-		};
-		if (ind->town != nullptr) {
+		if (fields.Has("type")) industry_json["type"] = ind->type;
+		if (fields.Has("name")) industry_json["name"] = StrMakeValid(GetString(STR_INDUSTRY_NAME, ind->index));
+		if (fields.Has("location")) {
+			industry_json["location"] = {
+				{"tile", ind->location.tile != INVALID_TILE ? ind->location.tile.base() : 0},
+				{"x", TileX(ind->location.tile)},
+				{"y", TileY(ind->location.tile)}
+			};
+		}
+		if (ind->town != nullptr && fields.Has("town")) {
 			industry_json["town"] = StrMakeValid(GetString(STR_TOWN_NAME, ind->town->index));
 		}
-		industry_json["production_level"] = ind->prod_level;
+		if (fields.Has("production_level")) industry_json["production_level"] = ind->prod_level;
 
-		nlohmann::json produces = nlohmann::json::array();
-		for (const auto &p : ind->produced) {
-			if (!IsValidCargoType(p.cargo)) continue;
-			const CargoSpec *cs = CargoSpec::Get(p.cargo);
-			if (!cs->IsValid()) continue;
+		if (fields.Has("produces")) {
+			nlohmann::json produces = nlohmann::json::array();
+			for (const auto &p : ind->produced) {
+				if (!IsValidCargoType(p.cargo)) continue;
+				const CargoSpec *cs = CargoSpec::Get(p.cargo);
+				if (!cs->IsValid()) continue;
 
-			nlohmann::json cargo_json;
-			cargo_json["cargo_id"] = p.cargo;
-			cargo_json["cargo_name"] = StrMakeValid(GetString(cs->name));
-			cargo_json["waiting"] = p.waiting;
-			cargo_json["rate"] = p.rate;
-			if (!p.history.empty()) {
-				cargo_json["last_month_production"] = p.history[0].production;
-				cargo_json["last_month_transported"] = p.history[0].transported;
+				nlohmann::json cargo_json;
+				cargo_json["cargo_id"] = p.cargo;
+				cargo_json["cargo_name"] = StrMakeValid(GetString(cs->name));
+				cargo_json["waiting"] = p.waiting;
+				cargo_json["rate"] = p.rate;
+				if (!p.history.empty()) {
+					cargo_json["last_month_production"] = p.history[0].production;
+					cargo_json["last_month_transported"] = p.history[0].transported;
+				}
+				produces.push_back(cargo_json);
 			}
-			produces.push_back(cargo_json);
+			industry_json["produces"] = produces;
 		}
-		industry_json["produces"] = produces;
 
-		nlohmann::json accepts = nlohmann::json::array();
-		for (const auto &a : ind->accepted) {
-			if (!IsValidCargoType(a.cargo)) continue;
-			const CargoSpec *cs = CargoSpec::Get(a.cargo);
-			if (!cs->IsValid()) continue;
+		if (fields.Has("accepts")) {
+			nlohmann::json accepts = nlohmann::json::array();
+			for (const auto &a : ind->accepted) {
+				if (!IsValidCargoType(a.cargo)) continue;
+				const CargoSpec *cs = CargoSpec::Get(a.cargo);
+				if (!cs->IsValid()) continue;
 
-			nlohmann::json cargo_json;
-			cargo_json["cargo_id"] = a.cargo;
-			cargo_json["cargo_name"] = StrMakeValid(GetString(cs->name));
-			cargo_json["waiting"] = a.waiting;
-			accepts.push_back(cargo_json);
+				nlohmann::json cargo_json;
+				cargo_json["cargo_id"] = a.cargo;
+				cargo_json["cargo_name"] = StrMakeValid(GetString(cs->name));
+				cargo_json["waiting"] = a.waiting;
+				accepts.push_back(cargo_json);
+			}
+			industry_json["accepts"] = accepts;
 		}
-		industry_json["accepts"] = accepts;
 
 		result.push_back(industry_json);
 	}
@@ -595,6 +803,32 @@ static nlohmann::json HandleIndustryGet(const nlohmann::json &params)
 	return result;
 }
 
+/**
+ * Get the cargo type of an optional cargo filter parameter.
+ * @param params The request parameters.
+ * @param key Name of the parameter, an ID or a case-insensitive cargo name.
+ * @return The cargo type, or INVALID_CARGO when the parameter is absent.
+ */
+static CargoType ParseCargoFilter(const nlohmann::json &params, const char *key)
+{
+	if (!params.contains(key)) return INVALID_CARGO;
+
+	const nlohmann::json &value = params[key];
+	if (value.is_number()) return static_cast<CargoType>(value.get<int>());
+	if (!value.is_string()) return INVALID_CARGO;
+
+	std::string cargo_name = value.get<std::string>();
+	std::transform(cargo_name.begin(), cargo_name.end(), cargo_name.begin(), ::tolower);
+	for (const CargoSpec *cs : CargoSpec::Iterate()) {
+		if (!cs->IsValid()) continue;
+
+		std::string name = StrMakeValid(GetString(cs->name));
+		std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+		if (name == cargo_name) return cs->Index();
+	}
+	throw std::runtime_error("Unknown cargo type: " + value.get<std::string>());
+}
+
 /**
  * Handler for industry.nearest - Find nearest industry matching criteria.
  *
@@ -619,53 +853,8 @@ static nlohmann::json HandleIndustryNearest(const nlohmann::json &params)
 	TileIndex ref_tile = TileXY(ref_x, ref_y);
 
 	/* Parse cargo filter - can be ID (int) or name (string) */
-	CargoType filter_produces = INVALID_CARGO;
-	CargoType filter_accepts = INVALID_CARGO;
-
-	if (params.contains("produces")) {
-		if (params["produces"].is_number()) {
-			filter_produces = static_cast<CargoType>(params["produces"].get<int>());
-		} else if (params["produces"].is_string()) {
-			std::string cargo_name = params["produces"].get<std::string>();
-			for (const CargoSpec *cs : CargoSpec::Iterate()) {
-				if (cs->IsValid()) {
-					std::string name = StrMakeValid(GetString(cs->name));
-					/* Case-insensitive comparison */
-					std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-					std::transform(cargo_name.begin(), cargo_name.end(), cargo_name.begin(), ::tolower);
-					if (name == cargo_name) {
-						filter_produces = cs->Index();
-						break;
-					}
-				}
-			}
-			if (!IsValidCargoType(filter_produces)) {
-				throw std::runtime_error("Unknown cargo type: " + params["produces"].get<std::string>());
-			}
-		}
-	}
-
-	if (params.contains("accepts")) {
-		if (params["accepts"].is_number()) {
-			filter_accepts = static_cast<CargoType>(params["accepts"].get<int>());
-		} else if (params["accepts"].is_string()) {
-			std::string cargo_name = params["accepts"].get<std::string>();
-			for (const CargoSpec *cs : CargoSpec::Iterate()) {
-				if (cs->IsValid()) {
-					std::string name = StrMakeValid(GetString(cs->name));
-					std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-					std::transform(cargo_name.begin(), cargo_name.end(), cargo_name.begin(), ::tolower);
-					if (name == cargo_name) {
-						filter_accepts = cs->Index();
-						break;
-					}
-				}
-			}
-			if (!IsValidCargoType(filter_accepts)) {
-				throw std::runtime_error("Unknown cargo type: " + params["accepts"].get<std::string>());
-			}
-		}
-	}
+	CargoType filter_produces = ParseCargoFilter(params, "produces");
+	CargoType filter_accepts = ParseCargoFilter(params, "accepts");
 
 	const Industry *nearest = nullptr;
 	uint min_distance = UINT_MAX;
@@ -823,22 +1012,32 @@ static nlohmann::json HandleTileGet(const nlohmann::json &params)
 	return result;
 }
 
-static nlohmann::json HandleTownList([[maybe_unused]] const nlohmann::json &params)
+/**
+ * Handler for town.list.
+ *
+ * Parameters:
+ *   fields: Optional array (or comma separated string) of the fields to return; id is always included
+ */
+static nlohmann::json HandleTownList(const nlohmann::json &params)
 {
 	nlohmann::json result = nlohmann::json::array();
 
+	RpcFieldSet fields(params);
+
 	for (const Town *t : Town::Iterate()) {
 		nlohmann::json town_json;
 		town_json["id"] = t->index.base();
-		town_json["name"] = StrMakeValid(GetString(STR_TOWN_NAME, t->index));
-		town_json["location"] = {
-			{"tile", t->xy != INVALID_TILE ? t->xy.base() : 0},
-			{"x", TileX(t->xy)},
-			{"y", TileY(t->xy)}
-		};
-		town_json["population"] = t->cache.population;
-		town_json["houses"] = t->cache.num_houses;
-		town_json["is_city"] = t->larger_town;
+		if (fields.Has("name")) town_json["name"] = StrMakeValid(GetString(STR_TOWN_NAME, t->index));
+		if (fields.Has("location")) {
+			town_json["location"] = {
+				{"tile", t->xy != INVALID_TILE ? t->xy.base() : 0},
+				{"x", TileX(t->xy)},
+				{"y", TileY(t->xy)}
+			};
+		}
+		if (fields.Has("population")) town_json["population"] = t->cache.population;
+		if (fields.Has("houses")) town_json["houses"] = t->cache.num_houses;
+		if (fields.Has("is_city")) town_json["is_city"] = t->larger_town;
 
 		result.push_back(town_json);
 	}
@@ -916,17 +1115,26 @@ static nlohmann::json HandleTownNearest(const nlohmann::json &params)
 	const Town *nearest = nullptr;
 	uint min_distance = UINT_MAX;
 
-	for (const Town *t : Town::Iterate()) {
-		/* Check population filter */
-		if (t->cache.population < min_pop) continue;
+	if (min_pop == 0 && !require_city) {
+		/* Without filters the town k-d tree gives the same town as the scan below;
+		 * on equal distances both pick the lowest town ID. */
+		if (_town_kdtree.Count() > 0) {
+			nearest = Town::Get(_town_kdtree.FindNearest(ref_x, ref_y));
+			min_distance = DistanceManhattan(ref_tile, nearest->xy);
+		}
+	} else {
+		for (const Town *t : Town::Iterate()) {
+			/* Check population filter */
+			if (t->cache.population < min_pop) continue;
 
-		/* Check city filter */
-		if (require_city && !t->larger_town) continue;
+			/* Check city filter */
+			if (require_city && !t->larger_town) continue;
 
-		uint distance = DistanceManhattan(ref_tile, t->xy);
-		if (distance < min_distance) {
-			min_distance = distance;
-			nearest = t;
+			uint distance = DistanceManhattan(ref_tile, t->xy);
+			if (distance < min_distance) {
+				min_distance = distance;
+				nearest = t;
+			}
 		}
 	}
 
@@ -1027,6 +1235,13 @@ static char GetBlockSymbol(const ScanBlock &block, bool show_traffic)
 	return '.';
 }
 
+/**
+ * Handler for map.scan - Render an overview of an area as a grid of symbols.
+ *
+ * The tile counts of each cell come from the persistent tile summary, and the
+ * traffic overlay only visits the vehicles in the tile hash near the area, so
+ * repeated scans at different zoom levels do not walk every tile.
+ */
 static nlohmann::json HandleMapScan(const nlohmann::json &params)
 {
 	/* Parameters */
@@ -1055,20 +1270,18 @@ static nlohmann::json HandleMapScan(const nlohmann::json &params)
 	result["scan_type"] = scan_type;
 	result["show_traffic"] = show_traffic;
 
-	/* Build vehicle location map for traffic overlay */
-	std::map<uint32_t, int> vehicle_counts;
+	/* Count the vehicles per cell for the traffic overlay, looking only at the vehicles near the scanned area. */
+	std::vector<int> vehicle_counts;
 	if (show_traffic) {
-		for (const Vehicle *v : Vehicle::Iterate()) {
+		vehicle_counts.resize(grid_size * grid_size);
+		int half_span = grid_size * zoom * TILE_SIZE / 2;
+		for (const Vehicle *v : VehiclesNearTileXY(origin_x * TILE_SIZE + half_span, origin_y * TILE_SIZE + half_span, half_span)) {
 			if (!v->IsPrimaryVehicle()) continue;
 			if (v->tile == INVALID_TILE) continue;
-			uint x = TileX(v->tile);
-			uint y = TileY(v->tile);
-			/* Map to block coordinates */
-			int block_x = (x - origin_x) / zoom;
-			int block_y = (y - origin_y) / zoom;
+			int block_x = (static_cast<int>(TileX(v->tile)) - origin_x) / zoom;
+			int block_y = (static_cast<int>(TileY(v->tile)) - origin_y) / zoom;
 			if (block_x >= 0 && block_x < grid_size && block_y >= 0 && block_y < grid_size) {
-				uint32_t key = (block_y << 16) | block_x;
-				vehicle_counts[key]++;
+				vehicle_counts[block_y * grid_size + block_x]++;
 			}
 		}
 	}
@@ -1080,42 +1293,17 @@ static nlohmann::json HandleMapScan(const nlohmann::json &params)
 	for (int gy = 0; gy < grid_size; gy++) {
 		std::string row;
 		for (int gx = 0; gx < grid_size; gx++) {
-			ScanBlock block;
-
-			/* Scan all tiles in this block */
-			for (int dy = 0; dy < zoom; dy++) {
-				for (int dx = 0; dx < zoom; dx++) {
-					int tx = origin_x + gx * zoom + dx;
-					int ty = origin_y + gy * zoom + dy;
-
-					if (tx < 0 || ty < 0 || tx >= (int)Map::SizeX() || ty >= (int)Map::SizeY()) {
-						continue;
-					}
+			TileTypeCounts<uint> counts = CountTileTypes(origin_x + gx * zoom, origin_y + gy * zoom, zoom, zoom);
 
-					TileIndex tile = TileXY(tx, ty);
-					block.total_tiles++;
-
-					TileType type = GetTileType(tile);
-					switch (type) {
-						case MP_RAILWAY: block.rail++; break;
-						case MP_ROAD: block.road++; break;
-						case MP_WATER: block.water++; break;
-						case MP_STATION: block.station++; break;
-						case MP_INDUSTRY: block.industry++; break;
-						case MP_HOUSE: block.house++; break;
-						default: break;
-					}
-				}
-			}
-
-			/* Add vehicle count for this block */
-			if (show_traffic) {
-				uint32_t key = (gy << 16) | gx;
-				auto it = vehicle_counts.find(key);
-				if (it != vehicle_counts.end()) {
-					block.vehicles = it->second;
-				}
-			}
+			ScanBlock block;
+			block.rail = counts[MP_RAILWAY];
+			block.road = counts[MP_ROAD];
+			block.water = counts[MP_WATER];
+			block.station = counts[MP_STATION];
+			block.industry = counts[MP_INDUSTRY];
+			block.house = counts[MP_HOUSE];
+			for (uint count : counts) block.total_tiles += count;
+			if (show_traffic) block.vehicles = vehicle_counts[gy * grid_size + gx];
 
 			char symbol = GetBlockSymbol(block, show_traffic);
 			row += symbol;
@@ -1206,9 +1394,11 @@ static nlohmann::json HandleMapTerrain(const nlohmann::json &params)
 	int current_water_run = 0;
 	int max_water_run = 0;
 
-	/* Scan the rectangular region */
+	/* Scan the rectangular region, getting the slopes a row at a time. */
+	std::vector<TileSlopeZ> slopes(x2 - x1 + 1);
 	for (int y = y1; y <= y2; y++) {
 		current_water_run = 0;
+		GetTileSlopesInRect(TileXY(x1, y), x2 - x1 + 1, 1, slopes);
 		for (int x = x1; x <= x2; x++) {
 			TileIndex tile = TileXY(x, y);
 			total_tiles++;
@@ -1217,7 +1407,7 @@ static nlohmann::json HandleMapTerrain(const nlohmann::json &params)
 			if (height < min_height) min_height = height;
 			if (height > max_height) max_height = height;
 
-			Slope slope = GetTileSlope(tile);
+			Slope slope = slopes[x - x1].slope;
 			if (slope == SLOPE_FLAT) {
 				flat_tiles++;
 			} else {
@@ -1325,6 +1515,174 @@ static nlohmann::json HandleMapTerrain(const nlohmann::json &params)
 	return result;
 }
 
+static constexpr uint MAX_REGION_TILES = 512 * 512; ///< Largest number of tiles map.region returns in one call.
+static constexpr uint REGION_TILE_SIZE = 5; ///< Number of bytes per tile in a map.region record.
+
+/**
+ * Get the transport bits of a tile for map.region.
+ * @param tile The tile.
+ * @return Track bits of plain rail, road bits with the tram bits in the upper nibble for
+ *         normal roads, the transport type with the direction in bits 2..3 for tunnels and
+ *         bridges, the water class for water, and 0 for everything else.
+ */
+static uint8_t GetRegionTransportBits(TileIndex tile)
+{
+	switch (GetTileType(tile)) {
+		case MP_RAILWAY:
+			return IsPlainRail(tile) ? GetTrackBits(tile) : 0;
+
+		case MP_ROAD:
+			if (!IsNormalRoad(tile)) return 0;
+			return GetRoadBits(tile, RTT_ROAD) | (GetRoadBits(tile, RTT_TRAM) << 4);
+
+		case MP_TUNNELBRIDGE:
+			return GetTunnelBridgeTransportType(tile) | (GetTunnelBridgeDirection(tile) << 2);
+
+		case MP_WATER:
+			return to_underlying(GetWaterClass(tile));
+
+		default:
+			return 0;
+	}
+}
+
+/**
+ * Encode bytes as base64, for clients on the JSON encoding.
+ * @param data The bytes.
+ * @return The base64 string, with padding.
+ */
+static std::string EncodeBase64(const std::vector<uint8_t> &data)
+{
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	std::string out;
+	out.reserve((data.size() + 2) / 3 * 4);
+	for (size_t i = 0; i < data.size(); i += 3) {
+		uint32_t block = data[i] << 16;
+		if (i + 1 < data.size()) block |= data[i + 1] << 8;
+		if (i + 2 < data.size()) block |= data[i + 2];
+
+		out += alphabet[GB(block, 18, 6)];
+		out += alphabet[GB(block, 12, 6)];
+		out += (i + 1 < data.size()) ? alphabet[GB(block, 6, 6)] : '=';
+		out += (i + 2 < data.size()) ? alphabet[GB(block, 0, 6)] : '=';
+	}
+	return out;
+}
+
+/**
+ * Handler for map.region - Get the layout of a rectangle of tiles in one call.
+ *
+ * Parameters:
+ *   x1, y1: Start coordinates (required)
+ *   x2, y2: End coordinates, inclusive (required)
+ *   base64: Return the data as base64 string instead of binary (optional, default false)
+ *
+ * Returns the tiles row by row, REGION_TILE_SIZE bytes each: tile type, height, slope,
+ * owner (0xFF for houses, industries and void tiles) and the transport bits of GetRegionTransportBits.
+ * The data is a binary value, which is a byte string on the msgpack and CBOR encodings;
+ * on the JSON encoding use base64 to avoid it becoming an array of numbers.
+ * Only the tile records are made on the game thread; encoding them is left to the
+ * RPC serialisation thread.
+ */
+static RpcResultBuilder HandleMapRegion(const nlohmann::json &params)
+{
+	if (!params.contains("x1") || !params.contains("y1") ||
+	    !params.contains("x2") || !params.contains("y2")) {
+		throw std::runtime_error("Missing required parameters: x1, y1, x2, y2");
+	}
+
+	int x1 = params["x1"].get<int>();
+	int y1 = params["y1"].get<int>();
+	int x2 = params["x2"].get<int>();
+	int y2 = params["y2"].get<int>();
+
+	if (x1 < 0 || y1 < 0 || x2 < 0 || y2 < 0 ||
+	    x1 >= (int)Map::SizeX() || y1 >= (int)Map::SizeY() ||
+	    x2 >= (int)Map::SizeX() || y2 >= (int)Map::SizeY()) {
+		throw std::runtime_error("Coordinates out of bounds");
+	}
+
+	if (x1 > x2) std::swap(x1, x2);
+	if (y1 > y2) std::swap(y1, y2);
+
+	uint width = x2 - x1 + 1;
+	uint height = y2 - y1 + 1;
+	if (width * height > MAX_REGION_TILES) {
+		throw std::runtime_error(fmt::format("Region too large, at most {} tiles per call", MAX_REGION_TILES));
+	}
+
+	std::vector<TileSlopeZ> slopes(width * height);
+	GetTileSlopesInRect(TileXY(x1, y1), width, height, slopes);
+
+	std::vector<uint8_t> data;
+	data.reserve(width * height * REGION_TILE_SIZE);
+	auto slope = slopes.begin();
+	for (int y = y1; y <= y2; y++) {
+		for (int x = x1; x <= x2; x++, ++slope) {
+			TileIndex tile = TileXY(x, y);
+			TileType tt = GetTileType(tile);
+
+			/* GetTileOwner asserts on houses, industries and the void border of the map. */
+			uint8_t owner = 0xFF;
+			if (tt != MP_HOUSE && tt != MP_INDUSTRY && tt != MP_VOID) owner = GetTileOwner(tile).base();
+
+			data.push_back(tt);
+			data.push_back(TileHeight(tile));
+			data.push_back(slope->slope);
+			data.push_back(owner);
+			data.push_back(GetRegionTransportBits(tile));
+		}
+	}
+
+	return [data = std::move(data), x1, y1, width, height, base64 = params.value("base64", false)]() mutable {
+		nlohmann::json result;
+		result["x"] = x1;
+		result["y"] = y1;
+		result["width"] = width;
+		result["height"] = height;
+		result["tile_size"] = REGION_TILE_SIZE;
+		result["fields"] = {"type", "height", "slope", "owner", "transport"};
+		if (base64) {
+			result["data"] = EncodeBase64(data);
+		} else {
+			result["data"] = nlohmann::json::binary(std::move(data));
+		}
+		return result;
+	};
+}
+
+/** Responses of engine.list and engine.get, per company. */
+struct RpcEngineCache {
+	uint32_t generation = 0; ///< Value of #_rpc_engine_cache_generation the responses are valid for.
+	std::map<std::tuple<CompanyID, VehicleType, bool>, nlohmann::json> lists; ///< engine.list responses by company, type filter and buildable_only.
+	std::map<std::pair<EngineID, CompanyID>, nlohmann::json> engines; ///< engine.get responses by engine and company.
+};
+
+/** Incremented whenever engines, their availability or their properties may have changed. */
+static uint32_t _rpc_engine_cache_generation = 1;
+static RpcEngineCache _rpc_engine_cache;
+
+/** Invalidate all cached engine.list and engine.get responses. */
+void RpcInvalidateEngineCache()
+{
+	_rpc_engine_cache_generation++;
+}
+
+/**
+ * Get the engine response cache, dropping its responses when they are out of date.
+ * @return The cache, valid for the current engines.
+ */
+static RpcEngineCache &GetEngineCache()
+{
+	if (_rpc_engine_cache.generation != _rpc_engine_cache_generation) {
+		_rpc_engine_cache.lists.clear();
+		_rpc_engine_cache.engines.clear();
+		_rpc_engine_cache.generation = _rpc_engine_cache_generation;
+	}
+	return _rpc_engine_cache;
+}
+
 /**
  * Handler for engine.list - List available engines.
  *
@@ -1353,6 +1711,15 @@ static nlohmann::json HandleEngineList(const nlohmann::json &params)
 		else if (type_str == "aircraft") filter_type = VEH_AIRCRAFT;
 	}
 
+	/* The list only changes when engines or their availability do; only existing companies are cached, as new ones invalidate the cache. */
+	bool cacheable = Company::IsValidID(company);
+	auto key = std::make_tuple(company, filter_type, buildable_only);
+	if (cacheable) {
+		RpcEngineCache &cache = GetEngineCache();
+		auto it = cache.lists.find(key);
+		if (it != cache.lists.end()) return it->second;
+	}
+
 	for (const Engine *e : Engine::Iterate()) {
 		if (!e->IsEnabled()) continue;
 		if (filter_type != VEH_INVALID && e->type != filter_type) continue;
@@ -1413,6 +1780,7 @@ static nlohmann::json HandleEngineList(const nlohmann::json &params)
 		result.push_back(engine_json);
 	}
 
+	if (cacheable) GetEngineCache().lists.emplace(key, result);
 	return result;
 }
 
@@ -1438,7 +1806,15 @@ static nlohmann::json HandleEngineGet(const nlohmann::json &params)
 	}
 
 	CompanyID company = static_cast<CompanyID>(params.value("company", 0));
-	bool is_buildable = Company::IsValidID(company) && IsEngineBuildable(e->index, e->type, company);
+	bool cacheable = Company::IsValidID(company);
+	auto key = std::make_pair(e->index, company);
+	if (cacheable) {
+		RpcEngineCache &cache = GetEngineCache();
+		auto it = cache.engines.find(key);
+		if (it != cache.engines.end()) return it->second;
+	}
+
+	bool is_buildable = cacheable && IsEngineBuildable(e->index, e->type, company);
 
 	nlohmann::json result;
 	result["id"] = e->index.base();
@@ -1510,6 +1886,7 @@ static nlohmann::json HandleEngineGet(const nlohmann::json &params)
 		result["refit_cargos"] = refit_cargos;
 	}
 
+	if (cacheable) GetEngineCache().engines.emplace(key, result);
 	return result;
 }
 
@@ -1968,7 +2345,7 @@ static nlohmann::json HandleStationGetCoverage(const nlohmann::json &params)
 	}
 
 	StationID sid = static_cast<StationID>(params["id"].get<int>());
-	const Station *st = Station::GetIfValid(sid);
+	Station *st = Station::GetIfValid(sid);
 	if (st == nullptr) {
 		throw std::runtime_error("Invalid station ID");
 	}
@@ -2012,16 +2389,16 @@ static nlohmann::json HandleStationGetCoverage(const nlohmann::json &params)
 	}
 	result["industries"] = industries;
 
-	/* Get towns within catchment */
+	/* Get towns within catchment. Every town keeps the stations whose catchment covers
+	 * one of its houses up to date, so the catchment does not have to be walked. */
 	nlohmann::json towns = nlohmann::json::array();
 	for (const Town *t : Town::Iterate()) {
-		if (st->CatchmentCoversTown(t->index)) {
-			nlohmann::json town_json;
-			town_json["id"] = t->index.base();
-			town_json["name"] = StrMakeValid(GetString(STR_TOWN_NAME, t->index));
-			town_json["population"] = t->cache.population;
-			towns.push_back(town_json);
-		}
+		if (!t->stations_near.contains(st)) continue;
+		nlohmann::json town_json;
+		town_json["id"] = t->index.base();
+		town_json["name"] = StrMakeValid(GetString(STR_TOWN_NAME, t->index));
+		town_json["population"] = t->cache.population;
+		towns.push_back(town_json);
 	}
 	result["towns"] = towns;
 
@@ -2036,24 +2413,9 @@ static nlohmann::json HandleStationGetCoverage(const nlohmann::json &params)
 
 		const GoodsEntry &ge = st->goods[c];
 
-		/* Check if station accepts this cargo */
-		if (IsCargoInClass(c, CargoClass::Passengers) || IsCargoInClass(c, CargoClass::Mail)) {
-			/* Passengers and mail are accepted if any town is in catchment */
-			if (!towns.empty()) {
-				accepts.push_back(StrMakeValid(GetString(cs->name)));
-			}
-		} else {
-			/* Other cargo - check if any industry accepts it */
-			for (const IndustryListEntry &entry : st->industries_near) {
-				const Industry *ind = entry.industry;
-				for (const auto &a : ind->accepted) {
-					if (a.cargo == c) {
-						accepts.push_back(StrMakeValid(GetString(cs->name)));
-						goto next_cargo_accept;
-					}
-				}
-			}
-			next_cargo_accept:;
+		/* The acceptance of the catchment is kept up to date by UpdateStationAcceptance. */
+		if (ge.status.Test(GoodsEntry::State::Acceptance)) {
+			accepts.push_back(StrMakeValid(GetString(cs->name)));
 		}
 
 		/* Check if cargo is waiting (means it can be picked up here) */
@@ -2225,32 +2587,6 @@ static nlohmann::json HandleAirportInfo(const nlohmann::json &params)
 	return result;
 }
 
-/**
- * Convert NewsType to a string.
- */
-static const char *NewsTypeToString(NewsType type)
-{
-	switch (type) {
-		case NewsType::ArrivalCompany: return "arrival_company";
-		case NewsType::ArrivalOther: return "arrival_other";
-		case NewsType::Accident: return "accident";
-		case NewsType::AccidentOther: return "accident_other";
-		case NewsType::CompanyInfo: return "company_info";
-		case NewsType::IndustryOpen: return "industry_open";
-		case NewsType::IndustryClose: return "industry_close";
-		case NewsType::Economy: return "economy";
-		case NewsType::IndustryCompany: return "industry_company";
-		case NewsType::IndustryOther: return "industry_other";
-		case NewsType::IndustryNobody: return "industry_nobody";
-		case NewsType::Advice: return "advice";
-		case NewsType::NewVehicles: return "new_vehicles";
-		case NewsType::Acceptance: return "acceptance";
-		case NewsType::Subsidies: return "subsidies";
-		case NewsType::General: return "general";
-		default: return "unknown";
-	}
-}
-
 /**
  * Convert AdviceType to a string.
  */
@@ -2321,7 +2657,7 @@ static nlohmann::json HandleCompanyAlerts(const nlohmann::json &params)
 		}
 
 		nlohmann::json alert;
-		alert["type"] = NewsTypeToString(item.type);
+		alert["type"] = RpcNewsTypeToString(item.type);
 		alert["advice_type"] = AdviceTypeToString(item.advice_type);
 		alert["date"] = item.date.base();
 		alert["message"] = item.GetStatusText();
@@ -2350,107 +2686,6 @@ static nlohmann::json HandleCompanyAlerts(const nlohmann::json &params)
 	return result;
 }
 
-/**
- * Check if a road tile is connected to the road network.
- * Uses flood fill to find if we can reach from start to target.
- */
-static bool IsRoadConnected(TileIndex start, TileIndex target, int max_tiles = 1000)
-{
-	if (start == target) return true;
-	if (!IsValidTile(start) || !IsValidTile(target)) return false;
-
-	/* Simple BFS to check connectivity */
-	std::vector<TileIndex> queue;
-	std::set<uint32_t> visited;
-
-	queue.push_back(start);
-	visited.insert(start.base());
-
-	int tiles_checked = 0;
-
-	while (!queue.empty() && tiles_checked < max_tiles) {
-		TileIndex current = queue.back();
-		queue.pop_back();
-		tiles_checked++;
-
-		if (current == target) return true;
-
-		/* Check all 4 directions */
-		for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
-			TileIndex next = TileAddByDiagDir(current, dir);
-			if (!IsValidTile(next)) continue;
-			if (visited.count(next.base())) continue;
-
-			/* Check if the next tile has road */
-			bool has_road = false;
-			if (IsTileType(next, MP_ROAD)) {
-				has_road = true;
-			} else if (IsTileType(next, MP_STATION)) {
-				/* Road stops are also valid road tiles */
-				if (IsStationRoadStopTile(next) || IsRoadWaypointTile(next)) {
-					has_road = true;
-				}
-			}
-
-			if (has_road) {
-				visited.insert(next.base());
-				queue.push_back(next);
-			}
-		}
-	}
-
-	return false;
-}
-
-/**
- * Check if a rail tile is connected to another via rail.
- */
-static bool IsRailConnected(TileIndex start, TileIndex target, int max_tiles = 1000)
-{
-	if (start == target) return true;
-	if (!IsValidTile(start) || !IsValidTile(target)) return false;
-
-	std::vector<TileIndex> queue;
-	std::set<uint32_t> visited;
-
-	queue.push_back(start);
-	visited.insert(start.base());
-
-	int tiles_checked = 0;
-
-	while (!queue.empty() && tiles_checked < max_tiles) {
-		TileIndex current = queue.back();
-		queue.pop_back();
-		tiles_checked++;
-
-		if (current == target) return true;
-
-		/* Check all 4 directions */
-		for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
-			TileIndex next = TileAddByDiagDir(current, dir);
-			if (!IsValidTile(next)) continue;
-			if (visited.count(next.base())) continue;
-
-			/* Check if the next tile has rail */
-			bool has_rail = false;
-			if (IsTileType(next, MP_RAILWAY)) {
-				has_rail = true;
-			} else if (IsTileType(next, MP_STATION)) {
-				if (IsRailStationTile(next)) {
-					has_rail = true;
-				}
-			}
-
-			if (has_rail) {
-				visited.insert(next.base());
-				queue.push_back(next);
-			}
-		}
-	}
-
-	return false;
-}
-
 /**
  * Handler for route.check - Check if two tiles are connected for a given transport type.
  *
@@ -2459,6 +2694,9 @@ static bool IsRailConnected(TileIndex start, TileIndex target, int max_tiles = 1
  *   end_tile or end_x/end_y: Ending tile (required)
  *   transport_type: "road", "rail", "water" (required)
  *
+ * Road and rail connectivity is answered from cached connected components, so
+ * repeated checks on the same network are cheap. Water is not checked.
+ *
  * Returns:
  *   connected: Whether the tiles are connected
  *   start_tile: The starting tile
@@ -2511,34 +2749,23 @@ static nlohmann::json HandleRouteCheck(const nlohmann::json &params)
 	std::string error;
 
 	if (transport_type == "road") {
-		/* Check if start tile has road */
-		bool start_has_road = IsTileType(start_tile, MP_ROAD) ||
-			(IsTileType(start_tile, MP_STATION) && (IsStationRoadStopTile(start_tile) || IsRoadWaypointTile(start_tile)));
-		bool end_has_road = IsTileType(end_tile, MP_ROAD) ||
-			(IsTileType(end_tile, MP_STATION) && (IsStationRoadStopTile(end_tile) || IsRoadWaypointTile(end_tile)));
-
-		if (!start_has_road) {
+		if (!RpcTileHasRoad(start_tile)) {
 			error = "Start tile does not have road";
-		} else if (!end_has_road) {
+		} else if (!RpcTileHasRoad(end_tile)) {
 			error = "End tile does not have road";
 		} else {
-			connected = IsRoadConnected(start_tile, end_tile);
+			connected = RpcIsRoadConnected(start_tile, end_tile);
 			if (!connected) {
 				error = "Tiles are not connected by road";
 			}
 		}
 	} else if (transport_type == "rail") {
-		bool start_has_rail = IsTileType(start_tile, MP_RAILWAY) ||
-			(IsTileType(start_tile, MP_STATION) && IsRailStationTile(start_tile));
-		bool end_has_rail = IsTileType(end_tile, MP_RAILWAY) ||
-			(IsTileType(end_tile, MP_STATION) && IsRailStationTile(end_tile));
-
-		if (!start_has_rail) {
+		if (!RpcTileHasRail(start_tile)) {
 			error = "Start tile does not have rail";
-		} else if (!end_has_rail) {
+		} else if (!RpcTileHasRail(end_tile)) {
 			error = "End tile does not have rail";
 		} else {
-			connected = IsRailConnected(start_tile, end_tile);
+			connected = RpcIsRailConnected(start_tile, end_tile);
 			if (!connected) {
 				error = "Tiles are not connected by rail";
 			}
@@ -2571,12 +2798,164 @@ static nlohmann::json HandleRouteCheck(const nlohmann::json &params)
 	return result;
 }
 
+/**
+ * Convert the statistics of a number of pathfinder searches to JSON.
+ * @param stats The statistics.
+ * @return The statistics as JSON object.
+ */
+static nlohmann::json PathfinderStatsToJson(const YapfSearchStats &stats)
+{
+	uint64_t cost_calcs = stats.cache_hits + stats.cache_misses;
+
+	nlohmann::json histogram = nlohmann::json::array();
+	for (uint i = 0; i < YapfSearchStats::TIME_BUCKETS; i++) {
+		uint64_t limit = YapfSearchStats::GetTimeBucketLimit(i);
+		histogram.push_back({
+			{"max_us", limit == UINT64_MAX ? nlohmann::json(nullptr) : nlohmann::json(limit)},
+			{"count", stats.time_histogram[i]}
+		});
+	}
+
+	return {
+		{"searches", stats.searches},
+		{"paths_found", stats.paths_found},
+		{"nodes_opened", stats.nodes_opened},
+		{"nodes_closed", stats.nodes_closed},
+		{"cache_hits", stats.cache_hits},
+		{"cache_misses", stats.cache_misses},
+		{"cache_hit_rate", cost_calcs == 0 ? 0.0 : static_cast<double>(stats.cache_hits) / cost_calcs},
+		{"node_limit_reached", stats.node_limit_reached},
+		{"total_time_us", stats.total_time},
+		{"time_histogram", histogram}
+	};
+}
+
+/**
+ * Handler for pathfinder.stats - Statistics of the pathfinder searches since the game started or the last reset.
+ *
+ * Parameters:
+ *   company: Only report this company (optional)
+ *   reset: Clear the statistics after reporting them (optional, default false)
+ *
+ * Returns per vehicle type (train, road, ship) the totals and the statistics per company.
+ * The time histogram gives the number of searches per duration bucket; the
+ * last bucket has no upper limit.
+ */
+static nlohmann::json HandlePathfinderStats(const nlohmann::json &params)
+{
+	std::optional<CompanyID> company;
+	if (params.contains("company")) {
+		company = static_cast<CompanyID>(params["company"].get<int>());
+		if (!Company::IsValidID(*company)) throw std::runtime_error("Invalid company ID");
+	}
+
+	nlohmann::json result;
+	for (VehicleType type : {VEH_TRAIN, VEH_ROAD, VEH_SHIP}) {
+		nlohmann::json type_json;
+		if (!company.has_value()) type_json["total"] = PathfinderStatsToJson(YapfGetTotalSearchStats(type));
+
+		nlohmann::json companies = nlohmann::json::array();
+		for (const Company *c : Company::Iterate()) {
+			if (company.has_value() && c->index != *company) continue;
+			nlohmann::json company_json = PathfinderStatsToJson(YapfGetSearchStats(type, c->index));
+			company_json["company"] = c->index.base();
+			companies.push_back(company_json);
+		}
+		type_json["companies"] = companies;
+
+		result[RpcVehicleTypeToString(type)] = type_json;
+	}
+
+	if (params.value("reset", false)) YapfResetSearchStats();
+
+	return result;
+}
+
+/**
+ * Handler for newgrf.stats - Cost of the NewGRF callbacks since the collection started or the last reset.
+ *
+ * The statistics are only collected while switched on with the collect parameter,
+ * as measuring every callback costs time.
+ *
+ * Parameters:
+ *   collect: Switch the collection of the statistics on or off (optional)
+ *   reset: Clear the statistics after reporting them (optional, default false)
+ *
+ * Returns one entry per NewGRF, feature and callback, the most expensive first.
+ * Callback 0 is the regular graphics lookup. Times are in nanoseconds and
+ * include the callbacks nested in the measured one.
+ */
+static nlohmann::json HandleNewGRFStats(const nlohmann::json &params)
+{
+	if (params.contains("collect")) SetNewGRFCallbackStatsEnabled(params["collect"].get<bool>());
+
+	NewGRFCallbackStatsMap all_stats = GetNewGRFCallbackStats();
+	std::vector<NewGRFCallbackStatsMap::const_pointer> sorted;
+	for (const auto &entry : all_stats) sorted.push_back(&entry);
+	std::ranges::stable_sort(sorted, std::greater{}, [](const auto *entry) { return entry->second.total_time; });
+
+	nlohmann::json result = nlohmann::json::array();
+	for (const auto *entry : sorted) {
+		const auto &[grfid, feature, callback] = entry->first;
+		const NewGRFCallbackStats &stats = entry->second;
+		result.push_back({
+			{"grfid", fmt::format("{:08X}", std::byteswap(grfid))},
+			{"feature", static_cast<int>(feature)},
+			{"callback", static_cast<int>(callback)},
+			{"calls", stats.calls},
+			{"total_time_ns", stats.total_time},
+			{"max_time_ns", stats.max_time}
+		});
+	}
+
+	if (params.value("reset", false)) ResetNewGRFCallbackStats();
+
+	return result;
+}
+
+/**
+ * Handler for spritecache.stats - Memory use and hit rate of the sprite cache.
+ *
+ * Parameters:
+ *   reset: Clear the hit, miss and eviction counters after reporting them (optional, default false)
+ *
+ * Returns the bytes in use and the target size, and per sprite type the cached
+ * sprites and bytes, the hits and misses, and the evicted sprites and bytes.
+ */
+static nlohmann::json HandleSpriteCacheStats(const nlohmann::json &params)
+{
+	static const char * const sprite_types[] = { "normal", "mapgen", "font", "recolour" };
+
+	auto [used, target] = GetSpriteCacheUsage();
+	nlohmann::json result;
+	result["bytes_used"] = used;
+	result["target_bytes"] = target;
+	result["types"] = nlohmann::json::array();
+
+	const SpriteCacheStatsArray &stats = GetSpriteCacheStats();
+	for (size_t type = 0; type < stats.size(); type++) {
+		result["types"].push_back({
+			{"type", sprite_types[type]},
+			{"sprites", stats[type].sprites},
+			{"bytes", stats[type].bytes},
+			{"hits", stats[type].hits},
+			{"misses", stats[type].misses},
+			{"evictions", stats[type].evictions},
+			{"evicted_bytes", stats[type].evicted_bytes}
+		});
+	}
+
+	if (params.value("reset", false)) ResetSpriteCacheStats();
+
+	return result;
+}
+
 void RpcRegisterQueryHandlers(RpcServer &server)
 {
 	server.RegisterHandler("ping", HandlePing);
 	server.RegisterHandler("game.status", HandleGameStatus);
 	server.RegisterHandler("company.list", HandleCompanyList);
-	server.RegisterHandler("vehicle.list", HandleVehicleList);
+	server.RegisterDeferredHandler("vehicle.list", HandleVehicleList);
 	server.RegisterHandler("vehicle.get", HandleVehicleGet);
 	server.RegisterHandler("station.list", HandleStationList);
 	server.RegisterHandler("station.get", HandleStationGet);
@@ -2587,6 +2966,7 @@ void RpcRegisterQueryHandlers(RpcServer &server)
 	server.RegisterHandler("map.distance", HandleMapDistance);
 	server.RegisterHandler("map.scan", HandleMapScan);
 	server.RegisterHandler("map.terrain", HandleMapTerrain);
+	server.RegisterDeferredHandler("map.region", HandleMapRegion);
 	server.RegisterHandler("tile.get", HandleTileGet);
 	server.RegisterHandler("town.list", HandleTownList);
 	server.RegisterHandler("town.get", HandleTownGet);
@@ -2607,4 +2987,7 @@ void RpcRegisterQueryHandlers(RpcServer &server)
 	server.RegisterHandler("airport.info", HandleAirportInfo);
 	server.RegisterHandler("company.alerts", HandleCompanyAlerts);
 	server.RegisterHandler("route.check", HandleRouteCheck);
+	server.RegisterHandler("pathfinder.stats", HandlePathfinderStats);
+	server.RegisterHandler("newgrf.stats", HandleNewGRFStats);
+	server.RegisterHandler("spritecache.stats", HandleSpriteCacheStats);
 }
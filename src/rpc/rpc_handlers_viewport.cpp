@@ -42,6 +42,25 @@ static std::deque<ActivityRecord> _activity_log;
 /** Mutex for thread-safe activity log access. */
 static std::mutex _activity_mutex;
 
+/** Shortest time between two camera moves, so requests of several agents do not make the camera jitter. */
+static constexpr std::chrono::milliseconds RPC_CAMERA_MIN_INTERVAL{500};
+
+/**
+ * Camera move of the main viewport requested by viewport.goto or viewport.follow.
+ * Requests are not applied immediately but merged: the last request wins, and it
+ * is applied by #RpcApplyCameraRequest at most once every #RPC_CAMERA_MIN_INTERVAL.
+ */
+struct RpcCameraRequest {
+	bool pending = false; ///< Whether there is a request to apply.
+	TileIndex tile = INVALID_TILE; ///< Tile to scroll to, when not following a vehicle.
+	VehicleID vehicle = VehicleID::Invalid(); ///< Vehicle to follow, if any.
+	bool stop_follow = false; ///< Stop following a vehicle, leaving the camera where it is.
+	bool instant = false; ///< Jump to #tile instead of scrolling to it.
+};
+
+static RpcCameraRequest _rpc_camera_request;
+static std::chrono::steady_clock::time_point _rpc_camera_last_move;
+
 /**
  * Record an activity at a tile location.
  * Call this from action handlers to track where changes are happening.
@@ -75,6 +94,39 @@ void RpcRecordActivityXY(uint x, uint y, const std::string &action)
 	}
 }
 
+/**
+ * Apply the pending camera request, if any, to the main viewport.
+ * Scrolling to a tile uses the smooth scrolling of the viewport, which only draws the
+ * newly exposed parts each frame, and following a vehicle uses the normal vehicle
+ * following of the viewport.
+ */
+void RpcApplyCameraRequest()
+{
+	if (!_rpc_camera_request.pending) return;
+
+	auto now = std::chrono::steady_clock::now();
+	if (now - _rpc_camera_last_move < RPC_CAMERA_MIN_INTERVAL) return;
+
+	RpcCameraRequest request = std::exchange(_rpc_camera_request, {});
+	_rpc_camera_last_move = now;
+
+	Window *w = FindWindowById(WC_MAIN_WINDOW, 0);
+	if (w == nullptr || w->viewport == nullptr) return;
+
+	if (request.stop_follow) {
+		w->viewport->CancelFollow(*w);
+		w->viewport->dest_scrollpos_x = w->viewport->scrollpos_x;
+		w->viewport->dest_scrollpos_y = w->viewport->scrollpos_y;
+	} else if (request.vehicle != VehicleID::Invalid()) {
+		/* The vehicle may have gone since the request was made. */
+		if (Vehicle::IsValidID(request.vehicle)) w->viewport->follow_vehicle = request.vehicle;
+	} else if (IsValidTile(request.tile)) {
+		/* A goto replaces any earlier follow request; do not let the vehicle pull the camera back. */
+		w->viewport->CancelFollow(*w);
+		ScrollMainWindowToTile(request.tile, request.instant);
+	}
+}
+
 /**
  * Handler for viewport.goto - Scroll the main viewport to a tile.
  *
@@ -83,8 +135,10 @@ void RpcRecordActivityXY(uint x, uint y, const std::string &action)
  *   x, y: Tile coordinates to scroll to (optional if tile provided)
  *   instant: Whether to jump instantly (default: false for smooth scroll)
  *
+ * The scroll is merged with other camera requests and applied after the current poll.
+ *
  * Returns:
- *   success: Whether the scroll was initiated
+ *   success: Whether the scroll was queued
  *   tile: The tile scrolled to
  */
 static nlohmann::json HandleViewportGoto(const nlohmann::json &params)
@@ -110,11 +164,10 @@ static nlohmann::json HandleViewportGoto(const nlohmann::json &params)
 
 	bool instant = params.value("instant", false);
 
-	/* Scroll the main window to the tile */
-	bool success = ScrollMainWindowToTile(tile, instant);
+	_rpc_camera_request = {true, tile, VehicleID::Invalid(), false, instant};
 
 	nlohmann::json result;
-	result["success"] = success;
+	result["success"] = true;
 	result["tile"] = tile.base();
 	result["x"] = TileX(tile);
 	result["y"] = TileY(tile);
@@ -129,8 +182,10 @@ static nlohmann::json HandleViewportGoto(const nlohmann::json &params)
  *   vehicle_id: The vehicle ID to follow
  *   stop: Set to true to stop following (optional)
  *
+ * Like viewport.goto, the request is merged with other camera requests.
+ *
  * Returns:
- *   success: Whether following was initiated
+ *   success: Whether following was queued
  *   vehicle_id: The vehicle being followed (or -1 if stopped)
  */
 static nlohmann::json HandleViewportFollow(const nlohmann::json &params)
@@ -138,15 +193,7 @@ static nlohmann::json HandleViewportFollow(const nlohmann::json &params)
 	nlohmann::json result;
 
 	if (params.value("stop", false)) {
-		/* Stop following - scroll to current position */
-		Window *w = GetMainWindow();
-		if (w != nullptr && w->viewport != nullptr) {
-			/* Reset focus to the current center tile */
-			Point pt = GetTileBelowCursor();
-			if (IsValidTile(TileVirtXY(pt.x, pt.y))) {
-				ScrollMainWindowToTile(TileVirtXY(pt.x, pt.y), true);
-			}
-		}
+		_rpc_camera_request = {true, INVALID_TILE, VehicleID::Invalid(), true, false};
 		result["success"] = true;
 		result["vehicle_id"] = -1;
 		result["following"] = false;
@@ -163,14 +210,11 @@ static nlohmann::json HandleViewportFollow(const nlohmann::json &params)
 		throw std::runtime_error("Invalid vehicle ID");
 	}
 
-	/* Find the main window and set it to follow the vehicle */
-	Window *w = GetMainWindow();
-	if (w == nullptr) {
+	if (FindWindowById(WC_MAIN_WINDOW, 0) == nullptr) {
 		throw std::runtime_error("No main window available");
 	}
 
-	/* Scroll to vehicle's current tile and let the game's normal vehicle following work */
-	ScrollMainWindowToTile(v->tile, false);
+	_rpc_camera_request = {true, INVALID_TILE, vid, false, false};
 
 	result["success"] = true;
 	result["vehicle_id"] = vid.base();
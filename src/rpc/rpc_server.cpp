@@ -9,13 +9,20 @@
 
 #include "../stdafx.h"
 #include "rpc_server.h"
+#include "rpc_handlers.h"
 #include "../debug.h"
+#include "../core/bitmath_func.hpp"
 #include "../network/core/os_abstraction.h"
+#include "../thread.h"
+#include "../console_func.h"
+#include "../framerate_type.h"
 
 #include "../safeguards.h"
 
 static std::unique_ptr<RpcServer> _rpc_server;
 
+static const std::string RPC_UNKNOWN_METHOD = "(unknown)"; ///< Statistics key of the requests for methods that do not exist.
+
 RpcServer::RpcServer() = default;
 
 RpcServer::~RpcServer()
@@ -58,6 +65,7 @@ bool RpcServer::Start(uint16_t port)
 	}
 
 	SetNonBlocking(this->listen_socket);
+	this->StartSerialiseThread();
 
 	Debug(net, 1, "[rpc] JSON-RPC server started on localhost:{}", port);
 	return true;
@@ -65,10 +73,10 @@ bool RpcServer::Start(uint16_t port)
 
 void RpcServer::Stop()
 {
+	this->StopSerialiseThread();
+
 	for (auto &client : this->clients) {
-		if (client.socket != INVALID_SOCKET) {
-			closesocket(client.socket);
-		}
+		this->CloseClient(client);
 	}
 	this->clients.clear();
 
@@ -79,12 +87,21 @@ void RpcServer::Stop()
 	}
 }
 
+/**
+ * Service all sockets that are ready, without blocking the game loop.
+ * Readiness of the clients is determined with a single poll; clients only ask
+ * for writability while they have queued output. Responses are queued and
+ * written as far as the socket allows, so a slow reader never stalls the game.
+ */
 void RpcServer::Poll()
 {
 	if (!this->IsRunning()) return;
 
-	this->AcceptNewClients();
+	PerformanceAccumulator framerate(PFE_RPC);
+
+	this->CollectSerialisedResponses();
 	this->ProcessClients();
+	this->AcceptNewClients();
 }
 
 void RpcServer::RegisterHandler(const std::string &method, RpcHandler handler)
@@ -92,6 +109,164 @@ void RpcServer::RegisterHandler(const std::string &method, RpcHandler handler)
 	this->handlers[method] = std::move(handler);
 }
 
+/**
+ * Register a handler whose result is built and serialised off the game thread.
+ * @param method The method name.
+ * @param handler The handler, which returns a builder for the result.
+ */
+void RpcServer::RegisterDeferredHandler(const std::string &method, RpcDeferredHandler handler)
+{
+	this->deferred_handlers[method] = std::move(handler);
+}
+
+/** Start the serialisation thread; without it deferred results are serialised on the game thread. */
+void RpcServer::StartSerialiseThread()
+{
+	if (this->serialise_threaded) return;
+
+	this->serialise_stop = false;
+	this->serialise_threaded = StartNewThread(&this->serialise_thread, "ottd:rpc", &RpcServer::SerialiseThreadThunk, this);
+}
+
+/** Stop the serialisation thread and drop everything that was still queued. */
+void RpcServer::StopSerialiseThread()
+{
+	if (this->serialise_threaded) {
+		{
+			std::lock_guard<std::mutex> lock(this->serialise_mutex);
+			this->serialise_stop = true;
+		}
+		this->serialise_cv.notify_one();
+		this->serialise_thread.join();
+		this->serialise_threaded = false;
+	}
+
+	this->serialise_jobs.clear();
+	this->serialised.clear();
+}
+
+/**
+ * Entry point of the serialisation thread.
+ * @param server The server to serialise responses for.
+ */
+/* static */ void RpcServer::SerialiseThreadThunk(RpcServer *server)
+{
+	server->SerialiseThread();
+}
+
+/** Main loop of the serialisation thread. */
+void RpcServer::SerialiseThread()
+{
+	std::unique_lock<std::mutex> lock(this->serialise_mutex);
+	for (;;) {
+		this->serialise_cv.wait(lock, [this]() { return this->serialise_stop || !this->serialise_jobs.empty(); });
+		if (this->serialise_stop) return;
+
+		SerialiseJob job = std::move(this->serialise_jobs.front());
+		this->serialise_jobs.pop_front();
+
+		lock.unlock();
+		std::string data = SerialiseJobResult(job);
+		lock.lock();
+
+		this->serialised.emplace_back(job.connection_id, std::move(data), std::move(job.methods));
+	}
+}
+
+/**
+ * Fill in the result of a deferred response.
+ * @param response The response envelope.
+ * @param builder The builder for the result; when empty the response is left untouched.
+ */
+/* static */ void RpcServer::CompleteResponse(nlohmann::json &response, const RpcResultBuilder &builder)
+{
+	if (!builder) return;
+
+	try {
+		response["result"] = builder();
+	} catch (const std::exception &e) {
+		response = MakeErrorResponse(response["id"], RpcErrorCode::InternalError, e.what());
+	}
+}
+
+/**
+ * Build the results of a job, if needed, and stringify the response.
+ * @param job The job to serialise.
+ * @return The serialised response, including the line terminator.
+ */
+/* static */ std::string RpcServer::SerialiseJobResult(SerialiseJob &job)
+{
+	if (job.response.is_array()) {
+		for (size_t i = 0; i < job.builders.size(); i++) CompleteResponse(job.response[i], job.builders[i]);
+	} else if (!job.builders.empty()) {
+		CompleteResponse(job.response, job.builders.front());
+	}
+
+	std::string data;
+	EncodeMessage(data, job.response, job.encoding);
+	return data;
+}
+
+/**
+ * Append a message in the given wire encoding to a buffer.
+ * @param out The buffer to append to.
+ * @param message The message to encode.
+ * @param encoding The wire encoding.
+ */
+/* static */ void RpcServer::EncodeMessage(std::string &out, const nlohmann::json &message, RpcEncoding encoding)
+{
+	if (encoding == RpcEncoding::Json) {
+		out += message.dump();
+		out += '\n';
+		return;
+	}
+
+	std::vector<uint8_t> payload = (encoding == RpcEncoding::MsgPack) ? nlohmann::json::to_msgpack(message) : nlohmann::json::to_cbor(message);
+	uint32_t length = static_cast<uint32_t>(payload.size());
+	out += static_cast<char>(GB(length, 24, 8));
+	out += static_cast<char>(GB(length, 16, 8));
+	out += static_cast<char>(GB(length, 8, 8));
+	out += static_cast<char>(GB(length, 0, 8));
+	out.append(reinterpret_cast<const char *>(payload.data()), payload.size());
+}
+
+/**
+ * Decode a single message in the given wire encoding.
+ * @param data The raw message, without line terminator or length prefix.
+ * @param encoding The wire encoding.
+ * @return The decoded message.
+ * @throw nlohmann::json::parse_error When the message is malformed.
+ */
+static nlohmann::json DecodeMessage(std::string_view data, RpcEncoding encoding)
+{
+	switch (encoding) {
+		case RpcEncoding::Json: return nlohmann::json::parse(data);
+		case RpcEncoding::MsgPack: return nlohmann::json::from_msgpack(data.begin(), data.end());
+		case RpcEncoding::Cbor: return nlohmann::json::from_cbor(data.begin(), data.end());
+		default: NOT_REACHED();
+	}
+}
+
+/** Move the responses finished by the serialisation thread to the output queues of their clients. */
+void RpcServer::CollectSerialisedResponses()
+{
+	std::vector<SerialisedResponse> ready;
+	{
+		std::lock_guard<std::mutex> lock(this->serialise_mutex);
+		if (this->serialised.empty()) return;
+		ready.swap(this->serialised);
+	}
+
+	for (auto &response : ready) {
+		auto it = std::ranges::find(this->clients, response.connection_id, &ClientConnection::connection_id);
+		if (it == this->clients.end() || it->socket == INVALID_SOCKET) continue;
+
+		this->AddBytesOut(response.methods, response.data.size());
+		it->send_buffer += response.data;
+		it->pending_jobs--;
+	}
+}
+
 void RpcServer::AcceptNewClients()
 {
 	for (;;) {
@@ -104,61 +279,403 @@ void RpcServer::AcceptNewClients()
 		SetNonBlocking(client_socket);
 		SetNoDelay(client_socket);
 
-		this->clients.emplace_back(ClientConnection{client_socket, {}});
+		ClientConnection &client = this->clients.emplace_back();
+		client.socket = client_socket;
+		client.connection_id = this->next_connection_id++;
 		Debug(net, 2, "[rpc] Client connected");
 	}
 }
 
+/**
+ * Service the clients. Requests are handled until #RPC_POLL_TIME_BUDGET of game thread
+ * time is used; the remaining requests stay in the receive buffers until the next poll.
+ * The client that is handled first rotates every poll, so one busy client cannot take
+ * the whole budget every time.
+ */
 void RpcServer::ProcessClients()
 {
-	for (auto it = this->clients.begin(); it != this->clients.end();) {
-		char buffer[4096];
-		ssize_t received = recv(it->socket, buffer, sizeof(buffer) - 1, 0);
+	if (this->clients.empty()) return;
+
+	std::vector<pollfd> fds;
+	fds.reserve(this->clients.size());
+	bool any_input_pending = false;
+	for (const auto &client : this->clients) {
+		pollfd &pfd = fds.emplace_back();
+		pfd.fd = client.socket;
+		pfd.events = 0;
+		/* Apply backpressure: a client that does not read its responses, or whose requests are
+		 * still waiting for the time budget, does not get to queue more work. */
+		if (client.send_buffer.size() - client.send_offset < RPC_SEND_BACKPRESSURE && !client.input_pending) pfd.events |= POLLIN;
+		if (client.HasPendingOutput()) pfd.events |= POLLOUT;
+		pfd.revents = 0;
+		any_input_pending |= client.input_pending;
+	}
+
+	int ready = PollSockets(fds, 0);
+	if (ready < 0) {
+		Debug(net, 1, "[rpc] poll() failed: {}", NetworkError::GetLast().AsString());
+		return;
+	}
+	if (ready == 0 && !any_input_pending) return;
+
+	this->poll_start = std::chrono::steady_clock::now();
+	this->poll_handled_any = false;
+
+	size_t first = this->first_client++ % fds.size();
+	for (size_t n = 0; n < fds.size(); n++) {
+		size_t i = (first + n) % fds.size();
+		ClientConnection &client = this->clients[i];
+		short revents = fds[i].revents;
+		if (client.input_pending) {
+			this->ProcessClientData(client);
+			if (client.socket == INVALID_SOCKET) continue;
+		}
+		if (revents == 0) {
+			if (client.HasPendingOutput()) this->FlushClient(client);
+			continue;
+		}
+
+		if ((revents & POLLNVAL) != 0) {
+			this->CloseClient(client);
+			continue;
+		}
+
+		/* POLLHUP/POLLERR are reported together with POLLIN when there is still data; recv() tells us the rest. */
+		if ((revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+			if (!this->ReceiveClientData(client)) continue;
+			this->ProcessClientData(client);
+		}
+
+		if (client.HasPendingOutput()) this->FlushClient(client);
+	}
+
+	std::erase_if(this->clients, [](const ClientConnection &client) { return client.socket == INVALID_SOCKET; });
+}
+
+/**
+ * Read whatever is available on the socket, up to #RPC_RECV_BUDGET bytes.
+ * @param client The client to read from.
+ * @return False when the client has been closed.
+ */
+bool RpcServer::ReceiveClientData(ClientConnection &client)
+{
+	char buffer[4096];
+	size_t budget = RPC_RECV_BUDGET;
+
+	while (budget > 0) {
+		ssize_t received = recv(client.socket, buffer, sizeof(buffer), 0);
 
 		if (received > 0) {
-			buffer[received] = '\0';
-			it->recv_buffer.append(buffer, received);
-			this->ProcessClientData(*it);
-			++it;
-		} else if (received == 0) {
+			client.recv_buffer.append(buffer, received);
+			budget -= std::min<size_t>(budget, received);
+			continue;
+		}
+
+		if (received == 0) {
 			Debug(net, 2, "[rpc] Client disconnected");
-			closesocket(it->socket);
-			it = this->clients.erase(it);
-		} else {
-			auto err = NetworkError::GetLast();
-			if (err.WouldBlock()) {
-				++it;
-			} else {
-				Debug(net, 2, "[rpc] Client error: {}", err.AsString());
-				closesocket(it->socket);
-				it = this->clients.erase(it);
-			}
+			this->CloseClient(client);
+			return false;
 		}
+
+		auto err = NetworkError::GetLast();
+		if (err.WouldBlock()) break;
+
+		Debug(net, 2, "[rpc] Client error: {}", err.AsString());
+		this->CloseClient(client);
+		return false;
 	}
+
+	return true;
 }
 
+/**
+ * Send as much of the queued output as the socket accepts right now.
+ * @param client The client to flush.
+ * @return False when the client has been closed.
+ */
+bool RpcServer::FlushClient(ClientConnection &client)
+{
+	while (client.HasPendingOutput()) {
+		size_t remaining = client.send_buffer.size() - client.send_offset;
+		ssize_t sent = send(client.socket, client.send_buffer.data() + client.send_offset, static_cast<int>(remaining), 0);
+
+		if (sent > 0) {
+			client.send_offset += sent;
+			continue;
+		}
+
+		auto err = NetworkError::GetLast();
+		if (sent < 0 && err.WouldBlock()) break;
+
+		Debug(net, 2, "[rpc] Client send error: {}", err.AsString());
+		this->CloseClient(client);
+		return false;
+	}
+
+	if (!client.HasPendingOutput()) {
+		client.send_buffer.clear();
+		client.send_offset = 0;
+	} else if (client.send_offset > client.send_buffer.size() / 2) {
+		/* Drop the already sent part so the queue does not grow without bounds. */
+		client.send_buffer.erase(0, client.send_offset);
+		client.send_offset = 0;
+	}
+
+	return true;
+}
+
+/**
+ * Close the connection of a client; it is removed from the list at the end of the poll.
+ * @param client The client to close.
+ */
+void RpcServer::CloseClient(ClientConnection &client)
+{
+	if (client.socket == INVALID_SOCKET) return;
+
+	closesocket(client.socket);
+	client.socket = INVALID_SOCKET;
+	client.recv_buffer.clear();
+	client.send_buffer.clear();
+	client.send_offset = 0;
+}
+
+/**
+ * Handle the complete requests that are in the receive buffer of a client.
+ * Pipelined requests are answered within the same poll as long as the time budget
+ * of the poll lasts, and their responses end up in the same output queue, so they
+ * are flushed together.
+ * @param client The client to handle the requests of.
+ */
 void RpcServer::ProcessClientData(ClientConnection &client)
 {
-	size_t pos;
-	while ((pos = client.recv_buffer.find('\n')) != std::string::npos) {
-		std::string line = client.recv_buffer.substr(0, pos);
-		client.recv_buffer.erase(0, pos + 1);
+	size_t start = 0;
+	client.input_pending = false;
+	while (client.socket != INVALID_SOCKET) {
+		/* Always handle at least one request per poll, so a slow request cannot stall everything. */
+		if (this->poll_handled_any && std::chrono::steady_clock::now() - this->poll_start >= RPC_POLL_TIME_BUDGET) {
+			client.input_pending = true;
+			break;
+		}
 
-		if (line.empty() || (line.size() == 1 && line[0] == '\r')) continue;
-		if (!line.empty() && line.back() == '\r') line.pop_back();
+		std::string_view buffer(client.recv_buffer);
+		std::string_view message;
 
+		/* The encoding can change halfway through the buffer, so check it for every message. */
+		if (client.encoding == RpcEncoding::Json) {
+			size_t pos = buffer.find('\n', start);
+			if (pos == std::string_view::npos) break;
+
+			message = buffer.substr(start, pos - start);
+			start = pos + 1;
+
+			if (!message.empty() && message.back() == '\r') message.remove_suffix(1);
+			if (message.empty()) continue;
+		} else {
+			if (buffer.size() - start < 4) break;
+
+			const uint8_t *header = reinterpret_cast<const uint8_t *>(buffer.data() + start);
+			size_t length = (static_cast<size_t>(header[0]) << 24) | (header[1] << 16) | (header[2] << 8) | header[3];
+			if (length > RPC_MAX_FRAME_SIZE) {
+				Debug(net, 1, "[rpc] Client sent a frame of {} bytes, closing connection", length);
+				this->CloseClient(client);
+				return;
+			}
+			if (buffer.size() - start - 4 < length) break;
+
+			message = buffer.substr(start + 4, length);
+			start += 4 + length;
+		}
+
+		nlohmann::json request;
 		try {
-			nlohmann::json request = nlohmann::json::parse(line);
-			nlohmann::json response = this->HandleRequest(request);
-			this->SendResponse(client, response);
+			request = DecodeMessage(message, client.encoding);
 		} catch (const nlohmann::json::parse_error &e) {
-			nlohmann::json response = this->MakeErrorResponse(nullptr, RpcErrorCode::ParseError, e.what());
-			this->SendResponse(client, response);
+			this->SendResponse(client, this->MakeErrorResponse(nullptr, RpcErrorCode::ParseError, e.what()));
+			continue;
+		}
+
+		this->HandleMessage(client, request, message.size());
+		this->poll_handled_any = true;
+	}
+
+	if (client.socket != INVALID_SOCKET) client.recv_buffer.erase(0, start);
+}
+
+/**
+ * Handle a decoded message from a client: a single request or a batch.
+ * @param client The client that sent the message.
+ * @param message The message.
+ * @param bytes_in Size of the message on the wire, for the statistics.
+ */
+void RpcServer::HandleMessage(ClientConnection &client, const nlohmann::json &message, size_t bytes_in)
+{
+	if (message.is_array()) {
+		this->HandleBatch(client, message, bytes_in);
+		return;
+	}
+
+	/* Requests about the connection itself are not routed to the handlers. */
+	if (message.is_object() && message.contains("method") && message["method"].is_string()) {
+		const std::string &method = message["method"].get_ref<const std::string &>();
+		if (method == "rpc.setEncoding") {
+			this->HandleSetEncoding(client, message);
+			return;
+		}
+		if (method == "rpc.subscribe" || method == "rpc.unsubscribe") {
+			this->HandleSubscribe(client, message, method == "rpc.subscribe");
+			return;
+		}
+	}
+
+	RpcResultBuilder builder;
+	nlohmann::json response = this->HandleRequest(message, &builder, bytes_in);
+	std::vector<std::string> methods;
+	if (message.is_object() && message.contains("method") && message["method"].is_string()) methods.push_back(message["method"].get<std::string>());
+	this->SendResponse(client, std::move(response), {std::move(builder)}, std::move(methods));
+}
+
+/**
+ * Handle rpc.setEncoding, which switches the wire encoding of the connection.
+ * The response is still sent in the old encoding; everything after it uses the new one.
+ * @param client The client that sent the request.
+ * @param request The request, with the encoding name ("json", "msgpack" or "cbor") in its params.
+ */
+void RpcServer::HandleSetEncoding(ClientConnection &client, const nlohmann::json &request)
+{
+	nlohmann::json id = request.value("id", nlohmann::json());
+	nlohmann::json params = request.value("params", nlohmann::json::object());
+	std::string name = params.is_object() ? params.value("encoding", "") : "";
+
+	RpcEncoding encoding;
+	if (name == "json") {
+		encoding = RpcEncoding::Json;
+	} else if (name == "msgpack") {
+		encoding = RpcEncoding::MsgPack;
+	} else if (name == "cbor") {
+		encoding = RpcEncoding::Cbor;
+	} else {
+		this->SendResponse(client, this->MakeErrorResponse(id, RpcErrorCode::InvalidParams, "Unknown encoding: " + name));
+		return;
+	}
+
+	this->SendResponse(client, this->MakeSuccessResponse(id, {{"encoding", name}}));
+	client.encoding = encoding;
+}
+
+/** Names of the topics for rpc.subscribe, indexed by RpcTopic. */
+static const std::array<std::string_view, to_underlying(RpcTopic::End)> _rpc_topic_names = {
+	"vehicle", "news", "station_rating", "cargomonitor",
+};
+
+/**
+ * Handle rpc.subscribe and rpc.unsubscribe.
+ * Subscribed clients get JSON-RPC notifications (requests without id) named "event.<topic>" pushed to them.
+ * @param client The client that sent the request.
+ * @param request The request, with an optional array of topic names in its params; default is all topics.
+ * @param subscribe True to subscribe, false to unsubscribe.
+ */
+void RpcServer::HandleSubscribe(ClientConnection &client, const nlohmann::json &request, bool subscribe)
+{
+	nlohmann::json id = request.value("id", nlohmann::json());
+	nlohmann::json params = request.value("params", nlohmann::json::object());
+
+	RpcTopics topics{};
+	if (params.is_object() && params.contains("topics") && params["topics"].is_array()) {
+		for (const nlohmann::json &name : params["topics"]) {
+			auto it = name.is_string() ? std::ranges::find(_rpc_topic_names, name.get<std::string>()) : _rpc_topic_names.end();
+			if (it == _rpc_topic_names.end()) {
+				this->SendResponse(client, this->MakeErrorResponse(id, RpcErrorCode::InvalidParams, "Unknown topic: " + name.dump()));
+				return;
+			}
+			topics.Set(static_cast<RpcTopic>(std::distance(_rpc_topic_names.begin(), it)));
 		}
+	} else {
+		topics.Set();
+	}
+
+	if (subscribe) {
+		client.topics.Set(topics);
+	} else {
+		client.topics.Reset(topics);
+	}
+
+	nlohmann::json subscribed = nlohmann::json::array();
+	for (uint8_t i = 0; i < to_underlying(RpcTopic::End); i++) {
+		if (client.topics.Test(static_cast<RpcTopic>(i))) subscribed.push_back(_rpc_topic_names[i]);
 	}
+	this->SendResponse(client, this->MakeSuccessResponse(id, {{"topics", subscribed}}));
 }
 
-nlohmann::json RpcServer::HandleRequest(const nlohmann::json &request)
+/**
+ * Check whether any client is subscribed to a topic, so producers can skip computing notifications nobody reads.
+ * @param topic The topic.
+ * @return True iff at least one connected client subscribed to it.
+ */
+bool RpcServer::HasSubscribers(RpcTopic topic) const
+{
+	return std::ranges::any_of(this->clients, [topic](const ClientConnection &client) { return client.socket != INVALID_SOCKET && client.topics.Test(topic); });
+}
+
+/**
+ * Push a notification to all clients subscribed to a topic.
+ * @param topic The topic of the notification.
+ * @param method The method name of the notification.
+ * @param params The parameters of the notification.
+ */
+void RpcServer::Notify(RpcTopic topic, const std::string &method, const nlohmann::json &params)
+{
+	nlohmann::json notification = {
+		{"jsonrpc", "2.0"},
+		{"method", method},
+		{"params", params}
+	};
+
+	for (auto &client : this->clients) {
+		if (client.socket == INVALID_SOCKET || !client.topics.Test(topic)) continue;
+		this->SendResponse(client, notification);
+	}
+}
+
+/**
+ * Handle a JSON-RPC 2.0 batch request. All requests are executed in order and
+ * their responses are sent back as one array, in the same order.
+ * As the whole batch is handled within one poll, the commands of all build
+ * requests in it are executed in the same game tick.
+ * @param client The client that sent the batch.
+ * @param batch The array of requests.
+ * @param bytes_in Size of the batch on the wire, for the statistics.
+ */
+void RpcServer::HandleBatch(ClientConnection &client, const nlohmann::json &batch, size_t bytes_in)
+{
+	if (batch.empty()) {
+		this->SendResponse(client, this->MakeErrorResponse(nullptr, RpcErrorCode::InvalidRequest, "Empty batch"));
+		return;
+	}
+
+	nlohmann::json responses = nlohmann::json::array();
+	std::vector<RpcResultBuilder> builders;
+	builders.reserve(batch.size());
+	std::vector<std::string> methods;
+
+	for (const nlohmann::json &request : batch) {
+		RpcResultBuilder &builder = builders.emplace_back();
+		responses.push_back(this->HandleRequest(request, &builder, bytes_in / batch.size()));
+		if (request.is_object() && request.contains("method") && request["method"].is_string()) methods.push_back(request["method"].get<std::string>());
+	}
+
+	this->SendResponse(client, std::move(responses), std::move(builders), std::move(methods));
+}
+
+/**
+ * Handle a single JSON-RPC request.
+ * @param request The request.
+ * @param[out] deferred When not \c nullptr and the method has a deferred handler, receives the
+ *                      builder for the result while the returned response has a \c null result.
+ *                      Otherwise deferred handlers are completed on the calling thread.
+ * @param bytes_in Size of the request on the wire, for the statistics.
+ * @return The response envelope.
+ */
+nlohmann::json RpcServer::HandleRequest(const nlohmann::json &request, RpcResultBuilder *deferred, size_t bytes_in)
 {
 	nlohmann::json id = nullptr;
 	if (request.contains("id")) {
@@ -176,6 +693,46 @@ nlohmann::json RpcServer::HandleRequest(const nlohmann::json &request)
 	std::string method = request["method"];
 	nlohmann::json params = request.value("params", nlohmann::json::object());
 
+	auto start = std::chrono::steady_clock::now();
+	nlohmann::json response = this->DispatchRequest(id, method, params, deferred);
+	uint64_t time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+	bool known = this->handlers.contains(method) || this->deferred_handlers.contains(method);
+	RpcMethodStats &stats = this->method_stats[known ? method : RPC_UNKNOWN_METHOD];
+	stats.calls++;
+	if (response.contains("error")) stats.errors++;
+	stats.bytes_in += bytes_in;
+	stats.total_time += time;
+	stats.max_time = std::max(stats.max_time, time);
+	stats.time_histogram[RpcMethodStats::GetTimeBucket(time)]++;
+
+	return response;
+}
+
+/**
+ * Call the handler of a request.
+ * @param id The id of the request.
+ * @param method The method of the request.
+ * @param params The parameters of the request.
+ * @param[out] deferred See #HandleRequest.
+ * @return The response envelope.
+ */
+nlohmann::json RpcServer::DispatchRequest(const nlohmann::json &id, const std::string &method, const nlohmann::json &params, RpcResultBuilder *deferred)
+{
+	auto deferred_it = this->deferred_handlers.find(method);
+	if (deferred_it != this->deferred_handlers.end()) {
+		try {
+			RpcResultBuilder builder = deferred_it->second(params);
+			if (deferred != nullptr) {
+				*deferred = std::move(builder);
+				return this->MakeSuccessResponse(id, nullptr);
+			}
+			return this->MakeSuccessResponse(id, builder());
+		} catch (const std::exception &e) {
+			return this->MakeErrorResponse(id, RpcErrorCode::InternalError, e.what());
+		}
+	}
+
 	auto handler_it = this->handlers.find(method);
 	if (handler_it == this->handlers.end()) {
 		return this->MakeErrorResponse(id, RpcErrorCode::MethodNotFound, "Method not found: " + method);
@@ -189,7 +746,7 @@ nlohmann::json RpcServer::HandleRequest(const nlohmann::json &request)
 	}
 }
 
-nlohmann::json RpcServer::MakeErrorResponse(const nlohmann::json &id, RpcErrorCode code, const std::string &message)
+/* static */ nlohmann::json RpcServer::MakeErrorResponse(const nlohmann::json &id, RpcErrorCode code, const std::string &message)
 {
 	return {
 		{"jsonrpc", "2.0"},
@@ -201,7 +758,7 @@ nlohmann::json RpcServer::MakeErrorResponse(const nlohmann::json &id, RpcErrorCo
 	};
 }
 
-nlohmann::json RpcServer::MakeSuccessResponse(const nlohmann::json &id, const nlohmann::json &result)
+/* static */ nlohmann::json RpcServer::MakeSuccessResponse(const nlohmann::json &id, const nlohmann::json &result)
 {
 	return {
 		{"jsonrpc", "2.0"},
@@ -210,10 +767,134 @@ nlohmann::json RpcServer::MakeSuccessResponse(const nlohmann::json &id, const nl
 	};
 }
 
-void RpcServer::SendResponse(ClientConnection &client, const nlohmann::json &response)
+/**
+ * Queue a response for a client. The data is sent by #FlushClient once the socket is writable.
+ * Responses with a builder are serialised on the serialisation thread; to keep the responses
+ * in order, any response that follows them goes through that thread as well.
+ * @param client The client to send to.
+ * @param response The response to send, or an array of responses for a batch.
+ * @param builders Builders for the results of the response(s) that have been deferred.
+ * @param methods Methods the size of the response is accounted to.
+ */
+void RpcServer::SendResponse(ClientConnection &client, nlohmann::json response, std::vector<RpcResultBuilder> builders, std::vector<std::string> methods)
 {
-	std::string data = response.dump() + "\n";
-	send(client.socket, data.c_str(), data.size(), 0);
+	if (client.socket == INVALID_SOCKET) return;
+
+	SerialiseJob job{client.connection_id, client.encoding, std::move(response), std::move(builders), std::move(methods)};
+	if (!this->serialise_threaded || (!job.IsDeferred() && client.pending_jobs == 0)) {
+		std::string data = SerialiseJobResult(job);
+		this->AddBytesOut(job.methods, data.size());
+		client.send_buffer += data;
+		return;
+	}
+
+	client.pending_jobs++;
+	{
+		std::lock_guard<std::mutex> lock(this->serialise_mutex);
+		this->serialise_jobs.push_back(std::move(job));
+	}
+	this->serialise_cv.notify_one();
+}
+
+/**
+ * Account the size of a serialised response to the methods of its requests.
+ * @param methods The methods; a batch is split evenly over them.
+ * @param bytes The size of the response.
+ */
+void RpcServer::AddBytesOut(const std::vector<std::string> &methods, size_t bytes)
+{
+	for (const std::string &method : methods) {
+		auto it = this->method_stats.find(method);
+		if (it == this->method_stats.end()) it = this->method_stats.find(RPC_UNKNOWN_METHOD);
+		if (it != this->method_stats.end()) it->second.bytes_out += bytes / methods.size();
+	}
+}
+
+/**
+ * Get the time covered by the statistics.
+ * @return Seconds since the server started or the statistics were reset.
+ */
+double RpcServer::GetStatsSeconds() const
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - this->stats_start).count();
+}
+
+/** Clear the statistics of all methods. */
+void RpcServer::ResetStats()
+{
+	this->method_stats.clear();
+	this->stats_start = std::chrono::steady_clock::now();
+}
+
+/**
+ * Get the bucket of the handler time histogram for a duration.
+ * @param time The duration in microseconds.
+ * @return The bucket.
+ */
+/* static */ uint RpcMethodStats::GetTimeBucket(uint64_t time)
+{
+	uint bucket = 0;
+	while (bucket < TIME_BUCKETS - 1 && time >= GetTimeBucketLimit(bucket)) bucket++;
+	return bucket;
+}
+
+/**
+ * Get the upper limit of a bucket of the handler time histogram.
+ * @param bucket The bucket.
+ * @return Requests in the bucket took less than this many microseconds; UINT64_MAX for the last bucket.
+ */
+/* static */ uint64_t RpcMethodStats::GetTimeBucketLimit(uint bucket)
+{
+	if (bucket >= TIME_BUCKETS - 1) return UINT64_MAX;
+	return static_cast<uint64_t>(1) << (TIME_BUCKET_BITS + bucket);
+}
+
+/**
+ * Estimate a percentile of the handler time from the histogram.
+ * @param percentile The percentile, 0 to 100.
+ * @return The upper limit of the bucket holding the percentile, or the longest time for the last bucket, in microseconds.
+ */
+uint64_t RpcMethodStats::GetPercentileTime(uint percentile) const
+{
+	uint64_t wanted = (this->calls * percentile + 99) / 100;
+	uint64_t seen = 0;
+	for (uint bucket = 0; bucket < TIME_BUCKETS; bucket++) {
+		seen += this->time_histogram[bucket];
+		if (seen >= wanted && seen > 0) return std::min(GetTimeBucketLimit(bucket), this->max_time);
+	}
+	return this->max_time;
+}
+
+/** Print the statistics per method to the console, the most expensive first. */
+void ConPrintRpcStats()
+{
+	if (_rpc_server == nullptr) {
+		IConsolePrint(CC_ERROR, "The RPC server is not running.");
+		return;
+	}
+
+	std::vector<RpcMethodStatsMap::const_pointer> sorted;
+	for (const auto &entry : _rpc_server->GetMethodStats()) sorted.push_back(&entry);
+	if (sorted.empty()) {
+		IConsolePrint(CC_ERROR, "No RPC requests have been handled yet.");
+		return;
+	}
+	std::ranges::stable_sort(sorted, std::greater{}, [](const auto *entry) { return entry->second.total_time; });
+
+	double seconds = std::max(_rpc_server->GetStatsSeconds(), 1.0);
+	IConsolePrint(CC_DEFAULT, "Over {:.0f} seconds:", seconds);
+	for (const auto *entry : sorted) {
+		const RpcMethodStats &stats = entry->second;
+		IConsolePrint(CC_DEFAULT, "  {}: {} calls, {} errors, {} bytes in, {} bytes out, p50 {}us, p99 {}us, max {}us, {:.2f} ms/s",
+			entry->first, stats.calls, stats.errors, stats.bytes_in, stats.bytes_out,
+			stats.GetPercentileTime(50), stats.GetPercentileTime(99), stats.max_time, stats.total_time / 1000.0 / seconds);
+	}
+}
+
+/** Clear the RPC statistics, if the server is running. */
+void RpcServerResetStats()
+{
+	if (_rpc_server != nullptr) _rpc_server->ResetStats();
 }
 
 void RpcServerStart()
@@ -233,6 +914,18 @@ void RpcServerStop()
 void RpcServerPoll()
 {
 	if (_rpc_server) {
+		PerformanceAccumulator::Reset(PFE_RPC);
 		_rpc_server->Poll();
+		RpcApplyCameraRequest();
 	}
 }
+
+bool RpcServerHasSubscribers(RpcTopic topic)
+{
+	return _rpc_server != nullptr && _rpc_server->HasSubscribers(topic);
+}
+
+void RpcServerNotify(RpcTopic topic, const std::string &method, const nlohmann::json &params)
+{
+	if (_rpc_server != nullptr) _rpc_server->Notify(topic, method, params);
+}
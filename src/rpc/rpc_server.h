@@ -11,14 +11,37 @@
 #define RPC_SERVER_H
 
 #include "../network/core/os_abstraction.h"
+#include "../core/enum_type.hpp"
 #include "../3rdparty/nlohmann/json.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 static constexpr uint16_t RPC_DEFAULT_PORT = 9877;
+static constexpr size_t RPC_RECV_BUDGET = 64 * 1024; ///< Maximum number of bytes read from one client per poll.
+static constexpr size_t RPC_SEND_BACKPRESSURE = 4 * 1024 * 1024; ///< Stop reading requests from a client while this much output is queued.
+static constexpr size_t RPC_MAX_FRAME_SIZE = 16 * 1024 * 1024; ///< Largest binary request frame a client may send.
+static constexpr std::chrono::microseconds RPC_POLL_TIME_BUDGET{2000}; ///< Game thread time for requests per poll; later requests wait for the next poll.
+
+/**
+ * Wire encoding of a connection. Connections start out with newline-terminated
+ * JSON text; after a successful rpc.setEncoding request both directions switch
+ * to frames of a 32 bit big-endian length followed by that many bytes.
+ */
+enum class RpcEncoding : uint8_t {
+	Json, ///< Newline-terminated JSON text.
+	MsgPack, ///< Length-prefixed MessagePack frames.
+	Cbor, ///< Length-prefixed CBOR frames.
+};
 
 enum class RpcErrorCode : int {
 	ParseError = -32700,
@@ -28,8 +51,50 @@ enum class RpcErrorCode : int {
 	InternalError = -32603,
 };
 
+/** Topics a client can subscribe to with rpc.subscribe, to get notifications pushed instead of polling. */
+enum class RpcTopic : uint8_t {
+	Vehicle, ///< Changes of the state of primary vehicles.
+	News, ///< New news items.
+	StationRating, ///< Noticeable changes of station ratings.
+	CargoMonitor, ///< Deltas of the active cargo monitors.
+	End,
+};
+using RpcTopics = EnumBitSet<RpcTopic, uint8_t, RpcTopic::End>;
+
 using RpcHandler = std::function<nlohmann::json(const nlohmann::json &params)>;
 
+/** Statistics of the requests of one method, since the server started or the statistics were reset. */
+struct RpcMethodStats {
+	static constexpr uint TIME_BUCKET_BITS = 4; ///< The first bucket of the handler time histogram holds requests shorter than 2^TIME_BUCKET_BITS microseconds.
+	static constexpr uint TIME_BUCKETS = 16; ///< Each bucket covers twice the time of the previous one; the last bucket holds all longer requests.
+
+	uint64_t calls = 0; ///< Number of requests.
+	uint64_t errors = 0; ///< Number of requests answered with an error.
+	uint64_t bytes_in = 0; ///< Size of the requests; a batch is split evenly over its requests.
+	uint64_t bytes_out = 0; ///< Size of the serialised responses; a batch is split evenly over its responses.
+	uint64_t total_time = 0; ///< Time spent handling the requests on the game thread, in microseconds.
+	uint64_t max_time = 0; ///< Longest time spent handling a request on the game thread, in microseconds.
+	std::array<uint64_t, TIME_BUCKETS> time_histogram{}; ///< Number of requests per duration bucket.
+
+	uint64_t GetPercentileTime(uint percentile) const;
+	static uint GetTimeBucket(uint64_t time);
+	static uint64_t GetTimeBucketLimit(uint bucket);
+};
+
+using RpcMethodStatsMap = std::map<std::string, RpcMethodStats>;
+
+/**
+ * Builds the result of a deferred handler. It runs on the serialisation thread,
+ * so it must only use the data it captured and never touch game state.
+ */
+using RpcResultBuilder = std::function<nlohmann::json()>;
+
+/**
+ * Handler that copies what it needs from the game state into a snapshot, and
+ * hands the building and stringifying of the JSON result to the serialisation thread.
+ */
+using RpcDeferredHandler = std::function<RpcResultBuilder(const nlohmann::json &params)>;
+
 class RpcServer {
 public:
 	RpcServer();
@@ -43,31 +108,105 @@ public:
 	void Poll();
 
 	void RegisterHandler(const std::string &method, RpcHandler handler);
+	void RegisterDeferredHandler(const std::string &method, RpcDeferredHandler handler);
 
 	bool IsRunning() const { return this->listen_socket != INVALID_SOCKET; }
 
+	bool HasSubscribers(RpcTopic topic) const;
+	void Notify(RpcTopic topic, const std::string &method, const nlohmann::json &params);
+
+	/** Get the statistics per method; requests for unknown methods are counted together. */
+	const RpcMethodStatsMap &GetMethodStats() const { return this->method_stats; }
+	double GetStatsSeconds() const;
+	void ResetStats();
+
 private:
 	struct ClientConnection {
 		SOCKET socket = INVALID_SOCKET;
+		uint32_t connection_id = 0; ///< Unique identifier, so serialised responses find their client.
+		uint32_t pending_jobs = 0; ///< Number of responses still being serialised; later responses must wait for them.
+		RpcEncoding encoding = RpcEncoding::Json; ///< Encoding of the requests and responses on this connection.
+		RpcTopics topics{}; ///< Topics this client subscribed to.
+		bool input_pending = false; ///< Whether complete requests are left in #recv_buffer because the time budget of the poll ran out.
 		std::string recv_buffer;
+		std::string send_buffer; ///< Serialised responses not yet accepted by the socket.
+		size_t send_offset = 0; ///< Number of bytes of #send_buffer that have already been sent.
+
+		bool HasPendingOutput() const { return this->send_offset < this->send_buffer.size(); }
+	};
+
+	/** A response waiting to be serialised on the serialisation thread. */
+	struct SerialiseJob {
+		uint32_t connection_id; ///< The client to send the response to.
+		RpcEncoding encoding; ///< The encoding to serialise the response with.
+		nlohmann::json response; ///< The response envelope, or an array of envelopes for a batch.
+		std::vector<RpcResultBuilder> builders; ///< Builders for the results of the envelope(s); empty builders mean the envelope is complete.
+		std::vector<std::string> methods; ///< Methods the size of the response is accounted to.
+
+		bool IsDeferred() const { return std::ranges::any_of(this->builders, [](const RpcResultBuilder &builder) { return static_cast<bool>(builder); }); }
+	};
+
+	/** A response that is ready to be queued for sending. */
+	struct SerialisedResponse {
+		uint32_t connection_id; ///< The client to send the response to.
+		std::string data; ///< The serialised response, including the line terminator.
+		std::vector<std::string> methods; ///< Methods the size of the response is accounted to.
 	};
 
 	SOCKET listen_socket = INVALID_SOCKET;
 	std::vector<ClientConnection> clients;
 	std::map<std::string, RpcHandler> handlers;
+	std::map<std::string, RpcDeferredHandler> deferred_handlers;
+	uint32_t next_connection_id = 1;
+	size_t first_client = 0; ///< Client to handle first in the next poll, so the time budget is shared round robin.
+	std::chrono::steady_clock::time_point poll_start; ///< When the handling of requests in the current poll started.
+	bool poll_handled_any = false; ///< Whether a request has been handled in the current poll.
+
+	RpcMethodStatsMap method_stats; ///< Statistics per method.
+	std::chrono::steady_clock::time_point stats_start = std::chrono::steady_clock::now(); ///< When the statistics were last reset.
+
+	std::thread serialise_thread; ///< Thread building and stringifying the results of deferred handlers.
+	std::mutex serialise_mutex; ///< Protects #serialise_jobs, #serialised and #serialise_stop.
+	std::condition_variable serialise_cv; ///< Signalled when a job is queued or the thread has to stop.
+	std::deque<SerialiseJob> serialise_jobs;
+	std::vector<SerialisedResponse> serialised;
+	bool serialise_stop = false;
+	bool serialise_threaded = false; ///< Whether #serialise_thread is running.
+
+	void StartSerialiseThread();
+	void StopSerialiseThread();
+	void SerialiseThread();
+	static void SerialiseThreadThunk(RpcServer *server);
+	void CollectSerialisedResponses();
+	static std::string SerialiseJobResult(SerialiseJob &job);
+	static void CompleteResponse(nlohmann::json &response, const RpcResultBuilder &builder);
+	static void EncodeMessage(std::string &out, const nlohmann::json &message, RpcEncoding encoding);
 
 	void AcceptNewClients();
 	void ProcessClients();
+	bool ReceiveClientData(ClientConnection &client);
+	bool FlushClient(ClientConnection &client);
+	void CloseClient(ClientConnection &client);
 	void ProcessClientData(ClientConnection &client);
-	nlohmann::json HandleRequest(const nlohmann::json &request);
-	nlohmann::json MakeErrorResponse(const nlohmann::json &id, RpcErrorCode code, const std::string &message);
-	nlohmann::json MakeSuccessResponse(const nlohmann::json &id, const nlohmann::json &result);
-	void SendResponse(ClientConnection &client, const nlohmann::json &response);
+	void HandleMessage(ClientConnection &client, const nlohmann::json &message, size_t bytes_in);
+	void HandleBatch(ClientConnection &client, const nlohmann::json &batch, size_t bytes_in);
+	void HandleSetEncoding(ClientConnection &client, const nlohmann::json &request);
+	void HandleSubscribe(ClientConnection &client, const nlohmann::json &request, bool subscribe);
+	nlohmann::json HandleRequest(const nlohmann::json &request, RpcResultBuilder *deferred = nullptr, size_t bytes_in = 0);
+	nlohmann::json DispatchRequest(const nlohmann::json &id, const std::string &method, const nlohmann::json &params, RpcResultBuilder *deferred);
+	void AddBytesOut(const std::vector<std::string> &methods, size_t bytes);
+	static nlohmann::json MakeErrorResponse(const nlohmann::json &id, RpcErrorCode code, const std::string &message);
+	static nlohmann::json MakeSuccessResponse(const nlohmann::json &id, const nlohmann::json &result);
+	void SendResponse(ClientConnection &client, nlohmann::json response, std::vector<RpcResultBuilder> builders = {}, std::vector<std::string> methods = {});
 };
 
 void RpcServerStart();
 void RpcServerStop();
 void RpcServerPoll();
+bool RpcServerHasSubscribers(RpcTopic topic);
+void RpcServerNotify(RpcTopic topic, const std::string &method, const nlohmann::json &params);
 void RpcRegisterHandlers(RpcServer &server);
+void ConPrintRpcStats();
+void RpcServerResetStats();
 
 #endif /* RPC_SERVER_H */
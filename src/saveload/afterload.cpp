@@ -216,6 +216,8 @@ static inline RailType UpdateRailType(RailType rt, RailType min)
 
 /**
  * Update the viewport coordinates of all signs.
+ * Signs that keep their position, for example after a change of the interface zoom,
+ * font or language, are only resized and stay in the viewport sign Kdtree.
  */
 void UpdateAllVirtCoords()
 {
@@ -223,7 +225,6 @@ void UpdateAllVirtCoords()
 	UpdateAllSignVirtCoords();
 	UpdateAllTownVirtCoords();
 	UpdateAllTextEffectVirtCoords();
-	RebuildViewportKdtree();
 }
 
 void ClearAllCachedNames()
@@ -231,6 +232,7 @@ void ClearAllCachedNames()
 	ClearAllStationCachedNames();
 	ClearAllTownCachedNames();
 	ClearAllIndustryCachedNames();
+	ClearAllCompanyCachedNames();
 }
 
 /**
@@ -251,6 +253,8 @@ static void InitializeWindowsAndCaches()
 	/* Update coordinates of the signs. */
 	ClearAllCachedNames();
 	UpdateAllVirtCoords();
+	/* All signs were inserted one by one, so balance the Kdtree again. */
+	RebuildViewportKdtree();
 	ResetViewportAfterLoadGame();
 
 	for (Company *c : Company::Iterate()) {
@@ -816,6 +820,10 @@ bool AfterLoadGame()
 	 * filled; and that could eventually lead to desyncs. */
 	CargoPacket::AfterLoad();
 
+	/* The game was initialised with a dummy map; size the vehicle hashes for the loaded
+	 * map before the vehicles are put into them. */
+	ResetVehicleHash();
+
 	/* Update all vehicles: Phase 1 */
 	AfterLoadVehiclesPhase1(true);
 
@@ -3454,6 +3462,8 @@ void ReloadNewGRFData()
 	GroupStatistics::UpdateAfterLoad();
 	/* update station graphics */
 	AfterLoadStations();
+	/* Pylons and wires depend on the rail types and stations of the NewGRFs */
+	ClearCatenaryLayouts();
 	/* Update company statistics. */
 	AfterLoadCompanyStats();
 	/* Check and update house and town values */
@@ -53,17 +53,16 @@ struct CMDLChunkHandler : ChunkHandler {
 
 		TempStorage storage;
 
+		/* Save in order of the monitor number, so the same game always gives the same savegame. */
 		int i = 0;
-		CargoMonitorMap::const_iterator iter = _cargo_deliveries.begin();
-		while (iter != _cargo_deliveries.end()) {
-			storage.number = iter->first;
-			storage.amount = iter->second;
+		for (const auto &[number, amount] : _cargo_deliveries.GetSorted()) {
+			storage.number = number;
+			storage.amount = amount;
 
 			SlSetArrayIndex(i);
 			SlObject(&storage, _cargomonitor_pair_desc);
 
 			i++;
-			iter++;
 		}
 	}
 
@@ -81,7 +80,7 @@ struct CMDLChunkHandler : ChunkHandler {
 
 			if (fix) storage.number = FixupCargoMonitor(storage.number);
 
-			_cargo_deliveries.emplace(storage.number, storage.amount);
+			_cargo_deliveries.Emplace(storage.number, storage.amount);
 		}
 	}
 };
@@ -96,17 +95,16 @@ struct CMPUChunkHandler : ChunkHandler {
 
 		TempStorage storage;
 
+		/* Save in order of the monitor number, so the same game always gives the same savegame. */
 		int i = 0;
-		CargoMonitorMap::const_iterator iter = _cargo_pickups.begin();
-		while (iter != _cargo_pickups.end()) {
-			storage.number = iter->first;
-			storage.amount = iter->second;
+		for (const auto &[number, amount] : _cargo_pickups.GetSorted()) {
+			storage.number = number;
+			storage.amount = amount;
 
 			SlSetArrayIndex(i);
 			SlObject(&storage, _cargomonitor_pair_desc);
 
 			i++;
-			iter++;
 		}
 	}
 
@@ -124,7 +122,7 @@ struct CMPUChunkHandler : ChunkHandler {
 
 			if (fix) storage.number = FixupCargoMonitor(storage.number);
 
-			_cargo_pickups.emplace(storage.number, storage.amount);
+			_cargo_pickups.Emplace(storage.number, storage.amount);
 		}
 	}
 };
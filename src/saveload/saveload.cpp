@@ -43,6 +43,7 @@
 #include "../gamelog.h"
 #include "../string_func.h"
 #include "../fios.h"
+#include "../console_func.h"
 #include "../error.h"
 #include "../strings_type.h"
 #include "../newgrf_railtype.h"
@@ -50,12 +51,26 @@
 #include "../settings_internal.h"
 #include "saveload_internal.h"
 #include "saveload_filter.h"
+#include "../trace.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 #ifdef __EMSCRIPTEN__
 #	include <emscripten.h>
 #endif
 
+#if defined(UNIX) && !defined(__EMSCRIPTEN__)
+#	define WITH_FORKED_AUTOSAVE
+#	define WITH_MAPPED_SAVEGAME_READER
+#	include <signal.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <sys/types.h>
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
+
 #ifdef WITH_LZO
 #include <lzo/lzo1x.h>
 #endif
@@ -68,6 +83,11 @@
 #include <lzma.h>
 #endif /* WITH_LIBLZMA */
 
+#if defined(WITH_ZSTD)
+#include <zstd.h>
+#include <thread>
+#endif /* WITH_ZSTD */
+
 #include "table/strings.h"
 
 #include "../safeguards.h"
@@ -81,6 +101,8 @@ uint32_t _ttdp_version;         ///< version of TTDP savegame (if applicable)
 SaveLoadVersion _sl_version;  ///< the major savegame version identifier
 uint8_t   _sl_minor_version;     ///< the minor savegame version, DO NOT USE!
 std::string _savegame_format; ///< how to compress savegames
+std::string _autosave_format; ///< how to compress autosaves; empty to compress them like other savegames
+std::string _network_savegame_format; ///< how to compress the map sent to joining clients; empty to compress it like other savegames
 bool _do_autosave;            ///< are we doing an autosave at the moment?
 
 /** What are we currently doing? */
@@ -104,33 +126,61 @@ static const size_t MEMORY_CHUNK_SIZE = 128 * 1024;
 /** A buffer for reading (and buffering) savegame data. */
 struct ReadBuffer {
 	uint8_t buf[MEMORY_CHUNK_SIZE]; ///< Buffer we're going to read from.
-	uint8_t *bufp = nullptr; ///< Location we're at reading the buffer.
-	uint8_t *bufe = nullptr; ///< End of the buffer we can read from.
+	const uint8_t *bufp = nullptr; ///< Location we're at reading the buffer.
+	const uint8_t *bufe = nullptr; ///< End of the buffer we can read from.
 	std::shared_ptr<LoadFilter> reader{}; ///< The filter used to actually read.
 	size_t read = 0; ///< The amount of read bytes so far from the filter.
+	bool in_place; ///< Whether we read from the filter's memory, instead of copying into our buffer.
 
 	/**
 	 * Initialise our variables.
 	 * @param reader The filter to actually read data.
 	 */
-	ReadBuffer(std::shared_ptr<LoadFilter> reader) : reader(std::move(reader))
+	ReadBuffer(std::shared_ptr<LoadFilter> reader) : reader(std::move(reader)), in_place(this->reader->CanReadInPlace())
 	{
 	}
 
-	inline uint8_t ReadByte()
+	/** Read the next block of data from the filter into the buffer. */
+	void FillBuffer()
 	{
-		if (this->bufp == this->bufe) {
-			size_t len = this->reader->Read(this->buf, lengthof(this->buf));
-			if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
-
-			this->read += len;
-			this->bufp = this->buf;
-			this->bufe = this->buf + len;
+		std::span<const uint8_t> data;
+		if (this->in_place) {
+			data = this->reader->ReadInPlace(SIZE_MAX);
+		} else {
+			data = std::span(this->buf, this->reader->Read(this->buf, lengthof(this->buf)));
 		}
+		if (data.empty()) SlErrorCorrupt("Unexpected end of chunk");
+
+		this->read += data.size();
+		this->bufp = data.data();
+		this->bufe = data.data() + data.size();
+	}
+
+	inline uint8_t ReadByte()
+	{
+		if (this->bufp == this->bufe) this->FillBuffer();
 
 		return *this->bufp++;
 	}
 
+	/**
+	 * Read a number of bytes at once, copying them a buffer at a time.
+	 * @param ptr The memory to read into.
+	 * @param length The number of bytes to read.
+	 */
+	void CopyBytes(uint8_t *ptr, size_t length)
+	{
+		while (length != 0) {
+			if (this->bufp == this->bufe) this->FillBuffer();
+
+			size_t n = std::min<size_t>(length, this->bufe - this->bufp);
+			std::copy_n(this->bufp, n, ptr);
+			this->bufp += n;
+			ptr += n;
+			length -= n;
+		}
+	}
+
 	/**
 	 * Get the size of the memory dump made so far.
 	 * @return The size.
@@ -163,6 +213,27 @@ struct MemoryDumper {
 		*this->buf++ = b;
 	}
 
+	/**
+	 * Write a number of bytes at once, copying them a block at a time.
+	 * @param ptr The bytes to write.
+	 * @param length The number of bytes to write.
+	 */
+	void CopyBytes(const uint8_t *ptr, size_t length)
+	{
+		while (length != 0) {
+			/* Are we at the end of this chunk? */
+			if (this->buf == this->bufe) {
+				this->buf = this->blocks.emplace_back(std::make_unique<uint8_t[]>(MEMORY_CHUNK_SIZE)).get();
+				this->bufe = this->buf + MEMORY_CHUNK_SIZE;
+			}
+
+			size_t n = std::min<size_t>(length, this->bufe - this->buf);
+			this->buf = std::copy_n(ptr, n, this->buf);
+			ptr += n;
+			length -= n;
+		}
+	}
+
 	/**
 	 * Flush this dumper into a writer.
 	 * @param writer The filter we want to use.
@@ -213,6 +284,7 @@ struct SaveLoadParams {
 	std::string extra_msg;               ///< the error message
 
 	bool saveinprogress;                 ///< Whether there is currently a save in progress.
+	std::string format;                  ///< The format, and compression level, the save in progress is written with.
 };
 
 static SaveLoadParams _sl; ///< Parameters used for/at saveload.
@@ -336,8 +408,19 @@ static void SlNullPointers()
  * @note This function does never return as it throws an exception to
  *       break out of all the saveload code.
  */
+/** An error of the savegame read ahead thread, to be raised again on the loader thread. */
+struct SlReadAheadError {
+	StringID string; ///< The translatable error message.
+	std::string extra_msg; ///< The extra, untranslated, error message.
+};
+
+static thread_local bool _sl_read_ahead_thread = false; ///< Whether this is the savegame read ahead thread.
+
 [[noreturn]] void SlError(StringID string, const std::string &extra_msg)
 {
+	/* The read ahead thread must not touch the state of the loader. */
+	if (_sl_read_ahead_thread) throw SlReadAheadError{string, extra_msg};
+
 	/* Distinguish between loading into _load_check_data vs. normal save/load. */
 	if (_sl.action == SLA_LOAD_CHECK) {
 		_load_check_data.error = string;
@@ -376,6 +459,44 @@ typedef void (*AsyncSaveFinishProc)();                      ///< Callback for wh
 static std::atomic<AsyncSaveFinishProc> _async_save_finish; ///< Callback to call when the savegame loading is finished.
 static std::thread _save_thread;                            ///< The thread we're using to compress and write a savegame
 
+#ifdef WITH_FORKED_AUTOSAVE
+static pid_t _autosave_child_pid = -1; ///< Process writing the forked autosave, or -1 when there is none.
+static int _autosave_child_pipe = -1;  ///< Read end of the pipe the forked autosave reports its error through.
+
+/**
+ * Collect the result of the forked autosave once its process has finished.
+ * @param wait Whether to block until the process has finished.
+ */
+static void CheckForkedAutosave(bool wait)
+{
+	if (_autosave_child_pid == -1) return;
+
+	int status = 0;
+	pid_t pid;
+	do {
+		pid = waitpid(_autosave_child_pid, &status, wait ? 0 : WNOHANG);
+	} while (pid == -1 && errno == EINTR);
+	if (pid == 0) return;
+
+	/* The child has exited, so everything it wrote is in the pipe already. */
+	std::string message;
+	char buf[256];
+	ssize_t len;
+	while ((len = read(_autosave_child_pipe, buf, sizeof(buf))) > 0) message.append(buf, len);
+	close(_autosave_child_pipe);
+
+	_autosave_child_pipe = -1;
+	_autosave_child_pid = -1;
+
+	InvalidateWindowData(WC_STATUS_BAR, 0, SBI_SAVELOAD_FINISH);
+
+	if (pid == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		Debug(sl, 0, "Forked autosave failed: {}", message.empty() ? "process terminated abnormally" : message);
+		ShowErrorMessage(GetEncodedString(STR_ERROR_AUTOSAVE_FAILED), {}, WL_ERROR);
+	}
+}
+#endif /* WITH_FORKED_AUTOSAVE */
+
 /**
  * Called by save thread to tell we finished saving.
  * @param proc The callback to call when saving is done.
@@ -393,6 +514,10 @@ static void SetAsyncSaveFinish(AsyncSaveFinishProc proc)
  */
 void ProcessAsyncSaveFinish()
 {
+#ifdef WITH_FORKED_AUTOSAVE
+	CheckForkedAutosave(false);
+#endif
+
 	AsyncSaveFinishProc proc = _async_save_finish.exchange(nullptr, std::memory_order_acq_rel);
 	if (proc == nullptr) return;
 
@@ -787,10 +912,10 @@ static void SlCopyBytes(void *ptr, size_t length)
 	switch (_sl.action) {
 		case SLA_LOAD_CHECK:
 		case SLA_LOAD:
-			for (; length != 0; length--) *p++ = SlReadByte();
+			_sl.reader->CopyBytes(p, length);
 			break;
 		case SLA_SAVE:
-			for (; length != 0; length--) SlWriteByte(*p++);
+			_sl.dumper->CopyBytes(p, length);
 			break;
 		default: NOT_REACHED();
 	}
@@ -2141,6 +2266,94 @@ void ChunkHandler::LoadCheck(size_t len) const
 	}
 }
 
+#ifdef WITH_MAPPED_SAVEGAME_READER
+/*
+ * Reading a mapped file beyond its end raises SIGBUS, which happens when the savegame is
+ * truncated while it is being loaded. The handler maps zeros over the missing pages so the
+ * read can continue, and the load fails once the current chunk has been read.
+ */
+static std::atomic<const uint8_t *> _sl_mapping_begin = nullptr; ///< Begin of the mapped savegame, or \c nullptr when none is mapped.
+static std::atomic<const uint8_t *> _sl_mapping_end = nullptr; ///< End of the mapped savegame.
+static size_t _sl_mapping_page_size = 0; ///< Size of a memory page.
+static volatile sig_atomic_t _sl_mapping_truncated = 0; ///< Whether part of the mapped savegame could not be read.
+static struct sigaction _sl_mapping_old_bus_action; ///< The SIGBUS handler before the savegame was mapped.
+
+/**
+ * Handle a bus error, caused by reading beyond the end of the mapped savegame.
+ * @param info Information about the signal, including the faulting address.
+ */
+static void HandleMappedSavegameBusError(int, siginfo_t *info, void *)
+{
+	const uint8_t *addr = static_cast<const uint8_t *>(info->si_addr);
+	const uint8_t *begin = _sl_mapping_begin.load();
+	if (begin != nullptr && addr >= begin && addr < _sl_mapping_end.load()) {
+		uintptr_t page = reinterpret_cast<uintptr_t>(addr) & ~static_cast<uintptr_t>(_sl_mapping_page_size - 1);
+		if (mmap(reinterpret_cast<void *>(page), _sl_mapping_page_size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) != MAP_FAILED) {
+			_sl_mapping_truncated = 1;
+			return;
+		}
+	}
+
+	/* Not ours; the access is retried with the previous handler, e.g. the crash log. */
+	sigaction(SIGBUS, &_sl_mapping_old_bus_action, nullptr);
+}
+
+/**
+ * Start handling bus errors for a mapped savegame.
+ * @param mapping The mapped savegame.
+ * @param size The size of the mapping.
+ * @return True iff the handler is installed; only one savegame can be mapped at a time.
+ */
+static bool InstallMappedSavegameBusHandler(const uint8_t *mapping, size_t size)
+{
+	if (_sl_mapping_begin.load() != nullptr) return false;
+
+	struct sigaction action {};
+	action.sa_sigaction = HandleMappedSavegameBusError;
+	action.sa_flags = SA_SIGINFO;
+	sigemptyset(&action.sa_mask);
+
+	_sl_mapping_page_size = sysconf(_SC_PAGESIZE);
+	_sl_mapping_truncated = 0;
+	_sl_mapping_end = mapping + size;
+	_sl_mapping_begin = mapping;
+	if (sigaction(SIGBUS, &action, &_sl_mapping_old_bus_action) != 0) {
+		_sl_mapping_begin = nullptr;
+		return false;
+	}
+	return true;
+}
+
+/** Stop handling bus errors for the mapped savegame, before it is unmapped. */
+static void RemoveMappedSavegameBusHandler()
+{
+	sigaction(SIGBUS, &_sl_mapping_old_bus_action, nullptr);
+	_sl_mapping_begin = nullptr;
+}
+#endif /* WITH_MAPPED_SAVEGAME_READER */
+
+/** Fail the load when the mapped savegame turned out to be truncated while reading it. */
+static void SlCheckMappedSavegame()
+{
+#ifdef WITH_MAPPED_SAVEGAME_READER
+	if (_sl_mapping_truncated) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE, "Savegame was truncated while loading");
+#endif /* WITH_MAPPED_SAVEGAME_READER */
+}
+
+/** Timings and sizes of a chunk, over the saves and loads since the statistics were reset. */
+struct SaveLoadChunkStats {
+	uint saves = 0; ///< Number of times the chunk has been saved.
+	uint loads = 0; ///< Number of times the chunk has been loaded.
+	std::chrono::nanoseconds save_time{}; ///< Total time spent saving the chunk.
+	std::chrono::nanoseconds load_time{}; ///< Total time spent loading the chunk.
+	size_t save_bytes = 0; ///< Total number of bytes the chunk was saved into, before compression.
+	size_t load_bytes = 0; ///< Total number of bytes the chunk was loaded from, after decompression.
+};
+
+static std::map<uint32_t, SaveLoadChunkStats> _sl_chunk_stats; ///< The statistics per chunk ID.
+static SaveLoadChunkStats _sl_afterload_stats; ///< The statistics of AfterLoadGame, as if it were a chunk; only the load fields are used.
+static uint _sl_benchmark_remaining = 0; ///< Number of loads the savegame benchmark still has to do.
+
 /**
  * Load a chunk of data (eg vehicles, stations, etc.)
  * @param ch The chunkhandler that will be used for the operation
@@ -2288,7 +2501,15 @@ static void SlSaveChunk(const ChunkHandler &ch)
 static void SlSaveChunks()
 {
 	for (auto &ch : ChunkHandlers()) {
+		auto start = std::chrono::steady_clock::now();
+		size_t start_size = _sl.dumper->GetSize();
+
 		SlSaveChunk(ch);
+
+		SaveLoadChunkStats &stats = _sl_chunk_stats[ch.get().id];
+		stats.saves++;
+		stats.save_time += std::chrono::steady_clock::now() - start;
+		stats.save_bytes += _sl.dumper->GetSize() - start_size;
 	}
 
 	/* Terminator */
@@ -2318,8 +2539,45 @@ static void SlLoadChunks()
 
 		ch = SlFindChunkHandler(id);
 		if (ch == nullptr) SlErrorCorrupt("Unknown chunk type");
+
+		auto start = std::chrono::steady_clock::now();
+		size_t start_size = _sl.reader->GetSize();
+
 		SlLoadChunk(*ch);
+		SlCheckMappedSavegame();
+
+		SaveLoadChunkStats &stats = _sl_chunk_stats[id];
+		stats.loads++;
+		stats.load_time += std::chrono::steady_clock::now() - start;
+		stats.load_bytes += _sl.reader->GetSize() - start_size;
 	}
+	SlCheckMappedSavegame();
+}
+
+/** Print the statistics of saving and loading the chunks to the console, averaged per save or load. */
+static void ConPrintSaveLoadChunkStats()
+{
+	auto print = [](std::string_view name, const SaveLoadChunkStats &stats) {
+		std::string load = stats.loads == 0 ? "-" : fmt::format("{} us, {} bytes", std::chrono::duration_cast<std::chrono::microseconds>(stats.load_time).count() / stats.loads, stats.load_bytes / stats.loads);
+		std::string save = stats.saves == 0 ? "-" : fmt::format("{} us, {} bytes", std::chrono::duration_cast<std::chrono::microseconds>(stats.save_time).count() / stats.saves, stats.save_bytes / stats.saves);
+		IConsolePrint(CC_DEFAULT, "{}: load {}; save {}", name, load, save);
+	};
+
+	for (const auto &[id, stats] : _sl_chunk_stats) {
+		print(fmt::format("{:c}{:c}{:c}{:c}", id >> 24, id >> 16, id >> 8, id), stats);
+	}
+	print("AfterLoadGame", _sl_afterload_stats);
+}
+
+/**
+ * Start the savegame benchmark. The caller must start loading the savegame.
+ * @param count The number of times to load the savegame.
+ */
+void StartSaveLoadBenchmark(uint count)
+{
+	_sl_chunk_stats.clear();
+	_sl_afterload_stats = {};
+	_sl_benchmark_remaining = count;
 }
 
 /** Load all chunks for savegame checking */
@@ -2334,7 +2592,9 @@ static void SlLoadCheckChunks()
 		ch = SlFindChunkHandler(id);
 		if (ch == nullptr) SlErrorCorrupt("Unknown chunk type");
 		SlLoadCheckChunk(*ch);
+		SlCheckMappedSavegame();
 	}
+	SlCheckMappedSavegame();
 }
 
 /** Fix all pointers (convert index -> pointer) */
@@ -2355,6 +2615,11 @@ static void SlFixPointers()
 struct FileReader : LoadFilter {
 	std::optional<FileHandle> file; ///< The file to read from.
 	long begin; ///< The begin of the file.
+#ifdef WITH_MAPPED_SAVEGAME_READER
+	const uint8_t *mapping = nullptr; ///< The file mapped into memory, once reading in place has been asked for.
+	size_t mapping_size = 0; ///< The size of the mapped file.
+	size_t mapping_pos = 0; ///< The position we are reading the mapped file at.
+#endif /* WITH_MAPPED_SAVEGAME_READER */
 
 	/**
 	 * Create the file reader, so it reads from a specific file.
@@ -2367,6 +2632,14 @@ struct FileReader : LoadFilter {
 	/** Make sure everything is cleaned up. */
 	~FileReader() override
 	{
+#ifdef WITH_MAPPED_SAVEGAME_READER
+		if (this->mapping != nullptr) {
+			_game_session_stats.savegame_size = this->mapping_pos - this->begin;
+			RemoveMappedSavegameBusHandler();
+			munmap(const_cast<uint8_t *>(this->mapping), this->mapping_size);
+			return;
+		}
+#endif /* WITH_MAPPED_SAVEGAME_READER */
 		if (this->file.has_value()) {
 			_game_session_stats.savegame_size = ftell(*this->file) - this->begin;
 		}
@@ -2377,11 +2650,67 @@ struct FileReader : LoadFilter {
 		/* We're in the process of shutting down, i.e. in "failure" mode. */
 		if (!this->file.has_value()) return 0;
 
+#ifdef WITH_MAPPED_SAVEGAME_READER
+		if (this->mapping != nullptr) {
+			std::span<const uint8_t> data = this->ReadInPlace(size);
+			std::copy_n(data.data(), data.size(), buf);
+			return data.size();
+		}
+#endif /* WITH_MAPPED_SAVEGAME_READER */
 		return fread(buf, 1, size, *this->file);
 	}
 
+#ifdef WITH_MAPPED_SAVEGAME_READER
+	/**
+	 * Map the rest of the file into memory, so it can be read without copying it.
+	 * Pages are only read from disk when they are touched, and are shared with the file cache.
+	 * Should the file be truncated while it is mapped, the load fails instead of crashing.
+	 * @return True iff the file is mapped.
+	 */
+	bool CanReadInPlace() override
+	{
+		if (this->mapping != nullptr) return true;
+		if (!this->file.has_value()) return false;
+
+		int fd = fileno(*this->file);
+		struct stat st;
+		long pos = ftell(*this->file);
+		if (fd == -1 || pos < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= pos) return false;
+
+		void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED) {
+			Debug(sl, 1, "Could not map the savegame into memory, reading it instead: {}", strerror(errno));
+			return false;
+		}
+		if (!InstallMappedSavegameBusHandler(static_cast<const uint8_t *>(mapping), st.st_size)) {
+			munmap(mapping, st.st_size);
+			return false;
+		}
+		madvise(mapping, st.st_size, MADV_SEQUENTIAL);
+
+		this->mapping = static_cast<const uint8_t *>(mapping);
+		this->mapping_size = st.st_size;
+		this->mapping_pos = pos;
+		return true;
+	}
+
+	std::span<const uint8_t> ReadInPlace(size_t size) override
+	{
+		size = std::min(size, this->mapping_size - this->mapping_pos);
+		std::span<const uint8_t> data(this->mapping + this->mapping_pos, size);
+		this->mapping_pos += size;
+		return data;
+	}
+#endif /* WITH_MAPPED_SAVEGAME_READER */
+
 	void Reset() override
 	{
+#ifdef WITH_MAPPED_SAVEGAME_READER
+		if (this->mapping != nullptr) {
+			this->mapping_pos = this->begin;
+			return;
+		}
+#endif /* WITH_MAPPED_SAVEGAME_READER */
 		clearerr(*this->file);
 		if (fseek(*this->file, this->begin, SEEK_SET)) {
 			Debug(sl, 1, "Could not reset the file reading");
@@ -2424,6 +2753,151 @@ struct FileWriter : SaveFilter {
 	}
 };
 
+/**
+ * Filter that reads ahead of the loader in a separate thread. This way the
+ * decompression of the next blocks of the savegame overlaps with the parsing
+ * of the chunks, instead of both alternating on the same thread.
+ */
+struct ReadAheadLoadFilter : LoadFilter {
+	static constexpr size_t BLOCK_COUNT = 8; ///< The number of blocks that can be read ahead.
+
+	/** A block of read ahead data. */
+	struct Block {
+		std::array<uint8_t, MEMORY_CHUNK_SIZE> data; ///< The read data.
+		size_t length = 0; ///< The number of valid bytes in the data.
+	};
+
+	std::array<Block, BLOCK_COUNT> blocks{}; ///< Ring buffer of read ahead blocks.
+	size_t head = 0; ///< The number of blocks fully consumed by the loader.
+	size_t tail = 0; ///< The number of blocks filled by the read ahead thread.
+	size_t offset = 0; ///< The number of bytes consumed from the block at the head.
+	bool finished = false; ///< Whether the read ahead thread has reached the end of the savegame or an error.
+	bool stop = false; ///< Whether the read ahead thread has to stop.
+	std::optional<SlReadAheadError> error{}; ///< The error the read ahead thread ran into, to be passed on to the loader.
+	std::mutex lock; ///< Lock for the state shared between the threads.
+	std::condition_variable cv; ///< Signal for changes to the state shared between the threads.
+	std::thread thread; ///< The read ahead thread.
+	bool threaded = false; ///< Whether the read ahead thread is used, or we just pass the reads on.
+
+	/**
+	 * Initialise this filter and start reading ahead.
+	 * @param chain The next filter in this chain.
+	 */
+	ReadAheadLoadFilter(std::shared_ptr<LoadFilter> chain) : LoadFilter(std::move(chain))
+	{
+		this->StartThread();
+	}
+
+	/** Stop the read ahead thread. */
+	~ReadAheadLoadFilter()
+	{
+		this->StopThread();
+	}
+
+	/** Start the read ahead thread; when that fails just read synchronously. */
+	void StartThread()
+	{
+		this->threaded = StartNewThread(&this->thread, "ottd:loadgame", [this]() { this->ReadAhead(); });
+		if (!this->threaded) Debug(sl, 1, "Cannot create savegame read ahead thread, reverting to single-threaded mode...");
+	}
+
+	/** Stop the read ahead thread, if it is running. */
+	void StopThread()
+	{
+		if (!this->thread.joinable()) return;
+
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->stop = true;
+		}
+		this->cv.notify_all();
+		this->thread.join();
+	}
+
+	/** Fill the free blocks of the ring buffer from the chain, until the end of the savegame. */
+	void ReadAhead()
+	{
+		_sl_read_ahead_thread = true;
+		try {
+			for (;;) {
+				Block *block;
+				{
+					std::unique_lock<std::mutex> guard(this->lock);
+					this->cv.wait(guard, [this]() { return this->stop || this->tail - this->head < BLOCK_COUNT; });
+					if (this->stop) return;
+					block = &this->blocks[this->tail % BLOCK_COUNT];
+				}
+
+				/* The loader does not touch the blocks after the tail, so no need to hold the lock. */
+				block->length = this->chain->Read(block->data.data(), block->data.size());
+
+				std::lock_guard<std::mutex> guard(this->lock);
+				if (block->length == 0) {
+					this->finished = true;
+				} else {
+					this->tail++;
+				}
+				this->cv.notify_all();
+				if (this->finished) return;
+			}
+		} catch (SlReadAheadError &e) {
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->error = std::move(e);
+			this->finished = true;
+			this->cv.notify_all();
+		} catch (...) {
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->error = SlReadAheadError{STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "savegame read ahead failed"};
+			this->finished = true;
+			this->cv.notify_all();
+		}
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		if (!this->threaded) return this->chain->Read(buf, size);
+
+		std::unique_lock<std::mutex> guard(this->lock);
+		this->cv.wait(guard, [this]() { return this->head != this->tail || this->finished; });
+		if (this->head == this->tail) {
+			/* All data before the error has been read, now pass it on. */
+			if (this->error.has_value()) SlError(this->error->string, this->error->extra_msg);
+			return 0;
+		}
+		guard.unlock();
+
+		/* The read ahead thread does not touch the block at the head, so no need to hold the lock. */
+		const Block &block = this->blocks[this->head % BLOCK_COUNT];
+		size_t len = std::min(size, block.length - this->offset);
+		std::copy_n(block.data.data() + this->offset, len, buf);
+		this->offset += len;
+
+		if (this->offset == block.length) {
+			guard.lock();
+			this->head++;
+			this->offset = 0;
+			guard.unlock();
+			this->cv.notify_all();
+		}
+		return len;
+	}
+
+	void Reset() override
+	{
+		this->StopThread();
+
+		this->head = 0;
+		this->tail = 0;
+		this->offset = 0;
+		this->finished = false;
+		this->stop = false;
+		this->error.reset();
+
+		this->chain->Reset();
+		this->StartThread();
+	}
+};
+
 /*******************************************
  ********** START OF LZO CODE **************
  *******************************************/
@@ -2534,6 +3008,16 @@ struct NoCompLoadFilter : LoadFilter {
 	{
 		return this->chain->Read(buf, size);
 	}
+
+	bool CanReadInPlace() override
+	{
+		return this->chain->CanReadInPlace();
+	}
+
+	std::span<const uint8_t> ReadInPlace(size_t size) override
+	{
+		return this->chain->ReadInPlace(size);
+	}
 };
 
 /** Filter without any compression. */
@@ -2788,6 +3272,121 @@ struct LZMASaveFilter : SaveFilter {
 
 #endif /* WITH_LIBLZMA */
 
+/********************************************
+ ********** START OF ZSTD CODE **************
+ ********************************************/
+
+#if defined(WITH_ZSTD)
+
+/** Filter using Zstandard decompression. */
+struct ZSTDLoadFilter : LoadFilter {
+	ZSTD_DCtx *zstd;                      ///< Stream state that we are reading from.
+	ZSTD_inBuffer input;                  ///< The part of fread_buf that has not been decompressed yet.
+	uint8_t fread_buf[MEMORY_CHUNK_SIZE]; ///< Buffer for reading from the file.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	ZSTDLoadFilter(std::shared_ptr<LoadFilter> chain) : LoadFilter(std::move(chain)), zstd(ZSTD_createDCtx()), input({this->fread_buf, 0, 0})
+	{
+		if (this->zstd == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize decompressor");
+	}
+
+	/** Clean up what we allocated. */
+	~ZSTDLoadFilter() override
+	{
+		ZSTD_freeDCtx(this->zstd);
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		ZSTD_outBuffer output = {buf, size, 0};
+
+		while (output.pos < output.size) {
+			/* read more bytes from the file? */
+			if (this->input.pos == this->input.size) {
+				this->input.size = this->chain->Read(this->fread_buf, sizeof(this->fread_buf));
+				this->input.pos = 0;
+			}
+
+			size_t last_pos = output.pos;
+			size_t r = ZSTD_decompressStream(this->zstd, &output, &this->input);
+			if (ZSTD_isError(r)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "libzstd returned error code");
+
+			/* Nothing left in the file, and nothing left in the decompressor either. */
+			if (this->input.size == 0 && output.pos == last_pos) break;
+		}
+
+		return output.pos;
+	}
+};
+
+/** Filter using Zstandard compression. */
+struct ZSTDSaveFilter : SaveFilter {
+	ZSTD_CCtx *zstd;                       ///< Stream state that we are writing to.
+	uint8_t fwrite_buf[MEMORY_CHUNK_SIZE]; ///< Buffer for writing to the file.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain             The next filter in this chain.
+	 * @param compression_level The requested level of compression.
+	 */
+	ZSTDSaveFilter(std::shared_ptr<SaveFilter> chain, uint8_t compression_level) : SaveFilter(std::move(chain)), zstd(ZSTD_createCCtx())
+	{
+		if (this->zstd == nullptr || ZSTD_isError(ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_compressionLevel, compression_level))) {
+			SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize compressor");
+		}
+
+		/* Compress on a few worker threads. This fails when libzstd is built without
+		 * multi-threading support, in which case it just compresses on this thread. */
+		uint threads = std::thread::hardware_concurrency();
+		if (threads > 1) ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_nbWorkers, std::min(threads, 4U));
+	}
+
+	/** Clean up what we allocated. */
+	~ZSTDSaveFilter() override
+	{
+		ZSTD_freeCCtx(this->zstd);
+	}
+
+	/**
+	 * Helper loop for writing the data.
+	 * @param p    The bytes to write.
+	 * @param len  Amount of bytes to write.
+	 * @param mode Whether to continue the stream or to finish it.
+	 */
+	void WriteLoop(uint8_t *p, size_t len, ZSTD_EndDirective mode)
+	{
+		ZSTD_inBuffer input = {p, len, 0};
+		for (;;) {
+			ZSTD_outBuffer output = {this->fwrite_buf, sizeof(this->fwrite_buf), 0};
+
+			size_t remaining = ZSTD_compressStream2(this->zstd, &output, &input, mode);
+			if (ZSTD_isError(remaining)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "libzstd returned error code");
+
+			/* bytes were emitted? */
+			if (output.pos != 0) this->chain->Write(this->fwrite_buf, output.pos);
+
+			/* When continuing all input must be taken in, when finishing everything must be flushed as well. */
+			if (mode == ZSTD_e_continue ? input.pos == input.size : remaining == 0) break;
+		}
+	}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		this->WriteLoop(buf, size, ZSTD_e_continue);
+	}
+
+	void Finish() override
+	{
+		this->WriteLoop(nullptr, 0, ZSTD_e_end);
+		this->chain->Finish();
+	}
+};
+
+#endif /* WITH_ZSTD */
+
 /*******************************************
  ************* END OF CODE *****************
  *******************************************/
@@ -2809,6 +3408,7 @@ static const uint32_t SAVEGAME_TAG_LZO = TO_BE32('OTTD');
 static const uint32_t SAVEGAME_TAG_NONE = TO_BE32('OTTN');
 static const uint32_t SAVEGAME_TAG_ZLIB = TO_BE32('OTTZ');
 static const uint32_t SAVEGAME_TAG_LZMA = TO_BE32('OTTX');
+static const uint32_t SAVEGAME_TAG_ZSTD = TO_BE32('OTTS');
 
 /** The different saveload formats known/understood by OpenTTD. */
 static const SaveLoadFormat _saveload_formats[] = {
@@ -2828,6 +3428,14 @@ static const SaveLoadFormat _saveload_formats[] = {
 #else
 	{"zlib", SAVEGAME_TAG_ZLIB, nullptr,                            nullptr,                            0, 0, 0},
 #endif
+#if defined(WITH_ZSTD)
+	/* Compresses on up to four worker threads. Level 3 is several times as fast as lzma level 2 for both saving and
+	 * loading, at savegames roughly a quarter larger; the highest levels get close to lzma, but are much slower again.
+	 * It comes before lzma, so lzma stays the default and savegames keep loading in builds without libzstd. */
+	{"zstd", SAVEGAME_TAG_ZSTD, CreateLoadFilter<ZSTDLoadFilter>,   CreateSaveFilter<ZSTDSaveFilter>,   1, 3, 19},
+#else
+	{"zstd", SAVEGAME_TAG_ZSTD, nullptr,                            nullptr,                            0, 0, 0},
+#endif
 #if defined(WITH_LIBLZMA)
 	/* Level 2 compression is speed wise as fast as zlib level 6 compression (old default), but results in ~10% smaller saves.
 	 * Higher compression levels are possible, and might improve savegame size by up to 25%, but are also up to 10 times slower.
@@ -2988,8 +3596,10 @@ static void SaveFileError()
  */
 static SaveOrLoadResult SaveFileToDisk(bool threaded)
 {
+	TraceZone zone("SaveFileToDisk");
+
 	try {
-		auto [fmt, compression] = GetSavegameFormat(_savegame_format);
+		auto [fmt, compression] = GetSavegameFormat(_sl.format);
 
 		/* We have written our stuff to memory, now write it to file! */
 		uint32_t hdr[2] = { fmt.tag, TO_BE32(SAVEGAME_VERSION << 16) };
@@ -3027,6 +3637,10 @@ static SaveOrLoadResult SaveFileToDisk(bool threaded)
 
 void WaitTillSaved()
 {
+#ifdef WITH_FORKED_AUTOSAVE
+	CheckForkedAutosave(true);
+#endif
+
 	if (!_save_thread.joinable()) return;
 
 	_save_thread.join();
@@ -3041,16 +3655,20 @@ void WaitTillSaved()
  * using the writer, either in threaded mode if possible, or single-threaded.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
+ * @param format   The format, and compression level, to write the savegame with.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
  */
-static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded)
+static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded, std::string_view format)
 {
+	TraceZone zone("DoSave");
+
 	assert(!_sl.saveinprogress);
 
 	_sl.dumper = std::make_unique<MemoryDumper>();
 	_sl.sf = std::move(writer);
 
 	_sl_version = SAVEGAME_VERSION;
+	_sl.format = format;
 
 	SaveViewportBeforeSaveGame();
 	SlSaveChunks();
@@ -3071,6 +3689,8 @@ static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded
 
 /**
  * Save the game using a (writer) filter.
+ * This is used for sending the map to joining clients; they wait for it to arrive,
+ * so the savegame may be written with a faster compression than regular savegames.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
@@ -3079,13 +3699,53 @@ SaveOrLoadResult SaveWithFilter(std::shared_ptr<SaveFilter> writer, bool threade
 {
 	try {
 		_sl.action = SLA_SAVE;
-		return DoSave(std::move(writer), threaded);
+		return DoSave(std::move(writer), threaded, _network_savegame_format.empty() ? _savegame_format : _network_savegame_format);
 	} catch (...) {
 		ClearSaveLoadState();
 		return SL_ERROR;
 	}
 }
 
+/** Filter discarding the savegame, for measuring how long saving takes. */
+struct NullSaveFilter : SaveFilter {
+	NullSaveFilter() : SaveFilter(nullptr)
+	{
+	}
+
+	void Write(uint8_t *, size_t) override
+	{
+	}
+};
+
+/**
+ * Continue the savegame benchmark after the savegame has been loaded.
+ * This saves the loaded game into nothing, to measure saving the chunks too.
+ * @param loaded Whether the savegame was loaded successfully.
+ * @return True iff the savegame has to be loaded again.
+ */
+bool SaveLoadBenchmarkAfterLoad(bool loaded)
+{
+	if (_sl_benchmark_remaining == 0) return false;
+
+	if (!loaded) {
+		_sl_benchmark_remaining = 0;
+		IConsolePrint(CC_ERROR, "Savegame benchmark aborted, the savegame could not be loaded.");
+		return false;
+	}
+
+	try {
+		_sl.action = SLA_SAVE;
+		DoSave(std::make_shared<NullSaveFilter>(), false, "none");
+	} catch (...) {
+		ClearSaveLoadState();
+	}
+
+	if (--_sl_benchmark_remaining != 0) return true;
+
+	ConPrintSaveLoadChunkStats();
+	return false;
+}
+
 /**
  * Determines the SaveLoadFormat that is connected to the given tag.
  * When the given tag is known, that format is chosen and a check on the validity of the version is performed.
@@ -3137,6 +3797,8 @@ static const SaveLoadFormat *DetermineSaveLoadFormat(uint32_t tag, uint32_t raw_
  */
 static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_check)
 {
+	TraceZone zone("DoLoad");
+
 	_sl.lf = std::move(reader);
 
 	if (load_check) {
@@ -3158,6 +3820,8 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 	}
 
 	_sl.lf = fmt->init_load(_sl.lf);
+	/* There is nothing to decompress or copy ahead when the savegame can be read in place. */
+	if (!_sl.lf->CanReadInPlace()) _sl.lf = std::make_shared<ReadAheadLoadFilter>(_sl.lf);
 	_sl.reader = std::make_unique<ReadBuffer>(_sl.lf);
 	_next_offs = 0;
 
@@ -3219,7 +3883,11 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 
 		/* After loading fix up savegame for any internal changes that
 		 * might have occurred since then. If it fails, load back the old game. */
-		if (!AfterLoadGame()) {
+		auto start = std::chrono::steady_clock::now();
+		bool after_load = AfterLoadGame();
+		_sl_afterload_stats.loads++;
+		_sl_afterload_stats.load_time += std::chrono::steady_clock::now() - start;
+		if (!after_load) {
 			_gamelog.StopAction();
 			return SL_REINIT;
 		}
@@ -3322,7 +3990,8 @@ SaveOrLoadResult SaveOrLoad(std::string_view filename, SaveLoadOperation fop, De
 			Debug(desync, 1, "save: {:08x}; {:02x}; {}", TimerGameEconomy::date, TimerGameEconomy::date_fract, filename);
 			if (!_settings_client.gui.threaded_saves) threaded = false;
 
-			return DoSave(std::make_shared<FileWriter>(std::move(*fh)), threaded);
+			/* Autosaves are made often and are only kept for a short while, so they may use a faster compression. */
+			return DoSave(std::make_shared<FileWriter>(std::move(*fh)), threaded, (_do_autosave && !_autosave_format.empty()) ? _autosave_format : _savegame_format);
 		}
 
 		/* LOAD game */
@@ -3341,6 +4010,60 @@ SaveOrLoadResult SaveOrLoad(std::string_view filename, SaveLoadOperation fop, De
 	}
 }
 
+#ifdef WITH_FORKED_AUTOSAVE
+/**
+ * Write an autosave from a forked copy of the game.
+ * The child gets a copy-on-write snapshot of the game state, so it can serialise
+ * and compress it while the game itself continues without waiting for the save.
+ * Only the thread calling fork() exists in the child; the savegame code does not
+ * wait for or lock against any of the other threads, and the debug output is
+ * flushed and unlocked around the fork, so the child writes its debug lines itself.
+ * @param filename The name of the autosave.
+ * @return True when the autosave is being written, false when a normal save must be made.
+ */
+static bool DoForkedAutosave(std::string_view filename)
+{
+	/* Never have two saves write at the same time. */
+	WaitTillSaved();
+
+	int fds[2];
+	if (pipe(fds) != 0) return false;
+
+	/* Otherwise anything still buffered would be written by both processes. */
+	DebugPrepareFork();
+	fflush(stdout);
+	fflush(stderr);
+
+	pid_t pid = fork();
+	DebugAfterFork(pid == 0);
+	if (pid == -1) {
+		Debug(sl, 1, "Cannot fork autosave process: {}, reverting to normal saving...", strerror(errno));
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if (pid == 0) {
+		close(fds[0]);
+		SaveOrLoadResult result = SaveOrLoad(filename, SLO_SAVE, DFT_GAME_FILE, AUTOSAVE_DIR, false);
+		if (result != SL_OK) {
+			/* Skip the "colour" character */
+			std::string message = GetSaveLoadErrorType().GetDecodedString().substr(3) + GetSaveLoadErrorMessage().GetDecodedString();
+			[[maybe_unused]] ssize_t written = write(fds[1], message.data(), message.size());
+		}
+		/* Do not run any exit handlers or destructors of the copied game state. */
+		_exit(result == SL_OK ? 0 : 1);
+	}
+
+	close(fds[1]);
+	_autosave_child_pid = pid;
+	_autosave_child_pipe = fds[0];
+
+	InvalidateWindowData(WC_STATUS_BAR, 0, SBI_SAVELOAD_START);
+	return true;
+}
+#endif /* WITH_FORKED_AUTOSAVE */
+
 /**
  * Create an autosave or netsave.
  * @param counter A reference to the counter variable to be used for rotating the file name.
@@ -3357,6 +4080,9 @@ void DoAutoOrNetsave(FiosNumberedSaveName &counter)
 	}
 
 	Debug(sl, 2, "Autosaving to '{}'", filename);
+#ifdef WITH_FORKED_AUTOSAVE
+	if (_settings_client.gui.fork_autosaves && DoForkedAutosave(filename)) return;
+#endif
 	if (SaveOrLoad(filename, SLO_SAVE, DFT_GAME_FILE, AUTOSAVE_DIR) != SL_OK) {
 		ShowErrorMessage(GetEncodedString(STR_ERROR_AUTOSAVE_FAILED), {}, WL_ERROR);
 	}
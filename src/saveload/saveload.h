@@ -461,6 +461,9 @@ void DoAutoOrNetsave(FiosNumberedSaveName &counter);
 SaveOrLoadResult SaveWithFilter(std::shared_ptr<struct SaveFilter> writer, bool threaded);
 SaveOrLoadResult LoadWithFilter(std::shared_ptr<struct LoadFilter> reader);
 
+void StartSaveLoadBenchmark(uint count);
+bool SaveLoadBenchmarkAfterLoad(bool loaded);
+
 typedef void AutolengthProc(int);
 
 /** Type of a chunk. */
@@ -1366,6 +1369,8 @@ inline void SlSkipBytes(size_t length)
 }
 
 extern std::string _savegame_format;
+extern std::string _autosave_format;
+extern std::string _network_savegame_format;
 extern bool _do_autosave;
 
 /**
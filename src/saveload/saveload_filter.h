@@ -34,6 +34,26 @@ struct LoadFilter {
 	 */
 	virtual size_t Read(uint8_t *buf, size_t len) = 0;
 
+	/**
+	 * Whether the savegame can be read in place with #ReadInPlace, instead of copying it with #Read.
+	 * @return True iff reading in place is possible.
+	 */
+	virtual bool CanReadInPlace()
+	{
+		return false;
+	}
+
+	/**
+	 * Get the next bytes of the savegame without copying them.
+	 * @param len The maximum number of bytes to get.
+	 * @return The bytes, which stay valid until this filter is destroyed; empty at the end of the savegame.
+	 * @pre CanReadInPlace()
+	 */
+	virtual std::span<const uint8_t> ReadInPlace([[maybe_unused]] size_t len)
+	{
+		return {};
+	}
+
 	/**
 	 * Reset this filter to read from the beginning of the file.
 	 */
@@ -387,6 +387,7 @@ static bool RealMakeScreenshot(ScreenshotType t, const std::string &name, uint32
 		 * name of the new screenshot (or an empty name). */
 		SetScreenshotWindowVisibility(true);
 		UndrawMouseCursor();
+		ProcessScheduledWindowDirty();
 		DrawDirtyBlocks();
 		SetScreenshotWindowVisibility(false);
 	}
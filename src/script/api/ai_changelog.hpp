@@ -19,6 +19,11 @@
  *
  * This version is not yet released. The following changes are not set in stone yet.
  *
+ * API additions:
+ * \li AIEventController::SetEventTypeEnabled
+ * \li AIEventController::SetAllEventTypesEnabled
+ * \li AIEventController::IsEventTypeEnabled
+ *
  * \b 15.0
  *
  * API additions:
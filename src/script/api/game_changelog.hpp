@@ -19,6 +19,11 @@
  *
  * This version is not yet released. The following changes are not set in stone yet.
  *
+ * API additions:
+ * \li GSEventController::SetEventTypeEnabled
+ * \li GSEventController::SetAllEventTypesEnabled
+ * \li GSEventController::IsEventTypeEnabled
+ *
  * \b 15.0
  *
  * API additions:
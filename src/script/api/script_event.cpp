@@ -28,8 +28,34 @@
 	return result;
 }
 
+/* static */ void ScriptEventController::SetEventTypeEnabled(ScriptEvent::ScriptEventType type, bool enabled)
+{
+	auto &queue = ScriptObject::GetEventQueue();
+	if (enabled == queue.enabled_by_default) {
+		queue.exceptions.erase(type);
+	} else {
+		queue.exceptions.insert(type);
+	}
+}
+
+/* static */ void ScriptEventController::SetAllEventTypesEnabled(bool enabled)
+{
+	auto &queue = ScriptObject::GetEventQueue();
+	queue.enabled_by_default = enabled;
+	queue.exceptions.clear();
+}
+
+/* static */ bool ScriptEventController::IsEventTypeEnabled(ScriptEvent::ScriptEventType type)
+{
+	const auto &queue = ScriptObject::GetEventQueue();
+	return queue.enabled_by_default != queue.exceptions.contains(type);
+}
+
 /* static */ void ScriptEventController::InsertEvent(ScriptEvent *event)
 {
+	/* The caller holds a reference to the event, so a dropped event is freed there. */
+	if (!IsEventTypeEnabled(event->GetEventType())) return;
+
 	ScriptObject::GetEventQueue().push(event);
 }
 
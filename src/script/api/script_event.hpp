@@ -104,6 +104,33 @@ public:
 	 */
 	static ScriptEvent *GetNextEvent();
 
+	/**
+	 * Choose whether events of a type are put in the queue; by default all events are.
+	 *  Events of a disabled type are dropped when they happen, so ignoring
+	 *  events the script has no use for saves handling them.
+	 * @param type The type of events.
+	 * @param enabled Whether the script wants to receive events of this type.
+	 * @note Events that are already waiting are not affected.
+	 * @note This is not saved; set it again after loading a game.
+	 */
+	static void SetEventTypeEnabled(ScriptEvent::ScriptEventType type, bool enabled);
+
+	/**
+	 * Choose whether events of all types are put in the queue. Use this with
+	 *  false and SetEventTypeEnabled to receive only the events of a few types.
+	 * @param enabled Whether the script wants to receive events.
+	 * @note Events that are already waiting are not affected.
+	 * @note This is not saved; set it again after loading a game.
+	 */
+	static void SetAllEventTypesEnabled(bool enabled);
+
+	/**
+	 * Check whether events of a type are put in the queue.
+	 * @param type The type of events.
+	 * @return True if events of this type are received by the script.
+	 */
+	static bool IsEventTypeEnabled(ScriptEvent::ScriptEventType type);
+
 	/**
 	 * Insert an event to the queue for the company.
 	 * @param event The event to insert.
@@ -485,10 +485,13 @@ void ScriptList::AddItem(SQInteger item, SQInteger value)
 {
 	this->modifications++;
 
-	if (this->HasItem(item)) return;
+	/* Lists are mostly filled in increasing order of the items, with the same
+	 * value, so hinting at the end makes most insertions constant time. */
+	size_t count = this->items.size();
+	this->items.try_emplace(this->items.end(), item, value);
+	if (this->items.size() == count) return;
 
-	this->items[item] = value;
-	this->values.emplace(value, item);
+	this->values.emplace_hint(this->values.end(), value, item);
 }
 
 void ScriptList::RemoveItem(SQInteger item)
@@ -554,18 +557,29 @@ bool ScriptList::SetValue(SQInteger item, SQInteger value)
 	auto item_iter = this->items.find(item);
 	if (item_iter == this->items.end()) return false;
 
+	this->UpdateValue(item_iter, value);
+	return true;
+}
+
+/**
+ * Set the value of an item that is known to be in the list.
+ * @param item_iter The item in #items.
+ * @param value The new value.
+ */
+void ScriptList::UpdateValue(ScriptListMap::iterator item_iter, SQInteger value)
+{
 	SQInteger value_old = item_iter->second;
-	if (value_old == value) return true;
+	if (value_old == value) return;
 
+	SQInteger item = item_iter->first;
 	this->sorter->Remove(item);
 	auto value_iter = this->values.find({value_old, item});
 	assert(value_iter != this->values.end());
 	item_iter->second = value;
+	/* Reuse the node, so changing a value never allocates. */
 	auto node_handle = this->values.extract(value_iter);
 	node_handle.value().first = value;
 	this->values.insert(std::move(node_handle));
-
-	return true;
 }
 
 void ScriptList::Sort(SorterType sorter, bool ascending)
@@ -845,6 +859,17 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 	/* Limit the total number of ops that can be consumed by a valuate operation */
 	SQOpsLimiter limiter(vm, MAX_VALUATE_OPS, "valuator function");
 
+	/* API functions without extra parameters, like ScriptTile::GetSlope, are
+	 * called directly instead of through squirrel. That gives the same values
+	 * and costs the same number of ops, as calling a native function from
+	 * squirrel costs none. */
+	const std::function<void(HSQUIRRELVM, SQInteger)> *native_valuator = nullptr;
+	if (nparam == 1) {
+		HSQOBJECT valuator;
+		sq_getstackobj(vm, 2, &valuator);
+		native_valuator = Squirrel::GetNativeValuator(vm, valuator);
+	}
+
 	/* Push the function to call */
 	sq_push(vm, 2);
 
@@ -853,7 +878,8 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 		begin = this->items.lower_bound(this->resume_item.value());
 	}
 
-	for (const auto &[item, _] : std::ranges::subrange(begin, this->items.end())) {
+	for (auto item_iter = begin; item_iter != this->items.end(); ++item_iter) {
+		SQInteger item = item_iter->first;
 		if (disabler.GetOriginalValue() && item != this->resume_item && ScriptController::GetOpsTillSuspend() < 0) {
 			this->resume_item = item;
 			/* Pop the valuator function. */
@@ -865,17 +891,22 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 		/* Check for changing of items. */
 		int previous_modification_count = this->modifications;
 
-		/* Push the root table as instance object, this is what squirrel does for meta-functions. */
-		sq_pushroottable(vm);
-		/* Push all arguments for the valuator function. */
-		sq_pushinteger(vm, item);
-		for (int i = 0; i < nparam - 1; i++) {
-			sq_push(vm, i + 3);
-		}
+		if (native_valuator != nullptr) {
+			/* Pushes the return value, just like the call below. */
+			(*native_valuator)(vm, item);
+		} else {
+			/* Push the root table as instance object, this is what squirrel does for meta-functions. */
+			sq_pushroottable(vm);
+			/* Push all arguments for the valuator function. */
+			sq_pushinteger(vm, item);
+			for (int i = 0; i < nparam - 1; i++) {
+				sq_push(vm, i + 3);
+			}
 
-		/* Call the function. Squirrel pops all parameters and pushes the return value. */
-		if (SQ_FAILED(sq_call(vm, nparam + 1, SQTrue, SQFalse))) {
-			return SQ_ERROR;
+			/* Call the function. Squirrel pops all parameters and pushes the return value. */
+			if (SQ_FAILED(sq_call(vm, nparam + 1, SQTrue, SQFalse))) {
+				return SQ_ERROR;
+			}
 		}
 
 		/* Retrieve the return value */
@@ -909,7 +940,8 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 			return sq_throwerror(vm, "modifying valuated list outside of valuator function");
 		}
 
-		this->SetValue(item, value);
+		this->modifications++;
+		this->UpdateValue(item_iter, value);
 
 		/* Pop the return value. */
 		sq_poptop(vm);
@@ -188,6 +188,10 @@ public:
 	ScriptListMap items;           ///< The items in the list
 	ScriptListSet values; ///< The items in the list, sorted by value
 
+private:
+	void UpdateValue(ScriptListMap::iterator item_iter, SQInteger value);
+
+public:
 	ScriptList();
 	~ScriptList() override;
 
@@ -490,6 +494,10 @@ public:
 	 * @note You can write your own valuators and use them. Just remember that
 	 *  the first parameter should be the index-value, and it should return
 	 *  an integer.
+	 * @note When the valuator is an API function taking just the item, such as
+	 *  ScriptVehicle.GetProfitThisYear, the whole list is valuated without
+	 *  calling back into the script for every item. Valuating a list once per
+	 *  wanted property is then the cheapest way to gather data about many items.
 	 * @note Example:
 	 * @code
 	 *  list.Valuate(ScriptBridge.GetPrice, 5);
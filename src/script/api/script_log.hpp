@@ -20,6 +20,8 @@ class ScriptLog : public ScriptObject {
 	/* ScriptController needs access to Enum and Log, in order to keep the flow from
 	 *  OpenTTD core to script API clear and simple. */
 	friend class ScriptController;
+	/* ScriptInstance writes the profile summary of the script to its log. */
+	friend class ScriptInstance;
 
 public:
 	/**
@@ -31,6 +31,7 @@
 #include "../signs_type.h"
 #include "../story_type.h"
 #include "../misc/endian_buffer.hpp"
+#include "../trace.h"
 
 #include "../safeguards.h"
 
@@ -184,6 +185,8 @@ void ScriptInstance::Died()
 
 void ScriptInstance::GameLoop()
 {
+	TraceZone zone("ScriptInstance::GameLoop");
+
 	ScriptObject::ActiveInstance active(*this);
 
 	if (this->IsDead()) return;
@@ -206,6 +209,7 @@ void ScriptInstance::GameLoop()
 		if (this->is_save_data_on_stack) {
 			sq_poptop(this->engine->GetVM());
 			this->is_save_data_on_stack = false;
+			this->save_data.clear();
 		}
 		try {
 			this->callback(*this);
@@ -256,6 +260,7 @@ void ScriptInstance::GameLoop()
 	if (this->is_save_data_on_stack) {
 		sq_poptop(this->engine->GetVM());
 		this->is_save_data_on_stack = false;
+		this->save_data.clear();
 	}
 
 	/* Continue the VM */
@@ -367,7 +372,7 @@ static const SaveLoad _script_byte[] = {
 	SLEG_VAR("type", _script_sl_byte, SLE_UINT8),
 };
 
-/* static */ bool ScriptInstance::SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, bool test)
+/* static */ bool ScriptInstance::SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, std::vector<uint8_t> &buffer)
 {
 	if (max_depth == 0) {
 		ScriptLog::Error("Savedata can only be nested to 25 deep. No data saved."); // SQUIRREL_MAX_DEPTH = 25
@@ -376,24 +381,16 @@ static const SaveLoad _script_byte[] = {
 
 	switch (sq_gettype(vm, index)) {
 		case OT_INTEGER: {
-			if (!test) {
-				_script_sl_byte = SQSL_INT;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_INT);
 			SQInteger res;
 			sq_getinteger(vm, index, &res);
-			if (!test) {
-				int64_t value = (int64_t)res;
-				SlCopy(&value, 1, SLE_INT64);
-			}
+			/* Integers are stored as SLE_INT64, so in big endian. */
+			uint64_t value = static_cast<uint64_t>(res);
+			for (int shift = 56; shift >= 0; shift -= 8) buffer.push_back(static_cast<uint8_t>(value >> shift));
 			return true;
 		}
 
 		case OT_STRING: {
-			if (!test) {
-				_script_sl_byte = SQSL_STRING;
-				SlObject(nullptr, _script_byte);
-			}
 			std::string_view view;
 			sq_getstring(vm, index, view);
 			size_t len = view.size() + 1;
@@ -401,23 +398,19 @@ static const SaveLoad _script_byte[] = {
 				ScriptLog::Error("Maximum string length is 254 chars. No data saved.");
 				return false;
 			}
-			if (!test) {
-				_script_sl_byte = (uint8_t)len;
-				SlObject(nullptr, _script_byte);
-				SlCopy(const_cast<char *>(view.data()), len, SLE_CHAR);
-			}
+			buffer.push_back(SQSL_STRING);
+			buffer.push_back(static_cast<uint8_t>(len));
+			buffer.insert(buffer.end(), view.begin(), view.end());
+			buffer.push_back('\0');
 			return true;
 		}
 
 		case OT_ARRAY: {
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_ARRAY);
 			sq_pushnull(vm);
 			while (SQ_SUCCEEDED(sq_next(vm, index - 1))) {
 				/* Store the value */
-				bool res = SaveObject(vm, -1, max_depth - 1, test);
+				bool res = SaveObject(vm, -1, max_depth - 1, buffer);
 				sq_pop(vm, 2);
 				if (!res) {
 					sq_pop(vm, 1);
@@ -425,22 +418,16 @@ static const SaveLoad _script_byte[] = {
 				}
 			}
 			sq_pop(vm, 1);
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY_TABLE_END;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_ARRAY_TABLE_END);
 			return true;
 		}
 
 		case OT_TABLE: {
-			if (!test) {
-				_script_sl_byte = SQSL_TABLE;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_TABLE);
 			sq_pushnull(vm);
 			while (SQ_SUCCEEDED(sq_next(vm, index - 1))) {
 				/* Store the key + value */
-				bool res = SaveObject(vm, -2, max_depth - 1, test) && SaveObject(vm, -1, max_depth - 1, test);
+				bool res = SaveObject(vm, -2, max_depth - 1, buffer) && SaveObject(vm, -1, max_depth - 1, buffer);
 				sq_pop(vm, 2);
 				if (!res) {
 					sq_pop(vm, 1);
@@ -448,47 +435,32 @@ static const SaveLoad _script_byte[] = {
 				}
 			}
 			sq_pop(vm, 1);
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY_TABLE_END;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_ARRAY_TABLE_END);
 			return true;
 		}
 
 		case OT_BOOL: {
-			if (!test) {
-				_script_sl_byte = SQSL_BOOL;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_BOOL);
 			SQBool res;
 			sq_getbool(vm, index, &res);
-			if (!test) {
-				_script_sl_byte = res ? 1 : 0;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(res ? 1 : 0);
 			return true;
 		}
 
 		case OT_NULL: {
-			if (!test) {
-				_script_sl_byte = SQSL_NULL;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_NULL);
 			return true;
 		}
 
 		case OT_INSTANCE:{
-			if (!test) {
-				_script_sl_byte = SQSL_INSTANCE;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_INSTANCE);
 			SQInteger top = sq_gettop(vm);
 			try {
 				ScriptObject *obj = static_cast<ScriptObject *>(Squirrel::GetRealInstance(vm, -1, "Object"));
 				if (!obj->SaveObject(vm)) throw std::exception();
 				if (sq_gettop(vm) != top + 2) throw std::exception();
-				if (sq_gettype(vm, -2) != OT_STRING || !SaveObject(vm, -2, max_depth - 1, test)) throw std::exception();
-				if (!SaveObject(vm, -1, max_depth - 1, test)) throw std::exception();
+				if (sq_gettype(vm, -2) != OT_STRING || !SaveObject(vm, -2, max_depth - 1, buffer)) throw std::exception();
+				if (!SaveObject(vm, -1, max_depth - 1, buffer)) throw std::exception();
 				sq_settop(vm, top);
 				return true;
 			} catch (...) {
@@ -522,10 +494,16 @@ void ScriptInstance::Save()
 
 	HSQUIRRELVM vm = this->engine->GetVM();
 	if (this->is_save_data_on_stack) {
+		/* Serialise the data that was just loaded, unless that was done
+		 * already by an earlier pass over this chunk. */
+		if (this->save_data.empty() && !SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, this->save_data)) {
+			this->save_data.clear();
+			SaveEmpty();
+			return;
+		}
 		_script_sl_byte = 1;
 		SlObject(nullptr, _script_byte);
-		/* Save the data that was just loaded. */
-		SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, false);
+		SlCopy(this->save_data.data(), this->save_data.size(), SLE_UINT8);
 	} else if (!this->is_started) {
 		SaveEmpty();
 		return;
@@ -562,12 +540,14 @@ void ScriptInstance::Save()
 			return;
 		}
 		sq_pushobject(vm, savedata);
-		if (SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, true)) {
+		this->save_data.clear();
+		if (SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, this->save_data)) {
 			_script_sl_byte = 1;
 			SlObject(nullptr, _script_byte);
-			SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, false);
+			SlCopy(this->save_data.data(), this->save_data.size(), SLE_UINT8);
 			this->is_save_data_on_stack = true;
 		} else {
+			this->save_data.clear();
 			SaveEmpty();
 			this->engine->CrashOccurred();
 		}
@@ -761,6 +741,7 @@ void ScriptInstance::LoadOnStack(ScriptData *data)
 		sq_pushinteger(vm, std::get<SQInteger>(version));
 		LoadObjects(vm, data);
 		this->is_save_data_on_stack = true;
+		this->save_data.clear();
 	} catch (Script_FatalError &e) {
 		ScriptLog::Warning(fmt::format("Loading failed: {}", e.GetErrorMessage()));
 		/* Discard partially loaded savegame data and version. */
@@ -775,6 +756,7 @@ bool ScriptInstance::CallLoad()
 	if (!this->is_save_data_on_stack) return true;
 	/* Whatever happens, after CallLoad the savegame data is removed from the stack. */
 	this->is_save_data_on_stack = false;
+	this->save_data.clear();
 
 	if (!this->engine->MethodExists(*this->instance, "Load")) {
 		ScriptLog::Warning("Loading failed: there was data for the script to load, but the script does not have a Load() function.");
@@ -847,6 +829,35 @@ size_t ScriptInstance::GetAllocatedMemory() const
 	return this->engine->GetAllocatedMemory();
 }
 
+bool ScriptInstance::SetProfiling(bool enable)
+{
+	if (this->engine == nullptr || this->IsDead()) return false;
+
+	this->engine->SetProfiling(enable);
+	return true;
+}
+
+bool ScriptInstance::IsProfiling() const
+{
+	return this->engine != nullptr && this->engine->IsProfiling();
+}
+
+std::vector<std::string> ScriptInstance::LogProfileSummary(size_t count)
+{
+	if (this->engine == nullptr) return {"No profiling data; the script is not running."};
+
+	ScriptObject::ActiveInstance active(*this);
+	std::vector<std::string> lines = this->engine->GetProfileSummary(count);
+	for (const std::string &line : lines) ScriptLog::Log(ScriptLogTypes::LOG_INFO, line);
+	return lines;
+}
+
+std::string ScriptInstance::GetProfileFoldedStacks() const
+{
+	if (this->engine == nullptr) return {};
+	return this->engine->GetProfileFoldedStacks();
+}
+
 void ScriptInstance::ReleaseSQObject(HSQOBJECT *obj)
 {
 	if (!this->in_shutdown) this->engine->ReleaseObject(obj);
@@ -244,6 +244,31 @@ public:
 
 	size_t GetAllocatedMemory() const;
 
+	/**
+	 * Start or stop profiling the API calls and call stacks of this script.
+	 * @param enable Whether to profile the script.
+	 * @return False when the script is not running, so it cannot be profiled.
+	 */
+	bool SetProfiling(bool enable);
+
+	/**
+	 * Is this script being profiled?
+	 */
+	bool IsProfiling() const;
+
+	/**
+	 * Get a summary of the profiling data of this script, and also write it to its log.
+	 * @param count Number of API functions and call stacks to list.
+	 * @return The lines of the summary.
+	 */
+	std::vector<std::string> LogProfileSummary(size_t count);
+
+	/**
+	 * Get the sampled call stacks of this script in the folded format used by flame graph tools.
+	 * @return The folded call stacks, empty when no profiling data was collected.
+	 */
+	std::string GetProfileFoldedStacks() const;
+
 	/**
 	 * Indicate whether this instance is currently being destroyed.
 	 */
@@ -295,6 +320,7 @@ private:
 	bool is_started = false; ///< Is the scripts constructor executed?
 	bool is_dead = false; ///< True if the script has been stopped.
 	bool is_save_data_on_stack = false; ///< Is the save data still on the squirrel stack?
+	std::vector<uint8_t> save_data; ///< The save data on the stack in the savegame format, once it has been serialised.
 	int suspend = 0; ///< The amount of ticks to suspend this script before it's allowed to continue.
 	bool is_paused = false; ///< Is the script paused? (a paused script will not be executed until unpaused)
 	bool in_shutdown = false; ///< Is this instance currently being destructed?
@@ -316,16 +342,15 @@ private:
 	bool LoadCompatibilityScript(std::string_view api_version, Subdirectory dir);
 
 	/**
-	 * Save one object (int / string / array / table) to the savegame.
+	 * Serialise one object (int / string / array / table) in the savegame format.
 	 * @param vm The virtual machine to get all the data from.
 	 * @param index The index on the squirrel stack of the element to save.
 	 * @param max_depth The maximum depth recursive arrays / tables will be stored
 	 *   with before an error is returned.
-	 * @param test If true, don't really store the data but only check if it is
-	 *   valid.
-	 * @return True if the saving was successful.
+	 * @param buffer The buffer to append the serialised object to.
+	 * @return True if the saving was successful; if not, the buffer contains a partial object.
 	 */
-	static bool SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, bool test);
+	static bool SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, std::vector<uint8_t> &buffer);
 
 	/**
 	 * Load all objects from a savegame.
@@ -20,11 +20,12 @@
 #include "script_types.hpp"
 #include "script_log_types.hpp"
 #include "script_object.hpp"
-
-class ScriptEvent;
+#include "api/script_event.hpp"
 
 /* This is a "struct", so we can forward declare it, and use as incomplete type. */
 struct ScriptEventQueue : std::queue<ScriptObjectRef<ScriptEvent>> {
+	bool enabled_by_default = true; ///< Whether events of types not in #exceptions are queued.
+	std::set<ScriptEvent::ScriptEventType> exceptions; ///< Event types for which #enabled_by_default does not hold.
 };
 
 /**
@@ -20,6 +20,7 @@
 #include <../squirrel/sqvm.h>
 #include "../core/math_func.hpp"
 #include "../core/string_consumer.hpp"
+#include <ranges>
 
 #include "../safeguards.h"
 
@@ -46,6 +47,45 @@ private:
 
 	static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almost any situation
 
+	static const size_t POOL_GRANULARITY = 16; ///< Small allocations are rounded up to a multiple of this.
+	static const size_t POOL_MAX_SIZE = 256; ///< Largest allocation that is recycled through a free list.
+	static const size_t POOL_CLASSES = POOL_MAX_SIZE / POOL_GRANULARITY; ///< Number of size classes.
+
+	/** A block in one of the free lists; it lives in the memory of the freed allocation itself. */
+	struct FreeBlock {
+		FreeBlock *next; ///< Next free block of the same size class.
+	};
+
+	/**
+	 * Freed small blocks, per size class. Squirrel creates and frees many small objects
+	 * (strings, tables, closures) of the same size, so recycling them avoids a trip to
+	 * the global heap for most allocations of a script. The blocks stay owned by this
+	 * allocator, so they are only given back to the heap when the script is destroyed.
+	 */
+	std::array<FreeBlock *, POOL_CLASSES> free_blocks{};
+
+	/**
+	 * Get the size class of an allocation.
+	 * @param size The size of the allocation.
+	 * @return The index in #free_blocks, or #POOL_CLASSES when the allocation is not pooled.
+	 */
+	static constexpr size_t GetSizeClass(size_t size)
+	{
+		if (size == 0 || size > POOL_MAX_SIZE) return POOL_CLASSES;
+		return (size - 1) / POOL_GRANULARITY;
+	}
+
+	/**
+	 * Get how many bytes are really allocated from the heap for a given allocation.
+	 * @param size The size of the allocation.
+	 * @return The size rounded up to its size class.
+	 */
+	static constexpr size_t GetBlockSize(size_t size)
+	{
+		size_t size_class = GetSizeClass(size);
+		return size_class == POOL_CLASSES ? size : (size_class + 1) * POOL_GRANULARITY;
+	}
+
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 	std::map<void *, size_t> allocations;
 #endif
@@ -78,7 +118,15 @@ private:
 	void *DoAlloc(SQUnsignedInteger requested_size)
 	{
 		try {
-			void *p = this->allocator.allocate(requested_size);
+			void *p;
+			size_t size_class = GetSizeClass(requested_size);
+			if (size_class != POOL_CLASSES && this->free_blocks[size_class] != nullptr) {
+				FreeBlock *block = this->free_blocks[size_class];
+				this->free_blocks[size_class] = block->next;
+				p = block;
+			} else {
+				p = this->allocator.allocate(GetBlockSize(requested_size));
+			}
 			assert(p != nullptr);
 			this->allocated_size += requested_size;
 
@@ -135,6 +183,16 @@ public:
 
 		this->CheckAllocationAllowed(size - oldsize);
 
+		if (GetSizeClass(size) != POOL_CLASSES && GetSizeClass(size) == GetSizeClass(oldsize)) {
+			/* The block is already large enough; keep it where it is. */
+			this->allocated_size += size - oldsize;
+#ifdef SCRIPT_DEBUG_ALLOCATIONS
+			assert(this->allocations.at(p) == oldsize);
+			this->allocations[p] = size;
+#endif
+			return p;
+		}
+
 		void *new_p = this->DoAlloc(size);
 		std::copy_n(static_cast<std::byte *>(p), std::min(oldsize, size), static_cast<std::byte *>(new_p));
 		this->Free(p, oldsize);
@@ -145,7 +203,12 @@ public:
 	void Free(void *p, SQUnsignedInteger size)
 	{
 		if (p == nullptr) return;
-		this->allocator.deallocate(reinterpret_cast<uint8_t*>(p), size);
+		size_t size_class = GetSizeClass(size);
+		if (size_class != POOL_CLASSES) {
+			this->free_blocks[size_class] = new (p) FreeBlock{this->free_blocks[size_class]};
+		} else {
+			this->allocator.deallocate(reinterpret_cast<uint8_t*>(p), size);
+		}
 		this->allocated_size -= size;
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
@@ -165,6 +228,13 @@ public:
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(this->allocations.empty());
 #endif
+		for (size_t size_class = 0; size_class < POOL_CLASSES; size_class++) {
+			while (this->free_blocks[size_class] != nullptr) {
+				FreeBlock *block = this->free_blocks[size_class];
+				this->free_blocks[size_class] = block->next;
+				this->allocator.deallocate(reinterpret_cast<uint8_t*>(block), (size_class + 1) * POOL_GRANULARITY);
+			}
+		}
 	}
 };
 
@@ -255,7 +325,7 @@ void Squirrel::PrintFunc(HSQUIRRELVM vm, std::string_view s)
 	}
 }
 
-void Squirrel::AddMethod(std::string_view method_name, SQFUNCTION proc, std::string_view params, void *userdata, int size, bool suspendable)
+HSQOBJECT Squirrel::AddMethod(std::string_view method_name, SQFUNCTION proc, std::string_view params, void *userdata, int size, bool suspendable)
 {
 	ScriptAllocatorScope alloc_scope(this);
 
@@ -269,6 +339,8 @@ void Squirrel::AddMethod(std::string_view method_name, SQFUNCTION proc, std::str
 	sq_newclosure(this->vm, proc, size != 0 ? 1 : 0);
 	if (!params.empty()) sq_setparamscheck(this->vm, params.size(), params);
 	sq_setnativeclosurename(this->vm, -1, method_name);
+	HSQOBJECT closure;
+	sq_getstackobj(this->vm, -1, &closure);
 	sq_newslot(this->vm, -3, SQFalse);
 
 	if (suspendable) {
@@ -288,6 +360,156 @@ void Squirrel::AddMethod(std::string_view method_name, SQFUNCTION proc, std::str
 		sq_remove(this->vm, -2);
 		sq_newslot(this->vm, -3, SQFalse);
 	}
+
+	return closure;
+}
+
+void Squirrel::AddNativeValuator(HSQOBJECT closure, std::function<void(HSQUIRRELVM, SQInteger)> &&valuator)
+{
+	ScriptAllocatorScope alloc_scope(this);
+
+	/* Keep the closure alive, so no other closure can get its address
+	 * when a script replaces the API function. */
+	sq_addref(this->vm, &closure);
+	this->native_valuators[closure._unVal.pNativeClosure] = std::move(valuator);
+}
+
+/* static */ const std::function<void(HSQUIRRELVM, SQInteger)> *Squirrel::GetNativeValuator(HSQUIRRELVM vm, const HSQOBJECT &closure)
+{
+	if (closure._type != OT_NATIVECLOSURE) return nullptr;
+
+	Squirrel *engine = static_cast<Squirrel *>(sq_getforeignptr(vm));
+	if (engine == nullptr) return nullptr;
+
+	auto it = engine->native_valuators.find(closure._unVal.pNativeClosure);
+	return it == engine->native_valuators.end() ? nullptr : &it->second;
+}
+
+void Squirrel::ProfileApiCallScope::Begin(Squirrel &engine, HSQUIRRELVM vm)
+{
+	if (vm->ci == nullptr || type(vm->ci->_closure) != OT_NATIVECLOSURE) return;
+
+	this->function = &engine.profile->api_functions[_nativeclosure(vm->ci->_closure)];
+	this->function->calls++;
+	this->start = std::chrono::steady_clock::now();
+}
+
+void Squirrel::SetProfiling(bool enable)
+{
+	if (enable && !this->profiling) this->profile = std::make_unique<SquirrelProfile>();
+	this->profiling = enable;
+}
+
+/**
+ * Record the current call stack of the script in the profile.
+ * @param ops The number of opcodes executed since the previous sample.
+ */
+void Squirrel::SampleCallStack(SQInteger ops)
+{
+	if (ops <= 0 || this->vm->_callsstacksize == 0) return;
+
+	/* Frames are stored outermost first, as the folded format expects. */
+	std::string stack;
+	for (SQInteger level = this->vm->_callsstacksize - 1; level >= 0; level--) {
+		SQStackInfos si;
+		if (SQ_FAILED(sq_stackinfos(this->vm, level, &si))) continue;
+
+		std::string_view source = si.source;
+		auto sep = source.find_last_of("/\\");
+		if (sep != std::string_view::npos) source.remove_prefix(sep + 1);
+
+		if (!stack.empty()) stack += ';';
+		fmt::format_to(std::back_inserter(stack), "{} ({})", si.funcname.empty() ? "unknown" : si.funcname, source);
+	}
+
+	auto it = this->profile->stacks.find(stack);
+	if (it == this->profile->stacks.end()) it = this->profile->stacks.emplace(std::move(stack), 0).first;
+	it->second += ops;
+	this->profile->samples++;
+}
+
+/**
+ * Get the names of the API functions, by their native closure.
+ * @return The name, as "Class.Function", of every native closure that is reachable from the root table.
+ */
+std::map<const void *, std::string> Squirrel::GetApiFunctionNames() const
+{
+	ScriptAllocatorScope alloc_scope(this);
+
+	std::map<const void *, std::string> names;
+	SQInteger top = sq_gettop(this->vm);
+
+	sq_pushroottable(this->vm);
+	sq_pushnull(this->vm);
+	while (SQ_SUCCEEDED(sq_next(this->vm, -2))) {
+		std::string_view name;
+		sq_getstring(this->vm, -2, name);
+
+		HSQOBJECT obj;
+		sq_getstackobj(this->vm, -1, &obj);
+		if (obj._type == OT_NATIVECLOSURE) {
+			names[obj._unVal.pNativeClosure] = name;
+		} else if (obj._type == OT_CLASS) {
+			sq_pushnull(this->vm);
+			while (SQ_SUCCEEDED(sq_next(this->vm, -2))) {
+				HSQOBJECT method;
+				sq_getstackobj(this->vm, -1, &method);
+				std::string_view method_name;
+				if (method._type == OT_NATIVECLOSURE && SQ_SUCCEEDED(sq_getstring(this->vm, -2, method_name))) {
+					/* Suspendable functions are registered as "@name@". */
+					if (method_name.size() > 2 && method_name.front() == '@') method_name = method_name.substr(1, method_name.size() - 2);
+					names[method._unVal.pNativeClosure] = fmt::format("{}.{}", name, method_name);
+				}
+				sq_pop(this->vm, 2);
+			}
+			sq_pop(this->vm, 1);
+		}
+		sq_pop(this->vm, 2);
+	}
+
+	sq_settop(this->vm, top);
+	return names;
+}
+
+std::vector<std::string> Squirrel::GetProfileSummary(size_t count) const
+{
+	std::vector<std::string> lines;
+	if (this->profile == nullptr) {
+		lines.emplace_back("No profiling data; start profiling first.");
+		return lines;
+	}
+
+	std::vector<std::pair<const void *, const SquirrelProfile::ApiFunction *>> functions;
+	for (const auto &[closure, function] : this->profile->api_functions) functions.emplace_back(closure, &function);
+	std::ranges::sort(functions, [](const auto &a, const auto &b) { return a.second->time > b.second->time; });
+
+	auto names = this->GetApiFunctionNames();
+	lines.push_back(fmt::format("API functions by wall time ({} of {}):", std::min(count, functions.size()), functions.size()));
+	for (const auto &[closure, function] : functions | std::views::take(count)) {
+		auto name = names.find(closure);
+		lines.push_back(fmt::format("  {:>10} calls {:>10.3f} ms  {}", function->calls,
+			std::chrono::duration<double, std::milli>(function->time).count(), name == names.end() ? "unknown" : name->second));
+	}
+
+	std::vector<std::pair<std::string_view, uint64_t>> stacks(this->profile->stacks.begin(), this->profile->stacks.end());
+	std::ranges::sort(stacks, [](const auto &a, const auto &b) { return a.second > b.second; });
+
+	lines.push_back(fmt::format("Call stacks by opcodes ({} of {}, {} samples):", std::min(count, stacks.size()), stacks.size(), this->profile->samples));
+	for (const auto &[stack, ops] : stacks | std::views::take(count)) {
+		lines.push_back(fmt::format("  {:>10} ops  {}", ops, stack));
+	}
+	return lines;
+}
+
+std::string Squirrel::GetProfileFoldedStacks() const
+{
+	std::string result;
+	if (this->profile == nullptr) return result;
+
+	for (const auto &[stack, ops] : this->profile->stacks) {
+		fmt::format_to(std::back_inserter(result), "{} {}\n", stack, ops);
+	}
+	return result;
 }
 
 void Squirrel::AddConst(std::string_view var_name, SQInteger value)
@@ -375,6 +597,7 @@ bool Squirrel::Resume(int suspend)
 	}
 
 	this->crashed = !sq_resumecatch(this->vm, suspend);
+	if (this->profiling) this->SampleCallStack(suspend > 0 ? suspend - this->vm->_ops_till_suspend : 1);
 	this->overdrawn_ops = -this->vm->_ops_till_suspend;
 	this->allocator->CheckLimit();
 	return this->vm->_suspended != 0;
@@ -699,6 +922,12 @@ SQRESULT Squirrel::LoadFile(HSQUIRRELVM vm, const std::string &filename, SQBool
 			break;
 	}
 
+	/* The compiled closure is not cached for the next VM loading this file. The
+	 * compiler reads and fills the constant table of the VM: 'const' and 'enum'
+	 * declarations of earlier files are folded into the bytecode, and the ones of
+	 * this file must be added for the files loaded after it. Reusing bytecode
+	 * would thus only be valid for a VM with exactly the same constants, and it
+	 * would skip adding this file's constants. */
 	SQFile f(std::move(*file), size);
 	if (SQ_SUCCEEDED(sq_compile(vm, func, &f, filename.c_str(), printerror))) {
 		return SQ_OK;
@@ -753,6 +982,9 @@ void Squirrel::Uninitialize()
 	/* Clean up the stuff */
 	sq_pop(this->vm, 1);
 	sq_close(this->vm);
+	this->native_valuators.clear();
+	this->profile.reset();
+	this->profiling = false;
 
 	/* Reset memory allocation errors. */
 	this->allocator->Reset();
@@ -11,6 +11,7 @@
 #define SQUIRREL_HPP
 
 #include <squirrel.h>
+#include <chrono>
 #include "../core/convertible_through_base.hpp"
 
 /** The type of script we're working with, i.e. for who is it? */
@@ -21,6 +22,19 @@ enum class ScriptType : uint8_t {
 
 struct ScriptAllocator;
 
+/** Profiling data of a script; it is only collected while profiling is enabled. */
+struct SquirrelProfile {
+	/** Statistics of calls to a single API function. */
+	struct ApiFunction {
+		uint64_t calls = 0; ///< Number of calls to the function.
+		std::chrono::steady_clock::duration time{}; ///< Wall time spent in the function, including nested calls.
+	};
+
+	std::map<const void *, ApiFunction> api_functions; ///< Statistics per API function, by its native closure.
+	std::map<std::string, uint64_t, std::less<>> stacks; ///< Opcodes executed per folded call stack.
+	uint64_t samples = 0; ///< Number of call stacks sampled.
+};
+
 class Squirrel {
 	friend class ScriptAllocatorScope;
 	friend class ScriptInstance;
@@ -35,6 +49,9 @@ private:
 	int overdrawn_ops;       ///< The amount of operations we have overdrawn.
 	std::string_view api_name; ///< Name of the API used for this squirrel.
 	std::unique_ptr<ScriptAllocator> allocator; ///< Allocator object used by this script.
+	std::map<const void *, std::function<void(HSQUIRRELVM, SQInteger)>> native_valuators; ///< Native implementations of API functions, by their closure.
+	std::unique_ptr<SquirrelProfile> profile; ///< Profiling data of the last profiling run, if any.
+	bool profiling = false; ///< Whether profiling data is being collected.
 
 	/**
 	 * The internal RunError handler. It looks up the real error and calls RunError with it.
@@ -46,6 +63,9 @@ private:
 	 */
 	std::string_view GetAPIName() { return this->api_name; }
 
+	void SampleCallStack(SQInteger ops);
+	std::map<const void *, std::string> GetApiFunctionNames() const;
+
 	/** Perform all initialization steps to create the engine. */
 	void Initialize();
 	/** Perform all the cleanups for the engine. */
@@ -76,6 +96,26 @@ public:
 	Squirrel(std::string_view api_name);
 	~Squirrel();
 
+	/** Records the call count and wall time of an API function while the script is being profiled. */
+	class ProfileApiCallScope {
+		SquirrelProfile::ApiFunction *function = nullptr; ///< The function being called, or nullptr when not profiling.
+		std::chrono::steady_clock::time_point start; ///< Time the call started.
+
+		void Begin(Squirrel &engine, HSQUIRRELVM vm);
+
+	public:
+		ProfileApiCallScope(HSQUIRRELVM vm)
+		{
+			Squirrel *engine = static_cast<Squirrel *>(sq_getforeignptr(vm));
+			if (engine != nullptr && engine->profiling) this->Begin(*engine, vm);
+		}
+
+		~ProfileApiCallScope()
+		{
+			if (this->function != nullptr) this->function->time += std::chrono::steady_clock::now() - this->start;
+		}
+	};
+
 	/**
 	 * Get the squirrel VM. Try to avoid using this.
 	 */
@@ -98,7 +138,23 @@ public:
 	 * Adds a function to the stack. Depending on the current state this means
 	 *  either a method or a global function.
 	 */
-	void AddMethod(std::string_view method_name, SQFUNCTION proc, std::string_view params = {}, void *userdata = nullptr, int size = 0, bool suspendable = false);
+	HSQOBJECT AddMethod(std::string_view method_name, SQFUNCTION proc, std::string_view params = {}, void *userdata = nullptr, int size = 0, bool suspendable = false);
+
+	/**
+	 * Register a native implementation of an API function, for ScriptList::Valuate
+	 * to use instead of calling the function through squirrel.
+	 * @param closure The native closure of the API function, as returned by AddMethod.
+	 * @param valuator Function that pushes the result of the API function for an item.
+	 */
+	void AddNativeValuator(HSQOBJECT closure, std::function<void(HSQUIRRELVM, SQInteger)> &&valuator);
+
+	/**
+	 * Get the native implementation of an API function, if it has one.
+	 * @param vm The VM the function is called in.
+	 * @param closure The function that would be called.
+	 * @return The native implementation, or nullptr when the function has to be called through squirrel.
+	 */
+	static const std::function<void(HSQUIRRELVM, SQInteger)> *GetNativeValuator(HSQUIRRELVM vm, const HSQOBJECT &closure);
 
 	/**
 	 * Adds a const to the stack. Depending on the current state this means
@@ -287,6 +343,31 @@ public:
 	 */
 	void Reset();
 
+	/**
+	 * Start or stop collecting profiling data. Starting discards the data of an earlier run,
+	 * stopping keeps the data so it can still be inspected.
+	 * @param enable Whether to profile the script.
+	 */
+	void SetProfiling(bool enable);
+
+	/**
+	 * Is the script being profiled?
+	 */
+	bool IsProfiling() const { return this->profiling; }
+
+	/**
+	 * Get a summary of the profiling data, with the most expensive API functions and call stacks first.
+	 * @param count Number of API functions and call stacks to list.
+	 * @return The lines of the summary.
+	 */
+	std::vector<std::string> GetProfileSummary(size_t count) const;
+
+	/**
+	 * Get the sampled call stacks in the folded format used by flame graph tools.
+	 * @return One line per call stack, with the frames separated by ';' followed by the opcodes executed in it.
+	 */
+	std::string GetProfileFoldedStacks() const;
+
 	/**
 	 * Get number of bytes allocated by this VM.
 	 */
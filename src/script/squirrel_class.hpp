@@ -59,7 +59,14 @@ public:
 	void DefSQStaticMethod(Squirrel &engine, Func function_proc, std::string_view function_name, std::string_view params = {}, bool suspendable = false)
 	{
 		using namespace SQConvert;
-		engine.AddMethod(function_name, DefSQStaticCallback<CL, Func>, params, &function_proc, sizeof(function_proc), suspendable);
+		HSQOBJECT closure = engine.AddMethod(function_name, DefSQStaticCallback<CL, Func>, params, &function_proc, sizeof(function_proc), suspendable);
+
+		/* Suspendable functions are wrapped in a squirrel function, so they are never valuated natively. */
+		if constexpr (NativeValuator<Func>::SUPPORTED) {
+			if (!suspendable) {
+				engine.AddNativeValuator(closure, [function_proc](HSQUIRRELVM vm, SQInteger item) { NativeValuator<Func>::Call(vm, function_proc, item); });
+			}
+		}
 	}
 
 	/**
@@ -104,6 +104,39 @@ namespace SQConvert {
 		}
 	};
 
+	/** Types a native valuator can pass an item as. */
+	template <typename T> concept ValuatorParam = (std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_enum_v<T> || ConvertibleThroughBase<T>;
+	/** Types a native valuator can return. */
+	template <typename T> concept ValuatorReturn = std::is_integral_v<T> || std::is_enum_v<T> || ConvertibleThroughBase<T>;
+
+	/**
+	 * Helper to call an API function natively from ScriptList::Valuate.
+	 * Only functions with a single integer-like parameter and an integer-like
+	 * or boolean result can be valuators without a squirrel call.
+	 */
+	template <typename Func> struct NativeValuator {
+		static constexpr bool SUPPORTED = false;
+	};
+
+	template <ValuatorReturn Tretval, ValuatorParam Targ> struct NativeValuator<Tretval (*)(Targ)> {
+		static constexpr bool SUPPORTED = true;
+
+		/**
+		 * Call the function for an item, converting the item and the result
+		 * exactly like a call through squirrel would.
+		 * @param vm The VM to push the result to.
+		 * @param func The API function.
+		 * @param item The item to pass.
+		 */
+		static void Call(HSQUIRRELVM vm, Tretval (*func)(Targ), SQInteger item)
+		{
+			sq_pushinteger(vm, item);
+			Targ arg = Param<Targ>::Get(vm, -1);
+			sq_poptop(vm);
+			Return<Tretval>::Set(vm, func(arg));
+		}
+	};
+
 	template <> struct Param<const std::string &> {
 		static inline const std::string Get(HSQUIRRELVM vm, int index)
 		{
@@ -235,6 +268,8 @@ namespace SQConvert {
 	template <typename Tcls, typename Tmethod, ScriptType Ttype>
 	inline SQInteger DefSQNonStaticCallback(HSQUIRRELVM vm)
 	{
+		Squirrel::ProfileApiCallScope profile_scope(vm);
+
 		/* Find the amount of params we got */
 		int nparam = sq_gettop(vm);
 		SQUserPointer ptr = nullptr;
@@ -278,6 +313,8 @@ namespace SQConvert {
 	template <typename Tcls, typename Tmethod, ScriptType Ttype>
 	inline SQInteger DefSQAdvancedNonStaticCallback(HSQUIRRELVM vm)
 	{
+		Squirrel::ProfileApiCallScope profile_scope(vm);
+
 		/* Find the amount of params we got */
 		int nparam = sq_gettop(vm);
 		SQUserPointer ptr = nullptr;
@@ -317,10 +354,15 @@ namespace SQConvert {
 	 * A general template for all function/static method callbacks from Squirrel.
 	 *  In here the function_proc is recovered, and the SQCall is called that
 	 *  can handle this exact amount of params.
+	 * @note Results are not memoised: calling a native function costs the script
+	 *  no ops, many API functions set the last error as a side effect, and their
+	 *  results depend on the company and test mode the script is in.
 	 */
 	template <typename Tcls, typename Tmethod>
 	inline SQInteger DefSQStaticCallback(HSQUIRRELVM vm)
 	{
+		Squirrel::ProfileApiCallScope profile_scope(vm);
+
 		/* Find the amount of params we got */
 		int nparam = sq_gettop(vm);
 		SQUserPointer ptr = nullptr;
@@ -347,6 +389,8 @@ namespace SQConvert {
 	template <typename Tcls, typename Tmethod>
 	inline SQInteger DefSQAdvancedStaticCallback(HSQUIRRELVM vm)
 	{
+		Squirrel::ProfileApiCallScope profile_scope(vm);
+
 		/* Find the amount of params we got */
 		int nparam = sq_gettop(vm);
 		SQUserPointer ptr = nullptr;
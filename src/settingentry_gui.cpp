@@ -858,6 +858,7 @@ SettingsContainer &GetSettingsTree()
 				time->Add(new SettingEntry("game_creation.ending_year"));
 				time->Add(new SettingEntry("gui.pause_on_newgame"));
 				time->Add(new SettingEntry("gui.fast_forward_speed_limit"));
+				time->Add(new SettingEntry("gui.fast_forward_render_free"));
 			}
 
 			SettingsPage *authorities = environment->Add(new SettingsPage(STR_CONFIG_SETTING_ENVIRONMENT_AUTHORITIES));
@@ -15,6 +15,7 @@
 #include "network/network_func.h"
 #include "network/core/config.h"
 #include "pathfinder/pathfinder_type.h"
+#include "pathfinder/yapf/yapf_cache.h"
 #include "linkgraph/linkgraphschedule.h"
 #include "genworld.h"
 #include "train.h"
@@ -50,6 +51,7 @@
 #include "void_map.h"
 #include "station_func.h"
 #include "station_base.h"
+#include "rpc/rpc_engine_cache.h"
 
 #include "table/strings.h"
 #include "table/settings.h"
@@ -161,7 +163,7 @@ static void RedrawSmallmap(int32_t)
 {
 	BuildLandLegend();
 	BuildOwnerLegend();
-	SetWindowClassesDirty(WC_SMALLMAP);
+	InvalidateWindowClassesData(WC_SMALLMAP, 3);
 }
 
 /** Redraw linkgraph links after a colour scheme change. */
@@ -319,9 +321,18 @@ static void TrainAccelerationModelChanged(int32_t)
 	/* These windows show acceleration values only when realistic acceleration is on. They must be redrawn after a setting change. */
 	SetWindowClassesDirty(WC_ENGINE_PREVIEW);
 	InvalidateWindowClassesData(WC_BUILD_VEHICLE, 0);
+	RpcInvalidateEngineCache();
 	SetWindowClassesDirty(WC_VEHICLE_DETAILS);
 }
 
+/**
+ * Forget the cached costs of rail segments, as they include the changed penalty.
+ */
+static void InvalidateRailSegmentCosts(int32_t)
+{
+	YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+}
+
 /**
  * This function updates the train acceleration cache after a steepness change.
  */
@@ -348,6 +359,7 @@ static void RoadVehAccelerationModelChanged(int32_t)
 	/* These windows show acceleration values only when realistic acceleration is on. They must be redrawn after a setting change. */
 	SetWindowClassesDirty(WC_ENGINE_PREVIEW);
 	InvalidateWindowClassesData(WC_BUILD_VEHICLE, 0);
+	RpcInvalidateEngineCache();
 	SetWindowClassesDirty(WC_VEHICLE_DETAILS);
 }
 
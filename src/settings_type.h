@@ -193,6 +193,7 @@ struct GUISettings {
 	ZoomLevel sprite_zoom_min;               ///< maximum zoom level at which higher-resolution alternative sprites will be used (if available) instead of scaling a lower resolution sprite
 	uint32_t autosave_interval;              ///< how often should we do autosaves?
 	bool   threaded_saves;                   ///< should we do threaded saves?
+	bool   fork_autosaves;                   ///< should autosaves be written by a forked process?
 	bool   keep_all_autosave;                ///< name the autosave in a different way
 	bool   autosave_on_exit;                 ///< save an autosave when you quit the game, but do not ask "Do you really want to quit?"
 	bool   autosave_on_network_disconnect;   ///< save an autosave when you get disconnected from a network game with an error?
@@ -235,6 +236,7 @@ struct GUISettings {
 	bool   auto_remove_signals;              ///< automatically remove signals when in the way during rail construction
 	uint16_t refresh_rate;                     ///< How often we refresh the screen (time between draw-ticks).
 	uint16_t fast_forward_speed_limit;         ///< Game speed to use when fast-forward is enabled.
+	bool fast_forward_render_free;             ///< Only redraw the screen once a second while fast-forward is enabled.
 
 	uint16_t console_backlog_timeout;          ///< the minimum amount of time items should be in the console backlog before they will be removed in ~3 seconds granularity.
 	uint16_t console_backlog_length;           ///< the minimum amount of items in the console backlog before items will be removed.
@@ -367,6 +369,7 @@ struct NetworkSettings {
 	uint16_t      restart_hours;                          ///< number of hours to run the server before automatic restart
 	uint8_t       min_active_clients;                       ///< minimum amount of active clients to unpause the game
 	bool        reload_cfg;                               ///< reload the config file before restarting
+	bool gamelog_archive; ///< Write every logged fundamental change to gamelog-archive.log, as the gamelog itself is compacted.
 	std::string last_joined;                              ///< Last joined server
 	UseRelayService use_relay_service;                    ///< Use relay service?
 	ParticipateSurvey participate_survey;                 ///< Participate in the automated survey
@@ -151,17 +151,46 @@ static const Depot *FindClosestShipDepot(const Vehicle *v, uint max_distance)
 {
 	const int max_region_distance = (max_distance / WATER_REGION_EDGE_LENGTH) + 1;
 
+	/** A depot that is close enough, when it turns out to be reachable. */
+	struct Candidate {
+		const Depot *depot; ///< The depot.
+		uint dist_sq; ///< Square of the distance to the vehicle.
+		int patch_hash; ///< Hash of the water region patch of the depot.
+	};
+
+	static std::vector<Candidate> candidates;
 	static std::unordered_set<int> visited_patch_hashes;
 	static std::deque<WaterRegionPatchDesc> patches_to_search;
+	candidates.clear();
 	visited_patch_hashes.clear();
 	patches_to_search.clear();
 
-	/* Step 1: find a set of reachable Water Region Patches using BFS. */
+	/* Step 1: find the depots in range, the closest first. Without any, there is no need to search the water. */
+	for (const Depot *depot : Depot::Iterate()) {
+		const TileIndex tile = depot->xy;
+		if (IsShipDepotTile(tile) && IsTileOwner(tile, v->owner)) {
+			const uint dist_sq = DistanceSquare(tile, v->tile);
+			if (dist_sq <= max_distance * max_distance) {
+				candidates.emplace_back(depot, dist_sq, CalculateWaterRegionPatchHash(GetWaterRegionPatchInfo(tile)));
+			}
+		}
+	}
+	if (candidates.empty()) return nullptr;
+
+	/* Stable, so of depots at the same distance the first in the pool still wins. */
+	std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) { return a.dist_sq < b.dist_sq; });
+
+	/* Step 2: find a set of reachable Water Region Patches using BFS. Once the
+	 * closest depot is known to be reachable, nothing else can beat it. */
 	const WaterRegionPatchDesc start_patch = GetWaterRegionPatchInfo(v->tile);
+	const int start_hash = CalculateWaterRegionPatchHash(start_patch);
+	if (start_hash == candidates.front().patch_hash) return candidates.front().depot;
+
 	patches_to_search.push_back(start_patch);
-	visited_patch_hashes.insert(CalculateWaterRegionPatchHash(start_patch));
+	visited_patch_hashes.insert(start_hash);
 
-	while (!patches_to_search.empty()) {
+	bool found_closest = false;
+	while (!patches_to_search.empty() && !found_closest) {
 		/* Remove first patch from the queue and make it the current patch. */
 		const WaterRegionPatchDesc current_node = patches_to_search.front();
 		patches_to_search.pop_front();
@@ -176,28 +205,19 @@ static const Depot *FindClosestShipDepot(const Vehicle *v, uint max_distance)
 			if (visited_patch_hashes.count(hash) == 0) {
 				visited_patch_hashes.insert(hash);
 				patches_to_search.push_back(water_region_patch);
+				if (hash == candidates.front().patch_hash) found_closest = true;
 			}
 		};
 
 		VisitWaterRegionPatchNeighbours(current_node, visit_func);
 	}
 
-	/* Step 2: Find the closest depot within the reachable Water Region Patches. */
-	const Depot *best_depot = nullptr;
-	uint best_dist_sq = std::numeric_limits<uint>::max();
-	for (const Depot *depot : Depot::Iterate()) {
-		const TileIndex tile = depot->xy;
-		if (IsShipDepotTile(tile) && IsTileOwner(tile, v->owner)) {
-			const uint dist_sq = DistanceSquare(tile, v->tile);
-			if (dist_sq < best_dist_sq && dist_sq <= max_distance * max_distance &&
-					visited_patch_hashes.count(CalculateWaterRegionPatchHash(GetWaterRegionPatchInfo(tile))) > 0) {
-				best_dist_sq = dist_sq;
-				best_depot = depot;
-			}
-		}
+	/* Step 3: the closest depot within the reachable Water Region Patches. */
+	for (const Candidate &candidate : candidates) {
+		if (visited_patch_hashes.count(candidate.patch_hash) > 0) return candidate.depot;
 	}
 
-	return best_depot;
+	return nullptr;
 }
 
 static void CheckIfShipNeedsService(Vehicle *v)
@@ -461,6 +481,9 @@ static void ShipArrivesAt(const Vehicle *v, Station *st)
  * @param tile Tile, the ship is about to enter
  * @param tracks Available track choices on \a tile
  * @return Track to choose, or INVALID_TRACK when to reverse.
+ * @note The pathfinder plans through a few water regions at once and caches the tiles
+ *       of that route in Ship::path, so on open water most tiles only pop that cache;
+ *       the pathfinder runs again when the cache is used up or no longer fits the tile.
  */
 static Track ChooseShipTrack(Ship *v, TileIndex tile, TrackBits tracks)
 {
@@ -38,12 +38,14 @@ Sign::~Sign()
 void Sign::UpdateVirtCoord()
 {
 	Point pt = RemapCoords(this->x, this->y, this->z);
+	pt.y -= 6 * ZOOM_BASE;
 
-	if (this->sign.kdtree_valid) _viewport_sign_kdtree.Remove(ViewportSignKdtreeItem::MakeSign(this->index));
+	bool moved = !this->sign.IsAt(pt.x, pt.y);
+	if (moved && this->sign.kdtree_valid) _viewport_sign_kdtree.Remove(ViewportSignKdtreeItem::MakeSign(this->index));
 
-	this->sign.UpdatePosition(pt.x, pt.y - 6 * ZOOM_BASE, GetString(STR_WHITE_SIGN, this->index));
+	this->sign.UpdatePosition(pt.x, pt.y, GetString(STR_WHITE_SIGN, this->index));
 
-	_viewport_sign_kdtree.Insert(ViewportSignKdtreeItem::MakeSign(this->index));
+	if (moved) _viewport_sign_kdtree.Insert(ViewportSignKdtreeItem::MakeSign(this->index));
 }
 
 /** Update the coordinates of all signs */
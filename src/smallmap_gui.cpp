@@ -652,6 +652,20 @@ protected:
 
 	std::unique_ptr<LinkGraphOverlay> overlay{};
 
+	/** Position and size of the map the cached tile colours were computed for. */
+	struct TileColoursKey {
+		int tile_x = 0; ///< X coordinate of the base tile of the map.
+		int tile_y = 0; ///< Y coordinate of the base tile of the map.
+		int zoom = 0; ///< Zoom level of the map.
+		SmallMapType map_type{}; ///< Type of the map.
+		int width = 0; ///< Number of tile groups in both directions that are cached.
+
+		bool operator==(const TileColoursKey &other) const = default;
+	};
+
+	mutable TileColoursKey tile_colours_key{}; ///< What #tile_colours were computed for.
+	mutable std::vector<std::optional<uint32_t>> tile_colours{}; ///< Colours of the tile groups drawn since the last full refresh.
+
 	/** Notify the industry chain window to stop sending newly selected industries. */
 	static void BreakIndustryChainLink()
 	{
@@ -867,7 +881,6 @@ protected:
 		this->scroll_x = sx;
 		this->scroll_y = sy;
 		this->subscroll = sub;
-		if (this->map_type == SMT_LINKSTATS) this->overlay->SetDirty();
 	}
 
 	/**
@@ -931,7 +944,7 @@ protected:
 			}
 			ta.ClampToMap(); // Clamp to map boundaries (may contain MP_VOID tiles!).
 
-			uint32_t val = this->GetTileColours(ta);
+			uint32_t val = this->GetCachedTileColours(xc, yc, ta);
 			uint8_t *val8 = (uint8_t *)&val;
 			int idx = std::max(0, -start_pos);
 			for (int pos = std::max(0, start_pos); pos < end_pos; pos++) {
@@ -1245,7 +1258,7 @@ protected:
 			}
 			this->SetWidgetDisabledState(WID_SM_ZOOM_IN,  this->zoom == zoomlevels[MIN_ZOOM_INDEX]);
 			this->SetWidgetDisabledState(WID_SM_ZOOM_OUT, this->zoom == zoomlevels[MAX_ZOOM_INDEX]);
-			this->SetDirty();
+			this->SetMapDirty();
 		}
 	}
 
@@ -1393,6 +1406,40 @@ protected:
 		}
 	}
 
+	/**
+	 * Get the colours of a group of tiles, reusing the colours computed
+	 * earlier when the same part of the map is redrawn. Parts of the map are
+	 * redrawn whenever another window moves over it, while the tiles only
+	 * need to be examined again after a full refresh.
+	 * @param xc The X coordinate of the first tile of the group.
+	 * @param yc The Y coordinate of the first tile of the group.
+	 * @param ta Tile area of the group.
+	 * @return Colours to display.
+	 */
+	uint32_t GetCachedTileColours(uint xc, uint yc, const TileArea &ta) const
+	{
+		/* The groups drawn are at multiples of the zoom level from the base tile.
+		 * Going right one group per 4 pixels lowers x and raises y, going down
+		 * one group per 2 pixels raises both, and drawing starts a bit left of
+		 * the map, so x ranges from -width / 4 to height / 2 and y from 0 to
+		 * height / 2 + width / 4, plus some slack for the partial groups. */
+		const NWidgetBase *wid = this->GetWidget<NWidgetBase>(WID_SM_MAP);
+		TileColoursKey key{this->scroll_x / (int)TILE_SIZE, this->scroll_y / (int)TILE_SIZE, this->zoom, this->map_type, (int)(wid->current_x / 4 + wid->current_y / 2) + 8};
+		if (key != this->tile_colours_key) {
+			this->tile_colours_key = key;
+			this->tile_colours.clear();
+		}
+		if (this->tile_colours.empty()) this->tile_colours.resize(static_cast<size_t>(key.width) * key.width);
+
+		int gx = ((int)xc - key.tile_x) / this->zoom + (int)wid->current_x / 4 + 4;
+		int gy = ((int)yc - key.tile_y) / this->zoom + 4;
+		if (!IsInsideBS(gx, 0, key.width) || !IsInsideBS(gy, 0, key.width)) return this->GetTileColours(ta);
+
+		std::optional<uint32_t> &colours = this->tile_colours[static_cast<size_t>(gy) * key.width + gx];
+		if (!colours.has_value()) colours = this->GetTileColours(ta);
+		return *colours;
+	}
+
 	/**
 	 * Determines the mouse position on the legend.
 	 * @param pt Mouse position.
@@ -1435,6 +1482,13 @@ protected:
 		_smallmap_industry_highlight_state = !_smallmap_industry_highlight_state;
 
 		this->UpdateLinks();
+		this->SetMapDirty();
+	}
+
+	/** Redraw the whole map, recomputing the colours of all tiles. */
+	void SetMapDirty()
+	{
+		this->tile_colours.clear();
 		this->SetDirty();
 	}
 
@@ -1444,7 +1498,7 @@ protected:
 		if (_smallmap_industry_highlight != IT_INVALID) return;
 
 		this->UpdateLinks();
-		this->SetDirty();
+		this->SetMapDirty();
 	}
 
 public:
@@ -1485,7 +1539,7 @@ public:
 		Point sxy = this->ComputeScroll(viewport_center.x / (int)TILE_SIZE, viewport_center.y / (int)TILE_SIZE,
 				std::max(0, (int)wid->current_x / 2 - 2), wid->current_y / 2, &sub);
 		this->SetNewScroll(sxy.x, sxy.y, sub);
-		this->SetDirty();
+		this->SetMapDirty();
 	}
 
 	/**
@@ -1708,7 +1762,7 @@ public:
 				pt = this->PixelToTile(pt.x - wid->pos_x, pt.y - wid->pos_y, &sub);
 				ScrollWindowTo(this->scroll_x + pt.x * TILE_SIZE, this->scroll_y + pt.y * TILE_SIZE, -1, w);
 
-				this->SetDirty();
+				this->SetMapDirty();
 				break;
 			}
 
@@ -1741,7 +1795,7 @@ public:
 				this->show_towns = !this->show_towns;
 				this->SetWidgetLoweredState(WID_SM_TOGGLETOWNNAME, this->show_towns);
 
-				this->SetDirty();
+				this->SetMapDirty();
 				SndClickBeep();
 				break;
 
@@ -1749,7 +1803,7 @@ public:
 				this->show_ind_names = !this->show_ind_names;
 				this->SetWidgetLoweredState(WID_SM_SHOW_IND_NAMES, this->show_ind_names);
 
-				this->SetDirty();
+				this->SetMapDirty();
 				SndClickBeep();
 				break;
 
@@ -1774,7 +1828,7 @@ public:
 							this->SelectLegendItem(click_pos, _legend_land_owners, _smallmap_company_count, NUM_NO_COMPANY_ENTRIES);
 						}
 					}
-					this->SetDirty();
+					this->SetMapDirty();
 				}
 				break;
 
@@ -1799,14 +1853,14 @@ public:
 					tbl->show_on_map = (widget == WID_SM_ENABLE_ALL);
 				}
 				if (this->map_type == SMT_LINKSTATS) this->SetOverlayCargoMask();
-				this->SetDirty();
+				this->SetMapDirty();
 				break;
 			}
 
 			case WID_SM_SHOW_HEIGHT: // Enable/disable showing of heightmap.
 				_smallmap_show_heightmap = !_smallmap_show_heightmap;
 				this->SetWidgetLoweredState(WID_SM_SHOW_HEIGHT, _smallmap_show_heightmap);
-				this->SetDirty();
+				this->SetMapDirty();
 				break;
 		}
 	}
@@ -1817,6 +1871,7 @@ public:
 	 * - data = 0: Displayed industries at the industry chain window have changed.
 	 * - data = 1: Companies have changed.
 	 * - data = 2: Cheat changing the maximum heightlevel has been used, rebuild our heightlevel-to-colour index
+	 * - data = 3: The colour scheme of the map has changed.
 	 * @param gui_scope Whether the call is done from GUI scope. You may not do everything when not in GUI scope. See #InvalidateWindowData() for details.
 	 */
 	void OnInvalidateData(int data = 0, bool gui_scope = true) override
@@ -1843,9 +1898,13 @@ public:
 				this->RebuildColourIndexIfNecessary();
 				break;
 
+			case 3:
+				/* The colour scheme has changed, the legends have already been rebuilt. */
+				break;
+
 			default: NOT_REACHED();
 		}
-		this->SetDirty();
+		this->SetMapDirty();
 	}
 
 	bool OnRightClick(Point, WidgetID widget) override
@@ -1877,7 +1936,7 @@ public:
 		Point pt = this->PixelToTile(delta.x, delta.y, &sub);
 		this->SetNewScroll(this->scroll_x + pt.x * TILE_SIZE, this->scroll_y + pt.y * TILE_SIZE, sub);
 
-		this->SetDirty();
+		this->SetMapDirty();
 	}
 
 	void OnMouseOver([[maybe_unused]] Point pt, WidgetID widget) override
@@ -1892,7 +1951,7 @@ public:
 		if (new_highlight != _smallmap_industry_highlight) {
 			_smallmap_industry_highlight = new_highlight;
 			_smallmap_industry_highlight_state = true;
-			this->SetDirty();
+			this->SetMapDirty();
 		}
 	}
 
@@ -10,6 +10,7 @@
 #include "stdafx.h"
 #include "landscape.h"
 #include "sound_type.h"
+#include "sound_func.h"
 #include "soundloader_func.h"
 #include "mixer.h"
 #include "newgrf_sound.h"
@@ -23,6 +24,7 @@
 #include "safeguards.h"
 
 static std::array<SoundEntry, ORIGINAL_SAMPLE_COUNT> _original_sounds;
+bool _sound_effects_suspended = false; ///< Do not play any sound effects, as the game is running while nobody can follow it.
 
 static void OpenBankFile(const std::string &filename)
 {
@@ -97,7 +99,7 @@ void InitializeSound()
 /* Low level sound player */
 static void StartSound(SoundID sound_id, float pan, uint volume)
 {
-	if (volume == 0) return;
+	if (volume == 0 || _sound_effects_suspended) return;
 
 	SoundEntry *sound = GetSound(sound_id);
 	if (sound == nullptr) return;
@@ -14,6 +14,8 @@
 #include "vehicle_type.h"
 #include "tile_type.h"
 
+extern bool _sound_effects_suspended; ///< Do not play any sound effects, as the game is running while nobody can follow it.
+
 void ChangeSoundSet(int index);
 
 void SndPlayTileFx(SoundID sound, TileIndex tile);
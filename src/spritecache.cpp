@@ -17,6 +17,8 @@
 #include "blitter/factory.hpp"
 #include "core/math_func.hpp"
 #include "video/video_driver.hpp"
+#include "console_func.h"
+#include "console_type.h"
 #include "spritecache.h"
 #include "spritecache_internal.h"
 
@@ -32,6 +34,7 @@ uint _sprite_cache_size = 4;
 static std::vector<SpriteCache> _spritecache;
 static size_t _spritecache_bytes_used = 0;
 static uint32_t _sprite_lru_counter;
+static SpriteCacheStatsArray _spritecache_stats; ///< Statistics of the sprite cache per sprite type.
 static std::vector<std::unique_ptr<SpriteFile>> _sprite_files;
 
 static inline SpriteCache *GetSpriteCache(uint index)
@@ -451,6 +454,10 @@ static void *ReadRecolourSprite(SpriteFile &file, size_t file_pos, uint num, Spr
  * @param allocator   Allocator function to use.
  * @param encoder     Sprite encoder to use.
  * @return Read sprite data.
+ * @note This must run on the thread that draws. The sprite files are shared
+ *       and seeked per read, the decoded pixels go through the static
+ *       SpriteLoader::Sprite::buffer, and the blitter may be replaced between
+ *       frames, so a second loading thread would need its own copy of all three.
  */
 static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_type, SpriteAllocator &allocator, SpriteEncoder *encoder)
 {
@@ -752,17 +759,30 @@ static void DeleteEntriesFromSpriteCache(size_t to_remove)
 	}
 
 	for (const auto &it : candidates) {
-		GetSpriteCache(it.id)->ClearSpriteData();
+		SpriteCache *sc = GetSpriteCache(it.id);
+		SpriteCacheStats &stats = _spritecache_stats[to_underlying(sc->type)];
+		stats.evictions++;
+		stats.evicted_bytes += sc->length;
+		sc->ClearSpriteData();
 	}
 
 	Debug(sprite, 3, "DeleteEntriesFromSpriteCache, deleted: {}, freed: {}, in use: {} --> {}, requested: {}",
 			candidates.size(), candidate_bytes, initial_in_use, _spritecache_bytes_used, to_remove);
 }
 
-void IncreaseSpriteLRU()
+/**
+ * Get the number of bytes the sprite cache may use before sprites are evicted.
+ * @return The target size of the sprite cache in bytes.
+ */
+static size_t GetSpriteCacheTargetSize()
 {
 	int bpp = BlitterFactory::GetCurrentBlitter()->GetScreenDepth();
-	uint target_size = (bpp > 0 ? _sprite_cache_size * bpp / 8 : 1) * 1024 * 1024;
+	return static_cast<size_t>(bpp > 0 ? _sprite_cache_size * bpp / 8 : 1) * 1024 * 1024;
+}
+
+void IncreaseSpriteLRU()
+{
+	size_t target_size = GetSpriteCacheTargetSize();
 	if (_spritecache_bytes_used > target_size) {
 		DeleteEntriesFromSpriteCache(_spritecache_bytes_used - target_size + 512 * 1024);
 	}
@@ -785,6 +805,11 @@ void IncreaseSpriteLRU()
 
 void SpriteCache::ClearSpriteData()
 {
+	if (this->ptr == nullptr) return;
+
+	SpriteCacheStats &stats = _spritecache_stats[to_underlying(this->type)];
+	stats.bytes -= this->length;
+	stats.sprites--;
 	_spritecache_bytes_used -= this->length;
 	this->ptr.reset();
 }
@@ -873,7 +898,11 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, SpriteAllocator *allocator,
 		sc->lru = ++_sprite_lru_counter;
 
 		/* Load the sprite, if it is not loaded, yet */
-		if (sc->ptr == nullptr) {
+		SpriteCacheStats &stats = _spritecache_stats[to_underlying(sc->type)];
+		if (sc->ptr != nullptr) {
+			stats.hits++;
+		} else {
+			stats.misses++;
 			UniquePtrSpriteAllocator cache_allocator;
 			if (sc->type == SpriteType::Recolour) {
 				ReadRecolourSprite(*sc->file, sc->file_pos, sc->length, cache_allocator);
@@ -883,6 +912,8 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, SpriteAllocator *allocator,
 			sc->ptr = std::move(cache_allocator.data);
 			sc->length = static_cast<uint32_t>(cache_allocator.size);
 			_spritecache_bytes_used += sc->length;
+			stats.bytes += sc->length;
+			stats.sprites++;
 		}
 
 		return static_cast<void *>(sc->ptr.get());
@@ -900,6 +931,10 @@ void GfxInitSpriteMem()
 
 	_sprite_files.clear();
 	_spritecache_bytes_used = 0;
+	for (SpriteCacheStats &stats : _spritecache_stats) {
+		stats.bytes = 0;
+		stats.sprites = 0;
+	}
 }
 
 /**
@@ -928,4 +963,52 @@ void GfxClearFontSpriteCache()
 	}
 }
 
+/**
+ * Get the statistics of the sprite cache per sprite type.
+ * @return The statistics, indexed by SpriteType.
+ */
+const SpriteCacheStatsArray &GetSpriteCacheStats()
+{
+	return _spritecache_stats;
+}
+
+/**
+ * Get the number of bytes the sprite cache uses and may use.
+ * @return Pair of the bytes in use and the target size in bytes.
+ */
+std::pair<size_t, size_t> GetSpriteCacheUsage()
+{
+	return {_spritecache_bytes_used, GetSpriteCacheTargetSize()};
+}
+
+/**
+ * Reset the hit, miss and eviction counters of the sprite cache.
+ * The number of cached sprites and bytes are kept, as those sprites are still cached.
+ */
+void ResetSpriteCacheStats()
+{
+	for (SpriteCacheStats &stats : _spritecache_stats) {
+		stats.hits = 0;
+		stats.misses = 0;
+		stats.evictions = 0;
+		stats.evicted_bytes = 0;
+	}
+}
+
+/** Print the statistics of the sprite cache to the console. */
+void ConPrintSpriteCacheStats()
+{
+	static const std::string_view sprite_types[] = { "normal", "map generator", "character", "recolour" };
+
+	auto [used, target] = GetSpriteCacheUsage();
+	IConsolePrint(CC_DEFAULT, "Sprite cache: {} KiB in use of {} KiB (sprite_cache_size_px = {})", used / 1024, target / 1024, _sprite_cache_size);
+	for (uint8_t type = 0; type < std::size(sprite_types); type++) {
+		const SpriteCacheStats &stats = _spritecache_stats[type];
+		uint64_t requests = stats.hits + stats.misses;
+		IConsolePrint(CC_DEFAULT, "  {}: {} sprites, {} KiB; {} requests, {:.1f}% hits; {} evicted, {} KiB",
+				sprite_types[type], stats.sprites, stats.bytes / 1024, requests, requests == 0 ? 0.0 : 100.0 * stats.hits / requests,
+				stats.evictions, stats.evicted_bytes / 1024);
+	}
+}
+
 /* static */ SpriteCollMap<ReusableBuffer<SpriteLoader::CommonPixel>> SpriteLoader::Sprite::buffer;
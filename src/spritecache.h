@@ -55,6 +55,24 @@ void IncreaseSpriteLRU();
 SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap);
 std::span<const std::unique_ptr<SpriteFile>> GetCachedSpriteFiles();
 
+/** Statistics of the sprite cache for one sprite type. */
+struct SpriteCacheStats {
+	uint64_t hits = 0; ///< Number of requests for a sprite that was cached.
+	uint64_t misses = 0; ///< Number of requests for a sprite that had to be loaded.
+	uint64_t evictions = 0; ///< Number of sprites removed to stay within the cache size.
+	uint64_t evicted_bytes = 0; ///< Number of bytes removed to stay within the cache size.
+	size_t sprites = 0; ///< Number of sprites currently in the cache.
+	size_t bytes = 0; ///< Number of bytes currently used by these sprites.
+};
+
+/** Statistics of the sprite cache, indexed by SpriteType. */
+using SpriteCacheStatsArray = std::array<SpriteCacheStats, to_underlying(SpriteType::Invalid)>;
+
+const SpriteCacheStatsArray &GetSpriteCacheStats();
+std::pair<size_t, size_t> GetSpriteCacheUsage();
+void ResetSpriteCacheStats();
+void ConPrintSpriteCacheStats();
+
 void ReadGRFSpriteOffsets(SpriteFile &file);
 size_t GetGRFSpriteOffset(uint32_t id);
 bool LoadNextSprite(SpriteID load_index, SpriteFile &file, uint file_sprite_id);
@@ -27,6 +27,7 @@
 #include "core/random_func.hpp"
 #include "linkgraph/linkgraph.h"
 #include "linkgraph/linkgraphschedule.h"
+#include "thread.h"
 
 #include "table/strings.h"
 
@@ -39,6 +40,51 @@ INSTANTIATE_POOL_METHODS(Station)
 
 StationKdtree _station_kdtree{};
 
+/**
+ * Upper bound of the distance in tiles between the sign of a station and the tiles in its catchment area.
+ * It only grows, except when the catchment of all stations is recomputed, so it can be used to limit
+ * a search of the station kdtree to the stations that may cover an area.
+ */
+static uint _station_catchment_reach = 0;
+
+/**
+ * Make sure _station_catchment_reach covers the catchment area of a station.
+ * @param st The station whose catchment area or sign changed.
+ */
+void ExtendStationCatchmentReach(const Station *st)
+{
+	const BitmapTileArea &ta = st->catchment_tiles;
+	if (ta.w == 0) return;
+
+	int x = TileX(st->xy);
+	int y = TileY(st->xy);
+	int left = TileX(ta.tile);
+	int top = TileY(ta.tile);
+	uint reach = std::max({abs(left - x), abs(left + ta.w - 1 - x), abs(top - y), abs(top + ta.h - 1 - y)});
+	_station_catchment_reach = std::max(_station_catchment_reach, reach);
+}
+
+/**
+ * Get the stations whose catchment area may cover part of an area.
+ * @param ta The area to check.
+ * @return The candidate stations, some of which may not actually cover the area.
+ */
+FlatSet<StationID> GetStationsNearArea(const TileArea &ta)
+{
+	FlatSet<StationID> stations;
+	uint reach = _station_catchment_reach;
+
+	uint16_t x1 = static_cast<uint16_t>(std::max<int>(0, TileX(ta.tile) - reach));
+	uint16_t y1 = static_cast<uint16_t>(std::max<int>(0, TileY(ta.tile) - reach));
+	uint16_t x2 = static_cast<uint16_t>(std::min<uint>(TileX(ta.tile) + ta.w + reach, Map::SizeX()));
+	uint16_t y2 = static_cast<uint16_t>(std::min<uint>(TileY(ta.tile) + ta.h + reach, Map::SizeY()));
+
+	_station_kdtree.FindContained(x1, y1, x2, y2, [&stations](StationID id) {
+		stations.insert(id);
+	});
+	return stations;
+}
+
 void RebuildStationKdtree()
 {
 	std::vector<StationID> stids;
@@ -473,7 +519,7 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 		return;
 	}
 
-	if (!_settings_game.station.serve_neutral_industries && this->industry != nullptr) {
+	if (!this->HasOwnCatchment()) {
 		/* Station is associated with an industry, so we only need to deliver to that industry. */
 		this->catchment_tiles.Initialize(this->industry->location);
 		for (TileIndex tile : this->industry->location) {
@@ -488,9 +534,30 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 		this->industry->stations_near.clear();
 		this->industry->stations_near.insert(this);
 		this->industries_near.insert(IndustryListEntry{0, this->industry});
+		ExtendStationCatchmentReach(this);
 		return;
 	}
 
+	this->FillCatchmentTiles();
+	this->AddCatchmentToNearbyLists();
+}
+
+/**
+ * Whether the catchment of this station follows from its own tiles, instead of it being the neutral station of an industry.
+ * @return True iff the catchment is built from the station's tiles.
+ */
+bool Station::HasOwnCatchment() const
+{
+	return _settings_game.station.serve_neutral_industries || this->industry == nullptr;
+}
+
+/**
+ * Fill the catchment tiles from the station's own tiles.
+ * This only reads the map and changes nothing but this station's catchment tiles.
+ * @pre !this->rect.IsEmpty() && this->HasOwnCatchment()
+ */
+void Station::FillCatchmentTiles()
+{
 	this->catchment_tiles.Initialize(GetCatchmentRect());
 
 	/* Loop finding all station tiles */
@@ -501,10 +568,18 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 		uint r = GetTileCatchmentRadius(tile, this);
 		if (r == CA_NONE) continue;
 
-		/* This tile sub-loop doesn't need to test any tiles, they are simply added to the catchment set. */
-		TileArea ta2 = TileArea(tile, 1, 1).Expand(r);
-		for (TileIndex tile2 : ta2) this->catchment_tiles.SetTile(tile2);
+		/* The tiles around don't need to be tested, they are simply added to the catchment set. */
+		this->catchment_tiles.SetArea(TileArea(tile, 1, 1).Expand(r));
 	}
+}
+
+/**
+ * Add this station to the nearby lists of the towns and industries in its catchment tiles.
+ * @pre The catchment tiles have been filled by #FillCatchmentTiles.
+ */
+void Station::AddCatchmentToNearbyLists()
+{
+	ExtendStationCatchmentReach(this);
 
 	/* Search catchment tiles for towns and industries */
 	BitmapTileIterator it(this->catchment_tiles);
@@ -527,15 +602,39 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 	}
 }
 
+/** Minimum number of stations per worker before filling their catchment tiles is spread over threads. */
+static const size_t CATCHMENT_STATIONS_PER_WORKER = 256;
+
 /**
  * Recomputes catchment of all stations.
  * This will additionally recompute nearby stations for all towns and industries.
+ * The catchment tiles of the stations are filled by several threads at once,
+ * as that only reads the map. The nearby lists are shared between stations,
+ * so they are updated afterwards on this thread, in the same order as before.
  */
 /* static */ void Station::RecomputeCatchmentForAll()
 {
 	for (Town *t : Town::Iterate()) { t->stations_near.clear(); }
 	for (Industry *i : Industry::Iterate()) { i->stations_near.clear(); }
-	for (Station *st : Station::Iterate()) { st->RecomputeCatchment(true); }
+	_station_catchment_reach = 0;
+
+	std::vector<Station *> own_catchment;
+	for (Station *st : Station::Iterate()) {
+		if (!st->rect.IsEmpty() && st->HasOwnCatchment()) own_catchment.push_back(st);
+	}
+
+	ParallelForEach("ottd:catchment", own_catchment.size(), own_catchment.size() / CATCHMENT_STATIONS_PER_WORKER, [&own_catchment](size_t i) {
+		own_catchment[i]->FillCatchmentTiles();
+	});
+
+	for (Station *st : Station::Iterate()) {
+		if (!st->rect.IsEmpty() && st->HasOwnCatchment()) {
+			st->industries_near.clear();
+			st->AddCatchmentToNearbyLists();
+		} else {
+			st->RecomputeCatchment(true);
+		}
+	}
 }
 
 /************************************************************************/
@@ -32,7 +32,11 @@ static const uint8_t MAX_STATION_RATING = 255;
  */
 class FlowStat {
 public:
-	typedef std::map<uint32_t, StationID> SharesMap;
+	/**
+	 * Shares of flow, as pairs of the cumulative flow up to and including the share and the station
+	 * the share is sent via. The pairs are sorted by cumulative flow, which is strictly increasing.
+	 */
+	typedef std::vector<std::pair<uint32_t, StationID>> SharesMap;
 
 	static const SharesMap empty_sharesmap;
 
@@ -52,7 +56,7 @@ public:
 	inline FlowStat(StationID st, uint flow, bool restricted = false)
 	{
 		assert(flow > 0);
-		this->shares[flow] = st;
+		this->shares.emplace_back(flow, st);
 		this->unrestricted = restricted ? 0 : flow;
 	}
 
@@ -67,7 +71,7 @@ public:
 	inline void AppendShare(StationID st, uint flow, bool restricted = false)
 	{
 		assert(flow > 0);
-		this->shares[(--this->shares.end())->first + flow] = st;
+		this->shares.emplace_back(this->shares.back().first + flow, st);
 		if (!restricted) this->unrestricted += flow;
 	}
 
@@ -108,7 +112,7 @@ public:
 	/**
 	 * Get a station a package can be routed to. This done by drawing a
 	 * random number between 0 and sum_shares and then looking that up in
-	 * the map with lower_bound. So each share gets selected with a
+	 * the shares with upper_bound. So each share gets selected with a
 	 * probability dependent on its flow. Do include restricted flows here.
 	 * @param is_restricted Output if a restricted flow was chosen.
 	 * @return A station ID from the shares map.
@@ -116,15 +120,15 @@ public:
 	inline StationID GetViaWithRestricted(bool &is_restricted) const
 	{
 		assert(!this->shares.empty());
-		uint rand = RandomRange((--this->shares.end())->first);
+		uint rand = RandomRange(this->shares.back().first);
 		is_restricted = rand >= this->unrestricted;
-		return this->shares.upper_bound(rand)->second;
+		return this->UpperBound(rand)->second;
 	}
 
 	/**
 	 * Get a station a package can be routed to. This done by drawing a
 	 * random number between 0 and sum_shares and then looking that up in
-	 * the map with lower_bound. So each share gets selected with a
+	 * the shares with upper_bound. So each share gets selected with a
 	 * probability dependent on its flow. Don't include restricted flows.
 	 * @return A station ID from the shares map.
 	 */
@@ -132,7 +136,7 @@ public:
 	{
 		assert(!this->shares.empty());
 		return this->unrestricted > 0 ?
-				this->shares.upper_bound(RandomRange(this->unrestricted))->second :
+				this->UpperBound(RandomRange(this->unrestricted))->second :
 				StationID::Invalid();
 	}
 
@@ -141,6 +145,16 @@ public:
 	void Invalidate();
 
 private:
+	/**
+	 * Find the first share with a cumulative flow greater than the given amount.
+	 * @param flow Amount of flow to look up.
+	 * @return Iterator to the share, or the end of the shares if there is none.
+	 */
+	inline SharesMap::const_iterator UpperBound(uint32_t flow) const
+	{
+		return std::ranges::upper_bound(this->shares, flow, std::less{}, &SharesMap::value_type::first);
+	}
+
 	SharesMap shares{}; ///< Shares of flow to be sent via specified station (or consumed locally).
 	uint unrestricted = 0; ///< Limit for unrestricted shares.
 };
@@ -569,6 +583,9 @@ public:
 	uint GetPlatformLength(TileIndex tile) const override;
 	void RecomputeCatchment(bool no_clear_nearby_lists = false);
 	static void RecomputeCatchmentForAll();
+	bool HasOwnCatchment() const;
+	void FillCatchmentTiles();
+	void AddCatchmentToNearbyLists();
 
 	uint GetCatchmentRadius() const;
 	Rect GetCatchmentRect() const;
@@ -633,6 +650,8 @@ public:
 };
 
 void RebuildStationKdtree();
+void ExtendStationCatchmentReach(const Station *st);
+FlatSet<StationID> GetStationsNearArea(const TileArea &ta);
 
 /**
  * Call a function on all stations that have any part of the requested area within their catchment.
@@ -647,25 +666,17 @@ void ForAllStationsAroundTiles(const TileArea &ta, Func func)
 	/* There are no stations, so we will never find anything. */
 	if (Station::GetNumItems() == 0) return;
 
-	/* Not using, or don't have a nearby stations list, so we need to scan. */
-	FlatSet<StationID> seen_stations;
-
-	/* Scan an area around the building covering the maximum possible station
-	 * to find the possible nearby stations. */
-	uint max_c = _settings_game.station.modified_catchment ? MAX_CATCHMENT : CA_UNMODIFIED;
-	TileArea ta_ext = TileArea(ta).Expand(max_c);
-	for (TileIndex tile : ta_ext) {
-		if (!IsTileType(tile, MP_STATION)) continue;
-		seen_stations.insert(GetStationIndex(tile));
-	}
-
-	for (StationID stationid : seen_stations) {
-		Station *st = Station::GetIfValid(stationid);
-		if (st == nullptr) continue; /* Waypoint */
+	/* Not using, or don't have a nearby stations list, so we need to search. The candidates
+	 * come from the station kdtree, in order of their index like a scan of the tiles would. */
+	for (StationID stationid : GetStationsNearArea(ta)) {
+		Station *st = Station::Get(stationid);
 
 		/* Check if station is attached to an industry */
 		if (!_settings_game.station.serve_neutral_industries && st->industry != nullptr) continue;
 
+		/* Skip stations whose catchment area is nowhere near. */
+		if (!st->catchment_tiles.Intersects(ta)) continue;
+
 		/* Test if the tile is within the station's catchment */
 		for (TileIndex tile : ta) {
 			if (st->TileIsInCatchment(tile)) {
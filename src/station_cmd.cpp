@@ -436,11 +436,13 @@ void Station::UpdateVirtCoord()
 	pt.y -= 32 * ZOOM_BASE;
 	if (this->facilities.Test(StationFacility::Airport) && this->airport.type == AT_OILRIG) pt.y -= 16 * ZOOM_BASE;
 
-	if (this->sign.kdtree_valid) _viewport_sign_kdtree.Remove(ViewportSignKdtreeItem::MakeStation(this->index));
+	/* A sign that keeps its position, e.g. after a change of the interface zoom or language, stays in the Kdtree. */
+	bool moved = !this->sign.IsAt(pt.x, pt.y);
+	if (moved && this->sign.kdtree_valid) _viewport_sign_kdtree.Remove(ViewportSignKdtreeItem::MakeStation(this->index));
 
 	this->sign.UpdatePosition(pt.x, pt.y, GetString(STR_VIEWPORT_STATION, this->index, this->facilities), GetString(STR_STATION_NAME, this->index, this->facilities));
 
-	_viewport_sign_kdtree.Insert(ViewportSignKdtreeItem::MakeStation(this->index));
+	if (moved) _viewport_sign_kdtree.Insert(ViewportSignKdtreeItem::MakeStation(this->index));
 
 	SetWindowDirty(WC_STATION_VIEW, this->index);
 }
@@ -458,6 +460,7 @@ void Station::MoveSign(TileIndex new_xy)
 	this->BaseStation::MoveSign(new_xy);
 
 	_station_kdtree.Insert(this->index);
+	ExtendStationCatchmentReach(this);
 }
 
 /** Update the virtual coords needed to draw the station sign for all stations. */
@@ -587,6 +590,8 @@ CargoArray GetAcceptanceAroundTiles(TileIndex center_tile, int w, int h, int rad
 
 /**
  * Get the acceptance of cargoes around the station in.
+ * The acceptance is summed anew each time, as NewGRF houses and industries
+ * can change their acceptance through callbacks without the map changing.
  * @param st Station to get acceptance of.
  * @param always_accepted bitmask of cargo accepted by houses and headquarters; can be nullptr
  */
@@ -2240,8 +2245,7 @@ static CommandCost RemoveRoadStop(TileIndex tile, DoCommandFlags flags, int repl
 	if (IsDriveThroughStopTile(tile) && flags.Test(DoCommandFlag::Bankrupt)) {
 		/* remove the 'going through road stop' status from all vehicles on that tile */
 		if (flags.Test(DoCommandFlag::Execute)) {
-			for (Vehicle *v : VehiclesOnTile(tile)) {
-				if (v->type != VEH_ROAD) continue;
+			for (Vehicle *v : VehiclesOnTile(tile, VEH_ROAD)) {
 				/* Okay... we are a road vehicle on a drive through road stop.
 				 * But that road stop has just been removed, so we need to make
 				 * sure we are in a valid state... however, vehicles can also
@@ -2297,6 +2301,7 @@ static CommandCost RemoveRoadStop(TileIndex tile, DoCommandFlags flags, int repl
 		}
 
 		delete cur_stop;
+		YapfNotifyRoadLayoutChange(tile);
 
 		/* Make sure no vehicle is going to the old roadstop. Narrow the search to any road vehicles with an order to
 		 * this station, then look for any currently heading to the tile. */
@@ -2371,6 +2376,7 @@ CommandCost RemoveRoadWaypointStop(TileIndex tile, DoCommandFlags flags, int rep
 		DeleteNewGRFInspectWindow(GSF_ROADSTOPS, tile.base());
 
 		DoClearSquare(tile);
+		YapfNotifyRoadLayoutChange(tile);
 
 		wp->rect.AfterRemoveTile(wp, tile);
 
@@ -3963,6 +3969,10 @@ static void UpdateStationRating(Station *st)
 	byte_inc_sat(&st->time_since_load);
 	byte_inc_sat(&st->time_since_unload);
 
+	/* These parts of the rating are the same for all cargoes of the station. */
+	const int statue_bonus = (Company::IsValidID(st->owner) && st->town->statues.Test(st->owner)) ? 26 : 0;
+	const bool last_vehicle_is_ship = st->last_vehicle_type == VEH_SHIP;
+
 	for (const CargoSpec *cs : CargoSpec::Iterate()) {
 		GoodsEntry *ge = &st->goods[cs->Index()];
 
@@ -4035,7 +4045,7 @@ static void UpdateStationRating(Station *st)
 			if (b >= 0) rating += b >> 2;
 
 			uint8_t waittime = ge->time_since_pickup;
-			if (st->last_vehicle_type == VEH_SHIP) waittime >>= 2;
+			if (last_vehicle_is_ship) waittime >>= 2;
 			if (waittime <= 21) rating += 25;
 			if (waittime <= 12) rating += 25;
 			if (waittime <= 6) rating += 45;
@@ -4049,7 +4059,7 @@ static void UpdateStationRating(Station *st)
 			if (ge->max_waiting_cargo <= 100) rating += 10;
 		}
 
-		if (Company::IsValidID(st->owner) && st->town->statues.Test(st->owner)) rating += 26;
+		rating += statue_bonus;
 
 		uint8_t age = ge->last_age;
 		if (age < 3) rating += 10;
@@ -4325,26 +4335,58 @@ static void StationHandleSmallTick(BaseStation *st)
 	if (b == 0) UpdateStationRating(Station::From(st));
 }
 
+/**
+ * Finds the stations due for work that is spread over a cycle of ticks, while walking the stations in order of their index.
+ * A station is due when (TimerGameTick::counter + index) is a multiple of the cycle length. So the due indices are
+ * all congruent modulo the cycle length, and can be stepped through instead of dividing for every station.
+ */
+class StationCycleWalker {
+	uint cycle; ///< Length of the cycle in ticks.
+	uint next; ///< Lowest due index not passed yet.
+
+public:
+	/**
+	 * Start walking the stations for the current tick.
+	 * @param cycle Length of the cycle in ticks.
+	 */
+	StationCycleWalker(uint cycle) : cycle(cycle), next(static_cast<uint>((cycle - TimerGameTick::counter % cycle) % cycle)) {}
+
+	/**
+	 * Check whether a station is due. Must be called with increasing indices.
+	 * @param index Index of the station.
+	 * @return True iff (TimerGameTick::counter + index) % cycle == 0.
+	 */
+	bool IsDue(StationID index)
+	{
+		while (this->next < index.base()) this->next += this->cycle;
+		return this->next == index.base();
+	}
+};
+
 void OnTick_Station()
 {
 	if (_game_mode == GM_EDITOR) return;
 
+	StationCycleWalker linkgraph_cycle(Ticks::STATION_LINKGRAPH_TICKS);
+	StationCycleWalker acceptance_cycle(Ticks::STATION_ACCEPTANCE_TICKS);
+
+	/* The counter of the small tick is part of the savegame and advances for every station on every tick,
+	 * and the stations must be handled in order of their index as they draw from the game Random().
+	 * So all stations are still visited, it's only finding the cycles that's cheaper. */
 	for (BaseStation *st : BaseStation::Iterate()) {
 		StationHandleSmallTick(st);
 
 		/* Clean up the link graph about once a week. */
-		if (Station::IsExpected(st) && (TimerGameTick::counter + st->index) % Ticks::STATION_LINKGRAPH_TICKS == 0) {
+		if (linkgraph_cycle.IsDue(st->index) && Station::IsExpected(st)) {
 			DeleteStaleLinks(Station::From(st));
 		};
 
 		/* Spread out big-tick over STATION_ACCEPTANCE_TICKS ticks. */
-		if ((TimerGameTick::counter + st->index) % Ticks::STATION_ACCEPTANCE_TICKS == 0) {
+		if (acceptance_cycle.IsDue(st->index)) {
 			/* Stop processing this station if it was deleted */
 			if (!StationHandleBigTick(st)) continue;
-		}
 
-		/* Spread out station animation over STATION_ACCEPTANCE_TICKS ticks. */
-		if ((TimerGameTick::counter + st->index) % Ticks::STATION_ACCEPTANCE_TICKS == 0) {
+			/* Spread out station animation over STATION_ACCEPTANCE_TICKS ticks. */
 			TriggerStationAnimation(st, st->xy, StationAnimationTrigger::AcceptanceTick);
 			TriggerRoadStopAnimation(st, st->xy, StationAnimationTrigger::AcceptanceTick);
 			if (Station::IsExpected(st)) TriggerAirportAnimation(Station::From(st), AirportAnimationTrigger::AcceptanceTick);
@@ -4359,6 +4401,9 @@ static const IntervalTimer<TimerGameEconomy> _economy_stations_monthly({TimerGam
 		for (GoodsEntry &ge : st->goods) {
 			ge.status.Set(GoodsEntry::State::LastMonth, ge.status.Test(GoodsEntry::State::CurrentMonth));
 			ge.status.Reset(GoodsEntry::State::CurrentMonth);
+
+			/* Merge waiting cargo whose source has disappeared in the meantime. */
+			if (ge.HasData()) ge.GetData().cargo.MergePackets();
 		}
 	}
 });
@@ -4590,7 +4635,10 @@ uint MoveGoodsToStation(CargoType cargo, uint amount, Source source, const Stati
 
 	Station *first_station = nullptr;
 	typedef std::pair<Station *, uint> StationInfo;
-	std::vector<StationInfo> used_stations;
+	/* Reused between calls, so industries and towns near several stations do not
+	 * allocate a new list every time they produce cargo. */
+	static std::vector<StationInfo> used_stations;
+	used_stations.clear();
 
 	for (Station *st : all_stations) {
 		if (exclusivity != INVALID_OWNER && exclusivity != st->owner) continue;
@@ -4602,10 +4650,7 @@ uint MoveGoodsToStation(CargoType cargo, uint amount, Source source, const Stati
 			first_station = st;
 			continue;
 		}
-		if (used_stations.empty()) {
-			used_stations.reserve(2);
-			used_stations.emplace_back(first_station, 0);
-		}
+		if (used_stations.empty()) used_stations.emplace_back(first_station, 0);
 		used_stations.emplace_back(st, 0);
 	}
 
@@ -4992,7 +5037,7 @@ StationID FlowStat::GetVia(StationID excluded, StationID excluded2) const
 {
 	if (this->unrestricted == 0) return StationID::Invalid();
 	assert(!this->shares.empty());
-	SharesMap::const_iterator it = this->shares.upper_bound(RandomRange(this->unrestricted));
+	SharesMap::const_iterator it = this->UpperBound(RandomRange(this->unrestricted));
 	assert(it != this->shares.end() && it->first <= this->unrestricted);
 	if (it->second != excluded && it->second != excluded2) return it->second;
 
@@ -5005,8 +5050,8 @@ StationID FlowStat::GetVia(StationID excluded, StationID excluded2) const
 	if (interval >= this->unrestricted) return StationID::Invalid(); // Only one station in the map.
 	uint new_max = this->unrestricted - interval;
 	uint rand = RandomRange(new_max);
-	SharesMap::const_iterator it2 = (rand < begin) ? this->shares.upper_bound(rand) :
-			this->shares.upper_bound(rand + interval);
+	SharesMap::const_iterator it2 = (rand < begin) ? this->UpperBound(rand) :
+			this->UpperBound(rand + interval);
 	assert(it2 != this->shares.end() && it2->first <= this->unrestricted);
 	if (it2->second != excluded && it2->second != excluded2) return it2->second;
 
@@ -5024,13 +5069,13 @@ StationID FlowStat::GetVia(StationID excluded, StationID excluded2) const
 		std::swap(interval, interval2);
 	}
 	rand = RandomRange(new_max);
-	SharesMap::const_iterator it3 = this->shares.upper_bound(this->unrestricted);
+	SharesMap::const_iterator it3 = this->UpperBound(this->unrestricted);
 	if (rand < begin) {
-		it3 = this->shares.upper_bound(rand);
+		it3 = this->UpperBound(rand);
 	} else if (rand < begin2 - interval) {
-		it3 = this->shares.upper_bound(rand + interval);
+		it3 = this->UpperBound(rand + interval);
 	} else {
-		it3 = this->shares.upper_bound(rand + interval + interval2);
+		it3 = this->UpperBound(rand + interval + interval2);
 	}
 	assert(it3 != this->shares.end() && it3->first <= this->unrestricted);
 	return it3->second;
@@ -5045,13 +5090,14 @@ void FlowStat::Invalidate()
 {
 	assert(!this->shares.empty());
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size());
 	uint i = 0;
 	for (const auto &it : this->shares) {
-		new_shares[++i] = it.second;
+		new_shares.emplace_back(++i, it.second);
 		if (it.first == this->unrestricted) this->unrestricted = i;
 	}
 	this->shares.swap(new_shares);
-	assert(!this->shares.empty() && this->unrestricted <= (--this->shares.end())->first);
+	assert(!this->shares.empty() && this->unrestricted <= this->shares.back().first);
 }
 
 /**
@@ -5070,6 +5116,7 @@ void FlowStat::ChangeShare(StationID st, int flow)
 	uint added_shares = 0;
 	uint last_share = 0;
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size());
 	for (const auto &it : this->shares) {
 		if (it.second == st) {
 			if (flow < 0) {
@@ -5091,11 +5138,11 @@ void FlowStat::ChangeShare(StationID st, int flow)
 			 * removed. */
 			flow = 0;
 		}
-		new_shares[it.first + added_shares - removed_shares] = it.second;
+		new_shares.emplace_back(it.first + added_shares - removed_shares, it.second);
 		last_share = it.first;
 	}
 	if (flow > 0) {
-		new_shares[last_share + (uint)flow] = st;
+		new_shares.emplace_back(last_share + (uint)flow, st);
 		if (this->unrestricted < last_share) {
 			this->ReleaseShare(st);
 		} else {
@@ -5116,6 +5163,7 @@ void FlowStat::RestrictShare(StationID st)
 	uint flow = 0;
 	uint last_share = 0;
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size());
 	for (auto &it : this->shares) {
 		if (flow == 0) {
 			if (it.first > this->unrestricted) return; // Not present or already restricted.
@@ -5123,15 +5171,15 @@ void FlowStat::RestrictShare(StationID st)
 				flow = it.first - last_share;
 				this->unrestricted -= flow;
 			} else {
-				new_shares[it.first] = it.second;
+				new_shares.emplace_back(it.first, it.second);
 			}
 		} else {
-			new_shares[it.first - flow] = it.second;
+			new_shares.emplace_back(it.first - flow, it.second);
 		}
 		last_share = it.first;
 	}
 	if (flow == 0) return;
-	new_shares[last_share + flow] = st;
+	new_shares.emplace_back(last_share + flow, st);
 	this->shares.swap(new_shares);
 	assert(!this->shares.empty());
 }
@@ -5161,10 +5209,11 @@ void FlowStat::ReleaseShare(StationID st)
 	}
 	if (flow == 0) return;
 	SharesMap new_shares;
-	new_shares[flow] = st;
+	new_shares.reserve(this->shares.size());
+	new_shares.emplace_back(flow, st);
 	for (SharesMap::iterator it(this->shares.begin()); it != this->shares.end(); ++it) {
 		if (it->second != st) {
-			new_shares[flow + it->first] = it->second;
+			new_shares.emplace_back(flow + it->first, it->second);
 		} else {
 			flow = 0;
 		}
@@ -5182,10 +5231,11 @@ void FlowStat::ScaleToMonthly(uint runtime)
 {
 	assert(runtime > 0);
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size());
 	uint share = 0;
 	for (auto i : this->shares) {
 		share = std::max(share + 1, i.first * 30 / runtime);
-		new_shares[share] = i.second;
+		new_shares.emplace_back(share, i.second);
 		if (this->unrestricted == i.first) this->unrestricted = share;
 	}
 	this->shares.swap(new_shares);
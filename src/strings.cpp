@@ -46,6 +46,7 @@
 #include "3rdparty/fmt/std.h"
 
 #include "strings_internal.h"
+#include "rpc/rpc_engine_cache.h"
 
 #include "safeguards.h"
 
@@ -1146,6 +1147,18 @@ static void FormatString(StringBuilder &builder, std::string_view str_arg, Strin
 			StringConsumer &consumer = str_stack.top().consumer;
 			const size_t ref_param_offset = str_stack.top().first_param_offset;
 			const uint case_index = str_stack.top().case_index;
+
+			/* Control codes are all outside of ASCII, so copy runs of plain ASCII text at once
+			 * instead of decoding and encoding them one character at a time. */
+			std::string_view left = consumer.GetLeftData();
+			auto plain_end = std::ranges::find_if(left, [](char c) { return c == '\0' || static_cast<uint8_t>(c) >= 0x80; });
+			if (plain_end != left.begin()) {
+				size_t plain_length = std::distance(left.begin(), plain_end);
+				builder += left.substr(0, plain_length);
+				consumer.Skip(plain_length);
+				continue;
+			}
+
 			char32_t b = consumer.ReadUtf8();
 			assert(b != 0);
 			if (b == 0) {
@@ -1608,7 +1621,11 @@ static void FormatString(StringBuilder &builder, std::string_view str_arg, Strin
 					const Company *c = Company::GetIfValid(args.GetNextParameter<CompanyID>());
 					if (c == nullptr) break;
 
-					if (!c->name.empty()) {
+					static bool use_cache = true;
+					if (use_cache) { // Use cached version if first call
+						AutoRestoreBackup cache_backup(use_cache, false);
+						builder += c->GetCachedName();
+					} else if (!c->name.empty()) {
 						auto tmp_params = MakeParameters(c->name);
 						GetStringWithArgs(builder, STR_JUST_RAW_STRING, tmp_params);
 					} else {
@@ -2133,6 +2150,7 @@ bool ReadLanguagePack(const LanguageMetadata *lang)
 	BuildIndustriesLegend();
 	BuildContentTypeStringList();
 	InvalidateWindowClassesData(WC_BUILD_VEHICLE);      // Build vehicle window.
+	RpcInvalidateEngineCache();                         // Engine names of the RPC server.
 	InvalidateWindowClassesData(WC_TRAINS_LIST);        // Train group window.
 	InvalidateWindowClassesData(WC_ROADVEH_LIST);       // Road vehicle group window.
 	InvalidateWindowClassesData(WC_SHIPS_LIST);         // Ship group window.
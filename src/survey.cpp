@@ -67,6 +67,9 @@
 #ifdef WITH_LZO
 #include <lzo/lzo1x.h>
 #endif
+#ifdef WITH_ZSTD
+#include <zstd.h>
+#endif
 #ifdef WITH_SDL2
 #include <SDL.h>
 #endif /* WITH_SDL2 */
@@ -436,6 +439,10 @@ void SurveyLibraries(nlohmann::json &survey)
 	survey["lzo"] = lzo_version_string();
 #endif
 
+#ifdef WITH_ZSTD
+	survey["zstd"] = ZSTD_versionString();
+#endif
+
 #ifdef WITH_PNG
 	survey["png"] = png_get_libpng_ver(nullptr);
 #endif /* WITH_PNG */
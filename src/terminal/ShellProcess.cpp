@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cerrno>
 #include <csignal>
 #include <cstdio>
@@ -29,6 +30,7 @@
 #include <unistd.h>
 #include <util.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/wait.h>
 #elif defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
 #include <pty.h>
@@ -37,6 +39,7 @@
 #include <termios.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/wait.h>
 #endif
 
@@ -92,6 +95,15 @@ public:
 		return result;
 	}
 
+	bool WaitReadable(int timeoutMs) override
+	{
+		if (this->master_fd < 0) return true;
+
+		pollfd pfd{this->master_fd, POLLIN, 0};
+		int result = poll(&pfd, 1, timeoutMs);
+		return result != 0;
+	}
+
 	bool Write(std::span<const uint8_t> data) override
 	{
 		if (this->master_fd < 0 || data.empty()) return false;
@@ -134,8 +146,8 @@ public:
 private:
 	int master_fd;
 	pid_t pid;
-	int exit_status = 0;
-	bool exited = false;
+	std::atomic<int> exit_status = 0; ///< Set by the thread reading the PTY, see TerminalReader.
+	std::atomic<bool> exited = false; ///< Set by the thread reading the PTY, after #exit_status.
 	std::string description;
 
 	void KillChild()
@@ -155,8 +167,8 @@ private:
 				int status = 0;
 				pid_t result = waitpid(this->pid, &status, WNOHANG);
 				if (result == this->pid) {
-					this->exited = true;
 					this->exit_status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+					this->exited = true;
 					this->pid = -1;
 					return;
 				}
@@ -170,8 +182,8 @@ private:
 		int status = 0;
 		pid_t result = waitpid(this->pid, &status, WNOHANG);
 		if (result == this->pid) {
-			this->exited = true;
 			this->exit_status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+			this->exited = true;
 		} else if (result == 0) {
 			/* Process still running (shouldn't happen after SIGKILL), detach waiter. */
 			pid_t pidToWait = this->pid;
@@ -191,8 +203,8 @@ private:
 		int status = 0;
 		pid_t result = waitpid(this->pid, &status, WNOHANG);
 		if (result == this->pid) {
-			this->exited = true;
 			this->exit_status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+			this->exited = true;
 			this->pid = -1;
 		}
 	}
@@ -41,6 +41,9 @@ public:
 	/** Read data from the process. Returns bytes read, 0 if no data, -1 on error. */
 	virtual ssize_t Read(uint8_t *buffer, size_t length) = 0;
 
+	/** Wait until Read has something to return, data or an error. Returns false on timeout. */
+	virtual bool WaitReadable(int timeoutMs) = 0;
+
 	/** Write binary data to the process. */
 	virtual bool Write(std::span<const uint8_t> data) = 0;
 
@@ -0,0 +1,79 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file TerminalReader.cpp Background thread feeding the output of a shell process into its terminal session. */
+
+#include "../stdafx.h"
+#include "../thread.h"
+#include "TerminalReader.h"
+#include "ShellProcess.h"
+#include "TerminalSession.h"
+
+#include <array>
+#include <chrono>
+
+#include "../safeguards.h"
+
+namespace OpenTTD::Terminal {
+
+/** Size of the chunks the output is read and parsed in; the session is locked per chunk. */
+static constexpr size_t READ_CHUNK_SIZE = 16384;
+
+/** How long the thread waits for output before checking whether it has to stop. */
+static constexpr int READ_WAIT_MS = 50;
+
+TerminalReader::TerminalReader(ShellProcess &process, TerminalSession &session)
+	: process(process), session(session)
+{
+	StartNewThread(&this->thread, "ottd:terminal", [this]() { this->Run(); });
+}
+
+TerminalReader::~TerminalReader()
+{
+	this->stop = true;
+	if (this->thread.joinable()) this->thread.join();
+}
+
+bool TerminalReader::TakeOutput()
+{
+	/* Without a thread, read on the caller's thread like before. */
+	if (!this->thread.joinable()) this->ReadAvailable(0);
+	return this->output.exchange(false);
+}
+
+/**
+ * Wait for output of the process and feed everything that is available to the session.
+ * @param timeoutMs How long to wait for output to arrive.
+ */
+void TerminalReader::ReadAvailable(int timeoutMs)
+{
+	if (!this->process.IsRunning() || !this->process.WaitReadable(timeoutMs)) return;
+
+	std::array<uint8_t, READ_CHUNK_SIZE> buffer;
+	for (;;) {
+		ssize_t bytes = this->process.Read(buffer.data(), buffer.size());
+		if (bytes <= 0) {
+			/* A hung up PTY stays readable; wait before Read checks again whether the process exited. */
+			if (bytes < 0 && timeoutMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+			return;
+		}
+
+		this->session.FeedOutput(std::span<const uint8_t>(buffer.data(), static_cast<size_t>(bytes)));
+		this->output = true;
+		if (this->stop) return;
+	}
+}
+
+/** Body of the reader thread. */
+void TerminalReader::Run()
+{
+	while (!this->stop && this->process.IsRunning()) {
+		this->ReadAvailable(READ_WAIT_MS);
+	}
+}
+
+} // namespace OpenTTD::Terminal
@@ -0,0 +1,53 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file TerminalReader.h Background thread feeding the output of a shell process into its terminal session. */
+
+#ifndef TERMINAL_READER_H
+#define TERMINAL_READER_H
+
+#include <atomic>
+#include <thread>
+
+namespace OpenTTD::Terminal {
+
+class ShellProcess;
+class TerminalSession;
+
+/**
+ * Reads the PTY of a shell process and parses the output into a terminal session
+ * on a thread of its own, so large amounts of output do not hold up the GUI. The
+ * GUI takes snapshots of the session whenever #TakeOutput says there is new output.
+ */
+class TerminalReader {
+public:
+	TerminalReader(ShellProcess &process, TerminalSession &session);
+	~TerminalReader();
+
+	TerminalReader(const TerminalReader &) = delete;
+	TerminalReader &operator=(const TerminalReader &) = delete;
+
+	/**
+	 * Check whether output has been fed to the session since the previous call.
+	 * @return True if there is new output.
+	 */
+	bool TakeOutput();
+
+private:
+	ShellProcess &process;
+	TerminalSession &session;
+	std::thread thread; ///< The thread reading the PTY, if it could be started.
+	std::atomic<bool> stop = false; ///< Set to make the thread stop.
+	std::atomic<bool> output = false; ///< Output has been fed to the session that the GUI has not seen.
+
+	void ReadAvailable(int timeoutMs);
+	void Run();
+};
+
+} // namespace OpenTTD::Terminal
+
+#endif /* TERMINAL_READER_H */
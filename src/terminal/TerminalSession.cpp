@@ -10,6 +10,7 @@
 #include "../stdafx.h"
 #include "TerminalSession.h"
 #include "../core/string_consumer.hpp"
+#include "../core/utf8.hpp"
 
 #include <algorithm>
 #include <array>
@@ -48,7 +49,6 @@ namespace {
 
 constexpr TerminalColourRGB kDefaultForegroundRgb{229, 229, 229};
 constexpr TerminalColourRGB kDefaultBackgroundRgb{0, 0, 0};
-constexpr int kMaxScrollbackRows = 2000;
 
 [[nodiscard]] TerminalCell MakeEmptyCell()
 {
@@ -59,6 +59,194 @@ constexpr int kMaxScrollbackRows = 2000;
 	return cell;
 }
 
+/** Attributes of a run of consecutive cells of a scrollback row. */
+struct ScrollbackSpan {
+	uint16_t length = 0;                 ///< Number of cells in the run.
+	TerminalColourRGB foregroundRgb;     ///< Foreground colour of the cells.
+	TerminalColourRGB backgroundRgb;     ///< Background colour of the cells.
+	uint8_t flags = 0;                   ///< Bold, underline, inverse, wide and continuation, see #SpanFlags.
+};
+
+[[nodiscard]] uint8_t SpanFlags(const TerminalCell &cell)
+{
+	return (cell.bold ? 1 : 0) | (cell.underline ? 2 : 0) | (cell.inverse ? 4 : 0) | (cell.wide ? 8 : 0) | (cell.continuation ? 16 : 0);
+}
+
+/** Check whether a cell is blank, with the default colours and no attributes. */
+[[nodiscard]] bool IsEmptyCell(const TerminalCell &cell)
+{
+	return cell.codepoint == U' ' && SpanFlags(cell) == 0 &&
+		cell.foregroundRgb.r == kDefaultForegroundRgb.r && cell.foregroundRgb.g == kDefaultForegroundRgb.g && cell.foregroundRgb.b == kDefaultForegroundRgb.b &&
+		cell.backgroundRgb.r == kDefaultBackgroundRgb.r && cell.backgroundRgb.g == kDefaultBackgroundRgb.g && cell.backgroundRgb.b == kDefaultBackgroundRgb.b;
+}
+
+[[nodiscard]] bool SameAttributes(const ScrollbackSpan &span, const TerminalCell &cell)
+{
+	return span.flags == SpanFlags(cell) &&
+		span.foregroundRgb.r == cell.foregroundRgb.r && span.foregroundRgb.g == cell.foregroundRgb.g && span.foregroundRgb.b == cell.foregroundRgb.b &&
+		span.backgroundRgb.r == cell.backgroundRgb.r && span.backgroundRgb.g == cell.backgroundRgb.g && span.backgroundRgb.b == cell.backgroundRgb.b;
+}
+
+/** A row of scrollback: the text in UTF-8 and the attributes as runs of equal cells. Trailing empty cells are not stored. */
+struct ScrollbackRow {
+	std::string text;                    ///< One UTF-8 encoded codepoint per cell.
+	std::vector<ScrollbackSpan> spans;   ///< Attributes of the cells, in order.
+
+	[[nodiscard]] size_t Bytes() const
+	{
+		return sizeof(*this) + this->text.capacity() + this->spans.capacity() * sizeof(ScrollbackSpan);
+	}
+};
+
+/**
+ * The rows that scrolled off the top of the terminal. Rows are stored compactly, as most
+ * output is plain ASCII with few colour changes, and the oldest rows are dropped when the
+ * rows use more than the byte budget.
+ */
+class Scrollback {
+public:
+	void SetBudget(size_t bytes)
+	{
+		this->budget = bytes;
+		this->Trim();
+	}
+
+	void Push(const TerminalCell *cells, int count)
+	{
+		while (count > 0 && IsEmptyCell(cells[count - 1])) count--;
+
+		ScrollbackRow row;
+		row.text.reserve(static_cast<size_t>(count));
+		for (int i = 0; i < count; i++) {
+			const TerminalCell &cell = cells[i];
+			auto [buf, len] = EncodeUtf8(cell.codepoint);
+			if (len == 0) {
+				row.text.push_back('?');
+			} else {
+				row.text.append(buf, len);
+			}
+
+			if (row.spans.empty() || row.spans.back().length == UINT16_MAX || !SameAttributes(row.spans.back(), cell)) {
+				row.spans.push_back({0, cell.foregroundRgb, cell.backgroundRgb, SpanFlags(cell)});
+			}
+			row.spans.back().length++;
+		}
+		row.text.shrink_to_fit();
+		row.spans.shrink_to_fit();
+
+		this->bytes += row.Bytes();
+		this->rows.push_back(std::move(row));
+		this->Trim();
+	}
+
+	void Clear()
+	{
+		this->first += this->rows.size();
+		this->rows.clear();
+		this->bytes = 0;
+	}
+
+	[[nodiscard]] int Rows() const
+	{
+		return static_cast<int>(this->rows.size());
+	}
+
+	/** Get the number of rows ever dropped or cleared, i.e. the absolute index of the oldest row. */
+	[[nodiscard]] uint64_t First() const
+	{
+		return this->first;
+	}
+
+	/**
+	 * Decode a row into cells.
+	 * @param index The row, 0 being the oldest.
+	 * @param dest The cells to fill.
+	 * @param width Number of cells to fill; cells beyond the stored row are empty.
+	 */
+	void Decode(size_t index, TerminalCell *dest, int width) const
+	{
+		const ScrollbackRow &row = this->rows[index];
+		std::string_view text = row.text;
+		int col = 0;
+		for (const ScrollbackSpan &span : row.spans) {
+			for (uint16_t i = 0; i < span.length && col < width; i++, col++) {
+				auto [len, c] = DecodeUtf8(text);
+				if (len == 0) {
+					len = 1;
+					c = U'?';
+				}
+				text.remove_prefix(std::min(len, text.size()));
+
+				TerminalCell &cell = dest[col];
+				cell.codepoint = c;
+				cell.foregroundRgb = span.foregroundRgb;
+				cell.backgroundRgb = span.backgroundRgb;
+				cell.bold = (span.flags & 1) != 0;
+				cell.underline = (span.flags & 2) != 0;
+				cell.inverse = (span.flags & 4) != 0;
+				cell.wide = (span.flags & 8) != 0;
+				cell.continuation = (span.flags & 16) != 0;
+			}
+		}
+		std::fill(dest + col, dest + width, MakeEmptyCell());
+	}
+
+	/**
+	 * Decode consecutive rows into cells, one after the other.
+	 * @param startRow The first row, 0 being the oldest.
+	 * @param rowCount Number of rows.
+	 * @param lineWidth Number of cells per row.
+	 * @param out The cells; rows that do not exist are empty.
+	 */
+	void Copy(int startRow, int rowCount, int lineWidth, std::vector<TerminalCell> &out) const
+	{
+		if (startRow < 0) {
+			out.clear();
+			return;
+		}
+		this->CopyAbsolute(this->first + startRow, rowCount, lineWidth, out);
+	}
+
+	/**
+	 * Decode consecutive rows into cells, addressing the rows by their absolute index.
+	 * The absolute index of a row does not change when older rows are dropped.
+	 * @param startRow The absolute index of the first row, see #First.
+	 * @param rowCount Number of rows.
+	 * @param lineWidth Number of cells per row.
+	 * @param out The cells; rows that do not exist (anymore) are empty.
+	 */
+	void CopyAbsolute(uint64_t startRow, int rowCount, int lineWidth, std::vector<TerminalCell> &out) const
+	{
+		if (rowCount <= 0 || lineWidth <= 0) {
+			out.clear();
+			return;
+		}
+
+		out.assign(static_cast<size_t>(rowCount) * lineWidth, MakeEmptyCell());
+		for (int i = 0; i < rowCount; i++) {
+			uint64_t sourceIndex = startRow + i;
+			if (sourceIndex < this->first) continue;
+			if (sourceIndex - this->first >= this->rows.size()) break;
+			this->Decode(static_cast<size_t>(sourceIndex - this->first), &out[static_cast<size_t>(i) * lineWidth], lineWidth);
+		}
+	}
+
+private:
+	std::deque<ScrollbackRow> rows;      ///< The rows, oldest first.
+	size_t bytes = 0;                    ///< Memory used by #rows.
+	size_t budget = TerminalSession::DEFAULT_SCROLLBACK_BYTES; ///< Most memory #rows may use.
+	uint64_t first = 0;                  ///< Absolute index of the oldest row in #rows.
+
+	void Trim()
+	{
+		while (this->bytes > this->budget && !this->rows.empty()) {
+			this->bytes -= this->rows.front().Bytes();
+			this->rows.pop_front();
+			this->first++;
+		}
+	}
+};
+
 /* ANSI colour table (8 basic + 8 bright). */
 constexpr std::array<TerminalColourRGB, 16> kAnsiColours = {{
 	{0, 0, 0},         // 0 Black
@@ -88,11 +276,13 @@ struct TerminalSession::Impl {
 	VTermScreen *screen = nullptr;
 	VTermState *state = nullptr;
 	bool dirty = true;
+	bool fullDamage = true;             ///< Whether all rows have to be read again.
+	std::vector<bool> damagedRows;      ///< Rows damaged since the last snapshot.
 	bool altScreenActive = false;
 	TerminalSnapshot snapshot;
 	int cols = 0;
 	int rows = 0;
-	std::deque<std::vector<TerminalCell>> scrollback;
+	Scrollback scrollback;
 
 	explicit Impl(int initialCols, int initialRows)
 	{
@@ -117,13 +307,20 @@ struct TerminalSession::Impl {
 
 		static VTermScreenCallbacks callbacks = {
 			/* damage */
-			[](VTermRect, void *user) {
+			[](VTermRect rect, void *user) {
 				auto *impl = static_cast<Impl *>(user);
-				if (impl) impl->dirty = true;
+				if (impl) impl->DamageRows(rect);
 				return 1;
 			},
 			/* moverect */
-			[](VTermRect, VTermRect, void *) { return 1; },
+			[](VTermRect dest, VTermRect src, void *user) {
+				auto *impl = static_cast<Impl *>(user);
+				if (impl) {
+					impl->DamageRows(dest);
+					impl->DamageRows(src);
+				}
+				return 1;
+			},
 			/* movecursor */
 			[](VTermPos, VTermPos, int, void *) { return 1; },
 			/* settermprop */
@@ -133,6 +330,7 @@ struct TerminalSession::Impl {
 				if (prop == VTERM_PROP_ALTSCREEN) {
 					impl->altScreenActive = (val->boolean != 0);
 					impl->dirty = true;
+					impl->fullDamage = true;
 					return 1;
 				}
 				return 0;
@@ -146,6 +344,7 @@ struct TerminalSession::Impl {
 					impl->rows = newRows;
 					impl->cols = newCols;
 					impl->dirty = true;
+					impl->fullDamage = true;
 				}
 				return 1;
 			},
@@ -178,7 +377,24 @@ struct TerminalSession::Impl {
 		}
 	}
 
-	void ForceRefresh() { this->dirty = true; }
+	void ForceRefresh()
+	{
+		this->dirty = true;
+		this->fullDamage = true;
+	}
+
+	/** Remember that the rows of a rectangle have to be read again. */
+	void DamageRows(VTermRect rect)
+	{
+		this->dirty = true;
+		if (this->damagedRows.size() != static_cast<size_t>(this->rows)) {
+			this->fullDamage = true;
+			return;
+		}
+		int start = std::max(0, rect.start_row);
+		int end = std::min(this->rows, rect.end_row);
+		for (int row = start; row < end; row++) this->damagedRows[row] = true;
+	}
 
 	void Feed(std::span<const uint8_t> bytes)
 	{
@@ -194,8 +410,9 @@ struct TerminalSession::Impl {
 		this->cols = std::max(2, newCols);
 		this->rows = std::max(2, newRows);
 		vterm_set_size(this->term, this->rows, this->cols);
-		this->scrollback.clear();
+		this->scrollback.Clear();
 		this->dirty = true;
+		this->fullDamage = true;
 	}
 
 	[[nodiscard]] TerminalCell ConvertVTermCell(const VTermScreenCell &cell) const
@@ -236,13 +453,21 @@ struct TerminalSession::Impl {
 		if (!this->dirty) return false;
 
 		this->dirty = false;
+
+		/* Damage may still be buffered for merging; that has to be known before reading the rows. */
+		vterm_screen_flush_damage(this->screen);
+
+		if (this->snapshot.rows != this->rows || this->snapshot.cols != this->cols) this->fullDamage = true;
 		this->snapshot.rows = this->rows;
 		this->snapshot.cols = this->cols;
 		this->snapshot.cells.resize(static_cast<size_t>(this->rows) * this->cols, MakeEmptyCell());
+		if (this->fullDamage) this->damagedRows.assign(this->rows, true);
+		this->fullDamage = false;
 
 		VTermPos pos{};
 		VTermScreenCell cell{};
 		for (int row = 0; row < this->rows; row++) {
+			if (!this->damagedRows[row]) continue;
 			pos.row = row;
 			for (int col = 0; col < this->cols; col++) {
 				pos.col = col;
@@ -252,7 +477,8 @@ struct TerminalSession::Impl {
 			}
 		}
 
-		vterm_screen_flush_damage(this->screen);
+		this->snapshot.damagedRows = this->damagedRows;
+		this->damagedRows.assign(this->rows, false);
 		outSnapshot = this->snapshot;
 		return true;
 	}
@@ -266,36 +492,14 @@ struct TerminalSession::Impl {
 		for (int col = 0; col < numCols; col++) {
 			row.push_back(this->ConvertVTermCell(cells[col]));
 		}
-		this->scrollback.push_back(std::move(row));
-		while (this->scrollback.size() > kMaxScrollbackRows) {
-			this->scrollback.pop_front();
-		}
+		this->scrollback.Push(row.data(), numCols);
 	}
 
-	int GetScrollbackRows() const { return static_cast<int>(this->scrollback.size()); }
+	int GetScrollbackRows() const { return this->scrollback.Rows(); }
 
 	void CopyScrollbackRows(int startRow, int rowCount, std::vector<TerminalCell> &out) const
 	{
-		if (rowCount <= 0 || startRow < 0) {
-			out.clear();
-			return;
-		}
-
-		const int lineWidth = this->snapshot.cols;
-		out.resize(static_cast<size_t>(rowCount) * lineWidth, MakeEmptyCell());
-
-		for (int i = 0; i < rowCount; i++) {
-			int sourceIndex = startRow + i;
-			if (sourceIndex < 0 || sourceIndex >= static_cast<int>(this->scrollback.size())) continue;
-
-			const auto &row = this->scrollback[static_cast<size_t>(sourceIndex)];
-			auto *dest = &out[static_cast<size_t>(i) * lineWidth];
-			size_t copyCount = std::min(row.size(), static_cast<size_t>(lineWidth));
-			std::copy_n(row.begin(), copyCount, dest);
-			if (copyCount < static_cast<size_t>(lineWidth)) {
-				std::fill(dest + copyCount, dest + lineWidth, MakeEmptyCell());
-			}
-		}
+		this->scrollback.Copy(startRow, rowCount, this->snapshot.cols, out);
 	}
 
 	bool IsAltScreenActive() const { return this->altScreenActive; }
@@ -317,7 +521,7 @@ struct TerminalSession::Impl {
 	bool currentBold = false;
 	bool currentUnderline = false;
 	bool currentInverse = false;
-	std::deque<std::vector<TerminalCell>> scrollback;
+	Scrollback scrollback;
 
 	enum class EscapeState { Text, EscapeIntroducer, CSI, OSC };
 	EscapeState escapeState = EscapeState::Text;
@@ -705,14 +909,7 @@ struct TerminalSession::Impl {
 	{
 		if (rowIndex < 0 || rowIndex >= this->rows || this->cols <= 0) return;
 
-		std::vector<TerminalCell> row;
-		row.reserve(static_cast<size_t>(this->cols));
-		const auto *src = &this->snapshot.cells[static_cast<size_t>(rowIndex) * this->cols];
-		row.insert(row.end(), src, src + this->cols);
-		this->scrollback.push_back(std::move(row));
-		while (this->scrollback.size() > kMaxScrollbackRows) {
-			this->scrollback.pop_front();
-		}
+		this->scrollback.Push(&this->snapshot.cells[static_cast<size_t>(rowIndex) * this->cols], this->cols);
 	}
 
 	void Resize(int newCols, int newRows)
@@ -726,45 +923,24 @@ struct TerminalSession::Impl {
 		this->cursorCol = std::min(this->cursorCol, this->cols - 1);
 		this->savedCursorRow = std::clamp(this->savedCursorRow, 0, this->rows - 1);
 		this->savedCursorCol = std::clamp(this->savedCursorCol, 0, this->cols - 1);
-		this->scrollback.clear();
+		this->scrollback.Clear();
 		this->ResetAttributes();
 		this->dirty = true;
 	}
 
-	int GetScrollbackRows() const { return static_cast<int>(this->scrollback.size()); }
+	int GetScrollbackRows() const { return this->scrollback.Rows(); }
 
 	void CopyScrollbackRows(int startRow, int rowCount, std::vector<TerminalCell> &out) const
 	{
-		if (rowCount <= 0 || startRow < 0) {
-			out.clear();
-			return;
-		}
-
-		const int lineWidth = this->snapshot.cols;
-		if (lineWidth <= 0) {
-			out.clear();
-			return;
-		}
-
-		out.resize(static_cast<size_t>(rowCount) * lineWidth, MakeEmptyCell());
-		for (int i = 0; i < rowCount; i++) {
-			int sourceIndex = startRow + i;
-			if (sourceIndex < 0 || sourceIndex >= static_cast<int>(this->scrollback.size())) continue;
-
-			const auto &row = this->scrollback[static_cast<size_t>(sourceIndex)];
-			auto *dest = &out[static_cast<size_t>(i) * lineWidth];
-			size_t copyCount = std::min(row.size(), static_cast<size_t>(lineWidth));
-			std::copy_n(row.begin(), copyCount, dest);
-			if (copyCount < static_cast<size_t>(lineWidth)) {
-				std::fill(dest + copyCount, dest + lineWidth, MakeEmptyCell());
-			}
-		}
+		this->scrollback.Copy(startRow, rowCount, this->snapshot.cols, out);
 	}
 
 	bool Snapshot(TerminalSnapshot &outSnapshot)
 	{
 		if (!this->dirty) return false;
 		this->dirty = false;
+		/* This parser does not track which rows it changed. */
+		this->snapshot.damagedRows.assign(this->rows, true);
 		outSnapshot = this->snapshot;
 		return true;
 	}
@@ -774,57 +950,86 @@ struct TerminalSession::Impl {
 
 #endif /* WITH_VTERM */
 
-TerminalSession::TerminalSession(int cols, int rows)
+/**
+ * Create a terminal session.
+ * @param cols Number of columns.
+ * @param rows Number of rows.
+ * @param scrollbackBytes Most memory the scrollback may use; the oldest rows are dropped beyond it.
+ */
+TerminalSession::TerminalSession(int cols, int rows, size_t scrollbackBytes)
 	: impl(std::make_unique<Impl>(cols, rows))
 {
+	this->impl->scrollback.SetBudget(scrollbackBytes);
 }
 
 TerminalSession::~TerminalSession() = default;
 
 void TerminalSession::Resize(int cols, int rows)
 {
+	std::lock_guard<std::mutex> lock(this->mutex);
 	this->impl->Resize(cols, rows);
 }
 
 void TerminalSession::FeedOutput(std::span<const uint8_t> bytes)
 {
 	if (bytes.empty()) return;
+	std::lock_guard<std::mutex> lock(this->mutex);
 	this->impl->Feed(bytes);
 }
 
 bool TerminalSession::ConsumeSnapshot(TerminalSnapshot &outSnapshot)
 {
-	return this->impl->Snapshot(outSnapshot);
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if (!this->impl->Snapshot(outSnapshot)) return false;
+	outSnapshot.scrollbackRows = this->impl->GetScrollbackRows();
+	outSnapshot.scrollbackFirst = this->impl->scrollback.First();
+	return true;
 }
 
 void TerminalSession::ForceFullRefresh()
 {
+	std::lock_guard<std::mutex> lock(this->mutex);
 	this->impl->ForceRefresh();
 }
 
 int TerminalSession::GetCols() const
 {
+	std::lock_guard<std::mutex> lock(this->mutex);
 	return this->impl->snapshot.cols;
 }
 
 int TerminalSession::GetRows() const
 {
+	std::lock_guard<std::mutex> lock(this->mutex);
 	return this->impl->snapshot.rows;
 }
 
 int TerminalSession::GetScrollbackRowCount() const
 {
+	std::lock_guard<std::mutex> lock(this->mutex);
 	return this->impl->GetScrollbackRows();
 }
 
 bool TerminalSession::IsAltScreenActive() const
 {
+	std::lock_guard<std::mutex> lock(this->mutex);
 	return this->impl->IsAltScreenActive();
 }
 
 void TerminalSession::CopyScrollbackRows(int startRow, int rowCount, std::vector<TerminalCell> &out) const
 {
+	std::lock_guard<std::mutex> lock(this->mutex);
 	this->impl->CopyScrollbackRows(startRow, rowCount, out);
 }
 
+void TerminalSession::CopySnapshotScrollbackRows(const TerminalSnapshot &snapshot, int startRow, int rowCount, std::vector<TerminalCell> &out) const
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if (startRow < 0) {
+		out.clear();
+		return;
+	}
+	this->impl->scrollback.CopyAbsolute(snapshot.scrollbackFirst + startRow, rowCount, this->impl->snapshot.cols, out);
+}
+
 } // namespace OpenTTD::Terminal
@@ -10,8 +10,10 @@
 #ifndef TERMINAL_SESSION_H
 #define TERMINAL_SESSION_H
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <span>
 #include <string>
 #include <vector>
@@ -42,22 +44,31 @@ struct TerminalSnapshot {
 	int rows = 0;                        ///< Number of rows.
 	int cols = 0;                        ///< Number of columns.
 	std::vector<TerminalCell> cells;     ///< Cell data (row-major order).
+	std::vector<bool> damagedRows;       ///< Rows that changed since the previous snapshot.
+	int scrollbackRows = 0;              ///< Number of scrollback rows when the snapshot was taken.
+	uint64_t scrollbackFirst = 0;        ///< Absolute index of the oldest scrollback row when the snapshot was taken.
 
 	void Clear()
 	{
 		this->rows = 0;
 		this->cols = 0;
+		this->scrollbackRows = 0;
+		this->scrollbackFirst = 0;
 		this->cells.clear();
+		this->damagedRows.clear();
 	}
 };
 
 /**
  * Terminal emulator session.
  * Wraps libvterm (if available) or a fallback ANSI parser.
+ * All methods may be called from any thread; the output is usually fed by a TerminalReader.
  */
 class TerminalSession {
 public:
-	TerminalSession(int cols, int rows);
+	static constexpr size_t DEFAULT_SCROLLBACK_BYTES = 8 * 1024 * 1024; ///< Default memory budget of the scrollback.
+
+	TerminalSession(int cols, int rows, size_t scrollbackBytes = DEFAULT_SCROLLBACK_BYTES);
 	~TerminalSession();
 
 	TerminalSession(const TerminalSession &) = delete;
@@ -94,9 +105,20 @@ public:
 	/** Copy scrollback rows to output buffer. */
 	void CopyScrollbackRows(int startRow, int rowCount, std::vector<TerminalCell> &out) const;
 
+	/**
+	 * Copy scrollback rows as they were when a snapshot was taken, so the rows match the
+	 * snapshot's scrollback row count even when rows were added or dropped since.
+	 * @param snapshot The snapshot the rows are relative to.
+	 * @param startRow The first row, 0 being the oldest row of the snapshot.
+	 * @param rowCount Number of rows.
+	 * @param out The cells; rows dropped since the snapshot are empty.
+	 */
+	void CopySnapshotScrollbackRows(const TerminalSnapshot &snapshot, int startRow, int rowCount, std::vector<TerminalCell> &out) const;
+
 private:
 	struct Impl;
 	std::unique_ptr<Impl> impl;
+	mutable std::mutex mutex; ///< Protects #impl.
 };
 
 } // namespace OpenTTD::Terminal
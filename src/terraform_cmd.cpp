@@ -19,6 +19,7 @@
 #include "core/backup_type.hpp"
 #include "terraform_cmd.h"
 #include "landscape_cmd.h"
+#include "pathfinder/yapf/yapf_cache.h"
 
 #include "table/strings.h"
 
@@ -284,6 +285,8 @@ std::tuple<CommandCost, Money, TileIndex> CmdTerraformLand(DoCommandFlags flags,
 		/* Mark affected areas dirty. */
 		for (const auto &t : ts.dirty_tiles) {
 			MarkTileDirtyByTile(t);
+			/* The slope of track is part of the cached segment costs. */
+			if (TrackStatusToTrackBits(GetTileTrackStatus(t, TRANSPORT_RAIL, 0)) != TRACK_BIT_NONE) YapfNotifyTrackLayoutChange(t, INVALID_TRACK);
 			TileIndexToHeightMap::const_iterator new_height = ts.tile_to_new_height.find(t);
 			if (new_height == ts.tile_to_new_height.end()) continue;
 			MarkTileDirtyByTile(t, 0, new_height->second);
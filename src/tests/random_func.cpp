@@ -0,0 +1,36 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file random_func.cpp Test functionality from core/random_func. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../core/random_func.hpp"
+
+#include "../safeguards.h"
+
+TEST_CASE("CounterRandomizer - Known answers")
+{
+	/* The known answer tests of the reference implementation of Philox4x32-10. */
+	CHECK(CounterRandomizer(0, 0).Generate({0, 0, 0, 0}) == std::array<uint32_t, 4>{0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8});
+	CHECK(CounterRandomizer(0xFFFFFFFF, 0xFFFFFFFF).Generate({0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}) == std::array<uint32_t, 4>{0x408F276D, 0x41C83B0E, 0xA20BC7C6, 0x6D5451FD});
+	CHECK(CounterRandomizer(0xA4093822, 0x299F31D0).Generate({0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344}) == std::array<uint32_t, 4>{0xD16CFE09, 0x94FDCCEB, 0x5001E420, 0x24126EA1});
+}
+
+TEST_CASE("CounterRandomizer - Independent of order")
+{
+	CounterRandomizer r(12345, 1);
+	uint32_t a = r.Get(10, 20, 0);
+	uint32_t b = r.Get(10, 20, 1);
+	CHECK(a != b);
+	CHECK(r.Get(10, 20, 1) == b);
+	CHECK(r.Get(10, 20, 0) == a);
+	CHECK(CounterRandomizer(12345, 2).Get(10, 20, 0) != a);
+	CHECK(r.GetRange(10, 20, 0, 100) < 100);
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file terminal_session.cpp Test the scrollback of the terminal session. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../core/format.hpp"
+#include "../terminal/TerminalSession.h"
+
+#include "../safeguards.h"
+
+using namespace OpenTTD::Terminal;
+
+static void Feed(TerminalSession &session, std::string_view output)
+{
+	session.FeedOutput(std::span<const uint8_t>(reinterpret_cast<const uint8_t *>(output.data()), output.size()));
+}
+
+static std::u32string RowText(const std::vector<TerminalCell> &cells)
+{
+	std::u32string text;
+	for (const TerminalCell &cell : cells) text.push_back(cell.codepoint);
+	return text;
+}
+
+TEST_CASE("TerminalSession - scrollback keeps text and attributes")
+{
+	TerminalSession session(10, 2);
+	Feed(session, "plain\r\n\x1b[1;31mred\x1b[0m \xC3\xA9\r\nthird\r\nfourth");
+
+	REQUIRE(session.GetScrollbackRowCount() == 2);
+
+	std::vector<TerminalCell> cells;
+	session.CopyScrollbackRows(0, 2, cells);
+	REQUIRE(cells.size() == 20);
+
+	std::vector<TerminalCell> first(cells.begin(), cells.begin() + 10);
+	std::vector<TerminalCell> second(cells.begin() + 10, cells.end());
+	CHECK(RowText(first) == U"plain     ");
+	CHECK(RowText(second) == U"red é     ");
+
+	CHECK(second[0].bold);
+	CHECK(second[2].bold);
+	CHECK_FALSE(second[4].bold);
+	CHECK(second[0].foregroundRgb.g != second[4].foregroundRgb.g);
+	CHECK_FALSE(second[9].bold);
+}
+
+TEST_CASE("TerminalSession - scrollback stays within its budget")
+{
+	TerminalSession session(10, 2, 4096);
+	for (int i = 0; i < 1000; i++) Feed(session, fmt::format("{}\r\n", i));
+
+	int rows = session.GetScrollbackRowCount();
+	CHECK(rows > 0);
+	CHECK(rows < 1000);
+
+	/* The newest rows are kept. */
+	std::vector<TerminalCell> cells;
+	session.CopyScrollbackRows(rows - 1, 1, cells);
+	CHECK(RowText(cells) == U"998       ");
+}
+
+TEST_CASE("TerminalSession - snapshot scrollback rows do not shift")
+{
+	TerminalSession session(10, 2, 4096);
+	for (int i = 0; i < 1000; i++) Feed(session, fmt::format("{}\r\n", i));
+
+	TerminalSnapshot snapshot;
+	REQUIRE(session.ConsumeSnapshot(snapshot));
+	int rows = snapshot.scrollbackRows;
+
+	/* New output drops old rows, but the snapshot's rows stay where they were. */
+	for (int i = 0; i < 10; i++) Feed(session, fmt::format("new{}\r\n", i));
+
+	std::vector<TerminalCell> cells;
+	session.CopySnapshotScrollbackRows(snapshot, rows - 1, 1, cells);
+	CHECK(RowText(cells) == U"998       ");
+
+	session.CopySnapshotScrollbackRows(snapshot, 0, 1, cells);
+	CHECK(RowText(cells) == U"          ");
+}
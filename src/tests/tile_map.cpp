@@ -0,0 +1,58 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file tile_map.cpp Test functionality from tile_map. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../tile_map.h"
+
+#include "../safeguards.h"
+
+/**
+ * Check that GetTileSlopesInRect gives the same as the per tile functions.
+ * @param x1 X of the northern tile of the rectangle.
+ * @param y1 Y of the northern tile of the rectangle.
+ * @param w Width of the rectangle.
+ * @param h Height of the rectangle.
+ */
+static void CheckTileSlopesInRect(uint x1, uint y1, uint w, uint h)
+{
+	std::vector<TileSlopeZ> slopes(w * h);
+	GetTileSlopesInRect(TileXY(x1, y1), w, h, slopes);
+
+	for (uint y = 0; y < h; y++) {
+		for (uint x = 0; x < w; x++) {
+			TileIndex tile = TileXY(x1 + x, y1 + y);
+			const TileSlopeZ &result = slopes[y * w + x];
+			auto [slope, z] = GetTileSlopeZ(tile);
+			CHECK(result.slope == slope);
+			CHECK(result.z == z);
+			CHECK(result.max_z == GetTileMaxZ(tile));
+		}
+	}
+}
+
+TEST_CASE("GetTileSlopesInRect")
+{
+	Map::Allocate(64, 64);
+
+	/* Corner heights that differ by at most one between neighbours, with some steep slopes. */
+	for (uint y = 0; y < Map::SizeY(); y++) {
+		for (uint x = 0; x < Map::SizeX(); x++) {
+			SetTileHeight(TileXY(x, y), 4 + ((x * 7 + y * 3) % 5 == 0) + ((x * y) % 11 == 0));
+		}
+	}
+
+	CheckTileSlopesInRect(0, 0, 64, 64);
+	CheckTileSlopesInRect(10, 20, 13, 7);
+	CheckTileSlopesInRect(60, 61, 4, 3);
+	CheckTileSlopesInRect(63, 63, 1, 1);
+	CheckTileSlopesInRect(5, 5, 1, 40);
+}
@@ -145,6 +145,7 @@
 #include "genworld.h"
 #include "core/random_func.hpp"
 #include "landscape_type.h"
+#include "thread.h"
 
 #include "safeguards.h"
 
@@ -341,6 +342,9 @@ static inline void FreeHeightMap()
 	_height_map.h.clear();
 }
 
+/** Maximum number of threads the passes over the whole height map are split over. */
+static const uint MAX_TGP_THREADS = 8;
+
 /**
  * Generates new random height in given amplitude (generated numbers will range from - amplitude to + amplitude)
  * @param r_max Limit of result
@@ -458,76 +462,78 @@ static int *HeightMapMakeHistogram(Height h_min, [[maybe_unused]] Height h_max,
 /** Applies sine wave redistribution onto height map */
 static void HeightMapSineTransform(Height h_min, Height h_max)
 {
-	for (Height &h : _height_map.h) {
-		double fheight;
-
-		if (h < h_min) continue;
-
-		/* Transform height into 0..1 space */
-		fheight = (double)(h - h_min) / (double)(h_max - h_min);
-		/* Apply sine transform depending on landscape type */
-		switch (_settings_game.game_creation.landscape) {
-			case LandscapeType::Toyland:
-			case LandscapeType::Temperate:
-				/* Move and scale 0..1 into -1..+1 */
-				fheight = 2 * fheight - 1;
-				/* Sine transform */
-				fheight = sin(fheight * M_PI_2);
-				/* Transform it back from -1..1 into 0..1 space */
-				fheight = 0.5 * (fheight + 1);
-				break;
-
-			case LandscapeType::Arctic:
-				{
-					/* Arctic terrain needs special height distribution.
-					 * Redistribute heights to have more tiles at highest (75%..100%) range */
-					double sine_upper_limit = 0.75;
-					double linear_compression = 2;
-					if (fheight >= sine_upper_limit) {
-						/* Over the limit we do linear compression up */
-						fheight = 1.0 - (1.0 - fheight) / linear_compression;
-					} else {
-						double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
-						/* Get 0..sine_upper_limit into -1..1 */
-						fheight = 2.0 * fheight / sine_upper_limit - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
-						fheight = 0.5 * (fheight + 1.0) * m;
+	ParallelForEachBand("ottd:tgp", _height_map.h.size(), 64 * 1024, MAX_TGP_THREADS, [h_min, h_max](size_t begin, size_t end) {
+		for (Height &h : std::span(_height_map.h).subspan(begin, end - begin)) {
+			double fheight;
+
+			if (h < h_min) continue;
+
+			/* Transform height into 0..1 space */
+			fheight = (double)(h - h_min) / (double)(h_max - h_min);
+			/* Apply sine transform depending on landscape type */
+			switch (_settings_game.game_creation.landscape) {
+				case LandscapeType::Toyland:
+				case LandscapeType::Temperate:
+					/* Move and scale 0..1 into -1..+1 */
+					fheight = 2 * fheight - 1;
+					/* Sine transform */
+					fheight = sin(fheight * M_PI_2);
+					/* Transform it back from -1..1 into 0..1 space */
+					fheight = 0.5 * (fheight + 1);
+					break;
+
+				case LandscapeType::Arctic:
+					{
+						/* Arctic terrain needs special height distribution.
+						 * Redistribute heights to have more tiles at highest (75%..100%) range */
+						double sine_upper_limit = 0.75;
+						double linear_compression = 2;
+						if (fheight >= sine_upper_limit) {
+							/* Over the limit we do linear compression up */
+							fheight = 1.0 - (1.0 - fheight) / linear_compression;
+						} else {
+							double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
+							/* Get 0..sine_upper_limit into -1..1 */
+							fheight = 2.0 * fheight / sine_upper_limit - 1.0;
+							/* Sine wave transform */
+							fheight = sin(fheight * M_PI_2);
+							/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
+							fheight = 0.5 * (fheight + 1.0) * m;
+						}
 					}
-				}
-				break;
-
-			case LandscapeType::Tropic:
-				{
-					/* Desert terrain needs special height distribution.
-					 * Half of tiles should be at lowest (0..25%) heights */
-					double sine_lower_limit = 0.5;
-					double linear_compression = 2;
-					if (fheight <= sine_lower_limit) {
-						/* Under the limit we do linear compression down */
-						fheight = fheight / linear_compression;
-					} else {
-						double m = sine_lower_limit / linear_compression;
-						/* Get sine_lower_limit..1 into -1..1 */
-						fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
-						fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
+					break;
+
+				case LandscapeType::Tropic:
+					{
+						/* Desert terrain needs special height distribution.
+						 * Half of tiles should be at lowest (0..25%) heights */
+						double sine_lower_limit = 0.5;
+						double linear_compression = 2;
+						if (fheight <= sine_lower_limit) {
+							/* Under the limit we do linear compression down */
+							fheight = fheight / linear_compression;
+						} else {
+							double m = sine_lower_limit / linear_compression;
+							/* Get sine_lower_limit..1 into -1..1 */
+							fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
+							/* Sine wave transform */
+							fheight = sin(fheight * M_PI_2);
+							/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
+							fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
+						}
 					}
-				}
-				break;
+					break;
 
-			default:
-				NOT_REACHED();
-				break;
+				default:
+					NOT_REACHED();
+					break;
+			}
+			/* Transform it back into h_min..h_max space */
+			h = (Height)(fheight * (h_max - h_min) + h_min);
+			if (h < 0) h = I2H(0);
+			if (h >= h_max) h = h_max - 1;
 		}
-		/* Transform it back into h_min..h_max space */
-		h = (Height)(fheight * (h_max - h_min) + h_min);
-		if (h < 0) h = I2H(0);
-		if (h >= h_max) h = h_max - 1;
-	}
+	});
 }
 
 /**
@@ -565,8 +571,6 @@ static void HeightMapCurves(uint level)
 
 	const std::span<const ControlPoint> curve_maps[] = { curve_map_1, curve_map_2, curve_map_3, curve_map_4 };
 
-	std::array<Height, std::size(curve_maps)> ht{};
-
 	/* Set up a grid to choose curve maps based on location; attempt to get a somewhat square grid */
 	float factor = sqrt((float)_height_map.size_x / (float)_height_map.size_y);
 	uint sx = Clamp((int)(((1 << level) * factor) + 0.5), 1, 128);
@@ -577,90 +581,93 @@ static void HeightMapCurves(uint level)
 		c[i] = RandomRange(static_cast<uint32_t>(std::size(curve_maps)));
 	}
 
-	/* Apply curves */
-	for (int x = 0; x < _height_map.size_x; x++) {
-
-		/* Get our X grid positions and bi-linear ratio */
-		float fx = (float)(sx * x) / _height_map.size_x + 1.0f;
-		uint x1 = (uint)fx;
-		uint x2 = x1;
-		float xr = 2.0f * (fx - x1) - 1.0f;
-		xr = sin(xr * M_PI_2);
-		xr = sin(xr * M_PI_2);
-		xr = 0.5f * (xr + 1.0f);
-		float xri = 1.0f - xr;
-
-		if (x1 > 0) {
-			x1--;
-			if (x2 >= sx) x2--;
-		}
-
-		for (int y = 0; y < _height_map.size_y; y++) {
-
-			/* Get our Y grid position and bi-linear ratio */
-			float fy = (float)(sy * y) / _height_map.size_y + 1.0f;
-			uint y1 = (uint)fy;
-			uint y2 = y1;
-			float yr = 2.0f * (fy - y1) - 1.0f;
-			yr = sin(yr * M_PI_2);
-			yr = sin(yr * M_PI_2);
-			yr = 0.5f * (yr + 1.0f);
-			float yri = 1.0f - yr;
-
-			if (y1 > 0) {
-				y1--;
-				if (y2 >= sy) y2--;
+	/* Apply curves; every band of columns only reads the grid and writes its own columns. */
+	ParallelForEachBand("ottd:tgp", _height_map.size_x, 64, MAX_TGP_THREADS, [&](size_t begin, size_t end) {
+		std::array<Height, std::size(curve_maps)> ht{};
+		for (int x = static_cast<int>(begin); x < static_cast<int>(end); x++) {
+
+			/* Get our X grid positions and bi-linear ratio */
+			float fx = (float)(sx * x) / _height_map.size_x + 1.0f;
+			uint x1 = (uint)fx;
+			uint x2 = x1;
+			float xr = 2.0f * (fx - x1) - 1.0f;
+			xr = sin(xr * M_PI_2);
+			xr = sin(xr * M_PI_2);
+			xr = 0.5f * (xr + 1.0f);
+			float xri = 1.0f - xr;
+
+			if (x1 > 0) {
+				x1--;
+				if (x2 >= sx) x2--;
 			}
 
-			uint corner_a = c[x1 + sx * y1];
-			uint corner_b = c[x1 + sx * y2];
-			uint corner_c = c[x2 + sx * y1];
-			uint corner_d = c[x2 + sx * y2];
+			for (int y = 0; y < _height_map.size_y; y++) {
+
+				/* Get our Y grid position and bi-linear ratio */
+				float fy = (float)(sy * y) / _height_map.size_y + 1.0f;
+				uint y1 = (uint)fy;
+				uint y2 = y1;
+				float yr = 2.0f * (fy - y1) - 1.0f;
+				yr = sin(yr * M_PI_2);
+				yr = sin(yr * M_PI_2);
+				yr = 0.5f * (yr + 1.0f);
+				float yri = 1.0f - yr;
+
+				if (y1 > 0) {
+					y1--;
+					if (y2 >= sy) y2--;
+				}
+
+				uint corner_a = c[x1 + sx * y1];
+				uint corner_b = c[x1 + sx * y2];
+				uint corner_c = c[x2 + sx * y1];
+				uint corner_d = c[x2 + sx * y2];
 
-			/* Bitmask of which curve maps are chosen, so that we do not bother
-			 * calculating a curve which won't be used. */
-			uint corner_bits = 0;
-			corner_bits |= 1 << corner_a;
-			corner_bits |= 1 << corner_b;
-			corner_bits |= 1 << corner_c;
-			corner_bits |= 1 << corner_d;
+				/* Bitmask of which curve maps are chosen, so that we do not bother
+				 * calculating a curve which won't be used. */
+				uint corner_bits = 0;
+				corner_bits |= 1 << corner_a;
+				corner_bits |= 1 << corner_b;
+				corner_bits |= 1 << corner_c;
+				corner_bits |= 1 << corner_d;
 
-			Height *h = &_height_map.height(x, y);
+				Height *h = &_height_map.height(x, y);
 
-			/* Do not touch sea level */
-			if (*h < I2H(1)) continue;
+				/* Do not touch sea level */
+				if (*h < I2H(1)) continue;
 
-			/* Only scale above sea level */
-			*h -= I2H(1);
+				/* Only scale above sea level */
+				*h -= I2H(1);
 
-			/* Apply all curve maps that are used on this tile. */
-			for (size_t t = 0; t < std::size(curve_maps); t++) {
-				if (!HasBit(corner_bits, static_cast<uint8_t>(t))) continue;
+				/* Apply all curve maps that are used on this tile. */
+				for (size_t t = 0; t < std::size(curve_maps); t++) {
+					if (!HasBit(corner_bits, static_cast<uint8_t>(t))) continue;
 
-				[[maybe_unused]] bool found = false;
-				auto &cm = curve_maps[t];
-				for (size_t i = 0; i < cm.size() - 1; i++) {
-					const ControlPoint &p1 = cm[i];
-					const ControlPoint &p2 = cm[i + 1];
+					[[maybe_unused]] bool found = false;
+					auto &cm = curve_maps[t];
+					for (size_t i = 0; i < cm.size() - 1; i++) {
+						const ControlPoint &p1 = cm[i];
+						const ControlPoint &p2 = cm[i + 1];
 
-					if (*h >= p1.x && *h < p2.x) {
-						ht[t] = p1.y + (*h - p1.x) * (p2.y - p1.y) / (p2.x - p1.x);
+						if (*h >= p1.x && *h < p2.x) {
+							ht[t] = p1.y + (*h - p1.x) * (p2.y - p1.y) / (p2.x - p1.x);
 #ifdef WITH_ASSERT
-						found = true;
+							found = true;
 #endif
-						break;
+							break;
+						}
 					}
+					assert(found);
 				}
-				assert(found);
-			}
 
-			/* Apply interpolation of curve map results. */
-			*h = (Height)((ht[corner_a] * yri + ht[corner_b] * yr) * xri + (ht[corner_c] * yri + ht[corner_d] * yr) * xr);
+				/* Apply interpolation of curve map results. */
+				*h = (Height)((ht[corner_a] * yri + ht[corner_b] * yr) * xri + (ht[corner_c] * yri + ht[corner_d] * yr) * xr);
 
-			/* Re-add sea level */
-			*h += I2H(1);
+				/* Re-add sea level */
+				*h += I2H(1);
+			}
 		}
-	}
+	});
 }
 
 /** Adjusts heights in height map to contain required amount of water tiles */
@@ -941,6 +948,10 @@ static double interpolated_noise(const double x, const double y, const int prime
  * the value p passed as a parameter rather than selected from the predefined
  * sequences. as you can guess by its title, i use this to create the indented
  * coastline, which is just another perlin sequence.
+ * @note This is evaluated twice per row and per column of the map, not per tile,
+ *  so even on the largest maps it is a few milliseconds of the generation; it is
+ *  not worth a vectorised version. The amplitude has to stay pow() instead of a
+ *  running product, as that would round differently and change existing maps.
  */
 static double perlin_coast_noise_2D(const double x, const double y, const double p, const int prime)
 {
@@ -997,11 +1008,13 @@ void GenerateTerrainPerlin()
 	int max_height = H2I(TGPGetMaxHeight());
 
 	/* Transfer height map into OTTD map */
-	for (int y = 0; y < _height_map.size_y; y++) {
-		for (int x = 0; x < _height_map.size_x; x++) {
-			TgenSetTileHeight(TileXY(x, y), Clamp(H2I(_height_map.height(x, y)), 0, max_height));
+	ParallelForEachBand("ottd:tgp", _height_map.size_y, 64, MAX_TGP_THREADS, [max_height](size_t begin, size_t end) {
+		for (int y = static_cast<int>(begin); y < static_cast<int>(end); y++) {
+			for (int x = 0; x < _height_map.size_x; x++) {
+				TgenSetTileHeight(TileXY(x, y), Clamp(H2I(_height_map.height(x, y)), 0, max_height));
+			}
 		}
-	}
+	});
 
 	FreeHeightMap();
 	GenerateWorldSetAbortCallback(nullptr);
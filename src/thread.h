@@ -13,6 +13,8 @@
 #include "debug.h"
 #include "crashlog.h"
 #include "error_func.h"
+#include "core/math_func.hpp"
+#include <atomic>
 #include <system_error>
 #include <thread>
 #include <mutex>
@@ -103,4 +105,68 @@ inline bool StartNewThread(std::thread *thr, std::string_view name, TFn&& _Fx, T
 	return false;
 }
 
+/**
+ * Get the number of threads worth splitting work over.
+ * @return The number of hardware threads, at least one.
+ */
+inline size_t GetParallelThreadCount()
+{
+	return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/**
+ * Call a function for every index of the range [0, count) on a few threads, this one included.
+ * The indices are handed out one at a time, so items that take very different times are spread
+ * well over the threads. The function may only write the data of its own index; anything that
+ * has to be combined is best stored per index and combined in index order afterwards, so the
+ * result does not depend on the number of threads. When no thread can be started, everything
+ * is done on this thread.
+ * @param name Name of the worker threads.
+ * @param count The number of items in the range.
+ * @param max_threads The maximum number of threads to use, at most #GetParallelThreadCount.
+ * @param func The function to call with every index.
+ */
+template <typename TFn>
+void ParallelForEach(std::string_view name, size_t count, size_t max_threads, TFn &&func)
+{
+	std::atomic<size_t> next = 0;
+	auto worker = [&func, &next, count]() {
+		for (size_t i = next++; i < count; i = next++) func(i);
+	};
+
+	size_t num_threads = std::clamp<size_t>(std::min(max_threads, count), 1, GetParallelThreadCount());
+	std::vector<std::thread> threads;
+	threads.reserve(num_threads - 1);
+	for (size_t i = 1; i < num_threads; i++) {
+		if (!StartNewThread(&threads.emplace_back(), name, [&worker]() { worker(); })) {
+			threads.pop_back();
+			break;
+		}
+	}
+	worker();
+
+	for (std::thread &thread : threads) thread.join();
+}
+
+/**
+ * Call a function for consecutive bands of the range [0, count) on a few threads, this one included.
+ * Every index is in exactly one band, so as long as the function only writes the data of its own
+ * band, the result does not depend on the number of threads.
+ * @param name Name of the worker threads.
+ * @param count The number of items in the range.
+ * @param min_band_size The smallest band worth starting a thread for.
+ * @param max_threads The maximum number of threads to use, at most #GetParallelThreadCount.
+ * @param func The function to call with the begin and end of a band.
+ */
+template <typename TFn>
+void ParallelForEachBand(std::string_view name, size_t count, size_t min_band_size, size_t max_threads, TFn &&func)
+{
+	size_t bands = std::clamp<size_t>(count / min_band_size, 1, std::min(max_threads, GetParallelThreadCount()));
+	size_t band_size = CeilDiv(count, bands);
+	ParallelForEach(name, bands, bands, [&func, count, band_size](size_t band) {
+		size_t begin = band * band_size;
+		if (begin < count) func(begin, std::min(count, begin + band_size));
+	});
+}
+
 #endif /* THREAD_H */
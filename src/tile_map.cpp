@@ -67,6 +67,60 @@ std::tuple<Slope, int> GetTileSlopeZ(TileIndex tile)
 	return GetTileSlopeGivenHeight(hnorth, hwest, heast, hsouth);
 }
 
+/**
+ * Get the slopes and heights of all tiles in a rectangle of the map at once.
+ * This is the same as calling #GetTileSlopeZ and #GetTileMaxZ for every tile, but every
+ * corner height is read only once, and every row of tiles is computed from two rows of
+ * heights in a loop the compiler can vectorise.
+ * @param tile The northern tile of the rectangle.
+ * @param w The width of the rectangle, in tiles along the X axis.
+ * @param h The height of the rectangle, in tiles along the Y axis.
+ * @param[out] slopes The slopes of the tiles, row by row along the Y axis; at least  w *  h items.
+ */
+void GetTileSlopesInRect(TileIndex tile, uint w, uint h, std::span<TileSlopeZ> slopes)
+{
+	uint x1 = TileX(tile);
+	uint y1 = TileY(tile);
+	assert(x1 + w <= Map::SizeX() && y1 + h <= Map::SizeY());
+	assert(slopes.size() >= static_cast<size_t>(w) * h);
+
+	/* Corner heights of a row of tiles along the X axis; like GetTileSlopeZ, the tiles at the
+	 * south-west and south-east edges of the map use their own height beyond the edge. */
+	auto read_heights = [x1, w](uint y, std::vector<uint8_t> &heights) {
+		TileIndex t = TileXY(x1, std::min(y, Map::MaxY()));
+		for (uint i = 0; i < w; i++) heights[i] = TileHeight(t + i);
+		heights[w] = TileHeight(TileXY(std::min(x1 + w, Map::MaxX()), std::min(y, Map::MaxY())));
+	};
+
+	std::vector<uint8_t> north(w + 1);
+	std::vector<uint8_t> south(w + 1);
+	read_heights(y1, north);
+
+	for (uint y = 0; y < h; y++) {
+		read_heights(y1 + y + 1, south);
+
+		/* The same as GetTileSlopeGivenHeight, without branches. */
+		TileSlopeZ *row = slopes.data() + static_cast<size_t>(y) * w;
+		for (uint i = 0; i < w; i++) {
+			uint8_t hnorth = north[i];
+			uint8_t hwest = north[i + 1];
+			uint8_t heast = south[i];
+			uint8_t hsouth = south[i + 1];
+
+			uint8_t hmin = std::min(std::min(hnorth, hwest), std::min(heast, hsouth));
+			uint8_t hmax = std::max(std::max(hnorth, hwest), std::max(heast, hsouth));
+
+			uint8_t slope = (hnorth != hmin ? SLOPE_N : 0) | (hwest != hmin ? SLOPE_W : 0) |
+					(heast != hmin ? SLOPE_E : 0) | (hsouth != hmin ? SLOPE_S : 0) |
+					(hmax - hmin == 2 ? SLOPE_STEEP : 0);
+
+			row[i] = {static_cast<Slope>(slope), hmin, hmax};
+		}
+
+		std::swap(north, south);
+	}
+}
+
 /**
  * Return the slope of a given tile, also for tiles outside the map (virtual "black" tiles).
  *
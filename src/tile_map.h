@@ -14,6 +14,7 @@
 #include "map_func.h"
 #include "core/bitmath_func.hpp"
 #include "settings_type.h"
+#include "tile_summary.h"
 
 /**
  * Returns the height of a tile
@@ -135,6 +136,7 @@ inline void SetTileType(Tile tile, TileType type)
 	 * edges of the map. If _settings_game.construction.freeform_edges is true,
 	 * the upper edges of the map are also VOID tiles. */
 	assert(IsInnerTile(tile) == (type != MP_VOID));
+	UpdateTileSummary(tile, static_cast<TileType>(GB(tile.type(), 4, 4)), type);
 	SB(tile.type(), 4, 4, type);
 }
 
@@ -269,6 +271,15 @@ std::tuple<Slope, int> GetTileSlopeZ(TileIndex tile);
 int GetTileZ(TileIndex tile);
 int GetTileMaxZ(TileIndex tile);
 
+/** Slope and height of a tile, as given by #GetTileSlopesInRect. */
+struct TileSlopeZ {
+	Slope slope; ///< Slope of the tile, except for the HALFTILE part.
+	uint8_t z; ///< Height of the lowest corner of the tile.
+	uint8_t max_z; ///< Height of the highest corner of the tile.
+};
+
+void GetTileSlopesInRect(TileIndex tile, uint w, uint h, std::span<TileSlopeZ> slopes);
+
 bool IsTileFlat(TileIndex tile, int *h = nullptr);
 
 /**
@@ -0,0 +1,94 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/**
+ * @file tile_summary.cpp Per block counts of the tile types on the map.
+ *
+ * The summary is built from the map on first use, after which SetTileType
+ * keeps it up to date. Loading a game writes the map directly, so allocating
+ * the map drops the summary and the next use builds it again.
+ */
+
+#include "stdafx.h"
+#include "tile_summary.h"
+#include "tile_map.h"
+
+#include "safeguards.h"
+
+std::vector<TileTypeCounts<uint8_t>> _tile_summary;
+
+/** Drop the summary, e.g. because the map is reallocated. */
+void ResetTileSummary()
+{
+	_tile_summary.clear();
+	_tile_summary.shrink_to_fit();
+}
+
+/** Build the summary from the current map. */
+static void BuildTileSummary()
+{
+	uint blocks_x = Map::SizeX() >> TILE_SUMMARY_BLOCK_BITS;
+	uint blocks_y = Map::SizeY() >> TILE_SUMMARY_BLOCK_BITS;
+	_tile_summary.assign(blocks_x * blocks_y, {});
+
+	for (const auto tile : Map::Iterate()) {
+		uint index = (TileY(tile) >> TILE_SUMMARY_BLOCK_BITS) * blocks_x + (TileX(tile) >> TILE_SUMMARY_BLOCK_BITS);
+		_tile_summary[index][GetTileType(tile)]++;
+	}
+}
+
+/**
+ * Count the tiles of each type within an area.
+ * Whole summary blocks within the area are taken from the summary; only the
+ * tiles of partially covered blocks are looked at.
+ * @param x X coordinate of the northern corner of the area.
+ * @param y Y coordinate of the northern corner of the area.
+ * @param w Width of the area; the part outside of the map is ignored.
+ * @param h Height of the area; the part outside of the map is ignored.
+ * @return The number of tiles of each type.
+ */
+TileTypeCounts<uint> CountTileTypes(uint x, uint y, uint w, uint h)
+{
+	if (_tile_summary.empty()) BuildTileSummary();
+
+	TileTypeCounts<uint> counts{};
+	if (x >= Map::SizeX() || y >= Map::SizeY()) return counts;
+	uint x_end = std::min(x + w, Map::SizeX());
+	uint y_end = std::min(y + h, Map::SizeY());
+
+	/* Whole blocks within the area. */
+	uint bx_begin = CeilDiv(x, TILE_SUMMARY_BLOCK_SIZE);
+	uint by_begin = CeilDiv(y, TILE_SUMMARY_BLOCK_SIZE);
+	uint bx_end = std::max(bx_begin, x_end >> TILE_SUMMARY_BLOCK_BITS);
+	uint by_end = std::max(by_begin, y_end >> TILE_SUMMARY_BLOCK_BITS);
+	uint blocks_x = Map::SizeX() >> TILE_SUMMARY_BLOCK_BITS;
+
+	for (uint by = by_begin; by < by_end; by++) {
+		for (uint bx = bx_begin; bx < bx_end; bx++) {
+			const TileTypeCounts<uint8_t> &block = _tile_summary[by * blocks_x + bx];
+			for (uint type = 0; type < NUM_TILE_TYPES; type++) counts[type] += block[type];
+		}
+	}
+
+	/* Tiles outside of the whole blocks. */
+	uint inner_x_begin = bx_begin << TILE_SUMMARY_BLOCK_BITS;
+	uint inner_x_end = bx_end << TILE_SUMMARY_BLOCK_BITS;
+	uint inner_y_begin = by_begin << TILE_SUMMARY_BLOCK_BITS;
+	uint inner_y_end = by_end << TILE_SUMMARY_BLOCK_BITS;
+	for (uint ty = y; ty < y_end; ty++) {
+		bool inner_row = ty >= inner_y_begin && ty < inner_y_end;
+		for (uint tx = x; tx < x_end; tx++) {
+			if (inner_row && tx >= inner_x_begin && tx < inner_x_end) {
+				tx = inner_x_end - 1;
+				continue;
+			}
+			counts[GetTileType(TileXY(tx, ty))]++;
+		}
+	}
+
+	return counts;
+}
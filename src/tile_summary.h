@@ -0,0 +1,49 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file tile_summary.h Per block counts of the tile types on the map. */
+
+#ifndef TILE_SUMMARY_H
+#define TILE_SUMMARY_H
+
+#include "tile_type.h"
+#include "map_func.h"
+
+static constexpr uint TILE_SUMMARY_BLOCK_BITS = 3; ///< Log2 of the edge length of a summary block.
+static constexpr uint TILE_SUMMARY_BLOCK_SIZE = 1U << TILE_SUMMARY_BLOCK_BITS; ///< Edge length, in tiles, of a summary block.
+static constexpr uint NUM_TILE_TYPES = MP_OBJECT + 1; ///< Number of tile types.
+
+/** Number of tiles of each type, either within one summary block or within an area. */
+template <typename T>
+using TileTypeCounts = std::array<T, NUM_TILE_TYPES>;
+
+/**
+ * Counts of every summary block, row by row.
+ * Empty while nobody asked for the summary, so keeping it up to date costs nothing until then.
+ */
+extern std::vector<TileTypeCounts<uint8_t>> _tile_summary;
+
+/**
+ * Account for the change of the type of a tile in the summary.
+ * @param tile The tile whose type changes.
+ * @param old_type The type the tile had.
+ * @param new_type The type the tile gets.
+ */
+inline void UpdateTileSummary(TileIndex tile, TileType old_type, TileType new_type)
+{
+	if (_tile_summary.empty() || old_type == new_type) return;
+
+	uint index = (TileY(tile) >> TILE_SUMMARY_BLOCK_BITS) * (Map::SizeX() >> TILE_SUMMARY_BLOCK_BITS) + (TileX(tile) >> TILE_SUMMARY_BLOCK_BITS);
+	TileTypeCounts<uint8_t> &block = _tile_summary[index];
+	block[old_type]--;
+	block[new_type]++;
+}
+
+void ResetTileSummary();
+TileTypeCounts<uint> CountTileTypes(uint x, uint y, uint w, uint h);
+
+#endif /* TILE_SUMMARY_H */
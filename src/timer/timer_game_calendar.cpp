@@ -134,7 +134,7 @@ bool TimerManager<TimerGameCalendar>::Elapsed([[maybe_unused]] TimerGameCalendar
 	TimerGameCalendar::year = ymd.year;
 
 	/* Make a temporary copy of the timers, as a timer's callback might add/remove other timers. */
-	auto timers = TimerManager<TimerGameCalendar>::GetTimers();
+	auto timers = TimerManager<TimerGameCalendar>::CopyTimers();
 
 	for (auto timer : timers) {
 		timer->Elapsed(TimerGameCalendar::DAY);
@@ -106,7 +106,10 @@ public:
 		NONE, ///< These timers can be executed in any order; there is no Random() in them, so order is not relevant.
 
 		/* All other may have a Random() call in them, so order is important.
-		 * For safety, you can only setup a single timer on a single priority. */
+		 * For safety, you can only setup a single timer on a single priority.
+		 * This is also why their work is done at once on the period boundary and not spread
+		 * over the following ticks: that would change the game, and the progress through
+		 * such a slice would have to be saved for clients joining halfway. */
 		COMPANY,
 		DISASTER,
 		ENGINE,
@@ -146,7 +146,7 @@ bool TimerManager<TimerGameEconomy>::Elapsed([[maybe_unused]] TimerGameEconomy::
 	TimerGameEconomy::year = ymd.year;
 
 	/* Make a temporary copy of the timers, as a timer's callback might add/remove other timers. */
-	auto timers = TimerManager<TimerGameEconomy>::GetTimers();
+	auto timers = TimerManager<TimerGameEconomy>::CopyTimers();
 
 	for (auto timer : timers) {
 		timer->Elapsed(TimerGameEconomy::DAY);
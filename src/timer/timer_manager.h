@@ -111,6 +111,17 @@ private:
 		}
 	};
 
+	/**
+	 * Copy the active timers, for when a timer's callback might add or remove other timers.
+	 * A vector is used, as copying the set would allocate a node for every timer.
+	 * @return The active timers, in the order they should be called.
+	 */
+	static std::vector<BaseTimer<TTimerType> *> CopyTimers()
+	{
+		const auto &timers = GetTimers();
+		return {timers.begin(), timers.end()};
+	}
+
 	/** Singleton list, to store all the active timers. */
 	static std::set<BaseTimer<TTimerType> *, base_timer_sorter> &GetTimers()
 	{
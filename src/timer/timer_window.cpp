@@ -49,7 +49,7 @@ template <>
 bool TimerManager<TimerWindow>::Elapsed(TimerWindow::TElapsed delta)
 {
 	/* Make a temporary copy of the timers, as a timer's callback might add/remove other timers. */
-	auto timers = TimerManager<TimerWindow>::GetTimers();
+	auto timers = TimerManager<TimerWindow>::CopyTimers();
 
 	for (auto timer : timers) {
 		timer->Elapsed(delta);
@@ -13,6 +13,7 @@
 #include "timer/timer_game_tick.h"
 #include "timer/timer_game_economy.h"
 #include "window_func.h"
+#include "window_gui.h"
 #include "vehicle_base.h"
 #include "timetable_cmd.h"
 #include "timetable.h"
@@ -55,6 +56,21 @@ TimerGameEconomy::Date GetDateFromStartTick(TimerGameTick::TickCounter start_tic
 	return TimerGameEconomy::date + (tick_offset / Ticks::DAY_TICKS);
 }
 
+/**
+ * Mark the timetable windows of all vehicles sharing the orders of a vehicle dirty.
+ * This looks at the open windows instead of the shared vehicles, as there are usually
+ * far fewer timetable windows open than vehicles sharing a timetable.
+ * @param v The vehicle.
+ */
+static void SetSharedTimetableWindowsDirty(const Vehicle *v)
+{
+	for (Window *w : Window::Iterate()) {
+		if (w->window_class != WC_VEHICLE_TIMETABLE) continue;
+		const Vehicle *u = Vehicle::GetIfValid(w->window_number);
+		if (u != nullptr && u->orders == v->orders) w->SetDirty();
+	}
+}
+
 /**
  * Change/update a particular timetable entry.
  * @param v            The vehicle to change the timetable of.
@@ -95,6 +111,7 @@ static void ChangeTimetable(Vehicle *v, VehicleOrderID order_number, uint16_t va
 	v->orders->UpdateTotalDuration(total_delta);
 	v->orders->UpdateTimetableDuration(timetable_delta);
 
+	const Vehicle *first = v->FirstShared();
 	for (v = v->FirstShared(); v != nullptr; v = v->NextShared()) {
 		if (v->cur_real_order_index == order_number && v->current_order.Equals(*order)) {
 			switch (mtf) {
@@ -116,8 +133,8 @@ static void ChangeTimetable(Vehicle *v, VehicleOrderID order_number, uint16_t va
 					NOT_REACHED();
 			}
 		}
-		SetWindowDirty(WC_VEHICLE_TIMETABLE, v->index);
 	}
+	SetSharedTimetableWindowsDirty(first);
 }
 
 /**
@@ -569,7 +586,5 @@ void UpdateVehicleTimetable(Vehicle *v, bool travelling)
 		}
 	}
 
-	for (v = v->FirstShared(); v != nullptr; v = v->NextShared()) {
-		SetWindowDirty(WC_VEHICLE_TIMETABLE, v->index);
-	}
+	SetSharedTimetableWindowsDirty(v);
 }
@@ -398,8 +398,11 @@ static bool IsCloseToTown(TileIndex tile, uint dist)
 void Town::UpdateVirtCoord()
 {
 	Point pt = RemapCoords2(TileX(this->xy) * TILE_SIZE, TileY(this->xy) * TILE_SIZE);
+	pt.y -= 24 * ZOOM_BASE;
 
-	if (this->cache.sign.kdtree_valid) _viewport_sign_kdtree.Remove(ViewportSignKdtreeItem::MakeTown(this->index));
+	/* Growing towns only change the size of their sign, which does not move it in the Kdtree. */
+	bool moved = !this->cache.sign.IsAt(pt.x, pt.y);
+	if (moved && this->cache.sign.kdtree_valid) _viewport_sign_kdtree.Remove(ViewportSignKdtreeItem::MakeTown(this->index));
 
 	std::string town_string;
 	if (this->larger_town) {
@@ -408,12 +411,12 @@ void Town::UpdateVirtCoord()
 		town_string = GetString(_settings_client.gui.population_in_label ? STR_VIEWPORT_TOWN_POP : STR_TOWN_NAME, this->index, this->cache.population);
 	}
 
-	this->cache.sign.UpdatePosition(pt.x, pt.y - 24 * ZOOM_BASE,
+	this->cache.sign.UpdatePosition(pt.x, pt.y,
 		town_string,
 		GetString(STR_TOWN_NAME, this->index, this->cache.population)
 );
 
-	_viewport_sign_kdtree.Insert(ViewportSignKdtreeItem::MakeTown(this->index));
+	if (moved) _viewport_sign_kdtree.Insert(ViewportSignKdtreeItem::MakeTown(this->index));
 
 	SetWindowDirty(WC_TOWN_VIEW, this->index);
 }
@@ -626,6 +629,8 @@ static void TileLoop_Town(TileIndex tile)
 	Town *t = Town::GetByTile(tile);
 	uint32_t r = Random();
 
+	/* The stations are only looked up once cargo is generated, and then only the town's
+	 * list of nearby stations, kept up to date by Station::RecomputeCatchment, is filtered. */
 	StationFinder stations(TileArea(tile, 1, 1));
 
 	if (hs->callback_mask.Test(HouseCallbackMask::ProduceCargo)) {
@@ -1842,7 +1847,9 @@ static bool GrowTownAtRoad(Town *t, TileIndex tile, TownExpandModes modes)
 			target_dir = ReverseDiagDir(GetTunnelBridgeDirection(tile));
 		} else {
 			/* Select a random bit from the blockmask, walk a step
-			 * and continue the search from there. */
+			 * and continue the search from there. This random walk is what
+			 * shapes the town, so it can't be replaced by picking from a
+			 * list of road ends without changing how towns grow. */
 			do {
 				if (cur_rb == ROAD_NONE) return false;
 				RoadBits target_bits;
@@ -2477,7 +2484,11 @@ bool GenerateTowns(TownLayout layout, std::optional<uint> number)
 
 	town_names.clear();
 
-	/* Build the town k-d tree again to make sure it's well balanced */
+	/* Build the town k-d tree again to make sure it's well balanced.
+	 * While generating, DoCreateTown already inserts every town into the tree, which
+	 * only rebalances itself when it has become noticeably unbalanced. The positions
+	 * are deliberately tried one random tile at a time, as the order of the Random()
+	 * calls determines which map a seed generates. */
 	RebuildTownKdtree();
 
 	if (current_number != 0) return true;
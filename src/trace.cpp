@@ -0,0 +1,118 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file trace.cpp Capturing a timeline of what the game spends its time on, written in the Chrome trace event format. */
+
+#include "stdafx.h"
+#include "trace.h"
+#include "core/format.hpp"
+#include "fileio_func.h"
+
+#include <mutex>
+
+#include "safeguards.h"
+
+/** Maximum number of events in one capture, to limit the memory use of a forgotten capture. */
+static const size_t MAX_TRACE_EVENTS = 4 * 1024 * 1024;
+
+/** An event in the trace; a zone that was left. */
+struct TraceEvent {
+	const char *name; ///< Name of the zone.
+	std::chrono::steady_clock::time_point start; ///< Moment the zone was entered.
+	std::chrono::steady_clock::duration duration; ///< Time spent in the zone.
+	uint thread; ///< Number of the thread the zone ran on.
+};
+
+std::atomic<bool> _trace_capturing; ///< Whether a trace is being captured.
+static std::mutex _trace_mutex; ///< Mutex to guard the recorded events.
+static std::vector<TraceEvent> _trace_events; ///< The recorded events.
+static std::chrono::steady_clock::time_point _trace_start; ///< Moment the capture started.
+static std::atomic<uint> _trace_next_thread; ///< Number to give to the next thread that records an event.
+
+/**
+ * Get the number of the current thread within traces.
+ * @return Number of the thread, counting from 1 in the order the threads first recorded an event.
+ */
+static uint GetTraceThread()
+{
+	thread_local uint thread = ++_trace_next_thread;
+	return thread;
+}
+
+/**
+ * Record a zone, if still capturing a trace.
+ * @param name Name of the zone.
+ * @param start Moment the zone was entered.
+ * @param end Moment the zone was left.
+ */
+void AddTraceEvent(const char *name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+	uint thread = GetTraceThread();
+
+	std::lock_guard<std::mutex> lock(_trace_mutex);
+	if (!_trace_capturing || start < _trace_start || _trace_events.size() >= MAX_TRACE_EVENTS) return;
+	_trace_events.emplace_back(name, start, end - start, thread);
+}
+
+/** Start capturing a trace, discarding any capture in progress. */
+void StartTraceCapture()
+{
+	std::lock_guard<std::mutex> lock(_trace_mutex);
+	_trace_events.clear();
+	_trace_start = std::chrono::steady_clock::now();
+	_trace_capturing = true;
+}
+
+/**
+ * Stop capturing the trace and write it.
+ * @param filename The file to write the trace to, in the JSON trace event format of Chrome and Perfetto.
+ * @return Whether the trace has been written.
+ */
+bool StopTraceCapture(std::string_view filename)
+{
+	std::vector<TraceEvent> events;
+	{
+		std::lock_guard<std::mutex> lock(_trace_mutex);
+		_trace_capturing = false;
+		std::swap(events, _trace_events);
+	}
+
+	auto f = FioFOpenFile(filename, "wt", Subdirectory::NO_DIRECTORY);
+	if (!f.has_value()) return false;
+
+	/* Complete events ("X") with their start and duration in microseconds. The viewers nest zones on the same thread by their times. */
+	fmt::print(*f, "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool first = true;
+	for (const TraceEvent &event : events) {
+		fmt::print(*f, "{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+				first ? "" : ",\n", event.name, event.thread,
+				std::chrono::duration<double, std::micro>(event.start - _trace_start).count(),
+				std::chrono::duration<double, std::micro>(event.duration).count());
+		first = false;
+	}
+	fmt::print(*f, "\n]}}\n");
+	return true;
+}
+
+/** Stop capturing the trace, and discard it. */
+void AbortTraceCapture()
+{
+	std::lock_guard<std::mutex> lock(_trace_mutex);
+	_trace_capturing = false;
+	_trace_events.clear();
+	_trace_events.shrink_to_fit();
+}
+
+/**
+ * Get the number of events recorded in the current capture.
+ * @return The number of events.
+ */
+size_t GetTraceEventCount()
+{
+	std::lock_guard<std::mutex> lock(_trace_mutex);
+	return _trace_events.size();
+}
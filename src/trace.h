@@ -0,0 +1,55 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file trace.h Capturing a timeline of what the game spends its time on. */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <chrono>
+
+extern std::atomic<bool> _trace_capturing;
+
+void AddTraceEvent(const char *name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+/**
+ * Records the time spent in a scope as an event in the trace, when capturing one.
+ * Zones may be nested, also across functions; the trace viewer shows them as a hierarchy.
+ *
+ * Usage:
+ * TraceZone zone("Name of the zone");
+ */
+class TraceZone {
+	const char *name; ///< Name of the zone; must outlive the capture, so usually a string literal.
+	std::chrono::steady_clock::time_point start; ///< Moment the zone was entered, if capturing.
+
+public:
+	/**
+	 * Enter a zone.
+	 * @param name Name of the zone, usually a string literal.
+	 */
+	inline TraceZone(const char *name) : name(name)
+	{
+		if (_trace_capturing.load(std::memory_order_relaxed)) this->start = std::chrono::steady_clock::now();
+	}
+
+	inline ~TraceZone()
+	{
+		if (this->start != std::chrono::steady_clock::time_point{}) AddTraceEvent(this->name, this->start, std::chrono::steady_clock::now());
+	}
+
+	TraceZone(const TraceZone &) = delete;
+	TraceZone &operator=(const TraceZone &) = delete;
+};
+
+void StartTraceCapture();
+bool StopTraceCapture(std::string_view filename);
+void AbortTraceCapture();
+size_t GetTraceEventCount();
+
+#endif /* TRACE_H */
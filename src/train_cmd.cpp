@@ -612,8 +612,7 @@ static std::vector<VehicleID> GetFreeWagonsInDepot(TileIndex tile)
 {
 	std::vector<VehicleID> free_wagons;
 
-	for (Vehicle *v : VehiclesOnTile(tile)) {
-		if (v->type != VEH_TRAIN) continue;
+	for (Vehicle *v : VehiclesOnTile(tile, VEH_TRAIN)) {
 		if (v->vehstatus.Test(VehState::Crashed)) continue;
 		if (!Train::From(v)->IsFreeWagon()) continue;
 
@@ -3240,6 +3239,9 @@ static uint CheckTrainCollision(Vehicle *v, Train *t)
  * Reports the incident in a flashy news item, modifies station ratings and
  * plays a sound.
  * @param v %Train to test.
+ * @note This runs right after each movement step of the train, while later trains have
+ *       not moved yet; checking all trains at the end of the tick would find other
+ *       collisions than the game has always found, and thus desync with other builds.
  */
 static bool CheckTrainCollision(Train *v)
 {
@@ -3252,14 +3254,14 @@ static bool CheckTrainCollision(Train *v)
 
 	/* find colliding vehicles */
 	if (v->track == TRACK_BIT_WORMHOLE) {
-		for (Vehicle *u : VehiclesOnTile(v->tile)) {
+		for (Vehicle *u : VehiclesOnTile(v->tile, VEH_TRAIN)) {
 			num_victims += CheckTrainCollision(u, v);
 		}
-		for (Vehicle *u : VehiclesOnTile(GetOtherTunnelBridgeEnd(v->tile))) {
+		for (Vehicle *u : VehiclesOnTile(GetOtherTunnelBridgeEnd(v->tile), VEH_TRAIN)) {
 			num_victims += CheckTrainCollision(u, v);
 		}
 	} else {
-		for (Vehicle *u : VehiclesNearTileXY(v->x_pos, v->y_pos, 7)) {
+		for (Vehicle *u : VehiclesNearTileXY(v->x_pos, v->y_pos, 7, VEH_TRAIN)) {
 			num_victims += CheckTrainCollision(u, v);
 		}
 	}
@@ -3280,6 +3282,10 @@ static bool CheckTrainCollision(Train *v)
  * @param nomove Stop moving this and all following vehicles.
  * @param reverse Set to false to not execute the vehicle reversing. This does not change any other logic.
  * @return True if the vehicle could be moved forward, false otherwise.
+ * @note Every part is moved on its own, also the wagons that just follow the front engine:
+ *       VehicleEnterTile of a wagon can enter a station, trigger a level crossing or
+ *       tunnel/bridge entry, and tile entry updates signals, reservations and the
+ *       vehicle position hashes that collision checks rely on in the same step.
  */
 bool TrainController(Train *v, Vehicle *nomove, bool reverse)
 {
@@ -3668,8 +3674,8 @@ static void DeleteLastWagon(Train *v)
 
 		/* If there are still crashed vehicles on the tile, give the track reservation to them */
 		TrackBits remaining_trackbits = TRACK_BIT_NONE;
-		for (const Vehicle *u : VehiclesOnTile(tile)) {
-			if (u->type != VEH_TRAIN || !u->vehstatus.Test(VehState::Crashed)) continue;
+		for (const Vehicle *u : VehiclesOnTile(tile, VEH_TRAIN)) {
+			if (!u->vehstatus.Test(VehState::Crashed)) continue;
 			TrackBits train_tbits = Train::From(u)->track;
 			if (train_tbits == TRACK_BIT_WORMHOLE) {
 				/* Vehicle is inside a wormhole, u->track contains no useful value then. */
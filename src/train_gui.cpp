@@ -34,9 +34,7 @@ void CcBuildWagon(Commands, const CommandCost &result, VehicleID new_veh_id, uin
 	const Vehicle *found = nullptr;
 	/* The non-deterministic order returned from VehiclesOnTile() does not
 	 * matter here as there must only be one locomotive for anything to happen. */
-	for (const Vehicle *v : VehiclesOnTile(tile)) {
-		if (v->type != VEH_TRAIN) continue;
-
+	for (const Vehicle *v : VehiclesOnTile(tile, VEH_TRAIN)) {
 		const Train *t = Train::From(v);
 		if (t->IsFrontEngine() && t->IsStoppedInDepot()) {
 			if (found != nullptr) return; // must be exactly one.
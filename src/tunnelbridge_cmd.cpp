@@ -569,6 +569,8 @@ CommandCost CmdBuildBridge(DoCommandFlags flags, TileIndex tile_end, TileIndex t
 				Owner owner_tram = hastram ? GetRoadOwner(tile_start, RTT_TRAM) : company;
 				MakeRoadBridgeRamp(tile_start, owner, owner_road, owner_tram, bridge_type, dir, road_rt, tram_rt);
 				MakeRoadBridgeRamp(tile_end,   owner, owner_road, owner_tram, bridge_type, ReverseDiagDir(dir), road_rt, tram_rt);
+				YapfNotifyRoadLayoutChange(tile_start);
+				YapfNotifyRoadLayoutChange(tile_end);
 				break;
 			}
 
@@ -799,6 +801,8 @@ CommandCost CmdBuildTunnel(DoCommandFlags flags, TileIndex start_tile, Transport
 			RoadType tram_rt = RoadTypeIsTram(roadtype) ? roadtype : INVALID_ROADTYPE;
 			MakeRoadTunnel(start_tile, company, direction,                 road_rt, tram_rt);
 			MakeRoadTunnel(end_tile,   company, ReverseDiagDir(direction), road_rt, tram_rt);
+			YapfNotifyRoadLayoutChange(start_tile);
+			YapfNotifyRoadLayoutChange(end_tile);
 		}
 		DirtyCompanyInfrastructureWindows(company);
 	}
@@ -927,6 +931,9 @@ static CommandCost DoClearTunnel(TileIndex tile, DoCommandFlags flags)
 
 			DoClearSquare(tile);
 			DoClearSquare(endtile);
+
+			YapfNotifyRoadLayoutChange(tile);
+			YapfNotifyRoadLayoutChange(endtile);
 		}
 	}
 
@@ -998,6 +1005,10 @@ static CommandCost DoClearBridge(TileIndex tile, DoCommandFlags flags)
 
 		DoClearSquare(tile);
 		DoClearSquare(endtile);
+		if (!rail) {
+			YapfNotifyRoadLayoutChange(tile);
+			YapfNotifyRoadLayoutChange(endtile);
+		}
 
 		for (TileIndex c = tile + delta; c != endtile; c += delta) {
 			/* do not let trees appear from 'nowhere' after removing bridge */
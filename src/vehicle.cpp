@@ -60,6 +60,7 @@
 #include "timer/timer_game_calendar.h"
 #include "timer/timer_game_economy.h"
 #include "timer/timer_game_tick.h"
+#include "trace.h"
 
 #include "table/strings.h"
 
@@ -380,23 +381,24 @@ Vehicle::Vehicle(VehicleType type)
 	this->last_loading_station = StationID::Invalid();
 }
 
-/* Size of the hash, 6 = 64 x 64, 7 = 128 x 128. Larger sizes will (in theory) reduce hash
- * lookup times at the expense of memory usage. */
-constexpr uint TILE_HASH_BITS = 7;
-constexpr uint TILE_HASH_SIZE = 1 << TILE_HASH_BITS;
-constexpr uint TILE_HASH_MASK = TILE_HASH_SIZE - 1;
-constexpr uint TOTAL_TILE_HASH_SIZE = 1 << (TILE_HASH_BITS * 2);
+/* Size of the hash along each axis as power of two, 7 = 128 x 128. Larger sizes reduce hash
+ * lookup times at the expense of memory usage, so the size grows with the map. */
+constexpr uint MIN_TILE_HASH_BITS = 7;
+constexpr uint MAX_TILE_HASH_BITS = 9;
 
 /* Resolution of the hash, 0 = 1*1 tile, 1 = 2*2 tiles, 2 = 4*4 tiles, etc.
  * Profiling results show that 0 is fastest. */
 constexpr uint TILE_HASH_RES = 0;
 
+static uint _tile_hash_bits = MIN_TILE_HASH_BITS; ///< Current size of the tile location hashes along each axis, as power of two.
+static uint _tile_hash_mask = (1 << MIN_TILE_HASH_BITS) - 1; ///< Mask of a 1D hash.
+
 /**
  * Compute hash for 1D tile coordinate.
  */
 static inline uint GetTileHash1D(uint p)
 {
-	return GB(p, TILE_HASH_RES, TILE_HASH_BITS);
+	return GB(p, TILE_HASH_RES, _tile_hash_bits);
 }
 
 /**
@@ -404,7 +406,7 @@ static inline uint GetTileHash1D(uint p)
  */
 static inline uint IncTileHash1D(uint h)
 {
-	return (h + 1) & TILE_HASH_MASK;
+	return (h + 1) & _tile_hash_mask;
 }
 
 /**
@@ -412,7 +414,7 @@ static inline uint IncTileHash1D(uint h)
  */
 static inline uint ComposeTileHash(uint hx, uint hy)
 {
-	return hx | hy << TILE_HASH_BITS;
+	return hx | hy << _tile_hash_bits;
 }
 
 /**
@@ -423,13 +425,43 @@ static inline uint GetTileHash(uint x, uint y)
 	return ComposeTileHash(GetTileHash1D(x), GetTileHash1D(y));
 }
 
-static std::array<Vehicle *, TOTAL_TILE_HASH_SIZE> _vehicle_tile_hash{};
+static std::vector<Vehicle *> _vehicle_tile_hash(1 << (2 * MIN_TILE_HASH_BITS));
+/** Tile location hashes with only the vehicles of one type, for the checks of vehicles for others of their own type. */
+static std::array<std::vector<Vehicle *>, VEH_COMPANY_END> _vehicle_type_tile_hash = {
+	std::vector<Vehicle *>(1 << (2 * MIN_TILE_HASH_BITS)), std::vector<Vehicle *>(1 << (2 * MIN_TILE_HASH_BITS)),
+	std::vector<Vehicle *>(1 << (2 * MIN_TILE_HASH_BITS)), std::vector<Vehicle *>(1 << (2 * MIN_TILE_HASH_BITS)),
+};
+
+/**
+ * Get the first vehicle of a bucket of the tile location hash.
+ * @param hash The bucket.
+ * @param type The type of the vehicles to visit, or #VEH_INVALID to visit all vehicles.
+ * @return The first vehicle in the bucket.
+ */
+static inline Vehicle *GetFirstVehicleInTileHash(uint hash, VehicleType type)
+{
+	if (type == VEH_INVALID) return _vehicle_tile_hash[hash];
+
+	assert(type < VEH_COMPANY_END);
+	return _vehicle_type_tile_hash[type][hash];
+}
+
+/**
+ * Get the next vehicle in a bucket of the tile location hash.
+ * @param v The current vehicle.
+ * @param type The type of the vehicles to visit, or #VEH_INVALID to visit all vehicles.
+ * @return The next vehicle in the bucket.
+ */
+static inline Vehicle *GetNextVehicleInTileHash(const Vehicle *v, VehicleType type)
+{
+	return type == VEH_INVALID ? v->hash_tile_next : v->hash_type_next;
+}
 
 /**
  * Iterator constructor.
  * Find first vehicle near (x, y).
  */
-VehiclesNearTileXY::Iterator::Iterator(int32_t x, int32_t y, uint max_dist)
+VehiclesNearTileXY::Iterator::Iterator(int32_t x, int32_t y, uint max_dist, VehicleType type) : type(type)
 {
 	/* There are no negative tile coordinates */
 	this->pos_rect.left = std::max<int>(0, x - max_dist);
@@ -437,7 +469,7 @@ VehiclesNearTileXY::Iterator::Iterator(int32_t x, int32_t y, uint max_dist)
 	this->pos_rect.top = std::max<int>(0, y - max_dist);
 	this->pos_rect.bottom = std::max<int>(0, y + max_dist);
 
-	if (2 * max_dist < TILE_HASH_MASK * TILE_SIZE) {
+	if (2 * max_dist < _tile_hash_mask * TILE_SIZE) {
 		/* Hash area to scan */
 		this->hxmin = this->hx = GetTileHash1D(this->pos_rect.left / TILE_SIZE);
 		this->hxmax = GetTileHash1D(this->pos_rect.right / TILE_SIZE);
@@ -446,12 +478,12 @@ VehiclesNearTileXY::Iterator::Iterator(int32_t x, int32_t y, uint max_dist)
 	} else {
 		/* Scan all */
 		this->hxmin = this->hx = 0;
-		this->hxmax = TILE_HASH_MASK;
+		this->hxmax = _tile_hash_mask;
 		this->hymin = this->hy = 0;
-		this->hymax = TILE_HASH_MASK;
+		this->hymax = _tile_hash_mask;
 	}
 
-	this->current_veh = _vehicle_tile_hash[ComposeTileHash(this->hx, this->hy)];
+	this->current_veh = GetFirstVehicleInTileHash(ComposeTileHash(this->hx, this->hy), this->type);
 	this->SkipEmptyBuckets();
 	this->SkipFalseMatches();
 }
@@ -462,7 +494,7 @@ VehiclesNearTileXY::Iterator::Iterator(int32_t x, int32_t y, uint max_dist)
 void VehiclesNearTileXY::Iterator::Increment()
 {
 	assert(this->current_veh != nullptr);
-	this->current_veh = this->current_veh->hash_tile_next;
+	this->current_veh = GetNextVehicleInTileHash(this->current_veh, this->type);
 	this->SkipEmptyBuckets();
 }
 
@@ -480,7 +512,7 @@ void VehiclesNearTileXY::Iterator::SkipEmptyBuckets()
 		} else {
 			return;
 		}
-		this->current_veh = _vehicle_tile_hash[ComposeTileHash(this->hx, this->hy)];
+		this->current_veh = GetFirstVehicleInTileHash(ComposeTileHash(this->hx, this->hy), this->type);
 	}
 }
 
@@ -496,9 +528,9 @@ void VehiclesNearTileXY::Iterator::SkipFalseMatches()
  * Iterator constructor.
  * Find first vehicle on tile.
  */
-VehiclesOnTile::Iterator::Iterator(TileIndex tile) : tile(tile)
+VehiclesOnTile::Iterator::Iterator(TileIndex tile, VehicleType type) : tile(tile), type(type)
 {
-	this->current = _vehicle_tile_hash[GetTileHash(TileX(tile), TileY(tile))];
+	this->current = GetFirstVehicleInTileHash(GetTileHash(TileX(tile), TileY(tile)), type);
 	this->SkipFalseMatches();
 }
 
@@ -508,7 +540,7 @@ VehiclesOnTile::Iterator::Iterator(TileIndex tile) : tile(tile)
  */
 void VehiclesOnTile::Iterator::Increment()
 {
-	this->current = this->current->hash_tile_next;
+	this->current = GetNextVehicleInTileHash(this->current, this->type);
 }
 
 /**
@@ -578,9 +610,7 @@ CommandCost EnsureNoTrainOnTrackBits(TileIndex tile, TrackBits track_bits)
 	 * error message only (which may be different for different machines).
 	 * Such a message does not affect MP synchronisation.
 	 */
-	for (const Vehicle *v : VehiclesOnTile(tile)) {
-		if (v->type != VEH_TRAIN) continue;
-
+	for (const Vehicle *v : VehiclesOnTile(tile, VEH_TRAIN)) {
 		const Train *t = Train::From(v);
 		if ((t->track != track_bits) && !TracksOverlap(t->track | track_bits)) continue;
 
@@ -620,6 +650,44 @@ static void UpdateVehicleTileHash(Vehicle *v, bool remove)
 	v->hash_tile_current = new_hash;
 }
 
+/**
+ * Update the position of a vehicle in the tile location hash with only the vehicles of its type.
+ * @param v The vehicle.
+ * @param remove Whether to remove the vehicle from the hash.
+ */
+static void UpdateVehicleTypeTileHash(Vehicle *v, bool remove)
+{
+	if (v->type >= VEH_COMPANY_END) return;
+
+	Vehicle **old_hash = v->hash_type_current;
+	Vehicle **new_hash;
+
+	if (remove) {
+		new_hash = nullptr;
+	} else {
+		new_hash = &_vehicle_type_tile_hash[v->type][GetTileHash(TileX(v->tile), TileY(v->tile))];
+	}
+
+	if (old_hash == new_hash) return;
+
+	/* Remove from the old position in the hash table */
+	if (old_hash != nullptr) {
+		if (v->hash_type_next != nullptr) v->hash_type_next->hash_type_prev = v->hash_type_prev;
+		*v->hash_type_prev = v->hash_type_next;
+	}
+
+	/* Insert vehicle at beginning of the new position in the hash table */
+	if (new_hash != nullptr) {
+		v->hash_type_next = *new_hash;
+		if (v->hash_type_next != nullptr) v->hash_type_next->hash_type_prev = &v->hash_type_next;
+		v->hash_type_prev = new_hash;
+		*new_hash = v;
+	}
+
+	/* Remember current hash position */
+	v->hash_type_current = new_hash;
+}
+
 static std::array<Vehicle *, 1 << (GEN_HASHX_BITS + GEN_HASHY_BITS)> _vehicle_viewport_hash{};
 
 static void UpdateVehicleViewportHash(Vehicle *v, int x, int y, int old_x, int old_y)
@@ -648,9 +716,19 @@ static void UpdateVehicleViewportHash(Vehicle *v, int x, int y, int old_x, int o
 
 void ResetVehicleHash()
 {
-	for (Vehicle *v : Vehicle::Iterate()) { v->hash_tile_current = nullptr; }
+	for (Vehicle *v : Vehicle::Iterate()) {
+		v->hash_tile_current = nullptr;
+		v->hash_type_current = nullptr;
+	}
 	_vehicle_viewport_hash.fill(nullptr);
-	_vehicle_tile_hash.fill(nullptr);
+
+	/* Larger maps get larger tile location hashes, so vehicles far apart share fewer buckets. */
+	_tile_hash_bits = Clamp((Map::LogX() + Map::LogY()) / 2 - 3, MIN_TILE_HASH_BITS, MAX_TILE_HASH_BITS);
+	_tile_hash_mask = (1 << _tile_hash_bits) - 1;
+
+	const size_t hash_size = static_cast<size_t>(1) << (2 * _tile_hash_bits);
+	_vehicle_tile_hash.assign(hash_size, nullptr);
+	for (auto &hash : _vehicle_type_tile_hash) hash.assign(hash_size, nullptr);
 }
 
 void ResetVehicleColourMap()
@@ -877,6 +955,7 @@ Vehicle::~Vehicle()
 	delete v;
 
 	UpdateVehicleTileHash(this, true);
+	UpdateVehicleTypeTileHash(this, true);
 	UpdateVehicleViewportHash(this, INVALID_COORD, 0, this->sprite_cache.old_coord.left, this->sprite_cache.old_coord.top);
 	if (this->type != VEH_EFFECT) {
 		DeleteVehicleNews(this->index);
@@ -953,6 +1032,8 @@ static void RunEconomyVehicleDayProc()
 
 void CallVehicleTicks()
 {
+	TraceZone zone("CallVehicleTicks");
+
 	_vehicles_to_autoreplace.clear();
 
 	RunEconomyVehicleDayProc();
@@ -965,7 +1046,17 @@ void CallVehicleTicks()
 	PerformanceAccumulator::Reset(PFE_GL_ROADVEHS);
 	PerformanceAccumulator::Reset(PFE_GL_SHIPS);
 	PerformanceAccumulator::Reset(PFE_GL_AIRCRAFT);
-
+	PerformanceAccumulator::Reset(PFE_GL_PATHFINDER);
+
+	/* Vehicles are ticked one by one in index order, and their pathfinding is done while they move.
+	 * The outcome of a train's route decision depends on the path reservations and signal states
+	 * left behind by the trains ticked before it, and the pathfinder itself reserves the path it
+	 * chooses. So these decisions can neither be made up front for all vehicles, nor in parallel,
+	 * without the result differing from what other clients compute. Stopped vehicles and
+	 * articulated parts can't be left out either; their cargo ages and their counters advance.
+	 * Networks that share no track or stations are no exception: breakdowns, NewGRF callbacks and
+	 * loading all draw from the one Random() sequence in vehicle order, and pool slots, company
+	 * money and news are shared, so ticking such "islands" side by side would still desync. */
 	for (Vehicle *v : Vehicle::Iterate()) {
 		[[maybe_unused]] VehicleID vehicle_index = v->index;
 
@@ -1662,6 +1753,7 @@ void VehicleEnterDepot(Vehicle *v)
 void Vehicle::UpdatePosition()
 {
 	UpdateVehicleTileHash(this, false);
+	UpdateVehicleTypeTileHash(this, false);
 }
 
 /**
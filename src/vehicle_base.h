@@ -51,7 +51,13 @@ enum NewGRFCacheValidValues : uint8_t {
 	NCVV_END,                           ///< End of the bits.
 };
 
-/** Cached often queried (NewGRF) values */
+/**
+ * Cached often queried (NewGRF) values.
+ * The results of the callbacks that would otherwise be asked every tick, like length,
+ * capacity or visual effect, are instead cached in #VehicleCache and #GroundVehicleCache
+ * when the consist changes. A generic cache of callback results could not know its
+ * inputs, as a callback may read any variable, the random bits or the temporary registers.
+ */
 struct NewGRFCache {
 	/* Values calculated when they are requested for the first time after invalidating the NewGRF cache. */
 	uint32_t position_consist_length = 0; ///< Cache for NewGRF var 40.
@@ -153,6 +159,9 @@ struct VehicleSpriteSeq {
 /**
  * Cache for vehicle sprites and values relating to whether they should be updated before drawing,
  * or calculating the viewport.
+ * @note The cache is per vehicle: the sprites of a NewGRF vehicle may depend on any of its
+ *       variables, such as its age, position or the vehicles around it, so vehicles of the
+ *       same engine with the same direction and load cannot share the resolved sprites.
  */
 struct MutableSpriteCache {
 	Direction last_direction = INVALID_DIR; ///< Last direction we obtained sprites for
@@ -231,6 +240,18 @@ public:
 	 */
 	TileIndex dest_tile = INVALID_TILE;
 
+	/* The fields read by every vehicle every tick are kept together, next to the chain pointers and the tile. */
+	VehStates vehstatus{}; ///< Status
+	Direction direction = INVALID_DIR; ///< facing
+	uint8_t progress = 0; ///< The percentage (if divided by 256) this vehicle already crossed the tile unit.
+	int32_t x_pos = 0; ///< x coordinate.
+	int32_t y_pos = 0; ///< y coordinate.
+	int32_t z_pos = 0; ///< z coordinate.
+	uint16_t cur_speed = 0; ///< current speed
+	uint8_t subspeed = 0; ///< fractional speed
+	uint8_t acceleration = 0; ///< used by train & aircraft
+	uint32_t motion_counter = 0; ///< counter to occasionally play a vehicle sound.
+
 	Money profit_this_year = 0; ///< Profit this year << 8, low 8 bits are fract
 	Money profit_last_year = 0; ///< Profit last year << 8, low 8 bits are fract
 	Money value = 0; ///< Value of the vehicle
@@ -246,6 +267,10 @@ public:
 	Vehicle **hash_tile_prev = nullptr; ///< NOSAVE: Previous vehicle in the tile location hash.
 	Vehicle **hash_tile_current = nullptr; ///< NOSAVE: Cache of the current hash chain.
 
+	Vehicle *hash_type_next = nullptr; ///< NOSAVE: Next vehicle in the tile location hash of its vehicle type.
+	Vehicle **hash_type_prev = nullptr; ///< NOSAVE: Previous vehicle in the tile location hash of its vehicle type.
+	Vehicle **hash_type_current = nullptr; ///< NOSAVE: Cache of the current hash chain of its vehicle type.
+
 	SpriteID colourmap{}; ///< NOSAVE: cached colour mapping
 
 	/* Related to age and service time */
@@ -262,11 +287,6 @@ public:
 	uint8_t breakdowns_since_last_service = 0; ///< Counter for the amount of breakdowns.
 	uint8_t breakdown_chance = 0; ///< Current chance of breakdowns.
 
-	int32_t x_pos = 0; ///< x coordinate.
-	int32_t y_pos = 0; ///< y coordinate.
-	int32_t z_pos = 0; ///< z coordinate.
-	Direction direction = INVALID_DIR; ///< facing
-
 	Owner owner = INVALID_OWNER; ///< Which company owns the vehicle?
 	/**
 	 * currently displayed sprite index
@@ -280,12 +300,6 @@ public:
 	TextEffectID fill_percent_te_id = INVALID_TE_ID; ///< a text-effect id to a loading indicator object
 	UnitID unitnumber{}; ///< unit number, for display purposes only
 
-	uint16_t cur_speed = 0; ///< current speed
-	uint8_t subspeed = 0; ///< fractional speed
-	uint8_t acceleration = 0; ///< used by train & aircraft
-	uint32_t motion_counter = 0; ///< counter to occasionally play a vehicle sound.
-	uint8_t progress = 0; ///< The percentage (if divided by 256) this vehicle already crossed the tile unit.
-
 	VehicleRandomTriggers waiting_random_triggers; ///< Triggers to be yet matched before rerandomizing the random bits.
 	uint16_t random_bits = 0; ///< Bits used for randomized variational spritegroups.
 
@@ -306,7 +320,6 @@ public:
 	uint8_t running_ticks = 0; ///< Number of ticks this vehicle was not stopped this day
 	uint16_t load_unload_ticks = 0; ///< Ticks to wait before starting next cycle.
 
-	VehStates vehstatus{}; ///< Status
 	uint8_t subtype = 0; ///< subtype (Filled with values from #AircraftSubType/#DisasterSubType/#EffectVehicleType/#GroundVehicleSubtypeFlags)
 	Order current_order{}; ///< The current order (+ status, like: loading)
 
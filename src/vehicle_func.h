@@ -48,6 +48,7 @@ bool IsValidImageIndex(uint8_t image_index);
 
 /**
  * Iterate over all vehicles on a tile.
+ * Optionally only the vehicles of one company vehicle type are visited; these are kept in a hash per type, so the other vehicles on the tile are not walked over.
  * @warning The order is non-deterministic. You have to make sure, that your processing is not order dependant.
  */
 class VehiclesOnTile {
@@ -63,7 +64,7 @@ public:
 		using pointer = void;
 		using reference = void;
 
-		explicit Iterator(TileIndex tile);
+		explicit Iterator(TileIndex tile, VehicleType type);
 
 		bool operator==(const Iterator &rhs) const { return this->current == rhs.current; }
 		bool operator==(const std::default_sentinel_t &) const { return this->current == nullptr; }
@@ -85,13 +86,14 @@ public:
 		}
 	private:
 		TileIndex tile;
+		VehicleType type;
 		Vehicle *current;
 
 		void Increment();
 		void SkipFalseMatches();
 	};
 
-	explicit VehiclesOnTile(TileIndex tile) : start(tile) {}
+	explicit VehiclesOnTile(TileIndex tile, VehicleType type = VEH_INVALID) : start(tile, type) {}
 	Iterator begin() const { return this->start; }
 	std::default_sentinel_t end() const { return std::default_sentinel_t(); }
 private:
@@ -113,6 +115,7 @@ bool HasVehicleOnTile(TileIndex tile, UnaryPred &&predicate)
 
 /**
  * Iterate over all vehicles near a given world coordinate.
+ * Optionally only the vehicles of one company vehicle type are visited; these are kept in a hash per type, so the other vehicles near the coordinate are not walked over.
  * @warning This only works for vehicles with proper Vehicle::Tile, so only ground vehicles outside wormholes.
  * @warning The order is non-deterministic. You have to make sure, that your processing is not order dependant.
  */
@@ -129,7 +132,7 @@ public:
 		using pointer = void;
 		using reference = void;
 
-		explicit Iterator(int32_t x, int32_t y, uint max_dist);
+		explicit Iterator(int32_t x, int32_t y, uint max_dist, VehicleType type);
 
 		bool operator==(const Iterator &rhs) const { return this->current_veh == rhs.current_veh; }
 		bool operator==(const std::default_sentinel_t &) const { return this->current_veh == nullptr; }
@@ -153,6 +156,7 @@ public:
 		Rect pos_rect;
 		uint hxmin, hxmax, hymin, hymax;
 		uint hx, hy;
+		VehicleType type;
 		Vehicle *current_veh;
 
 		void Increment();
@@ -160,7 +164,7 @@ public:
 		void SkipFalseMatches();
 	};
 
-	explicit VehiclesNearTileXY(int32_t x, int32_t y, uint max_dist) : start(x, y, max_dist) {}
+	explicit VehiclesNearTileXY(int32_t x, int32_t y, uint max_dist, VehicleType type = VEH_INVALID) : start(x, y, max_dist, type) {}
 	Iterator begin() const { return this->start; }
 	std::default_sentinel_t end() const { return std::default_sentinel_t(); }
 private:
@@ -12,6 +12,8 @@
 #include "../blitter/factory.hpp"
 #include "../saveload/saveload.h"
 #include "../window_func.h"
+#include "../framerate_type.h"
+#include "../network/network_replay.h"
 #include "null_v.h"
 
 #include "../safeguards.h"
@@ -31,6 +33,8 @@ std::optional<std::string_view> VideoDriver_Null::Start(const StringList &parm)
 	this->UpdateAutoResolution();
 
 	this->ticks = GetDriverParamInt(parm, "ticks", 1000);
+	this->benchmark_file = GetDriverParam(parm, "benchmark").value_or("");
+	this->replay_file = GetDriverParam(parm, "replay").value_or("");
 	_screen.width  = _screen.pitch = _cur_resolution.width;
 	_screen.height = _cur_resolution.height;
 	_screen.dst_ptr = nullptr;
@@ -50,12 +54,20 @@ void VideoDriver_Null::MainLoop()
 {
 	uint i;
 
+	if (!this->replay_file.empty() && !NetworkStartCommandReplay(this->replay_file)) return;
+	if (!this->benchmark_file.empty()) StartPerformanceRecording();
+
 	for (i = 0; i < this->ticks; i++) {
 		::GameLoop();
 		::InputLoop();
 		::UpdateWindows();
 	}
 
+	if (!this->benchmark_file.empty() && !WritePerformanceRecording(this->benchmark_file, this->ticks)) {
+		Debug(misc, 0, "Failed to write the benchmark results to '{}'", this->benchmark_file);
+	}
+	NetworkStopCommandReplay();
+
 	/* If requested, make a save just before exit. The normal exit-flow is
 	 * not triggered from this driver, so we have to do this manually. */
 	if (_settings_client.gui.autosave_on_exit) {
@@ -16,6 +16,8 @@
 class VideoDriver_Null : public VideoDriver {
 private:
 	uint ticks = 0; ///< Amount of ticks to run.
+	std::string benchmark_file; ///< File to write the statistics of the performance measurements to, if any.
+	std::string replay_file; ///< Command log to replay while running, if any.
 
 public:
 	std::optional<std::string_view> Start(const StringList &param) override;
@@ -25,7 +25,13 @@ class OpenGLSprite;
 
 using OpenGLSpriteLRUCache = LRUCache<SpriteID, std::unique_ptr<OpenGLSprite>>;
 
-/** Platform-independent back-end class for OpenGL video drivers. */
+/**
+ * Platform-independent back-end class for OpenGL video drivers.
+ * Only the cursor is drawn with textured sprites; the viewports are blitted
+ * into the video buffer by the CPU blitter. Viewports are drawn directly
+ * into that buffer interleaved with the GUI and the overlays, so moving them
+ * to the GPU would need all of those to be composed on the GPU too.
+ */
 class OpenGLBackend : public SpriteEncoder {
 private:
 	static OpenGLBackend *instance; ///< Singleton instance pointer.
@@ -27,6 +27,18 @@
 bool _video_hw_accel; ///< Whether to consider hardware accelerated video drivers on startup.
 bool _video_vsync; ///< Whether we should use vsync (only if active video driver supports HW acceleration).
 
+static constexpr std::chrono::seconds RENDER_FREE_DRAW_INTERVAL{1}; ///< Time between redraws of the screen while fast-forwarding render free.
+
+/**
+ * Whether the game is fast-forwarding render free, i.e. game ticks run back-to-back and
+ * the screen is only redrawn every #RENDER_FREE_DRAW_INTERVAL.
+ * @return True iff the game is fast-forwarding render free.
+ */
+static bool IsRenderFree()
+{
+	return _settings_client.gui.fast_forward_render_free && _game_speed != 100 && _game_mode == GM_NORMAL && !_pause_mode.Any() && !HasModalProgress();
+}
+
 void VideoDriver::GameLoop()
 {
 	this->next_game_tick += this->GetGameInterval();
@@ -106,6 +118,13 @@ void VideoDriver::Tick()
 	if (!this->is_game_threaded && std::chrono::steady_clock::now() >= this->next_game_tick) {
 		this->GameLoop();
 
+		/* When fast-forwarding render free, keep running game ticks till the next draw tick; that one only handles input most of the time. */
+		if (this->HasGUI() && IsRenderFree()) {
+			while (_switch_mode == SM_NONE && std::chrono::steady_clock::now() >= this->next_game_tick && std::chrono::steady_clock::now() < this->next_draw_tick) {
+				this->GameLoop();
+			}
+		}
+
 		/* For things like dedicated server, don't run a separate draw-tick. */
 		if (!this->HasGUI()) {
 			::InputLoop();
@@ -123,6 +142,8 @@ void VideoDriver::Tick()
 		/* Locking video buffer can block (especially with vsync enabled), do it before taking game state lock. */
 		this->LockVideoBuffer();
 
+		bool draw = true;
+
 		{
 			/* Tell the game-thread to stop so we can have a go. */
 			std::lock_guard<std::mutex> lock_wait(this->game_thread_wait_mutex);
@@ -148,16 +169,31 @@ void VideoDriver::Tick()
 
 			::InputLoop();
 
+			/* When fast-forwarding render free, only redraw the screen once in a while. In the meantime
+			 * nothing is marked dirty, so the whole screen has to be redrawn when it is time. */
+			if (IsRenderFree()) {
+				draw = now >= this->next_render_free_draw;
+				if (draw) this->next_render_free_draw = now + RENDER_FREE_DRAW_INTERVAL;
+			}
+			if (draw && _screen_dirty_suspended) {
+				_screen_dirty_suspended = false;
+				MarkWholeScreenDirty();
+			}
+
 			/* Prevent drawing when switching mode, as windows can be removed when they should still appear. */
-			if (_game_mode == GM_BOOTSTRAP || _switch_mode == SM_NONE || HasModalProgress()) {
+			if (draw && (_game_mode == GM_BOOTSTRAP || _switch_mode == SM_NONE || HasModalProgress())) {
 				::UpdateWindows();
 			}
 
 			this->PopulateSystemSprites();
+
+			_screen_dirty_suspended = IsRenderFree();
 		}
 
-		this->CheckPaletteAnim();
-		this->Paint();
+		if (draw) {
+			this->CheckPaletteAnim();
+			this->Paint();
+		}
 
 		this->UnlockVideoBuffer();
 
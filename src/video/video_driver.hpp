@@ -349,6 +349,7 @@ protected:
 
 	std::chrono::steady_clock::time_point next_game_tick;
 	std::chrono::steady_clock::time_point next_draw_tick;
+	std::chrono::steady_clock::time_point next_render_free_draw; ///< When to redraw the screen next while fast-forwarding render free.
 
 	bool fast_forward_key_pressed; ///< The fast-forward key is being pressed.
 	bool fast_forward_via_key; ///< The fast-forward was enabled by key press.
@@ -90,8 +90,8 @@
 #include "network/network_func.h"
 #include "framerate_type.h"
 #include "viewport_cmd.h"
+#include "elrail_func.h"
 
-#include <forward_list>
 #include <stack>
 
 #include "widgets/vehicle_widget.h"
@@ -1206,6 +1206,10 @@ static int GetViewportY(Point tile)
 
 /**
  * Add the landscape to the viewport, i.e. all ground tiles and buildings.
+ * @note The draw procs are called again for every redraw, as their output
+ *       also depends on state that does not mark the tile dirty, e.g. the
+ *       tile selection, transparency settings, snow line and NewGRF
+ *       callbacks, so a per-tile cache of the sprites cannot be kept valid.
  */
 static void ViewportAddLandscape()
 {
@@ -1552,6 +1556,22 @@ void ViewportSign::UpdatePosition(int center, int top, std::string_view str, std
 	this->MarkDirty();
 }
 
+/**
+ * Update the position of the viewport sign, and allow it in the _viewport_sign_kdtree.
+ * The sign may be resized without being moved in the Kdtree, so account for its
+ * size in the area searched for signs right away.
+ * @param center the (preferred) center of the viewport sign
+ * @param top    the new top of the sign
+ * @param str    the string to show in the sign
+ * @param str_small the string to show when zoomed out. If the string is empty then the \a str is used.
+ */
+void TrackedViewportSign::UpdatePosition(int center, int top, std::string_view str, std::string_view str_small)
+{
+	this->kdtree_valid = true;
+	this->ViewportSign::UpdatePosition(center, top, str, str_small);
+	_viewport_sign_maxwidth = std::max<int>({_viewport_sign_maxwidth, this->width_normal, this->width_small});
+}
+
 /**
  * Mark the sign dirty in all viewports.
  * @param maxzoom Maximum %ZoomLevel at which the text is visible.
@@ -1612,22 +1632,22 @@ static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 	 */
 	const uint32_t ORDER_COMPARED = UINT32_MAX; // Sprite was compared but we still need to compare the ones preceding it
 	const uint32_t ORDER_RETURNED = UINT32_MAX - 1; // Mark sorted sprite in case there are other occurrences of it in the stack
-	std::stack<ParentSpriteToDraw *> sprite_order;
+	/* The containers are only used by the drawing thread, so keep them around to not allocate them for every redraw. */
+	static std::stack<ParentSpriteToDraw *, std::vector<ParentSpriteToDraw *>> sprite_order;
 	uint32_t next_order = 0;
 
-	std::forward_list<std::pair<int64_t, ParentSpriteToDraw *>> sprite_list;  // We store sprites in a list sorted by xmin+ymin
+	static ParentSpriteSortList sprite_list;  // We store sprites in a list sorted by xmin+ymin
 
 	/* Initialize sprite list and order. */
 	for (auto p = psdv->rbegin(); p != psdv->rend(); p++) {
-		sprite_list.emplace_front((*p)->xmin + (*p)->ymin, *p);
 		sprite_order.push(*p);
 		(*p)->order = next_order++;
 	}
 
-	sprite_list.sort();
+	sprite_list.Fill(*psdv);
 
-	std::vector<ParentSpriteToDraw *> preceding;  // Temporarily stores sprites that precede current and their position in the list
-	auto preceding_prev = sprite_list.begin(); // Store iterator in case we need to delete a single preceding sprite
+	static std::vector<ParentSpriteToDraw *> preceding;  // Temporarily stores sprites that precede current and their position in the list
+	uint32_t preceding_prev = sprite_list.BeforeBegin(); // Store position in case we need to delete a single preceding sprite
 	auto out = psdv->begin();  // Iterator to output sorted sprites
 
 	while (!sprite_order.empty()) {
@@ -1656,18 +1676,19 @@ static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 		 * to ensure that we iterate the current sprite as we need to remove it from the list.
 		 */
 		auto ssum = std::max(s->xmax, s->xmin) + std::max(s->ymax, s->ymin);
-		auto prev = sprite_list.before_begin();
-		auto x = sprite_list.begin();
-		while (x != sprite_list.end() && x->first <= ssum) {
-			auto p = x->second;
+		uint32_t prev = sprite_list.BeforeBegin();
+		uint32_t x = sprite_list.Next(prev);
+		while (x != ParentSpriteSortList::END && sprite_list.Key(x) <= ssum) {
+			auto p = sprite_list.Sprite(x);
 			if (p == s) {
 				/* We found the current sprite, remove it and move on. */
-				x = sprite_list.erase_after(prev);
+				x = sprite_list.EraseAfter(prev);
 				continue;
 			}
 
 			auto p_prev = prev;
-			prev = x++;
+			prev = x;
+			x = sprite_list.Next(x);
 
 			if (s->xmax < p->xmin || s->ymax < p->ymin || s->zmax < p->zmin) continue;
 			if (s->xmin <= p->xmax && // overlap in X?
@@ -1696,7 +1717,7 @@ static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 			if (p->xmax <= s->xmax && p->ymax <= s->ymax && p->zmax <= s->zmax) {
 				p->order = ORDER_RETURNED;
 				s->order = ORDER_RETURNED;
-				sprite_list.erase_after(preceding_prev);
+				sprite_list.EraseAfter(preceding_prev);
 				*(out++) = p;
 				*(out++) = s;
 				continue;
@@ -1814,6 +1835,17 @@ static void ViewportDrawStrings(ZoomLevel zoom, const StringSpriteToDrawVector *
 	}
 }
 
+/**
+ * Draw a part of a viewport.
+ * @param vp The viewport to draw.
+ * @param left Left edge of the part to draw, in virtual coordinates.
+ * @param top Top edge of the part to draw, in virtual coordinates.
+ * @param right Right edge of the part to draw, in virtual coordinates.
+ * @param bottom Bottom edge of the part to draw, in virtual coordinates.
+ * @note This collects into the global #_vd and draws via #_cur_dpi, and the
+ *       sprites it collects may be loaded into or evicted from the sprite
+ *       cache. None of that is thread safe, so this must run on the draw thread.
+ */
 void ViewportDoDraw(const Viewport &vp, int left, int top, int right, int bottom)
 {
 	_vd.dpi.zoom = vp.zoom;
@@ -2012,7 +2044,6 @@ void UpdateViewportPosition(Window *w, uint32_t delta_ms)
 		int current_x = vp.scrollpos_x;
 		int current_y = vp.scrollpos_y;
 
-		bool update_overlay = false;
 		if (delta_x != 0 || delta_y != 0) {
 			if (_settings_client.gui.smooth_scroll) {
 				int delta_x_clamped;
@@ -2030,8 +2061,6 @@ void UpdateViewportPosition(Window *w, uint32_t delta_ms)
 				vp.scrollpos_x = vp.dest_scrollpos_x;
 				vp.scrollpos_y = vp.dest_scrollpos_y;
 			}
-			update_overlay = (vp.scrollpos_x == vp.dest_scrollpos_x &&
-								vp.scrollpos_y == vp.dest_scrollpos_y);
 		}
 
 		ClampViewportToMap(vp, &vp.scrollpos_x, &vp.scrollpos_y);
@@ -2044,7 +2073,6 @@ void UpdateViewportPosition(Window *w, uint32_t delta_ms)
 		}
 
 		SetViewportPosition(w, vp.scrollpos_x, vp.scrollpos_y);
-		if (update_overlay) RebuildViewportOverlay(w);
 	}
 }
 
@@ -2099,6 +2127,8 @@ static bool MarkViewportDirty(const Viewport &vp, int left, int top, int right,
  */
 bool MarkAllViewportsDirty(int left, int top, int right, int bottom)
 {
+	if (_screen_dirty_suspended) return false;
+
 	bool dirty = false;
 
 	for (const Window *w : Window::Iterate()) {
@@ -2133,6 +2163,9 @@ void ConstrainAllViewportsZoom()
  */
 void MarkTileDirtyByTile(TileIndex tile, int bridge_level_offset, int tile_height_override)
 {
+	/* Whatever changed on the tile may move the pylons and wires of it and its neighbours. */
+	InvalidateCatenaryLayout(tile);
+
 	Point pt = RemapCoords(TileX(tile) * TILE_SIZE, TileY(tile) * TILE_SIZE, tile_height_override * TILE_HEIGHT);
 	MarkAllViewportsDirty(
 			pt.x - MAX_TILE_EXTENT_LEFT,
@@ -2530,16 +2563,6 @@ bool HandleViewportClicked(const Viewport &vp, int x, int y)
 	return result;
 }
 
-void RebuildViewportOverlay(Window *w)
-{
-	if (w->viewport->overlay != nullptr &&
-			w->viewport->overlay->GetCompanyMask().Any() &&
-			w->viewport->overlay->GetCargoMask() != 0) {
-		w->viewport->overlay->SetDirty();
-		w->SetDirty();
-	}
-}
-
 /**
  * Scrolls the viewport in a window to a given location.
  * @param x       Desired x location of the map to scroll to (world coordinate).
@@ -2569,7 +2592,6 @@ bool ScrollWindowTo(int x, int y, int z, Window *w, bool instant)
 	if (instant) {
 		w->viewport->scrollpos_x = pt.x;
 		w->viewport->scrollpos_y = pt.y;
-		RebuildViewportOverlay(w);
 	}
 
 	w->viewport->dest_scrollpos_x = pt.x;
@@ -39,6 +39,75 @@ struct ParentSpriteToDraw {
 
 typedef std::vector<ParentSpriteToDraw*> ParentSpriteToSortVector;
 
+/**
+ * Singly linked list of parent sprites ordered by xmin + ymin, as used by the sprite sorters.
+ * The nodes are kept in vectors that are reused between sorts, so sorting does not
+ * allocate a node for every sprite at every redraw.
+ */
+class ParentSpriteSortList {
+public:
+	static constexpr uint32_t END = UINT32_MAX; ///< Marker for the end of the list.
+
+	/**
+	 * Fill the list with the given sprites, ordered by xmin + ymin.
+	 * @param psdv The sprites to put in the list.
+	 */
+	void Fill(const ParentSpriteToSortVector &psdv)
+	{
+		this->items.clear();
+		for (ParentSpriteToDraw *p : psdv) this->items.emplace_back(p->xmin + p->ymin, p);
+		std::sort(this->items.begin(), this->items.end());
+
+		uint32_t count = static_cast<uint32_t>(this->items.size());
+		this->next.resize(count + 1);
+		for (uint32_t i = 0; i < count; i++) this->next[i] = i + 1;
+		if (count > 0) this->next[count - 1] = END;
+		this->next[count] = count > 0 ? 0 : END;
+	}
+
+	/**
+	 * Get the position before the first node, to start iterating or erasing from.
+	 * @return The position before the first node.
+	 */
+	uint32_t BeforeBegin() const { return static_cast<uint32_t>(this->items.size()); }
+
+	/**
+	 * Get the position of the node after the given position.
+	 * @param pos The position to get the next of.
+	 * @return The position of the next node, or #END.
+	 */
+	uint32_t Next(uint32_t pos) const { return this->next[pos]; }
+
+	/**
+	 * Remove the node after the given position.
+	 * @param pos The position before the node to remove.
+	 * @return The position of the node after the removed one, or #END.
+	 */
+	uint32_t EraseAfter(uint32_t pos)
+	{
+		this->next[pos] = this->next[this->next[pos]];
+		return this->next[pos];
+	}
+
+	/**
+	 * Get the sort key of the node at the given position.
+	 * @param pos The position of the node.
+	 * @return The xmin + ymin of the sprite.
+	 */
+	int64_t Key(uint32_t pos) const { return this->items[pos].first; }
+
+	/**
+	 * Get the sprite of the node at the given position.
+	 * @param pos The position of the node.
+	 * @return The sprite.
+	 */
+	ParentSpriteToDraw *Sprite(uint32_t pos) const { return this->items[pos].second; }
+
+private:
+	std::vector<std::pair<int64_t, ParentSpriteToDraw *>> items; ///< The sprites, sorted by xmin + ymin.
+	std::vector<uint32_t> next; ///< For every item the position of the next one that is still in the list; the last entry is the head.
+};
+
 /** Type for method for checking whether a viewport sprite sorter exists. */
 typedef bool (*VpSorterChecker)();
 /** Type for the actual viewport sprite sorter. */
@@ -13,7 +13,6 @@
 #include "cpu.h"
 #include "smmintrin.h"
 #include "viewport_sprite_sorter.h"
-#include <forward_list>
 #include <stack>
 
 #include "safeguards.h"
@@ -41,22 +40,22 @@ void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv)
 	 */
 	const uint32_t ORDER_COMPARED = UINT32_MAX; // Sprite was compared but we still need to compare the ones preceding it
 	const uint32_t ORDER_RETURNED = UINT32_MAX - 1; // Mark sorted sprite in case there are other occurrences of it in the stack
-	std::stack<ParentSpriteToDraw *> sprite_order;
+	/* The containers are only used by the drawing thread, so keep them around to not allocate them for every redraw. */
+	static std::stack<ParentSpriteToDraw *, std::vector<ParentSpriteToDraw *>> sprite_order;
 	uint32_t next_order = 0;
 
-	std::forward_list<std::pair<int64_t, ParentSpriteToDraw *>> sprite_list;  // We store sprites in a list sorted by xmin+ymin
+	static ParentSpriteSortList sprite_list;  // We store sprites in a list sorted by xmin+ymin
 
 	/* Initialize sprite list and order. */
 	for (auto p = psdv->rbegin(); p != psdv->rend(); p++) {
-		sprite_list.emplace_front((*p)->xmin + (*p)->ymin, *p);
 		sprite_order.push(*p);
 		(*p)->order = next_order++;
 	}
 
-	sprite_list.sort();
+	sprite_list.Fill(*psdv);
 
-	std::vector<ParentSpriteToDraw *> preceding;  // Temporarily stores sprites that precede current and their position in the list
-	auto preceding_prev = sprite_list.begin(); // Store iterator in case we need to delete a single preceding sprite
+	static std::vector<ParentSpriteToDraw *> preceding;  // Temporarily stores sprites that precede current and their position in the list
+	uint32_t preceding_prev = sprite_list.BeforeBegin(); // Store position in case we need to delete a single preceding sprite
 	auto out = psdv->begin();  // Iterator to output sorted sprites
 
 	while (!sprite_order.empty()) {
@@ -85,18 +84,19 @@ void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv)
 		 * to ensure that we iterate the current sprite as we need to remove it from the list.
 		 */
 		auto ssum = std::max(s->xmax, s->xmin) + std::max(s->ymax, s->ymin);
-		auto prev = sprite_list.before_begin();
-		auto x = sprite_list.begin();
-		while (x != sprite_list.end() && x->first <= ssum) {
-			auto p = x->second;
+		uint32_t prev = sprite_list.BeforeBegin();
+		uint32_t x = sprite_list.Next(prev);
+		while (x != ParentSpriteSortList::END && sprite_list.Key(x) <= ssum) {
+			auto p = sprite_list.Sprite(x);
 			if (p == s) {
 				/* We found the current sprite, remove it and move on. */
-				x = sprite_list.erase_after(prev);
+				x = sprite_list.EraseAfter(prev);
 				continue;
 			}
 
 			auto p_prev = prev;
-			prev = x++;
+			prev = x;
+			x = sprite_list.Next(x);
 
 			/* Check that p->xmin <= s->xmax && p->ymin <= s->ymax && p->zmin <= s->zmax */
 			__m128i s_max = LOAD_128((__m128i*) &s->xmax);
@@ -142,7 +142,7 @@ void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv)
 			if (p->xmax <= s->xmax && p->ymax <= s->ymax && p->zmax <= s->zmax) {
 				p->order = ORDER_RETURNED;
 				s->order = ORDER_RETURNED;
-				sprite_list.erase_after(preceding_prev);
+				sprite_list.EraseAfter(preceding_prev);
 				*(out++) = p;
 				*(out++) = s;
 				continue;
@@ -66,10 +66,18 @@ struct TrackedViewportSign : ViewportSign {
 	 * Update the position of the viewport sign.
 	 * Note that this function hides the base class function.
 	 */
-	void UpdatePosition(int center, int top, std::string_view str, std::string_view str_small = {})
+	void UpdatePosition(int center, int top, std::string_view str, std::string_view str_small = {});
+
+	/**
+	 * Check whether the sign is in the _viewport_sign_kdtree at the given position.
+	 * When it is, updating the sign only changes its size, and it can stay in the Kdtree.
+	 * @param center The center of the sign.
+	 * @param top The top of the sign.
+	 * @return True iff the sign is in the Kdtree at that position.
+	 */
+	bool IsAt(int center, int top) const
 	{
-		this->kdtree_valid = true;
-		this->ViewportSign::UpdatePosition(center, top, str, str_small);
+		return this->kdtree_valid && this->center == center && this->top == top;
 	}
 };
 
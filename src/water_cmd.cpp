@@ -1264,11 +1264,17 @@ static void DoDryUp(TileIndex tile)
  * Let a water tile floods its diagonal adjoining tiles
  * called from tunnelbridge_cmd, and by TileLoop_Industry() and TileLoop_Track()
  *
+ * Water tiles without anything left to flood around them are marked as non-flooding
+ * and skip the neighbour checks; ClearNeighbourNonFloodingStates() wakes them up again
+ * whenever a neighbouring tile changes, so only the shoreline is checked each cycle.
+ *
  * @param tile the water/shore tile that floods
  */
 void TileLoop_Water(TileIndex tile)
 {
 	if (IsTileType(tile, MP_WATER)) {
+		/* Even water that can't flood must be visited by the tile loop, the
+		 * ambient sound callback draws from the game randomiser. */
 		AmbientSoundEffect(tile);
 		if (IsNonFloodingWaterTile(tile)) return;
 	}
@@ -42,6 +42,8 @@
 
 #include "table/strings.h"
 
+#include <unordered_set>
+
 #include "safeguards.h"
 
 /** Values for _settings_client.gui.auto_scrolling */
@@ -968,8 +970,44 @@ void Window::SetDirty() const
 	AddDirtyBlock(this->left, this->top, this->left + this->width, this->top + this->height);
 }
 
+/** The values of a widget that decide where it and the widgets around it are placed. */
+struct WidgetLayoutState {
+	const NWidgetBase *nwid; ///< The widget itself, as windows may replace widgets in OnInit().
+	uint current_x, current_y; ///< Current size; zero for a widget that has never been laid out.
+	int pos_x, pos_y; ///< Current position.
+	uint smallest_x, smallest_y; ///< Smallest size.
+	uint fill_x, fill_y; ///< Fill steps.
+	uint resize_x, resize_y; ///< Resize steps.
+	uint8_t padding_left, padding_top, padding_right, padding_bottom; ///< Padding.
+	int shown_plane; ///< Shown plane of a selection widget, 0 for other widgets.
+
+	bool operator==(const WidgetLayoutState &) const = default;
+};
+
+/**
+ * Get the values that decide the layout of the widgets of a window.
+ * Only the root and the widgets with an index are looked at; the sizes of the other widgets
+ * follow from those, as they do not depend on the data of the window.
+ * @param w The window.
+ * @param[out] state The values of the widgets.
+ */
+static void GetWidgetLayoutState(const Window &w, std::vector<WidgetLayoutState> &state)
+{
+	auto add = [&state](const NWidgetBase *nwid) {
+		const NWidgetStacked *stacked = dynamic_cast<const NWidgetStacked *>(nwid);
+		state.push_back({nwid, nwid->current_x, nwid->current_y, nwid->pos_x, nwid->pos_y, nwid->smallest_x, nwid->smallest_y, nwid->fill_x, nwid->fill_y, nwid->resize_x, nwid->resize_y,
+				nwid->padding.left, nwid->padding.top, nwid->padding.right, nwid->padding.bottom, stacked == nullptr ? 0 : stacked->shown_plane});
+	};
+
+	state.clear();
+	add(w.nested_root.get());
+	for (const auto &[index, nwid] : w.widget_lookup) add(nwid);
+}
+
 /**
  * Re-initialize a window, and optionally change its size.
+ * When only the data of the window changed and the smallest sizes of its widgets stay the same,
+ * the widgets keep their current size and position instead of being laid out again.
  * @param rx Horizontal resize of the window.
  * @param ry Vertical resize of the window.
  * @param reposition If set, reposition the window to default location.
@@ -979,6 +1017,12 @@ void Window::ReInit(int rx, int ry, bool reposition)
 {
 	this->SetDirty(); // Mark whole current window as dirty.
 
+	/* The containers are only used when re-initializing windows, so keep them around. */
+	static std::vector<WidgetLayoutState> old_layout;
+	static std::vector<WidgetLayoutState> new_layout;
+	bool may_keep_layout = rx == 0 && ry == 0 && !reposition && !this->full_layout && this->scale == _gui_scale && this->layout_text_dir == _current_text_dir;
+	if (may_keep_layout) GetWidgetLayoutState(*this, old_layout);
+
 	/* Save current size. */
 	int window_width  = this->width * _gui_scale / this->scale;
 	int window_height = this->height * _gui_scale / this->scale;
@@ -987,6 +1031,18 @@ void Window::ReInit(int rx, int ry, bool reposition)
 	this->OnInit();
 	/* Re-initialize window smallest size. */
 	this->nested_root->SetupSmallestSize(this);
+
+	if (may_keep_layout) {
+		GetWidgetLayoutState(*this, new_layout);
+		if (old_layout == new_layout) {
+			/* Nothing moves, but the window may still want to update e.g. the capacity of its scrollbars. */
+			ResizeWindow(this, 0, 0, true, false);
+			return;
+		}
+	}
+	this->layout_text_dir = _current_text_dir;
+	this->full_layout = false;
+
 	this->nested_root->AssignSizePosition(ST_SMALLEST, 0, 0, this->nested_root->smallest_x, this->nested_root->smallest_y, _current_text_dir == TD_RTL);
 	this->width  = this->nested_root->smallest_x;
 	this->height = this->nested_root->smallest_y;
@@ -1827,7 +1883,7 @@ void Window::InitNested(WindowNumber window_number)
  * Empty constructor, initialization has been moved to #InitNested() called from the constructor of the derived class.
  * @param desc The description of the window.
  */
-Window::Window(WindowDesc &desc) : window_desc(desc), scale(_gui_scale), mouse_capture_widget(INVALID_WIDGET)
+Window::Window(WindowDesc &desc) : window_desc(desc), scale(_gui_scale), layout_text_dir(_current_text_dir), mouse_capture_widget(INVALID_WIDGET)
 {
 	this->z_position = _z_windows.insert(_z_windows.end(), this);
 }
@@ -3145,6 +3201,7 @@ void UpdateWindows()
 		w->ProcessScheduledInvalidations();
 		w->ProcessHighlightedInvalidations();
 	}
+	ProcessScheduledWindowDirty();
 
 	/* Skip the actual drawing on dedicated servers without screen.
 	 * But still empty the invalidation queues above. */
@@ -3168,16 +3225,75 @@ void UpdateWindows()
 	}
 }
 
+/** A request to repaint (a widget of) one or all windows of a class. */
+struct ScheduledWindowDirty {
+	WindowClass cls; ///< Window class.
+	bool all_numbers; ///< Whether all windows of the class are to be repainted.
+	int32_t number; ///< Window number within the class, if not all.
+	WidgetID widget; ///< Widget to repaint, or \c INVALID_WIDGET for the whole window.
+
+	bool operator==(const ScheduledWindowDirty &other) const = default;
+};
+
+/** Hash of a #ScheduledWindowDirty. */
+struct ScheduledWindowDirtyHash {
+	size_t operator()(const ScheduledWindowDirty &request) const
+	{
+		uint64_t window = static_cast<uint64_t>(request.cls) << 33 | static_cast<uint64_t>(request.all_numbers) << 32 | static_cast<uint32_t>(request.number);
+		return std::hash<uint64_t>{}(window) ^ (std::hash<WidgetID>{}(request.widget) << 1);
+	}
+};
+
+/**
+ * Repaint requests made since the last redraw. Game logic often marks the same
+ * window dirty many times per tick, so each request is only kept once and matched
+ * against the windows once before drawing.
+ */
+static std::unordered_set<ScheduledWindowDirty, ScheduledWindowDirtyHash> _scheduled_window_dirty;
+
+/**
+ * Schedule a repaint request for the next redraw.
+ * @param request The request.
+ */
+static void ScheduleWindowDirty(const ScheduledWindowDirty &request)
+{
+	/* Nothing would be repainted anyway; the whole screen is marked dirty when drawing resumes. */
+	if (_screen_dirty_suspended) return;
+	_scheduled_window_dirty.insert(request);
+}
+
+/**
+ * Mark the windows dirty for which a repaint was requested since the last redraw.
+ */
+void ProcessScheduledWindowDirty()
+{
+	if (_scheduled_window_dirty.empty()) return;
+
+	for (const Window *w : Window::Iterate()) {
+		for (const ScheduledWindowDirty &request : _scheduled_window_dirty) {
+			if (w->window_class != request.cls) continue;
+			if (!request.all_numbers && w->window_number != request.number) continue;
+
+			if (request.widget == INVALID_WIDGET) {
+				w->SetDirty();
+			} else {
+				w->SetWidgetDirty(request.widget);
+			}
+		}
+	}
+
+	_scheduled_window_dirty.clear();
+}
+
 /**
  * Mark window as dirty (in need of repainting)
  * @param cls Window class
  * @param number Window number in that class
+ * @note The window is marked dirty at the next redraw.
  */
 void SetWindowDirty(WindowClass cls, WindowNumber number)
 {
-	for (const Window *w : Window::Iterate()) {
-		if (w->window_class == cls && w->window_number == number) w->SetDirty();
-	}
+	ScheduleWindowDirty({cls, false, number, INVALID_WIDGET});
 }
 
 /**
@@ -3185,25 +3301,21 @@ void SetWindowDirty(WindowClass cls, WindowNumber number)
  * @param cls Window class
  * @param number Window number in that class
  * @param widget_index Index number of the widget that needs repainting
+ * @note The widget is marked dirty at the next redraw.
  */
 void SetWindowWidgetDirty(WindowClass cls, WindowNumber number, WidgetID widget_index)
 {
-	for (const Window *w : Window::Iterate()) {
-		if (w->window_class == cls && w->window_number == number) {
-			w->SetWidgetDirty(widget_index);
-		}
-	}
+	ScheduleWindowDirty({cls, false, number, widget_index});
 }
 
 /**
  * Mark all windows of a particular class as dirty (in need of repainting)
  * @param cls Window class
+ * @note The windows are marked dirty at the next redraw.
  */
 void SetWindowClassesDirty(WindowClass cls)
 {
-	for (const Window *w : Window::Iterate()) {
-		if (w->window_class == cls) w->SetDirty();
-	}
+	ScheduleWindowDirty({cls, true, 0, INVALID_WIDGET});
 }
 
 /**
@@ -3403,6 +3515,8 @@ void ReInitWindow(Window *w, bool zoom_changed)
 		w->nested_root->AdjustPaddingForZoom();
 		w->UpdateQueryStringSize();
 	}
+	/* Fonts, strings or sprites changed, so also the widgets without an index may have a different size. */
+	w->full_layout = true;
 	w->ReInit();
 }
 
@@ -303,6 +303,8 @@ public:
 	WindowNumber window_number = 0; ///< Window number within the window class
 
 	int scale = 0; ///< Scale of this window -- used to determine how to resize.
+	TextDirection layout_text_dir = TD_LTR; ///< Text direction the widgets were laid out for.
+	bool full_layout = false; ///< Whether the next ReInit() has to lay out the widgets again, even when their smallest sizes stay the same.
 
 	uint8_t timeout_timer = 0; ///< Timer value of the WindowFlag::Timeout for flags.
 	uint8_t white_border_timer = 0; ///< Timer value of the WindowFlag::WhiteBorder for flags.
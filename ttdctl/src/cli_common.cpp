@@ -10,6 +10,7 @@
 #include "cli_common.h"
 #include <iostream>
 #include <algorithm>
+#include <cstdlib>
 
 void PrintUsage()
 {
@@ -19,9 +20,14 @@ void PrintUsage()
 	std::cout << "  -h, --help          Show this help message\n";
 	std::cout << "  -H, --host <host>   Server host (default: localhost)\n";
 	std::cout << "  -p, --port <port>   Server port (default: 9877)\n";
-	std::cout << "  -o, --output <fmt>  Output format: table, json (default: table)\n\n";
+	std::cout << "  -o, --output <fmt>  Output format: table, json (default: table)\n";
+	std::cout << "  -S, --socket <path> Unix socket of a ttdctl daemon (default: $TTDCTL_SOCKET or per-port path)\n";
+	std::cout << "  -e, --encoding <e>  Wire encoding: json, msgpack, cbor (default: json)\n";
+	std::cout << "  -f, --fields <list> Comma separated fields for list commands (with -o json)\n\n";
 	std::cout << "Resources:\n";
 	std::cout << "  ping                Test connection to game\n";
+	std::cout << "  daemon              Keep one connection to the game open for all ttdctl calls\n";
+	std::cout << "  batch               Run calls read from stdin over one connection, one JSON result per line\n";
 	std::cout << "  game                Game status and control\n";
 	std::cout << "  company             Company information\n";
 	std::cout << "  vehicle             Vehicle information and control\n";
@@ -40,6 +46,10 @@ void PrintUsage()
 	std::cout << "  airport             Airport information and building\n";
 	std::cout << "  viewport            Camera/viewport control\n";
 	std::cout << "  activity            Activity tracking for auto-camera\n";
+	std::cout << "  events              Stream pushed game events (vehicle, news, station_rating, cargomonitor)\n";
+	std::cout << "  pathfinder          Pathfinder search statistics\n";
+	std::cout << "  newgrf              NewGRF callback cost statistics\n";
+	std::cout << "  spritecache         Sprite cache memory use and hit rate\n";
 	std::cout << "\nVehicle Management:\n";
 	std::cout << "  vehicle build       Build a new vehicle at a depot\n";
 	std::cout << "  vehicle sell        Sell a vehicle (must be in depot)\n";
@@ -92,11 +102,15 @@ void PrintUsage()
 	std::cout << "  activity clear      Clear activity history\n";
 	std::cout << "\nExamples:\n";
 	std::cout << "  ttdctl ping\n";
+	std::cout << "  ttdctl daemon &                     # Later calls reuse its connection\n";
+	std::cout << "  printf 'station.get {\"id\": 1}\\nstation.get {\"id\": 2}\\n' | ttdctl batch\n";
 	std::cout << "  ttdctl game status\n";
 	std::cout << "  ttdctl game newgame                 # Generate new world\n";
 	std::cout << "  ttdctl game newgame --seed 12345    # With specific seed\n";
 	std::cout << "  ttdctl company list\n";
 	std::cout << "  ttdctl vehicle list road\n";
+	std::cout << "  ttdctl vehicle list --since 12          # Only vehicles changed after cursor 12\n";
+	std::cout << "  ttdctl -o json -f id,location vehicle list\n";
 	std::cout << "  ttdctl vehicle get 42\n";
 	std::cout << "  ttdctl station list\n";
 	std::cout << "  ttdctl station get 5\n";
@@ -155,12 +169,24 @@ void PrintUsage()
 	std::cout << "  ttdctl activity hotspot                 # Find most active area\n";
 	std::cout << "  ttdctl activity hotspot --seconds 60    # Look back 60 seconds\n";
 	std::cout << "  ttdctl activity clear                   # Clear activity log\n";
+	std::cout << "\n  # Event Streaming:\n";
+	std::cout << "  ttdctl events                           # All topics\n";
+	std::cout << "  ttdctl events vehicle news -o json      # Selected topics, one JSON object per line\n";
+	std::cout << "\n  # Diagnostics:\n";
+	std::cout << "  ttdctl pathfinder stats                 # Pathfinder searches per vehicle type and company\n";
+	std::cout << "  ttdctl pathfinder stats --company 0 --reset\n";
+	std::cout << "  ttdctl newgrf stats --start              # Start collecting NewGRF callback costs\n";
+	std::cout << "  ttdctl newgrf stats --top 20             # Most expensive NewGRF callbacks\n";
+	std::cout << "  ttdctl spritecache stats                # Sprite cache use per sprite type\n";
 }
 
 CliOptions ParseArgs(int argc, char *argv[])
 {
 	CliOptions opts;
 
+	const char *env_socket = std::getenv("TTDCTL_SOCKET");
+	if (env_socket != nullptr) opts.socket_path = env_socket;
+
 	for (int i = 1; i < argc; ++i) {
 		std::string arg = argv[i];
 
@@ -170,6 +196,12 @@ CliOptions ParseArgs(int argc, char *argv[])
 			if (i + 1 < argc) opts.host = argv[++i];
 		} else if (arg == "-p" || arg == "--port") {
 			if (i + 1 < argc) opts.port = static_cast<uint16_t>(std::stoi(argv[++i]));
+		} else if (arg == "-S" || arg == "--socket") {
+			if (i + 1 < argc) opts.socket_path = argv[++i];
+		} else if (arg == "-e" || arg == "--encoding") {
+			if (i + 1 < argc) opts.encoding = argv[++i];
+		} else if (arg == "-f" || arg == "--fields") {
+			if (i + 1 < argc) opts.fields = argv[++i];
 		} else if (arg == "-o" || arg == "--output") {
 			if (i + 1 < argc) {
 				std::string fmt = argv[++i];
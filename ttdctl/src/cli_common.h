@@ -22,6 +22,9 @@ static constexpr uint16_t DEFAULT_PORT = 9877;
 struct CliOptions {
 	std::string host = DEFAULT_HOST;
 	uint16_t port = DEFAULT_PORT;
+	std::string socket_path; ///< Unix-domain socket of the ttdctl daemon; empty for the default path.
+	std::string encoding = "json"; ///< Wire encoding for direct connections: json, msgpack or cbor.
+	std::string fields; ///< Comma separated fields for list commands; only used with JSON output.
 	std::string resource;
 	std::string action;
 	std::vector<std::string> args;
@@ -37,6 +40,9 @@ void PrintUsage();
 CliOptions ParseArgs(int argc, char *argv[]);
 void PrintTable(const std::vector<std::vector<std::string>> &rows);
 
+/* Connection daemon - daemon.cpp */
+int RunDaemon(const CliOptions &opts);
+
 /* Query commands - commands_query.cpp */
 int HandlePing(RpcClient &client, const CliOptions &opts);
 int HandleGameStatus(RpcClient &client, const CliOptions &opts);
@@ -68,6 +74,11 @@ int HandleStationCoverage(RpcClient &client, const CliOptions &opts);
 int HandleVehicleGetCargoByType(RpcClient &client, const CliOptions &opts);
 int HandleAirportInfo(RpcClient &client, const CliOptions &opts);
 int HandleRouteCheck(RpcClient &client, const CliOptions &opts);
+int HandleEvents(RpcClient &client, const CliOptions &opts);
+int HandleBatch(RpcClient &client, const CliOptions &opts);
+int HandlePathfinderStats(RpcClient &client, const CliOptions &opts);
+int HandleNewGRFStats(RpcClient &client, const CliOptions &opts);
+int HandleSpriteCacheStats(RpcClient &client, const CliOptions &opts);
 
 /* Action commands - commands_action.cpp */
 int HandleGameNewGame(RpcClient &client, const CliOptions &opts);
@@ -154,10 +154,16 @@ int HandleVehicleList(RpcClient &client, const CliOptions &opts)
 {
 	try {
 		nlohmann::json params = nlohmann::json::object();
-		if (!opts.args.empty()) {
-			params["type"] = opts.args[0];
+		for (size_t i = 0; i < opts.args.size(); ++i) {
+			if (opts.args[i] == "--since" && i + 1 < opts.args.size()) {
+				params["since"] = std::stoull(opts.args[++i]);
+			} else if (opts.args[i][0] != '-' && !params.contains("type")) {
+				params["type"] = opts.args[i];
+			}
 		}
 
+		if (opts.json_output && !opts.fields.empty()) params["fields"] = opts.fields;
+
 		auto result = client.Call("vehicle.list", params);
 
 		if (opts.json_output) {
@@ -165,6 +171,13 @@ int HandleVehicleList(RpcClient &client, const CliOptions &opts)
 			return 0;
 		}
 
+		if (params.contains("since")) {
+			std::cout << "Cursor: " << result["cursor"].get<uint64_t>();
+			if (result["reset"].get<bool>()) std::cout << " (reset, full list)";
+			std::cout << ", removed: " << result["removed"].size() << "\n";
+			result = result["vehicles"];
+		}
+
 		if (result.empty()) {
 			std::cout << "No vehicles found.\n";
 			return 0;
@@ -235,7 +248,10 @@ int HandleVehicleGet(RpcClient &client, const CliOptions &opts)
 int HandleStationList(RpcClient &client, const CliOptions &opts)
 {
 	try {
-		auto result = client.Call("station.list", {});
+		nlohmann::json params = nlohmann::json::object();
+		if (opts.json_output && !opts.fields.empty()) params["fields"] = opts.fields;
+
+		auto result = client.Call("station.list", params);
 
 		if (opts.json_output) {
 			std::cout << result.dump(2) << "\n";
@@ -320,7 +336,10 @@ int HandleStationGet(RpcClient &client, const CliOptions &opts)
 int HandleIndustryList(RpcClient &client, const CliOptions &opts)
 {
 	try {
-		auto result = client.Call("industry.list", {});
+		nlohmann::json params = nlohmann::json::object();
+		if (opts.json_output && !opts.fields.empty()) params["fields"] = opts.fields;
+
+		auto result = client.Call("industry.list", params);
 
 		if (opts.json_output) {
 			std::cout << result.dump(2) << "\n";
@@ -728,7 +747,10 @@ int HandleTileGet(RpcClient &client, const CliOptions &opts)
 int HandleTownList(RpcClient &client, const CliOptions &opts)
 {
 	try {
-		auto result = client.Call("town.list", {});
+		nlohmann::json params = nlohmann::json::object();
+		if (opts.json_output && !opts.fields.empty()) params["fields"] = opts.fields;
+
+		auto result = client.Call("town.list", params);
 
 		if (opts.json_output) {
 			std::cout << result.dump(2) << "\n";
@@ -1430,3 +1452,248 @@ int HandleRouteCheck(RpcClient &client, const CliOptions &opts)
 		return 1;
 	}
 }
+
+int HandlePathfinderStats(RpcClient &client, const CliOptions &opts)
+{
+	try {
+		nlohmann::json params = nlohmann::json::object();
+		for (size_t i = 0; i < opts.args.size(); i++) {
+			if (opts.args[i] == "--company" && i + 1 < opts.args.size()) {
+				params["company"] = std::stoi(opts.args[++i]);
+			} else if (opts.args[i] == "--reset") {
+				params["reset"] = true;
+			}
+		}
+
+		auto result = client.Call("pathfinder.stats", params);
+
+		if (opts.json_output) {
+			std::cout << result.dump(2) << "\n";
+			return 0;
+		}
+
+		auto add_row = [](std::vector<std::vector<std::string>> &rows, const std::string &name, const nlohmann::json &s) {
+			uint64_t searches = s["searches"].get<uint64_t>();
+			uint64_t time = s["total_time_us"].get<uint64_t>();
+			std::string hit_rate = std::to_string(static_cast<int>(s["cache_hit_rate"].get<double>() * 100.0 + 0.5)) + "%";
+			rows.push_back({
+				name,
+				std::to_string(searches),
+				std::to_string(s["paths_found"].get<uint64_t>()),
+				std::to_string(s["node_limit_reached"].get<uint64_t>()),
+				std::to_string(s["nodes_opened"].get<uint64_t>()),
+				std::to_string(s["nodes_closed"].get<uint64_t>()),
+				hit_rate,
+				std::to_string(time / 1000),
+				std::to_string(searches == 0 ? 0 : time / searches)
+			});
+		};
+
+		std::vector<std::vector<std::string>> rows;
+		rows.push_back({"Type", "Searches", "Found", "Limited", "Opened", "Closed", "Cache hits", "Total ms", "Avg us"});
+		for (const auto &[type, type_json] : result.items()) {
+			if (type_json.contains("total")) add_row(rows, type, type_json["total"]);
+			for (const auto &c : type_json["companies"]) {
+				add_row(rows, type + " company " + std::to_string(c["company"].get<int>()), c);
+			}
+		}
+		PrintTable(rows);
+		return 0;
+	} catch (const std::exception &e) {
+		std::cerr << "Error: " << e.what() << "\n";
+		return 1;
+	}
+}
+
+int HandleNewGRFStats(RpcClient &client, const CliOptions &opts)
+{
+	try {
+		nlohmann::json params = nlohmann::json::object();
+		size_t top = SIZE_MAX;
+		for (size_t i = 0; i < opts.args.size(); i++) {
+			if (opts.args[i] == "--top" && i + 1 < opts.args.size()) {
+				top = std::stoul(opts.args[++i]);
+			} else if (opts.args[i] == "--reset") {
+				params["reset"] = true;
+			} else if (opts.args[i] == "--start") {
+				params["collect"] = true;
+			} else if (opts.args[i] == "--stop") {
+				params["collect"] = false;
+			}
+		}
+
+		auto result = client.Call("newgrf.stats", params);
+
+		if (opts.json_output) {
+			std::cout << result.dump(2) << "\n";
+			return 0;
+		}
+
+		if (result.empty()) {
+			std::cout << "No NewGRF callback statistics; start collecting them with --start.\n";
+			return 0;
+		}
+
+		std::vector<std::vector<std::string>> rows;
+		rows.push_back({"GRF ID", "Feature", "Callback", "Calls", "Total us", "Avg ns", "Max ns"});
+		for (const auto &s : result) {
+			if (rows.size() > top) break;
+			uint64_t calls = s["calls"].get<uint64_t>();
+			uint64_t time = s["total_time_ns"].get<uint64_t>();
+			rows.push_back({
+				s["grfid"].get<std::string>(),
+				std::to_string(s["feature"].get<int>()),
+				std::to_string(s["callback"].get<int>()),
+				std::to_string(calls),
+				std::to_string(time / 1000),
+				std::to_string(calls == 0 ? 0 : time / calls),
+				std::to_string(s["max_time_ns"].get<uint64_t>())
+			});
+		}
+		PrintTable(rows);
+		return 0;
+	} catch (const std::exception &e) {
+		std::cerr << "Error: " << e.what() << "\n";
+		return 1;
+	}
+}
+
+int HandleSpriteCacheStats(RpcClient &client, const CliOptions &opts)
+{
+	try {
+		nlohmann::json params = nlohmann::json::object();
+		for (const auto &arg : opts.args) {
+			if (arg == "--reset") params["reset"] = true;
+		}
+
+		auto result = client.Call("spritecache.stats", params);
+
+		if (opts.json_output) {
+			std::cout << result.dump(2) << "\n";
+			return 0;
+		}
+
+		std::cout << "In use: " << result["bytes_used"].get<uint64_t>() / 1024 << " KiB of "
+				<< result["target_bytes"].get<uint64_t>() / 1024 << " KiB\n\n";
+
+		std::vector<std::vector<std::string>> rows;
+		rows.push_back({"Type", "Sprites", "KiB", "Hits", "Misses", "Hit %", "Evicted", "Evicted KiB"});
+		for (const auto &s : result["types"]) {
+			uint64_t hits = s["hits"].get<uint64_t>();
+			uint64_t misses = s["misses"].get<uint64_t>();
+			rows.push_back({
+				s["type"].get<std::string>(),
+				std::to_string(s["sprites"].get<uint64_t>()),
+				std::to_string(s["bytes"].get<uint64_t>() / 1024),
+				std::to_string(hits),
+				std::to_string(misses),
+				std::to_string(hits + misses == 0 ? 0 : hits * 100 / (hits + misses)),
+				std::to_string(s["evictions"].get<uint64_t>()),
+				std::to_string(s["evicted_bytes"].get<uint64_t>() / 1024)
+			});
+		}
+		PrintTable(rows);
+		return 0;
+	} catch (const std::exception &e) {
+		std::cerr << "Error: " << e.what() << "\n";
+		return 1;
+	}
+}
+
+int HandleEvents(RpcClient &client, const CliOptions &opts)
+{
+	try {
+		/* The optional action and arguments are the topics; default is all of them. */
+		nlohmann::json params = nlohmann::json::object();
+		if (!opts.action.empty()) {
+			nlohmann::json topics = nlohmann::json::array();
+			topics.push_back(opts.action);
+			for (const auto &arg : opts.args) {
+				if (arg[0] != '-') topics.push_back(arg);
+			}
+			params["topics"] = topics;
+		}
+
+		auto result = client.Call("rpc.subscribe", params);
+		if (!opts.json_output) {
+			std::cerr << "Subscribed to:";
+			for (const auto &topic : result["topics"]) std::cerr << " " << topic.get<std::string>();
+			std::cerr << "\n";
+		}
+
+		for (;;) {
+			auto notification = client.WaitForNotification();
+			if (opts.json_output) {
+				std::cout << notification.dump() << std::endl;
+			} else {
+				std::cout << notification.value("method", "") << " " << notification["params"].dump() << std::endl;
+			}
+		}
+	} catch (const std::exception &e) {
+		std::cerr << "Error: " << e.what() << "\n";
+		return 1;
+	}
+}
+
+/** Number of batch requests sent ahead of their responses. */
+static constexpr size_t BATCH_WINDOW = 32;
+
+/**
+ * Read calls from stdin, one per line, and run them pipelined over one connection.
+ * A line is either a JSON-RPC style object with "method" and optional "params" and
+ * "id", or a method name followed by its parameters as JSON. Empty lines and lines
+ * starting with '#' are skipped. Every response is written to stdout as one JSON
+ * object per line, as soon as it arrives, with the id of the call or its line number.
+ */
+int HandleBatch(RpcClient &client, const CliOptions &)
+{
+	std::vector<std::pair<std::string, nlohmann::json>> calls;
+	std::vector<nlohmann::json> ids;
+	bool failed = false;
+
+	std::string line;
+	for (int line_number = 1; std::getline(std::cin, line); line_number++) {
+		size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line[first] == '#') continue;
+		line = line.substr(first, line.find_last_not_of(" \t\r") + 1 - first);
+
+		nlohmann::json id = line_number;
+		nlohmann::json call;
+		if (line[0] == '{') {
+			call = nlohmann::json::parse(line, nullptr, false);
+			if (call.is_object() && call.contains("id")) id = call["id"];
+		} else {
+			size_t space = line.find_first_of(" \t");
+			call = {{"method", line.substr(0, space)}};
+			if (space != std::string::npos) call["params"] = nlohmann::json::parse(line.substr(space + 1), nullptr, false);
+		}
+
+		if (!call.is_object() || !call.contains("method") || !call["method"].is_string() || (call.contains("params") && call["params"].is_discarded())) {
+			nlohmann::json error = {{"id", id}, {"error", {{"code", -32700}, {"message", "Invalid call on line " + std::to_string(line_number)}}}};
+			std::cout << error.dump() << std::endl;
+			failed = true;
+			continue;
+		}
+
+		calls.emplace_back(call["method"].get<std::string>(), call.value("params", nlohmann::json::object()));
+		ids.push_back(std::move(id));
+	}
+
+	try {
+		client.CallPipelined(calls, BATCH_WINDOW, [&](size_t index, const nlohmann::json &response) {
+			nlohmann::json output = {{"id", ids[index]}, {"method", calls[index].first}};
+			if (response.contains("result")) {
+				output["result"] = response["result"];
+			} else {
+				output["error"] = response.value("error", nlohmann::json{{"code", -32603}, {"message", "Response missing 'result' field"}});
+				failed = true;
+			}
+			std::cout << output.dump() << std::endl;
+		});
+	} catch (const std::exception &e) {
+		std::cerr << "Error: " << e.what() << "\n";
+		return 1;
+	}
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/**
+ * @file daemon.cpp Long-running ttdctl daemon that multiplexes many short-lived
+ * ttdctl invocations over one persistent connection to the game.
+ *
+ * Local clients connect to a Unix-domain socket and send newline-terminated
+ * requests. Those are forwarded unchanged to the game; as the game answers the
+ * requests of a connection in order, the responses are routed back using a
+ * queue of the local clients that are waiting.
+ */
+
+#include "cli_common.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <map>
+
+/** A ttdctl process connected to the daemon. */
+struct DaemonClient {
+	std::string recv_buffer; ///< Partially received request.
+};
+
+/** Set by the signal handler to stop the daemon. */
+static volatile sig_atomic_t _daemon_stop = 0;
+
+static void DaemonSignalHandler(int)
+{
+	_daemon_stop = 1;
+}
+
+/**
+ * Create the listening Unix-domain socket.
+ * @param path The path of the socket.
+ * @return The socket, or -1 on failure.
+ */
+static int ListenUnix(const std::string &path)
+{
+	struct sockaddr_un addr{};
+	if (path.size() >= sizeof(addr.sun_path)) return -1;
+
+	int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (sock < 0) return -1;
+
+	addr.sun_family = AF_UNIX;
+	std::memcpy(addr.sun_path, path.c_str(), path.size());
+
+	unlink(path.c_str());
+	if (bind(sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 || listen(sock, 16) < 0) {
+		close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+/**
+ * Build the error response a waiting client gets when the game connection is lost.
+ * @param message The error message.
+ * @return The serialised response, including the line terminator.
+ */
+static std::string MakeDaemonError(const std::string &message)
+{
+	nlohmann::json response = {
+		{"jsonrpc", "2.0"},
+		{"id", nullptr},
+		{"error", {{"code", -32603}, {"message", message}}}
+	};
+	return response.dump() + "\n";
+}
+
+int RunDaemon(const CliOptions &opts)
+{
+	std::string path = opts.socket_path.empty() ? DefaultDaemonSocketPath(opts.port) : opts.socket_path;
+
+	int listen_sock = ListenUnix(path);
+	if (listen_sock < 0) {
+		std::cerr << "Error: failed to listen on " << path << "\n";
+		return 1;
+	}
+
+	signal(SIGINT, DaemonSignalHandler);
+	signal(SIGTERM, DaemonSignalHandler);
+	signal(SIGPIPE, SIG_IGN);
+
+	std::cout << "ttdctl daemon listening on " << path << ", forwarding to " << opts.host << ":" << opts.port << std::endl;
+
+	int upstream = -1;
+	std::string upstream_buffer;
+	std::deque<int> waiting; ///< Local clients waiting for a response, in request order; -1 for clients that went away.
+	std::map<int, DaemonClient> clients;
+
+	auto drop_upstream = [&](const std::string &reason) {
+		if (upstream >= 0) close(upstream);
+		upstream = -1;
+		upstream_buffer.clear();
+		for (int fd : waiting) {
+			if (fd >= 0) SendAll(fd, MakeDaemonError(reason));
+		}
+		waiting.clear();
+	};
+
+	auto drop_client = [&](int fd) {
+		close(fd);
+		clients.erase(fd);
+		for (int &w : waiting) {
+			if (w == fd) w = -1;
+		}
+	};
+
+	while (!_daemon_stop) {
+		std::vector<pollfd> fds;
+		fds.push_back({listen_sock, POLLIN, 0});
+		if (upstream >= 0) fds.push_back({upstream, POLLIN, 0});
+		for (const auto &[fd, client] : clients) fds.push_back({fd, POLLIN, 0});
+
+		if (poll(fds.data(), fds.size(), 1000) < 0) {
+			if (errno == EINTR) continue;
+			break;
+		}
+
+		for (const pollfd &pfd : fds) {
+			if (pfd.revents == 0) continue;
+
+			if (pfd.fd == listen_sock) {
+				int fd = accept(listen_sock, nullptr, nullptr);
+				if (fd >= 0) clients[fd] = {};
+				continue;
+			}
+
+			char buffer[4096];
+			ssize_t received = recv(pfd.fd, buffer, sizeof(buffer), 0);
+
+			if (pfd.fd == upstream) {
+				if (received <= 0) {
+					drop_upstream("Connection to game lost");
+					continue;
+				}
+				upstream_buffer.append(buffer, received);
+
+				size_t start = 0;
+				size_t pos;
+				while ((pos = upstream_buffer.find('\n', start)) != std::string::npos) {
+					/* Notifications have no requester waiting for them; do not let them shift the routing. */
+					nlohmann::json message = nlohmann::json::parse(std::string_view(upstream_buffer).substr(start, pos - start), nullptr, false);
+					bool notification = message.is_object() && message.contains("method") && !message.contains("id");
+					if (!notification && !waiting.empty()) {
+						int fd = waiting.front();
+						waiting.pop_front();
+						if (fd >= 0) SendAll(fd, upstream_buffer.substr(start, pos + 1 - start));
+					}
+					start = pos + 1;
+				}
+				upstream_buffer.erase(0, start);
+				continue;
+			}
+
+			auto it = clients.find(pfd.fd);
+			if (it == clients.end()) continue;
+
+			if (received <= 0) {
+				drop_client(pfd.fd);
+				continue;
+			}
+			it->second.recv_buffer.append(buffer, received);
+
+			size_t start = 0;
+			size_t pos;
+			while ((pos = it->second.recv_buffer.find('\n', start)) != std::string::npos) {
+				std::string line = it->second.recv_buffer.substr(start, pos + 1 - start);
+				start = pos + 1;
+
+				if (upstream < 0) {
+					try {
+						upstream = ConnectTcp(opts.host, opts.port);
+					} catch (const std::exception &e) {
+						SendAll(pfd.fd, MakeDaemonError(e.what()));
+						continue;
+					}
+				}
+
+				waiting.push_back(pfd.fd);
+				if (!SendAll(upstream, line)) drop_upstream("Failed to forward request to game");
+			}
+			it->second.recv_buffer.erase(0, start);
+		}
+	}
+
+	drop_upstream("Daemon shutting down");
+	for (const auto &[fd, client] : clients) close(fd);
+	close(listen_sock);
+	unlink(path.c_str());
+
+	return 0;
+}
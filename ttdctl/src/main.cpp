@@ -19,10 +19,27 @@ int main(int argc, char *argv[])
 		return opts.help ? 0 : 1;
 	}
 
-	RpcClient client(opts.host, opts.port);
+	if (opts.resource == "daemon") return RunDaemon(opts);
+
+	if (opts.resource == "events") {
+		/* Pushed notifications cannot be routed through the daemon, so always connect directly. */
+		RpcClient client(opts.host, opts.port);
+		return HandleEvents(client, opts);
+	}
+
+	/* Go through a running daemon when there is one; otherwise connect directly. */
+	RpcClient client(opts.host, opts.port, opts.socket_path.empty() ? DefaultDaemonSocketPath(opts.port) : opts.socket_path);
+	try {
+		client.SetEncoding(opts.encoding);
+	} catch (const std::exception &e) {
+		std::cerr << "Error: " << e.what() << "\n";
+		return 1;
+	}
 
 	if (opts.resource == "ping") {
 		return HandlePing(client, opts);
+	} else if (opts.resource == "batch") {
+		return HandleBatch(client, opts);
 	} else if (opts.resource == "game") {
 		if (opts.action == "status" || opts.action.empty()) {
 			return HandleGameStatus(client, opts);
@@ -171,6 +188,18 @@ int main(int argc, char *argv[])
 		if (opts.action == "check") {
 			return HandleRouteCheck(client, opts);
 		}
+	} else if (opts.resource == "pathfinder") {
+		if (opts.action == "stats" || opts.action.empty()) {
+			return HandlePathfinderStats(client, opts);
+		}
+	} else if (opts.resource == "newgrf") {
+		if (opts.action == "stats" || opts.action.empty()) {
+			return HandleNewGRFStats(client, opts);
+		}
+	} else if (opts.resource == "spritecache") {
+		if (opts.action == "stats" || opts.action.empty()) {
+			return HandleSpriteCacheStats(client, opts);
+		}
 	} else if (opts.resource == "town") {
 		if (opts.action == "list" || opts.action.empty()) {
 			return HandleTownList(client, opts);
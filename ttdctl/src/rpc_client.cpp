@@ -10,71 +10,300 @@
 #include "rpc_client.h"
 
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <unistd.h>
 
-#include <stdexcept>
+#include <cerrno>
+#include <cstdlib>
 #include <cstring>
+#include <map>
+#include <stdexcept>
 
-RpcClient::RpcClient(const std::string &host, uint16_t port)
-	: host(host), port(port)
+/**
+ * Get the path of the Unix-domain socket a ttdctl daemon for the given game port listens on.
+ * @param port The RPC port of the game.
+ * @return The socket path.
+ */
+std::string DefaultDaemonSocketPath(uint16_t port)
 {
+	const char *dir = std::getenv("XDG_RUNTIME_DIR");
+	std::string base = (dir != nullptr && *dir != '\0') ? dir : "/tmp";
+	return base + "/ttdctl-" + std::to_string(getuid()) + "-" + std::to_string(port) + ".sock";
 }
 
-RpcClient::~RpcClient() = default;
-
-std::string RpcClient::SendRequest(const std::string &request)
+/**
+ * Open a TCP connection to the game.
+ * @param host The host to connect to.
+ * @param port The port to connect to.
+ * @return The connected socket.
+ */
+int ConnectTcp(const std::string &host, uint16_t port)
 {
 	int sock = socket(AF_INET, SOCK_STREAM, 0);
 	if (sock < 0) {
 		throw std::runtime_error("Failed to create socket");
 	}
 
-	struct hostent *server = gethostbyname(this->host.c_str());
+	struct hostent *server = gethostbyname(host.c_str());
 	if (server == nullptr) {
 		close(sock);
-		throw std::runtime_error("Failed to resolve host: " + this->host);
+		throw std::runtime_error("Failed to resolve host: " + host);
 	}
 
 	struct sockaddr_in addr{};
 	addr.sin_family = AF_INET;
 	std::memcpy(&addr.sin_addr.s_addr, server->h_addr, server->h_length);
-	addr.sin_port = htons(this->port);
+	addr.sin_port = htons(port);
 
 	if (connect(sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
 		close(sock);
-		throw std::runtime_error("Failed to connect to " + this->host + ":" + std::to_string(this->port));
+		throw std::runtime_error("Failed to connect to " + host + ":" + std::to_string(port));
 	}
 
 	int flag = 1;
 	setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
 
-	std::string msg = request + "\n";
-	if (send(sock, msg.c_str(), msg.size(), 0) < 0) {
+	return sock;
+}
+
+/**
+ * Connect to a Unix-domain socket.
+ * @param path The path of the socket.
+ * @return The connected socket, or -1 when nobody is listening there.
+ */
+int ConnectUnix(const std::string &path)
+{
+	struct sockaddr_un addr{};
+	if (path.empty() || path.size() >= sizeof(addr.sun_path)) return -1;
+
+	int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (sock < 0) return -1;
+
+	addr.sun_family = AF_UNIX;
+	std::memcpy(addr.sun_path, path.c_str(), path.size());
+
+	if (connect(sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
 		close(sock);
-		throw std::runtime_error("Failed to send request");
+		return -1;
+	}
+
+	return sock;
+}
+
+/**
+ * Send all data, retrying on partial writes.
+ * @param sock The socket to send on.
+ * @param data The data to send.
+ * @return True when everything has been sent.
+ */
+bool SendAll(int sock, const std::string &data)
+{
+	size_t sent = 0;
+	while (sent < data.size()) {
+		ssize_t n = send(sock, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) return false;
+		sent += n;
+	}
+	return true;
+}
+
+RpcClient::RpcClient(const std::string &host, uint16_t port, const std::string &socket_path)
+	: host(host), port(port), socket_path(socket_path)
+{
+}
+
+RpcClient::~RpcClient()
+{
+	this->Disconnect();
+}
+
+/**
+ * Select the wire encoding for the connection to the game.
+ * Binary encodings are only negotiated on direct connections; the daemon always speaks JSON.
+ * @param encoding The encoding: json, msgpack or cbor.
+ */
+void RpcClient::SetEncoding(const std::string &encoding)
+{
+	if (encoding != "json" && encoding != "msgpack" && encoding != "cbor") {
+		throw std::runtime_error("Unknown encoding: " + encoding);
 	}
+	this->encoding = encoding;
+}
+
+void RpcClient::Connect()
+{
+	if (this->sock >= 0) return;
 
+	this->binary = false;
+	this->sock = ConnectUnix(this->socket_path);
+	if (this->sock >= 0) return;
+
+	this->sock = ConnectTcp(this->host, this->port);
+	if (this->encoding == "json") return;
+
+	nlohmann::json request = {
+		{"jsonrpc", "2.0"},
+		{"id", this->next_id++},
+		{"method", "rpc.setEncoding"},
+		{"params", {{"encoding", this->encoding}}}
+	};
 	std::string response;
-	char buffer[4096];
-	ssize_t received;
+	if (!SendAll(this->sock, request.dump() + "\n") || !this->ReceiveMessage(response)) {
+		this->Disconnect();
+		throw std::runtime_error("Failed to negotiate encoding " + this->encoding);
+	}
+	if (!nlohmann::json::parse(response, nullptr, false).contains("result")) {
+		this->Disconnect();
+		throw std::runtime_error("Server does not support encoding " + this->encoding);
+	}
+	this->binary = true;
+}
+
+void RpcClient::Disconnect()
+{
+	if (this->sock < 0) return;
+
+	close(this->sock);
+	this->sock = -1;
+	this->binary = false;
+	this->recv_buffer.clear();
+}
+
+/**
+ * Receive one complete message from the connection.
+ * @param[out] message The message, without line terminator or length prefix.
+ * @return False when the connection was closed before a complete message arrived.
+ */
+bool RpcClient::ReceiveMessage(std::string &message)
+{
+	for (;;) {
+		if (this->binary) {
+			if (this->recv_buffer.size() >= 4) {
+				const uint8_t *header = reinterpret_cast<const uint8_t *>(this->recv_buffer.data());
+				size_t length = (static_cast<size_t>(header[0]) << 24) | (header[1] << 16) | (header[2] << 8) | header[3];
+				if (this->recv_buffer.size() - 4 >= length) {
+					message = this->recv_buffer.substr(4, length);
+					this->recv_buffer.erase(0, 4 + length);
+					return true;
+				}
+			}
+		} else {
+			size_t pos = this->recv_buffer.find('\n');
+			if (pos != std::string::npos) {
+				message = this->recv_buffer.substr(0, pos);
+				this->recv_buffer.erase(0, pos + 1);
+				return true;
+			}
+		}
 
-	while ((received = recv(sock, buffer, sizeof(buffer) - 1, 0)) > 0) {
-		buffer[received] = '\0';
-		response += buffer;
-		if (response.find('\n') != std::string::npos) break;
+		char buffer[4096];
+		ssize_t received = recv(this->sock, buffer, sizeof(buffer), 0);
+		if (received < 0 && errno == EINTR) continue;
+		if (received <= 0) return false;
+		this->recv_buffer.append(buffer, received);
 	}
+}
+
+/**
+ * Encode a request in the encoding of the connection.
+ * @param request The request.
+ * @return The message to send, including line terminator or length prefix.
+ */
+std::string RpcClient::EncodeMessage(const nlohmann::json &request) const
+{
+	if (!this->binary) return request.dump() + "\n";
+
+	std::vector<uint8_t> payload = (this->encoding == "msgpack") ? nlohmann::json::to_msgpack(request) : nlohmann::json::to_cbor(request);
+	uint32_t length = static_cast<uint32_t>(payload.size());
+	std::string msg;
+	msg += static_cast<char>(length >> 24);
+	msg += static_cast<char>(length >> 16);
+	msg += static_cast<char>(length >> 8);
+	msg += static_cast<char>(length);
+	msg.append(reinterpret_cast<const char *>(payload.data()), payload.size());
+	return msg;
+}
+
+/**
+ * Send a request and wait for its response.
+ * @param request The request.
+ * @return The decoded response.
+ */
+nlohmann::json RpcClient::SendRequest(const nlohmann::json &request)
+{
+	/* A kept-alive connection may have been closed by the game in the meantime;
+	 * in that case nothing has been received yet and one reconnect is safe. */
+	for (int attempt = 0; attempt < 2; attempt++) {
+		bool reused = this->sock >= 0;
+		this->Connect();
+
+		if (!SendAll(this->sock, this->EncodeMessage(request))) {
+			this->Disconnect();
+			if (reused) continue;
+			throw std::runtime_error("Failed to send request");
+		}
+
+		/* Notifications of subscriptions can arrive before the response; keep them for WaitForNotification. */
+		for (;;) {
+			std::string message;
+			if (!this->ReceiveMessage(message)) break;
 
-	close(sock);
+			nlohmann::json response = this->DecodeMessage(message);
+			if (response.is_object() && response.contains("method") && !response.contains("id")) {
+				this->notifications.push_back(std::move(response));
+				continue;
+			}
+			return response;
+		}
 
-	if (response.empty()) {
+		bool nothing_received = this->recv_buffer.empty();
+		this->Disconnect();
+		if (reused && nothing_received) continue;
 		throw std::runtime_error("Empty response from server");
 	}
 
-	return response;
+	throw std::runtime_error("Failed to connect to " + this->host + ":" + std::to_string(this->port));
+}
+
+/**
+ * Decode a message in the encoding of the connection.
+ * @param message The raw message.
+ * @return The decoded message.
+ */
+nlohmann::json RpcClient::DecodeMessage(const std::string &message)
+{
+	try {
+		if (!this->binary) return nlohmann::json::parse(message);
+		if (this->encoding == "msgpack") return nlohmann::json::from_msgpack(message.begin(), message.end());
+		return nlohmann::json::from_cbor(message.begin(), message.end());
+	} catch (const nlohmann::json::parse_error &e) {
+		throw std::runtime_error("Invalid JSON response: " + std::string(e.what()));
+	}
+}
+
+/**
+ * Wait for the next notification pushed by the server, see rpc.subscribe.
+ * @return The notification, with its method and params.
+ */
+nlohmann::json RpcClient::WaitForNotification()
+{
+	if (this->notifications.empty()) {
+		std::string message;
+		if (this->sock < 0 || !this->ReceiveMessage(message)) {
+			this->Disconnect();
+			throw std::runtime_error("Connection to server lost");
+		}
+		return this->DecodeMessage(message);
+	}
+
+	nlohmann::json notification = std::move(this->notifications.front());
+	this->notifications.pop_front();
+	return notification;
 }
 
 nlohmann::json RpcClient::Call(const std::string &method, const nlohmann::json &params)
@@ -86,14 +315,7 @@ nlohmann::json RpcClient::Call(const std::string &method, const nlohmann::json &
 		{"params", params}
 	};
 
-	std::string response_str = this->SendRequest(request.dump());
-
-	nlohmann::json response;
-	try {
-		response = nlohmann::json::parse(response_str);
-	} catch (const nlohmann::json::parse_error &e) {
-		throw std::runtime_error("Invalid JSON response: " + std::string(e.what()));
-	}
+	nlohmann::json response = this->SendRequest(request);
 
 	if (response.contains("error")) {
 		auto &error = response["error"];
@@ -113,3 +335,58 @@ nlohmann::json RpcClient::Call(const std::string &method, const nlohmann::json &
 
 	return response["result"];
 }
+
+/**
+ * Call many methods over one connection without waiting for every response
+ * before sending the next request. The game handles the requests of a connection
+ * one after the other, but the round trips and the serialisation of the responses
+ * overlap. At most \a window requests are sent ahead, so the game does not stop
+ * reading because responses pile up that are not being read yet.
+ * @param calls Method and parameters of every call.
+ * @param window Maximum number of requests waiting for their response.
+ * @param on_response Called with the index of the call and its complete response, error or result, in the order the responses arrive.
+ */
+void RpcClient::CallPipelined(const std::vector<std::pair<std::string, nlohmann::json>> &calls, size_t window, const std::function<void(size_t, const nlohmann::json &)> &on_response)
+{
+	this->Connect();
+
+	std::map<int, size_t> outstanding; ///< Index of the call of every request waiting for its response, by request id.
+	size_t next = 0;
+	while (next < calls.size() || !outstanding.empty()) {
+		while (next < calls.size() && outstanding.size() < window) {
+			int id = this->next_id++;
+			nlohmann::json request = {
+				{"jsonrpc", "2.0"},
+				{"id", id},
+				{"method", calls[next].first},
+				{"params", calls[next].second}
+			};
+			if (!SendAll(this->sock, this->EncodeMessage(request))) {
+				this->Disconnect();
+				throw std::runtime_error("Failed to send request");
+			}
+			outstanding[id] = next++;
+		}
+
+		std::string message;
+		if (!this->ReceiveMessage(message)) {
+			this->Disconnect();
+			throw std::runtime_error("Connection to server lost");
+		}
+
+		nlohmann::json response = this->DecodeMessage(message);
+		if (response.is_object() && response.contains("method") && !response.contains("id")) {
+			this->notifications.push_back(std::move(response));
+			continue;
+		}
+
+		/* Errors without id, like those of the daemon when the game goes away, belong to the oldest request. */
+		auto it = outstanding.begin();
+		if (response.is_object() && response.contains("id") && response["id"].is_number_integer()) it = outstanding.find(response["id"].get<int>());
+		if (it == outstanding.end()) continue;
+
+		size_t index = it->second;
+		outstanding.erase(it);
+		on_response(index, response);
+	}
+}
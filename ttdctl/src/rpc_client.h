@@ -11,25 +11,53 @@
 #define RPC_CLIENT_H
 
 #include <nlohmann/json.hpp>
+#include <deque>
+#include <functional>
 #include <string>
+#include <utility>
+#include <vector>
 #include <cstdint>
 
+std::string DefaultDaemonSocketPath(uint16_t port);
+int ConnectTcp(const std::string &host, uint16_t port);
+int ConnectUnix(const std::string &path);
+bool SendAll(int sock, const std::string &data);
+
+/**
+ * JSON-RPC client. The connection is opened on the first call and kept open
+ * for all further calls. When a ttdctl daemon is listening on the Unix-domain
+ * socket, requests go through its shared connection instead.
+ */
 class RpcClient {
 public:
-	RpcClient(const std::string &host, uint16_t port);
+	RpcClient(const std::string &host, uint16_t port, const std::string &socket_path = {});
 	~RpcClient();
 
 	RpcClient(const RpcClient &) = delete;
 	RpcClient &operator=(const RpcClient &) = delete;
 
 	nlohmann::json Call(const std::string &method, const nlohmann::json &params);
+	void CallPipelined(const std::vector<std::pair<std::string, nlohmann::json>> &calls, size_t window, const std::function<void(size_t, const nlohmann::json &)> &on_response);
+	void SetEncoding(const std::string &encoding);
+	nlohmann::json WaitForNotification();
 
 private:
 	std::string host;
 	uint16_t port;
+	std::string socket_path; ///< Unix-domain socket of a ttdctl daemon; tried before connecting directly.
+	std::string encoding = "json"; ///< Wire encoding to negotiate on direct connections: json, msgpack or cbor.
+	int sock = -1;
+	bool binary = false; ///< Whether the current connection uses length-prefixed binary frames.
+	std::string recv_buffer; ///< Data received after the last complete response.
+	std::deque<nlohmann::json> notifications; ///< Notifications that arrived while waiting for a response.
 	int next_id = 1;
 
-	std::string SendRequest(const std::string &request);
+	void Connect();
+	void Disconnect();
+	bool ReceiveMessage(std::string &message);
+	std::string EncodeMessage(const nlohmann::json &request) const;
+	nlohmann::json DecodeMessage(const std::string &message);
+	nlohmann::json SendRequest(const nlohmann::json &request);
 };
 
 #endif /* RPC_CLIENT_H */